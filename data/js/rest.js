@@ -25,24 +25,44 @@ pixelix.rest.Client.prototype.listFiles = function(path = "/", page = "0") {
     });
 };
 
+pixelix.rest.Client.prototype.listFilesByCursor = function(path = "/", cursor = null, count = 0) {
+    var parameter = {};
+
+    if (null === cursor) {
+        parameter.dir = path;
+    } else {
+        parameter.cursor = cursor;
+    }
+
+    if (0 < count) {
+        parameter.count = count;
+    }
+
+    return utils.makeRequest({
+        method: "GET",
+        url: this._hostname + this._baseUri + "/fs",
+        isJsonResponse: true,
+        parameter: parameter
+    });
+};
+
 pixelix.rest.Client.prototype.listAllFiles = function(path = "/") {
-    var page    = 0;
     var data    = [];
     var client  = this;
     var handler = function(rsp) {
         var promise = null;
 
-        if (0 < rsp.data.length) {
-            data = data.concat(rsp.data);
-            ++page;
-            promise = client.listFiles(path, page).then(handler);
+        data = data.concat(rsp.data);
+
+        if ("string" === typeof rsp.cursor) {
+            promise = client.listFilesByCursor(path, rsp.cursor).then(handler);
         } else {
             promise = Promise.resolve(data);
         }
         return promise;
     };
 
-    return this.listFiles(path, page).then(handler);
+    return this.listFilesByCursor(path).then(handler);
 };
 
 pixelix.rest.Client.prototype.listAllFilesRecursive = function(path = "/") {
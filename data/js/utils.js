@@ -127,4 +127,37 @@ utils.readJsonFile = function(file) {
         }
         rawFile.send(null);
     });
+};
+
+utils.getTmplValues = function() {
+    /* The values are requested only once per page. */
+    if ("undefined" === typeof utils.tmplValues) {
+        utils.tmplValues = utils.makeRequest({
+            method: "GET",
+            url: "/tmpl.json",
+            isJsonResponse: true
+        }).then(function(rsp) {
+            return rsp.data;
+        });
+    }
+
+    return utils.tmplValues;
+};
+
+utils.injectTmplValues = function() {
+    return utils.getTmplValues().then(function(values) {
+        var elements    = document.querySelectorAll("[data-tmpl]");
+        var index       = 0;
+        var key         = "";
+
+        for(index = 0; index < elements.length; ++index) {
+            key = elements[index].getAttribute("data-tmpl");
+
+            if ("undefined" !== typeof values[key]) {
+                elements[index].textContent = values[key];
+            }
+        }
+
+        return values;
+    });
 };
\ No newline at end of file
@@ -45,6 +45,7 @@ pixelix.ws.Client = function(options) {
     this._cmdQueue      = [];
     this._pendingCmd    = null;
     this._onEvent       = null;
+    this._onFrame       = null;
 
     this._sendCmdFromQueue = function() {
         var msg = "";
@@ -98,6 +99,7 @@ pixelix.ws.Client.prototype.connect = function(options) {
             try {
                 wsUrl = options.protocol + "://" + options.hostname + ":" + options.port + options.endpoint;
                 this._socket = new WebSocket(wsUrl);
+                this._socket.binaryType = "arraybuffer";
 
                 this._socket.onopen = function(openEvent) {
                     console.debug("Websocket opened.");
@@ -114,8 +116,12 @@ pixelix.ws.Client.prototype.connect = function(options) {
                 };
 
                 this._socket.onmessage = function(messageEvent) {
-                    console.debug("Websocket message: " + messageEvent.data);
-                    this._onMessage(messageEvent.data);
+                    if (messageEvent.data instanceof ArrayBuffer) {
+                        this._onBinaryMessage(messageEvent.data);
+                    } else {
+                        console.debug("Websocket message: " + messageEvent.data);
+                        this._onMessage(messageEvent.data);
+                    }
                 }.bind(this);
 
             } catch (exception) {
@@ -173,6 +179,8 @@ pixelix.ws.Client.prototype._onMessage = function(msg) {
                     rsp.data.push(parseInt(data[index], 16));
                 }
                 this._pendingCmd.resolve(rsp);
+            } else if ("DISPSTREAM" === this._pendingCmd.name) {
+                this._pendingCmd.resolve(rsp);
             } else if ("BRIGHTNESS" === this._pendingCmd.name) {
                 rsp.brightness = parseInt(data[0]);
                 rsp.automaticBrightnessControl = (1 === parseInt(data[1])) ? true : false;
@@ -238,6 +246,68 @@ pixelix.ws.Client.prototype._onMessage = function(msg) {
     return;
 };
 
+pixelix.ws.Client.prototype._onBinaryMessage = function(msg) {
+    var data    = new Uint8Array(msg);
+    var frame   = {};
+    var index   = 0;
+    var offset  = 10;
+
+    /* Only display frames are expected. */
+    if ((offset <= data.length) && (0xff === data[0])) {
+        frame.slotId    = data[1];
+        frame.width     = (data[2] << 8) | data[3];
+        frame.height    = (data[4] << 8) | data[5];
+        frame.seqNo     = ((data[6] << 24) | (data[7] << 16) | (data[8] << 8) | data[9]) >>> 0;
+        frame.data      = [];
+
+        for(index = offset; (index + 2) < data.length; index += 3) {
+            frame.data.push((data[index] << 16) | (data[index + 1] << 8) | data[index + 2]);
+        }
+
+        if (null !== this._onFrame) {
+            this._onFrame(frame);
+        }
+    }
+
+    return;
+};
+
+pixelix.ws.Client.prototype.subscribeDisplay = function(options) {
+    return new Promise(function(resolve, reject) {
+        if ((null === this._socket) ||
+            ("number" !== typeof options.fps) ||
+            ("function" !== typeof options.onFrame)) {
+            reject();
+        } else {
+            this._onFrame = options.onFrame;
+
+            this._sendCmd({
+                name: "DISPSTREAM",
+                par: options.fps,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
+pixelix.ws.Client.prototype.unsubscribeDisplay = function() {
+    return new Promise(function(resolve, reject) {
+        if (null === this._socket) {
+            reject();
+        } else {
+            this._onFrame = null;
+
+            this._sendCmd({
+                name: "DISPSTREAM",
+                par: 0,
+                resolve: resolve,
+                reject: reject
+            });
+        }
+    }.bind(this));
+};
+
 pixelix.ws.Client.prototype.getDisplayContent = function() {
     return new Promise(function(resolve, reject) {
         if (null === this._socket) {
@@ -0,0 +1,398 @@
+"""
+MIT License
+
+Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+================================================================================
+Create a sprite animation (.anim) from a bitmap (.bmp) texture.
+
+The sprite animation is a compact binary container, which is played by the
+device without decoding the texture image. All frames share one palette and
+every frame contains only the pixels, which changed compared to the previous
+frame. The first frame is stored relative to a canvas, which is filled with
+the first palette color.
+
+File format (little endian):
+    Header
+        char[4]     Signature "ANIM"
+        uint8       Version (1)
+        uint8       Flags (bit 0: repeat infinite)
+        uint16      Frame width in pixels
+        uint16      Frame height in pixels
+        uint16      Number of frames
+        uint8       Frames per second
+        uint8       Number of palette colors - 1
+        uint16      Reserved (0)
+    Palette
+        uint8[3]    Red, green and blue of every palette color
+    Frames
+        uint16      Size of the frame data in byte
+        uint8[]     Frame data, which is a sequence of records:
+                    - Number of unchanged pixels to skip. A byte with 255
+                      continues the number with the next byte.
+                    - Packet header: Bit 7 marks a run, bit 0-6 are the
+                      number of pixels - 1.
+                    - Run: One palette index for all pixels.
+                      Literal: One palette index per pixel.
+
+"""
+
+import argparse
+import json
+import struct
+import sys
+from PIL import Image
+
+ANIM_SIGNATURE      = b"ANIM"
+ANIM_VERSION        = 1
+ANIM_FLAG_REPEAT    = 0x01
+MAX_PALETTE_SIZE    = 256
+MAX_PACKET_PIXELS   = 128
+PACKET_RUN          = 0x80
+MIN_RUN_PIXELS      = 3
+MIN_SKIP_PIXELS     = 2
+SKIP_CONTINUE       = 255
+
+def get_frames(img, frame_width, frame_height, frames_cnt):
+    """Cut the texture image into frames, ordered from top left to the right
+    and in the next row again from left to right.
+
+    Args:
+        img (Image): Texture image
+        frame_width (int): Frame width in pixels
+        frame_height (int): Frame height in pixels
+        frames_cnt (int): Number of frames
+
+    Returns:
+        list: Frames, every frame is a list of RGB tuples in row order.
+    """
+    frames      = []
+    frames_x    = img.width // frame_width
+
+    for frame_idx in range(frames_cnt):
+        offs_x  = (frame_idx % frames_x) * frame_width
+        offs_y  = (frame_idx // frames_x) * frame_height
+        frame   = []
+
+        for y in range(frame_height):
+            for x in range(frame_width):
+                frame.append(img.getpixel((offs_x + x, offs_y + y))[0:3])
+
+        frames.append(frame)
+
+    return frames
+
+def get_palette(frames):
+    """Get the palette of all frames. The colors are ordered by their
+    frequency, which makes the most used color to the canvas background.
+
+    Args:
+        frames (list): Frames
+
+    Returns:
+        list: Palette with RGB tuples or None if there are too many colors.
+    """
+    histogram = {}
+
+    for frame in frames:
+        for color in frame:
+            histogram[color] = histogram.get(color, 0) + 1
+
+    palette = None
+    if len(histogram) <= MAX_PALETTE_SIZE:
+        palette = sorted(histogram, key=lambda color: histogram[color], reverse=True)
+
+    return palette
+
+def encode_packets(indices):
+    """Encode changed pixels as run and literal packets.
+
+    Args:
+        indices (list): Palette indices of the changed pixels
+
+    Returns:
+        list: Packets
+    """
+    packets     = []
+    literal     = []
+    pos         = 0
+
+    while pos < len(indices):
+        run_len = 1
+
+        while (pos + run_len < len(indices)) and \
+              (indices[pos + run_len] == indices[pos]) and \
+              (run_len < MAX_PACKET_PIXELS):
+            run_len += 1
+
+        if run_len >= MIN_RUN_PIXELS:
+            if len(literal) > 0:
+                packets.append(bytes([len(literal) - 1]) + bytes(literal))
+                literal = []
+
+            packets.append(bytes([PACKET_RUN | (run_len - 1), indices[pos]]))
+            pos += run_len
+        else:
+            literal.append(indices[pos])
+            pos += 1
+
+            if len(literal) == MAX_PACKET_PIXELS:
+                packets.append(bytes([len(literal) - 1]) + bytes(literal))
+                literal = []
+
+    if len(literal) > 0:
+        packets.append(bytes([len(literal) - 1]) + bytes(literal))
+
+    return packets
+
+def encode_skip(skip):
+    """Encode the number of unchanged pixels.
+
+    Args:
+        skip (int): Number of unchanged pixels
+
+    Returns:
+        bytes: Encoded number
+    """
+    data = bytearray()
+
+    while skip >= SKIP_CONTINUE:
+        data.append(SKIP_CONTINUE)
+        skip -= SKIP_CONTINUE
+
+    data.append(skip)
+
+    return bytes(data)
+
+def encode_frame(prev_indices, indices):
+    """Encode the pixels of a frame, which changed compared to the previous one.
+
+    Args:
+        prev_indices (list): Palette indices of the previous frame
+        indices (list): Palette indices of the frame
+
+    Returns:
+        bytes: Frame data
+    """
+    data    = bytearray()
+    pos     = 0
+    skip    = 0
+
+    while pos < len(indices):
+        if indices[pos] == prev_indices[pos]:
+            skip += 1
+            pos += 1
+        else:
+            changed = []
+
+            # Short unchanged gaps are cheaper as part of the changed pixels.
+            while pos < len(indices):
+                gap = 0
+                while (pos + gap < len(indices)) and \
+                      (indices[pos + gap] == prev_indices[pos + gap]):
+                    gap += 1
+
+                if (gap >= MIN_SKIP_PIXELS) or (pos + gap == len(indices)):
+                    break
+
+                changed.extend(indices[pos:pos + gap + 1])
+                pos += gap + 1
+
+            for packet in encode_packets(changed):
+                data += encode_skip(skip)
+                data += packet
+                skip = 0
+
+    return bytes(data)
+
+def create_sprite_anim(frames, palette, frame_width, frame_height, fps, repeat):
+    """Create the sprite animation.
+
+    Args:
+        frames (list): Frames
+        palette (list): Palette
+        frame_width (int): Frame width in pixels
+        frame_height (int): Frame height in pixels
+        fps (int): Frames per second
+        repeat (bool): Repeat animation infinite
+
+    Returns:
+        bytes: Sprite animation
+    """
+    flags = 0
+    if repeat is True:
+        flags |= ANIM_FLAG_REPEAT
+
+    data = bytearray(ANIM_SIGNATURE)
+    data += struct.pack("<BBHHHBBH", ANIM_VERSION, flags, frame_width, frame_height, len(frames), fps, len(palette) - 1, 0)
+
+    for color in palette:
+        data += bytes(color)
+
+    color_to_index  = {color: index for index, color in enumerate(palette)}
+    prev_indices    = [0] * (frame_width * frame_height)
+
+    for frame in frames:
+        indices     = [color_to_index[color] for color in frame]
+        frame_data  = encode_frame(prev_indices, indices)
+
+        data += struct.pack("<H", len(frame_data))
+        data += frame_data
+
+        prev_indices = indices
+
+    return bytes(data)
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Create a sprite animation file.")
+
+    parser.add_argument(
+        "--spriteSheet",
+        dest="sprite_sheet_filename",
+        type=str,
+        required=False,
+        default=None,
+        help="Take frame size, number of frames, fps and repeat from a sprite sheet file (.sprite)."
+    )
+
+    parser.add_argument(
+        "--frameWidth",
+        dest="frame_width",
+        type=int,
+        default=0,
+        help="Frame width in pixels"
+    )
+
+    parser.add_argument(
+        "--frameHeight",
+        dest="frame_height",
+        type=int,
+        default=0,
+        help="Frame height in pixels"
+    )
+
+    parser.add_argument(
+        "--framesCnt",
+        dest="frames_cnt",
+        type=int,
+        required=False,
+        default=0,
+        help="Specify number of frames in case the texture contains gaps. (Default: Derived from texture and frame size.)"
+    )
+
+    parser.add_argument(
+        "--fps",
+        dest="fps",
+        type=int,
+        default=12,
+        help="Frames per second. (Default: 12)"
+    )
+
+    parser.add_argument(
+        "--repeat",
+        dest="repeat",
+        type=str,
+        required=False,
+        default="true",
+        help="Repeat animation infinite. If false it will run just once. (Default: true)"
+    )
+
+    parser.add_argument(
+        "texture_filename",
+        metavar="textureFilename",
+        type=str,
+        help="Texture image filename. Only .bmp is supported."
+    )
+
+    parser.add_argument(
+        "anim_filename",
+        metavar="animFilename",
+        type=str,
+        help="Sprite animation filename, which to create (.anim)."
+    )
+
+    args = parser.parse_args()
+
+    frame_width     = args.frame_width
+    frame_height    = args.frame_height
+    frames_cnt      = args.frames_cnt
+    fps             = args.fps
+    repeat          = True
+
+    if args.repeat.lower() == "false":
+        repeat = False
+
+    if args.sprite_sheet_filename is not None:
+        with open(args.sprite_sheet_filename) as json_file:
+            texture = json.load(json_file)["texture"]
+
+        frame_width     = texture["frame"]["width"]
+        frame_height    = texture["frame"]["height"]
+        frames_cnt      = texture.get("frames", 0)
+        fps             = texture["fps"]
+        repeat          = texture.get("repeat", True)
+
+    if args.texture_filename.endswith(".bmp") is False:
+        print(f'{args.texture_filename} is not supported. Only bitmap files (.bmp) files.')
+        sys.exit(1)
+
+    if (frame_width <= 0) or (frame_height <= 0):
+        print('The frame size is missing.')
+        sys.exit(1)
+
+    print(f'Loading texture image "{args.texture_filename}".')
+
+    img = Image.open(args.texture_filename).convert("RGB")
+
+    print(f'Texture size is {img.width} x {img.height}.')
+
+    frames_x = img.width // frame_width
+    frames_y = img.height // frame_height
+
+    if (frames_cnt == 0) or (frames_cnt > frames_x * frames_y):
+        frames_cnt = frames_x * frames_y
+
+    print(f'{frames_cnt} frames in the texture.')
+
+    frames = get_frames(img, frame_width, frame_height, frames_cnt)
+
+    img.close()
+
+    palette = get_palette(frames)
+
+    if palette is None:
+        print(f'The texture has more than {MAX_PALETTE_SIZE} colors.')
+        sys.exit(1)
+
+    print(f'{len(palette)} colors in the palette.')
+
+    anim_filename = args.anim_filename
+    if anim_filename.endswith(".anim") is False:
+        anim_filename += ".anim"
+
+    anim = create_sprite_anim(frames, palette, frame_width, frame_height, fps, repeat)
+
+    with open(anim_filename, 'wb') as outfile:
+        outfile.write(anim)
+
+    texture_size = frames_cnt * frame_width * frame_height * 3
+
+    print(f'"{anim_filename}" sprite animation created with {len(anim)} byte (texture pixels: {texture_size} byte).')
@@ -121,6 +121,31 @@ public:
      */
     virtual void drawPixel(int16_t x, int16_t y, const TColor& color) = 0;
 
+    /**
+     * Draw a horizontal span of pixels with individual colors.
+     * Pixels outside the canvas are skipped.
+     *
+     * Overwrite it in case the pixels can be written directly, which avoids
+     * a drawPixel() call per pixel.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Pixel colors
+     * @param[in] length    Number of pixels
+     */
+    virtual void drawHSpan(int16_t x, int16_t y, const TColor* colors, uint16_t length)
+    {
+        uint16_t idx = 0U;
+
+        if (nullptr != colors)
+        {
+            for(idx = 0U; idx < length; ++idx)
+            {
+                drawPixel(x + idx, y, colors[idx]);
+            }
+        }
+    }
+
     /**
      * Copy framebuffer content.
      *
@@ -286,18 +311,8 @@ public:
      */
     void drawBitmap(int16_t x, int16_t y, const BaseGfxBitmap<TColor>& bitmap)
     {
-        uint16_t    canvasWidth     = bitmap.getWidth();
-        uint16_t    canvasHeight    = bitmap.getHeight();
-        int16_t     xIndex          = 0;
-        int16_t     yIndex          = 0;
-
-        for(yIndex = 0; yIndex < canvasHeight; ++yIndex)
-        {
-            for(xIndex = 0; xIndex < canvasWidth; ++xIndex)
-            {
-                drawPixel(x + xIndex, y + yIndex, bitmap.getColor(xIndex, yIndex));
-            }
-        }
+        /* The bitmap knows best how to get its pixels. */
+        bitmap.blit(*this, x, y);
     }
 
 protected:
@@ -79,8 +79,49 @@ public:
     {
     }
 
+    /**
+     * Draw the whole bitmap into the given graphics interface, row by row
+     * as spans. Bitmaps which know their pixel layout provide a faster way.
+     *
+     * @param[in] gfx   Graphics interface
+     * @param[in] x     x-coordinate of the upper left bitmap corner
+     * @param[in] y     y-coordinate of the upper left bitmap corner
+     */
+    virtual void blit(BaseGfx<TColor>& gfx, int16_t x, int16_t y) const
+    {
+        TColor      colors[BLIT_CHUNK_SIZE];
+        uint16_t    row     = 0U;
+
+        for(row = 0U; row < this->getHeight(); ++row)
+        {
+            uint16_t column = 0U;
+
+            while(this->getWidth() > column)
+            {
+                uint16_t    count   = this->getWidth() - column;
+                uint16_t    idx     = 0U;
+
+                if (BLIT_CHUNK_SIZE < count)
+                {
+                    count = BLIT_CHUNK_SIZE;
+                }
+
+                for(idx = 0U; idx < count; ++idx)
+                {
+                    colors[idx] = this->getColor(column + idx, row);
+                }
+
+                gfx.drawHSpan(x + column, y + row, colors, count);
+                column += count;
+            }
+        }
+    }
+
 protected:
 
+    /** Max. number of pixels, which are drawn at once by blit(). */
+    static const uint16_t   BLIT_CHUNK_SIZE = 32U;
+
     /**
      * Constructs a bitmap.
      */
@@ -248,6 +289,67 @@ public:
         }
     }
 
+    /**
+     * Draw a horizontal span of pixels with individual colors.
+     * Pixels outside the bitmap are skipped.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Pixel colors
+     * @param[in] length    Number of pixels
+     */
+    virtual void drawHSpan(int16_t x, int16_t y, const TColor* colors, uint16_t length)
+    {
+        int32_t xBegin  = x;
+        int32_t xEnd    = static_cast<int32_t>(x) + length;
+
+        if (0 > xBegin)
+        {
+            xBegin = 0;
+        }
+
+        if (width < xEnd)
+        {
+            xEnd = width;
+        }
+
+        if ((nullptr != colors) &&
+            (0 <= y) &&
+            (height > y) &&
+            (xBegin < xEnd))
+        {
+            TColor*         pixel   = &m_pixels[pixelMap(xBegin, y)];
+            const TColor*   color   = &colors[xBegin - x];
+            int32_t         count   = xEnd - xBegin;
+
+            while(0 < count)
+            {
+                *pixel = *color;
+                ++pixel;
+                ++color;
+                --count;
+            }
+        }
+    }
+
+    /**
+     * Draw the whole bitmap into the given graphics interface.
+     * Every row is drawn directly from the pixel buffer.
+     *
+     * @param[in] gfx   Graphics interface
+     * @param[in] x     x-coordinate of the upper left bitmap corner
+     * @param[in] y     y-coordinate of the upper left bitmap corner
+     */
+    virtual void blit(BaseGfx<TColor>& gfx, int16_t x, int16_t y) const
+    {
+        uint16_t row = 0U;
+
+        for(row = 0U; row < height; ++row)
+        {
+            gfx.drawHSpan(x, y + row, &m_pixels[pixelMap(0U, row)], width);
+        }
+    }
+
 private:
 
     /** Number of pixels in the pixel buffer. */
@@ -514,6 +616,71 @@ public:
         }
     }
 
+    /**
+     * Draw a horizontal span of pixels with individual colors.
+     * Pixels outside the bitmap are skipped.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Pixel colors
+     * @param[in] length    Number of pixels
+     */
+    void drawHSpan(int16_t x, int16_t y, const TColor* colors, uint16_t length)
+    {
+        int32_t xBegin  = x;
+        int32_t xEnd    = static_cast<int32_t>(x) + length;
+
+        if (0 > xBegin)
+        {
+            xBegin = 0;
+        }
+
+        if (m_width < xEnd)
+        {
+            xEnd = m_width;
+        }
+
+        if ((nullptr != m_pixels) &&
+            (nullptr != colors) &&
+            (0 <= y) &&
+            (m_height > y) &&
+            (xBegin < xEnd))
+        {
+            TColor*         pixel   = &m_pixels[pixelMap(xBegin, y)];
+            const TColor*   color   = &colors[xBegin - x];
+            int32_t         count   = xEnd - xBegin;
+
+            while(0 < count)
+            {
+                *pixel = *color;
+                ++pixel;
+                ++color;
+                --count;
+            }
+        }
+    }
+
+    /**
+     * Draw the whole bitmap into the given graphics interface.
+     * Every row is drawn directly from the pixel buffer.
+     *
+     * @param[in] gfx   Graphics interface
+     * @param[in] x     x-coordinate of the upper left bitmap corner
+     * @param[in] y     y-coordinate of the upper left bitmap corner
+     */
+    void blit(BaseGfx<TColor>& gfx, int16_t x, int16_t y) const
+    {
+        if (nullptr != m_pixels)
+        {
+            uint16_t row = 0U;
+
+            for(row = 0U; row < m_height; ++row)
+            {
+                gfx.drawHSpan(x, y + row, &m_pixels[pixelMap(0U, row)], m_width);
+            }
+        }
+    }
+
     /**
      * Use this function to determine whether a internal bitmap buffer is allocated or not.
      * 
@@ -581,120 +748,1270 @@ private:
 };
 
 /**
- * This class provides a bitmap overlay.
+ * This class provides a dynamic allocated bitmap with an alpha channel.
+ * The alpha channel is kept in a separate mask plane with one byte per pixel,
+ * which is only allocated as soon as the first pixel is not opaque. The
+ * colors itself are stored not premultiplied, therefore an opaque bitmap
+ * behaves exactly like a dynamic bitmap.
  * 
  * @tparam TColor   The color representation.
  */
 template < typename TColor >
-class BaseGfxOverlayBitmap : public BaseGfxBitmap<TColor>
+class BaseGfxAlphaBitmap : public BaseGfxDynamicBitmap<TColor>
 {
 public:
 
+    /** Alpha value of a fully opaque pixel. */
+    static const uint8_t    ALPHA_OPAQUE        = 255U;
+
+    /** Alpha value of a fully transparent pixel. */
+    static const uint8_t    ALPHA_TRANSPARENT   = 0U;
+
     /**
-     * Constructs the bitmap overlay.
-     * 
-     * @param[in] gfx   Graphic operations
+     * Constructs the bitmap, but without internal buffer.
      */
-    BaseGfxOverlayBitmap(BaseGfx<TColor>& gfx) :
-        BaseGfxBitmap<TColor>(),
-        m_gfx(gfx)
+    BaseGfxAlphaBitmap() :
+        BaseGfxDynamicBitmap<TColor>(),
+        m_alpha(nullptr),
+        m_transparentCnt(0U),
+        m_translucentCnt(0U)
     {
     }
 
     /**
-     * Constructs the bitmap overlay by copy.
+     * Constructs the bitmap by copy.
      * 
      * @param[in] bitmap    Source bitmap
      */
-    BaseGfxOverlayBitmap(const BaseGfxOverlayBitmap& bitmap) :
-        BaseGfxBitmap<TColor>(bitmap),
-        m_gfx(bitmap.m_gfx)
+    BaseGfxAlphaBitmap(const BaseGfxAlphaBitmap& bitmap) :
+        BaseGfxDynamicBitmap<TColor>(bitmap),
+        m_alpha(nullptr),
+        m_transparentCnt(0U),
+        m_translucentCnt(0U)
     {
+        copyAlpha(bitmap);
     }
 
     /**
-     * Destroys the bitmap overlay.
+     * Destroys the bitmap.
      */
-    virtual ~BaseGfxOverlayBitmap()
+    virtual ~BaseGfxAlphaBitmap()
     {
+        releaseAlpha();
     }
 
     /**
-     * Assigns a bitmap overlay.
+     * Assigns a bitmap.
      * 
      * @param[in] bitmap    Source bitmap
      * 
      * @return Bitmap
      */
-    BaseGfxOverlayBitmap& operator=(const BaseGfxOverlayBitmap& bitmap)
+    BaseGfxAlphaBitmap& operator=(const BaseGfxAlphaBitmap& bitmap)
     {
         if (&bitmap != this)
         {
-            BaseGfxBitmap<TColor>::operator=(bitmap);
+            BaseGfxDynamicBitmap<TColor>::operator=(bitmap);
 
-            m_gfx = bitmap.m_gfx;
+            releaseAlpha();
+            copyAlpha(bitmap);
         }
 
         return *this;
     }
 
     /**
-     * Get the width of the bitmap in pixels.
+     * Create internal pixel buffer. All pixels are opaque.
+     * If a pixel buffer already exists, it will fail.
      * 
-     * @return Width in pixels
+     * @param[in] width     Pixel bitmap width in pixels
+     * @param[in] height    Pixel bitmap height in pixels
+     *
+     * @return If successful, it will return true otherwise false.
      */
-    uint16_t getWidth() const
+    bool create(uint16_t width, uint16_t height)
     {
-        return m_gfx.getWidth();
+        bool isSuccessful = BaseGfxDynamicBitmap<TColor>::create(width, height);
+
+        if (true == isSuccessful)
+        {
+            releaseAlpha();
+        }
+
+        return isSuccessful;
     }
 
     /**
-     * Get the height of the bitmap in pixels.
-     * 
-     * @return Height in pixels
+     * Release the internal pixel buffer and the alpha mask.
      */
-    uint16_t getHeight() const
+    void release()
     {
-        return m_gfx.getHeight();
+        BaseGfxDynamicBitmap<TColor>::release();
+        releaseAlpha();
     }
 
     /**
-     * Get pixel color at given position.
-     * This is used for color manipulation in higher layers.
-     *
+     * Get the alpha value of a pixel.
+     * 
      * @param[in] x x-coordinate
      * @param[in] y y-coordinate
-     *
-     * @return Color
+     * 
+     * @return Alpha value [0; 255] - 0: transparent / 255: opaque
      */
-    TColor& getColor(int16_t x, int16_t y)
+    uint8_t getAlpha(int16_t x, int16_t y) const
     {
-        return m_gfx.getColor(x, y);
+        uint8_t alpha = ALPHA_TRANSPARENT;
+
+        if ((0 <= x) &&
+            (0 <= y) &&
+            (getWidth() > x) &&
+            (getHeight() > y))
+        {
+            if (nullptr == m_alpha)
+            {
+                alpha = ALPHA_OPAQUE;
+            }
+            else
+            {
+                alpha = m_alpha[pixelMap(x, y)];
+            }
+        }
+
+        return alpha;
     }
 
     /**
-     * Get pixel color at given position.
+     * Set the alpha value of a pixel.
+     * The alpha mask is allocated with the first pixel, which is not opaque.
+     * If that fails, the pixel stays opaque.
+     * 
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] alpha Alpha value [0; 255] - 0: transparent / 255: opaque
+     */
+    void setAlpha(int16_t x, int16_t y, uint8_t alpha)
+    {
+        if ((true == BaseGfxDynamicBitmap<TColor>::isAllocated()) &&
+            (0 <= x) &&
+            (0 <= y) &&
+            (getWidth() > x) &&
+            (getHeight() > y))
+        {
+            if ((nullptr == m_alpha) &&
+                (ALPHA_OPAQUE != alpha))
+            {
+                allocateAlpha();
+            }
+
+            if (nullptr != m_alpha)
+            {
+                uint8_t& value = m_alpha[pixelMap(x, y)];
+
+                countAlpha(value, false);
+                value = alpha;
+                countAlpha(value, true);
+            }
+        }
+    }
+
+    /**
+     * Is every pixel of the bitmap opaque?
+     * 
+     * @return If every pixel is opaque, it will return true otherwise false.
+     */
+    bool isOpaque() const
+    {
+        return ((0U == m_transparentCnt) && (0U == m_translucentCnt));
+    }
+
+    /**
+     * Is at least one pixel of the bitmap neither opaque nor transparent?
+     * If not, the alpha channel can be expressed by a color key.
+     * 
+     * @return If a pixel is partial transparent, it will return true otherwise false.
+     */
+    bool isTranslucent() const
+    {
+        return (0U < m_translucentCnt);
+    }
+
+    /**
+     * Get the memory, which is used by the pixel buffer and the alpha mask.
+     * 
+     * @return Memory size in bytes
+     */
+    size_t getMemorySize() const
+    {
+        size_t pixels = static_cast<size_t>(getWidth()) * getHeight();
+
+        return (pixels * sizeof(TColor)) + ((nullptr == m_alpha) ? 0U : pixels);
+    }
+
+    /**
+     * Draw the whole bitmap into the given graphics interface.
+     * An opaque bitmap is drawn directly row by row. Otherwise opaque runs are
+     * drawn as span, transparent pixels are skipped and only the partial
+     * transparent pixels are blended with the graphics interface content.
      *
+     * @param[in] gfx   Graphics interface
+     * @param[in] x     x-coordinate of the upper left bitmap corner
+     * @param[in] y     y-coordinate of the upper left bitmap corner
+     */
+    void blit(BaseGfx<TColor>& gfx, int16_t x, int16_t y) const
+    {
+        if (true == isOpaque())
+        {
+            BaseGfxDynamicBitmap<TColor>::blit(gfx, x, y);
+        }
+        else
+        {
+            const uint16_t  WIDTH   = getWidth();
+            const uint16_t  HEIGHT  = getHeight();
+            uint16_t        row     = 0U;
+
+            for(row = 0U; row < HEIGHT; ++row)
+            {
+                const uint8_t*  alphaRow    = &m_alpha[pixelMap(0U, row)];
+                uint16_t        column      = 0U;
+
+                while(WIDTH > column)
+                {
+                    uint8_t alpha = alphaRow[column];
+
+                    if (ALPHA_OPAQUE == alpha)
+                    {
+                        uint16_t begin = column;
+
+                        while((WIDTH > column) && (ALPHA_OPAQUE == alphaRow[column]))
+                        {
+                            ++column;
+                        }
+
+                        gfx.drawHSpan(x + begin, y + row, &getColor(begin, row), column - begin);
+                    }
+                    else
+                    {
+                        if (ALPHA_TRANSPARENT != alpha)
+                        {
+                            TColor color = gfx.getColor(x + column, y + row);
+
+                            color.blend(getColor(column, row), alpha);
+                            gfx.drawPixel(x + column, y + row, color);
+                        }
+
+                        ++column;
+                    }
+                }
+            }
+        }
+    }
+
+    using BaseGfxDynamicBitmap<TColor>::getWidth;
+    using BaseGfxDynamicBitmap<TColor>::getHeight;
+    using BaseGfxDynamicBitmap<TColor>::getColor;
+
+private:
+
+    uint8_t*    m_alpha;            /**< Alpha mask, only allocated if not opaque */
+    size_t      m_transparentCnt;   /**< Number of transparent pixels */
+    size_t      m_translucentCnt;   /**< Number of partial transparent pixels */
+
+    /**
+     * Map the x- and y-coordinates to the alpha mask index.
+     * No out of bounds check!
+     * 
      * @param[in] x x-coordinate
      * @param[in] y y-coordinate
-     *
-     * @return Color
+     * 
+     * @return Alpha mask position
      */
-    const TColor& getColor(int16_t x, int16_t y) const
+    size_t pixelMap(uint16_t x, uint16_t y) const
     {
-        return m_gfx.getColor(x, y);
+        return x + y * static_cast<size_t>(getWidth());
     }
 
     /**
-     * Draw a single pixel at given position.
-     *
-     * @param[in] x     x-coordinate
-     * @param[in] y     y-coordinate
-     * @param[in] color Color
+     * Update the pixel counters by an alpha value.
+     * 
+     * @param[in] alpha     Alpha value
+     * @param[in] isAdded   Pixel is added (true) or removed (false)
      */
-    virtual void drawPixel(int16_t x, int16_t y, const TColor& color)
+    void countAlpha(uint8_t alpha, bool isAdded)
     {
-        m_gfx.drawPixel(x, y, color);
+        size_t* counter = nullptr;
+
+        if (ALPHA_TRANSPARENT == alpha)
+        {
+            counter = &m_transparentCnt;
+        }
+        else if (ALPHA_OPAQUE != alpha)
+        {
+            counter = &m_translucentCnt;
+        }
+        else
+        {
+            /* Opaque pixels are not counted. */
+            ;
+        }
+
+        if (nullptr != counter)
+        {
+            if (true == isAdded)
+            {
+                ++(*counter);
+            }
+            else
+            {
+                --(*counter);
+            }
+        }
+    }
+
+    /**
+     * Allocate the alpha mask with all pixels opaque.
+     */
+    void allocateAlpha()
+    {
+        const size_t SIZE = static_cast<size_t>(getWidth()) * getHeight();
+
+        m_alpha = new(std::nothrow) uint8_t[SIZE];
+
+        if (nullptr != m_alpha)
+        {
+            size_t idx = 0U;
+
+            for(idx = 0U; idx < SIZE; ++idx)
+            {
+                m_alpha[idx] = ALPHA_OPAQUE;
+            }
+        }
+    }
+
+    /**
+     * Release the alpha mask, which makes all pixels opaque.
+     */
+    void releaseAlpha()
+    {
+        if (nullptr != m_alpha)
+        {
+            delete[] m_alpha;
+            m_alpha = nullptr;
+        }
+
+        m_transparentCnt = 0U;
+        m_translucentCnt = 0U;
+    }
+
+    /**
+     * Copy the alpha mask of the given bitmap. The pixel buffer must
+     * already be copied.
+     * 
+     * @param[in] bitmap    Source bitmap
+     */
+    void copyAlpha(const BaseGfxAlphaBitmap& bitmap)
+    {
+        if ((nullptr != bitmap.m_alpha) &&
+            (getWidth() == bitmap.getWidth()) &&
+            (getHeight() == bitmap.getHeight()))
+        {
+            allocateAlpha();
+
+            if (nullptr != m_alpha)
+            {
+                const size_t    SIZE    = static_cast<size_t>(getWidth()) * getHeight();
+                size_t          idx     = 0U;
+
+                for(idx = 0U; idx < SIZE; ++idx)
+                {
+                    m_alpha[idx] = bitmap.m_alpha[idx];
+                }
+
+                m_transparentCnt = bitmap.m_transparentCnt;
+                m_translucentCnt = bitmap.m_translucentCnt;
+            }
+        }
+    }
+};
+
+/**
+ * This class provides a dynamic allocated bitmap with indexed colors.
+ * Every pixel is an index into a color palette with 2, 4, 16 or 256 entries,
+ * which needs 1, 2, 4 or 8 bits per pixel. Icons typically need only a few
+ * colors, which makes it much smaller than a bitmap with full colors.
+ * 
+ * Only colors which are part of the palette can be drawn.
+ * 
+ * A palette index can be declared as transparent color key. Pixels with this
+ * index are skipped during blit.
+ * 
+ * @tparam TColor   The color representation.
+ */
+template < typename TColor >
+class BaseGfxPaletteBitmap : public BaseGfxBitmap<TColor>
+{
+public:
+
+    /** Max. number of palette colors. */
+    static const uint16_t   MAX_PALETTE_SIZE    = 256U;
+
+    /**
+     * Constructs the bitmap, but without internal buffer.
+     */
+    BaseGfxPaletteBitmap() :
+        BaseGfxBitmap<TColor>(),
+        m_indices(nullptr),
+        m_palette(nullptr),
+        m_width(0U),
+        m_height(0U),
+        m_bpp(0U),
+        m_stride(0U),
+        m_scratch(),
+        m_transparentIndex(NO_TRANSPARENT_INDEX)
+    {
+    }
+
+    /**
+     * Constructs the bitmap by copy.
+     * 
+     * @param[in] bitmap    Source bitmap
+     */
+    BaseGfxPaletteBitmap(const BaseGfxPaletteBitmap& bitmap) :
+        BaseGfxBitmap<TColor>(bitmap),
+        m_indices(nullptr),
+        m_palette(nullptr),
+        m_width(0U),
+        m_height(0U),
+        m_bpp(0U),
+        m_stride(0U),
+        m_scratch(),
+        m_transparentIndex(NO_TRANSPARENT_INDEX)
+    {
+        *this = bitmap;
+    }
+
+    /**
+     * Destroys the bitmap.
+     */
+    virtual ~BaseGfxPaletteBitmap()
+    {
+        release();
+    }
+
+    /**
+     * Assigns a bitmap.
+     * 
+     * @param[in] bitmap    Source bitmap
+     * 
+     * @return Bitmap
+     */
+    BaseGfxPaletteBitmap& operator=(const BaseGfxPaletteBitmap& bitmap)
+    {
+        if (&bitmap != this)
+        {
+            BaseGfxBitmap<TColor>::operator=(bitmap);
+
+            release();
+
+            if ((true == bitmap.isAllocated()) &&
+                (true == create(bitmap.m_width, bitmap.m_height, bitmap.m_bpp)))
+            {
+                const size_t    INDEX_BUFFER_SIZE   = static_cast<size_t>(m_stride) * m_height;
+                size_t          idx                 = 0U;
+
+                for(idx = 0U; idx < INDEX_BUFFER_SIZE; ++idx)
+                {
+                    m_indices[idx] = bitmap.m_indices[idx];
+                }
+
+                for(idx = 0U; idx < getPaletteSize(); ++idx)
+                {
+                    m_palette[idx] = bitmap.m_palette[idx];
+                }
+
+                m_transparentIndex = bitmap.m_transparentIndex;
+            }
+        }
+
+        return *this;
+    }
+
+    /**
+     * Create internal index buffer and palette. All pixels are set to the
+     * first palette color.
+     * If a buffer already exists, it will fail.
+     * 
+     * @param[in] width     Pixel bitmap width in pixels
+     * @param[in] height    Pixel bitmap height in pixels
+     * @param[in] bpp       Bits per pixel: 1, 2, 4 or 8
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool create(uint16_t width, uint16_t height, uint8_t bpp)
+    {
+        bool isSuccessful = false;
+
+        if ((nullptr == m_indices) &&
+            (0U < width) &&
+            (0U < height) &&
+            ((1U == bpp) || (2U == bpp) || (4U == bpp) || (8U == bpp)))
+        {
+            uint16_t    stride  = (static_cast<uint32_t>(width) * bpp + 7U) / 8U;
+            size_t      size    = static_cast<size_t>(stride) * height;
+
+            m_indices = new(std::nothrow) uint8_t[size];
+            m_palette = new(std::nothrow) TColor[1U << bpp];
+
+            if ((nullptr == m_indices) ||
+                (nullptr == m_palette))
+            {
+                release();
+            }
+            else
+            {
+                size_t idx = 0U;
+
+                for(idx = 0U; idx < size; ++idx)
+                {
+                    m_indices[idx] = 0U;
+                }
+
+                m_width     = width;
+                m_height    = height;
+                m_bpp       = bpp;
+                m_stride    = stride;
+
+                isSuccessful = true;
+            }
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Create the bitmap from a bitmap with full colors. The number of bits
+     * per pixel is derived from the number of colors.
+     * If a buffer already exists, it will be released.
+     * 
+     * @param[in] bitmap    Source bitmap
+     * 
+     * @return If the source bitmap has too many colors or not enough memory is available, it will return false otherwise true.
+     */
+    bool convert(const BaseGfxBitmap<TColor>& bitmap)
+    {
+        return convertBitmap(bitmap, nullptr);
+    }
+
+    /**
+     * Create the bitmap from a bitmap with alpha channel. Transparent pixels
+     * get an own palette index, which is used as transparent color key.
+     * If a buffer already exists, it will be released.
+     * 
+     * @param[in] bitmap    Source bitmap
+     * 
+     * @return If the source bitmap has partial transparent pixels, too many colors or not enough memory is available, it will return false otherwise true.
+     */
+    bool convert(const BaseGfxAlphaBitmap<TColor>& bitmap)
+    {
+        bool isSuccessful = false;
+
+        if (true == bitmap.isOpaque())
+        {
+            isSuccessful = convertBitmap(bitmap, nullptr);
+        }
+        else if (false == bitmap.isTranslucent())
+        {
+            isSuccessful = convertBitmap(bitmap, &bitmap);
+        }
+        else
+        {
+            release();
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Release the internal index buffer and palette.
+     */
+    void release()
+    {
+        if (nullptr != m_indices)
+        {
+            delete[] m_indices;
+            m_indices = nullptr;
+        }
+
+        if (nullptr != m_palette)
+        {
+            delete[] m_palette;
+            m_palette = nullptr;
+        }
+
+        m_width     = 0U;
+        m_height    = 0U;
+        m_bpp               = 0U;
+        m_stride            = 0U;
+        m_transparentIndex  = NO_TRANSPARENT_INDEX;
+    }
+
+    /**
+     * Use this function to determine whether a internal bitmap buffer is allocated or not.
+     * 
+     * @return If no bitmap buffer is allocated, it will return false otherwise true.
+     */
+    bool isAllocated() const
+    {
+        return (nullptr != m_indices);
+    }
+
+    /**
+     * Get the width of the bitmap in pixels.
+     * 
+     * @return Width in pixels
+     */
+    uint16_t getWidth() const
+    {
+        return m_width;
+    }
+
+    /**
+     * Get the height of the bitmap in pixels.
+     * 
+     * @return Height in pixels
+     */
+    uint16_t getHeight() const
+    {
+        return m_height;
+    }
+
+    /**
+     * Get the number of bits per pixel.
+     * 
+     * @return Bits per pixel or 0 if not allocated.
+     */
+    uint8_t getBpp() const
+    {
+        return m_bpp;
+    }
+
+    /**
+     * Get the number of palette colors.
+     * 
+     * @return Number of palette colors
+     */
+    uint16_t getPaletteSize() const
+    {
+        return (0U == m_bpp) ? 0U : (1U << m_bpp);
+    }
+
+    /**
+     * Get the memory, which is used by the index buffer and the palette.
+     * 
+     * @return Memory size in bytes
+     */
+    size_t getMemorySize() const
+    {
+        return (static_cast<size_t>(m_stride) * m_height) + (getPaletteSize() * sizeof(TColor));
+    }
+
+    /**
+     * Get a palette color.
+     * 
+     * @param[in] index Palette index
+     * 
+     * @return Color
+     */
+    const TColor& getPaletteColor(uint8_t index) const
+    {
+        static TColor   trash;
+        const TColor*   color   = &trash;
+
+        if (getPaletteSize() > index)
+        {
+            color = &m_palette[index];
+        }
+
+        return *color;
+    }
+
+    /**
+     * Set a palette color. All pixels with this index will change.
+     * 
+     * @param[in] index Palette index
+     * @param[in] color Color
+     */
+    void setPaletteColor(uint8_t index, const TColor& color)
+    {
+        if (getPaletteSize() > index)
+        {
+            m_palette[index] = color;
+        }
+    }
+
+    /**
+     * Declare a palette index as transparent color key. Pixels with this
+     * index are not drawn during blit.
+     * 
+     * @param[in] index Palette index
+     */
+    void setTransparentIndex(uint8_t index)
+    {
+        if (getPaletteSize() > index)
+        {
+            m_transparentIndex = index;
+        }
+    }
+
+    /**
+     * Remove the transparent color key. All pixels are drawn during blit.
+     */
+    void clearTransparentIndex()
+    {
+        m_transparentIndex = NO_TRANSPARENT_INDEX;
+    }
+
+    /**
+     * Is a transparent color key declared?
+     * 
+     * @return If a transparent color key is declared, it will return true otherwise false.
+     */
+    bool hasTransparentIndex() const
+    {
+        return (NO_TRANSPARENT_INDEX != m_transparentIndex);
+    }
+
+    /**
+     * Get the palette index, which is used as transparent color key.
+     * 
+     * @return Palette index, only valid if hasTransparentIndex() returns true.
+     */
+    uint8_t getTransparentIndex() const
+    {
+        return static_cast<uint8_t>(m_transparentIndex);
+    }
+
+    /**
+     * Get the palette index of a pixel.
+     * 
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     * 
+     * @return Palette index
+     */
+    uint8_t getIndex(int16_t x, int16_t y) const
+    {
+        uint8_t index = 0U;
+
+        if ((nullptr != m_indices) &&
+            (0 <= x) &&
+            (0 <= y) &&
+            (m_width > x) &&
+            (m_height > y))
+        {
+            uint8_t pixelsPerByte   = 8U / m_bpp;
+            uint8_t shift           = 8U - m_bpp - ((x % pixelsPerByte) * m_bpp);
+            uint8_t mask            = (1U << m_bpp) - 1U;
+
+            index = (m_indices[y * m_stride + (x / pixelsPerByte)] >> shift) & mask;
+        }
+
+        return index;
+    }
+
+    /**
+     * Set the palette index of a pixel.
+     * 
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] index Palette index
+     */
+    void setIndex(int16_t x, int16_t y, uint8_t index)
+    {
+        if ((nullptr != m_indices) &&
+            (0 <= x) &&
+            (0 <= y) &&
+            (m_width > x) &&
+            (m_height > y) &&
+            (getPaletteSize() > index))
+        {
+            uint8_t     pixelsPerByte   = 8U / m_bpp;
+            uint8_t     shift           = 8U - m_bpp - ((x % pixelsPerByte) * m_bpp);
+            uint8_t     mask            = (1U << m_bpp) - 1U;
+            uint8_t&    data            = m_indices[y * m_stride + (x / pixelsPerByte)];
+
+            data = (data & ~(mask << shift)) | (index << shift);
+        }
+    }
+
+    /**
+     * Get pixel color at given position.
+     * Note, the color can't be manipulated, because it may be shared with
+     * other pixels. Use setPaletteColor() instead.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color
+     */
+    TColor& getColor(int16_t x, int16_t y)
+    {
+        m_scratch = getPaletteColor(getIndex(x, y));
+
+        return m_scratch;
+    }
+
+    /**
+     * Get pixel color at given position.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color
+     */
+    const TColor& getColor(int16_t x, int16_t y) const
+    {
+        return getPaletteColor(getIndex(x, y));
+    }
+
+    /**
+     * Draw a single pixel at given position.
+     * If the color is not part of the palette, it will be skipped.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Color
+     */
+    void drawPixel(int16_t x, int16_t y, const TColor& color)
+    {
+        uint16_t index = findColor(m_palette, getPaletteSize(), color);
+
+        if (getPaletteSize() > index)
+        {
+            setIndex(x, y, index);
+        }
+    }
+
+    /**
+     * Draw the whole bitmap into the given graphics interface. The palette
+     * indices are expanded row by row directly to colors.
+     *
+     * @param[in] gfx   Graphics interface
+     * @param[in] x     x-coordinate of the upper left bitmap corner
+     * @param[in] y     y-coordinate of the upper left bitmap corner
+     */
+    void blit(BaseGfx<TColor>& gfx, int16_t x, int16_t y) const
+    {
+        if (nullptr != m_indices)
+        {
+            if (false == hasTransparentIndex())
+            {
+                blitIndices<false>(gfx, x, y);
+            }
+            else
+            {
+                blitIndices<true>(gfx, x, y);
+            }
+        }
+    }
+
+    /**
+     * Get the number of bits per pixel, which are required for the given
+     * number of colors.
+     * 
+     * @param[in] colors    Number of colors
+     * 
+     * @return Bits per pixel or 0 if there are too many colors.
+     */
+    static uint8_t getBppByColors(uint16_t colors)
+    {
+        uint8_t bpp = 0U;
+
+        if (2U >= colors)
+        {
+            bpp = 1U;
+        }
+        else if (4U >= colors)
+        {
+            bpp = 2U;
+        }
+        else if (16U >= colors)
+        {
+            bpp = 4U;
+        }
+        else if (MAX_PALETTE_SIZE >= colors)
+        {
+            bpp = 8U;
+        }
+        else
+        {
+            /* Too many colors. */
+            ;
+        }
+
+        return bpp;
+    }
+
+private:
+
+    uint8_t*    m_indices;          /**< Palette indices, packed row by row, MSB first */
+    TColor*     m_palette;          /**< Color palette */
+    uint16_t    m_width;            /**< Bitmap width in pixels */
+    uint16_t    m_height;           /**< Bitmap height in pixels */
+    uint8_t     m_bpp;              /**< Bits per pixel */
+    uint16_t    m_stride;           /**< Number of bytes per row */
+    TColor      m_scratch;          /**< Pixel color, which is given for manipulation */
+    uint16_t    m_transparentIndex; /**< Palette index of the transparent color key */
+
+    /** Value of the transparent color key, if no key is declared. */
+    static const uint16_t   NO_TRANSPARENT_INDEX    = MAX_PALETTE_SIZE;
+
+    /**
+     * Find a color in a palette.
+     * 
+     * @param[in] palette       Palette
+     * @param[in] paletteSize   Number of palette colors
+     * @param[in] color         Color to find
+     * 
+     * @return Palette index or the palette size if not found.
+     */
+    static uint16_t findColor(const TColor* palette, uint16_t paletteSize, const TColor& color)
+    {
+        uint16_t idx = 0U;
+
+        while((paletteSize > idx) && (false == (palette[idx] == color)))
+        {
+            ++idx;
+        }
+
+        return idx;
+    }
+
+    /**
+     * Create the bitmap from a bitmap with full colors. If an alpha bitmap is
+     * given, its transparent pixels get the last palette index, which is
+     * declared as transparent color key.
+     * 
+     * @param[in] bitmap        Source bitmap
+     * @param[in] alphaBitmap   Source alpha bitmap, which contains only opaque and transparent pixels or nullptr
+     * 
+     * @return If the source bitmap has too many colors or not enough memory is available, it will return false otherwise true.
+     */
+    bool convertBitmap(const BaseGfxBitmap<TColor>& bitmap, const BaseGfxAlphaBitmap<TColor>* alphaBitmap)
+    {
+        bool        isSuccessful    = false;
+        TColor*     palette         = new(std::nothrow) TColor[MAX_PALETTE_SIZE];
+        uint16_t    paletteSize     = 0U;
+        uint16_t    keySize         = (nullptr == alphaBitmap) ? 0U : 1U;
+        bool        isTooMuch       = false;
+        int16_t     x               = 0;
+        int16_t     y               = 0;
+
+        release();
+
+        if (nullptr != palette)
+        {
+            /* Collect all colors of the visible pixels. */
+            for(y = 0; (y < bitmap.getHeight()) && (false == isTooMuch); ++y)
+            {
+                for(x = 0; (x < bitmap.getWidth()) && (false == isTooMuch); ++x)
+                {
+                    const TColor& color = bitmap.getColor(x, y);
+
+                    if ((false == isTransparent(alphaBitmap, x, y)) &&
+                        (paletteSize <= findColor(palette, paletteSize, color)))
+                    {
+                        if (MAX_PALETTE_SIZE <= (paletteSize + keySize))
+                        {
+                            isTooMuch = true;
+                        }
+                        else
+                        {
+                            palette[paletteSize] = color;
+                            ++paletteSize;
+                        }
+                    }
+                }
+            }
+
+            if ((false == isTooMuch) &&
+                (true == create(bitmap.getWidth(), bitmap.getHeight(), getBppByColors(paletteSize + keySize))))
+            {
+                uint16_t idx = 0U;
+
+                for(idx = 0U; idx < paletteSize; ++idx)
+                {
+                    m_palette[idx] = palette[idx];
+                }
+
+                for(y = 0; y < m_height; ++y)
+                {
+                    for(x = 0; x < m_width; ++x)
+                    {
+                        if (true == isTransparent(alphaBitmap, x, y))
+                        {
+                            setIndex(x, y, paletteSize);
+                        }
+                        else
+                        {
+                            setIndex(x, y, findColor(palette, paletteSize, bitmap.getColor(x, y)));
+                        }
+                    }
+                }
+
+                if (nullptr != alphaBitmap)
+                {
+                    m_transparentIndex = paletteSize;
+                }
+
+                isSuccessful = true;
+            }
+
+            delete[] palette;
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Is the pixel of the alpha bitmap transparent?
+     * 
+     * @param[in] alphaBitmap   Alpha bitmap or nullptr
+     * @param[in] x             x-coordinate
+     * @param[in] y             y-coordinate
+     * 
+     * @return If the pixel is transparent, it will return true otherwise false.
+     */
+    static bool isTransparent(const BaseGfxAlphaBitmap<TColor>* alphaBitmap, int16_t x, int16_t y)
+    {
+        return ((nullptr != alphaBitmap) &&
+                (BaseGfxAlphaBitmap<TColor>::ALPHA_TRANSPARENT == alphaBitmap->getAlpha(x, y)));
+    }
+
+    /**
+     * Select the row expansion, which fits to the number of bits per pixel.
+     * 
+     * @tparam isKeyed  Skip pixels with the transparent color key or not
+     * 
+     * @param[in] gfx   Graphics interface
+     * @param[in] x     x-coordinate of the upper left bitmap corner
+     * @param[in] y     y-coordinate of the upper left bitmap corner
+     */
+    template < bool isKeyed >
+    void blitIndices(BaseGfx<TColor>& gfx, int16_t x, int16_t y) const
+    {
+        switch(m_bpp)
+        {
+        case 1U:
+            blitRows<1U, isKeyed>(gfx, x, y);
+            break;
+
+        case 2U:
+            blitRows<2U, isKeyed>(gfx, x, y);
+            break;
+
+        case 4U:
+            blitRows<4U, isKeyed>(gfx, x, y);
+            break;
+
+        case 8U:
+            blitRows<8U, isKeyed>(gfx, x, y);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    /**
+     * Expand the palette indices row by row and draw them as span.
+     * The number of bits per pixel is known at compile time, which keeps
+     * the inner loop free of any division. Without color key the check
+     * for transparent pixels is removed at compile time as well.
+     * 
+     * @tparam bpp      Bits per pixel
+     * @tparam isKeyed  Skip pixels with the transparent color key or not
+     * 
+     * @param[in] gfx   Graphics interface
+     * @param[in] x     x-coordinate of the upper left bitmap corner
+     * @param[in] y     y-coordinate of the upper left bitmap corner
+     */
+    template < uint8_t bpp, bool isKeyed >
+    void blitRows(BaseGfx<TColor>& gfx, int16_t x, int16_t y) const
+    {
+        const uint8_t   PIXELS_PER_BYTE = 8U / bpp;
+        const uint8_t   MASK            = (1U << bpp) - 1U;
+        TColor          colors[BaseGfxBitmap<TColor>::BLIT_CHUNK_SIZE];
+        uint16_t        row             = 0U;
+
+        for(row = 0U; row < m_height; ++row)
+        {
+            const uint8_t*  indices = &m_indices[row * m_stride];
+            uint16_t        column  = 0U;
+            uint16_t        count   = 0U;
+
+            for(column = 0U; column < m_width; ++column)
+            {
+                uint8_t shift   = 8U - bpp - ((column % PIXELS_PER_BYTE) * bpp);
+                uint8_t index   = (indices[column / PIXELS_PER_BYTE] >> shift) & MASK;
+
+                if ((true == isKeyed) &&
+                    (m_transparentIndex == index))
+                {
+                    if (0U < count)
+                    {
+                        gfx.drawHSpan(x + column - count, y + row, colors, count);
+                        count = 0U;
+                    }
+                }
+                else
+                {
+                    colors[count] = m_palette[index];
+                    ++count;
+
+                    if (BaseGfxBitmap<TColor>::BLIT_CHUNK_SIZE == count)
+                    {
+                        gfx.drawHSpan(x + column + 1 - count, y + row, colors, count);
+                        count = 0U;
+                    }
+                }
+            }
+
+            if (0U < count)
+            {
+                gfx.drawHSpan(x + m_width - count, y + row, colors, count);
+            }
+        }
+    }
+};
+
+/**
+ * This class provides a bitmap overlay.
+ * 
+ * @tparam TColor   The color representation.
+ */
+template < typename TColor >
+class BaseGfxOverlayBitmap : public BaseGfxBitmap<TColor>
+{
+public:
+
+    /**
+     * Constructs the bitmap overlay.
+     * 
+     * @param[in] gfx   Graphic operations
+     */
+    BaseGfxOverlayBitmap(BaseGfx<TColor>& gfx) :
+        BaseGfxBitmap<TColor>(),
+        m_gfx(gfx)
+    {
+    }
+
+    /**
+     * Constructs the bitmap overlay by copy.
+     * 
+     * @param[in] bitmap    Source bitmap
+     */
+    BaseGfxOverlayBitmap(const BaseGfxOverlayBitmap& bitmap) :
+        BaseGfxBitmap<TColor>(bitmap),
+        m_gfx(bitmap.m_gfx)
+    {
+    }
+
+    /**
+     * Destroys the bitmap overlay.
+     */
+    virtual ~BaseGfxOverlayBitmap()
+    {
+    }
+
+    /**
+     * Assigns a bitmap overlay.
+     * 
+     * @param[in] bitmap    Source bitmap
+     * 
+     * @return Bitmap
+     */
+    BaseGfxOverlayBitmap& operator=(const BaseGfxOverlayBitmap& bitmap)
+    {
+        if (&bitmap != this)
+        {
+            BaseGfxBitmap<TColor>::operator=(bitmap);
+
+            m_gfx = bitmap.m_gfx;
+        }
+
+        return *this;
+    }
+
+    /**
+     * Get the width of the bitmap in pixels.
+     * 
+     * @return Width in pixels
+     */
+    uint16_t getWidth() const
+    {
+        return m_gfx.getWidth();
+    }
+
+    /**
+     * Get the height of the bitmap in pixels.
+     * 
+     * @return Height in pixels
+     */
+    uint16_t getHeight() const
+    {
+        return m_gfx.getHeight();
+    }
+
+    /**
+     * Get pixel color at given position.
+     * This is used for color manipulation in higher layers.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color
+     */
+    TColor& getColor(int16_t x, int16_t y)
+    {
+        return m_gfx.getColor(x, y);
+    }
+
+    /**
+     * Get pixel color at given position.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return Color
+     */
+    const TColor& getColor(int16_t x, int16_t y) const
+    {
+        return m_gfx.getColor(x, y);
+    }
+
+    /**
+     * Draw a single pixel at given position.
+     *
+     * @param[in] x     x-coordinate
+     * @param[in] y     y-coordinate
+     * @param[in] color Color
+     */
+    virtual void drawPixel(int16_t x, int16_t y, const TColor& color)
+    {
+        m_gfx.drawPixel(x, y, color);
+    }
+
+    /**
+     * Draw a horizontal span of pixels with individual colors.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Pixel colors
+     * @param[in] length    Number of pixels
+     */
+    virtual void drawHSpan(int16_t x, int16_t y, const TColor* colors, uint16_t length)
+    {
+        m_gfx.drawHSpan(x, y, colors, length);
     }
 
 private:
@@ -303,6 +303,40 @@ public:
         }
     }
 
+    /**
+     * Draw a horizontal span of pixels with individual colors.
+     * Pixels outside the map canvas are skipped.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Pixel colors
+     * @param[in] length    Number of pixels
+     */
+    void drawHSpan(int16_t x, int16_t y, const TColor* colors, uint16_t length) final
+    {
+        int32_t xBegin  = x;
+        int32_t xEnd    = static_cast<int32_t>(x) + length;
+
+        if (0 > xBegin)
+        {
+            xBegin = 0;
+        }
+
+        if (m_width < xEnd)
+        {
+            xEnd = m_width;
+        }
+
+        if ((nullptr != m_gfx) &&
+            (nullptr != colors) &&
+            (0 <= y) &&
+            (m_height > y) &&
+            (xBegin < xEnd))
+        {
+            m_gfx->drawHSpan(xBegin + m_offsX, y + m_offsY, &colors[xBegin - x], xEnd - xBegin);
+        }
+    }
+
 private:
 
     BaseGfx<TColor>*    m_gfx;      /**< The underlying graphic operations. */
@@ -0,0 +1,547 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Basic procedural shader engine
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __BASE_GFX_SHADER_HPP__
+#define __BASE_GFX_SHADER_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include <BaseGfx.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * State type for kernels, which don't need any state per pixel.
+ * The shader engine won't allocate a state buffer for them.
+ */
+struct BaseGfxShaderNoState
+{
+};
+
+/**
+ * Shader state traits, used to decide at compile time whether a state
+ * buffer per pixel is necessary.
+ *
+ * @tparam TState The state per pixel.
+ */
+template < typename TState >
+struct BaseGfxShaderStateTraits
+{
+    static const bool IS_STATEFUL = true; /**< Kernel has a state per pixel */
+};
+
+/**
+ * Shader state traits of stateless kernels.
+ */
+template <>
+struct BaseGfxShaderStateTraits<BaseGfxShaderNoState>
+{
+    static const bool IS_STATEFUL = false; /**< Kernel has no state per pixel */
+};
+
+/**
+ * Read only view on the state of the previous frame.
+ * Coordinates outside the frame are clamped to its border, which keeps the
+ * kernels free of any boundary handling.
+ *
+ * @tparam TState The state per pixel.
+ */
+template < typename TState >
+class BaseGfxShaderStateView
+{
+public:
+
+    /**
+     * Constructs a state view.
+     *
+     * @param[in] states    States row by row.
+     * @param[in] width     Frame width in pixels.
+     * @param[in] height    Frame height in pixels.
+     * @param[in] stride    Number of states per row. Stateless kernels use 0.
+     */
+    BaseGfxShaderStateView(const TState* states, uint16_t width, uint16_t height, uint16_t stride) :
+        m_states(states),
+        m_width(width),
+        m_height(height),
+        m_stride(stride)
+    {
+    }
+
+    /**
+     * Destroys the state view.
+     */
+    ~BaseGfxShaderStateView()
+    {
+    }
+
+    /**
+     * Get frame width in pixels.
+     *
+     * @return Width in pixels
+     */
+    uint16_t getWidth() const
+    {
+        return m_width;
+    }
+
+    /**
+     * Get frame height in pixels.
+     *
+     * @return Height in pixels
+     */
+    uint16_t getHeight() const
+    {
+        return m_height;
+    }
+
+    /**
+     * Get the state of the previous frame at the given position.
+     *
+     * @param[in] x x-coordinate, will be clamped to the frame.
+     * @param[in] y y-coordinate, will be clamped to the frame.
+     *
+     * @return State
+     */
+    const TState& get(int16_t x, int16_t y) const
+    {
+        return getRow(y)[clamp(x, m_width)];
+    }
+
+    /**
+     * Get the states of a whole row of the previous frame.
+     *
+     * @param[in] y y-coordinate, will be clamped to the frame.
+     *
+     * @return States of the row
+     */
+    const TState* getRow(int16_t y) const
+    {
+        return &m_states[static_cast<size_t>(clamp(y, m_height)) * m_stride];
+    }
+
+private:
+
+    const TState*   m_states;   /**< States row by row */
+    uint16_t        m_width;    /**< Frame width in pixels */
+    uint16_t        m_height;   /**< Frame height in pixels */
+    uint16_t        m_stride;   /**< Number of states per row */
+
+    BaseGfxShaderStateView();
+
+    /**
+     * Clamp coordinate to [0; size - 1].
+     *
+     * @param[in] value Coordinate
+     * @param[in] size  Size in pixels
+     *
+     * @return Clamped coordinate
+     */
+    static uint16_t clamp(int16_t value, uint16_t size)
+    {
+        uint16_t clamped = 0U;
+
+        if (0 > value)
+        {
+            clamped = 0U;
+        }
+        else if (size <= static_cast<uint16_t>(value))
+        {
+            clamped = size - 1U;
+        }
+        else
+        {
+            clamped = value;
+        }
+
+        return clamped;
+    }
+};
+
+/**
+ * Base of a per pixel kernel. The derived kernel only provides the method
+ * for a single pixel, which is inlined into the row loop at compile time:
+ *
+ * TColor shade(int16_t x, int16_t y, uint32_t t, const BaseGfxShaderStateView<TState>& prev, TState& next);
+ *
+ * - x, y: Pixel coordinates.
+ * - t: Fixed point time, see BaseGfxShader::TIME_FRAC_BITS.
+ * - prev: State of the previous frame.
+ * - next: State of this pixel in the next frame.
+ *
+ * @tparam TColor   The color representation.
+ * @tparam TState   The state per pixel.
+ * @tparam TKernel  The derived kernel.
+ */
+template < typename TColor, typename TState, typename TKernel >
+class BaseGfxPixelKernel
+{
+public:
+
+    /** State per pixel */
+    typedef TState State;
+
+    /**
+     * Shade a whole row by calling the per pixel kernel.
+     *
+     * @param[in]   y       y-coordinate of the row.
+     * @param[in]   t       Fixed point time.
+     * @param[in]   prev    State of the previous frame.
+     * @param[out]  next    States of the row in the next frame.
+     * @param[out]  colors  Colors of the row.
+     * @param[in]   width   Row width in pixels.
+     */
+    void shadeRow(int16_t y, uint32_t t, const BaseGfxShaderStateView<TState>& prev, TState* next, TColor* colors, uint16_t width)
+    {
+        TKernel&    kernel  = static_cast<TKernel&>(*this);
+        uint16_t    x       = 0U;
+
+        for(x = 0U; x < width; ++x)
+        {
+            colors[x] = kernel.shade(x, y, t, prev, next[x]);
+        }
+
+        return;
+    }
+
+protected:
+
+    /**
+     * Constructs the pixel kernel.
+     */
+    BaseGfxPixelKernel()
+    {
+    }
+
+    /**
+     * Destroys the pixel kernel.
+     */
+    ~BaseGfxPixelKernel()
+    {
+    }
+};
+
+/**
+ * Procedural shader engine. It iterates over the frame, advances the fixed
+ * point time, handles the double buffered state per pixel and writes the
+ * colors row by row via the span API.
+ *
+ * The kernel is a functor, which provides the type of the state per pixel
+ * and the method to shade a whole row:
+ *
+ * typedef ... State;
+ * void shadeRow(int16_t y, uint32_t t, const BaseGfxShaderStateView<State>& prev, State* next, TColor* colors, uint16_t width);
+ *
+ * Kernels, which are easier to write per pixel, derive from BaseGfxPixelKernel.
+ * Kernels without state use BaseGfxShaderNoState, which needs no state buffer.
+ *
+ * @tparam TColor   The color representation.
+ * @tparam TKernel  The kernel, which calculates the frame.
+ */
+template < typename TColor, typename TKernel >
+class BaseGfxShader
+{
+public:
+
+    /** State per pixel */
+    typedef typename TKernel::State State;
+
+    /** Number of fractional bits of the time. */
+    static const uint8_t    TIME_FRAC_BITS  = 8U;
+
+    /** One time unit in fixed point representation. */
+    static const uint32_t   TIME_ONE        = 1U << TIME_FRAC_BITS;
+
+    /**
+     * Constructs the shader engine.
+     */
+    BaseGfxShader() :
+        m_kernel(),
+        m_width(0U),
+        m_height(0U),
+        m_stride(0U),
+        m_stateBuffer(nullptr),
+        m_current(0U),
+        m_rowColors(nullptr),
+        m_time(0U)
+    {
+        m_states[0] = nullptr;
+        m_states[1] = nullptr;
+    }
+
+    /**
+     * Destroys the shader engine.
+     */
+    ~BaseGfxShader()
+    {
+        release();
+    }
+
+    /**
+     * Allocate the state buffers and the row buffer for the given frame size.
+     * A previous allocation is released.
+     *
+     * @param[in] width     Frame width in pixels.
+     * @param[in] height    Frame height in pixels.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool create(uint16_t width, uint16_t height)
+    {
+        bool isSuccessful = false;
+
+        release();
+
+        if ((0U < width) &&
+            (0U < height))
+        {
+            /* Stateless kernels share a single row of dummy states. */
+            size_t  numStates   = width;
+
+            if (true == BaseGfxShaderStateTraits<State>::IS_STATEFUL)
+            {
+                numStates *= height;
+            }
+
+            m_stateBuffer   = new(std::nothrow) State[2U * numStates];
+            m_rowColors     = new(std::nothrow) TColor[width];
+
+            if ((nullptr == m_stateBuffer) ||
+                (nullptr == m_rowColors))
+            {
+                release();
+            }
+            else
+            {
+                m_width     = width;
+                m_height    = height;
+                m_stride    = (true == BaseGfxShaderStateTraits<State>::IS_STATEFUL) ? width : 0U;
+                m_states[0] = &m_stateBuffer[0];
+                m_states[1] = &m_stateBuffer[numStates];
+                m_current   = 0U;
+
+                isSuccessful = true;
+            }
+        }
+
+        return isSuccessful;
+    }
+
+    /**
+     * Release all buffers.
+     */
+    void release()
+    {
+        if (nullptr != m_stateBuffer)
+        {
+            delete[] m_stateBuffer;
+            m_stateBuffer = nullptr;
+        }
+
+        if (nullptr != m_rowColors)
+        {
+            delete[] m_rowColors;
+            m_rowColors = nullptr;
+        }
+
+        m_states[0] = nullptr;
+        m_states[1] = nullptr;
+        m_width     = 0U;
+        m_height    = 0U;
+        m_stride    = 0U;
+
+        return;
+    }
+
+    /**
+     * Is the shader engine ready to render?
+     *
+     * @return If buffers are available, it will return true otherwise false.
+     */
+    bool isCreated() const
+    {
+        return (nullptr != m_stateBuffer);
+    }
+
+    /**
+     * Reset time and the state of every pixel to its default.
+     */
+    void reset()
+    {
+        if (nullptr != m_stateBuffer)
+        {
+            size_t  numStates   = static_cast<size_t>(m_stride) * m_height;
+            size_t  idx         = 0U;
+
+            for(idx = 0U; idx < numStates; ++idx)
+            {
+                m_states[m_current][idx] = State();
+            }
+        }
+
+        m_time = 0U;
+
+        return;
+    }
+
+    /**
+     * Get the kernel, e.g. to change its parameters.
+     *
+     * @return Kernel
+     */
+    TKernel& getKernel()
+    {
+        return m_kernel;
+    }
+
+    /**
+     * Get the kernel.
+     *
+     * @return Kernel
+     */
+    const TKernel& getKernel() const
+    {
+        return m_kernel;
+    }
+
+    /**
+     * Get the current fixed point time.
+     *
+     * @return Time
+     */
+    uint32_t getTime() const
+    {
+        return m_time;
+    }
+
+    /**
+     * Advance the time. The unit is given by the kernel, e.g. frames or
+     * seconds.
+     *
+     * @param[in] delta Fixed point time delta.
+     */
+    void advance(uint32_t delta = TIME_ONE)
+    {
+        m_time += delta;
+        return;
+    }
+
+    /**
+     * Get the current state of a pixel, e.g. to inject something from outside.
+     * The state is considered by the next rendering.
+     *
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     *
+     * @return State, which is nullptr if the coordinates are invalid.
+     */
+    State* getState(uint16_t x, uint16_t y)
+    {
+        State* state = nullptr;
+
+        if ((nullptr != m_stateBuffer) &&
+            (m_width > x) &&
+            (m_height > y) &&
+            (true == BaseGfxShaderStateTraits<State>::IS_STATEFUL))
+        {
+            state = &m_states[m_current][static_cast<size_t>(y) * m_stride + x];
+        }
+
+        return state;
+    }
+
+    /**
+     * Render a whole frame. Afterwards the next state becomes the current state.
+     *
+     * @param[in] gfx   Graphics interface.
+     * @param[in] x     x-coordinate of the upper left frame corner.
+     * @param[in] y     y-coordinate of the upper left frame corner.
+     */
+    void render(BaseGfx<TColor>& gfx, int16_t x = 0, int16_t y = 0)
+    {
+        if (nullptr != m_stateBuffer)
+        {
+            BaseGfxShaderStateView<State>   prev(m_states[m_current], m_width, m_height, m_stride);
+            State*                          next    = m_states[1U - m_current];
+            uint16_t                        row     = 0U;
+
+            for(row = 0U; row < m_height; ++row)
+            {
+                m_kernel.shadeRow(row, m_time, prev, &next[static_cast<size_t>(row) * m_stride], m_rowColors, m_width);
+                gfx.drawHSpan(x, y + row, m_rowColors, m_width);
+            }
+
+            m_current = 1U - m_current;
+        }
+
+        return;
+    }
+
+private:
+
+    TKernel     m_kernel;       /**< Kernel, which calculates the frame */
+    uint16_t    m_width;        /**< Frame width in pixels */
+    uint16_t    m_height;       /**< Frame height in pixels */
+    uint16_t    m_stride;       /**< Number of states per row */
+    State*      m_stateBuffer;  /**< Buffer of both state frames */
+    State*      m_states[2];    /**< Current and next state frame */
+    uint8_t     m_current;      /**< Index of the current state frame */
+    TColor*     m_rowColors;    /**< Colors of the row, which is shaded */
+    uint32_t    m_time;         /**< Fixed point time */
+
+    BaseGfxShader(const BaseGfxShader& shader);
+    BaseGfxShader& operator=(const BaseGfxShader& shader);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __BASE_GFX_SHADER_HPP__ */
+
+/** @} */
@@ -101,6 +101,13 @@ public:
      */
     virtual void clear() = 0;
 
+    /**
+     * Copy the framebuffer row by row into the given graphics interface.
+     *
+     * @param[in] gfx   Destination, e.g. a bitmap with the display size.
+     */
+    virtual void copyTo(YAGfx& gfx) const = 0;
+
 protected:
 
     /**
@@ -70,7 +70,9 @@ Display::Display() :
     IDisplay(),
     m_strip(Board::LedMatrix::width * Board::LedMatrix::height, Board::Pin::ledMatrixDataOutPinNo),
     m_topo(Board::LedMatrix::width, Board::LedMatrix::height),
-    m_ledMatrix()
+    m_ledMatrix(),
+    m_colorLut(),
+    m_brightness(m_colorLut.getBrightness())
 {
 }
 
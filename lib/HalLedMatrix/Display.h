@@ -40,13 +40,18 @@
  * Compile Switches
  *****************************************************************************/
 
+#ifndef CONFIG_DISPLAY_DITHERING_ENABLE
+#define CONFIG_DISPLAY_DITHERING_ENABLE (0)
+#endif  /* CONFIG_DISPLAY_DITHERING_ENABLE */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
 #include <stdint.h>
 #include <IDisplay.hpp>
-#include <NeoPixelBrightnessBus.h>
+#include <NeoPixelBus.h>
 #include <ColorDef.hpp>
+#include <ColorLut.h>
 #include <YAGfxBitmap.h>
 
 #include "Board.h"
@@ -61,6 +66,8 @@
 
 /**
  * This display represents a LED matrix of 32x8 NeoPixels (WS2812B).
+ * The framebuffer colors are gamma corrected, white balanced and scaled
+ * by the brightness via lookup tables, before they are sent to the LEDs.
  */
 class Display : public IDisplay
 {
@@ -100,11 +107,21 @@ public:
         int16_t x = 0;
         int16_t y = 0;
 
+        /* The lookup tables are only changed here, so they are never
+         * calculated again while they are in use.
+         */
+        m_colorLut.setBrightness(m_brightness);
+
         for(y = 0; y < m_ledMatrix.getHeight(); ++y)
         {
             for(x = 0; x < m_ledMatrix.getWidth(); ++x)
             {
-                HtmlColor htmlColor = static_cast<uint32_t>(m_ledMatrix.getColor(x, y));
+#if (0 != CONFIG_DISPLAY_DITHERING_ENABLE)
+                ColorLut::Residual& residual    = m_residuals[y * Board::LedMatrix::width + x];
+                HtmlColor           htmlColor   = static_cast<uint32_t>(m_colorLut.apply(m_ledMatrix.getColor(x, y), residual));
+#else   /* (0 != CONFIG_DISPLAY_DITHERING_ENABLE) */
+                HtmlColor           htmlColor   = static_cast<uint32_t>(m_colorLut.apply(m_ledMatrix.getColor(x, y)));
+#endif  /* (0 != CONFIG_DISPLAY_DITHERING_ENABLE) */
 
                 m_strip.SetPixelColor(m_topo.Map(x, y), htmlColor);
             }
@@ -127,6 +144,7 @@ public:
 
     /**
      * Set brightness from 0 to 255.
+     * It takes effect with the next show().
      *
      * @param[in] brightness    Brightness value [0; 255]
      */
@@ -139,7 +157,7 @@ public:
             (Board::LedMatrix::supplyCurrentMax * brightness) /
             (Board::LedMatrix::maxCurrentPerLed * Board::LedMatrix::width *Board::LedMatrix::height);
 
-        m_strip.SetBrightness(SAFE_BRIGHTNESS);
+        m_brightness = SAFE_BRIGHTNESS;
         return;
     }
 
@@ -154,6 +172,17 @@ public:
         return;
     }
 
+    /**
+     * Copy the framebuffer row by row into the given graphics interface.
+     *
+     * @param[in] gfx   Destination, e.g. a bitmap with the display size.
+     */
+    void copyTo(YAGfx& gfx) const final
+    {
+        m_ledMatrix.blit(gfx, 0, 0);
+        return;
+    }
+
     /**
      * Get width in pixel.
      *
@@ -203,7 +232,7 @@ public:
 private:
 
     /** Pixel representation of the LED matrix */
-    NeoPixelBrightnessBus<NeoGrbFeature, Neo800KbpsMethod>                  m_strip;
+    NeoPixelBus<NeoGrbFeature, Neo800KbpsMethod>                            m_strip;
 
     /** Panel topology, used to map coordinates to the framebuffer. */
     NeoTopology<ColumnMajorAlternatingLayout>                               m_topo;
@@ -214,6 +243,17 @@ private:
      */
     YAGfxStaticBitmap<Board::LedMatrix::width, Board::LedMatrix::height>    m_ledMatrix;
 
+    /** Transforms the framebuffer colors to the LED colors. */
+    ColorLut                                                                m_colorLut;
+
+    /** Brightness, which is applied to the lookup tables by the next show(). */
+    volatile uint8_t                                                        m_brightness;
+
+#if (0 != CONFIG_DISPLAY_DITHERING_ENABLE)
+    /** Residual fraction per LED, which is carried to the next frame. */
+    ColorLut::Residual                                                      m_residuals[Board::LedMatrix::width * Board::LedMatrix::height];
+#endif  /* (0 != CONFIG_DISPLAY_DITHERING_ENABLE) */
+
     /**
      * Construct display.
      */
@@ -238,6 +278,19 @@ private:
     {
         m_ledMatrix.drawPixel(x, y, color);
     }
+
+    /**
+     * Draw a horizontal span of pixels on the display.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Pixel colors in RGB888 format
+     * @param[in] length    Number of pixels
+     */
+    void drawHSpan(int16_t x, int16_t y, const Color* colors, uint16_t length) final
+    {
+        m_ledMatrix.drawHSpan(x, y, colors, length);
+    }
 };
 
 /******************************************************************************
@@ -70,8 +70,11 @@ Display::Display() :
     IDisplay(),
     m_tft(),
     m_ledMatrix(),
+    m_colorLut(),
     m_brightness(DEFAULT_BRIGHTNESS)
 {
+    m_colorLut.setGamma(1.0F);
+    m_colorLut.setBrightness(DEFAULT_BRIGHTNESS);
 }
 
 Display::~Display()
@@ -47,6 +47,7 @@
 #include <IDisplay.hpp>
 #include <ColorDef.hpp>
 #include <TFT_eSPI.h>
+#include <ColorLut.h>
 #include <YAGfxBitmap.h>
 
 #include "Board.h"
@@ -61,6 +62,9 @@
 
 /**
  * This display represents a graphic TFT display.
+ * The framebuffer colors are white balanced and scaled by the brightness
+ * via lookup tables. The TFT applies its own gamma, therefore no gamma
+ * correction is done.
  */
 class Display : public IDisplay
 {
@@ -100,16 +104,16 @@ public:
         int32_t x = 0;
         int32_t y = 0;
 
+        /* The lookup tables are only changed here, so they are never
+         * calculated again while they are in use.
+         */
+        m_colorLut.setBrightness(m_brightness);
+
         for(y = 0; y < MATRIX_HEIGHT; ++y)
         {
             for(x = 0; x < MATRIX_WIDTH; ++x)
             {
-                Color       brightnessAdjustedColor = m_ledMatrix.getColor(x, y);
-                uint16_t    intensity               = brightnessAdjustedColor.getIntensity();
-
-                intensity *= (static_cast<uint16_t>(m_brightness) + 1U);
-                intensity /= 256U;
-                brightnessAdjustedColor.setIntensity(static_cast<uint8_t>(intensity));
+                Color brightnessAdjustedColor = m_colorLut.apply(m_ledMatrix.getColor(x, y));
 
                 m_tft.fillRect( y * (PIXEL_HEIGHT + PiXEL_DISTANCE) + BORDER_Y,
                                 TFT_HEIGHT - (x * (PIXEL_WIDTH  + PiXEL_DISTANCE) + BORDER_X) - 1,
@@ -136,6 +140,7 @@ public:
     /**
      * Set brightness from 0 to 255.
      * 255 = max. brightness.
+     * It takes effect with the next show().
      *
      * @param[in] brightness    Brightness value [0; 255]
      */
@@ -157,6 +162,17 @@ public:
         return;
     }
 
+    /**
+     * Copy the framebuffer row by row into the given graphics interface.
+     *
+     * @param[in] gfx   Destination, e.g. a bitmap with the display size.
+     */
+    void copyTo(YAGfx& gfx) const final
+    {
+        m_ledMatrix.blit(gfx, 0, 0);
+        return;
+    }
+
     /**
      * Get width in pixel.
      *
@@ -233,7 +249,8 @@ private:
 
     TFT_eSPI                                        m_tft;          /**< T-Display driver */
     YAGfxStaticBitmap<MATRIX_WIDTH, MATRIX_HEIGHT>  m_ledMatrix;    /**< Simulated LED matrix framebuffer */
-    uint8_t                                         m_brightness;   /**< Display brightness [0; 255] value. 255 = max. brightness. */
+    ColorLut                                        m_colorLut;     /**< Transforms the framebuffer colors to the TFT colors. */
+    volatile uint8_t                                m_brightness;   /**< Brightness, which is applied to the lookup tables by the next show(). */
 
     /**
      * Construct display.
@@ -259,6 +276,19 @@ private:
     {
         m_ledMatrix.drawPixel(x, y, color);
     }
+
+    /**
+     * Draw a horizontal span of pixels on the display.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Pixel colors in RGB888 format
+     * @param[in] length    Number of pixels
+     */
+    void drawHSpan(int16_t x, int16_t y, const Color* colors, uint16_t length) final
+    {
+        m_ledMatrix.drawHSpan(x, y, colors, length);
+    }
 };
 
 /******************************************************************************
@@ -0,0 +1,450 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Game of life grid
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "LifeGrid.h"
+
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static inline void fullAdd(uint32_t a, uint32_t b, uint32_t c, uint32_t& sum, uint32_t& carry);
+static inline void halfAdd(uint32_t a, uint32_t b, uint32_t& sum, uint32_t& carry);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+LifeGrid::LifeGrid() :
+    m_width(0U),
+    m_height(0U),
+    m_wordsPerRow(0U),
+    m_lastWordBits(0U),
+    m_lastWordMask(0U),
+    m_cells(nullptr),
+    m_nextCells(nullptr),
+    m_generation(0U),
+    m_history(),
+    m_historyIdx(0U),
+    m_historyCnt(0U),
+    m_period(0U)
+{
+}
+
+LifeGrid::~LifeGrid()
+{
+    destroy();
+}
+
+bool LifeGrid::create(uint16_t width, uint16_t height)
+{
+    bool isSuccessful = false;
+
+    destroy();
+
+    if ((0U < width) &&
+        (0U < height))
+    {
+        size_t gridSize = 0U;
+
+        m_width         = width;
+        m_height        = height;
+        m_wordsPerRow   = (width + (BITS - 1U)) / BITS;
+        m_lastWordBits  = width - ((m_wordsPerRow - 1U) * BITS);
+
+        if (BITS == m_lastWordBits)
+        {
+            m_lastWordMask = UINT32_MAX;
+        }
+        else
+        {
+            m_lastWordMask = (1U << m_lastWordBits) - 1U;
+        }
+
+        gridSize    = static_cast<size_t>(m_wordsPerRow) * m_height;
+        m_cells     = new(std::nothrow) uint32_t[gridSize];
+        m_nextCells = new(std::nothrow) uint32_t[gridSize];
+
+        if ((nullptr == m_cells) ||
+            (nullptr == m_nextCells))
+        {
+            destroy();
+        }
+        else
+        {
+            clear();
+            isSuccessful = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+void LifeGrid::destroy()
+{
+    if (nullptr != m_cells)
+    {
+        delete[] m_cells;
+        m_cells = nullptr;
+    }
+
+    if (nullptr != m_nextCells)
+    {
+        delete[] m_nextCells;
+        m_nextCells = nullptr;
+    }
+
+    m_width         = 0U;
+    m_height        = 0U;
+    m_wordsPerRow   = 0U;
+    m_lastWordBits  = 0U;
+    m_lastWordMask  = 0U;
+
+    clearHistory();
+
+    return;
+}
+
+void LifeGrid::clear()
+{
+    if (nullptr != m_cells)
+    {
+        memset(m_cells, 0, static_cast<size_t>(m_wordsPerRow) * m_height * sizeof(uint32_t));
+    }
+
+    clearHistory();
+
+    return;
+}
+
+void LifeGrid::randomize(uint32_t seed)
+{
+    if (nullptr != m_cells)
+    {
+        uint32_t    state   = (0U == seed) ? 1U : seed;
+        uint16_t    y       = 0U;
+
+        for(y = 0U; y < m_height; ++y)
+        {
+            uint32_t*   row = &m_cells[static_cast<size_t>(y) * m_wordsPerRow];
+            uint16_t    idx = 0U;
+
+            for(idx = 0U; idx < m_wordsPerRow; ++idx)
+            {
+                /* Xorshift32 pseudo random number generator */
+                state ^= state << 13U;
+                state ^= state >> 17U;
+                state ^= state << 5U;
+
+                row[idx] = state;
+            }
+
+            row[m_wordsPerRow - 1U] &= m_lastWordMask;
+        }
+    }
+
+    clearHistory();
+
+    return;
+}
+
+bool LifeGrid::getCell(uint16_t x, uint16_t y) const
+{
+    bool isAlive = false;
+
+    if ((nullptr != m_cells) &&
+        (m_width > x) &&
+        (m_height > y))
+    {
+        uint32_t word = m_cells[static_cast<size_t>(y) * m_wordsPerRow + (x / BITS)];
+
+        isAlive = (0U != ((word >> (x % BITS)) & 1U));
+    }
+
+    return isAlive;
+}
+
+void LifeGrid::setCell(uint16_t x, uint16_t y, bool state)
+{
+    if ((nullptr != m_cells) &&
+        (m_width > x) &&
+        (m_height > y))
+    {
+        uint32_t&   word    = m_cells[static_cast<size_t>(y) * m_wordsPerRow + (x / BITS)];
+        uint32_t    mask    = 1U << (x % BITS);
+
+        if (false == state)
+        {
+            word &= ~mask;
+        }
+        else
+        {
+            word |= mask;
+        }
+    }
+
+    return;
+}
+
+const uint32_t* LifeGrid::getRow(uint16_t y) const
+{
+    const uint32_t* row = nullptr;
+
+    if ((nullptr != m_cells) &&
+        (m_height > y))
+    {
+        row = &m_cells[static_cast<size_t>(y) * m_wordsPerRow];
+    }
+
+    return row;
+}
+
+void LifeGrid::step()
+{
+    if (nullptr != m_cells)
+    {
+        uint16_t    y           = 0U;
+        uint32_t*   tmp         = nullptr;
+
+        /* The first history entry is the initial pattern. */
+        if (0U == m_historyCnt)
+        {
+            updateHistory();
+        }
+
+        for(y = 0U; y < m_height; ++y)
+        {
+            /* Wrap-around at the top and bottom border. */
+            uint16_t yAbove = (0U == y) ? (m_height - 1U) : (y - 1U);
+            uint16_t yBelow = ((m_height - 1U) == y) ? 0U : (y + 1U);
+
+            stepRow(&m_cells[static_cast<size_t>(yAbove) * m_wordsPerRow],
+                    &m_cells[static_cast<size_t>(y) * m_wordsPerRow],
+                    &m_cells[static_cast<size_t>(yBelow) * m_wordsPerRow],
+                    &m_nextCells[static_cast<size_t>(y) * m_wordsPerRow]);
+        }
+
+        /* Next generation becomes the current one. */
+        tmp         = m_cells;
+        m_cells     = m_nextCells;
+        m_nextCells = tmp;
+
+        ++m_generation;
+        updateHistory();
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void LifeGrid::clearHistory()
+{
+    m_generation    = 0U;
+    m_historyIdx    = 0U;
+    m_historyCnt    = 0U;
+    m_period        = 0U;
+
+    return;
+}
+
+uint32_t LifeGrid::calcHash() const
+{
+    const uint32_t  FNV_OFFSET_BASIS    = 2166136261U;
+    const uint32_t  FNV_PRIME           = 16777619U;
+    uint32_t        hash                = FNV_OFFSET_BASIS;
+    size_t          gridSize            = static_cast<size_t>(m_wordsPerRow) * m_height;
+    size_t          idx                 = 0U;
+
+    /* FNV-1a, applied word by word. */
+    for(idx = 0U; idx < gridSize; ++idx)
+    {
+        hash ^= m_cells[idx];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+void LifeGrid::updateHistory()
+{
+    uint32_t    hash    = calcHash();
+    uint8_t     dist    = 1U;
+
+    m_period = 0U;
+
+    /* Search backwards for the same pattern, starting with the previous generation.
+     * The hash may collide, which would cause a wrong period. Because it is only
+     * used to restart the game, this is accepted.
+     */
+    while((m_historyCnt >= dist) && (0U == m_period))
+    {
+        uint8_t idx = (m_historyIdx + HISTORY_SIZE - dist) % HISTORY_SIZE;
+
+        if (hash == m_history[idx])
+        {
+            m_period = dist;
+        }
+
+        ++dist;
+    }
+
+    m_history[m_historyIdx] = hash;
+    m_historyIdx = (m_historyIdx + 1U) % HISTORY_SIZE;
+
+    if (HISTORY_SIZE > m_historyCnt)
+    {
+        ++m_historyCnt;
+    }
+
+    return;
+}
+
+void LifeGrid::stepRow(const uint32_t* above, const uint32_t* row, const uint32_t* below, uint32_t* next) const
+{
+    uint16_t idx = 0U;
+
+    for(idx = 0U; idx < m_wordsPerRow; ++idx)
+    {
+        uint32_t    ones    = 0U;
+        uint32_t    twos    = 0U;
+        uint32_t    fours   = 0U;
+        uint32_t    sumA    = 0U;
+        uint32_t    sumB    = 0U;
+        uint32_t    sumC    = 0U;
+        uint32_t    carryA  = 0U;
+        uint32_t    carryB  = 0U;
+        uint32_t    carryC  = 0U;
+        uint32_t    carryD  = 0U;
+        uint32_t    carryE  = 0U;
+        uint32_t    carryF  = 0U;
+        uint32_t    sumD    = 0U;
+
+        /* Sum up the 8 neighbours of every cell bit-sliced. The result is
+         * the number of alive neighbours modulo 8 in the bits ones, twos
+         * and fours. 8 neighbours wrap to 0, which has the same result.
+         */
+        fullAdd(getWest(above, idx), above[idx], getEast(above, idx), sumA, carryA);
+        fullAdd(getWest(row, idx), getEast(row, idx), getWest(below, idx), sumB, carryB);
+        halfAdd(below[idx], getEast(below, idx), sumC, carryC);
+
+        /* Weight 1 */
+        fullAdd(sumA, sumB, sumC, ones, carryD);
+
+        /* Weight 2 */
+        fullAdd(carryA, carryB, carryC, sumD, carryE);
+        halfAdd(sumD, carryD, twos, carryF);
+
+        /* Weight 4, the carry with weight 8 is not needed. */
+        fours = carryE ^ carryF;
+
+        /* Rules:
+         * 1. Any live cell with fewer than two live neighbours dies, as if by underpopulation.
+         * 2. Any live cell with two or three live neighbours lives on to the next generation.
+         * 3. Any live cell with more than three live neighbours dies, as if by overpopulation.
+         * 4. Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction.
+         *
+         * Alive in the next generation are all cells with 3 neighbours and
+         * all alive cells with 2 neighbours.
+         */
+        next[idx] = twos & ~fours & (ones | row[idx]);
+    }
+
+    next[m_wordsPerRow - 1U] &= m_lastWordMask;
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Full adder, which adds three bits of every bit position.
+ *
+ * @param[in]  a        Summand a
+ * @param[in]  b        Summand b
+ * @param[in]  c        Summand c
+ * @param[out] sum      Sum
+ * @param[out] carry    Carry
+ */
+static inline void fullAdd(uint32_t a, uint32_t b, uint32_t c, uint32_t& sum, uint32_t& carry)
+{
+    uint32_t tmp = a ^ b;
+
+    sum     = tmp ^ c;
+    carry   = (a & b) | (tmp & c);
+}
+
+/**
+ * Half adder, which adds two bits of every bit position.
+ *
+ * @param[in]  a        Summand a
+ * @param[in]  b        Summand b
+ * @param[out] sum      Sum
+ * @param[out] carry    Carry
+ */
+static inline void halfAdd(uint32_t a, uint32_t b, uint32_t& sum, uint32_t& carry)
+{
+    sum     = a ^ b;
+    carry   = a & b;
+}
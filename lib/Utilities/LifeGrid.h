@@ -0,0 +1,305 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Game of life grid
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __LIFEGRID_H__
+#define __LIFEGRID_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Toroidal grid of the Conways Game of Life.
+ *
+ * Every row is stored in 32 bit words, one bit per cell. The next generation
+ * is calculated word parallel: the eight neighbours of all 32 cells of a word
+ * are summed up with bit-sliced adders, instead of counting the neighbours
+ * cell by cell. The wrap-around at the left and right border is handled by
+ * the carry bits at the word edges.
+ *
+ * The hashes of the last generations are kept to detect still lifes and
+ * oscillators.
+ */
+class LifeGrid
+{
+public:
+
+    /** Number of generations, which are considered by the cycle detection. */
+    static const uint8_t    HISTORY_SIZE    = 16U;
+
+    /** Number of cells per word. */
+    static const uint8_t    BITS            = 32U;
+
+    /**
+     * Constructs an empty grid.
+     */
+    LifeGrid();
+
+    /**
+     * Destroys the grid.
+     */
+    ~LifeGrid();
+
+    /**
+     * Allocate the grid. All cells are dead.
+     *
+     * @param[in] width     Grid width in cells
+     * @param[in] height    Grid height in cells
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool create(uint16_t width, uint16_t height);
+
+    /**
+     * Release the grid.
+     */
+    void destroy();
+
+    /**
+     * Is the grid allocated?
+     *
+     * @return If allocated, it will return true otherwise false.
+     */
+    bool isAllocated() const
+    {
+        return (nullptr != m_cells);
+    }
+
+    /**
+     * Get grid width.
+     *
+     * @return Width in cells
+     */
+    uint16_t getWidth() const
+    {
+        return m_width;
+    }
+
+    /**
+     * Get grid height.
+     *
+     * @return Height in cells
+     */
+    uint16_t getHeight() const
+    {
+        return m_height;
+    }
+
+    /**
+     * Kill all cells and start with a new history.
+     */
+    void clear();
+
+    /**
+     * Generate a random pattern and start with a new history.
+     *
+     * @param[in] seed  Seed of the pseudo random number generator, must not be 0.
+     */
+    void randomize(uint32_t seed);
+
+    /**
+     * Get cell state.
+     *
+     * @param[in] x     x-coordinate of cell
+     * @param[in] y     y-coordinate of cell
+     *
+     * @return Alive (true) or dead (false). Cells outside the grid are dead.
+     */
+    bool getCell(uint16_t x, uint16_t y) const;
+
+    /**
+     * Set cell state.
+     * Note, the history is not cleared. Call clear() before a new pattern
+     * is set cell by cell.
+     *
+     * @param[in] x     x-coordinate of cell
+     * @param[in] y     y-coordinate of cell
+     * @param[in] state Alive (true) or dead (false).
+     */
+    void setCell(uint16_t x, uint16_t y, bool state);
+
+    /**
+     * Get the cells of a row. Cell x is bit (x % BITS) of word (x / BITS).
+     *
+     * @param[in] y     y-coordinate of row
+     *
+     * @return Row words. If the row is not available, it will return nullptr.
+     */
+    const uint32_t* getRow(uint16_t y) const;
+
+    /**
+     * Calculate the next generation.
+     */
+    void step();
+
+    /**
+     * Get the number of generations, since the last pattern was generated.
+     *
+     * @return Number of generations
+     */
+    uint32_t getGeneration() const
+    {
+        return m_generation;
+    }
+
+    /**
+     * Get the period of the current generation, which means the number of
+     * generations after which the same pattern appeared. A still life has
+     * the period 1.
+     *
+     * @return Period or 0, if no cycle is detected within the history.
+     */
+    uint8_t getPeriod() const
+    {
+        return m_period;
+    }
+
+private:
+
+    uint16_t    m_width;                    /**< Grid width in cells */
+    uint16_t    m_height;                   /**< Grid height in cells */
+    uint16_t    m_wordsPerRow;              /**< Number of words per row */
+    uint8_t     m_lastWordBits;             /**< Number of cells in the last word of a row */
+    uint32_t    m_lastWordMask;             /**< Mask of the cells in the last word of a row */
+    uint32_t*   m_cells;                    /**< Cells of the current generation */
+    uint32_t*   m_nextCells;                /**< Cells of the next generation */
+    uint32_t    m_generation;               /**< Number of generations since the pattern was generated */
+    uint32_t    m_history[HISTORY_SIZE];    /**< Hashes of the last generations */
+    uint8_t     m_historyIdx;               /**< Index of the next history entry */
+    uint8_t     m_historyCnt;               /**< Number of valid history entries */
+    uint8_t     m_period;                   /**< Period of the current generation or 0 */
+
+    LifeGrid(const LifeGrid& grid);
+    LifeGrid& operator=(const LifeGrid& grid);
+
+    /**
+     * Forget all previous generations.
+     */
+    void clearHistory();
+
+    /**
+     * Calculate the hash of the current generation.
+     *
+     * @return Hash
+     */
+    uint32_t calcHash() const;
+
+    /**
+     * Determine the period of the current generation and add it to the history.
+     */
+    void updateHistory();
+
+    /**
+     * Calculate one row of the next generation.
+     *
+     * @param[in]  above    Row above
+     * @param[in]  row      Row
+     * @param[in]  below    Row below
+     * @param[out] next     Row of the next generation
+     */
+    void stepRow(const uint32_t* above, const uint32_t* row, const uint32_t* below, uint32_t* next) const;
+
+    /**
+     * Get for every cell of a word its west neighbour.
+     *
+     * @param[in] row   Row
+     * @param[in] idx   Word index
+     *
+     * @return West neighbours
+     */
+    uint32_t getWest(const uint32_t* row, uint16_t idx) const
+    {
+        uint32_t carry = 0U;
+
+        if (0U < idx)
+        {
+            carry = row[idx - 1U] >> (BITS - 1U);
+        }
+        else
+        {
+            /* Wrap-around: The west neighbour of the first cell is the last cell. */
+            carry = (row[m_wordsPerRow - 1U] >> (m_lastWordBits - 1U)) & 1U;
+        }
+
+        return (row[idx] << 1U) | carry;
+    }
+
+    /**
+     * Get for every cell of a word its east neighbour.
+     *
+     * @param[in] row   Row
+     * @param[in] idx   Word index
+     *
+     * @return East neighbours
+     */
+    uint32_t getEast(const uint32_t* row, uint16_t idx) const
+    {
+        uint32_t east = row[idx] >> 1U;
+
+        if (m_wordsPerRow > (idx + 1U))
+        {
+            east |= row[idx + 1U] << (BITS - 1U);
+        }
+        else
+        {
+            /* Wrap-around: The east neighbour of the last cell is the first cell. */
+            east |= (row[0U] & 1U) << (m_lastWordBits - 1U);
+        }
+
+        return east;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __LIFEGRID_H__ */
+
+/** @} */
@@ -0,0 +1,306 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  MQTT packet encoder and decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MqttPacket.h"
+
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** MQTT protocol name, used in the CONNECT packet. */
+static const char   PROTOCOL_NAME[]     = "MQTT";
+
+/** MQTT protocol level 4 is version 3.1.1. */
+static const uint8_t PROTOCOL_LEVEL     = 4U;
+
+/** CONNECT flag: clean session */
+static const uint8_t CONNECT_FLAG_CLEAN = 0x02U;
+
+/** CONNECT flag: password */
+static const uint8_t CONNECT_FLAG_PASS  = 0x40U;
+
+/** CONNECT flag: user name */
+static const uint8_t CONNECT_FLAG_USER  = 0x80U;
+
+/** PUBLISH flag: duplicate delivery */
+static const uint8_t PUBLISH_FLAG_DUP   = 0x08U;
+
+/** PUBLISH flag: retain */
+static const uint8_t PUBLISH_FLAG_RETAIN = 0x01U;
+
+/** The reserved flags of SUBSCRIBE and UNSUBSCRIBE must be 0010. */
+static const uint8_t SUBSCRIBE_FLAGS    = 0x02U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+extern void MqttPacket::appendFixedHeader(std::vector<uint8_t>& buffer, uint8_t header, size_t remainingLength)
+{
+    buffer.push_back(header);
+
+    /* The remaining length is encoded with 7 bit per byte, the MSB signals that more bytes follow. */
+    do
+    {
+        uint8_t value = static_cast<uint8_t>(remainingLength & 0x7FU);
+
+        remainingLength >>= 7U;
+
+        if (0U < remainingLength)
+        {
+            value |= 0x80U;
+        }
+
+        buffer.push_back(value);
+    }
+    while(0U < remainingLength);
+
+    return;
+}
+
+extern void MqttPacket::appendUInt16(std::vector<uint8_t>& buffer, uint16_t value)
+{
+    buffer.push_back(static_cast<uint8_t>(value >> 8U));
+    buffer.push_back(static_cast<uint8_t>(value & 0xFFU));
+
+    return;
+}
+
+extern void MqttPacket::appendString(std::vector<uint8_t>& buffer, const String& str)
+{
+    appendUInt16(buffer, static_cast<uint16_t>(str.length()));
+    buffer.insert(buffer.end(), str.c_str(), str.c_str() + str.length());
+
+    return;
+}
+
+extern void MqttPacket::appendConnect(std::vector<uint8_t>& buffer, const String& clientId, const String& user, const String& password, uint16_t keepAlive)
+{
+    uint8_t connectFlags    = CONNECT_FLAG_CLEAN;
+    size_t  remainingLength = 2U + strlen(PROTOCOL_NAME) + 1U + 1U + 2U + 2U + clientId.length();
+
+    if (false == user.isEmpty())
+    {
+        connectFlags    |= CONNECT_FLAG_USER;
+        remainingLength += 2U + user.length();
+
+        if (false == password.isEmpty())
+        {
+            connectFlags    |= CONNECT_FLAG_PASS;
+            remainingLength += 2U + password.length();
+        }
+    }
+
+    appendFixedHeader(buffer, PACKET_TYPE_CONNECT << 4U, remainingLength);
+    appendString(buffer, PROTOCOL_NAME);
+    buffer.push_back(PROTOCOL_LEVEL);
+    buffer.push_back(connectFlags);
+    appendUInt16(buffer, keepAlive);
+    appendString(buffer, clientId);
+
+    if (0U != (connectFlags & CONNECT_FLAG_USER))
+    {
+        appendString(buffer, user);
+    }
+
+    if (0U != (connectFlags & CONNECT_FLAG_PASS))
+    {
+        appendString(buffer, password);
+    }
+
+    return;
+}
+
+extern void MqttPacket::appendPublish(std::vector<uint8_t>& buffer, const String& topic, const String& payload, uint8_t qos, bool retain, uint16_t packetId, bool isDup)
+{
+    uint8_t header          = (PACKET_TYPE_PUBLISH << 4U) | (qos << 1U);
+    size_t  remainingLength = 2U + topic.length() + payload.length();
+
+    if (true == isDup)
+    {
+        header |= PUBLISH_FLAG_DUP;
+    }
+
+    if (true == retain)
+    {
+        header |= PUBLISH_FLAG_RETAIN;
+    }
+
+    if (0U != qos)
+    {
+        remainingLength += 2U;
+    }
+
+    appendFixedHeader(buffer, header, remainingLength);
+    appendString(buffer, topic);
+
+    if (0U != qos)
+    {
+        appendUInt16(buffer, packetId);
+    }
+
+    buffer.insert(buffer.end(), payload.c_str(), payload.c_str() + payload.length());
+
+    return;
+}
+
+extern void MqttPacket::appendSubscribe(std::vector<uint8_t>& buffer, uint16_t packetId, const String& topic, uint8_t qos)
+{
+    appendFixedHeader(buffer, (PACKET_TYPE_SUBSCRIBE << 4U) | SUBSCRIBE_FLAGS, 2U + 2U + topic.length() + 1U);
+    appendUInt16(buffer, packetId);
+    appendString(buffer, topic);
+    buffer.push_back(qos);
+
+    return;
+}
+
+extern void MqttPacket::appendUnsubscribe(std::vector<uint8_t>& buffer, uint16_t packetId, const String& topic)
+{
+    appendFixedHeader(buffer, (PACKET_TYPE_UNSUBSCRIBE << 4U) | SUBSCRIBE_FLAGS, 2U + 2U + topic.length());
+    appendUInt16(buffer, packetId);
+    appendString(buffer, topic);
+
+    return;
+}
+
+extern MqttPacket::DecodeResult MqttPacket::decodeRemainingLength(const uint8_t* data, size_t size, size_t& remainingLength, size_t& lenSize)
+{
+    DecodeResult    result  = DECODE_RESULT_INCOMPLETE;
+    size_t          index   = 0U;
+
+    remainingLength = 0U;
+
+    /* The remaining length is encoded in max. 4 byte, 7 bit per byte. */
+    while((DECODE_RESULT_INCOMPLETE == result) &&
+          (index < size))
+    {
+        uint8_t value = data[index];
+
+        remainingLength |= static_cast<size_t>(value & 0x7FU) << (7U * index);
+        ++index;
+
+        if (0U == (value & 0x80U))
+        {
+            result = DECODE_RESULT_OK;
+        }
+        else if (MAX_REMAINING_LENGTH_SIZE <= index)
+        {
+            result = DECODE_RESULT_MALFORMED;
+        }
+        else
+        {
+            /* Nothing to do. */
+            ;
+        }
+    }
+
+    lenSize = index;
+
+    return result;
+}
+
+extern bool MqttPacket::decodePublish(uint8_t header, const uint8_t* data, size_t size, Publish& publish)
+{
+    bool    isValid = false;
+    uint8_t qos     = (header >> 1U) & 0x03U;
+
+    if ((PACKET_TYPE_PUBLISH == (header >> 4U)) &&
+        (1U >= qos) &&
+        (2U <= size))
+    {
+        size_t topicLen = decodeUInt16(data);
+        size_t index    = 2U + topicLen;
+
+        if (size >= (index + ((0U == qos) ? 0U : 2U)))
+        {
+            publish.qos         = qos;
+            publish.packetId    = 0U;
+            publish.topic       = reinterpret_cast<const char*>(&data[2]);
+            publish.topicLen    = topicLen;
+
+            if (0U != qos)
+            {
+                publish.packetId = decodeUInt16(&data[index]);
+                index += 2U;
+            }
+
+            publish.payload     = &data[index];
+            publish.payloadSize = size - index;
+
+            isValid = true;
+        }
+    }
+
+    return isValid;
+}
+
+extern uint16_t MqttPacket::decodeUInt16(const uint8_t* data)
+{
+    return (static_cast<uint16_t>(data[0]) << 8U) | data[1];
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,232 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  MQTT packet encoder and decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __MQTT_PACKET_H__
+#define __MQTT_PACKET_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <WString.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * MQTT 3.1.1 packet encoder and decoder. The encoder functions append a
+ * complete packet to a byte buffer, the decoder functions work on received
+ * raw data. They don't depend on the TCP/IP stack.
+ *
+ * Used specification:
+ * - MQTT Version 3.1.1, OASIS Standard
+ */
+namespace MqttPacket
+{
+
+/**
+ * MQTT control packet types.
+ */
+enum PacketType
+{
+    PACKET_TYPE_CONNECT     = 1,    /**< Client request to connect to server */
+    PACKET_TYPE_CONNACK     = 2,    /**< Connect acknowledgment */
+    PACKET_TYPE_PUBLISH     = 3,    /**< Publish message */
+    PACKET_TYPE_PUBACK      = 4,    /**< Publish acknowledgment */
+    PACKET_TYPE_SUBSCRIBE   = 8,    /**< Client subscribe request */
+    PACKET_TYPE_SUBACK      = 9,    /**< Subscribe acknowledgment */
+    PACKET_TYPE_UNSUBSCRIBE = 10,   /**< Unsubscribe request */
+    PACKET_TYPE_UNSUBACK    = 11,   /**< Unsubscribe acknowledgment */
+    PACKET_TYPE_PINGREQ     = 12,   /**< PING request */
+    PACKET_TYPE_PINGRESP    = 13,   /**< PING response */
+    PACKET_TYPE_DISCONNECT  = 14    /**< Client is disconnecting */
+};
+
+/**
+ * Result of decoding the remaining length.
+ */
+enum DecodeResult
+{
+    DECODE_RESULT_OK = 0,       /**< Successful decoded. */
+    DECODE_RESULT_INCOMPLETE,   /**< More data is necessary. */
+    DECODE_RESULT_MALFORMED     /**< Data is malformed. */
+};
+
+/**
+ * A received PUBLISH packet. The topic and payload refer to the raw data.
+ */
+struct Publish
+{
+    uint8_t         qos;            /**< Quality of service */
+    uint16_t        packetId;       /**< Packet identifier, only valid for QoS > 0. */
+    const char*     topic;          /**< Topic name, not zero terminated! */
+    size_t          topicLen;       /**< Topic name length in byte */
+    const uint8_t*  payload;        /**< Payload */
+    size_t          payloadSize;    /**< Payload size in byte */
+};
+
+/** Max. remaining length, which can be encoded in 4 byte. */
+static const size_t     MAX_REMAINING_LENGTH        = 268435455U;
+
+/** Max. number of byte, used to encode the remaining length. */
+static const size_t     MAX_REMAINING_LENGTH_SIZE   = 4U;
+
+/** SUBACK return code: failure */
+static const uint8_t    SUBACK_FAILURE              = 0x80U;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Append a fixed header to the buffer.
+ *
+ * @param[in,out]   buffer          Buffer
+ * @param[in]       header          First byte of the fixed header.
+ * @param[in]       remainingLength Remaining length in byte.
+ */
+extern void appendFixedHeader(std::vector<uint8_t>& buffer, uint8_t header, size_t remainingLength);
+
+/**
+ * Append a 16-bit value in big endian to the buffer.
+ *
+ * @param[in,out]   buffer  Buffer
+ * @param[in]       value   Value
+ */
+extern void appendUInt16(std::vector<uint8_t>& buffer, uint16_t value);
+
+/**
+ * Append a UTF-8 encoded string with length prefix to the buffer.
+ *
+ * @param[in,out]   buffer  Buffer
+ * @param[in]       str     String
+ */
+extern void appendString(std::vector<uint8_t>& buffer, const String& str);
+
+/**
+ * Append a CONNECT packet with clean session to the buffer.
+ * The password is only used together with a user name.
+ *
+ * @param[in,out]   buffer      Buffer
+ * @param[in]       clientId    Client identifier
+ * @param[in]       user        User name, empty if not used.
+ * @param[in]       password    Password, empty if not used.
+ * @param[in]       keepAlive   Keep alive interval in s
+ */
+extern void appendConnect(std::vector<uint8_t>& buffer, const String& clientId, const String& user, const String& password, uint16_t keepAlive);
+
+/**
+ * Append a PUBLISH packet to the buffer.
+ *
+ * @param[in,out]   buffer      Buffer
+ * @param[in]       topic       Topic name
+ * @param[in]       payload     Payload
+ * @param[in]       qos         Quality of service
+ * @param[in]       retain      Shall the broker retain the message?
+ * @param[in]       packetId    Packet identifier, only used for QoS > 0.
+ * @param[in]       isDup       Is it a retransmission?
+ */
+extern void appendPublish(std::vector<uint8_t>& buffer, const String& topic, const String& payload, uint8_t qos, bool retain, uint16_t packetId, bool isDup);
+
+/**
+ * Append a SUBSCRIBE packet with a single topic filter to the buffer.
+ *
+ * @param[in,out]   buffer      Buffer
+ * @param[in]       packetId    Packet identifier
+ * @param[in]       topic       Topic filter
+ * @param[in]       qos         Max. quality of service
+ */
+extern void appendSubscribe(std::vector<uint8_t>& buffer, uint16_t packetId, const String& topic, uint8_t qos);
+
+/**
+ * Append a UNSUBSCRIBE packet with a single topic filter to the buffer.
+ *
+ * @param[in,out]   buffer      Buffer
+ * @param[in]       packetId    Packet identifier
+ * @param[in]       topic       Topic filter
+ */
+extern void appendUnsubscribe(std::vector<uint8_t>& buffer, uint16_t packetId, const String& topic);
+
+/**
+ * Decode the remaining length of the fixed header.
+ *
+ * @param[in]   data            Data, starting after the first byte of the fixed header.
+ * @param[in]   size            Data size in byte
+ * @param[out]  remainingLength Decoded remaining length in byte
+ * @param[out]  lenSize         Number of byte, used by the encoded remaining length.
+ *
+ * @return Decode result
+ */
+extern DecodeResult decodeRemainingLength(const uint8_t* data, size_t size, size_t& remainingLength, size_t& lenSize);
+
+/**
+ * Decode the variable header and payload of a received PUBLISH packet.
+ * QoS 2 is not supported and handled as malformed packet.
+ *
+ * @param[in]   header  First byte of the fixed header.
+ * @param[in]   data    Variable header and payload
+ * @param[in]   size    Size of variable header and payload in byte
+ * @param[out]  publish Decoded packet
+ *
+ * @return If the packet is valid, it will return true otherwise false.
+ */
+extern bool decodePublish(uint8_t header, const uint8_t* data, size_t size, Publish& publish);
+
+/**
+ * Decode a 16-bit value in big endian.
+ *
+ * @param[in] data  Data, at least 2 byte.
+ *
+ * @return Value
+ */
+extern uint16_t decodeUInt16(const uint8_t* data);
+
+}
+
+#endif  /* __MQTT_PACKET_H__ */
+
+/** @} */
@@ -0,0 +1,190 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Token bucket
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __TOKENBUCKET_HPP__
+#define __TOKENBUCKET_HPP__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Token bucket, used to limit the rate of events, based on millis().
+ * Every event takes a token. The bucket is refilled with one token per
+ * refill period, up to its capacity. The capacity is the max. burst size.
+ */
+class TokenBucket
+{
+public:
+
+    /**
+     * Constructs a full token bucket.
+     * 
+     * @param[in] capacity      Max. number of tokens
+     * @param[in] refillPeriod  Period in ms to refill a single token
+     */
+    TokenBucket(uint32_t capacity, uint32_t refillPeriod) :
+        m_capacity(capacity),
+        m_refillPeriod(refillPeriod),
+        m_tokens(capacity),
+        m_timestamp(0U),
+        m_isStarted(false)
+    {
+    }
+
+    /**
+     * Destroys the token bucket.
+     */
+    ~TokenBucket()
+    {
+    }
+
+    /**
+     * Take a token.
+     * 
+     * @return If a token is available, it will return true otherwise false.
+     */
+    bool take()
+    {
+        return take(millis());
+    }
+
+    /**
+     * Take a token at the given time.
+     * 
+     * @param[in] timestamp Timestamp in ms
+     * 
+     * @return If a token is available, it will return true otherwise false.
+     */
+    bool take(uint32_t timestamp)
+    {
+        bool isAvailable = false;
+
+        refill(timestamp);
+
+        if (0U < m_tokens)
+        {
+            --m_tokens;
+            isAvailable = true;
+        }
+
+        return isAvailable;
+    }
+
+    /**
+     * Get number of available tokens at the given time.
+     * 
+     * @param[in] timestamp Timestamp in ms
+     * 
+     * @return Number of available tokens
+     */
+    uint32_t getTokens(uint32_t timestamp)
+    {
+        refill(timestamp);
+
+        return m_tokens;
+    }
+
+private:
+
+    uint32_t    m_capacity;     /**< Max. number of tokens */
+    uint32_t    m_refillPeriod; /**< Period in ms to refill a single token */
+    uint32_t    m_tokens;       /**< Number of available tokens */
+    uint32_t    m_timestamp;    /**< Timestamp in ms of the last refill */
+    bool        m_isStarted;    /**< Is the refill timestamp valid? */
+
+    /**
+     * Refill the tokens, according to the elapsed time since the last refill.
+     * 
+     * @param[in] timestamp Timestamp in ms
+     */
+    void refill(uint32_t timestamp)
+    {
+        if (false == m_isStarted)
+        {
+            m_timestamp = timestamp;
+            m_isStarted = true;
+        }
+        else if (0U == m_refillPeriod)
+        {
+            m_tokens = m_capacity;
+        }
+        else
+        {
+            uint32_t tokens = (timestamp - m_timestamp) / m_refillPeriod;
+
+            if (0U < tokens)
+            {
+                /* The remaining time is kept for the next token. */
+                m_timestamp += tokens * m_refillPeriod;
+
+                if ((m_capacity - m_tokens) <= tokens)
+                {
+                    m_tokens    = m_capacity;
+                    m_timestamp = timestamp;
+                }
+                else
+                {
+                    m_tokens += tokens;
+                }
+            }
+        }
+
+        return;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __TOKENBUCKET_HPP__ */
+
+/** @} */
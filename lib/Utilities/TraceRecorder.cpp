@@ -0,0 +1,142 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Trace recorder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "TraceRecorder.h"
+
+#if (0 != CONFIG_TRACE_RECORDER_ENABLE)
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void TraceRecorder::record(Type type, const char* name, int32_t value)
+{
+    UBaseType_t intState    = portSET_INTERRUPT_MASK_FROM_ISR();
+    uint8_t     core        = static_cast<uint8_t>(xPortGetCoreID());
+    RingBuffer& ring        = m_rings[core];
+    uint32_t    seqNum      = ring.wrCnt.fetch_add(1U, std::memory_order_relaxed) + 1U;
+    uint32_t    timestamp   = micros();
+    Event&      event       = ring.events[(seqNum - 1U) & (EVENTS_PER_CORE - 1U)];
+
+    /* The slot is claimed and the timestamp read without being interrupted.
+     * Otherwise another task on the same core could record an event in
+     * between and the timestamps would go backwards in sequence order.
+     */
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(intState);
+
+    /* Mark the event as invalid during update, because a reader may
+     * access it concurrently.
+     */
+    event.seqNum = 0U;
+    std::atomic_thread_fence(std::memory_order_release);
+
+    event.timestamp     = timestamp;
+    event.name          = name;
+    event.value         = value;
+    event.taskNumber    = static_cast<uint16_t>(uxTaskGetTaskNumber(xTaskGetCurrentTaskHandle()));
+    event.type          = static_cast<uint8_t>(type);
+    event.core          = core;
+
+    std::atomic_thread_fence(std::memory_order_release);
+    event.seqNum = seqNum;
+}
+
+bool TraceRecorder::getEvent(uint8_t core, uint32_t idx, Event& event) const
+{
+    bool isValid = false;
+
+    if ((MAX_CORES > core) &&
+        (EVENTS_PER_CORE > idx))
+    {
+        const RingBuffer&   ring        = m_rings[core];
+        uint32_t            wrCnt       = ring.wrCnt.load(std::memory_order_acquire);
+        uint32_t            available   = (EVENTS_PER_CORE < wrCnt) ? EVENTS_PER_CORE : wrCnt;
+
+        if (available > idx)
+        {
+            uint32_t        seqNum  = wrCnt - available + idx + 1U;
+            const Event&    src     = ring.events[(seqNum - 1U) & (EVENTS_PER_CORE - 1U)];
+
+            event = src;
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            /* Was the event overwritten meanwhile? */
+            if ((seqNum == event.seqNum) &&
+                (seqNum == src.seqNum))
+            {
+                isValid = true;
+            }
+        }
+    }
+
+    return isValid;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+#endif  /* (0 != CONFIG_TRACE_RECORDER_ENABLE) */
@@ -0,0 +1,250 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Trace recorder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup utilities
+ *
+ * @{
+ */
+
+#ifndef __TRACE_RECORDER_H__
+#define __TRACE_RECORDER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+#ifndef CONFIG_TRACE_RECORDER_ENABLE
+#define CONFIG_TRACE_RECORDER_ENABLE    (0)
+#endif  /* CONFIG_TRACE_RECORDER_ENABLE */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+#if (0 != CONFIG_TRACE_RECORDER_ENABLE)
+#include <Arduino.h>
+#include <atomic>
+#endif  /* (0 != CONFIG_TRACE_RECORDER_ENABLE) */
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#if (0 == CONFIG_TRACE_RECORDER_ENABLE)
+
+    #define TRACE_BEGIN(_name, _value)
+    #define TRACE_END(_name)
+    #define TRACE_COUNTER(_name, _value)
+    #define TRACE_SCOPE(_name, _value)
+
+#else  /* (0 == CONFIG_TRACE_RECORDER_ENABLE) */
+
+    /** Record the begin of a duration. The name must be a string literal. */
+    #define TRACE_BEGIN(_name, _value)      TraceRecorder::getInstance().record(TraceRecorder::TYPE_BEGIN, (_name), (_value))
+
+    /** Record the end of a duration. The name must be a string literal. */
+    #define TRACE_END(_name)                TraceRecorder::getInstance().record(TraceRecorder::TYPE_END, (_name), 0)
+
+    /** Record a counter value. The name must be a string literal. */
+    #define TRACE_COUNTER(_name, _value)    TraceRecorder::getInstance().record(TraceRecorder::TYPE_COUNTER, (_name), (_value))
+
+    /** Record the duration of the current scope, only once per scope. The name must be a string literal. */
+    #define TRACE_SCOPE(_name, _value)      TraceScope traceScope((_name), (_value))
+
+#endif  /* (0 == CONFIG_TRACE_RECORDER_ENABLE) */
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+#if (0 != CONFIG_TRACE_RECORDER_ENABLE)
+
+/**
+ * The trace recorder records fixed size trace events into a ring buffer per core.
+ * The events are written lock-free, therefore it can be used in any task context
+ * with minimal overhead. If a ring buffer is full, the oldest events are overwritten.
+ *
+ * Note, the event name is only stored as pointer, therefore only string literals
+ * shall be used.
+ */
+class TraceRecorder
+{
+public:
+
+    /**
+     * Trace event types.
+     */
+    enum Type
+    {
+        TYPE_BEGIN = 0, /**< Begin of a duration */
+        TYPE_END,       /**< End of a duration */
+        TYPE_COUNTER    /**< Counter value */
+    };
+
+    /**
+     * A single trace event.
+     */
+    struct Event
+    {
+        uint32_t    seqNum;     /**< Sequence number in the ring buffer, 0 means invalid. */
+        uint32_t    timestamp;  /**< Timestamp in us */
+        const char* name;       /**< Event name (string literal) */
+        int32_t     value;      /**< Event argument, e.g. the counter value. */
+        uint16_t    taskNumber; /**< Unique number of the task, which recorded the event. */
+        uint8_t     type;       /**< Event type, see Type. */
+        uint8_t     core;       /**< Core, the task was running on. */
+    };
+
+    /** Number of events per core. Must be a power of 2. */
+    static const uint32_t   EVENTS_PER_CORE = 256U;
+
+    /** Number of supported cores. */
+    static const uint8_t    MAX_CORES       = portNUM_PROCESSORS;
+
+    /**
+     * Get the trace recorder instance.
+     *
+     * @return Trace recorder instance
+     */
+    static TraceRecorder& getInstance()
+    {
+        static TraceRecorder instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Record a single trace event.
+     *
+     * @param[in] type  Event type
+     * @param[in] name  Event name, must be a string literal.
+     * @param[in] value Event argument
+     */
+    void record(Type type, const char* name, int32_t value);
+
+    /**
+     * Get a copy of a recorded event. The events of a core are ordered from
+     * the oldest (index 0) to the newest one, which is the timestamp order too.
+     * If a event was overwritten in the meantime, it will be reported as invalid.
+     *
+     * @param[in]   core    Core id
+     * @param[in]   idx     Event index [0; EVENTS_PER_CORE - 1]
+     * @param[out]  event   Event
+     *
+     * @return If event is valid, it will return true otherwise false.
+     */
+    bool getEvent(uint8_t core, uint32_t idx, Event& event) const;
+
+private:
+
+    /**
+     * Ring buffer with the events of a single core.
+     */
+    struct RingBuffer
+    {
+        std::atomic<uint32_t>   wrCnt;                      /**< Number of events ever written. */
+        Event                   events[EVENTS_PER_CORE];    /**< Events */
+    };
+
+    RingBuffer  m_rings[MAX_CORES];     /**< A ring buffer per core to avoid contention. */
+
+    /**
+     * Constructs the trace recorder.
+     */
+    TraceRecorder() :
+        m_rings()
+    {
+        uint8_t core = 0U;
+
+        for(core = 0U; core < MAX_CORES; ++core)
+        {
+            m_rings[core].wrCnt = 0U;
+        }
+    }
+
+    /**
+     * Destroys the trace recorder.
+     */
+    ~TraceRecorder()
+    {
+        /* Will never be called. */
+    }
+
+    TraceRecorder(const TraceRecorder& recorder);
+    TraceRecorder& operator=(const TraceRecorder& recorder);
+};
+
+/**
+ * The trace scope records the begin event at creation and the end event
+ * during destruction.
+ */
+class TraceScope
+{
+public:
+
+    /**
+     * Creates the trace scope and records the begin event.
+     *
+     * @param[in] name  Event name, must be a string literal.
+     * @param[in] value Event argument
+     */
+    TraceScope(const char* name, int32_t value) :
+        m_name(name)
+    {
+        TraceRecorder::getInstance().record(TraceRecorder::TYPE_BEGIN, m_name, value);
+    }
+
+    /**
+     * Destroys the trace scope and records the end event.
+     */
+    ~TraceScope()
+    {
+        TraceRecorder::getInstance().record(TraceRecorder::TYPE_END, m_name, 0);
+    }
+
+private:
+
+    const char* m_name; /**< Event name */
+
+    TraceScope();
+    TraceScope(const TraceScope& scope);
+    TraceScope& operator=(const TraceScope& scope);
+};
+
+#endif  /* (0 != CONFIG_TRACE_RECORDER_ENABLE) */
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __TRACE_RECORDER_H__ */
+
+/** @} */
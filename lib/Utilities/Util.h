@@ -78,6 +78,16 @@ namespace Util
  *
  * @return If conversion fails, it will return false otherwise true.
  */
+extern bool strToUInt8(const char* str, uint8_t& value);
+
+/**
+ * Convert a string to uint8_t. See the C string variant for details.
+ *
+ * @param[in]   str     String
+ * @param[out]  value   Converted value
+ *
+ * @return If conversion fails, it will return false otherwise true.
+ */
 extern bool strToUInt8(const String& str, uint8_t& value);
 
 /**
@@ -89,6 +99,16 @@ extern bool strToUInt8(const String& str, uint8_t& value);
  *
  * @return If conversion fails, it will return false otherwise true.
  */
+extern bool strToUInt16(const char* str, uint16_t& value);
+
+/**
+ * Convert a string to uint16_t. See the C string variant for details.
+ *
+ * @param[in]   str     String
+ * @param[out]  value   Converted value
+ *
+ * @return If conversion fails, it will return false otherwise true.
+ */
 extern bool strToUInt16(const String& str, uint16_t& value);
 
 /**
@@ -104,6 +124,16 @@ extern bool strToUInt16(const String& str, uint16_t& value);
  *
  * @return If conversion fails, it will return false otherwise true.
  */
+extern bool strToUInt32(const char* str, uint32_t& value);
+
+/**
+ * Convert a string to uint32_t. See the C string variant for details.
+ *
+ * @param[in]   str     String
+ * @param[out]  value   Converted value
+ *
+ * @return If conversion fails, it will return false otherwise true.
+ */
 extern bool strToUInt32(const String& str, uint32_t& value);
 
 /**
@@ -115,6 +145,16 @@ extern bool strToUInt32(const String& str, uint32_t& value);
  *
  * @return If conversion fails, it will return false otherwise true.
  */
+extern bool strToInt32(const char* str, int32_t& value);
+
+/**
+ * Convert a string to int32_t. See the C string variant for details.
+ *
+ * @param[in]   str     String
+ * @param[out]  value   Converted value
+ *
+ * @return If conversion fails, it will return false otherwise true.
+ */
 extern bool strToInt32(const String& str, int32_t& value);
 
 /**
@@ -0,0 +1,167 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Output color transformation with lookup tables
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ColorLut.h"
+
+#include <math.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+ColorLut::ColorLut() :
+    m_gamma(DEFAULT_GAMMA),
+    m_whiteBalance{UINT8_MAX, UINT8_MAX, UINT8_MAX},
+    m_brightness(UINT8_MAX),
+    m_gammaLut(),
+    m_lut()
+{
+    updateGammaLut();
+}
+
+void ColorLut::setGamma(float gamma)
+{
+    if ((0.0F < gamma) &&
+        (m_gamma != gamma))
+    {
+        m_gamma = gamma;
+        updateGammaLut();
+    }
+
+    return;
+}
+
+void ColorLut::setWhiteBalance(uint8_t red, uint8_t green, uint8_t blue)
+{
+    if ((red != m_whiteBalance[RED]) ||
+        (green != m_whiteBalance[GREEN]) ||
+        (blue != m_whiteBalance[BLUE]))
+    {
+        m_whiteBalance[RED]     = red;
+        m_whiteBalance[GREEN]   = green;
+        m_whiteBalance[BLUE]    = blue;
+
+        updateLut();
+    }
+
+    return;
+}
+
+void ColorLut::setBrightness(uint8_t brightness)
+{
+    if (brightness != m_brightness)
+    {
+        m_brightness = brightness;
+        updateLut();
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void ColorLut::updateGammaLut()
+{
+    uint16_t index = 0U;
+
+    /* The floating point calculation is done only if the gamma changes,
+     * which is usually once.
+     */
+    for(index = 0U; index < VALUES; ++index)
+    {
+        float normalized = static_cast<float>(index) / static_cast<float>(UINT8_MAX);
+
+        m_gammaLut[index] = static_cast<uint16_t>(powf(normalized, m_gamma) * static_cast<float>(MAX_VALUE) + 0.5F);
+    }
+
+    updateLut();
+
+    return;
+}
+
+void ColorLut::updateLut()
+{
+    /* Scaling is max. 255 * 255, so the product with a 8.8 fixed point
+     * value still fits into 32 bit.
+     */
+    const uint32_t  MAX_SCALE   = static_cast<uint32_t>(UINT8_MAX) * UINT8_MAX;
+    uint8_t         baseColor   = 0U;
+
+    for(baseColor = 0U; baseColor < BASE_COLORS; ++baseColor)
+    {
+        const uint32_t  SCALE   = static_cast<uint32_t>(m_whiteBalance[baseColor]) * m_brightness;
+        uint16_t        index   = 0U;
+
+        for(index = 0U; index < VALUES; ++index)
+        {
+            m_lut[baseColor][index] = static_cast<uint16_t>((m_gammaLut[index] * SCALE + (MAX_SCALE / 2U)) / MAX_SCALE);
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
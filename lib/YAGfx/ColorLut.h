@@ -0,0 +1,288 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Output color transformation with lookup tables
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __COLOR_LUT_H__
+#define __COLOR_LUT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "YAColor.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Transforms the colors of the framebuffer to the colors, which are sent to
+ * the physical display. Gamma correction, white balance and brightness are
+ * combined to one lookup table per base color, which is calculated again
+ * only if one of them changes.
+ *
+ * The tables contain 8.8 fixed point values. The fraction is either rounded
+ * or carried to the next frame per pixel (temporal dithering), which
+ * smoothes fades at low brightness.
+ *
+ * The tables are calculated in place and not protected against concurrent
+ * access. Change the settings only in the context, which calls apply().
+ */
+class ColorLut
+{
+public:
+
+    /** Default gamma value */
+    static constexpr float  DEFAULT_GAMMA   = 2.2F;
+
+    /**
+     * Residual fraction of a pixel, which is carried to the next frame by
+     * temporal dithering.
+     */
+    struct Residual
+    {
+        uint8_t red;    /**< Red fraction */
+        uint8_t green;  /**< Green fraction */
+        uint8_t blue;   /**< Blue fraction */
+
+        /**
+         * Constructs a residual without fraction.
+         */
+        Residual() :
+            red(0U),
+            green(0U),
+            blue(0U)
+        {
+        }
+    };
+
+    /**
+     * Constructs the lookup tables with default gamma, neutral white balance
+     * and full brightness.
+     */
+    ColorLut();
+
+    /**
+     * Destroys the lookup tables.
+     */
+    ~ColorLut()
+    {
+    }
+
+    /**
+     * Get gamma value.
+     *
+     * @return Gamma value
+     */
+    float getGamma() const
+    {
+        return m_gamma;
+    }
+
+    /**
+     * Set gamma value. A gamma value of 1 disables the gamma correction.
+     *
+     * @param[in] gamma Gamma value (> 0)
+     */
+    void setGamma(float gamma);
+
+    /**
+     * Get white balance, which is the max. value of every base color.
+     *
+     * @param[out] red      Max. red value
+     * @param[out] green    Max. green value
+     * @param[out] blue     Max. blue value
+     */
+    void getWhiteBalance(uint8_t& red, uint8_t& green, uint8_t& blue) const
+    {
+        red     = m_whiteBalance[RED];
+        green   = m_whiteBalance[GREEN];
+        blue    = m_whiteBalance[BLUE];
+        return;
+    }
+
+    /**
+     * Set white balance, which is the max. value of every base color.
+     * White in the framebuffer results in this color on the display.
+     *
+     * @param[in] red   Max. red value
+     * @param[in] green Max. green value
+     * @param[in] blue  Max. blue value
+     */
+    void setWhiteBalance(uint8_t red, uint8_t green, uint8_t blue);
+
+    /**
+     * Get brightness.
+     *
+     * @return Brightness [0; 255]
+     */
+    uint8_t getBrightness() const
+    {
+        return m_brightness;
+    }
+
+    /**
+     * Set brightness. It scales the light output linear, like a PWM does.
+     * The lookup tables are calculated again only if the brightness changes.
+     *
+     * @param[in] brightness    Brightness [0; 255]
+     */
+    void setBrightness(uint8_t brightness);
+
+    /**
+     * Transform a framebuffer color to the display color.
+     *
+     * @param[in] color Framebuffer color
+     *
+     * @return Display color
+     */
+    Color apply(const Color& color) const
+    {
+        uint8_t red     = 0U;
+        uint8_t green   = 0U;
+        uint8_t blue    = 0U;
+
+        color.get(red, green, blue);
+
+        return Color(roundValue(m_lut[RED][red]), roundValue(m_lut[GREEN][green]), roundValue(m_lut[BLUE][blue]));
+    }
+
+    /**
+     * Transform a framebuffer color to the display color with temporal
+     * dithering. The fraction, which can't be shown, is added to the next
+     * frame of the same pixel, so the average over time is exact.
+     *
+     * @param[in]       color       Framebuffer color
+     * @param[in,out]   residual    Residual fraction of the pixel
+     *
+     * @return Display color
+     */
+    Color apply(const Color& color, Residual& residual) const
+    {
+        uint8_t red     = 0U;
+        uint8_t green   = 0U;
+        uint8_t blue    = 0U;
+
+        color.get(red, green, blue);
+
+        red     = dither(m_lut[RED][red], residual.red);
+        green   = dither(m_lut[GREEN][green], residual.green);
+        blue    = dither(m_lut[BLUE][blue], residual.blue);
+
+        return Color(red, green, blue);
+    }
+
+private:
+
+    /** Index of the base colors in the tables. */
+    enum BaseColor
+    {
+        RED = 0,    /**< Red */
+        GREEN,      /**< Green */
+        BLUE,       /**< Blue */
+        BASE_COLORS /**< Number of base colors */
+    };
+
+    /** Number of values per base color */
+    static const uint16_t   VALUES              = UINT8_MAX + 1U;
+
+    /** Number of fraction bits in the tables */
+    static const uint8_t    FRACTION_BITS       = 8U;
+
+    /** Max. value in the tables */
+    static const uint16_t   MAX_VALUE           = static_cast<uint16_t>(UINT8_MAX) << FRACTION_BITS;
+
+    float       m_gamma;                            /**< Gamma value */
+    uint8_t     m_whiteBalance[BASE_COLORS];        /**< Max. value per base color */
+    uint8_t     m_brightness;                       /**< Brightness [0; 255] */
+    uint16_t    m_gammaLut[VALUES];                 /**< Gamma corrected values in 8.8 fixed point */
+    uint16_t    m_lut[BASE_COLORS][VALUES];         /**< Display values per base color in 8.8 fixed point */
+
+    /**
+     * Calculate the gamma table and afterwards the base color tables.
+     */
+    void updateGammaLut();
+
+    /**
+     * Calculate the base color tables by scaling the gamma table with the
+     * white balance and brightness.
+     */
+    void updateLut();
+
+    /**
+     * Round a 8.8 fixed point value to the nearest integer.
+     *
+     * @param[in] value 8.8 fixed point value
+     *
+     * @return Rounded value
+     */
+    static inline uint8_t roundValue(uint16_t value)
+    {
+        return static_cast<uint8_t>((value + (1U << (FRACTION_BITS - 1U))) >> FRACTION_BITS);
+    }
+
+    /**
+     * Add the residual fraction to a 8.8 fixed point value and keep the new
+     * fraction for the next frame.
+     *
+     * @param[in]       value       8.8 fixed point value
+     * @param[in,out]   residual    Residual fraction
+     *
+     * @return Integer part of the sum
+     */
+    static inline uint8_t dither(uint16_t value, uint8_t& residual)
+    {
+        const uint16_t SUM = value + residual;
+
+        residual = static_cast<uint8_t>(SUM & UINT8_MAX);
+
+        return static_cast<uint8_t>(SUM >> FRACTION_BITS);
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __COLOR_LUT_H__ */
+
+/** @} */
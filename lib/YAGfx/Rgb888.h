@@ -360,6 +360,22 @@ public:
      */
     void turnColorWheel(uint8_t wheelPos);
 
+    /**
+     * Blend the given color over this color. The result has max. intensity.
+     *
+     * @param[in] color Color, which to blend over this color
+     * @param[in] alpha Opacity of the given color [0; 255] - 0: transparent / 255: opaque
+     */
+    void blend(const Rgb888& color, uint8_t alpha)
+    {
+        m_red       = blendBaseColor(applyIntensity(m_red), color.applyIntensity(color.m_red), alpha);
+        m_green     = blendBaseColor(applyIntensity(m_green), color.applyIntensity(color.m_green), alpha);
+        m_blue      = blendBaseColor(applyIntensity(m_blue), color.applyIntensity(color.m_blue), alpha);
+        m_intensity = MAX_BRIGHT;
+
+        return;
+    }
+
     /**
      * Extract the red base color from a RGB24 value.
      * 
@@ -415,6 +431,24 @@ private:
         return (static_cast<uint16_t>(baseColor) * static_cast<uint16_t>(m_intensity)) / MAX_BRIGHT;
     }
 
+    /**
+     * Blend two base colors in fixed-point arithmetic.
+     * The division by 255 is replaced by (v + (v >> 8)) >> 8, which
+     * rounds exactly for all possible values.
+     *
+     * @param[in] dst   Base color in the background
+     * @param[in] src   Base color in the foreground
+     * @param[in] alpha Opacity of the foreground [0; 255]
+     *
+     * @return Blended base color
+     */
+    static inline uint8_t blendBaseColor(uint8_t dst, uint8_t src, uint8_t alpha)
+    {
+        const uint16_t VALUE = static_cast<uint16_t>(src) * alpha + static_cast<uint16_t>(dst) * (MAX_BRIGHT - alpha) + 128U;
+
+        return static_cast<uint8_t>((VALUE + (VALUE >> 8U)) >> 8U);
+    }
+
 };
 
 /******************************************************************************
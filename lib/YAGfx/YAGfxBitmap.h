@@ -68,6 +68,12 @@ using YAGfxStaticBitmap = BaseGfxStaticBitmap<Color, width, height>;
 /** GFX dynamic bitmap with concrete color. */
 using YAGfxDynamicBitmap = BaseGfxDynamicBitmap<Color>;
 
+/** GFX alpha bitmap with concrete color. */
+using YAGfxAlphaBitmap = BaseGfxAlphaBitmap<Color>;
+
+/** GFX palette bitmap with concrete color. */
+using YAGfxPaletteBitmap = BaseGfxPaletteBitmap<Color>;
+
 /** GFX overlay bitmap with concrete color. */
 using YAGfxOverlayBitmap = BaseGfxOverlayBitmap<Color>;
 
@@ -0,0 +1,88 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Yet another GFX procedural shader engine
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __YAGFX_SHADER_H__
+#define __YAGFX_SHADER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <BaseGfxShader.hpp>
+#include <YAColor.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** State of stateless kernels. */
+using YAGfxShaderNoState = BaseGfxShaderNoState;
+
+/** Read only view on the state of the previous frame.
+ *
+ * @tparam TState   The state per pixel.
+ */
+template < typename TState >
+using YAGfxShaderStateView = BaseGfxShaderStateView<TState>;
+
+/** Per pixel kernel base with concrete color.
+ *
+ * @tparam TState   The state per pixel.
+ * @tparam TKernel  The derived kernel.
+ */
+template < typename TState, typename TKernel >
+using YAGfxPixelKernel = BaseGfxPixelKernel<Color, TState, TKernel>;
+
+/** Procedural shader engine with concrete color.
+ *
+ * @tparam TKernel  The kernel, which calculates the frame.
+ */
+template < typename TKernel >
+using YAGfxShader = BaseGfxShader<Color, TKernel>;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __YAGFX_SHADER_H__ */
+
+/** @} */
@@ -0,0 +1,465 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Decoded bitmap cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "BitmapCache.h"
+
+#include <YAColor.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+const YAGfxBitmap& BitmapCache::Ref::get() const
+{
+    static const YAGfxDynamicBitmap emptyBitmap;
+    const YAGfxBitmap*              bitmap      = &emptyBitmap;
+
+    if (nullptr != m_entry)
+    {
+        if (true == m_entry->paletteBitmap.isAllocated())
+        {
+            bitmap = &m_entry->paletteBitmap;
+        }
+        else
+        {
+            bitmap = &m_entry->bitmap;
+        }
+    }
+
+    return *bitmap;
+}
+
+BmpImgLoader::Ret BitmapCache::load(FS& fs, const String& fileName, Ref& ref)
+{
+    BmpImgLoader::Ret   ret     = BmpImgLoader::RET_OK;
+    File                fd      = fs.open(fileName);
+
+    if (false == fd)
+    {
+        ret = BmpImgLoader::RET_FILE_NOT_FOUND;
+    }
+    else
+    {
+        time_t  lastWrite   = fd.getLastWrite();
+        size_t  fileSize    = fd.size();
+        Entry*  entry       = nullptr;
+
+        fd.close();
+
+        /* Already cached? */
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+
+            entry = find(fileName, lastWrite, fileSize);
+
+            if (nullptr != entry)
+            {
+                borrow(entry, ref);
+            }
+        }
+
+        /* Decode it without blocking the cache, because this takes long. */
+        if (nullptr == entry)
+        {
+            entry = new(std::nothrow) Entry();
+
+            if (nullptr == entry)
+            {
+                ret = BmpImgLoader::RET_IMG_TOO_BIG;
+            }
+            else
+            {
+                ret = decode(fs, fileName, *entry);
+
+                if (BmpImgLoader::RET_OK != ret)
+                {
+                    delete entry;
+                    entry = nullptr;
+                }
+                else
+                {
+                    std::lock_guard<std::mutex> guard(m_mutex);
+                    Entry*                      cachedEntry = nullptr;
+
+                    entry->fileName     = fileName;
+                    entry->lastWrite    = lastWrite;
+                    entry->fileSize     = fileSize;
+
+                    /* Another user may have loaded it in the meantime. */
+                    cachedEntry = find(fileName, lastWrite, fileSize);
+
+                    if (nullptr != cachedEntry)
+                    {
+                        delete entry;
+                        entry = cachedEntry;
+                    }
+                    else
+                    {
+                        insert(entry);
+                    }
+
+                    borrow(entry, ref);
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+size_t BitmapCache::getBudget() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    return m_budget;
+}
+
+void BitmapCache::setBudget(size_t budget)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    m_budget = budget;
+    evict(0U);
+
+    return;
+}
+
+size_t BitmapCache::getUsage() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    return m_usage;
+}
+
+uint8_t BitmapCache::getCount() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    uint8_t                     count   = 0U;
+    uint8_t                     idx     = 0U;
+
+    for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+    {
+        if (nullptr != m_entries[idx])
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+void BitmapCache::clear()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    uint8_t                     idx     = 0U;
+
+    for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+    {
+        if ((nullptr != m_entries[idx]) &&
+            (0U == m_entries[idx]->refCnt))
+        {
+            remove(idx);
+        }
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void BitmapCache::Ref::set(Entry* entry)
+{
+    BitmapCache&                cache   = BitmapCache::getInstance();
+    std::lock_guard<std::mutex> guard(cache.m_mutex);
+
+    if (nullptr != entry)
+    {
+        cache.addRef(entry);
+    }
+
+    if (nullptr != m_entry)
+    {
+        cache.releaseRef(m_entry);
+    }
+
+    m_entry = entry;
+
+    return;
+}
+
+BitmapCache::BitmapCache() :
+    m_entries(),
+    m_budget(DEFAULT_BUDGET),
+    m_usage(0U),
+    m_useCnt(0U),
+    m_mutex()
+{
+}
+
+BitmapCache::~BitmapCache()
+{
+    uint8_t idx = 0U;
+
+    for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+    {
+        if (nullptr != m_entries[idx])
+        {
+            remove(idx);
+        }
+    }
+}
+
+BitmapCache::Entry* BitmapCache::find(const String& fileName, time_t lastWrite, size_t fileSize)
+{
+    Entry*  entry   = nullptr;
+    uint8_t idx     = 0U;
+
+    for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+    {
+        if ((nullptr != m_entries[idx]) &&
+            (fileName == m_entries[idx]->fileName))
+        {
+            /* The file was modified in the meantime? */
+            if ((lastWrite != m_entries[idx]->lastWrite) ||
+                (fileSize != m_entries[idx]->fileSize))
+            {
+                remove(idx);
+            }
+            else
+            {
+                entry = m_entries[idx];
+            }
+
+            break;
+        }
+    }
+
+    return entry;
+}
+
+BmpImgLoader::Ret BitmapCache::decode(FS& fs, const String& fileName, Entry& entry)
+{
+    BmpImgLoader        loader;
+    BmpImgLoader::Ret   ret     = loader.load(fs, fileName, entry.bitmap);
+
+    if (BmpImgLoader::RET_OK == ret)
+    {
+        entry.size = entry.bitmap.getMemorySize();
+
+        /* Icons have usually only a few colors, which makes a
+         * palette bitmap much smaller. Transparent pixels are kept
+         * by a color key, only partial transparent pixels require
+         * the full color bitmap.
+         */
+        if ((true == entry.paletteBitmap.convert(entry.bitmap)) &&
+            (entry.size > entry.paletteBitmap.getMemorySize()))
+        {
+            entry.size = entry.paletteBitmap.getMemorySize();
+            entry.bitmap.release();
+        }
+        else
+        {
+            entry.paletteBitmap.release();
+        }
+    }
+
+    return ret;
+}
+
+void BitmapCache::insert(Entry* entry)
+{
+    uint8_t idx = 0U;
+
+    evict(entry->size);
+
+    /* Find a free slot. If the cache is full of referenced
+     * bitmaps, the bitmap is used without caching it.
+     */
+    while((MAX_ENTRIES > idx) && (nullptr != m_entries[idx]))
+    {
+        ++idx;
+    }
+
+    if (MAX_ENTRIES <= idx)
+    {
+        idx = findLeastRecentlyUsed();
+
+        if (MAX_ENTRIES > idx)
+        {
+            remove(idx);
+        }
+    }
+
+    if (MAX_ENTRIES > idx)
+    {
+        m_entries[idx]      = entry;
+        entry->isCached     = true;
+        m_usage            += entry->size;
+    }
+
+    return;
+}
+
+void BitmapCache::borrow(Entry* entry, Ref& ref)
+{
+    ++m_useCnt;
+    entry->lastUsed = m_useCnt;
+
+    /* Take the reference before the old one is released, because
+     * both may be the same.
+     */
+    addRef(entry);
+
+    if (nullptr != ref.m_entry)
+    {
+        releaseRef(ref.m_entry);
+    }
+
+    ref.m_entry = entry;
+
+    return;
+}
+
+void BitmapCache::addRef(Entry* entry)
+{
+    ++entry->refCnt;
+
+    return;
+}
+
+void BitmapCache::releaseRef(Entry* entry)
+{
+    if (0U < entry->refCnt)
+    {
+        --entry->refCnt;
+    }
+
+    if ((0U == entry->refCnt) &&
+        (false == entry->isCached))
+    {
+        delete entry;
+    }
+
+    return;
+}
+
+void BitmapCache::remove(uint8_t idx)
+{
+    Entry* entry = m_entries[idx];
+
+    m_entries[idx]  = nullptr;
+    m_usage        -= entry->size;
+    entry->isCached = false;
+
+    /* Still borrowed? It will be destroyed with its last reference. */
+    if (0U == entry->refCnt)
+    {
+        delete entry;
+    }
+
+    return;
+}
+
+void BitmapCache::evict(size_t required)
+{
+    while(m_budget < (m_usage + required))
+    {
+        uint8_t idx = findLeastRecentlyUsed();
+
+        if (MAX_ENTRIES <= idx)
+        {
+            break;
+        }
+
+        remove(idx);
+    }
+
+    return;
+}
+
+uint8_t BitmapCache::findLeastRecentlyUsed() const
+{
+    uint8_t found   = MAX_ENTRIES;
+    uint8_t idx     = 0U;
+
+    for(idx = 0U; idx < MAX_ENTRIES; ++idx)
+    {
+        if ((nullptr != m_entries[idx]) &&
+            (0U == m_entries[idx]->refCnt))
+        {
+            if ((MAX_ENTRIES <= found) ||
+                (m_entries[idx]->lastUsed < m_entries[found]->lastUsed))
+            {
+                found = idx;
+            }
+        }
+    }
+
+    return found;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
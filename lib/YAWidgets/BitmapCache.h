@@ -0,0 +1,382 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Decoded bitmap cache
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __BITMAP_CACHE_H__
+#define __BITMAP_CACHE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <time.h>
+#include <mutex>
+#include <YAGfxBitmap.h>
+#include <FS.h>
+
+#include "BmpImgLoader.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Process wide cache of decoded bitmap images, which are shared between all
+ * users, e.g. the widgets of different plugin instances showing the same
+ * icon. A bitmap is identified by its filename, the time of its last
+ * modification and the file size, so a changed file is decoded again.
+ *
+ * Bitmaps with only a few colors are kept as palette bitmap, if this needs
+ * less memory.
+ *
+ * Borrowed bitmaps are immutable and reference counted. Bitmaps which are
+ * not referenced anymore are kept until the memory budget is exceeded,
+ * then the least recently used ones are released first. Referenced bitmaps
+ * are never released, therefore the budget may be exceeded temporarily.
+ *
+ * The cache is locked only for the lookup and the insertion, a bitmap is
+ * decoded without holding the lock. Other users are not blocked by it.
+ */
+class BitmapCache
+{
+private:
+
+    /* Forward declaration */
+    struct Entry;
+
+public:
+
+    /**
+     * Reference to a borrowed bitmap of the cache.
+     */
+    class Ref
+    {
+    public:
+
+        /**
+         * Constructs an empty reference.
+         */
+        Ref() :
+            m_entry(nullptr)
+        {
+        }
+
+        /**
+         * Constructs a reference by copy. Both share the same bitmap.
+         *
+         * @param[in] ref   Reference, which to copy.
+         */
+        Ref(const Ref& ref) :
+            m_entry(nullptr)
+        {
+            set(ref.m_entry);
+        }
+
+        /**
+         * Destroys the reference and gives the bitmap back to the cache.
+         */
+        ~Ref()
+        {
+            release();
+        }
+
+        /**
+         * Assigns a reference. Both share the same bitmap.
+         *
+         * @param[in] ref   Reference, which to assign.
+         *
+         * @return Reference
+         */
+        Ref& operator=(const Ref& ref)
+        {
+            if (&ref != this)
+            {
+                set(ref.m_entry);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Is a bitmap referenced?
+         *
+         * @return If no bitmap is referenced, it will return true otherwise false.
+         */
+        bool isEmpty() const
+        {
+            return (nullptr == m_entry);
+        }
+
+        /**
+         * Get the borrowed bitmap.
+         *
+         * @return Bitmap, which is empty if nothing is referenced.
+         */
+        const YAGfxBitmap& get() const;
+
+        /**
+         * Give the bitmap back to the cache.
+         */
+        void release()
+        {
+            set(nullptr);
+        }
+
+    private:
+
+        friend class BitmapCache;
+
+        Entry*  m_entry;    /**< Cache entry with the bitmap */
+
+        /**
+         * Reference another cache entry.
+         *
+         * @param[in] entry Cache entry, may be nullptr.
+         */
+        void set(Entry* entry);
+    };
+
+    /** Default memory budget in bytes. */
+    static const size_t     DEFAULT_BUDGET  = 32U * 1024U;
+
+    /** Max. number of cached bitmaps. */
+    static const uint8_t    MAX_ENTRIES     = 16U;
+
+    /**
+     * Get the bitmap cache instance.
+     *
+     * @return Bitmap cache
+     */
+    static BitmapCache& getInstance()
+    {
+        static BitmapCache instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Borrow a bitmap image from the cache. If it is not cached yet or the
+     * file was modified in the meantime, it will be loaded from the filesystem.
+     *
+     * @param[in]   fs          Filesystem
+     * @param[in]   fileName    Filename with full path
+     * @param[out]  ref         Reference to the bitmap
+     *
+     * @return If successful, it will return BmpImgLoader::RET_OK. See BmpImgLoader::Ret type for more informations.
+     */
+    BmpImgLoader::Ret load(FS& fs, const String& fileName, Ref& ref);
+
+    /**
+     * Get the memory budget.
+     *
+     * @return Memory budget in bytes
+     */
+    size_t getBudget() const;
+
+    /**
+     * Set the memory budget. Not referenced bitmaps will be released until
+     * the cache fits into it.
+     *
+     * @param[in] budget    Memory budget in bytes
+     */
+    void setBudget(size_t budget);
+
+    /**
+     * Get the memory, which is used by all cached bitmaps.
+     *
+     * @return Used memory in bytes
+     */
+    size_t getUsage() const;
+
+    /**
+     * Get the number of cached bitmaps.
+     *
+     * @return Number of cached bitmaps
+     */
+    uint8_t getCount() const;
+
+    /**
+     * Release all bitmaps, which are not referenced.
+     */
+    void clear();
+
+private:
+
+    /**
+     * A single cached bitmap.
+     */
+    struct Entry
+    {
+        String              fileName;       /**< Filename with full path */
+        time_t              lastWrite;      /**< Time of last file modification */
+        size_t              fileSize;       /**< File size in bytes */
+        YAGfxAlphaBitmap    bitmap;         /**< Decoded bitmap with full colors and alpha channel */
+        YAGfxPaletteBitmap  paletteBitmap;  /**< Decoded bitmap with palette, used instead if smaller */
+        size_t              size;           /**< Bitmap size in bytes */
+        uint32_t            refCnt;         /**< Number of references */
+        uint32_t            lastUsed;       /**< Usage timestamp for the LRU replacement */
+        bool                isCached;       /**< Is the entry part of the cache? */
+
+        /**
+         * Constructs a cache entry.
+         */
+        Entry() :
+            fileName(),
+            lastWrite(0),
+            fileSize(0U),
+            bitmap(),
+            paletteBitmap(),
+            size(0U),
+            refCnt(0U),
+            lastUsed(0U),
+            isCached(false)
+        {
+        }
+    };
+
+    Entry*              m_entries[MAX_ENTRIES]; /**< Cached bitmaps */
+    size_t              m_budget;               /**< Memory budget in bytes */
+    size_t              m_usage;                /**< Used memory in bytes */
+    uint32_t            m_useCnt;               /**< Usage counter, used as LRU timestamp */
+    mutable std::mutex  m_mutex;                /**< Protects the cache against concurrent access */
+
+    /**
+     * Constructs the bitmap cache.
+     */
+    BitmapCache();
+
+    /**
+     * Destroys the bitmap cache.
+     */
+    ~BitmapCache();
+
+    BitmapCache(const BitmapCache& cache);
+    BitmapCache& operator=(const BitmapCache& cache);
+
+    /**
+     * Find a cached entry. A entry of a modified file is removed.
+     * The mutex must be taken.
+     *
+     * @param[in] fileName  Filename with full path
+     * @param[in] lastWrite Time of last file modification
+     * @param[in] fileSize  File size in bytes
+     *
+     * @return Cache entry or nullptr if not found.
+     */
+    Entry* find(const String& fileName, time_t lastWrite, size_t fileSize);
+
+    /**
+     * Decode a bitmap image into a entry, which is not part of the cache yet.
+     * It doesn't access the cache, therefore the mutex is not necessary.
+     *
+     * @param[in]   fs          Filesystem
+     * @param[in]   fileName    Filename with full path
+     * @param[out]  entry       Cache entry
+     *
+     * @return If successful, it will return BmpImgLoader::RET_OK. See BmpImgLoader::Ret type for more informations.
+     */
+    static BmpImgLoader::Ret decode(FS& fs, const String& fileName, Entry& entry);
+
+    /**
+     * Insert a decoded entry into the cache. If the cache is full of
+     * referenced bitmaps, the entry is not cached.
+     * The mutex must be taken.
+     *
+     * @param[in] entry Cache entry
+     */
+    void insert(Entry* entry);
+
+    /**
+     * Reference a entry and release the entry, which was referenced before.
+     * The mutex must be taken.
+     *
+     * @param[in]       entry   Cache entry
+     * @param[in,out]   ref     Reference
+     */
+    void borrow(Entry* entry, Ref& ref);
+
+    /**
+     * Increase the reference counter of a entry.
+     *
+     * @param[in] entry Cache entry
+     */
+    void addRef(Entry* entry);
+
+    /**
+     * Decrease the reference counter of a entry. Entries which are not part
+     * of the cache anymore, are destroyed with the last reference.
+     *
+     * @param[in] entry Cache entry
+     */
+    void releaseRef(Entry* entry);
+
+    /**
+     * Remove a entry from the cache. If it is not referenced anymore, it
+     * will be destroyed, otherwise with its last reference.
+     *
+     * @param[in] idx   Index of the entry in the cache.
+     */
+    void remove(uint8_t idx);
+
+    /**
+     * Release the least recently used not referenced entries, until the
+     * required memory fits into the budget.
+     *
+     * @param[in] required  Required memory in bytes
+     */
+    void evict(size_t required);
+
+    /**
+     * Get the index of the least recently used not referenced entry.
+     *
+     * @return Index of entry or MAX_ENTRIES if there is none.
+     */
+    uint8_t findLeastRecentlyUsed() const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __BITMAP_CACHE_H__ */
+
+/** @} */
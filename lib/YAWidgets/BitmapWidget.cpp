@@ -36,7 +36,7 @@
 
 #include <YAColor.h>
 #include <Logging.h>
-#include <BmpImgLoader.h>
+#include <BitmapCache.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -72,7 +72,10 @@ BitmapWidget& BitmapWidget::operator=(const BitmapWidget& widget)
         Widget::operator=(widget);
         
         m_bitmap        = widget.m_bitmap;
+        m_cachedBitmap  = widget.m_cachedBitmap;
         m_spriteSheet   = widget.m_spriteSheet;
+        m_animation     = widget.m_animation;
+        m_gif           = widget.m_gif;
         m_timer         = widget.m_timer;
         m_duration      = widget.m_duration;
     }
@@ -90,8 +93,7 @@ bool BitmapWidget::load(FS& fs, const String& filename)
     }
     else
     {
-        BmpImgLoader        loader;
-        BmpImgLoader::Ret   ret = loader.load(fs, filename, m_bitmap);
+        BmpImgLoader::Ret ret = BitmapCache::getInstance().load(fs, filename, m_cachedBitmap);
 
         if (BmpImgLoader::RET_OK != ret)
         {
@@ -121,8 +123,12 @@ bool BitmapWidget::load(FS& fs, const String& filename)
             /* Avoid wasting memory. Additional this is important to detect whether the sprite sheet
              * shall be shown or the single bitmap image.
              */
+            m_bitmap.release();
             m_spriteSheet.release();
+            m_animation.release();
+            m_gif.close();
             m_timer.stop();
+            invalidate();
 
             isSuccessful = true;
         }
@@ -151,7 +157,12 @@ bool BitmapWidget::loadSpriteSheet(FS& fs, const String& spriteSheetFileName, co
         /* Avoid wasting memory. Additional this is important to detect whether the sprite sheet
          * shall be shown or the single bitmap image.
          */
-        m_bitmap.release();        
+        m_bitmap.release();
+        m_cachedBitmap.release();
+        m_animation.release();
+        m_gif.close();
+        m_timer.stop();
+        invalidate();
 
         isSuccessful = true;
     }
@@ -159,6 +170,89 @@ bool BitmapWidget::loadSpriteSheet(FS& fs, const String& spriteSheetFileName, co
     return isSuccessful;
 }
 
+bool BitmapWidget::loadAnimation(FS& fs, const String& filename)
+{
+    bool isSuccessful = false;
+
+    if (false == fs.exists(filename))
+    {
+        LOG_WARNING("File %s doesn't exists.", filename.c_str());
+    }
+    else if (false == m_animation.load(fs, filename))
+    {
+        LOG_ERROR("File %s has invalid format.", filename.c_str());
+    }
+    else
+    {
+        /* Calculate duration per frame. */
+        m_duration = 1000U / m_animation.getFPS();
+
+        /* Avoid wasting memory. The sprite animation has its own canvas. */
+        m_bitmap.release();
+        m_cachedBitmap.release();
+        m_spriteSheet.release();
+        m_gif.close();
+        m_timer.stop();
+        invalidate();
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool BitmapWidget::loadGif(FS& fs, const String& filename)
+{
+    bool isSuccessful = false;
+
+    if (false == fs.exists(filename))
+    {
+        LOG_WARNING("File %s doesn't exists.", filename.c_str());
+    }
+    else
+    {
+        GifDecoder::Ret ret = m_gif.open(fs, filename);
+
+        if (GifDecoder::RET_OK != ret)
+        {
+            if (GifDecoder::RET_FILE_NOT_FOUND == ret)
+            {
+                LOG_ERROR("Failed to open file %s.", filename.c_str());
+            }
+            else if (GifDecoder::RET_FILE_FORMAT_INVALID == ret)
+            {
+                LOG_ERROR("File %s has invalid format.", filename.c_str());
+            }
+            else if (GifDecoder::RET_FILE_FORMAT_UNSUPPORTED == ret)
+            {
+                LOG_ERROR("File %s has unsupported format.", filename.c_str());
+            }
+            else if (GifDecoder::RET_IMG_TOO_BIG == ret)
+            {
+                LOG_ERROR("File %s is too big.", filename.c_str());
+            }
+            else
+            {
+                LOG_ERROR("Failed to load %s because of internal error.", filename.c_str());
+            }
+        }
+        else
+        {
+            /* Avoid wasting memory. The GIF decoder has its own canvas. */
+            m_bitmap.release();
+            m_cachedBitmap.release();
+            m_spriteSheet.release();
+            m_animation.release();
+            m_timer.stop();
+            invalidate();
+
+            isSuccessful = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
 void BitmapWidget::setSpriteSheetForward(bool forward)
 {
     m_spriteSheet.setForward(forward);
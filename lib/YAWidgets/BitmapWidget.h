@@ -46,9 +46,13 @@
 #include <stdint.h>
 #include <FS.h>
 #include <SimpleTimer.hpp>
+#include <Util.h>
 
 #include "Widget.hpp"
 #include "SpriteSheet.h"
+#include "SpriteAnimation.h"
+#include "BitmapCache.h"
+#include "GifDecoder.h"
 
 /******************************************************************************
  * Macros
@@ -60,6 +64,10 @@
 
 /**
  * Bitmap widget, showing a simple bitmap.
+ * Bitmaps loaded from the filesystem are borrowed from the bitmap cache
+ * and shared with other widgets.
+ * Animated GIF images are decoded frame by frame from the filesystem.
+ * Precompiled sprite animations play only the changed pixels per frame.
  */
 class BitmapWidget : public Widget
 {
@@ -71,7 +79,10 @@ public:
     BitmapWidget() :
         Widget(WIDGET_TYPE),
         m_bitmap(),
+        m_cachedBitmap(),
         m_spriteSheet(),
+        m_animation(),
+        m_gif(),
         m_timer(),
         m_duration(0U)
     {
@@ -85,7 +96,10 @@ public:
     BitmapWidget(const BitmapWidget& widget) :
         Widget(WIDGET_TYPE),
         m_bitmap(widget.m_bitmap),
+        m_cachedBitmap(widget.m_cachedBitmap),
         m_spriteSheet(widget.m_spriteSheet),
+        m_animation(widget.m_animation),
+        m_gif(widget.m_gif),
         m_timer(widget.m_timer),
         m_duration(widget.m_duration)
     {
@@ -117,10 +131,17 @@ public:
             m_bitmap.copy(bitmap);
         }
 
+        /* Give a borrowed bitmap back to the cache. */
+        m_cachedBitmap.release();
+
         /* Release sprite sheet to avoid wasting memory. The widget can
          * only show one of them.
          */
         m_spriteSheet.release();
+        m_animation.release();
+        m_gif.close();
+
+        invalidate();
     }
 
     /**
@@ -130,11 +151,19 @@ public:
      */
     const YAGfxBitmap& get() const
     {
-        return m_bitmap;
+        const YAGfxBitmap* bitmap = &m_bitmap;
+
+        if (false == m_cachedBitmap.isEmpty())
+        {
+            bitmap = &m_cachedBitmap.get();
+        }
+
+        return *bitmap;
     }
 
     /**
-     * Load bitmap image from filesystem.
+     * Load bitmap image from filesystem. It is borrowed from the bitmap
+     * cache, so only the first widget decodes it.
      * If a sprite sheet is active, it will be disabled.
      *
      * @param[in] fs        Filesystem
@@ -155,6 +184,29 @@ public:
      */
     bool loadSpriteSheet(FS& fs, const String& spriteSheetFileName, const String& textureFileName);
 
+    /**
+     * Load sprite animation file (.anim) from filesystem.
+     * If a sprite sheet is active, it will be disabled.
+     *
+     * @param[in] fs        Filesystem
+     * @param[in] filename  Filename with full path
+     *
+     * @return If successful loaded it will return true otherwise false.
+     */
+    bool loadAnimation(FS& fs, const String& filename);
+
+    /**
+     * Load animated GIF image (.gif) from filesystem. Only the current frame
+     * is kept in memory, the next one is decoded when its time has come.
+     * If a sprite sheet is active, it will be disabled.
+     *
+     * @param[in] fs        Filesystem
+     * @param[in] filename  Filename with full path
+     *
+     * @return If successful loaded it will return true otherwise false.
+     */
+    bool loadGif(FS& fs, const String& filename);
+
     /** Set the animation control flag FORWARD of a sprite sheet 
      * 
      * @param[in] forward The state to be set.
@@ -166,6 +218,47 @@ public:
      * @param[in] isRepeat The state to be set.
      */
     void setSpriteSheetRepeatInfinite(bool repeat);
+
+    /**
+     * Is the bitmap widget invalid and must be painted again?
+     * It is as long as an animation runs. A finished GIF animation or
+     * a stopped one, because of a corrupt file, doesn't run anymore.
+     *
+     * @return If the widget is invalid, it will return true otherwise false.
+     */
+    bool isInvalid() const override
+    {
+        return ((true == Widget::isInvalid()) ||
+                (true == m_timer.isTimerRunning()));
+    }
+
+    /**
+     * A single bitmap image with full colors fills its whole area. Cached
+     * bitmaps, sprite sheets and animations may contain transparent pixels.
+     *
+     * @return If the widget is opaque, it will return true otherwise false.
+     */
+    bool isOpaque() const override
+    {
+        return ((&m_bitmap == &getShownBitmap()) &&
+                (true == m_bitmap.isAllocated()));
+    }
+
+    /**
+     * Get the area in the canvas, which the shown bitmap covers.
+     *
+     * @param[in]   gfx     Graphics interface of the canvas
+     * @param[out]  area    Area in the canvas
+     */
+    void getArea(const YAGfx& gfx, Area& area) const override
+    {
+        const YAGfxBitmap& bitmap = getShownBitmap();
+
+        UTIL_NOT_USED(gfx);
+
+        area = Area(m_posX, m_posY, bitmap.getWidth(), bitmap.getHeight());
+        return;
+    }
     
     /** Widget type string */
     static const char* WIDGET_TYPE;
@@ -173,9 +266,42 @@ public:
 private:
 
     YAGfxDynamicBitmap  m_bitmap;       /**< Bitmap image which is shown if no sprite sheet is loaded. */
+    BitmapCache::Ref    m_cachedBitmap; /**< Bitmap image from the cache, which is shown instead of the bitmap image. */
     SpriteSheet         m_spriteSheet;  /**< Sprite sheet for animation with texture. */
-    SimpleTimer         m_timer;        /**< Timer used for sprite sheet. */
-    uint32_t            m_duration;     /**< Duration of one frame in ms. */
+    SpriteAnimation     m_animation;    /**< Precompiled sprite animation. */
+    GifDecoder          m_gif;          /**< GIF image decoder for animation. */
+    SimpleTimer         m_timer;        /**< Timer used for sprite sheet and GIF animation. */
+    uint32_t            m_duration;     /**< Duration of one sprite sheet or sprite animation frame in ms. */
+
+    /**
+     * Get the bitmap, which is currently shown.
+     *
+     * @return Bitmap
+     */
+    const YAGfxBitmap& getShownBitmap() const
+    {
+        const YAGfxBitmap* bitmap = &get();
+
+        if (true == m_gif.isOpen())
+        {
+            bitmap = &m_gif.getFrame();
+        }
+        else if (false == m_animation.isEmpty())
+        {
+            bitmap = &m_animation.getFrame();
+        }
+        else if (false == m_spriteSheet.isEmpty())
+        {
+            bitmap = &m_spriteSheet.getFrame();
+        }
+        else
+        {
+            /* Single bitmap image. */
+            ;
+        }
+
+        return *bitmap;
+    }
 
     /**
      * Paint the widget with the given graphics interface.
@@ -184,9 +310,73 @@ private:
      */
     void paint(YAGfx& gfx) override
     {
-        if (true == m_spriteSheet.isEmpty())
+        if (true == m_gif.isOpen())
+        {
+            gfx.drawBitmap(m_posX, m_posY, m_gif.getFrame());
+
+            /* A finished animation keeps its last frame and is not started again. */
+            if (true == m_gif.isFinished())
+            {
+                ;
+            }
+            /* If timer is not running, start it. */
+            else if (false == m_timer.isTimerRunning())
+            {
+                m_timer.start(m_gif.getDelay());
+            }
+            /* If the timer has a timeout, decode next frame and restart timer.
+             * Every frame has its own delay.
+             */
+            else if (true == m_timer.isTimeout())
+            {
+                /* A corrupt file is closed, otherwise it would be decoded
+                 * again and again. The last frame stays on the canvas.
+                 */
+                if (GifDecoder::RET_OK != m_gif.next())
+                {
+                    m_gif.close();
+                    m_timer.stop();
+                }
+                /* The timer is stopped, so the widget is not painted anymore. */
+                else if (true == m_gif.isFinished())
+                {
+                    m_timer.stop();
+                }
+                else
+                {
+                    m_timer.start(m_gif.getDelay());
+                }
+            }
+            else
+            {
+                /* Nothing to do. */
+                ;
+            }
+        }
+        else if (false == m_animation.isEmpty())
+        {
+            gfx.drawBitmap(m_posX, m_posY, m_animation.getFrame());
+
+            /* If timer is not running, start it. */
+            if (false == m_timer.isTimerRunning())
+            {
+                m_timer.start(m_duration);
+            }
+            /* If the timer has a timeout, apply next frame and restart timer. */
+            else if (true == m_timer.isTimeout())
+            {
+                m_animation.next();
+                m_timer.start(m_duration);
+            }
+            else
+            {
+                /* Nothing to do. */
+                ;
+            }
+        }
+        else if (true == m_spriteSheet.isEmpty())
         {
-            gfx.drawBitmap(m_posX, m_posY, m_bitmap);
+            gfx.drawBitmap(m_posX, m_posY, get());
         }
         else
         {
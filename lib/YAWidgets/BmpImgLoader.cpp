@@ -97,6 +97,29 @@ typedef enum
 
 } CompressionMethod;
 
+/** DIB header sizes of the supported header versions. */
+typedef enum
+{
+    DIB_HEADER_SIZE_INFO    = 40,   /**< BITMAPINFOHEADER */
+    DIB_HEADER_SIZE_V2      = 52,   /**< BITMAPV2INFOHEADER, with RGB bit masks */
+    DIB_HEADER_SIZE_V3      = 56,   /**< BITMAPV3INFOHEADER, with RGBA bit masks */
+    DIB_HEADER_SIZE_V4      = 108,  /**< BITMAPV4HEADER */
+    DIB_HEADER_SIZE_V5      = 124   /**< BITMAPV5HEADER */
+
+} DibHeaderSize;
+
+/** Bit mask of the red channel in a 32 bit pixel (BGRA). */
+static const uint32_t   BIT_MASK_RED    = 0x00FF0000U;
+
+/** Bit mask of the green channel in a 32 bit pixel (BGRA). */
+static const uint32_t   BIT_MASK_GREEN  = 0x0000FF00U;
+
+/** Bit mask of the blue channel in a 32 bit pixel (BGRA). */
+static const uint32_t   BIT_MASK_BLUE   = 0x000000FFU;
+
+/** Bit mask of the alpha channel in a 32 bit pixel (BGRA). */
+static const uint32_t   BIT_MASK_ALPHA  = 0xFF000000U;
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -110,6 +133,42 @@ typedef enum
  *****************************************************************************/
 
 BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxDynamicBitmap& bitmap)
+{
+    return loadImage(fs, fileName, bitmap, nullptr);
+}
+
+BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxAlphaBitmap& bitmap)
+{
+    return loadImage(fs, fileName, bitmap, &bitmap);
+}
+
+BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxPaletteBitmap& bitmap)
+{
+    YAGfxDynamicBitmap  fullColorBitmap;
+    Ret                 ret             = load(fs, fileName, fullColorBitmap);
+
+    bitmap.release();
+
+    if (RET_OK == ret)
+    {
+        if (false == bitmap.convert(fullColorBitmap))
+        {
+            ret = RET_IMG_TOO_MANY_COLORS;
+        }
+    }
+
+    return ret;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+BmpImgLoader::Ret BmpImgLoader::loadImage(FS& fs, const String& fileName, YAGfxDynamicBitmap& bitmap, YAGfxAlphaBitmap* alphaBitmap)
 {
     Ret     ret = RET_OK;
     File    fd  = fs.open(fileName);
@@ -122,6 +181,7 @@ BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxDynami
     {
         BmpFileHeader   bmpFileHeader;
         BmpV5Header     dibHeader;
+        bool            isAlphaUsed     = false;
 
         if (false == loadBmpFileHeader(fd, bmpFileHeader))
         {
@@ -136,17 +196,13 @@ BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxDynami
         {
             ret = RET_FILE_FORMAT_INVALID;
         }
-        /* Contains the bitmap file the supported DIB header?
-         * Planes must be 1.
-         * Compression is not supported.
-         * Palette colors are not supported.
-         * 24 and 32 bits per pixel are supported.
-         */
-        else if ((sizeof(dibHeader) != dibHeader.headerSize) ||
-                 (1 != dibHeader.planes) ||
-                 (COMPRESSION_METHOD_RGB != dibHeader.compression) ||
-                 (0 < dibHeader.paletteColors) ||
-                 ((24 != dibHeader.bpp) && (32 != dibHeader.bpp)))
+        /* Contains the bitmap file the supported DIB header? */
+        else if (false == isDibHeaderSupported(dibHeader, nullptr != alphaBitmap))
+        {
+            ret = RET_FILE_FORMAT_UNSUPPORTED;
+        }
+        else if ((COMPRESSION_METHOD_BITFIELDS == dibHeader.compression) &&
+                 (false == loadBitFields(fd, dibHeader, isAlphaUsed)))
         {
             ret = RET_FILE_FORMAT_UNSUPPORTED;
         }
@@ -161,7 +217,7 @@ BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxDynami
             uint16_t width  = abs(dibHeader.imageWidth);
             uint16_t height = abs(dibHeader.imageHeight);
 
-            bitmap.release();
+            releaseImage(bitmap, alphaBitmap);
 
             if (false == bitmap.create(width, height))
             {
@@ -217,6 +273,11 @@ BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxDynami
                             Color color(lineBuffer[2], lineBuffer[1], lineBuffer[0]);
 
                             bitmap.drawPixel(x, y, color);
+
+                            if (true == isAlphaUsed)
+                            {
+                                alphaBitmap->setAlpha(x, y, lineBuffer[3]);
+                            }
                         }
 
                         ++x;
@@ -232,19 +293,23 @@ BmpImgLoader::Ret BmpImgLoader::load(FS& fs, const String& fileName, YAGfxDynami
 
     if (RET_OK != ret)
     {
-        bitmap.release();
+        releaseImage(bitmap, alphaBitmap);
     }
 
     return ret;
 }
 
-/******************************************************************************
- * Protected Methods
- *****************************************************************************/
-
-/******************************************************************************
- * Private Methods
- *****************************************************************************/
+void BmpImgLoader::releaseImage(YAGfxDynamicBitmap& bitmap, YAGfxAlphaBitmap* alphaBitmap)
+{
+    if (nullptr != alphaBitmap)
+    {
+        alphaBitmap->release();
+    }
+    else
+    {
+        bitmap.release();
+    }
+}
 
 bool BmpImgLoader::loadBmpFileHeader(File& fd, BmpFileHeader& header)
 {
@@ -270,6 +335,88 @@ bool BmpImgLoader::loadDibHeader(File& fd, BmpV5Header& header)
     return isSuccessful;
 }
 
+bool BmpImgLoader::isDibHeaderSupported(const BmpV5Header& header, bool isExtended) const
+{
+    bool isSupported = false;
+
+    /* Planes must be 1.
+     * Palette colors are not supported.
+     */
+    if ((1 != header.planes) ||
+        (0 < header.paletteColors))
+    {
+        /* Not supported. */
+        ;
+    }
+    /* Only the info header without compression.
+     * 24 and 32 bits per pixel are supported.
+     */
+    else if (false == isExtended)
+    {
+        isSupported = ((sizeof(header) == header.headerSize) &&
+                       (COMPRESSION_METHOD_RGB == header.compression) &&
+                       ((24 == header.bpp) || (32 == header.bpp)));
+    }
+    /* All header versions, which follow the info header.
+     * 24 and 32 bits per pixel without compression are supported.
+     * 32 bits per pixel with bit fields are supported.
+     */
+    else if ((DIB_HEADER_SIZE_INFO == header.headerSize) ||
+             (DIB_HEADER_SIZE_V2 == header.headerSize) ||
+             (DIB_HEADER_SIZE_V3 == header.headerSize) ||
+             (DIB_HEADER_SIZE_V4 == header.headerSize) ||
+             (DIB_HEADER_SIZE_V5 == header.headerSize))
+    {
+        if (COMPRESSION_METHOD_RGB == header.compression)
+        {
+            isSupported = ((24 == header.bpp) || (32 == header.bpp));
+        }
+        else if (COMPRESSION_METHOD_BITFIELDS == header.compression)
+        {
+            isSupported = (32 == header.bpp);
+        }
+        else
+        {
+            /* Compression is not supported. */
+            ;
+        }
+    }
+    else
+    {
+        /* Unknown header version. */
+        ;
+    }
+
+    return isSupported;
+}
+
+bool BmpImgLoader::loadBitFields(File& fd, const BmpV5Header& header, bool& isAlphaUsed)
+{
+    bool        isSupported = false;
+    uint32_t    masks[4U]   = { 0U, 0U, 0U, 0U };
+    size_t      size        = 3U * sizeof(uint32_t);
+
+    /* The bit masks directly follow the info header. Since V3 the header
+     * contains the alpha mask too, before it is the red, green and blue mask only.
+     */
+    if (DIB_HEADER_SIZE_V3 <= header.headerSize)
+    {
+        size = sizeof(masks);
+    }
+
+    if ((size == fd.read(reinterpret_cast<uint8_t*>(masks), size)) &&
+        (BIT_MASK_RED == masks[0U]) &&
+        (BIT_MASK_GREEN == masks[1U]) &&
+        (BIT_MASK_BLUE == masks[2U]) &&
+        ((BIT_MASK_ALPHA == masks[3U]) || (0U == masks[3U])))
+    {
+        isAlphaUsed = (BIT_MASK_ALPHA == masks[3U]);
+        isSupported = true;
+    }
+
+    return isSupported;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
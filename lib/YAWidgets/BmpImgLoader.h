@@ -65,6 +65,10 @@ typedef struct _BmpV5Header BmpV5Header;
  * - No compression
  * - No palette colors
  * - Resolution of max. 65535 x 65535 pixels
+ *
+ * Loading into a bitmap with alpha channel additionally supports 32 bit per
+ * pixel images with bit fields (BGRA), like they are written by most
+ * image editors.
  */
 class BmpImgLoader
 {
@@ -93,7 +97,8 @@ public:
         RET_FILE_NOT_FOUND,             /**< File not found. */
         RET_FILE_FORMAT_INVALID,        /**< Invalid file format. */
         RET_FILE_FORMAT_UNSUPPORTED,    /**< File format is not supported. */
-        RET_IMG_TOO_BIG                 /**< Image size is too big. */
+        RET_IMG_TOO_BIG,                /**< Image size is too big. */
+        RET_IMG_TOO_MANY_COLORS         /**< Image can't be converted to a palette bitmap. */
     };
 
     /**
@@ -107,8 +112,54 @@ public:
      */
     Ret load(FS& fs, const String& fileName, YAGfxDynamicBitmap& bitmap);
 
+    /**
+     * Load bitmap image (.bmp) with alpha channel from file system to bitmap
+     * buffer. Images without alpha channel are loaded as opaque bitmap.
+     * 
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the file
+     * @param[out] bitmap   Bitmap buffer with alpha channel
+     * 
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret load(FS& fs, const String& fileName, YAGfxAlphaBitmap& bitmap);
+
+    /**
+     * Load bitmap image (.bmp) from file system and convert it to a palette
+     * bitmap. The number of bits per pixel depends on the number of colors.
+     * If the image can't be converted, because it has more than 256 colors
+     * or the memory is not sufficient, RET_IMG_TOO_MANY_COLORS is returned.
+     * 
+     * @param[in] fs        File system
+     * @param[in] fileName  Name of the file
+     * @param[out] bitmap   Palette bitmap
+     * 
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret load(FS& fs, const String& fileName, YAGfxPaletteBitmap& bitmap);
+
 private:
 
+    /**
+     * Load bitmap image (.bmp) from file system to bitmap buffer.
+     * 
+     * @param[in] fs            File system
+     * @param[in] fileName      Name of the file
+     * @param[out] bitmap       Bitmap buffer
+     * @param[out] alphaBitmap  Same bitmap buffer, if the alpha channel shall be loaded, otherwise nullptr.
+     * 
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret loadImage(FS& fs, const String& fileName, YAGfxDynamicBitmap& bitmap, YAGfxAlphaBitmap* alphaBitmap);
+
+    /**
+     * Release the bitmap buffer and the alpha channel.
+     * 
+     * @param[out] bitmap       Bitmap buffer
+     * @param[out] alphaBitmap  Same bitmap buffer with alpha channel or nullptr.
+     */
+    void releaseImage(YAGfxDynamicBitmap& bitmap, YAGfxAlphaBitmap* alphaBitmap);
+
     /**
      * Load bitmap file header from file system.
      * 
@@ -128,6 +179,28 @@ private:
      * @return If successful, it will return true otherwise false.
      */
     bool loadDibHeader(File& fd, BmpV5Header& header);
+
+    /**
+     * Is the DIB header supported?
+     * 
+     * @param[in] header        DIB header
+     * @param[in] isExtended    Support the extended header versions and 32 bit per pixel with bit fields.
+     *
+     * @return If supported, it will return true otherwise false.
+     */
+    bool isDibHeaderSupported(const BmpV5Header& header, bool isExtended) const;
+
+    /**
+     * Load the bit fields, which follow the DIB header. Only the BGRA order
+     * with 8 bit per channel is supported.
+     * 
+     * @param[in] fd            File descriptor
+     * @param[in] header        DIB header
+     * @param[out] isAlphaUsed  Contains the image an alpha channel?
+     *
+     * @return If supported, it will return true otherwise false.
+     */
+    bool loadBitFields(File& fd, const BmpV5Header& header, bool& isAlphaUsed);
 };
 
 /******************************************************************************
@@ -0,0 +1,877 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming GIF image decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "GifDecoder.h"
+
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** GIF signature and version of the 1987 specification. */
+static const char       GIF_SIGNATURE_87A[]         = "GIF87a";
+
+/** GIF signature and version of the 1989 specification. */
+static const char       GIF_SIGNATURE_89A[]         = "GIF89a";
+
+/** Size of the GIF signature and version in byte. */
+static const size_t     GIF_SIGNATURE_SIZE          = 6U;
+
+/** Block type: Extension introducer */
+static const uint8_t    EXTENSION_INTRODUCER        = 0x21U;
+
+/** Block type: Image separator */
+static const uint8_t    IMAGE_SEPARATOR             = 0x2CU;
+
+/** Block type: Trailer, which marks the end of the file. */
+static const uint8_t    TRAILER                     = 0x3BU;
+
+/** Extension label: Graphic control extension */
+static const uint8_t    LABEL_GRAPHIC_CONTROL       = 0xF9U;
+
+/** Extension label: Application extension */
+static const uint8_t    LABEL_APPLICATION           = 0xFFU;
+
+/** Application identifier and authentication code of the animation loop extension. */
+static const char       APP_ID_NETSCAPE[]           = "NETSCAPE2.0";
+
+/** Size of the application identifier and authentication code in byte. */
+static const uint8_t    APP_ID_SIZE                 = 11U;
+
+/** Sub-block id of the loop count in the animation loop extension. */
+static const uint8_t    NETSCAPE_LOOP_COUNT_ID      = 0x01U;
+
+/** Flag: Global/local color table present */
+static const uint8_t    FLAG_COLOR_TABLE            = 0x80U;
+
+/** Flag: Image is interlaced */
+static const uint8_t    FLAG_INTERLACED             = 0x40U;
+
+/** Mask of the color table size. */
+static const uint8_t    MASK_COLOR_TABLE_SIZE       = 0x07U;
+
+/** Flag: Transparent color index is given */
+static const uint8_t    FLAG_TRANSPARENT            = 0x01U;
+
+/** Shift of the disposal method in the graphic control extension. */
+static const uint8_t    DISPOSAL_SHIFT              = 2U;
+
+/** Mask of the disposal method in the graphic control extension. */
+static const uint8_t    DISPOSAL_MASK               = 0x07U;
+
+/** Min. LZW code size in bit. */
+static const uint8_t    LZW_MIN_CODE_SIZE           = 2U;
+
+/** Max. LZW min. code size in bit, which is enough for 256 colors. */
+static const uint8_t    LZW_MAX_MIN_CODE_SIZE       = 8U;
+
+/** Max. LZW code size in bit. */
+static const uint8_t    LZW_MAX_CODE_SIZE           = 12U;
+
+/** Number of passes of interlaced images. */
+static const uint8_t    INTERLACE_PASSES            = 4U;
+
+/** First row of every interlace pass. */
+static const uint8_t    INTERLACE_START[INTERLACE_PASSES]   = { 0U, 4U, 2U, 1U };
+
+/** Row step of every interlace pass. */
+static const uint8_t    INTERLACE_STEP[INTERLACE_PASSES]    = { 8U, 8U, 4U, 2U };
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+GifDecoder::GifDecoder() :
+    m_fs(nullptr),
+    m_fileName(),
+    m_fd(nullptr),
+    m_work(nullptr),
+    m_canvas(),
+    m_backup(),
+    m_globalColorCnt(0U),
+    m_firstFramePos(0U),
+    m_delay(DEFAULT_DELAY),
+    m_disposal(DISPOSAL_NONE),
+    m_frameX(0),
+    m_frameY(0),
+    m_frameWidth(0U),
+    m_frameHeight(0U),
+    m_frameCnt(0U),
+    m_hasLoopCount(false),
+    m_loopCnt(0U),
+    m_loop(0U),
+    m_isFinished(false),
+    m_blockLen(0U),
+    m_blockIdx(0U),
+    m_isDataEnd(false),
+    m_bitBuffer(0U),
+    m_bitCnt(0U)
+{
+}
+
+GifDecoder::GifDecoder(const GifDecoder& decoder) :
+    m_fs(nullptr),
+    m_fileName(),
+    m_fd(nullptr),
+    m_work(nullptr),
+    m_canvas(),
+    m_backup(),
+    m_globalColorCnt(0U),
+    m_firstFramePos(0U),
+    m_delay(DEFAULT_DELAY),
+    m_disposal(DISPOSAL_NONE),
+    m_frameX(0),
+    m_frameY(0),
+    m_frameWidth(0U),
+    m_frameHeight(0U),
+    m_frameCnt(0U),
+    m_hasLoopCount(false),
+    m_loopCnt(0U),
+    m_loop(0U),
+    m_isFinished(false),
+    m_blockLen(0U),
+    m_blockIdx(0U),
+    m_isDataEnd(false),
+    m_bitBuffer(0U),
+    m_bitCnt(0U)
+{
+    if ((true == decoder.isOpen()) &&
+        (nullptr != decoder.m_fs))
+    {
+        (void)open(*decoder.m_fs, decoder.m_fileName);
+    }
+}
+
+GifDecoder::~GifDecoder()
+{
+    close();
+}
+
+GifDecoder& GifDecoder::operator=(const GifDecoder& decoder)
+{
+    if (&decoder != this)
+    {
+        close();
+
+        if ((true == decoder.isOpen()) &&
+            (nullptr != decoder.m_fs))
+        {
+            (void)open(*decoder.m_fs, decoder.m_fileName);
+        }
+    }
+
+    return *this;
+}
+
+GifDecoder::Ret GifDecoder::open(FS& fs, const String& fileName)
+{
+    Ret ret = RET_OK;
+
+    close();
+
+    m_fd = fs.open(fileName);
+
+    if (false == m_fd)
+    {
+        ret = RET_FILE_NOT_FOUND;
+    }
+    else
+    {
+        uint8_t     signature[GIF_SIGNATURE_SIZE];
+        uint16_t    width       = 0U;
+        uint16_t    height      = 0U;
+        uint8_t     screen[3U]; /* Flags, background color index, pixel aspect ratio */
+
+        if ((false == readBytes(signature, sizeof(signature))) ||
+            (false == readUInt16(width)) ||
+            (false == readUInt16(height)) ||
+            (false == readBytes(screen, sizeof(screen))))
+        {
+            ret = RET_FILE_FORMAT_INVALID;
+        }
+        else if ((0 != memcmp(signature, GIF_SIGNATURE_87A, GIF_SIGNATURE_SIZE)) &&
+                 (0 != memcmp(signature, GIF_SIGNATURE_89A, GIF_SIGNATURE_SIZE)))
+        {
+            ret = RET_FILE_FORMAT_UNSUPPORTED;
+        }
+        else if ((0U == width) ||
+                 (0U == height))
+        {
+            ret = RET_FILE_FORMAT_INVALID;
+        }
+        else
+        {
+            m_work = new(std::nothrow) WorkMem;
+
+            if ((nullptr == m_work) ||
+                (false == m_canvas.create(width, height)))
+            {
+                ret = RET_IMG_TOO_BIG;
+            }
+            else if (0U != (screen[0] & FLAG_COLOR_TABLE))
+            {
+                m_globalColorCnt = 1U << ((screen[0] & MASK_COLOR_TABLE_SIZE) + 1U);
+
+                if (false == readColorTable(m_work->globalColors, m_globalColorCnt))
+                {
+                    ret = RET_FILE_FORMAT_INVALID;
+                }
+            }
+            else
+            {
+                /* Nothing to do. */
+                ;
+            }
+
+            if (RET_OK == ret)
+            {
+                m_fs            = &fs;
+                m_fileName      = fileName;
+                m_firstFramePos = m_fd.position();
+
+                /* The canvas has no alpha channel, therefore the background
+                 * is always black and the background color index is ignored.
+                 */
+                m_canvas.fillScreen(ColorDef::BLACK);
+
+                ret = next();
+            }
+        }
+    }
+
+    if (RET_OK != ret)
+    {
+        close();
+    }
+
+    return ret;
+}
+
+void GifDecoder::close()
+{
+    if (true == m_fd)
+    {
+        m_fd.close();
+    }
+
+    if (nullptr != m_work)
+    {
+        delete m_work;
+        m_work = nullptr;
+    }
+
+    m_canvas.release();
+    m_backup.release();
+
+    m_fs                = nullptr;
+    m_fileName          = "";
+    m_globalColorCnt    = 0U;
+    m_firstFramePos     = 0U;
+    m_delay             = DEFAULT_DELAY;
+    m_disposal          = DISPOSAL_NONE;
+    m_frameX            = 0;
+    m_frameY            = 0;
+    m_frameWidth        = 0U;
+    m_frameHeight       = 0U;
+    m_frameCnt          = 0U;
+    m_hasLoopCount      = false;
+    m_loopCnt           = 0U;
+    m_loop              = 0U;
+    m_isFinished        = false;
+
+    return;
+}
+
+GifDecoder::Ret GifDecoder::next()
+{
+    Ret             ret             = RET_OK;
+    bool            isFrameDecoded  = false;
+    GraphicControl  gce             = { DISPOSAL_NONE, false, 0U, 0U };
+
+    if (false == isOpen())
+    {
+        ret = RET_FILE_NOT_FOUND;
+    }
+
+    while((RET_OK == ret) &&
+          (false == isFrameDecoded) &&
+          (false == m_isFinished))
+    {
+        uint8_t blockType = 0U;
+
+        if (false == readBytes(&blockType, sizeof(blockType)))
+        {
+            ret = RET_FILE_FORMAT_INVALID;
+        }
+        else if (EXTENSION_INTRODUCER == blockType)
+        {
+            if (false == readExtension(gce))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+        }
+        else if (IMAGE_SEPARATOR == blockType)
+        {
+            ret = decodeFrame(gce);
+
+            isFrameDecoded = true;
+        }
+        else if (TRAILER == blockType)
+        {
+            /* A image without any frame is invalid. */
+            if (0U == m_frameCnt)
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+            /* Without animation loop extension the image is shown once and
+             * a loop count of 0 means infinite.
+             */
+            else if ((false == m_hasLoopCount) ||
+                     ((0U < m_loopCnt) && (m_loopCnt <= m_loop)))
+            {
+                /* Keep the last frame. */
+                m_isFinished = true;
+            }
+            else if (false == m_fd.seek(m_firstFramePos))
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+            else
+            {
+                ++m_loop;
+            }
+        }
+        else
+        {
+            ret = RET_FILE_FORMAT_INVALID;
+        }
+    }
+
+    return ret;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool GifDecoder::readBytes(uint8_t* buffer, size_t size)
+{
+    return (size == m_fd.read(buffer, size));
+}
+
+bool GifDecoder::readUInt16(uint16_t& value)
+{
+    bool    isSuccessful    = false;
+    uint8_t buffer[2U];
+
+    /* All multi-byte values are stored in little endian order. */
+    if (true == readBytes(buffer, sizeof(buffer)))
+    {
+        value = static_cast<uint16_t>(buffer[0]) | (static_cast<uint16_t>(buffer[1]) << 8U);
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool GifDecoder::readColorTable(uint8_t* colors, uint16_t colorCnt)
+{
+    return readBytes(colors, colorCnt * 3U);
+}
+
+bool GifDecoder::readSubBlock(uint8_t& length)
+{
+    bool isSuccessful = readBytes(&length, sizeof(length));
+
+    if ((true == isSuccessful) &&
+        (0U < length))
+    {
+        isSuccessful = readBytes(m_work->block, length);
+    }
+
+    return isSuccessful;
+}
+
+bool GifDecoder::skipSubBlocks()
+{
+    bool    isSuccessful    = true;
+    uint8_t length          = 0U;
+
+    do
+    {
+        isSuccessful = readSubBlock(length);
+    }
+    while((true == isSuccessful) && (0U < length));
+
+    return isSuccessful;
+}
+
+bool GifDecoder::readExtension(GraphicControl& gce)
+{
+    uint8_t label           = 0U;
+    uint8_t length          = 0U;
+    bool    isSuccessful    = readBytes(&label, sizeof(label));
+
+    if (true == isSuccessful)
+    {
+        isSuccessful = readSubBlock(length);
+    }
+
+    if ((true == isSuccessful) &&
+        (0U < length))
+    {
+        if (LABEL_GRAPHIC_CONTROL == label)
+        {
+            if (4U > length)
+            {
+                isSuccessful = false;
+            }
+            else
+            {
+                const uint8_t* block = m_work->block;
+
+                gce.disposal        = (block[0] >> DISPOSAL_SHIFT) & DISPOSAL_MASK;
+                gce.isTransparent   = (0U != (block[0] & FLAG_TRANSPARENT));
+                gce.delay           = static_cast<uint16_t>(block[1]) | (static_cast<uint16_t>(block[2]) << 8U);
+                gce.transparentIdx  = block[3];
+
+                isSuccessful = skipSubBlocks();
+            }
+        }
+        else if ((LABEL_APPLICATION == label) &&
+                 (APP_ID_SIZE == length) &&
+                 (0 == memcmp(m_work->block, APP_ID_NETSCAPE, APP_ID_SIZE)))
+        {
+            do
+            {
+                isSuccessful = readSubBlock(length);
+
+                if ((true == isSuccessful) &&
+                    (3U <= length) &&
+                    (NETSCAPE_LOOP_COUNT_ID == m_work->block[0]))
+                {
+                    m_hasLoopCount  = true;
+                    m_loopCnt       = static_cast<uint16_t>(m_work->block[1]) | (static_cast<uint16_t>(m_work->block[2]) << 8U);
+                }
+            }
+            while((true == isSuccessful) && (0U < length));
+        }
+        else
+        {
+            /* Comment, plain text and unknown extensions are skipped. */
+            isSuccessful = skipSubBlocks();
+        }
+    }
+
+    return isSuccessful;
+}
+
+GifDecoder::Ret GifDecoder::decodeFrame(const GraphicControl& gce)
+{
+    Ret             ret         = RET_OK;
+    uint16_t        left        = 0U;
+    uint16_t        top         = 0U;
+    uint16_t        width       = 0U;
+    uint16_t        height      = 0U;
+    uint8_t         flags       = 0U;
+    uint8_t         minCodeSize = 0U;
+    const uint8_t*  colors      = nullptr;
+    uint16_t        colorCnt    = 0U;
+
+    if ((false == readUInt16(left)) ||
+        (false == readUInt16(top)) ||
+        (false == readUInt16(width)) ||
+        (false == readUInt16(height)) ||
+        (false == readBytes(&flags, sizeof(flags))))
+    {
+        ret = RET_FILE_FORMAT_INVALID;
+    }
+    else if (0U != (flags & FLAG_COLOR_TABLE))
+    {
+        colors      = m_work->localColors;
+        colorCnt    = 1U << ((flags & MASK_COLOR_TABLE_SIZE) + 1U);
+
+        if (false == readColorTable(m_work->localColors, colorCnt))
+        {
+            ret = RET_FILE_FORMAT_INVALID;
+        }
+    }
+    else if (0U < m_globalColorCnt)
+    {
+        colors      = m_work->globalColors;
+        colorCnt    = m_globalColorCnt;
+    }
+    /* Neither a local nor a global color table. */
+    else
+    {
+        ret = RET_FILE_FORMAT_INVALID;
+    }
+
+    if (RET_OK == ret)
+    {
+        if ((false == readBytes(&minCodeSize, sizeof(minCodeSize))) ||
+            (LZW_MIN_CODE_SIZE > minCodeSize) ||
+            (LZW_MAX_MIN_CODE_SIZE < minCodeSize))
+        {
+            ret = RET_FILE_FORMAT_INVALID;
+        }
+    }
+
+    if (RET_OK == ret)
+    {
+        /* The previous frame is disposed right before the next one is drawn.
+         * This keeps the last frame untouched, if the animation finishes.
+         */
+        disposeFrame();
+
+        m_frameX        = static_cast<int16_t>(left);
+        m_frameY        = static_cast<int16_t>(top);
+        m_frameWidth    = width;
+        m_frameHeight   = height;
+        m_disposal      = gce.disposal;
+        m_delay         = gce.delay * 10U;
+
+        /* Browsers show frames with no or a very short delay with a
+         * default delay. Do the same to get a similar animation speed.
+         */
+        if (MIN_DELAY > m_delay)
+        {
+            m_delay = DEFAULT_DELAY;
+        }
+
+        /* Save the canvas area, which will be overwritten, to be able to
+         * restore it before the next frame is drawn.
+         */
+        if (DISPOSAL_PREVIOUS == m_disposal)
+        {
+            if ((width != m_backup.getWidth()) ||
+                (height != m_backup.getHeight()))
+            {
+                m_backup.release();
+
+                if (false == m_backup.create(width, height))
+                {
+                    ret = RET_IMG_TOO_BIG;
+                }
+            }
+
+            if (RET_OK == ret)
+            {
+                int16_t y = 0;
+
+                for(y = 0; y < height; ++y)
+                {
+                    int16_t x = 0;
+
+                    for(x = 0; x < width; ++x)
+                    {
+                        m_backup.drawPixel(x, y, m_canvas.getColor(m_frameX + x, m_frameY + y));
+                    }
+                }
+            }
+        }
+    }
+
+    if (RET_OK == ret)
+    {
+        const uint16_t  clearCode       = 1U << minCodeSize;
+        const uint16_t  endCode         = clearCode + 1U;
+        const bool      isInterlaced    = (0U != (flags & FLAG_INTERLACED));
+        uint8_t         codeSize        = minCodeSize + 1U;
+        uint16_t        nextCode        = endCode + 1U;
+        uint16_t        prevCode        = LZW_MAX_CODES; /* No previous code */
+        uint8_t         firstPixel      = 0U;
+        bool            isEnd           = false;
+        uint16_t        x               = 0U;
+        uint16_t        y               = 0U;
+        uint8_t         pass            = 0U;
+
+        m_blockLen  = 0U;
+        m_blockIdx  = 0U;
+        m_isDataEnd = false;
+        m_bitBuffer = 0U;
+        m_bitCnt    = 0U;
+
+        while((RET_OK == ret) && (false == isEnd))
+        {
+            uint16_t    code        = 0U;
+            uint16_t    stackIdx    = 0U;
+
+            if (false == readCode(codeSize, code))
+            {
+                /* Some encoders omit the end of information code. */
+                if (true == m_isDataEnd)
+                {
+                    isEnd = true;
+                }
+                else
+                {
+                    ret = RET_FILE_FORMAT_INVALID;
+                }
+            }
+            else if (clearCode == code)
+            {
+                codeSize    = minCodeSize + 1U;
+                nextCode    = endCode + 1U;
+                prevCode    = LZW_MAX_CODES;
+            }
+            else if (endCode == code)
+            {
+                isEnd = true;
+            }
+            /* First code after a clear code? */
+            else if (LZW_MAX_CODES == prevCode)
+            {
+                if (clearCode < code)
+                {
+                    ret = RET_FILE_FORMAT_INVALID;
+                }
+                else
+                {
+                    m_work->stack[stackIdx] = static_cast<uint8_t>(code);
+                    ++stackIdx;
+
+                    firstPixel  = static_cast<uint8_t>(code);
+                    prevCode    = code;
+                }
+            }
+            else if (nextCode < code)
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+            else
+            {
+                uint16_t current = code;
+
+                /* The code is not in the table yet, which is the case for
+                 * a sequence like KwKwK. Its string is the previous one,
+                 * followed by the first pixel of the previous one.
+                 */
+                if (nextCode == code)
+                {
+                    m_work->stack[stackIdx] = firstPixel;
+                    ++stackIdx;
+
+                    current = prevCode;
+                }
+
+                /* Unwind the string of the code in reverse order. */
+                while((endCode < current) && ((LZW_MAX_CODES - 1U) > stackIdx))
+                {
+                    m_work->stack[stackIdx] = m_work->suffix[current];
+                    ++stackIdx;
+
+                    current = m_work->prefix[current];
+                }
+
+                firstPixel = static_cast<uint8_t>(current);
+                m_work->stack[stackIdx] = firstPixel;
+                ++stackIdx;
+
+                /* The table stays as it is, if its full. The encoder has to
+                 * send a clear code to reset it.
+                 */
+                if (LZW_MAX_CODES > nextCode)
+                {
+                    m_work->prefix[nextCode] = prevCode;
+                    m_work->suffix[nextCode] = firstPixel;
+                    ++nextCode;
+
+                    if ((nextCode == (1U << codeSize)) &&
+                        (LZW_MAX_CODE_SIZE > codeSize))
+                    {
+                        ++codeSize;
+                    }
+                }
+
+                prevCode = code;
+            }
+
+            /* Draw the pixels of the decoded string. Pixels outside the
+             * frame are ignored.
+             */
+            while((0U < stackIdx) && (height > y))
+            {
+                uint8_t colorIdx = 0U;
+
+                --stackIdx;
+                colorIdx = m_work->stack[stackIdx];
+
+                if (((false == gce.isTransparent) || (gce.transparentIdx != colorIdx)) &&
+                    (colorCnt > colorIdx))
+                {
+                    const uint8_t* rgb = &colors[colorIdx * 3U];
+
+                    m_canvas.drawPixel(m_frameX + x, m_frameY + y, Color(rgb[0], rgb[1], rgb[2]));
+                }
+
+                ++x;
+                if (width <= x)
+                {
+                    x = 0U;
+
+                    if (false == isInterlaced)
+                    {
+                        ++y;
+                    }
+                    else
+                    {
+                        y += INTERLACE_STEP[pass];
+
+                        while((height <= y) && ((INTERLACE_PASSES - 1U) > pass))
+                        {
+                            ++pass;
+                            y = INTERLACE_START[pass];
+                        }
+                    }
+                }
+            }
+        }
+
+        if ((RET_OK == ret) &&
+            (false == m_isDataEnd))
+        {
+            if (false == skipSubBlocks())
+            {
+                ret = RET_FILE_FORMAT_INVALID;
+            }
+        }
+
+        ++m_frameCnt;
+    }
+
+    return ret;
+}
+
+bool GifDecoder::readCode(uint8_t codeSize, uint16_t& code)
+{
+    bool isSuccessful = true;
+
+    /* The codes are packed LSB first into the data sub-blocks. */
+    while((true == isSuccessful) && (codeSize > m_bitCnt))
+    {
+        if (m_blockLen <= m_blockIdx)
+        {
+            if (true == m_isDataEnd)
+            {
+                isSuccessful = false;
+            }
+            else if (false == readSubBlock(m_blockLen))
+            {
+                isSuccessful = false;
+            }
+            else if (0U == m_blockLen)
+            {
+                m_isDataEnd     = true;
+                isSuccessful    = false;
+            }
+            else
+            {
+                m_blockIdx = 0U;
+            }
+        }
+
+        if (true == isSuccessful)
+        {
+            m_bitBuffer |= static_cast<uint32_t>(m_work->block[m_blockIdx]) << m_bitCnt;
+            m_bitCnt    += 8U;
+            ++m_blockIdx;
+        }
+    }
+
+    if (true == isSuccessful)
+    {
+        code        = static_cast<uint16_t>(m_bitBuffer & ((1U << codeSize) - 1U));
+        m_bitBuffer >>= codeSize;
+        m_bitCnt    -= codeSize;
+    }
+
+    return isSuccessful;
+}
+
+void GifDecoder::disposeFrame()
+{
+    switch(m_disposal)
+    {
+    case DISPOSAL_BACKGROUND:
+        m_canvas.fillRect(m_frameX, m_frameY, m_frameWidth, m_frameHeight, ColorDef::BLACK);
+        break;
+
+    case DISPOSAL_PREVIOUS:
+        if (true == m_backup.isAllocated())
+        {
+            m_canvas.drawBitmap(m_frameX, m_frameY, m_backup);
+        }
+        break;
+
+    default:
+        /* Nothing to do. */
+        break;
+    }
+
+    m_disposal = DISPOSAL_NONE;
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
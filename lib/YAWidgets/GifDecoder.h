@@ -0,0 +1,345 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming GIF image decoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __GIF_DECODER_H__
+#define __GIF_DECODER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <YAGfxBitmap.h>
+#include <FS.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Streaming GIF image decoder, which decodes one frame after another from
+ * the filesystem into a canvas. Only the canvas and the LZW tables are kept
+ * in memory, therefore the number of frames is not limited.
+ *
+ * Supported are:
+ * - GIF87a and GIF89a
+ * - Global and local color tables
+ * - Interlaced frames
+ * - Transparency and frame disposal (graphic control extension)
+ * - Loop count (NETSCAPE2.0 application extension)
+ *
+ * The canvas has no alpha channel, therefore the background is black.
+ */
+class GifDecoder
+{
+public:
+
+    /**
+     * Constructs a GIF decoder, which has no file opened.
+     */
+    GifDecoder();
+
+    /**
+     * Constructs a GIF decoder by copying another one.
+     * If the other decoder has a file opened, the same file will be opened
+     * and decoded up to the first frame.
+     *
+     * @param[in] decoder   GIF decoder, which to copy
+     */
+    GifDecoder(const GifDecoder& decoder);
+
+    /**
+     * Destroys the GIF decoder and closes the file.
+     */
+    ~GifDecoder();
+
+    /**
+     * Assigns a GIF decoder.
+     * If the other decoder has a file opened, the same file will be opened
+     * and decoded up to the first frame.
+     *
+     * @param[in] decoder   GIF decoder, which to assign
+     *
+     * @return GIF decoder
+     */
+    GifDecoder& operator=(const GifDecoder& decoder);
+
+    /**
+     * Possible return values with more information.
+     */
+    enum Ret
+    {
+        RET_OK = 0,                     /**< Successful */
+        RET_FILE_NOT_FOUND,             /**< File not found. */
+        RET_FILE_FORMAT_INVALID,        /**< Invalid file format. */
+        RET_FILE_FORMAT_UNSUPPORTED,    /**< File format is not supported. */
+        RET_IMG_TOO_BIG                 /**< Image size is too big. */
+    };
+
+    /** Max. number of LZW codes, limited by the max. code size of 12 bit. */
+    static const uint16_t   LZW_MAX_CODES   = 4096U;
+
+    /** Max. number of colors in a color table. */
+    static const uint16_t   MAX_COLORS      = 256U;
+
+    /** Delay in ms used for frames, which have no or a too short delay. */
+    static const uint32_t   DEFAULT_DELAY   = 100U;
+
+    /** Min. delay in ms. Shorter delays are replaced by the default delay. */
+    static const uint32_t   MIN_DELAY       = 20U;
+
+    /**
+     * Open a GIF image (.gif) from the filesystem and decode the first frame.
+     * The file stays open until the decoder is closed.
+     *
+     * @param[in] fs        Filesystem
+     * @param[in] fileName  Name of the file
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret open(FS& fs, const String& fileName);
+
+    /**
+     * Close the file and release all working memory.
+     */
+    void close();
+
+    /**
+     * Is a GIF image opened?
+     *
+     * @return If opened, it will return true otherwise false.
+     */
+    bool isOpen() const
+    {
+        return m_canvas.isAllocated();
+    }
+
+    /**
+     * Decode the next frame into the canvas. After the last frame the
+     * animation starts again with the first one, as long as the loop count
+     * is not exhausted. If it is, the last frame stays.
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret next();
+
+    /**
+     * Get the canvas with the current frame.
+     *
+     * @return Canvas
+     */
+    const YAGfxBitmap& getFrame() const
+    {
+        return m_canvas;
+    }
+
+    /**
+     * Get the delay of the current frame in ms.
+     *
+     * @return Delay in ms
+     */
+    uint32_t getDelay() const
+    {
+        return m_delay;
+    }
+
+    /**
+     * Is the animation finished, because the loop count is exhausted?
+     * An image without animation loop extension is played once.
+     *
+     * @return If finished, it will return true otherwise false.
+     */
+    bool isFinished() const
+    {
+        return m_isFinished;
+    }
+
+private:
+
+    /**
+     * Working memory, which is allocated as long as an image is open.
+     */
+    struct WorkMem
+    {
+        uint16_t    prefix[LZW_MAX_CODES];          /**< Prefix code of every LZW code. */
+        uint8_t     suffix[LZW_MAX_CODES];          /**< Last pixel of every LZW code. */
+        uint8_t     stack[LZW_MAX_CODES];           /**< Pixels of a LZW code in reverse order. */
+        uint8_t     globalColors[MAX_COLORS * 3U];  /**< Global color table (RGB). */
+        uint8_t     localColors[MAX_COLORS * 3U];   /**< Local color table (RGB). */
+        uint8_t     block[UINT8_MAX];               /**< Current data sub-block. */
+    };
+
+    /**
+     * Graphic control extension, which controls the next frame.
+     */
+    struct GraphicControl
+    {
+        uint8_t     disposal;       /**< Disposal method */
+        bool        isTransparent;  /**< Has the frame a transparent color? */
+        uint8_t     transparentIdx; /**< Color index of the transparent color. */
+        uint16_t    delay;          /**< Delay in 1/100 s */
+    };
+
+    /**
+     * Frame disposal methods of the graphic control extension.
+     */
+    enum Disposal
+    {
+        DISPOSAL_NONE = 0,          /**< Not specified. */
+        DISPOSAL_KEEP,              /**< Leave the frame in place. */
+        DISPOSAL_BACKGROUND,        /**< Restore to background. */
+        DISPOSAL_PREVIOUS           /**< Restore to previous. */
+    };
+
+    FS*                 m_fs;               /**< Filesystem of the opened file. */
+    String              m_fileName;         /**< Name of the opened file. */
+    File                m_fd;               /**< File descriptor. */
+    WorkMem*            m_work;             /**< Working memory. */
+    YAGfxDynamicBitmap  m_canvas;           /**< Canvas with the current frame. */
+    YAGfxDynamicBitmap  m_backup;           /**< Canvas area, which the current frame overwrites. Used for disposal "restore to previous". */
+    uint16_t            m_globalColorCnt;   /**< Number of global colors. 0 if there is no global color table. */
+    uint32_t            m_firstFramePos;    /**< File position after the global color table. */
+    uint32_t            m_delay;            /**< Delay of the current frame in ms. */
+    uint8_t             m_disposal;         /**< Disposal method of the current frame. */
+    int16_t             m_frameX;           /**< x-coordinate of the current frame. */
+    int16_t             m_frameY;           /**< y-coordinate of the current frame. */
+    uint16_t            m_frameWidth;       /**< Width of the current frame. */
+    uint16_t            m_frameHeight;      /**< Height of the current frame. */
+    uint32_t            m_frameCnt;         /**< Number of decoded frames since the image was opened. */
+    bool                m_hasLoopCount;     /**< Has the image an animation loop extension? */
+    uint16_t            m_loopCnt;          /**< Number of repetitions. 0 means infinite. */
+    uint16_t            m_loop;             /**< Current repetition. */
+    bool                m_isFinished;       /**< Is the animation finished? */
+    uint8_t             m_blockLen;         /**< Length of the current data sub-block. */
+    uint8_t             m_blockIdx;         /**< Index of the next byte in the current data sub-block. */
+    bool                m_isDataEnd;        /**< Is the end of the image data (block terminator) reached? */
+    uint32_t            m_bitBuffer;        /**< Bit buffer for reading LZW codes. */
+    uint8_t             m_bitCnt;           /**< Number of bits in the bit buffer. */
+
+    /**
+     * Read bytes from the file.
+     *
+     * @param[out] buffer   Buffer
+     * @param[in] size      Number of bytes to read
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readBytes(uint8_t* buffer, size_t size);
+
+    /**
+     * Read a 16 bit little endian value from the file.
+     *
+     * @param[out] value    Value
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readUInt16(uint16_t& value);
+
+    /**
+     * Read a color table from the file.
+     *
+     * @param[out] colors   Color table (RGB)
+     * @param[in] colorCnt  Number of colors
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readColorTable(uint8_t* colors, uint16_t colorCnt);
+
+    /**
+     * Read a data sub-block into the block buffer.
+     *
+     * @param[out] length   Length of the sub-block. 0 for the block terminator.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readSubBlock(uint8_t& length);
+
+    /**
+     * Skip data sub-blocks up to and including the block terminator.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool skipSubBlocks();
+
+    /**
+     * Read a extension block. The extension introducer is already read.
+     *
+     * @param[out] gce      Graphic control extension of the next frame
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readExtension(GraphicControl& gce);
+
+    /**
+     * Read the image descriptor and decode the image data into the canvas.
+     * The image separator is already read.
+     *
+     * @param[in] gce   Graphic control extension of this frame
+     *
+     * @return If successful, it will return RET_OK. See Ret type for more informations.
+     */
+    Ret decodeFrame(const GraphicControl& gce);
+
+    /**
+     * Read the next LZW code from the data sub-blocks.
+     *
+     * @param[in] codeSize  Code size in bit
+     * @param[out] code     LZW code
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool readCode(uint8_t codeSize, uint16_t& code);
+
+    /**
+     * Dispose the current frame, according to its disposal method.
+     */
+    void disposeFrame();
+
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __GIF_DECODER_H__ */
+
+/** @} */
@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
+#include <Util.h>
 #include <Widget.hpp>
 #include <YAColor.h>
 
@@ -139,7 +140,11 @@ public:
      */
     void setOnState(bool state)
     {
-        m_isOn = state;
+        if (m_isOn != state)
+        {
+            m_isOn = state;
+            invalidate();
+        }
 
         return;
     }
@@ -162,6 +167,7 @@ public:
     void setColorOff(const Color& color)
     {
         m_colorOff = color;
+        invalidate();
 
         return;
     }
@@ -184,6 +190,7 @@ public:
     void setColorOn(const Color& color)
     {
         m_colorOn = color;
+        invalidate();
 
         return;
     }
@@ -206,6 +213,7 @@ public:
     void setWidth(uint16_t width)
     {
         m_width = width;
+        invalidate();
 
         return;
     }
@@ -220,6 +228,30 @@ public:
         return m_width;
     }
 
+    /**
+     * The lamp fills its whole area.
+     *
+     * @return Always opaque
+     */
+    bool isOpaque() const override
+    {
+        return true;
+    }
+
+    /**
+     * Get the area in the canvas, which the lamp paints.
+     *
+     * @param[in]   gfx     Graphics interface of the canvas
+     * @param[out]  area    Area in the canvas
+     */
+    void getArea(const YAGfx& gfx, Area& area) const override
+    {
+        UTIL_NOT_USED(gfx);
+
+        area = Area(m_posX, m_posY, m_width, HEIGHT);
+        return;
+    }
+
     /** Widget type string */
     static const char*      WIDGET_TYPE;
 
@@ -138,6 +138,8 @@ public:
             m_progress = progress;
         }
 
+        invalidate();
+
         return;
     }
 
@@ -149,6 +151,7 @@ public:
     void setColor(const Color& color)
     {
         m_color = color;
+        invalidate();
         return;
     }
 
@@ -162,6 +165,7 @@ public:
         if (ALGORITHM_MAX > algorithm)
         {
             m_algorithm = algorithm;
+            invalidate();
         }
 
         return;
@@ -0,0 +1,396 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Sprite animation
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SpriteAnimation.h"
+
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Sprite animation signature. */
+static const char       ANIM_SIGNATURE[]        = "ANIM";
+
+/** Size of the sprite animation signature in byte. */
+static const size_t     ANIM_SIGNATURE_SIZE     = 4U;
+
+/** Supported sprite animation file format version. */
+static const uint8_t    ANIM_VERSION            = 1U;
+
+/** Size of the sprite animation header in byte. */
+static const size_t     ANIM_HEADER_SIZE        = 16U;
+
+/** Flag: Repeat animation infinite */
+static const uint8_t    ANIM_FLAG_REPEAT        = 0x01U;
+
+/** Size of the frame data size in byte. */
+static const size_t     FRAME_SIZE_SIZE         = 2U;
+
+/** A skip byte with this value continues the number of skipped pixels with the next byte. */
+static const uint8_t    SKIP_CONTINUE           = 0xFFU;
+
+/** Flag in the packet header, which marks a run. */
+static const uint8_t    PACKET_RUN              = 0x80U;
+
+/** Mask of the number of pixels - 1 in the packet header. */
+static const uint8_t    PACKET_PIXELS_MASK      = 0x7FU;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+SpriteAnimation& SpriteAnimation::operator=(const SpriteAnimation& animation)
+{
+    if (this != (&animation))
+    {
+        release();
+
+        if (nullptr != animation.m_data)
+        {
+            m_data = new(std::nothrow) uint8_t[animation.m_dataSize];
+
+            if (nullptr != m_data)
+            {
+                memcpy(m_data, animation.m_data, animation.m_dataSize);
+
+                m_dataSize      = animation.m_dataSize;
+                m_canvas        = animation.m_canvas;
+                m_frameCnt      = animation.m_frameCnt;
+                m_currentFrame  = animation.m_currentFrame;
+                m_nextFramePos  = animation.m_nextFramePos;
+            }
+        }
+
+        m_fps       = animation.m_fps;
+        m_repeat    = animation.m_repeat;
+    }
+
+    return *this;
+}
+
+bool SpriteAnimation::load(FS& fs, const String& fileName)
+{
+    bool    isSuccessful    = false;
+    File    fd              = fs.open(fileName);
+
+    release();
+
+    if (true == fd)
+    {
+        uint8_t header[ANIM_HEADER_SIZE];
+
+        if ((sizeof(header) == fd.read(header, sizeof(header))) &&
+            (0 == memcmp(header, ANIM_SIGNATURE, ANIM_SIGNATURE_SIZE)) &&
+            (ANIM_VERSION == header[4]))
+        {
+            uint8_t     flags           = header[5];
+            uint16_t    frameWidth      = static_cast<uint16_t>(header[6]) | (static_cast<uint16_t>(header[7]) << 8U);
+            uint16_t    frameHeight     = static_cast<uint16_t>(header[8]) | (static_cast<uint16_t>(header[9]) << 8U);
+            uint16_t    frameCnt        = static_cast<uint16_t>(header[10]) | (static_cast<uint16_t>(header[11]) << 8U);
+            uint8_t     fps             = header[12];
+            uint16_t    paletteSize     = static_cast<uint16_t>(header[13]) + 1U;
+            size_t      fileSize        = fd.size();
+            size_t      framesPos       = ANIM_HEADER_SIZE + paletteSize * 3U;
+
+            if ((0U < frameCnt) &&
+                (0U < fps) &&
+                (framesPos < fileSize) &&
+                (true == m_canvas.create(frameWidth, frameHeight, YAGfxPaletteBitmap::getBppByColors(paletteSize))))
+            {
+                uint16_t    idx     = 0U;
+                bool        isValid = true;
+
+                for(idx = 0U; (idx < paletteSize) && (true == isValid); ++idx)
+                {
+                    uint8_t rgb[3U];
+
+                    if (sizeof(rgb) != fd.read(rgb, sizeof(rgb)))
+                    {
+                        isValid = false;
+                    }
+                    else
+                    {
+                        m_canvas.setPaletteColor(static_cast<uint8_t>(idx), Color(rgb[0], rgb[1], rgb[2]));
+                    }
+                }
+
+                /* Only the frames are kept in memory. */
+                if (true == isValid)
+                {
+                    m_dataSize  = fileSize - framesPos;
+                    m_data      = new(std::nothrow) uint8_t[m_dataSize];
+
+                    if ((nullptr == m_data) ||
+                        (m_dataSize != fd.read(m_data, m_dataSize)))
+                    {
+                        isValid = false;
+                    }
+                }
+
+                /* Play all frames once to validate them. Afterwards
+                 * playing can not fail anymore.
+                 */
+                if (true == isValid)
+                {
+                    size_t pos = 0U;
+
+                    m_frameCnt = frameCnt;
+
+                    for(idx = 0U; (idx < frameCnt) && (true == isValid); ++idx)
+                    {
+                        pos = applyFrame(pos);
+
+                        if (0U == pos)
+                        {
+                            isValid = false;
+                        }
+                    }
+
+                    if ((true == isValid) &&
+                        (m_dataSize == pos))
+                    {
+                        m_fps       = fps;
+                        m_repeat    = (0U != (flags & ANIM_FLAG_REPEAT));
+
+                        reset();
+
+                        isSuccessful = true;
+                    }
+                }
+            }
+        }
+
+        fd.close();
+    }
+
+    if (false == isSuccessful)
+    {
+        release();
+    }
+
+    return isSuccessful;
+}
+
+void SpriteAnimation::next()
+{
+    if (false == isEmpty())
+    {
+        if (m_frameCnt > (m_currentFrame + 1U))
+        {
+            m_nextFramePos = applyFrame(m_nextFramePos);
+            ++m_currentFrame;
+        }
+        /* The first frame is relative to a cleared canvas. */
+        else if ((true == m_repeat) &&
+                 (1U < m_frameCnt))
+        {
+            reset();
+        }
+        else
+        {
+            /* Keep the last frame. */
+            ;
+        }
+    }
+}
+
+void SpriteAnimation::reset()
+{
+    if (false == isEmpty())
+    {
+        clearCanvas();
+
+        m_nextFramePos  = applyFrame(0U);
+        m_currentFrame  = 0U;
+    }
+}
+
+void SpriteAnimation::release()
+{
+    if (nullptr != m_data)
+    {
+        delete[] m_data;
+        m_data = nullptr;
+    }
+
+    m_canvas.release();
+
+    m_dataSize      = 0U;
+    m_frameCnt      = 0U;
+    m_currentFrame  = 0U;
+    m_nextFramePos  = 0U;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void SpriteAnimation::clearCanvas()
+{
+    int16_t y = 0;
+
+    for(y = 0; y < m_canvas.getHeight(); ++y)
+    {
+        int16_t x = 0;
+
+        for(x = 0; x < m_canvas.getWidth(); ++x)
+        {
+            m_canvas.setIndex(x, y, 0U);
+        }
+    }
+}
+
+size_t SpriteAnimation::applyFrame(size_t pos)
+{
+    size_t nextPos = 0U;
+
+    if ((pos + FRAME_SIZE_SIZE) <= m_dataSize)
+    {
+        size_t  frameSize   = static_cast<size_t>(m_data[pos]) | (static_cast<size_t>(m_data[pos + 1U]) << 8U);
+        size_t  idx         = pos + FRAME_SIZE_SIZE;
+        size_t  end         = idx + frameSize;
+
+        if (end <= m_dataSize)
+        {
+            const uint16_t  WIDTH       = m_canvas.getWidth();
+            const uint32_t  PIXEL_CNT   = static_cast<uint32_t>(WIDTH) * m_canvas.getHeight();
+            const uint16_t  COLORS      = m_canvas.getPaletteSize();
+            uint32_t        pixel       = 0U;
+            bool            isValid     = true;
+
+            while((true == isValid) && (end > idx))
+            {
+                uint8_t skip = 0U;
+
+                /* Skip unchanged pixels. */
+                do
+                {
+                    skip = m_data[idx];
+                    ++idx;
+
+                    pixel += skip;
+                }
+                while((SKIP_CONTINUE == skip) && (end > idx));
+
+                if (end <= idx)
+                {
+                    isValid = false;
+                }
+                else
+                {
+                    uint8_t     packetHeader    = m_data[idx];
+                    uint8_t     pixelCnt        = (packetHeader & PACKET_PIXELS_MASK) + 1U;
+                    bool        isRun           = (0U != (packetHeader & PACKET_RUN));
+                    size_t      payloadSize     = (true == isRun) ? 1U : pixelCnt;
+
+                    ++idx;
+
+                    if ((PIXEL_CNT < (pixel + pixelCnt)) ||
+                        (end < (idx + payloadSize)))
+                    {
+                        isValid = false;
+                    }
+                    else
+                    {
+                        int16_t x       = static_cast<int16_t>(pixel % WIDTH);
+                        int16_t y       = static_cast<int16_t>(pixel / WIDTH);
+                        uint8_t cnt     = 0U;
+
+                        /* Only the changed pixels are touched. */
+                        for(cnt = 0U; (cnt < pixelCnt) && (true == isValid); ++cnt)
+                        {
+                            uint8_t colorIdx = (true == isRun) ? m_data[idx] : m_data[idx + cnt];
+
+                            if (COLORS <= colorIdx)
+                            {
+                                isValid = false;
+                            }
+                            else
+                            {
+                                m_canvas.setIndex(x, y, colorIdx);
+
+                                ++x;
+                                if (WIDTH <= x)
+                                {
+                                    x = 0;
+                                    ++y;
+                                }
+                            }
+                        }
+
+                        pixel   += pixelCnt;
+                        idx     += payloadSize;
+                    }
+                }
+            }
+
+            if (true == isValid)
+            {
+                nextPos = end;
+            }
+        }
+    }
+
+    return nextPos;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
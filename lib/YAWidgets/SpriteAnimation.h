@@ -0,0 +1,289 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Sprite animation
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup gfx
+ *
+ * @{
+ */
+
+#ifndef __SPRITE_ANIMATION_H__
+#define __SPRITE_ANIMATION_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <YAGfxBitmap.h>
+#include <FS.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The sprite animation plays a precompiled sprite animation file (.anim),
+ * which is created by ./doc/spritesheet/create_sprite_anim.py.
+ *
+ * All frames share one palette and every frame contains only the pixels,
+ * which changed compared to the previous frame, run length encoded.
+ * Only the compressed frames and one palette bitmap are kept in memory
+ * and for every frame only the changed pixels are touched.
+ *
+ * Because every frame depends on the previous one, the animation runs
+ * only forward.
+ */
+class SpriteAnimation
+{
+public:
+
+    /**
+     * Constructs a sprite animation, without frames.
+     */
+    SpriteAnimation() :
+        m_data(nullptr),
+        m_dataSize(0U),
+        m_canvas(),
+        m_frameCnt(0U),
+        m_fps(DEFAULT_FPS),
+        m_repeat(true),
+        m_currentFrame(0U),
+        m_nextFramePos(0U)
+    {
+    }
+
+    /**
+     * Constructs a sprite animation by copy.
+     * 
+     * @param[in] animation The sprite animation, which to copy from.
+     */
+    SpriteAnimation(const SpriteAnimation& animation) :
+        m_data(nullptr),
+        m_dataSize(0U),
+        m_canvas(),
+        m_frameCnt(0U),
+        m_fps(DEFAULT_FPS),
+        m_repeat(true),
+        m_currentFrame(0U),
+        m_nextFramePos(0U)
+    {
+        *this = animation;
+    }
+
+    /**
+     * Destroys the sprite animation.
+     */
+    ~SpriteAnimation()
+    {
+        release();
+    }
+
+    /**
+     * Assigns a sprite animation.
+     * 
+     * @param[in] animation The sprite animation, which to copy from.
+     * 
+     * @return The sprite animation itself.
+     */
+    SpriteAnimation& operator=(const SpriteAnimation& animation);
+
+    /**
+     * Get animation speed.
+     * 
+     * @return Frame per second
+     */
+    uint8_t getFPS() const
+    {
+        return m_fps;
+    }
+
+    /**
+     * Set animation speed.
+     * 
+     * @param[in] fps   Frames per second
+     */
+    void setFPS(uint8_t fps)
+    {
+        m_fps = fps;
+    }
+
+    /**
+     * Does the animation runs infinite or just once?
+     * 
+     * @return If the animation is continuously repeated, it will return true otherwise false.
+     */
+    bool isRepeatedInfinite() const
+    {
+        return m_repeat;
+    }
+
+    /**
+     * Set whether the animation is repeated continuously or it runs just once.
+     * 
+     * @param[in] repeat    If set to true, the animation will run infinite.
+     */
+    void repeatInfinite(bool repeat)
+    {
+        m_repeat = repeat;
+    }
+
+    /**
+     * Get frame width in pixels.
+     * 
+     * @return Frame width in pixels
+     */
+    uint16_t getFrameWidth() const
+    {
+        return m_canvas.getWidth();
+    }
+
+    /**
+     * Get frame height in pixels.
+     * 
+     * @return Frame height in pixels
+     */
+    uint16_t getFrameHeight() const
+    {
+        return m_canvas.getHeight();
+    }
+
+    /**
+     * Get number of frames.
+     * 
+     * @return Number of frames
+     */
+    uint16_t getFrameCount() const
+    {
+        return m_frameCnt;
+    }
+
+    /**
+     * Get the index of the current frame.
+     * 
+     * @return Frame index
+     */
+    uint16_t getCurrentFrame() const
+    {
+        return m_currentFrame;
+    }
+
+    /**
+     * Get the current frame.
+     * 
+     * @return Current frame
+     */
+    const YAGfxBitmap& getFrame() const
+    {
+        return m_canvas;
+    }
+
+    /**
+     * Load sprite animation file (.anim) from the filesystem.
+     * All frames are validated, so playing them can not fail.
+     * 
+     * @param[in] fs        The filesystem
+     * @param[in] fileName  Name of the sprite animation file in the filesystem
+     *
+     * @return If successful loaded, it will return true otherwise false.
+     */
+    bool load(FS& fs, const String& fileName);
+
+    /**
+     * Move to the next frame.
+     * After the last frame, the animation starts again with the first one,
+     * but only if the animation repeats infinite.
+     */
+    void next();
+
+    /**
+     * Reset animation sequence to the first frame.
+     */
+    void reset();
+
+    /**
+     * Release the frames.
+     */
+    void release();
+
+    /**
+     * Use this function to determine whether a sprite animation is loaded or not.
+     * 
+     * @return If no sprite animation is loaded, it will return true otherwise false.
+     */
+    bool isEmpty() const
+    {
+        return (nullptr == m_data);
+    }
+
+private:
+
+    /**
+     * Default frames per seconds (FPS).
+     */
+    static const uint8_t    DEFAULT_FPS = 12U;
+
+    uint8_t*            m_data;         /**< Compressed frames. */
+    size_t              m_dataSize;     /**< Size of the compressed frames in byte. */
+    YAGfxPaletteBitmap  m_canvas;       /**< The current frame. */
+    uint16_t            m_frameCnt;     /**< Number of frames. */
+    uint8_t             m_fps;          /**< Number of frames per second. */
+    bool                m_repeat;       /**< Repeat animation continuously or it runs just once. */
+    uint16_t            m_currentFrame; /**< Index of the current frame. */
+    size_t              m_nextFramePos; /**< Position of the next frame in the compressed frames. */
+
+    /**
+     * Fill the canvas with the first palette color.
+     */
+    void clearCanvas();
+
+    /**
+     * Apply the changed pixels of a frame to the canvas.
+     * 
+     * @param[in] pos   Position of the frame in the compressed frames
+     * 
+     * @return If the frame is valid, it will return the position of the following frame otherwise 0.
+     */
+    size_t applyFrame(size_t pos);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __SPRITE_ANIMATION_H__ */
+
+/** @} */
@@ -35,7 +35,7 @@
 #include "SpriteSheet.h"
 
 #include <ArduinoJson.h>
-#include <BmpImgLoader.h>
+#include <BitmapCache.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -91,16 +91,17 @@ bool SpriteSheet::loadTexture(FS& fs, const String& fileName, uint16_t frameWidt
     if ((0U < frameWidth) &&
         (0U < frameHeight))
     {
-        BmpImgLoader loader;
-
-        if (BmpImgLoader::RET_OK == loader.load(fs, fileName, m_texture))
+        if (BmpImgLoader::RET_OK == BitmapCache::getInstance().load(fs, fileName, m_texture))
         {
+            /* The texture is shared with others, it is only read via the map. */
+            m_textureMap.setGfx(const_cast<YAGfxBitmap&>(m_texture.get()));
+
             /* The frame size must be lower or equal to the texture size. */
-            if ((m_texture.getWidth() >= frameWidth) &&
-                (m_texture.getHeight() >= frameHeight))
+            if ((m_texture.get().getWidth() >= frameWidth) &&
+                (m_texture.get().getHeight() >= frameHeight))
             {
-                m_framesX   = m_texture.getWidth() / frameWidth;
-                m_framesY   = m_texture.getHeight() / frameHeight;
+                m_framesX   = m_texture.get().getWidth() / frameWidth;
+                m_framesY   = m_texture.get().getHeight() / frameHeight;
 
                 /* A 0 number of frames requests the automatic frame count calculation.
                  * This assumes that there will be no frame gaps in the texture image.
@@ -126,7 +127,7 @@ bool SpriteSheet::loadTexture(FS& fs, const String& fileName, uint16_t frameWidt
             }
             else
             {
-                m_texture.release();
+                release();
             }
         }
     }
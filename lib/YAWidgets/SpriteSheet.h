@@ -48,6 +48,8 @@
 #include <YAGfxBitmap.h>
 #include <FS.h>
 
+#include "BitmapCache.h"
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -65,6 +67,9 @@
  * 
  * The order of the sprites shall follow in x-direction from 0 to N and
  * continue in the next y row and so on.
+ * 
+ * The texture image is borrowed from the bitmap cache and shared with
+ * other sprite sheets.
  */
 class SpriteSheet
 {
@@ -75,7 +80,7 @@ public:
      */
     SpriteSheet() :
         m_texture(),
-        m_textureMap(m_texture),
+        m_textureMap(),
         m_frame(m_textureMap),
         m_frameCnt(0U),
         m_fps(DEFAULT_FPS),
@@ -96,7 +101,7 @@ public:
     SpriteSheet(const SpriteSheet& spriteSheet) :
         m_texture(spriteSheet.m_texture),
         m_textureMap(spriteSheet.m_textureMap),
-        m_frame(spriteSheet.m_frame),
+        m_frame(m_textureMap),
         m_frameCnt(spriteSheet.m_frameCnt),
         m_fps(spriteSheet.m_fps),
         m_repeat(spriteSheet.m_repeat),
@@ -117,8 +122,7 @@ public:
 
     /**
      * Assgins a sprite sheet.
-     * Note, the referenced bitmap image won't be assigned! You have to do this
-     * separately.
+     * Note, the texture image is shared and not copied.
      * 
      * @param[in] spriteSheet   The sprite sheet, which to copy from.
      * 
@@ -263,11 +267,12 @@ public:
     void reset();
 
     /**
-     * Release the internal pixel buffer with texture.
+     * Give the texture back to the bitmap cache.
      */
     void release()
     {
         m_texture.release();
+        m_textureMap = YAGfxMap();
     }
 
     /**
@@ -277,7 +282,7 @@ public:
      */
     bool isEmpty() const
     {
-        return !m_texture.isAllocated();
+        return m_texture.isEmpty();
     }
 
 private:
@@ -287,7 +292,7 @@ private:
      */
     static const uint8_t    DEFAULT_FPS = 12U;
 
-    YAGfxDynamicBitmap  m_texture;          /**< Texture image. */
+    BitmapCache::Ref    m_texture;          /**< Texture image, borrowed from the bitmap cache. */
     YAGfxMap            m_textureMap;       /**< Map canvas over the texture image. */
     YAGfxOverlayBitmap  m_frame;            /**< The current frame. */
     uint8_t             m_frameCnt;         /**< Number of frames in the texture. */
@@ -227,6 +227,8 @@ public:
         m_scrollInfo.offsetDest = 0;
         m_scrollInfo.stopAtDest = false;
         m_scrollInfo.textWidth  = 0U;
+
+        invalidate();
     }
 
     /**
@@ -257,6 +259,7 @@ public:
     void setTextColor(const Color& color)
     {
         m_gfxText.setTextColor(color);
+        invalidate();
         return;
     }
 
@@ -337,6 +340,20 @@ public:
         return status;
     }
 
+    /**
+     * Is the text widget invalid and must be painted again?
+     * It is as long as a new text is pending or the text is scrolling.
+     *
+     * @return If the widget is invalid, it will return true otherwise false.
+     */
+    bool isInvalid() const override
+    {
+        return ((true == Widget::isInvalid()) ||
+                (true == m_isNewTextAvailable) ||
+                (true == m_handleNewText) ||
+                (true == m_scrollInfo.isEnabled));
+    }
+
     /** Default text color */
     static const uint32_t   DEFAULT_TEXT_COLOR      = ColorDef::WHITE;
 
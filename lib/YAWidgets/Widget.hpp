@@ -55,14 +55,174 @@
  * Types and Classes
  *****************************************************************************/
 
+/* Forward declarations */
+class WidgetGroup;
+
 /**
  * Base widget, which contains the position
  * inside a canvas and declares the graphics interface.
+ *
+ * A widget is invalid as long as its shown content doesn't match its state
+ * anymore, e.g. after a new text, bitmap, position or enable state. A widget
+ * group uses it to repaint only what changed.
  */
 class Widget
 {
 public:
 
+    /**
+     * Rectangular area in a canvas.
+     */
+    struct Area
+    {
+        int16_t     x;      /**< Upper left corner (x-coordinate) */
+        int16_t     y;      /**< Upper left corner (y-coordinate) */
+        uint16_t    width;  /**< Width in pixels */
+        uint16_t    height; /**< Height in pixels */
+
+        /**
+         * Constructs an empty area.
+         */
+        Area() :
+            x(0),
+            y(0),
+            width(0U),
+            height(0U)
+        {
+        }
+
+        /**
+         * Constructs an area.
+         *
+         * @param[in] xPos      Upper left corner (x-coordinate)
+         * @param[in] yPos      Upper left corner (y-coordinate)
+         * @param[in] w         Width in pixels
+         * @param[in] h         Height in pixels
+         */
+        Area(int16_t xPos, int16_t yPos, uint16_t w, uint16_t h) :
+            x(xPos),
+            y(yPos),
+            width(w),
+            height(h)
+        {
+        }
+
+        /**
+         * Is the area empty?
+         *
+         * @return If the area contains no pixel, it will return true otherwise false.
+         */
+        bool isEmpty() const
+        {
+            return ((0U == width) || (0U == height));
+        }
+
+        /**
+         * Does the area contain the given pixel?
+         *
+         * @param[in] xPos  x-coordinate
+         * @param[in] yPos  y-coordinate
+         *
+         * @return If the pixel is inside, it will return true otherwise false.
+         */
+        bool contains(int16_t xPos, int16_t yPos) const
+        {
+            return ((x <= xPos) &&
+                    (y <= yPos) &&
+                    ((static_cast<int32_t>(x) + width) > xPos) &&
+                    ((static_cast<int32_t>(y) + height) > yPos));
+        }
+
+        /**
+         * Does the area completely contain the given area?
+         *
+         * @param[in] area  Area
+         *
+         * @return If the given area is inside, it will return true otherwise false.
+         */
+        bool contains(const Area& area) const
+        {
+            return ((false == isEmpty()) &&
+                    (false == area.isEmpty()) &&
+                    (x <= area.x) &&
+                    (y <= area.y) &&
+                    ((static_cast<int32_t>(x) + width) >= (static_cast<int32_t>(area.x) + area.width)) &&
+                    ((static_cast<int32_t>(y) + height) >= (static_cast<int32_t>(area.y) + area.height)));
+        }
+
+        /**
+         * Does the area overlap the given area?
+         *
+         * @param[in] area  Area
+         *
+         * @return If both areas overlap, it will return true otherwise false.
+         */
+        bool intersects(const Area& area) const
+        {
+            return ((false == isEmpty()) &&
+                    (false == area.isEmpty()) &&
+                    (x < (static_cast<int32_t>(area.x) + area.width)) &&
+                    (area.x < (static_cast<int32_t>(x) + width)) &&
+                    (y < (static_cast<int32_t>(area.y) + area.height)) &&
+                    (area.y < (static_cast<int32_t>(y) + height)));
+        }
+
+        /**
+         * Extend the area, so that it contains the given area too.
+         *
+         * @param[in] area  Area
+         */
+        void unite(const Area& area)
+        {
+            if (true == isEmpty())
+            {
+                *this = area;
+            }
+            else if (false == area.isEmpty())
+            {
+                int32_t right       = static_cast<int32_t>(x) + width;
+                int32_t bottom      = static_cast<int32_t>(y) + height;
+                int32_t areaRight   = static_cast<int32_t>(area.x) + area.width;
+                int32_t areaBottom  = static_cast<int32_t>(area.y) + area.height;
+
+                x       = (x < area.x) ? x : area.x;
+                y       = (y < area.y) ? y : area.y;
+                width   = ((right > areaRight) ? right : areaRight) - x;
+                height  = ((bottom > areaBottom) ? bottom : areaBottom) - y;
+            }
+            else
+            {
+                /* Nothing to do. */
+                ;
+            }
+        }
+
+        /**
+         * Reduce the area to the part, which overlaps the given area.
+         *
+         * @param[in] area  Area
+         */
+        void intersect(const Area& area)
+        {
+            if (false == intersects(area))
+            {
+                *this = Area();
+            }
+            else
+            {
+                int32_t right       = static_cast<int32_t>(x) + width;
+                int32_t bottom      = static_cast<int32_t>(y) + height;
+                int32_t areaRight   = static_cast<int32_t>(area.x) + area.width;
+                int32_t areaBottom  = static_cast<int32_t>(area.y) + area.height;
+
+                x       = (x > area.x) ? x : area.x;
+                y       = (y > area.y) ? y : area.y;
+                width   = ((right < areaRight) ? right : areaRight) - x;
+                height  = ((bottom < areaBottom) ? bottom : areaBottom) - y;
+            }
+        }
+    };
+
     /**
      * Destroys a widget.
      */
@@ -87,6 +247,7 @@ public:
             m_posY      = widget.m_posY;
             /* m_name is not assigned! */
             m_isEnabled = widget.m_isEnabled;
+            m_isInvalid = true;
         }
 
         return *this;
@@ -100,8 +261,14 @@ public:
      */
     void move(int16_t x, int16_t y)
     {
-        m_posX = x;
-        m_posY = y;
+        if ((m_posX != x) ||
+            (m_posY != y))
+        {
+            m_posX = x;
+            m_posY = y;
+            invalidate();
+        }
+
         return;
     }
 
@@ -129,8 +296,60 @@ public:
         if (true == m_isEnabled)
         {
             paint(gfx);
+            getArea(gfx, m_paintedArea);
         }
+        else
+        {
+            m_paintedArea = Area();
+        }
+
+        m_isInvalid = false;
+
+        return;
+    }
+
+    /**
+     * Mark the widget as invalid, which means it must be painted again.
+     */
+    void invalidate()
+    {
+        m_isInvalid = true;
+        return;
+    }
+
+    /**
+     * Is the widget invalid and must be painted again?
+     * Animated widgets are invalid as long as their animation runs.
+     *
+     * @return If the widget is invalid, it will return true otherwise false.
+     */
+    virtual bool isInvalid() const
+    {
+        return m_isInvalid;
+    }
 
+    /**
+     * Paints the widget every pixel in its area?
+     * Widgets below an opaque widget, which are completely covered by it,
+     * don't need to be painted.
+     *
+     * @return If the widget is opaque, it will return true otherwise false.
+     */
+    virtual bool isOpaque() const
+    {
+        return false;
+    }
+
+    /**
+     * Get the area in the canvas, which the widget paints.
+     * As long as a widget doesn't know it better, it is the whole canvas.
+     *
+     * @param[in]   gfx     Graphics interface of the canvas
+     * @param[out]  area    Area in the canvas
+     */
+    virtual void getArea(const YAGfx& gfx, Area& area) const
+    {
+        area = Area(0, 0, gfx.getWidth(), gfx.getHeight());
         return;
     }
 
@@ -182,7 +401,12 @@ public:
      */
     void enable()
     {
-        m_isEnabled = true;
+        if (false == m_isEnabled)
+        {
+            m_isEnabled = true;
+            invalidate();
+        }
+
         return;
     }
 
@@ -192,7 +416,12 @@ public:
      */
     void disable()
     {
-        m_isEnabled = false;
+        if (true == m_isEnabled)
+        {
+            m_isEnabled = false;
+            invalidate();
+        }
+
         return;
     }
 
@@ -224,6 +453,8 @@ protected:
     int16_t     m_posY;         /**< Upper left corner (y-coordinate) of the widget in a canvas. */
     String      m_name;         /**< Widget name for identification. */
     bool        m_isEnabled;    /**< If widget is enabled, it will be drawn otherwise not. */
+    bool        m_isInvalid;    /**< If widget is invalid, it must be painted again. */
+    Area        m_paintedArea;  /**< Area in the canvas, which was painted the last time. */
 
     /**
      * Constructs a widget at position (0, 0) in the canvas.
@@ -235,7 +466,9 @@ protected:
         m_posX(0),
         m_posY(0),
         m_name(),
-        m_isEnabled(true)
+        m_isEnabled(true),
+        m_isInvalid(true),
+        m_paintedArea()
     {
     }
 
@@ -251,7 +484,9 @@ protected:
         m_posX(x),
         m_posY(y),
         m_name(),
-        m_isEnabled(true)
+        m_isEnabled(true),
+        m_isInvalid(true),
+        m_paintedArea()
     {
     }
 
@@ -266,7 +501,9 @@ protected:
         m_posX(widget.m_posX),
         m_posY(widget.m_posY),
         m_name(),
-        m_isEnabled(widget.m_isEnabled)
+        m_isEnabled(widget.m_isEnabled),
+        m_isInvalid(true),
+        m_paintedArea()
     {
     }
 
@@ -279,6 +516,9 @@ protected:
 
 private:
 
+    /* The widget group decides, which of its widgets are painted. */
+    friend class WidgetGroup;
+
     /* Default constructor not allowed. */
     Widget();
 };
@@ -69,6 +69,151 @@ const char* WidgetGroup::WIDGET_TYPE = "widgetGroup";
  * Private Methods
  *****************************************************************************/
 
+void WidgetGroup::paint(YAGfx& gfx)
+{
+    const Area                      CANVAS(0, 0, m_width, m_height);
+    Area                            area;
+    DLinkedListIterator<Widget*>    it(m_widgets);
+
+    m_gfx = &gfx;
+
+    /* Without background, the content below the widgets can't be restored.
+     * Therefore all widgets are painted.
+     */
+    if ((false == m_hasBackground) ||
+        (true == m_isInvalid))
+    {
+        area = CANVAS;
+    }
+    else
+    {
+        area = getInvalidArea();
+        area.intersect(CANVAS);
+    }
+
+    m_clip = area;
+
+    if ((true == m_hasBackground) &&
+        (false == area.isEmpty()))
+    {
+        fillRect(area.x, area.y, area.width, area.height, m_backgroundColor);
+    }
+
+    /* Walk through all widgets and draw them in the priority as
+     * they were added. Only widgets, which are invalid or overlap the
+     * area, are painted. Everything outside the area is clipped.
+     */
+    if (true == it.first())
+    {
+        do
+        {
+            Widget* widget      = *it.current();
+            Area    widgetArea;
+
+            widget->getArea(*this, widgetArea);
+
+            if ((true == widget->isEnabled()) &&
+                (true == isCovered(widget, widgetArea)))
+            {
+                /* Nothing to paint, but remember where it is. */
+                widget->m_paintedArea   = widgetArea;
+                widget->m_isInvalid     = false;
+            }
+            else if ((true == widget->isInvalid()) ||
+                     (true == widgetArea.intersects(area)))
+            {
+                /* The area below was cleared, therefore the widget must
+                 * be painted completely. A widget group would paint
+                 * only its invalid widgets otherwise.
+                 */
+                widget->invalidate();
+                widget->update(*this);
+            }
+            else
+            {
+                /* Widget is still valid. */
+                ;
+            }
+        }
+        while(true == it.next());
+    }
+
+    m_clip  = Area();
+    m_gfx   = nullptr;
+
+    return;
+}
+
+Widget::Area WidgetGroup::getInvalidArea() const
+{
+    Area                                area;
+    DLinkedListConstIterator<Widget*>   it(m_widgets);
+
+    if (true == it.first())
+    {
+        do
+        {
+            const Widget* widget = *it.current();
+
+            if (true == widget->isInvalid())
+            {
+                /* The old content must be removed and the new one painted. */
+                area.unite(widget->m_paintedArea);
+
+                if (true == widget->isEnabled())
+                {
+                    Area widgetArea;
+
+                    widget->getArea(*this, widgetArea);
+                    area.unite(widgetArea);
+                }
+            }
+        }
+        while(true == it.next());
+    }
+
+    return area;
+}
+
+bool WidgetGroup::isCovered(const Widget* widget, const Area& area) const
+{
+    bool                                isCovered   = false;
+    bool                                isOnTop     = false;
+    DLinkedListConstIterator<Widget*>   it(m_widgets);
+
+    /* Only widgets, which are added later, are painted on top. */
+    if (true == it.first())
+    {
+        do
+        {
+            const Widget* other = *it.current();
+
+            if (widget == other)
+            {
+                isOnTop = true;
+            }
+            else if ((true == isOnTop) &&
+                     (true == other->isEnabled()) &&
+                     (true == other->isOpaque()))
+            {
+                Area otherArea;
+
+                other->getArea(*this, otherArea);
+                isCovered = otherArea.contains(area);
+            }
+            else
+            {
+                /* Widget is below or not opaque. */
+                ;
+            }
+        }
+        while(  (false == isCovered) &&
+                (true == it.next()));
+    }
+
+    return isCovered;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include <WString.h>
 #include <LinkedList.hpp>
+#include <Util.h>
 #include <Widget.hpp>
 
 /******************************************************************************
@@ -58,6 +59,14 @@
 
 /**
  * This class defines a widget group and can contain several widgets.
+ *
+ * If the group has a background color, it repaints only the area of its
+ * invalid widgets. The area is cleared with the background color and every
+ * widget, which overlaps it, is painted again, clipped to the area.
+ * Without background color, all widgets are painted every time, because
+ * the content below them can't be restored.
+ * Widgets, which are completely covered by an opaque widget on top of them,
+ * are not painted at all.
  */
 class WidgetGroup : public Widget, private YAGfx
 {
@@ -76,7 +85,10 @@ public:
         m_width(width),
         m_height(height),
         m_widgets(),
-        m_gfx(nullptr)
+        m_gfx(nullptr),
+        m_clip(),
+        m_hasBackground(false),
+        m_backgroundColor()
     {
     }
 
@@ -90,7 +102,10 @@ public:
         m_width(group.m_width),
         m_height(group.m_height),
         m_widgets(group.m_widgets),
-        m_gfx(group.m_gfx)
+        m_gfx(group.m_gfx),
+        m_clip(),
+        m_hasBackground(group.m_hasBackground),
+        m_backgroundColor(group.m_backgroundColor)
     {
     }
 
@@ -114,10 +129,12 @@ public:
         {
             Widget::operator=(group);
 
-            m_width     = group.m_width;
-            m_height    = group.m_height;
-            m_widgets   = group.m_widgets;
-            m_gfx       = group.m_gfx;
+            m_width             = group.m_width;
+            m_height            = group.m_height;
+            m_widgets           = group.m_widgets;
+            m_gfx               = group.m_gfx;
+            m_hasBackground     = group.m_hasBackground;
+            m_backgroundColor   = group.m_backgroundColor;
         }
 
         return *this;
@@ -160,7 +177,7 @@ public:
         /* Underlying canvas? */
         if (nullptr != m_gfx)
         {
-            pixel = &m_gfx->getColor(x, y);
+            pixel = &m_gfx->getColor(m_posX + x, m_posY + y);
         }
 
         return *pixel;
@@ -183,7 +200,7 @@ public:
         /* Underlying canvas? */
         if (nullptr != m_gfx)
         {
-            pixel = &m_gfx->getColor(x, y);
+            pixel = &m_gfx->getColor(m_posX + x, m_posY + y);
         }
 
         return *pixel;
@@ -197,6 +214,7 @@ public:
     void setWidth(uint16_t width)
     {
         m_width = width;
+        invalidate();
     }
 
     /**
@@ -207,6 +225,7 @@ public:
     void setHeight(uint16_t height)
     {
         m_height = height;
+        invalidate();
     }
 
     /**
@@ -223,6 +242,90 @@ public:
         m_posY      = offsY;
         m_width     = width;
         m_height    = height;
+        invalidate();
+    }
+
+    /**
+     * Set the background color. The whole canvas is cleared with it and
+     * afterwards only the area of invalid widgets.
+     *
+     * @param[in] color Background color
+     */
+    void setBackgroundColor(const Color& color)
+    {
+        m_hasBackground     = true;
+        m_backgroundColor   = color;
+        invalidate();
+        return;
+    }
+
+    /**
+     * Remove the background color. All widgets are painted every time
+     * over the content of the underlying canvas.
+     */
+    void clearBackgroundColor()
+    {
+        m_hasBackground = false;
+        invalidate();
+        return;
+    }
+
+    /**
+     * Has the widget group a background color?
+     *
+     * @return If a background color is set, it will return true otherwise false.
+     */
+    bool hasBackgroundColor() const
+    {
+        return m_hasBackground;
+    }
+
+    /**
+     * Is the widget group or one of its widgets invalid?
+     *
+     * @return If something must be painted again, it will return true otherwise false.
+     */
+    bool isInvalid() const override
+    {
+        bool                                isInvalid   = Widget::isInvalid();
+        DLinkedListConstIterator<Widget*>   it(m_widgets);
+
+        if ((false == isInvalid) &&
+            (true == it.first()))
+        {
+            do
+            {
+                isInvalid = (*it.current())->isInvalid();
+            }
+            while(  (false == isInvalid) &&
+                    (true == it.next()));
+        }
+
+        return isInvalid;
+    }
+
+    /**
+     * A widget group with background color paints every pixel of its canvas.
+     *
+     * @return If the widget group is opaque, it will return true otherwise false.
+     */
+    bool isOpaque() const override
+    {
+        return m_hasBackground;
+    }
+
+    /**
+     * Get the area in the underlying canvas, which the widget group paints.
+     *
+     * @param[in]   gfx     Graphics interface of the underlying canvas
+     * @param[out]  area    Area in the underlying canvas
+     */
+    void getArea(const YAGfx& gfx, Area& area) const override
+    {
+        UTIL_NOT_USED(gfx);
+
+        area = Area(m_posX, m_posY, m_width, m_height);
+        return;
     }
 
     /**
@@ -235,6 +338,9 @@ public:
     bool addWidget(Widget& widget)
     {
         Widget* ptr = &widget;
+
+        invalidate();
+
         return m_widgets.append(ptr);
     }
 
@@ -255,6 +361,7 @@ public:
         {
             /* Remove widget */
             it.remove();
+            invalidate();
             status = true;
         }
 
@@ -313,36 +420,35 @@ private:
 
     uint16_t                m_width;    /**< Canvas width in pixels */
     uint16_t                m_height;   /**< Canvas height in pixels */
-    DLinkedList<Widget*>    m_widgets;  /**< Widgets in the group */
-    YAGfx*                  m_gfx;      /**< Graphics interface of the underlying layer */
+    DLinkedList<Widget*>    m_widgets;          /**< Widgets in the group */
+    YAGfx*                  m_gfx;              /**< Graphics interface of the underlying layer */
+    Area                    m_clip;             /**< Area in the canvas, which may be painted */
+    bool                    m_hasBackground;    /**< Is a background color set? */
+    Color                   m_backgroundColor;  /**< Background color */
 
     /**
      * Paint the widget with the given graphics interface.
      * 
      * @param[in] gfx   Graphics interface
      */
-    void paint(YAGfx& gfx) override
-    {
-        DLinkedListIterator<Widget*> it(m_widgets);
-
-        m_gfx = &gfx;
+    void paint(YAGfx& gfx) override;
 
-        /* Walk through all widgets and draw them in the priority as
-         * they were added.
-         */
-        if (true == it.first())
-        {
-            do
-            {
-                (*it.current())->update(*this);
-            }
-            while(true == it.next());
-        }
-
-        m_gfx = nullptr;
+    /**
+     * Get the area, which must be painted again, because of invalid widgets.
+     *
+     * @return Area in the canvas, which may be empty.
+     */
+    Area getInvalidArea() const;
 
-        return;
-    }
+    /**
+     * Is the widget completely covered by an opaque widget on top of it?
+     *
+     * @param[in] widget    Widget
+     * @param[in] area      Area of the widget in the canvas
+     *
+     * @return If the widget is covered, it will return true otherwise false.
+     */
+    bool isCovered(const Widget* widget, const Area& area) const;
 
     /**
      * Draw a single pixel and ensure that the drawing borders are not violated.
@@ -353,18 +459,52 @@ private:
      */
     void drawPixel(int16_t x, int16_t y, const Color& color) final
     {
-        /* Don't draw outside the canvas. */
+        /* Don't draw outside the clipping area. */
         if ((nullptr != m_gfx) &&
-            (0 <= x) &&
-            (0 <= y) &&
-            (m_width > x) &&
-            (m_height > y))
-        {    
+            (true == m_clip.contains(x, y)))
+        {
             m_gfx->drawPixel(m_posX + x, m_posY + y, color);
         }
 
         return;
     }
+
+    /**
+     * Draw a horizontal span of pixels and ensure that the drawing borders
+     * are not violated.
+     *
+     * @param[in] x         x-coordinate of the first pixel
+     * @param[in] y         y-coordinate of the first pixel
+     * @param[in] colors    Pixel colors
+     * @param[in] length    Number of pixels
+     */
+    void drawHSpan(int16_t x, int16_t y, const Color* colors, uint16_t length) final
+    {
+        int32_t xBegin  = x;
+        int32_t xEnd    = static_cast<int32_t>(x) + length;
+
+        if (m_clip.x > xBegin)
+        {
+            xBegin = m_clip.x;
+        }
+
+        if ((static_cast<int32_t>(m_clip.x) + m_clip.width) < xEnd)
+        {
+            xEnd = static_cast<int32_t>(m_clip.x) + m_clip.width;
+        }
+
+        /* Don't draw outside the clipping area. */
+        if ((nullptr != m_gfx) &&
+            (nullptr != colors) &&
+            (m_clip.y <= y) &&
+            ((static_cast<int32_t>(m_clip.y) + m_clip.height) > y) &&
+            (xBegin < xEnd))
+        {
+            m_gfx->drawHSpan(m_posX + xBegin, m_posY + y, &colors[xBegin - x], xEnd - xBegin);
+        }
+
+        return;
+    }
 };
 
 /******************************************************************************
@@ -0,0 +1,218 @@
+"""
+MIT License
+
+Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+================================================================================
+Prepares the web assets for the filesystem image.
+
+The web pages are static, therefore they and the other text assets (JavaScript,
+CSS) are gzip compressed. Every asset reference in the web pages gets the
+content hash of the asset as version parameter, e.g. /js/menu.js?v=1a2b3c4d.
+The web server allows the client to cache such requests forever, because a
+changed asset results in a different reference.
+
+The data directory itself is not modified. The filesystem image is built from
+a prepared copy in the build directory.
+
+"""
+
+import os
+import shutil
+import gzip
+import hashlib
+import re
+
+# pylint: disable=undefined-variable
+Import("env") # type: ignore
+
+# Targets, which build the filesystem image.
+FILESYSTEM_TARGETS = [ "buildfs", "uploadfs", "uploadfsota" ]
+
+# Directories with assets, which are referenced by the web pages.
+ASSET_DIRS = [ "js", "style", "images" ]
+
+# Single assets, which are referenced by the web pages.
+ASSET_FILES = [ "favicon.png" ]
+
+# File extensions of assets, which will be compressed.
+COMPRESS_EXTENSIONS = [ ".html", ".js", ".css" ]
+
+# Directories, which are not touched. The captive portal page is still
+# processed as template by the web server.
+EXCLUDE_DIRS = [ "cp", "configuration" ]
+
+# Length of the content hash in characters.
+HASH_LENGTH = 8
+
+# Asset references in the web pages.
+ASSET_REF_PATTERN = re.compile(r'(src|href)="(/[^"?#]+)"')
+
+def is_excluded(rel_path):
+    """Checks whether the file is in a excluded directory.
+
+    Args:
+        rel_path (str): Path relative to the data directory
+
+    Returns:
+        bool: If excluded, it will return True otherwise False.
+    """
+    parts = rel_path.replace(os.sep, "/").split("/")
+
+    return (1 < len(parts)) and (parts[0] in EXCLUDE_DIRS)
+
+def get_files(base_dir):
+    """Get all files in the directory and its sub-directories.
+
+    Args:
+        base_dir (str): Directory
+
+    Returns:
+        list: Paths of the files relative to the directory
+    """
+    files = []
+
+    for root, _, file_names in os.walk(base_dir):
+        for file_name in file_names:
+            files.append(os.path.relpath(os.path.join(root, file_name), base_dir))
+
+    return files
+
+def get_content_hash(file_path):
+    """Get the hash over the uncompressed content of a file.
+
+    Args:
+        file_path (str): Path of the file, which may be gzip compressed.
+
+    Returns:
+        str: Content hash
+    """
+    if file_path.endswith(".gz"):
+        with gzip.open(file_path, "rb") as file:
+            content = file.read()
+    else:
+        with open(file_path, "rb") as file:
+            content = file.read()
+
+    return hashlib.sha256(content).hexdigest()[:HASH_LENGTH]
+
+def get_asset_hashes(data_dir):
+    """Get the content hashes of all assets, which may be referenced by the web pages.
+
+    Args:
+        data_dir (str): Data directory
+
+    Returns:
+        dict: Content hash per asset URL
+    """
+    hashes = {}
+
+    for rel_path in get_files(data_dir):
+        url = "/" + rel_path.replace(os.sep, "/")
+        top_dir = url.split("/")[1]
+
+        if (top_dir in ASSET_DIRS) or (url[1:] in ASSET_FILES):
+            # The web server looks for the compressed file automatically.
+            if url.endswith(".gz"):
+                url = url[:-len(".gz")]
+
+            hashes[url] = get_content_hash(os.path.join(data_dir, rel_path))
+
+    return hashes
+
+def add_asset_versions(file_path, hashes):
+    """Add the content hash as version parameter to every known asset reference in a web page.
+
+    Args:
+        file_path (str): Path of the web page
+        hashes (dict): Content hash per asset URL
+    """
+    with open(file_path, "r", encoding="utf-8") as file:
+        content = file.read()
+
+    def add_version(match):
+        url = match.group(2)
+
+        if url not in hashes:
+            return match.group(0)
+
+        return match.group(1) + "=\"" + url + "?v=" + hashes[url] + "\""
+
+    content = ASSET_REF_PATTERN.sub(add_version, content)
+
+    with open(file_path, "w", encoding="utf-8", newline="") as file:
+        file.write(content)
+
+def compress(file_path):
+    """Compress a file with gzip and remove the original one.
+    The timestamp in the gzip header is cleared to get reproducible images.
+
+    Args:
+        file_path (str): Path of the file
+    """
+    with open(file_path, "rb") as file_in:
+        with open(file_path + ".gz", "wb") as file_out:
+            with gzip.GzipFile(filename="", mode="wb", compresslevel=9, fileobj=file_out, mtime=0) as gzip_file:
+                shutil.copyfileobj(file_in, gzip_file)
+
+    os.remove(file_path)
+
+def prepare_web_assets(data_dir, build_data_dir):
+    """Prepare the web assets in a copy of the data directory.
+
+    Args:
+        data_dir (str): Data directory
+        build_data_dir (str): Directory, where to prepare the copy
+    """
+    if os.path.isdir(build_data_dir):
+        shutil.rmtree(build_data_dir)
+
+    shutil.copytree(data_dir, build_data_dir)
+
+    hashes = get_asset_hashes(build_data_dir)
+    size_before = 0
+    size_after = 0
+
+    for rel_path in get_files(build_data_dir):
+        file_path = os.path.join(build_data_dir, rel_path)
+
+        if is_excluded(rel_path):
+            continue
+
+        if rel_path.endswith(".html"):
+            add_asset_versions(file_path, hashes)
+
+        if os.path.splitext(rel_path)[1] in COMPRESS_EXTENSIONS:
+            size_before += os.path.getsize(file_path)
+            compress(file_path)
+            size_after += os.path.getsize(file_path + ".gz")
+
+    print("Web assets compressed  : " + str(size_before) + " -> " + str(size_after) + " bytes")
+
+# pylint: disable=undefined-variable
+if any(target in FILESYSTEM_TARGETS for target in COMMAND_LINE_TARGETS): # type: ignore
+    DATA_DIR = env.subst("$PROJECT_DATA_DIR") # type: ignore
+    BUILD_DATA_DIR = os.path.join(env.subst("$BUILD_DIR"), "data") # type: ignore
+
+    prepare_web_assets(DATA_DIR, BUILD_DATA_DIR)
+
+    # pylint: disable=undefined-variable
+    env.Replace(PROJECT_DATA_DIR=BUILD_DATA_DIR) # type: ignore
@@ -0,0 +1,197 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Boot profiler
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "BootProfiler.h"
+
+#include <Arduino.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+uint8_t BootProfiler::begin(const char* name)
+{
+    return addPhase(name, true);
+}
+
+void BootProfiler::end(uint8_t id)
+{
+    uint32_t timestamp = micros();
+
+    if (MAX_PHASES > id)
+    {
+        CriticalSectionGuard guard(m_critSec);
+
+        if (true == m_phases[id].isRunning)
+        {
+            m_phases[id].duration   = timestamp - m_phases[id].start;
+            m_phases[id].isRunning  = false;
+        }
+    }
+
+    return;
+}
+
+void BootProfiler::mark(const char* name)
+{
+    (void)addPhase(name, false);
+
+    return;
+}
+
+void BootProfiler::finish()
+{
+    uint32_t    timestamp   = micros();
+    uint8_t     idx         = 0U;
+
+    {
+        CriticalSectionGuard guard(m_critSec);
+
+        if (false == m_isFinished)
+        {
+            m_bootDuration  = timestamp;
+            m_isFinished    = true;
+        }
+    }
+
+    LOG_INFO("Boot finished after %u ms.", m_bootDuration / 1000U);
+
+    for(idx = 0U; idx < m_phaseCnt; ++idx)
+    {
+        const Phase& phase = m_phases[idx];
+
+        LOG_DEBUG("Boot phase %s: start %u us, duration %u us, core %d.", phase.name, phase.start, phase.duration, phase.core);
+    }
+
+    return;
+}
+
+uint32_t BootProfiler::getBootDuration() const
+{
+    uint32_t duration = 0U;
+
+    if (false == m_isFinished)
+    {
+        duration = micros();
+    }
+    else
+    {
+        duration = m_bootDuration;
+    }
+
+    return duration;
+}
+
+uint8_t BootProfiler::getPhaseCount() const
+{
+    CriticalSectionGuard guard(m_critSec);
+
+    return m_phaseCnt;
+}
+
+bool BootProfiler::getPhase(uint8_t idx, Phase& phase) const
+{
+    CriticalSectionGuard    guard(m_critSec);
+    bool                    isAvailable = false;
+
+    if (m_phaseCnt > idx)
+    {
+        phase       = m_phases[idx];
+        isAvailable = true;
+    }
+
+    return isAvailable;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+uint8_t BootProfiler::addPhase(const char* name, bool isRunning)
+{
+    uint32_t                timestamp   = micros();
+    int32_t                 core        = xPortGetCoreID();
+    uint8_t                 id          = INVALID_PHASE_ID;
+    CriticalSectionGuard    guard(m_critSec);
+
+    if ((false == m_isFinished) &&
+        (MAX_PHASES > m_phaseCnt))
+    {
+        Phase& phase = m_phases[m_phaseCnt];
+
+        phase.name      = name;
+        phase.start     = timestamp;
+        phase.duration  = 0U;
+        phase.core      = core;
+        phase.isRunning = isRunning;
+
+        id = m_phaseCnt;
+        ++m_phaseCnt;
+    }
+
+    return id;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,208 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Boot profiler
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __BOOT_PROFILER_H__
+#define __BOOT_PROFILER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <CriticalSection.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The boot profiler records the duration of the single initialization
+ * phases, until the system is completely up. Phases may run concurrently
+ * on different cores. All timestamps are in us since power-on.
+ */
+class BootProfiler
+{
+public:
+
+    /**
+     * A single boot phase.
+     */
+    struct Phase
+    {
+        const char* name;       /**< Phase name */
+        uint32_t    start;      /**< Start timestamp in us */
+        uint32_t    duration;   /**< Duration in us */
+        int32_t     core;       /**< Id of the core, where the phase ran. */
+        bool        isRunning;  /**< Is the phase still running? */
+    };
+
+    /**
+     * Get boot profiler instance.
+     *
+     * @return Boot profiler instance
+     */
+    static BootProfiler& getInstance()
+    {
+        static BootProfiler instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Begin a boot phase.
+     *
+     * @param[in] name  Name of the phase, which must be a string literal.
+     *
+     * @return Phase id, which is used to end the phase. If no more phase can be recorded, it returns INVALID_PHASE_ID.
+     */
+    uint8_t begin(const char* name);
+
+    /**
+     * End a boot phase.
+     *
+     * @param[in] id    Phase id
+     */
+    void end(uint8_t id);
+
+    /**
+     * Record a milestone, which is a phase without duration.
+     * Example: The first frame was shown.
+     *
+     * @param[in] name  Name of the milestone, which must be a string literal.
+     */
+    void mark(const char* name);
+
+    /**
+     * Mark the boot as finished. Further phases are not recorded anymore.
+     */
+    void finish();
+
+    /**
+     * Is the boot finished?
+     *
+     * @return If boot is finished, it will return true otherwise false.
+     */
+    bool isFinished() const
+    {
+        return m_isFinished;
+    }
+
+    /**
+     * Get the boot duration in us. If the boot is not finished yet,
+     * the duration until now is returned.
+     *
+     * @return Boot duration in us
+     */
+    uint32_t getBootDuration() const;
+
+    /**
+     * Get number of recorded phases.
+     *
+     * @return Number of phases
+     */
+    uint8_t getPhaseCount() const;
+
+    /**
+     * Get a recorded phase. The phases are ordered by their begin.
+     *
+     * @param[in]   idx     Phase index
+     * @param[out]  phase   Phase
+     *
+     * @return If phase is available, it will return true otherwise false.
+     */
+    bool getPhase(uint8_t idx, Phase& phase) const;
+
+    /** Max. number of phases, which can be recorded. */
+    static const uint8_t    MAX_PHASES          = 32U;
+
+    /** Invalid phase id. */
+    static const uint8_t    INVALID_PHASE_ID    = UINT8_MAX;
+
+private:
+
+    mutable CriticalSection m_critSec;              /**< Protects the phases, because they are recorded by several tasks. */
+    Phase                   m_phases[MAX_PHASES];   /**< Recorded phases */
+    uint8_t                 m_phaseCnt;             /**< Number of recorded phases */
+    uint32_t                m_bootDuration;         /**< Boot duration in us, valid after boot is finished. */
+    bool                    m_isFinished;           /**< Is boot finished? */
+
+    /**
+     * Constructs the boot profiler.
+     */
+    BootProfiler() :
+        m_critSec(),
+        m_phases(),
+        m_phaseCnt(0U),
+        m_bootDuration(0U),
+        m_isFinished(false)
+    {
+    }
+
+    /**
+     * Destroys the boot profiler.
+     */
+    ~BootProfiler()
+    {
+        /* Will never be called. */
+    }
+
+    BootProfiler(const BootProfiler& profiler);
+    BootProfiler& operator=(const BootProfiler& profiler);
+
+    /**
+     * Add a phase.
+     *
+     * @param[in] name      Phase name
+     * @param[in] isRunning Is the phase running or is it a milestone?
+     *
+     * @return Phase id or INVALID_PHASE_ID
+     */
+    uint8_t addPhase(const char* name, bool isRunning);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __BOOT_PROFILER_H__ */
+
+/** @} */
@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "JsonFile.h"
+#include "MemTag.h"
 
 #define STREAMUTILS_ENABLE_EEPROM 0
 #include <StreamUtils.h>
@@ -63,8 +64,9 @@
 
 bool JsonFile::load(const String& fileName, JsonDocument& doc)
 {
-    bool    isSuccessful    = false;
-    File    fd              = m_fs.open(fileName, "r");
+    MemTagGuard memTagGuard(MemTag::ID_JSON);
+    bool        isSuccessful    = false;
+    File        fd              = m_fs.open(fileName, "r");
 
     if (true == fd)
     {
@@ -84,8 +86,9 @@ bool JsonFile::load(const String& fileName, JsonDocument& doc)
 
 bool JsonFile::save(const String& fileName, const JsonDocument& doc)
 {
-    bool    isSuccessful    = false;
-    File    fd              = m_fs.open(fileName, "w");
+    MemTagGuard memTagGuard(MemTag::ID_JSON);
+    bool        isSuccessful    = false;
+    File        fd              = m_fs.open(fileName, "w");
 
     if (true == fd)
     {
@@ -79,6 +79,26 @@ void MemMon::process()
     {
         uint32_t minFreeHeap        = ESP.getMinFreeHeap();
         uint32_t minFreeHeapBlock   = ESP.getMaxAllocHeap();
+        uint32_t freeHeap           = ESP.getFreeHeap();
+        uint8_t  fragmentation      = 0U;
+
+        if ((0U < freeHeap) &&
+            (minFreeHeapBlock <= freeHeap))
+        {
+            fragmentation = static_cast<uint8_t>(100U - ((static_cast<uint64_t>(minFreeHeapBlock) * 100U) / freeHeap));
+        }
+
+        {
+            CriticalSectionGuard guard(m_critSec);
+
+            m_fragHistory[m_fragHistoryWrIdx] = fragmentation;
+            m_fragHistoryWrIdx = (m_fragHistoryWrIdx + 1U) % FRAGMENTATION_HISTORY_SIZE;
+
+            if (FRAGMENTATION_HISTORY_SIZE > m_fragHistoryCnt)
+            {
+                ++m_fragHistoryCnt;
+            }
+        }
 
         if (MIN_HEAP_MEMORY >= minFreeHeap)
         {
@@ -98,6 +118,30 @@ void MemMon::process()
     }
 }
 
+size_t MemMon::getFragmentationHistory(uint8_t* history, size_t size)
+{
+    size_t count = 0U;
+
+    if (nullptr != history)
+    {
+        CriticalSectionGuard    guard(m_critSec);
+        size_t                  rdIdx   = 0U;
+
+        count = (size < m_fragHistoryCnt) ? size : m_fragHistoryCnt;
+
+        /* Skip the oldest samples, which don't fit into the buffer. */
+        rdIdx = (m_fragHistoryWrIdx + FRAGMENTATION_HISTORY_SIZE - count) % FRAGMENTATION_HISTORY_SIZE;
+
+        for(size_t idx = 0U; idx < count; ++idx)
+        {
+            history[idx] = m_fragHistory[rdIdx];
+            rdIdx = (rdIdx + 1U) % FRAGMENTATION_HISTORY_SIZE;
+        }
+    }
+
+    return count;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
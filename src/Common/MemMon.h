@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include <SysMsgPlugin.h>
 #include <WString.h>
+#include <CriticalSection.hpp>
 
 /******************************************************************************
  * Macros
@@ -79,6 +80,19 @@ public:
      */
     void process();
 
+    /**
+     * Get the fragmentation history of the heap. The fragmentation index
+     * is 0 for a unfragmented heap and 100 for a completely fragmented heap.
+     * It is derived from the largest free block in relation to the whole free heap.
+     * The samples are ordered from the oldest to the newest one.
+     *
+     * @param[out]  history Buffer for the samples in percent
+     * @param[in]   size    Max. number of samples the buffer can hold
+     *
+     * @return Number of samples written to the buffer
+     */
+    size_t getFragmentationHistory(uint8_t* history, size_t size);
+
     /** Processing cycle in ms. */
     static const uint32_t PROCESSING_CYCLE          = 60U * 1000U;
 
@@ -88,14 +102,26 @@ public:
     /** Minimum size of largest block of heap that can be allocated at once in bytes, the monitor starts to warn. */
     static const size_t     MIN_HEAP_BLOCK_MEMORY   = 4096U;
 
+    /** Max. number of fragmentation samples in the history. One sample per processing cycle. */
+    static const size_t     FRAGMENTATION_HISTORY_SIZE  = 60U;
+
 private:
 
-    SimpleTimer m_timer;    /**< Timer used for cyclic processing. */
+    SimpleTimer     m_timer;                                            /**< Timer used for cyclic processing. */
+    CriticalSection m_critSec;                                          /**< Protects the fragmentation history. */
+    uint8_t         m_fragHistory[FRAGMENTATION_HISTORY_SIZE];          /**< Fragmentation history as ring buffer */
+    size_t          m_fragHistoryWrIdx;                                 /**< Write index of the fragmentation history */
+    size_t          m_fragHistoryCnt;                                   /**< Number of samples in the fragmentation history */
 
     /**
      * Constructs the memory monitor.
      */
-    MemMon()
+    MemMon() :
+        m_timer(),
+        m_critSec(),
+        m_fragHistory(),
+        m_fragHistoryWrIdx(0U),
+        m_fragHistoryCnt(0U)
     {
     }
 
@@ -117,4 +143,4 @@ private:
 
 #endif  /* __MEM_MON_H__ */
 
-/** @} */
\ No newline at end of file
+/** @} */
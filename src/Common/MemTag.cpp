@@ -0,0 +1,543 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Heap allocation tagging
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MemTag.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * A task, which is currently inside a tagged scope.
+ */
+struct TaggedTask
+{
+    TaskHandle_t    task;   /**< Task handle, nullptr means unused. */
+    MemTag::Id      id;     /**< Memory tag id of the innermost scope. */
+};
+
+/**
+ * A tracked heap allocation.
+ */
+struct TrackedAlloc
+{
+    void*       ptr;    /**< Address of the allocated block, nullptr means unused. */
+    uint32_t    info;   /**< Requested size in bytes (upper 24 bit) and memory tag id (lower 8 bit). */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+extern "C" void* __real_malloc(size_t size);
+extern "C" void* __real_calloc(size_t num, size_t size);
+extern "C" void* __real_realloc(void* ptr, size_t size);
+extern "C" void __real_free(void* ptr);
+
+static MemTag::Id getTaskTag();
+static size_t hashIndex(const void* ptr);
+static void track(void* ptr, size_t size, MemTag::Id id);
+static MemTag::Id untrack(void* ptr, size_t& size);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/**
+ * Spinlock to protect the tracking data against concurrent access by tasks
+ * and cores. Note, the CriticalSection class can't be used here, because the
+ * allocation hooks are called before any constructor of a static object ran.
+ * The spinlock is constant initialized instead.
+ */
+static portMUX_TYPE         gSpinlock                               = portMUX_INITIALIZER_UNLOCKED;
+
+/** Tasks which are currently inside a tagged scope. */
+static TaggedTask           gTaggedTasks[MemTag::MAX_TAGGED_TASKS];
+
+/** Number of tasks which are currently inside a tagged scope. Used for the fast path. */
+static volatile uint8_t     gTaggedTaskCount                        = 0U;
+
+/** Tracked allocations, hash table with linear probing. */
+static TrackedAlloc         gTrackedAllocs[MemTag::MAX_TRACKED_ALLOCS];
+
+/** Number of tracked allocations. Used for the fast path. */
+static volatile size_t      gTrackedAllocCount                      = 0U;
+
+/** Number of allocations which couldn't be tracked, because the table was full. */
+static uint32_t             gUntrackedCount                         = 0U;
+
+/** Heap statistics per memory tag. */
+static MemTag::Statistics   gStatistics[MemTag::ID_COUNT];
+
+/**
+ * Max. number of tracked allocations in percent of the table size.
+ * A lower load keeps the probe sequences short.
+ */
+static const size_t         MAX_LOAD                                = 75U;
+
+/** Max. size of a allocation, which can be stored in a tracking entry. */
+static const uint32_t       MAX_TRACKED_SIZE                        = 0x00ffffffU;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+MemTag::Id MemTag::enter(Id id)
+{
+    TaskHandle_t    task        = xTaskGetCurrentTaskHandle();
+    Id              outerId     = ID_UNTAGGED;
+    TaggedTask*     freeSlot    = nullptr;
+    TaggedTask*     found       = nullptr;
+    uint8_t         idx         = 0U;
+
+    portENTER_CRITICAL(&gSpinlock);
+
+    for(idx = 0U; idx < UTIL_ARRAY_NUM(gTaggedTasks); ++idx)
+    {
+        if (task == gTaggedTasks[idx].task)
+        {
+            found = &gTaggedTasks[idx];
+            break;
+        }
+        else if ((nullptr == freeSlot) &&
+                 (nullptr == gTaggedTasks[idx].task))
+        {
+            freeSlot = &gTaggedTasks[idx];
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    /* Nested scope? */
+    if (nullptr != found)
+    {
+        outerId     = found->id;
+        found->id   = id;
+    }
+    /* Outermost scope, if no slot is available the scope is just not tagged. */
+    else if (nullptr != freeSlot)
+    {
+        freeSlot->task  = task;
+        freeSlot->id    = id;
+        ++gTaggedTaskCount;
+    }
+    else
+    {
+        ;
+    }
+
+    portEXIT_CRITICAL(&gSpinlock);
+
+    return outerId;
+}
+
+void MemTag::leave(Id outerId)
+{
+    TaskHandle_t    task    = xTaskGetCurrentTaskHandle();
+    uint8_t         idx     = 0U;
+
+    portENTER_CRITICAL(&gSpinlock);
+
+    for(idx = 0U; idx < UTIL_ARRAY_NUM(gTaggedTasks); ++idx)
+    {
+        if (task == gTaggedTasks[idx].task)
+        {
+            /* Leaving the outermost scope? */
+            if (ID_UNTAGGED == outerId)
+            {
+                gTaggedTasks[idx].task  = nullptr;
+                gTaggedTasks[idx].id    = ID_UNTAGGED;
+                --gTaggedTaskCount;
+            }
+            else
+            {
+                gTaggedTasks[idx].id = outerId;
+            }
+
+            break;
+        }
+    }
+
+    portEXIT_CRITICAL(&gSpinlock);
+}
+
+void MemTag::getStatistics(Id id, Statistics& statistics)
+{
+    if (ID_COUNT > id)
+    {
+        portENTER_CRITICAL(&gSpinlock);
+        statistics = gStatistics[id];
+        portEXIT_CRITICAL(&gSpinlock);
+    }
+}
+
+uint32_t MemTag::getUntrackedCount()
+{
+    return gUntrackedCount;
+}
+
+const char* MemTag::idToStr(Id id)
+{
+    const char* name = "unknown";
+
+    switch(id)
+    {
+    case ID_UNTAGGED:
+        name = "untagged";
+        break;
+
+    case ID_PLUGINS:
+        name = "plugins";
+        break;
+
+    case ID_HTTP_CLIENT:
+        name = "httpClient";
+        break;
+
+    case ID_JSON:
+        name = "json";
+        break;
+
+    case ID_WEB_SERVER:
+        name = "webServer";
+        break;
+
+    case ID_LOGGING:
+        name = "logging";
+        break;
+
+    default:
+        break;
+    }
+
+    return name;
+}
+
+/**
+ * Allocation hook for malloc(), see linker option --wrap=malloc.
+ *
+ * @param[in] size  Size in bytes
+ *
+ * @return Allocated memory or nullptr
+ */
+extern "C" void* __wrap_malloc(size_t size)
+{
+    void* ptr = __real_malloc(size);
+
+    if ((nullptr != ptr) &&
+        (0U < gTaggedTaskCount))
+    {
+        MemTag::Id id = getTaskTag();
+
+        if (MemTag::ID_UNTAGGED != id)
+        {
+            track(ptr, size, id);
+        }
+    }
+
+    return ptr;
+}
+
+/**
+ * Allocation hook for calloc(), see linker option --wrap=calloc.
+ *
+ * @param[in] num   Number of elements
+ * @param[in] size  Element size in bytes
+ *
+ * @return Allocated memory or nullptr
+ */
+extern "C" void* __wrap_calloc(size_t num, size_t size)
+{
+    void* ptr = __real_calloc(num, size);
+
+    if ((nullptr != ptr) &&
+        (0U < gTaggedTaskCount))
+    {
+        MemTag::Id id = getTaskTag();
+
+        if (MemTag::ID_UNTAGGED != id)
+        {
+            track(ptr, num * size, id);
+        }
+    }
+
+    return ptr;
+}
+
+/**
+ * Allocation hook for realloc(), see linker option --wrap=realloc.
+ * A already tracked block keeps its memory tag, otherwise the memory tag
+ * of the current scope is used.
+ *
+ * @param[in] ptr   Memory block which to reallocate
+ * @param[in] size  New size in bytes
+ *
+ * @return Reallocated memory or nullptr
+ */
+extern "C" void* __wrap_realloc(void* ptr, size_t size)
+{
+    MemTag::Id  id      = MemTag::ID_UNTAGGED;
+    size_t      oldSize = 0U;
+    void*       newPtr  = nullptr;
+
+    /* The old block must be untracked before it is released by realloc,
+     * otherwise a concurrent allocation may get the same address.
+     */
+    if ((nullptr != ptr) &&
+        (0U < gTrackedAllocCount))
+    {
+        portENTER_CRITICAL(&gSpinlock);
+        id = untrack(ptr, oldSize);
+        portEXIT_CRITICAL(&gSpinlock);
+    }
+
+    newPtr = __real_realloc(ptr, size);
+
+    if ((MemTag::ID_UNTAGGED == id) &&
+        (0U < gTaggedTaskCount))
+    {
+        id = getTaskTag();
+    }
+
+    if (MemTag::ID_UNTAGGED != id)
+    {
+        if (nullptr != newPtr)
+        {
+            track(newPtr, size, id);
+        }
+        /* Reallocation failed, the old block is still valid. */
+        else if ((nullptr != ptr) &&
+                 (0U < size) &&
+                 (0U < oldSize))
+        {
+            track(ptr, oldSize, id);
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return newPtr;
+}
+
+/**
+ * Allocation hook for free(), see linker option --wrap=free.
+ *
+ * @param[in] ptr   Memory block which to release
+ */
+extern "C" void __wrap_free(void* ptr)
+{
+    /* Untrack before release, otherwise a concurrent allocation may get the same address. */
+    if ((nullptr != ptr) &&
+        (0U < gTrackedAllocCount))
+    {
+        size_t size = 0U;
+
+        portENTER_CRITICAL(&gSpinlock);
+        (void)untrack(ptr, size);
+        portEXIT_CRITICAL(&gSpinlock);
+    }
+
+    __real_free(ptr);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the memory tag of the current task.
+ *
+ * @return Memory tag id
+ */
+static MemTag::Id getTaskTag()
+{
+    TaskHandle_t    task    = xTaskGetCurrentTaskHandle();
+    MemTag::Id      id      = MemTag::ID_UNTAGGED;
+    uint8_t         idx     = 0U;
+
+    /* Only the current task modifies its own entry, therefore no lock is necessary. */
+    for(idx = 0U; idx < UTIL_ARRAY_NUM(gTaggedTasks); ++idx)
+    {
+        if (task == gTaggedTasks[idx].task)
+        {
+            id = gTaggedTasks[idx].id;
+            break;
+        }
+    }
+
+    return id;
+}
+
+/**
+ * Calculate the home index of a memory block in the tracking table.
+ *
+ * @param[in] ptr   Memory block address
+ *
+ * @return Index in the tracking table
+ */
+static size_t hashIndex(const void* ptr)
+{
+    /* Heap blocks are at least 4 byte aligned, the multiplication spreads
+     * the remaining bits (Fibonacci hashing).
+     */
+    uint32_t value = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(ptr) >> 2U);
+
+    return static_cast<size_t>((value * 2654435761U) >> 16U) & (MemTag::MAX_TRACKED_ALLOCS - 1U);
+}
+
+/**
+ * Track a allocated memory block.
+ *
+ * @param[in] ptr   Memory block address
+ * @param[in] size  Memory block size in bytes
+ * @param[in] id    Memory tag id
+ */
+static void track(void* ptr, size_t size, MemTag::Id id)
+{
+    portENTER_CRITICAL(&gSpinlock);
+
+    if (((MemTag::MAX_TRACKED_ALLOCS * MAX_LOAD) / 100U <= gTrackedAllocCount) ||
+        (MAX_TRACKED_SIZE < size))
+    {
+        ++gUntrackedCount;
+    }
+    else
+    {
+        size_t              idx     = hashIndex(ptr);
+        MemTag::Statistics& stat    = gStatistics[id];
+
+        while(nullptr != gTrackedAllocs[idx].ptr)
+        {
+            idx = (idx + 1U) & (MemTag::MAX_TRACKED_ALLOCS - 1U);
+        }
+
+        gTrackedAllocs[idx].ptr     = ptr;
+        gTrackedAllocs[idx].info    = (static_cast<uint32_t>(size) << 8U) | static_cast<uint32_t>(id);
+        ++gTrackedAllocCount;
+
+        stat.liveBytes += size;
+        ++stat.allocCount;
+
+        if (stat.peakBytes < stat.liveBytes)
+        {
+            stat.peakBytes = stat.liveBytes;
+        }
+    }
+
+    portEXIT_CRITICAL(&gSpinlock);
+}
+
+/**
+ * Untrack a memory block. The caller must hold the spinlock.
+ *
+ * @param[in]   ptr     Memory block address
+ * @param[out]  size    Size of the memory block in bytes, only valid if tracked.
+ *
+ * @return Memory tag id of the block. If it was not tracked, it will be MemTag::ID_UNTAGGED.
+ */
+static MemTag::Id untrack(void* ptr, size_t& size)
+{
+    MemTag::Id  id  = MemTag::ID_UNTAGGED;
+    size_t      idx = hashIndex(ptr);
+
+    while((nullptr != gTrackedAllocs[idx].ptr) &&
+          (ptr != gTrackedAllocs[idx].ptr))
+    {
+        idx = (idx + 1U) & (MemTag::MAX_TRACKED_ALLOCS - 1U);
+    }
+
+    if (nullptr != gTrackedAllocs[idx].ptr)
+    {
+        size_t next = (idx + 1U) & (MemTag::MAX_TRACKED_ALLOCS - 1U);
+
+        id      = static_cast<MemTag::Id>(gTrackedAllocs[idx].info & 0xffU);
+        size    = gTrackedAllocs[idx].info >> 8U;
+
+        gStatistics[id].liveBytes -= size;
+        ++gStatistics[id].freeCount;
+
+        /* Backward shift deletion keeps the probe sequences intact without tombstones. */
+        while(nullptr != gTrackedAllocs[next].ptr)
+        {
+            size_t home = hashIndex(gTrackedAllocs[next].ptr);
+
+            /* Can the entry be moved to the free slot? That is the case if its
+             * home index is not cyclically in between the free slot and itself.
+             */
+            if (((next - home) & (MemTag::MAX_TRACKED_ALLOCS - 1U)) >=
+                ((next - idx) & (MemTag::MAX_TRACKED_ALLOCS - 1U)))
+            {
+                gTrackedAllocs[idx] = gTrackedAllocs[next];
+                idx = next;
+            }
+
+            next = (next + 1U) & (MemTag::MAX_TRACKED_ALLOCS - 1U);
+        }
+
+        gTrackedAllocs[idx].ptr     = nullptr;
+        gTrackedAllocs[idx].info    = 0U;
+        --gTrackedAllocCount;
+    }
+
+    return id;
+}
@@ -0,0 +1,202 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Heap allocation tagging
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup common
+ *
+ * @{
+ */
+
+#ifndef __MEM_TAG_H__
+#define __MEM_TAG_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Heap allocation tagging.
+ *
+ * Every heap allocation (malloc, calloc, realloc and therefore new, String,
+ * JSON documents, etc.) which is done inside a tagged scope, is accounted to
+ * the subsystem of the scope. The allocation is tracked until it is released,
+ * independent of which task releases it.
+ *
+ * The malloc family is hooked by the linker (--wrap), see platformio.ini.
+ * Allocations outside of any tagged scope are not tracked at all, which keeps
+ * the overhead low enough for release builds.
+ */
+namespace MemTag
+{
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Memory tag ids, which identify the subsystem a heap allocation belongs to.
+ */
+enum Id
+{
+    ID_UNTAGGED = 0,    /**< Allocation outside of any tagged scope. It is not tracked. */
+    ID_PLUGINS,         /**< Plugins */
+    ID_HTTP_CLIENT,     /**< Asynchronous HTTP client */
+    ID_JSON,            /**< JSON files */
+    ID_WEB_SERVER,      /**< Web server: REST API, websocket and plugin topics */
+    ID_LOGGING,         /**< Logging */
+    ID_COUNT            /**< Number of memory tags */
+};
+
+/**
+ * Heap statistics of a single memory tag.
+ */
+struct Statistics
+{
+    uint32_t    liveBytes;  /**< Currently allocated bytes */
+    uint32_t    peakBytes;  /**< Max. allocated bytes at the same time */
+    uint32_t    allocCount; /**< Number of allocations */
+    uint32_t    freeCount;  /**< Number of releases */
+
+    /**
+     * Initialize the statistics.
+     */
+    Statistics() :
+        liveBytes(0U),
+        peakBytes(0U),
+        allocCount(0U),
+        freeCount(0U)
+    {
+    }
+};
+
+/** Max. number of tasks which can be inside a tagged scope at the same time. */
+static const uint8_t    MAX_TAGGED_TASKS    = 8U;
+
+/** Max. number of allocations which can be tracked at the same time. Must be a power of 2. */
+static const size_t     MAX_TRACKED_ALLOCS  = 512U;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Enter a tagged scope in the context of the current task.
+ * Prefer the MemTagGuard instead of calling it directly.
+ *
+ * @param[in] id    Memory tag id of the scope
+ *
+ * @return Memory tag id of the outer scope, which is necessary to leave.
+ */
+Id enter(Id id);
+
+/**
+ * Leave a tagged scope in the context of the current task.
+ * Prefer the MemTagGuard instead of calling it directly.
+ *
+ * @param[in] outerId   Memory tag id of the outer scope, which was returned by enter().
+ */
+void leave(Id outerId);
+
+/**
+ * Get the heap statistics of a memory tag.
+ *
+ * @param[in]   id          Memory tag id
+ * @param[out]  statistics  Heap statistics
+ */
+void getStatistics(Id id, Statistics& statistics);
+
+/**
+ * Get number of allocations in tagged scopes, which couldn't be tracked,
+ * because the tracking table was full.
+ *
+ * @return Number of untracked allocations
+ */
+uint32_t getUntrackedCount();
+
+/**
+ * Get the user friendly name of a memory tag.
+ *
+ * @param[in] id    Memory tag id
+ *
+ * @return Memory tag name
+ */
+const char* idToStr(Id id);
+
+}
+
+/**
+ * The memory tag guard enters a tagged scope at creation and leaves it during
+ * destruction. Scopes can be nested, the innermost scope wins.
+ */
+class MemTagGuard
+{
+public:
+
+    /**
+     * Creates the memory tag guard and enters the tagged scope.
+     *
+     * @param[in] id    Memory tag id of the scope
+     */
+    MemTagGuard(MemTag::Id id) :
+        m_outerId(MemTag::enter(id))
+    {
+    }
+
+    /**
+     * Destroys the memory tag guard and leaves the tagged scope.
+     */
+    ~MemTagGuard()
+    {
+        MemTag::leave(m_outerId);
+    }
+
+private:
+
+    MemTag::Id  m_outerId;  /**< Memory tag id of the outer scope. */
+
+    MemTagGuard();
+    MemTagGuard(const MemTagGuard& guard);
+    MemTagGuard& operator=(const MemTagGuard& guard);
+
+};
+
+#endif  /* __MEM_TAG_H__ */
+
+/** @} */
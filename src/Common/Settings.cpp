@@ -119,6 +119,9 @@ static const char*  KEY_SCROLL_PAUSE                = "scroll_pause";
 /** NotifyURL key */
 static const char*  KEY_NOTIFY_URL                  = "notify_url";
 
+/** MQTT broker URL key */
+static const char*  KEY_MQTT_BROKER_URL             = "mqtt_broker_url";
+
 /* ---------- Key value pair names ---------- */
 
 /** Wifi network name of key value pair */
@@ -175,6 +178,9 @@ static const char*  NAME_SCROLL_PAUSE               = "Text scroll pause [ms]";
 /** NotifyURL name */
 static const char*  NAME_NOTIFY_URL                 = "URL to be triggered when PIXELIX has connected to a remote network.";
 
+/** MQTT broker URL name */
+static const char*  NAME_MQTT_BROKER_URL            = "MQTT broker URL (mqtt://[user:password@]host[:port]), empty to disable MQTT.";
+
 /* ---------- Default values ---------- */
 
 /** Wifi network default value */
@@ -231,6 +237,9 @@ static uint32_t         DEFAULT_SCROLL_PAUSE            = 80U;
 /** NotifyURL default value */
 static const char*     DEFAULT_NOTIFY_URL               = "";
 
+/** MQTT broker URL default value */
+static const char*      DEFAULT_MQTT_BROKER_URL         = "";
+
 /* ---------- Minimum values ---------- */
 
 /** Wifi network SSID min. length. Section 7.3.2.1 of the 802.11-2007 specification. */
@@ -286,6 +295,9 @@ static uint32_t         MIN_VALUE_SCROLL_PAUSE          = 20U;
 /** NotifyURL min. length */
 static const size_t     MIN_VALUE_NOTIFY_URL            = 0U;
 
+/** MQTT broker URL min. length */
+static const size_t     MIN_VALUE_MQTT_BROKER_URL       = 0U;
+
 /* ---------- Maximum values ---------- */
 
 /** Wifi network SSID max. length. Section 7.3.2.1 of the 802.11-2007 specification. */
@@ -350,6 +362,9 @@ static uint32_t         MAX_VALUE_SCROLL_PAUSE          = 500U;
 /** NotifyURL max. length */
 static const size_t     MAX_VALUE_NOTIFY_URL            = 64U;
 
+/** MQTT broker URL max. length */
+static const size_t     MAX_VALUE_MQTT_BROKER_URL       = 128U;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -431,7 +446,8 @@ Settings::Settings() :
     m_maxSlots              (m_preferences, KEY_MAX_SLOTS,              NAME_MAX_SLOTS,             DEFAULT_MAX_SLOTS,              MIN_MAX_SLOTS,                  MAX_MAX_SLOTS),
     m_slotConfig            (m_preferences, KEY_SLOT_CONFIG,            NAME_SLOT_CONFIG,           DEFAULT_SLOT_CONFIG,            MIN_VALUE_SLOT_CONFIG,          MAX_VALUE_SLOT_CONFIG),
     m_scrollPause           (m_preferences, KEY_SCROLL_PAUSE,           NAME_SCROLL_PAUSE,          DEFAULT_SCROLL_PAUSE,           MIN_VALUE_SCROLL_PAUSE,         MAX_VALUE_SCROLL_PAUSE),
-    m_notifyURL             (m_preferences, KEY_NOTIFY_URL,             NAME_NOTIFY_URL,            DEFAULT_NOTIFY_URL,             MIN_VALUE_NOTIFY_URL,           MAX_VALUE_NOTIFY_URL)
+    m_notifyURL             (m_preferences, KEY_NOTIFY_URL,             NAME_NOTIFY_URL,            DEFAULT_NOTIFY_URL,             MIN_VALUE_NOTIFY_URL,           MAX_VALUE_NOTIFY_URL),
+    m_mqttBrokerUrl         (m_preferences, KEY_MQTT_BROKER_URL,        NAME_MQTT_BROKER_URL,       DEFAULT_MQTT_BROKER_URL,        MIN_VALUE_MQTT_BROKER_URL,      MAX_VALUE_MQTT_BROKER_URL,      true)
 {
     uint8_t idx = 0;
 
@@ -470,6 +486,8 @@ Settings::Settings() :
     m_keyValueList[idx] = &m_scrollPause;
     ++idx;
     m_keyValueList[idx] = &m_notifyURL;
+    ++idx;
+    m_keyValueList[idx] = &m_mqttBrokerUrl;
 }
 
 Settings::~Settings()
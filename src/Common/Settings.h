@@ -275,6 +275,17 @@ public:
     {
         return m_notifyURL;
     }
+
+    /**
+     * Get MQTT broker URL.
+     *
+     * @return Key value pair
+     */
+    KeyValueString& getMqttBrokerUrl()
+    {
+        return m_mqttBrokerUrl;
+    }
+
     /**
      * Get a list of all key value pairs.
      *
@@ -305,7 +316,7 @@ public:
     KeyValue* getSettingByKey(const char* key);
 
     /** Number of key value pairs. */
-    static const uint8_t KEY_VALUE_PAIR_NUM = 18U;
+    static const uint8_t KEY_VALUE_PAIR_NUM = 19U;
 
 private:
 
@@ -330,6 +341,7 @@ private:
     KeyValueJson    m_slotConfig;           /**< Display slot configuration */
     KeyValueUInt32  m_scrollPause;          /**< Text scroll pause */
     KeyValueString  m_notifyURL;            /**< URL to be triggered when PIXELIX has connected to a remote network. */
+    KeyValueString  m_mqttBrokerUrl;        /**< MQTT broker URL */
 
     /**
      * Constructs the settings instance.
@@ -63,7 +63,8 @@
 void TaskMon::process()
 {
 #if configUSE_TRACE_FACILITY
-    bool isProcessingTime = false;
+    bool isProcessingTime   = false;
+    bool isSamplingTime     = false;
 
     if (false == m_timer.isTimerRunning())
     {
@@ -76,66 +77,37 @@ void TaskMon::process()
         m_timer.restart();
     }
 
-    if (true == isProcessingTime)
+    if (false == m_samplingTimer.isTimerRunning())
+    {
+        m_samplingTimer.start(SAMPLING_CYCLE);
+        isSamplingTime = true;
+    }
+    else if (true == m_samplingTimer.isTimeout())
+    {
+        isSamplingTime = true;
+        m_samplingTimer.restart();
+    }
+
+    if ((true == isProcessingTime) ||
+        (true == isSamplingTime))
     {
         UBaseType_t     numOfTasks      = uxTaskGetNumberOfTasks();
         TaskStatus_t*   taskStatus      = new(std::nothrow) TaskStatus_t[numOfTasks];
 
         if (nullptr != taskStatus)
         {
-            uint32_t    totalRunTime    = 0U;
-            UBaseType_t index           = 0U;
-            size_t      taskNameMaxLen  = 0U;
-            size_t      taskStateMaxLen = 0U;
+            uint32_t totalRunTime = 0U;
 
             numOfTasks = uxTaskGetSystemState(taskStatus, numOfTasks, &totalRunTime);
 
-            /* Determine the length of the longest task name and the longest task state name. */
-            for(index = 0U; index < numOfTasks; ++index)
+            if (true == isSamplingTime)
             {
-                size_t taskNameLen  = strlen(taskStatus[index].pcTaskName);
-                size_t taskStateLen = taskState2Str(taskStatus[index].eCurrentState).length();
-
-                if (taskNameMaxLen < taskNameLen)
-                {
-                    taskNameMaxLen = taskNameLen;
-                }
-
-                if (taskStateMaxLen < taskStateLen)
-                {
-                    taskStateMaxLen = taskStateLen;
-                }
+                addSample(taskStatus, numOfTasks, totalRunTime);
             }
 
-            /* Show task informations */
-            for(index = 0U; index < numOfTasks; ++index)
+            if (true == isProcessingTime)
             {
-                uint32_t statsAsPercentage = 0U;
-
-                /* Calculate task load in percent, if total run time is available.
-                 * Note, this depends on how FreeRTOS is configured.
-                 */
-                if (0U < totalRunTime)
-                {
-                    statsAsPercentage = taskStatus[index].ulRunTimeCounter / (totalRunTime / 100U);
-                }
-
-#if configTASKLIST_INCLUDE_COREID
-                LOG_DEBUG("Task \"%s\": c %d, p %2u, %s, %3u%%, stack high water mark: %u",
-                    taskStatus[index].xCoreID,
-                    fillUpSpaces(taskStatus[index].pcTaskName, taskNameMaxLen).c_str(),
-                    taskStatus[index].uxCurrentPriority,
-                    fillUpSpaces(taskState2Str(taskStatus[index].eCurrentState).c_str(), taskStateMaxLen).c_str(),
-                    statsAsPercentage,
-                    taskStatus[index].usStackHighWaterMark);
-    #else
-                LOG_DEBUG("Task \"%s\": p %2u, %s, %3u%%, stack high water mark: %u",
-                    fillUpSpaces(taskStatus[index].pcTaskName, taskNameMaxLen).c_str(),
-                    taskStatus[index].uxCurrentPriority,
-                    fillUpSpaces(taskState2Str(taskStatus[index].eCurrentState).c_str(), taskStateMaxLen).c_str(),
-                    statsAsPercentage,
-                    taskStatus[index].usStackHighWaterMark);
-#endif
+                logTasks(taskStatus, numOfTasks, totalRunTime);
             }
 
             delete[] taskStatus;
@@ -144,6 +116,75 @@ void TaskMon::process()
 #endif  /* configUSE_TRACE_FACILITY */
 }
 
+uint8_t TaskMon::getLatestSamples(Sample* samples, uint8_t maxCnt)
+{
+    uint8_t             cnt     = 0U;
+    uint8_t             idx     = 0U;
+    MutexGuard<Mutex>   guard(m_mutex);
+
+    if (nullptr != samples)
+    {
+        if (maxCnt < m_historyCnt)
+        {
+            idx = m_historyCnt - maxCnt;
+        }
+
+        while(m_historyCnt > idx)
+        {
+            samples[cnt] = getSample(idx);
+            ++cnt;
+            ++idx;
+        }
+    }
+
+    return cnt;
+}
+
+uint8_t TaskMon::getSamplesSince(uint32_t since, Sample* samples, uint8_t maxCnt)
+{
+    uint8_t             cnt     = 0U;
+    uint8_t             idx     = 0U;
+    MutexGuard<Mutex>   guard(m_mutex);
+
+    if (nullptr != samples)
+    {
+        while((m_historyCnt > idx) &&
+              (maxCnt > cnt))
+        {
+            const Sample& sample = getSample(idx);
+
+            if (since <= sample.seqNum)
+            {
+                samples[cnt] = sample;
+                ++cnt;
+            }
+
+            ++idx;
+        }
+    }
+
+    return cnt;
+}
+
+bool TaskMon::getTaskName(uint16_t taskNumber, String& name)
+{
+    bool                isSuccessful    = false;
+    MutexGuard<Mutex>   guard(m_mutex);
+    uint8_t             idx             = 0U;
+
+    for(idx = 0U; idx < m_lastRunTimesCnt; ++idx)
+    {
+        if (taskNumber == m_lastRunTimes[idx].taskNumber)
+        {
+            name            = m_lastRunTimes[idx].name;
+            isSuccessful    = true;
+            break;
+        }
+    }
+
+    return isSuccessful;
+}
+
 String TaskMon::taskState2Str(eTaskState state)
 {
     String name;
@@ -208,6 +249,140 @@ String TaskMon::fillUpSpaces(const char* str, size_t len)
  * Private Methods
  *****************************************************************************/
 
+#if configUSE_TRACE_FACILITY
+
+void TaskMon::logTasks(const TaskStatus_t* taskStatus, UBaseType_t numOfTasks, uint32_t totalRunTime)
+{
+    UBaseType_t index           = 0U;
+    size_t      taskNameMaxLen  = 0U;
+    size_t      taskStateMaxLen = 0U;
+
+    /* Determine the length of the longest task name and the longest task state name. */
+    for(index = 0U; index < numOfTasks; ++index)
+    {
+        size_t taskNameLen  = strlen(taskStatus[index].pcTaskName);
+        size_t taskStateLen = taskState2Str(taskStatus[index].eCurrentState).length();
+
+        if (taskNameMaxLen < taskNameLen)
+        {
+            taskNameMaxLen = taskNameLen;
+        }
+
+        if (taskStateMaxLen < taskStateLen)
+        {
+            taskStateMaxLen = taskStateLen;
+        }
+    }
+
+    /* Show task informations */
+    for(index = 0U; index < numOfTasks; ++index)
+    {
+        uint32_t statsAsPercentage = 0U;
+
+        /* Calculate task load in percent, if total run time is available.
+         * Note, this depends on how FreeRTOS is configured.
+         */
+        if (100U <= totalRunTime)
+        {
+            statsAsPercentage = taskStatus[index].ulRunTimeCounter / (totalRunTime / 100U);
+        }
+
+#if configTASKLIST_INCLUDE_COREID
+        LOG_DEBUG("Task \"%s\": c %d, p %2u, %s, %3u%%, stack high water mark: %u",
+            fillUpSpaces(taskStatus[index].pcTaskName, taskNameMaxLen).c_str(),
+            taskStatus[index].xCoreID,
+            taskStatus[index].uxCurrentPriority,
+            fillUpSpaces(taskState2Str(taskStatus[index].eCurrentState).c_str(), taskStateMaxLen).c_str(),
+            statsAsPercentage,
+            taskStatus[index].usStackHighWaterMark);
+#else
+        LOG_DEBUG("Task \"%s\": p %2u, %s, %3u%%, stack high water mark: %u",
+            fillUpSpaces(taskStatus[index].pcTaskName, taskNameMaxLen).c_str(),
+            taskStatus[index].uxCurrentPriority,
+            fillUpSpaces(taskState2Str(taskStatus[index].eCurrentState).c_str(), taskStateMaxLen).c_str(),
+            statsAsPercentage,
+            taskStatus[index].usStackHighWaterMark);
+#endif
+    }
+}
+
+void TaskMon::addSample(const TaskStatus_t* taskStatus, UBaseType_t numOfTasks, uint32_t totalRunTime)
+{
+    MutexGuard<Mutex>   guard(m_mutex);
+    TaskRunTime         runTimes[MAX_TASKS];
+    uint8_t             runTimesCnt         = 0U;
+    Sample&             sample              = m_history[m_historyWrIdx];
+    bool                isFirstSample       = (0U == m_lastTotalRunTime);
+    UBaseType_t         index               = 0U;
+
+    if (MAX_TASKS < numOfTasks)
+    {
+        numOfTasks = MAX_TASKS;
+    }
+
+    sample.seqNum       = m_seqNum;
+    sample.timestamp    = millis();
+    sample.totalRunTime = totalRunTime - m_lastTotalRunTime; /* Overflow is handled by unsigned arithmetic. */
+    sample.taskCount    = 0U;
+
+    for(index = 0U; index < numOfTasks; ++index)
+    {
+        const TaskStatus_t& status      = taskStatus[index];
+        TaskInfo&           taskInfo    = sample.tasks[sample.taskCount];
+        uint32_t            lastCounter = 0U;
+        uint8_t             lastIdx     = 0U;
+
+        /* Tasks which are created after the last sample, start with 0. */
+        for(lastIdx = 0U; lastIdx < m_lastRunTimesCnt; ++lastIdx)
+        {
+            if (static_cast<uint16_t>(status.xTaskNumber) == m_lastRunTimes[lastIdx].taskNumber)
+            {
+                lastCounter = m_lastRunTimes[lastIdx].runTimeCounter;
+                break;
+            }
+        }
+
+        taskInfo.runTime        = status.ulRunTimeCounter - lastCounter;
+        taskInfo.taskNumber     = static_cast<uint16_t>(status.xTaskNumber);
+        taskInfo.stackHeadroom  = static_cast<uint16_t>(status.usStackHighWaterMark);
+        taskInfo.priority       = static_cast<uint8_t>(status.uxCurrentPriority);
+#if configTASKLIST_INCLUDE_COREID
+        taskInfo.core           = (tskNO_AFFINITY == status.xCoreID) ? -1 : static_cast<int8_t>(status.xCoreID);
+#else
+        taskInfo.core           = -1;
+#endif
+        ++sample.taskCount;
+
+        runTimes[runTimesCnt].taskNumber        = taskInfo.taskNumber;
+        runTimes[runTimesCnt].runTimeCounter    = status.ulRunTimeCounter;
+        (void)strncpy(runTimes[runTimesCnt].name, status.pcTaskName, sizeof(runTimes[runTimesCnt].name) - 1U);
+        runTimes[runTimesCnt].name[sizeof(runTimes[runTimesCnt].name) - 1U] = '\0';
+        ++runTimesCnt;
+    }
+
+    /* Only the tasks of the current sample are required as reference for the next one. */
+    for(index = 0U; index < runTimesCnt; ++index)
+    {
+        m_lastRunTimes[index] = runTimes[index];
+    }
+    m_lastRunTimesCnt   = runTimesCnt;
+    m_lastTotalRunTime  = totalRunTime;
+
+    /* The first sample contains the run time since the task creation, which is skipped. */
+    if (false == isFirstSample)
+    {
+        m_historyWrIdx = (m_historyWrIdx + 1U) % HISTORY_SIZE;
+        ++m_seqNum;
+
+        if (HISTORY_SIZE > m_historyCnt)
+        {
+            ++m_historyCnt;
+        }
+    }
+}
+
+#endif  /* configUSE_TRACE_FACILITY */
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
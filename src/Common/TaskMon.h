@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include <SysMsgPlugin.h>
 #include <WString.h>
+#include <Mutex.hpp>
 
 /******************************************************************************
  * Macros
@@ -57,11 +58,45 @@
 
 /**
  * Task monitor
+ *
+ * Besides the periodic log output, it samples the task run time statistics
+ * continuously and keeps them in a history. This allows to see how the tasks
+ * share the cores over the last minutes.
  */
 class TaskMon
 {
 public:
 
+    /** Max. number of tasks, which are considered per sample. */
+    static const uint8_t    MAX_TASKS           = 24U;
+
+    /** Max. number of samples in the history. */
+    static const uint8_t    HISTORY_SIZE        = 30U;
+
+    /**
+     * Statistics of a single task, determined in a sample.
+     */
+    struct TaskInfo
+    {
+        uint32_t    runTime;        /**< Run time since the previous sample in run time counter ticks (us). */
+        uint16_t    taskNumber;     /**< Unique task number, assigned by FreeRTOS. */
+        uint16_t    stackHeadroom;  /**< Min. free stack since task creation in bytes (stack high water mark). */
+        uint8_t     priority;       /**< Current task priority */
+        int8_t      core;           /**< Core the task is pinned to, -1 means no affinity. */
+    };
+
+    /**
+     * A single sample with the statistics of all tasks.
+     */
+    struct Sample
+    {
+        uint32_t    seqNum;             /**< Sequence number, increases with every sample. */
+        uint32_t    timestamp;          /**< Timestamp in ms */
+        uint32_t    totalRunTime;       /**< Elapsed run time counter ticks (us) since the previous sample. */
+        uint8_t     taskCount;          /**< Number of valid task statistics. */
+        TaskInfo    tasks[MAX_TASKS];   /**< Task statistics */
+    };
+
     /**
      * Get task monitor instance.
      *
@@ -79,18 +114,86 @@ public:
      */
     void process();
 
+    /**
+     * Get a copy of the latest samples from the history.
+     * All samples are copied at once, so they are consistent to each other.
+     *
+     * @param[out]  samples Sample buffer, ordered from old to new.
+     * @param[in]   maxCnt  Max. number of samples, which fit into the buffer.
+     *
+     * @return Number of copied samples
+     */
+    uint8_t getLatestSamples(Sample* samples, uint8_t maxCnt);
+
+    /**
+     * Get a copy of the oldest samples from the history, starting with the
+     * given sequence number.
+     * All samples are copied at once, so they are consistent to each other.
+     *
+     * @param[in]   since   Sequence number of the first sample
+     * @param[out]  samples Sample buffer, ordered from old to new.
+     * @param[in]   maxCnt  Max. number of samples, which fit into the buffer.
+     *
+     * @return Number of copied samples
+     */
+    uint8_t getSamplesSince(uint32_t since, Sample* samples, uint8_t maxCnt);
+
+    /**
+     * Get the name of a task by its task number.
+     * Only tasks of the latest sample are known.
+     *
+     * @param[in]   taskNumber  Unique task number
+     * @param[out]  name        Task name
+     *
+     * @return If task is known, it will return true otherwise false.
+     */
+    bool getTaskName(uint16_t taskNumber, String& name);
+
     /** Processing cycle in ms. */
     static const uint32_t PROCESSING_CYCLE  = 60U * 1000U;
 
+    /** Sampling cycle in ms. Together with the history size it defines the observed period. */
+    static const uint32_t SAMPLING_CYCLE    = 10U * 1000U;
+
 private:
 
-    SimpleTimer m_timer;    /**< Timer used for cyclic processing. */
+    /**
+     * Run time counter of a task, sampled last time.
+     */
+    struct TaskRunTime
+    {
+        uint16_t    taskNumber;                         /**< Unique task number */
+        uint32_t    runTimeCounter;                     /**< Absolute run time counter */
+        char        name[configMAX_TASK_NAME_LEN];      /**< Task name */
+    };
+
+    SimpleTimer m_timer;                        /**< Timer used for cyclic processing. */
+    SimpleTimer m_samplingTimer;                /**< Timer used for cyclic sampling. */
+    Mutex       m_mutex;                        /**< Protects the history and the task names. */
+    Sample      m_history[HISTORY_SIZE];        /**< Sample history as ring buffer */
+    uint8_t     m_historyWrIdx;                 /**< Write index of the history */
+    uint8_t     m_historyCnt;                   /**< Number of samples in the history */
+    uint32_t    m_seqNum;                       /**< Sequence number of the next sample */
+    TaskRunTime m_lastRunTimes[MAX_TASKS];      /**< Run time counters of the last sample */
+    uint8_t     m_lastRunTimesCnt;              /**< Number of valid run time counters */
+    uint32_t    m_lastTotalRunTime;             /**< Total run time counter of the last sample */
 
     /**
      * Constructs the task monitor.
      */
-    TaskMon()
+    TaskMon() :
+        m_timer(),
+        m_samplingTimer(),
+        m_mutex(),
+        m_history(),
+        m_historyWrIdx(0U),
+        m_historyCnt(0U),
+        m_seqNum(0U),
+        m_lastRunTimes(),
+        m_lastRunTimesCnt(0U),
+        m_lastTotalRunTime(0U)
     {
+        (void)m_mutex.create();
     }
 
     /**
@@ -104,6 +207,30 @@ private:
     TaskMon(const TaskMon& taskMon);
     TaskMon& operator=(const TaskMon& taskMon);
 
+#if configUSE_TRACE_FACILITY
+
+    /**
+     * Show the task informations via log output.
+     *
+     * @param[in] taskStatus    Task status array
+     * @param[in] numOfTasks    Number of elements in the task status array
+     * @param[in] totalRunTime  Total run time counter
+     */
+    void logTasks(const TaskStatus_t* taskStatus, UBaseType_t numOfTasks, uint32_t totalRunTime);
+
+    /**
+     * Add a sample to the history. The run time of each task is calculated
+     * as difference to the last sample. The very first sample is only used
+     * as reference.
+     *
+     * @param[in] taskStatus    Task status array
+     * @param[in] numOfTasks    Number of elements in the task status array
+     * @param[in] totalRunTime  Total run time counter
+     */
+    void addSample(const TaskStatus_t* taskStatus, UBaseType_t numOfTasks, uint32_t totalRunTime);
+
+#endif  /* configUSE_TRACE_FACILITY */
+
     /**
      * Get task state as user friendly string.
      *
@@ -120,6 +247,19 @@ private:
      * @return Filled up string
      */
     String fillUpSpaces(const char* str, size_t len);
+
+    /**
+     * Get a sample from the history.
+     * The mutex must be taken by the caller.
+     *
+     * @param[in] idx   Sample index, 0 is the oldest one.
+     *
+     * @return Sample
+     */
+    const Sample& getSample(uint8_t idx) const
+    {
+        return m_history[(m_historyWrIdx + HISTORY_SIZE - m_historyCnt + idx) % HISTORY_SIZE];
+    }
 };
 
 /******************************************************************************
@@ -128,4 +268,4 @@ private:
 
 #endif  /* __TASK_MON_H__ */
 
-/** @} */
\ No newline at end of file
+/** @} */
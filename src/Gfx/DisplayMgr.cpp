@@ -36,11 +36,14 @@
 #include "Settings.h"
 #include "BrightnessCtrl.h"
 #include "PluginMgr.h"
+#include "MemTag.h"
 
 #include <Display.h>
 #include <Logging.h>
 #include <ArduinoJson.h>
 #include <Util.h>
+#include <TraceRecorder.h>
+#include <new>
 
 #if (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS)
 #include <StatisticValue.hpp>
@@ -183,6 +186,24 @@ bool DisplayMgr::begin()
             }
         }
 
+        if (false == m_mutexFrame.isAllocated())
+        {
+            if (false == m_mutexFrame.create())
+            {
+                isError = true;
+            }
+        }
+
+        if (nullptr == m_frameEvents)
+        {
+            m_frameEvents = xEventGroupCreate();
+
+            if (nullptr == m_frameEvents)
+            {
+                isError = true;
+            }
+        }
+
         /* Process task not started yet? */
         if ((false == isError) &&
             (nullptr == m_processTaskHandle))
@@ -238,6 +259,22 @@ void DisplayMgr::end()
     m_mutexUpdate.destroy();
     m_mutexInterf.destroy();
 
+    if (nullptr != m_frameEvents)
+    {
+        vEventGroupDelete(m_frameEvents);
+        m_frameEvents = nullptr;
+    }
+
+    /* Release the published frames. Subscribers, which still hold one, keep it alive. */
+    {
+        MutexGuard<Mutex> guard(m_mutexFrame);
+
+        for(idx = 0U; idx < FRAME_COUNT; ++idx)
+        {
+            m_frames[idx].reset();
+        }
+    }
+
     m_selectedFrameBuffer = nullptr;
 
     /* Release framebuffer memory. */
@@ -725,6 +762,102 @@ void DisplayMgr::setNetworkStatus(bool isConnected)
     m_isNetworkConnected = isConnected;
 }
 
+bool DisplayMgr::waitForFrameDone(uint32_t timeout) const
+{
+    bool isFrameDone = false;
+
+    /* The frame done event is only set by the update task. */
+    if ((nullptr != m_updateTaskHandle) &&
+        (nullptr != m_frameEvents))
+    {
+        EventBits_t bits = 0U;
+
+        /* Wait for the next frame and not for a already sent one. */
+        (void)xEventGroupClearBits(m_frameEvents, EVT_FRAME_DONE);
+        bits = xEventGroupWaitBits(m_frameEvents, EVT_FRAME_DONE, pdFALSE, pdTRUE, pdMS_TO_TICKS(timeout));
+
+        if (0U != (bits & EVT_FRAME_DONE))
+        {
+            isFrameDone = true;
+        }
+    }
+
+    return isFrameDone;
+}
+
+void DisplayMgr::subscribeFrames()
+{
+    MutexGuard<Mutex> guard(m_mutexFrame);
+
+    /* First subscriber? */
+    if (0U == m_frameSubscribers)
+    {
+        IDisplay&   display = Display::getInstance();
+        uint8_t     idx     = 0U;
+
+        for(idx = 0U; idx < FRAME_COUNT; ++idx)
+        {
+            m_frames[idx].reset(new(std::nothrow) Frame());
+
+            if (nullptr != m_frames[idx])
+            {
+                m_frames[idx]->seqNo    = 0U;
+                m_frames[idx]->slotId   = SlotList::SLOT_ID_INVALID;
+
+                if (false == m_frames[idx]->bitmap.create(display.getWidth(), display.getHeight()))
+                {
+                    m_frames[idx].reset();
+                }
+            }
+        }
+    }
+
+    if (UINT8_MAX > m_frameSubscribers)
+    {
+        ++m_frameSubscribers;
+    }
+
+    return;
+}
+
+void DisplayMgr::unsubscribeFrames()
+{
+    MutexGuard<Mutex> guard(m_mutexFrame);
+
+    if (0U < m_frameSubscribers)
+    {
+        --m_frameSubscribers;
+
+        /* Release the frames after the last subscriber is gone. Subscribers, which still hold one, keep it alive. */
+        if (0U == m_frameSubscribers)
+        {
+            uint8_t idx = 0U;
+
+            for(idx = 0U; idx < FRAME_COUNT; ++idx)
+            {
+                m_frames[idx].reset();
+            }
+        }
+    }
+
+    return;
+}
+
+DisplayMgr::FramePtr DisplayMgr::getFrame() const
+{
+    MutexGuard<Mutex>   guard(m_mutexFrame);
+    FramePtr            frame   = m_frames[m_frameIdx];
+
+    /* Not published yet? */
+    if ((nullptr != frame) &&
+        (0U == frame->seqNo))
+    {
+        frame.reset();
+    }
+
+    return frame;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -742,6 +875,7 @@ DisplayMgr::DisplayMgr() :
     m_updateTaskHandle(nullptr),
     m_updateTaskExit(false),
     m_updateTaskSemaphore(nullptr),
+    m_frameEvents(nullptr),
     m_slotList(),
     m_selectedSlotId(SlotList::SLOT_ID_INVALID),
     m_selectedPlugin(nullptr),
@@ -756,7 +890,12 @@ DisplayMgr::DisplayMgr() :
     m_fadeEffect(&m_fadeLinearEffect),
     m_fadeEffectIndex(FADE_EFFECT_LINEAR),
     m_fadeEffectUpdate(false),
-    m_isNetworkConnected(false)
+    m_isNetworkConnected(false),
+    m_maxFramePeriod(0U),
+    m_frameSubscribers(0U),
+    m_frameSeqNo(0U),
+    m_frames(),
+    m_frameIdx(0U)
 {
 }
 
@@ -854,6 +993,8 @@ void DisplayMgr::fadeInOut(YAGfx& dst)
         /* Continuously update the current canvas with its framebuffer. */
         if (nullptr != m_selectedPlugin)
         {
+            TRACE_SCOPE("Plugin::update", m_selectedPlugin->getUID());
+
             m_selectedPlugin->update(*m_selectedFrameBuffer);
         }
 
@@ -867,18 +1008,22 @@ void DisplayMgr::fadeInOut(YAGfx& dst)
 
         /* Fade new display content in */
         case FADE_IN:
+            TRACE_BEGIN("FadeEffect::fadeIn", 0);
             if (true == m_fadeEffect->fadeIn(dst, *prevFb, *m_selectedFrameBuffer))
             {
                 m_displayFadeState = FADE_IDLE;
             }
+            TRACE_END("FadeEffect::fadeIn");
             break;
 
         /* Fade old display content out! */
         case FADE_OUT:
+            TRACE_BEGIN("FadeEffect::fadeOut", 0);
             if (true == m_fadeEffect->fadeOut(dst, *prevFb, *m_selectedFrameBuffer))
             {
                 m_displayFadeState = FADE_IN;
             }
+            TRACE_END("FadeEffect::fadeOut");
             break;
 
         default:
@@ -896,6 +1041,8 @@ void DisplayMgr::process()
     uint8_t                     stickySlot  = SlotList::SLOT_ID_INVALID;
     MutexGuard<MutexRecursive>  guardInterf(m_mutexInterf);
 
+    TRACE_SCOPE("DisplayMgr::process", 0);
+
     /* Handle display brightness */
     BrightnessCtrl::getInstance().process();
 
@@ -1110,6 +1257,10 @@ void DisplayMgr::process()
 
         if (nullptr != plugin)
         {
+            MemTagGuard memTagGuard(MemTag::ID_PLUGINS);
+
+            TRACE_SCOPE("Plugin::process", plugin->getUID());
+
             plugin->process(m_isNetworkConnected);
         }
     }
@@ -1121,6 +1272,9 @@ void DisplayMgr::update()
 {
     IDisplay&                   display = Display::getInstance();
     MutexGuard<MutexRecursive>  guard(m_mutexUpdate);
+    MemTagGuard                 memTagGuard(MemTag::ID_PLUGINS);
+
+    TRACE_SCOPE("DisplayMgr::update", 0);
 
     /* Update display (main canvas available) */
     if (nullptr != m_selectedFrameBuffer)
@@ -1130,7 +1284,9 @@ void DisplayMgr::update()
     /* Update display (main canvas not available) */
     else if (nullptr != m_selectedPlugin)
     {
+        TRACE_BEGIN("Plugin::update", m_selectedPlugin->getUID());
         m_selectedPlugin->update(display);
+        TRACE_END("Plugin::update");
     }
     /* No plugin selected. */
     else
@@ -1139,7 +1295,9 @@ void DisplayMgr::update()
         ;
     }
 
+    TRACE_BEGIN("Display::show", 0);
     display.show();
+    TRACE_END("Display::show");
 
     return;
 }
@@ -1272,6 +1430,55 @@ void DisplayMgr::destroyUpdateTask()
     return;
 }
 
+void DisplayMgr::publishFrame()
+{
+    /* Any subscriber? */
+    if (0U < m_frameSubscribers)
+    {
+        std::shared_ptr<Frame>  frame;
+        uint8_t                 nextIdx = 0U;
+
+        {
+            MutexGuard<Mutex> guard(m_mutexFrame);
+
+            nextIdx = (m_frameIdx + 1U) % FRAME_COUNT;
+            frame   = m_frames[nextIdx];
+        }
+
+        /* Only the published frame can be taken by a subscriber. Therefore
+         * the next frame can be reused, if no subscriber holds it anymore.
+         * Besides the frame list, the local reference is the only one then.
+         */
+        if ((nullptr != frame) &&
+            (2 == frame.use_count()))
+        {
+            Display::getInstance().copyTo(frame->bitmap);
+
+            /* The sequence number 0 is reserved for not published frames. */
+            ++m_frameSeqNo;
+            if (0U == m_frameSeqNo)
+            {
+                ++m_frameSeqNo;
+            }
+
+            frame->seqNo    = m_frameSeqNo;
+            frame->slotId   = m_selectedSlotId;
+
+            {
+                MutexGuard<Mutex> guard(m_mutexFrame);
+
+                /* Frames not released meanwhile by the last subscriber? */
+                if (frame == m_frames[nextIdx])
+                {
+                    m_frameIdx = nextIdx;
+                }
+            }
+        }
+    }
+
+    return;
+}
+
 void DisplayMgr::processTask(void* parameters)
 {
     DisplayMgr* tthis = reinterpret_cast<DisplayMgr*>(parameters);
@@ -1328,6 +1535,8 @@ void DisplayMgr::updateTask(void* parameters)
 
 #endif /* (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS) */
 
+        uint32_t timestampLastFrame = millis();
+
         (void)xSemaphoreTake(tthis->m_updateTaskSemaphore, portMAX_DELAY);
 
         while(false == tthis->m_updateTaskExit)
@@ -1338,6 +1547,13 @@ void DisplayMgr::updateTask(void* parameters)
             uint32_t    durationPhyUpdate   = 0U;
             bool        abort               = false;
 
+            /* Observe the frame period, which shows display stalls. */
+            if (tthis->m_maxFramePeriod < (timestamp - timestampLastFrame))
+            {
+                tthis->m_maxFramePeriod = timestamp - timestampLastFrame;
+            }
+            timestampLastFrame = timestamp;
+
             /* Observe the physical display refresh and limit the duration to 70% of refresh period. */
             const uint32_t  MAX_LOOP_TIME   = (UPDATE_TASK_PERIOD * 7U) / (10U);
 
@@ -1352,6 +1568,7 @@ void DisplayMgr::updateTask(void* parameters)
              * and artifacts on the display, because of e.g. webserver flash
              * access.
              */
+            TRACE_BEGIN("Display::isReady", 0);
             timestampPhyUpdate = millis();
             while((false == Display::getInstance().isReady()) && (false == abort))
             {
@@ -1362,6 +1579,13 @@ void DisplayMgr::updateTask(void* parameters)
                     abort = true;
                 }
             }
+            TRACE_END("Display::isReady");
+
+            /* Frame is sent, signal the window until the next physical update. */
+            (void)xEventGroupSetBits(tthis->m_frameEvents, EVT_FRAME_DONE);
+
+            /* Provide the completed frame to the subscribers. */
+            tthis->publishFrame();
 
 #if (0 != CONFIG_DISPLAY_MGR_ENABLE_STATISTICS)
             statistics.displayUpdate.update(durationPhyUpdate);
@@ -44,6 +44,9 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
+#include <memory>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
 #include <Board.h>
 #include <TextWidget.h>
 #include <SimpleTimer.hpp>
@@ -73,6 +76,19 @@ class DisplayMgr
 {
 public:
 
+    /**
+     * A copy of a frame, which was completely sent to the physical display.
+     */
+    struct Frame
+    {
+        uint32_t            seqNo;  /**< Frame sequence number, incremented for every published frame. 0 if not published yet. */
+        uint8_t             slotId; /**< Id of the slot, which was shown */
+        YAGfxDynamicBitmap  bitmap; /**< Pixel colors with the display size */
+    };
+
+    /** Shared reference to a published frame, which is never changed afterwards. */
+    typedef std::shared_ptr<const Frame> FramePtr;
+
     /** Fade effects */
     enum FadeEffect
     {
@@ -324,6 +340,61 @@ public:
      */
     void setNetworkStatus(bool isConnected);
 
+    /**
+     * Wait until the next frame is completely sent to the physical display.
+     * Afterwards there is a window until the next physical display update,
+     * which can be used for long flash write cycles without causing
+     * display artifacts.
+     *
+     * @param[in] timeout   Max. time to wait in ms
+     *
+     * @return If a frame was sent, it will return true. If the display update task is not running or on timeout, it will return false.
+     */
+    bool waitForFrameDone(uint32_t timeout) const;
+
+    /**
+     * Get the max. period between two display updates, since the last reset.
+     *
+     * @return Max. frame period in ms
+     */
+    uint32_t getMaxFramePeriod() const
+    {
+        return m_maxFramePeriod;
+    }
+
+    /**
+     * Reset the max. frame period.
+     */
+    void resetMaxFramePeriod()
+    {
+        m_maxFramePeriod = 0U;
+    }
+
+    /**
+     * Subscribe to the completed frames. As long as there is at least one
+     * subscriber, the display update task publishes every completed frame
+     * once. All subscribers share the published frame.
+     *
+     * The frames are allocated by the first subscriber, because the display
+     * update task shall not allocate memory.
+     */
+    void subscribeFrames();
+
+    /**
+     * Unsubscribe from the completed frames. The last subscriber releases
+     * the frames.
+     */
+    void unsubscribeFrames();
+
+    /**
+     * Get the last published frame. The frame stays valid as long as the
+     * reference is hold. Compared to getFBCopy(), no copy is done and the
+     * slot scheduling is not blocked.
+     *
+     * @return Last published frame or nullptr if not available.
+     */
+    FramePtr getFrame() const;
+
 private:
 
     /** The process task stack size in bytes */
@@ -350,12 +421,24 @@ private:
     /** The update task priority shall be higher than the other application tasks. */
     static const UBaseType_t    UPDATE_TASK_PRIORITY    = 4U;
 
+    /**
+     * Number of frames for publishing. While one is published, the other
+     * one is filled with the next frame, if no subscriber holds it anymore.
+     */
+    static const uint8_t        FRAME_COUNT             = 2U;
+
+    /** Event bit, which is set after a frame is completely sent to the physical display. */
+    static const EventBits_t    EVT_FRAME_DONE          = (1U << 0U);
+
     /** Mutex to protect concurrent access through the public interface. */
     mutable MutexRecursive      m_mutexInterf;
 
     /** Mutex to protect the display update against concurrent access. */
     MutexRecursive              m_mutexUpdate;
 
+    /** Mutex to protect the published frame and the frame subscribers. */
+    mutable Mutex               m_mutexFrame;
+
     /** Process task handle */
     TaskHandle_t                m_processTaskHandle;
 
@@ -374,6 +457,9 @@ private:
     /** Binary semaphore used to signal the update task exited. */
     SemaphoreHandle_t           m_updateTaskSemaphore;
 
+    /** Event group, which the update task uses to signal that a frame is completely sent. */
+    EventGroupHandle_t          m_frameEvents;
+
     /** List of all slots with their connected plugins. */
     SlotList                    m_slotList;
 
@@ -419,6 +505,11 @@ private:
     FadeEffect          m_fadeEffectIndex;              /**< Fade effect index to determine the next fade effect. */
     bool                m_fadeEffectUpdate;             /**< Flag to indicate that the fadeEffect was updated. */
     bool                m_isNetworkConnected;           /**< Is a network connection established? */
+    volatile uint32_t   m_maxFramePeriod;               /**< Max. period in ms between two display updates since last reset. */
+    volatile uint8_t    m_frameSubscribers;             /**< Number of frame subscribers. */
+    uint32_t            m_frameSeqNo;                   /**< Sequence number of the last published frame. */
+    std::shared_ptr<Frame> m_frames[FRAME_COUNT];       /**< Published frame and the one, which is reused for the next frame. */
+    uint8_t             m_frameIdx;                     /**< Index of the published frame. */
 
     /**
      * Constructs the display manager.
@@ -495,6 +586,14 @@ private:
      */
     void destroyUpdateTask();
 
+    /**
+     * Publish the current display content, if there is any frame subscriber.
+     * It shall be called by the update task after the frame was sent to the
+     * physical display. If a subscriber still holds the frame, which would
+     * be reused, the current display content is skipped.
+     */
+    void publishFrame();
+
     /**
      * Display update task is responsible to refresh the display content.
      *
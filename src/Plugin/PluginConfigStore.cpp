@@ -0,0 +1,600 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin configuration store
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PluginConfigStore.h"
+#include "FileSystem.h"
+#include "JsonFile.h"
+
+#include <Logging.h>
+#include <StreamUtils.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint16_t getUInt16(const uint8_t* buffer);
+static uint32_t getUInt32(const uint8_t* buffer);
+static void setUInt16(uint8_t* buffer, uint16_t value);
+static void setUInt32(uint8_t* buffer, uint32_t value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Magic at the begin of the container file. */
+static const uint8_t    MAGIC[]         = { 'P', 'X', 'C', 'S' };
+
+/** Buffer size in bytes, used to copy configurations between files. */
+static const size_t     COPY_BUFFER_SIZE = 128U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void PluginConfigStore::begin()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    loadIndex();
+
+    return;
+}
+
+bool PluginConfigStore::load(uint16_t uid, JsonDocument& doc)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isSuccessful    = false;
+    String                      jsonFileName    = getJsonFileName(uid);
+    Entry*                      entry           = nullptr;
+
+    loadIndex();
+
+    /* A JSON configuration file e.g. from a restored backup, takes precedence. */
+    if (true == m_fs.exists(jsonFileName))
+    {
+        JsonFile jsonFile(m_fs);
+
+        if (true == jsonFile.load(jsonFileName, doc))
+        {
+            LOG_INFO("Import configuration %s.", jsonFileName.c_str());
+
+            (void)store(uid, doc, true);
+            isSuccessful = true;
+        }
+    }
+
+    if (false == isSuccessful)
+    {
+        entry = find(uid);
+    }
+
+    if (nullptr == entry)
+    {
+        ;
+    }
+    /* Pending change? */
+    else if (nullptr != entry->data)
+    {
+        if (DeserializationError::Ok == deserializeMsgPack(doc, entry->data, entry->size).code())
+        {
+            isSuccessful = true;
+        }
+    }
+    else
+    {
+        File fd = m_fs.open(FILE_NAME, "r");
+
+        if (false == fd)
+        {
+            LOG_WARNING("Failed to open %s.", FILE_NAME);
+        }
+        else
+        {
+            if (true == fd.seek(entry->offset))
+            {
+                ReadBufferingStream bufferedStream(fd, COPY_BUFFER_SIZE);
+
+                if (DeserializationError::Ok == deserializeMsgPack(doc, bufferedStream).code())
+                {
+                    isSuccessful = true;
+                }
+            }
+
+            fd.close();
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool PluginConfigStore::save(uint16_t uid, const JsonDocument& doc)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+
+    loadIndex();
+
+    return store(uid, doc, false);
+}
+
+void PluginConfigStore::remove(uint16_t uid)
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    String                      jsonFileName    = getJsonFileName(uid);
+    uint8_t                     idx             = 0U;
+
+    loadIndex();
+
+    while(idx < m_entryCnt)
+    {
+        if (uid == m_entries[idx].uid)
+        {
+            if (nullptr != m_entries[idx].data)
+            {
+                delete[] m_entries[idx].data;
+                m_entries[idx].data = nullptr;
+            }
+
+            /* Keep the entries continuous. */
+            --m_entryCnt;
+            m_entries[idx] = m_entries[m_entryCnt];
+
+            m_isDirty = true;
+            m_writeTimer.start(WRITE_DELAY);
+        }
+        else
+        {
+            ++idx;
+        }
+    }
+
+    if (true == m_fs.remove(jsonFileName))
+    {
+        LOG_INFO("File %s removed", jsonFileName.c_str());
+    }
+
+    return;
+}
+
+void PluginConfigStore::process()
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    if ((true == m_isDirty) &&
+        (true == m_writeTimer.isTimeout()))
+    {
+        m_writeTimer.stop();
+
+        if (false == flush())
+        {
+            /* Try again later. */
+            m_writeTimer.start(WRITE_DELAY);
+        }
+    }
+
+    return;
+}
+
+bool PluginConfigStore::flush()
+{
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    bool                        isSuccessful    = true;
+
+    if (true == m_isDirty)
+    {
+        uint32_t    offsets[MAX_ENTRIES];
+        uint32_t    offset      = HEADER_SIZE + m_entryCnt * INDEX_SIZE;
+        uint8_t     idx         = 0U;
+
+        for(idx = 0U; idx < m_entryCnt; ++idx)
+        {
+            offsets[idx]    = offset;
+            offset         += m_entries[idx].size;
+        }
+
+        if (false == writeTmpFile(offsets))
+        {
+            LOG_ERROR("Failed to write %s.", TMP_FILE_NAME);
+            (void)m_fs.remove(TMP_FILE_NAME);
+            isSuccessful = false;
+        }
+        /* Replacing the container by renaming is atomic. */
+        else if (false == m_fs.rename(TMP_FILE_NAME, FILE_NAME))
+        {
+            LOG_ERROR("Failed to rename %s.", TMP_FILE_NAME);
+            (void)m_fs.remove(TMP_FILE_NAME);
+            isSuccessful = false;
+        }
+        else
+        {
+            for(idx = 0U; idx < m_entryCnt; ++idx)
+            {
+                Entry& entry = m_entries[idx];
+
+                entry.offset = offsets[idx];
+
+                if (nullptr != entry.data)
+                {
+                    delete[] entry.data;
+                    entry.data = nullptr;
+                }
+
+                /* The imported JSON configuration file is now part of the container. */
+                if (true == entry.isImported)
+                {
+                    (void)m_fs.remove(getJsonFileName(entry.uid));
+                    entry.isImported = false;
+                }
+            }
+
+            m_isDirty = false;
+
+            LOG_INFO("Plugin configurations saved.");
+        }
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+PluginConfigStore::PluginConfigStore() :
+    m_fs(FILESYSTEM),
+    m_mutex(),
+    m_entries(),
+    m_entryCnt(0U),
+    m_isIndexLoaded(false),
+    m_isDirty(false),
+    m_writeTimer()
+{
+    (void)m_mutex.create();
+}
+
+void PluginConfigStore::loadIndex()
+{
+    if (false == m_isIndexLoaded)
+    {
+        File fd = m_fs.open(FILE_NAME, "r");
+
+        m_isIndexLoaded = true;
+
+        if (true == fd)
+        {
+            uint8_t     header[HEADER_SIZE];
+            uint16_t    count       = 0U;
+            size_t      fileSize    = fd.size();
+
+            if ((sizeof(header) != fd.read(header, sizeof(header))) ||
+                (0 != memcmp(header, MAGIC, sizeof(MAGIC))) ||
+                (VERSION != header[4U]))
+            {
+                LOG_ERROR("Invalid header in %s.", FILE_NAME);
+            }
+            else
+            {
+                uint16_t idx = 0U;
+
+                count = getUInt16(&header[6U]);
+
+                for(idx = 0U; (idx < count) && (MAX_ENTRIES > m_entryCnt); ++idx)
+                {
+                    uint8_t index[INDEX_SIZE];
+
+                    if (sizeof(index) != fd.read(index, sizeof(index)))
+                    {
+                        LOG_ERROR("Invalid index in %s.", FILE_NAME);
+                        break;
+                    }
+                    else
+                    {
+                        Entry& entry = m_entries[m_entryCnt];
+
+                        entry.uid           = getUInt16(&index[0U]);
+                        entry.offset        = getUInt32(&index[4U]);
+                        entry.size          = getUInt32(&index[8U]);
+                        entry.data          = nullptr;
+                        entry.isImported    = false;
+
+                        if ((fileSize < entry.offset) ||
+                            ((fileSize - entry.offset) < entry.size))
+                        {
+                            LOG_WARNING("Invalid index entry for UID %u.", entry.uid);
+                        }
+                        else
+                        {
+                            ++m_entryCnt;
+                        }
+                    }
+                }
+            }
+
+            fd.close();
+        }
+    }
+
+    return;
+}
+
+PluginConfigStore::Entry* PluginConfigStore::find(uint16_t uid)
+{
+    Entry*  entry   = nullptr;
+    uint8_t idx     = 0U;
+
+    for(idx = 0U; idx < m_entryCnt; ++idx)
+    {
+        if (uid == m_entries[idx].uid)
+        {
+            entry = &m_entries[idx];
+            break;
+        }
+    }
+
+    return entry;
+}
+
+bool PluginConfigStore::store(uint16_t uid, const JsonDocument& doc, bool isImported)
+{
+    bool    isSuccessful    = false;
+    Entry*  entry           = find(uid);
+    size_t  size            = measureMsgPack(doc);
+    uint8_t* data           = nullptr;
+
+    if ((nullptr == entry) &&
+        (MAX_ENTRIES > m_entryCnt))
+    {
+        entry = &m_entries[m_entryCnt];
+        ++m_entryCnt;
+
+        entry->uid          = uid;
+        entry->offset       = 0U;
+        entry->size         = 0U;
+        entry->data         = nullptr;
+        entry->isImported   = false;
+    }
+
+    if (nullptr == entry)
+    {
+        LOG_ERROR("No space for configuration of UID %u.", uid);
+    }
+    else
+    {
+        data = new(std::nothrow) uint8_t[size];
+
+        if (nullptr == data)
+        {
+            LOG_ERROR("Out of memory for configuration of UID %u.", uid);
+        }
+        else
+        {
+            if (nullptr != entry->data)
+            {
+                delete[] entry->data;
+            }
+
+            entry->size         = serializeMsgPack(doc, data, size);
+            entry->data         = data;
+            entry->isImported   = (true == entry->isImported) || (true == isImported);
+
+            /* Every change restarts the timer, which batches several changes. */
+            m_isDirty = true;
+            m_writeTimer.start(WRITE_DELAY);
+
+            isSuccessful = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+String PluginConfigStore::getJsonFileName(uint16_t uid) const
+{
+    return String("/configuration/") + uid + ".json";
+}
+
+bool PluginConfigStore::writeTmpFile(const uint32_t* offsets)
+{
+    bool    isSuccessful    = true;
+    File    fdOld;
+    File    fd              = m_fs.open(TMP_FILE_NAME, "w");
+    uint8_t idx             = 0U;
+
+    if (false == fd)
+    {
+        isSuccessful = false;
+    }
+    else
+    {
+        uint8_t header[HEADER_SIZE];
+
+        memcpy(header, MAGIC, sizeof(MAGIC));
+        header[4U] = VERSION;
+        header[5U] = 0U;
+        setUInt16(&header[6U], m_entryCnt);
+
+        if (sizeof(header) != fd.write(header, sizeof(header)))
+        {
+            isSuccessful = false;
+        }
+
+        for(idx = 0U; (idx < m_entryCnt) && (true == isSuccessful); ++idx)
+        {
+            uint8_t index[INDEX_SIZE];
+
+            setUInt16(&index[0U], m_entries[idx].uid);
+            setUInt16(&index[2U], 0U);
+            setUInt32(&index[4U], offsets[idx]);
+            setUInt32(&index[8U], m_entries[idx].size);
+
+            if (sizeof(index) != fd.write(index, sizeof(index)))
+            {
+                isSuccessful = false;
+            }
+        }
+
+        for(idx = 0U; (idx < m_entryCnt) && (true == isSuccessful); ++idx)
+        {
+            const Entry& entry = m_entries[idx];
+
+            if (nullptr != entry.data)
+            {
+                if (entry.size != fd.write(entry.data, entry.size))
+                {
+                    isSuccessful = false;
+                }
+            }
+            /* Unchanged configurations are copied from the current container. */
+            else
+            {
+                uint8_t     buffer[COPY_BUFFER_SIZE];
+                uint32_t    remaining   = entry.size;
+
+                if (false == fdOld)
+                {
+                    fdOld = m_fs.open(FILE_NAME, "r");
+                }
+
+                if ((false == fdOld) ||
+                    (false == fdOld.seek(entry.offset)))
+                {
+                    isSuccessful = false;
+                }
+
+                while((0U < remaining) && (true == isSuccessful))
+                {
+                    size_t len = (sizeof(buffer) < remaining) ? sizeof(buffer) : remaining;
+
+                    if ((len != fdOld.read(buffer, len)) ||
+                        (len != fd.write(buffer, len)))
+                    {
+                        isSuccessful = false;
+                    }
+
+                    remaining -= len;
+                }
+            }
+        }
+
+        if (true == fdOld)
+        {
+            fdOld.close();
+        }
+
+        fd.close();
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get 16-bit value from little endian buffer.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static uint16_t getUInt16(const uint8_t* buffer)
+{
+    return static_cast<uint16_t>(buffer[0U]) |
+           (static_cast<uint16_t>(buffer[1U]) << 8U);
+}
+
+/**
+ * Get 32-bit value from little endian buffer.
+ *
+ * @param[in] buffer    Buffer
+ *
+ * @return Value
+ */
+static uint32_t getUInt32(const uint8_t* buffer)
+{
+    return static_cast<uint32_t>(buffer[0U]) |
+           (static_cast<uint32_t>(buffer[1U]) << 8U) |
+           (static_cast<uint32_t>(buffer[2U]) << 16U) |
+           (static_cast<uint32_t>(buffer[3U]) << 24U);
+}
+
+/**
+ * Set 16-bit value in little endian buffer.
+ *
+ * @param[out]  buffer  Buffer
+ * @param[in]   value   Value
+ */
+static void setUInt16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0U] = static_cast<uint8_t>(value & 0xffU);
+    buffer[1U] = static_cast<uint8_t>((value >> 8U) & 0xffU);
+
+    return;
+}
+
+/**
+ * Set 32-bit value in little endian buffer.
+ *
+ * @param[out]  buffer  Buffer
+ * @param[in]   value   Value
+ */
+static void setUInt32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0U] = static_cast<uint8_t>(value & 0xffU);
+    buffer[1U] = static_cast<uint8_t>((value >> 8U) & 0xffU);
+    buffer[2U] = static_cast<uint8_t>((value >> 16U) & 0xffU);
+    buffer[3U] = static_cast<uint8_t>((value >> 24U) & 0xffU);
+
+    return;
+}
@@ -0,0 +1,252 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Plugin configuration store
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup plugin
+ *
+ * @{
+ */
+
+#ifndef __PLUGIN_CONFIG_STORE_H__
+#define __PLUGIN_CONFIG_STORE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <ArduinoJson.h>
+#include <FS.h>
+#include <Mutex.hpp>
+#include <SimpleTimer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The plugin configuration store keeps the configuration of all plugins in
+ * a single container file. Every configuration is stored MessagePack encoded
+ * and referenced by an index at the begin of the container.
+ *
+ * Container layout (little endian):
+ * - Header: Magic "PXCS", version (1 byte), reserved (1 byte), number of entries (2 byte).
+ * - Index: Per entry the plugin UID (2 byte), reserved (2 byte), offset (4 byte) and size (4 byte).
+ * - Data: MessagePack encoded configurations.
+ *
+ * The index is read on first access. Changed configurations are kept in
+ * memory and written together after a short delay. The container is
+ * written to a temporary file first and renamed afterwards, so a power loss
+ * never results in a broken container.
+ *
+ * A JSON configuration file (/configuration/<uid>.json) of a plugin takes
+ * precedence over the container. It is imported on the next load and removed
+ * after the container was written. This keeps the restore of a backup working.
+ */
+class PluginConfigStore
+{
+public:
+
+    /**
+     * Get the plugin configuration store instance.
+     *
+     * @return Plugin configuration store instance
+     */
+    static PluginConfigStore& getInstance()
+    {
+        static PluginConfigStore instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Read the index of the container in advance. This is optional, because
+     * the index is read on first access anyway. But it allows to do it
+     * during the startup in parallel to other initialization steps.
+     */
+    void begin();
+
+    /**
+     * Load the configuration of a plugin.
+     *
+     * @param[in]   uid Plugin UID
+     * @param[out]  doc Configuration
+     *
+     * @return If successful loaded, it will return true otherwise false.
+     */
+    bool load(uint16_t uid, JsonDocument& doc);
+
+    /**
+     * Save the configuration of a plugin. The configuration is written
+     * delayed to the filesystem, see process().
+     *
+     * @param[in] uid   Plugin UID
+     * @param[in] doc   Configuration
+     *
+     * @return If successful saved, it will return true otherwise false.
+     */
+    bool save(uint16_t uid, const JsonDocument& doc);
+
+    /**
+     * Remove the configuration of a plugin.
+     *
+     * @param[in] uid   Plugin UID
+     */
+    void remove(uint16_t uid);
+
+    /**
+     * Process the store. Pending changes are written after a delay, which
+     * batches several changes in a single write.
+     */
+    void process();
+
+    /**
+     * Write pending changes immediately.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool flush();
+
+    /** Max. number of plugin configurations. */
+    static const uint8_t    MAX_ENTRIES     = 32U;
+
+    /** Delay in ms after the last change, till the changes are written. */
+    static const uint32_t   WRITE_DELAY     = 2000U;
+
+    /** Full path of the container file. */
+    static constexpr const char*    FILE_NAME       = "/configuration/plugins.bin";
+
+    /** Full path of the temporary container file, used during writing. */
+    static constexpr const char*    TMP_FILE_NAME   = "/configuration/plugins.tmp";
+
+private:
+
+    /**
+     * A single configuration entry.
+     */
+    struct Entry
+    {
+        uint16_t    uid;            /**< Plugin UID */
+        uint32_t    offset;         /**< Offset in the container file */
+        uint32_t    size;           /**< Size of the MessagePack encoded configuration in bytes */
+        uint8_t*    data;           /**< Pending MessagePack encoded configuration, nullptr if not changed. */
+        bool        isImported;     /**< Is imported from a JSON configuration file? */
+    };
+
+    /** Container file format version */
+    static const uint8_t    VERSION         = 1U;
+
+    /** Header size in bytes */
+    static const size_t     HEADER_SIZE     = 8U;
+
+    /** Size of a single index entry in bytes */
+    static const size_t     INDEX_SIZE      = 12U;
+
+    fs::FS&         m_fs;                       /**< Filesystem */
+    MutexRecursive  m_mutex;                    /**< Protects the store against concurrent access. */
+    Entry           m_entries[MAX_ENTRIES];     /**< Configuration entries */
+    uint8_t         m_entryCnt;                 /**< Number of configuration entries */
+    bool            m_isIndexLoaded;            /**< Is index loaded from container file? */
+    bool            m_isDirty;                  /**< Are there pending changes? */
+    SimpleTimer     m_writeTimer;               /**< Timer used to delay the write of pending changes. */
+
+    /**
+     * Constructs the plugin configuration store.
+     */
+    PluginConfigStore();
+
+    /**
+     * Destroys the plugin configuration store.
+     */
+    ~PluginConfigStore()
+    {
+        /* Will never be called. */
+    }
+
+    PluginConfigStore(const PluginConfigStore& store);
+    PluginConfigStore& operator=(const PluginConfigStore& store);
+
+    /**
+     * Load the index from the container file, if not already done.
+     */
+    void loadIndex();
+
+    /**
+     * Find the entry of a plugin.
+     *
+     * @param[in] uid   Plugin UID
+     *
+     * @return Entry or nullptr if not found.
+     */
+    Entry* find(uint16_t uid);
+
+    /**
+     * Store a configuration as pending change.
+     *
+     * @param[in] uid           Plugin UID
+     * @param[in] doc           Configuration
+     * @param[in] isImported    Is imported from JSON configuration file?
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool store(uint16_t uid, const JsonDocument& doc, bool isImported);
+
+    /**
+     * Get the full path of the JSON configuration file of a plugin.
+     *
+     * @param[in] uid   Plugin UID
+     *
+     * @return Full path
+     */
+    String getJsonFileName(uint16_t uid) const;
+
+    /**
+     * Write the whole container to the temporary file.
+     *
+     * @param[in] offsets   Calculated offsets of every entry in the new container.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool writeTmpFile(const uint32_t* offsets);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __PLUGIN_CONFIG_STORE_H__ */
+
+/** @} */
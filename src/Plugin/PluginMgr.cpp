@@ -41,9 +41,12 @@
 #include "Plugin.hpp"
 #include "HttpStatus.h"
 #include "RestUtil.h"
+#include "MemTag.h"
+#include "MqttService.h"
 
 #include <Logging.h>
 #include <ArduinoJson.h>
+#include <Util.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -71,9 +74,63 @@
 
 void PluginMgr::begin()
 {
+    if (false == m_mutexMeta.isAllocated())
+    {
+        LOG_WARNING("Couldn't create mutex.");
+    }
+
     createPluginConfigDirectory();
 }
 
+void PluginMgr::process()
+{
+    MutexGuard<Mutex>                   guard(m_mutexMeta);
+    DLinkedListIterator<PluginObjData*> it(m_pluginMeta);
+    bool                                isMqttConnected = MqttService::getInstance().isConnected();
+
+    /* Publish all topics after the connection to the MQTT broker is established. */
+    if ((true == isMqttConnected) &&
+        (false == m_isMqttConnected))
+    {
+        m_isPublishPending  = true;
+        m_publishPluginIdx  = 0U;
+        m_publishTopicIdx   = 0U;
+    }
+
+    m_isMqttConnected = isMqttConnected;
+
+    if ((true == m_isMqttConnected) &&
+        (true == m_isPublishPending))
+    {
+        publishTopics();
+    }
+
+    /* Apply the last coalesced request of every plugin topic. */
+    if (true == it.first())
+    {
+        do
+        {
+            PluginObjData*  pluginMeta  = *it.current();
+            uint8_t         idx         = 0U;
+
+            for(idx = 0U; idx < PluginObjData::MAX_WEB_HANDLERS; ++idx)
+            {
+                WebHandlerData* webHandlerData  = &pluginMeta->webHandlers[idx];
+                String          value;
+
+                if ((nullptr != webHandlerData->webHandler) &&
+                    (true == webHandlerData->limiter.getPending(value)))
+                {
+                    applyTopic(pluginMeta->plugin, webHandlerData->topic, value);
+                }
+            }
+        }
+        while(true == it.next());
+    }
+
+    return;
+}
+
 void PluginMgr::registerPlugin(const String& name, IPluginMaintenance::CreateFunc createFunc)
 {
     m_pluginFactory.registerPlugin(name, createFunc);
@@ -82,6 +139,7 @@ void PluginMgr::registerPlugin(const String& name, IPluginMaintenance::CreateFun
 
 IPluginMaintenance* PluginMgr::install(const String& name, uint8_t slotId)
 {
+    MemTagGuard         memTagGuard(MemTag::ID_PLUGINS);
     IPluginMaintenance* plugin = m_pluginFactory.createPlugin(name);
 
     if (nullptr != plugin)
@@ -458,8 +516,9 @@ void PluginMgr::registerTopics(IPluginMaintenance* plugin)
 
             if (nullptr != metaData)
             {
-                String baseUriByUid     = getRestApiBaseUriByUid(plugin->getUID());
-                String baseUriByAlias;
+                MutexGuard<Mutex>   guard(m_mutexMeta);
+                String              baseUriByUid    = getRestApiBaseUriByUid(plugin->getUID());
+                String              baseUriByAlias;
 
                 if (false == plugin->getAlias().isEmpty())
                 {
@@ -470,11 +529,29 @@ void PluginMgr::registerTopics(IPluginMaintenance* plugin)
 
                 for (JsonVariant topic : topics)
                 {
-                    registerTopic(baseUriByUid, metaData, topic.as<String>());
+                    String topicStr = topic.as<String>();
+
+                    registerTopic(baseUriByUid, metaData, topicStr);
 
                     if (false == baseUriByAlias.isEmpty())
                     {
-                        registerTopic(baseUriByAlias, metaData, topic.as<String>());
+                        registerTopic(baseUriByAlias, metaData, topicStr);
+                    }
+
+                    /* Commands are received via MQTT in the "set" subtopic. */
+                    if (false == MqttService::getInstance().subscribe(getMqttTopic(plugin->getUID(), topicStr) + "/set",
+                                    [this, plugin, topicStr](const String& mqttTopic, const uint8_t* payload, size_t size)
+                                    {
+                                        UTIL_NOT_USED(mqttTopic);
+                                        this->onMqttMessage(plugin, topicStr, payload, size);
+                                    }))
+                    {
+                        LOG_WARNING("[%s][%u] Couldn't subscribe %s.", plugin->getName(), plugin->getUID(), topicStr.c_str());
+                    }
+
+                    if (true == m_isMqttConnected)
+                    {
+                        publishTopic(plugin, topicStr);
                     }
                 }
 
@@ -523,6 +600,12 @@ void PluginMgr::registerTopic(const String& baseUri, PluginObjData* metaData, co
                                             this->uploadHandler(request, filename, index, data, len, final, plugin, topic, webHandlerData);
                                         });
         webHandlerData->uri         = topicUri;
+        webHandlerData->topic       = topic;
+
+        if (false == webHandlerData->limiter.init())
+        {
+            LOG_WARNING("[%s][%u] Request limiter not available.", metaData->plugin->getName(), metaData->plugin->getUID());
+        }
 
         LOG_INFO("[%s][%u] Register: %s", metaData->plugin->getName(), metaData->plugin->getUID(), topicUri.c_str());
     }
@@ -530,6 +613,7 @@ void PluginMgr::registerTopic(const String& baseUri, PluginObjData* metaData, co
 
 void PluginMgr::webReqHandler(AsyncWebServerRequest *request, IPluginMaintenance* plugin, const String& topic, WebHandlerData* webHandlerData)
 {
+    MemTagGuard         memTagGuard(MemTag::ID_WEB_SERVER);
     String              content;
     const size_t        JSON_DOC_SIZE   = 1024U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
@@ -561,8 +645,9 @@ void PluginMgr::webReqHandler(AsyncWebServerRequest *request, IPluginMaintenance
     }
     else if (HTTP_POST == request->method())
     {
-        DynamicJsonDocument jsonDocPar(JSON_DOC_SIZE);
-        size_t              idx = 0U;
+        DynamicJsonDocument     jsonDocPar(JSON_DOC_SIZE);
+        size_t                  idx     = 0U;
+        RequestLimiter::Result  result  = RequestLimiter::RESULT_APPLY;
 
         /* Add arguments */
         for(idx = 0U; idx < request->args(); ++idx)
@@ -570,14 +655,49 @@ void PluginMgr::webReqHandler(AsyncWebServerRequest *request, IPluginMaintenance
             jsonDocPar[request->argName(idx)] = request->arg(idx);
         }
 
-        /* Add uploaded file */
+        /* Add uploaded file. A file upload is never coalesced, because the
+         * file would be lost.
+         */
         if ((false == webHandlerData->isUploadError) &&
             (false == webHandlerData->fullPath.isEmpty()))
         {
             jsonDocPar["fullPath"] = webHandlerData->fullPath;
+
+            if (false == webHandlerData->limiter.take())
+            {
+                result = RequestLimiter::RESULT_REJECTED;
+            }
         }
+        else
+        {
+            String value;
+
+            (void)serializeJson(jsonDocPar, value);
+            result = webHandlerData->limiter.limit(value);
+        }
+
+        if (RequestLimiter::RESULT_REJECTED == result)
+        {
+            RestUtil::prepareRspError(jsonDoc, "Too many requests.");
+
+            jsonDoc.remove("data");
+
+            /* If a file is available, it will be removed now. */
+            if (false == webHandlerData->fullPath.isEmpty())
+            {
+                (void)FILESYSTEM.remove(webHandlerData->fullPath);
+            }
 
-        if (false == plugin->setTopic(topic, jsonDocPar.as<JsonObject>()))
+            httpStatusCode = HttpStatus::STATUS_CODE_TOO_MANY_REQUESTS;
+        }
+        /* The request is applied after the coalescing window, if no later one replaces it. */
+        else if (RequestLimiter::RESULT_COALESCED == result)
+        {
+            dataObj["coalesced"]    = true;
+            jsonDoc["status"]       = "ok";
+            httpStatusCode          = HttpStatus::STATUS_CODE_OK;
+        }
+        else if (false == plugin->setTopic(topic, jsonDocPar.as<JsonObject>()))
         {
             RestUtil::prepareRspError(jsonDoc, "Requested topic not supported or invalid data.");
 
@@ -595,6 +715,8 @@ void PluginMgr::webReqHandler(AsyncWebServerRequest *request, IPluginMaintenance
         {
             jsonDoc["status"]   = "ok";
             httpStatusCode      = HttpStatus::STATUS_CODE_OK;
+
+            publishTopic(plugin, topic);
         }
     }
     else
@@ -611,8 +733,179 @@ void PluginMgr::webReqHandler(AsyncWebServerRequest *request, IPluginMaintenance
     return;
 }
 
+void PluginMgr::applyTopic(IPluginMaintenance* plugin, const String& topic, const String& value)
+{
+    const size_t            JSON_DOC_SIZE   = 1024U;
+    DynamicJsonDocument     jsonDocPar(JSON_DOC_SIZE);
+    DeserializationError    error           = deserializeJson(jsonDocPar, value);
+
+    if (DeserializationError::Ok != error.code())
+    {
+        LOG_WARNING("[%s][%u] Invalid pending request of %s: %s", plugin->getName(), plugin->getUID(), topic.c_str(), error.c_str());
+    }
+    else if (false == plugin->setTopic(topic, jsonDocPar.as<JsonObject>()))
+    {
+        LOG_WARNING("[%s][%u] Pending request of %s rejected.", plugin->getName(), plugin->getUID(), topic.c_str());
+    }
+    else
+    {
+        publishTopic(plugin, topic);
+    }
+
+    return;
+}
+
+String PluginMgr::getMqttTopic(uint16_t uid, const String& topic)
+{
+    String mqttTopic = "/display/uid/";
+
+    mqttTopic += uid;
+    mqttTopic += topic;
+
+    return mqttTopic;
+}
+
+void PluginMgr::publishTopic(IPluginMaintenance* plugin, const String& topic)
+{
+    const size_t        JSON_DOC_SIZE   = 1024U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    JsonObject          dataObj         = jsonDoc.to<JsonObject>();
+
+    /* Without connection the topics are published after the connection is established. */
+    if ((true == MqttService::getInstance().isConnected()) &&
+        (true == plugin->getTopic(topic, dataObj)))
+    {
+        String payload;
+
+        (void)serializeJson(jsonDoc, payload);
+
+        /* The state is retained, so a new subscriber gets it immediately. */
+        if (false == MqttService::getInstance().publish(getMqttTopic(plugin->getUID(), topic), payload, MqttClient::QOS_0, true))
+        {
+            LOG_WARNING("[%s][%u] Couldn't publish %s.", plugin->getName(), plugin->getUID(), topic.c_str());
+        }
+    }
+
+    return;
+}
+
+void PluginMgr::publishTopics()
+{
+    DLinkedListIterator<PluginObjData*> it(m_pluginMeta);
+    bool                                isAvailable = it.first();
+    bool                                isQueueFull = false;
+    uint32_t                            pluginIdx   = 0U;
+
+    /* Skip the plugins, which topics are already published. */
+    while((true == isAvailable) &&
+          (m_publishPluginIdx > pluginIdx))
+    {
+        isAvailable = it.next();
+        ++pluginIdx;
+    }
+
+    while((true == isAvailable) &&
+          (false == isQueueFull))
+    {
+        IPluginMaintenance* plugin          = (*it.current())->plugin;
+        const size_t        JSON_DOC_SIZE   = 512U;
+        DynamicJsonDocument topicsDoc(JSON_DOC_SIZE);
+        JsonArray           topics          = topicsDoc.createNestedArray("topics");
+
+        plugin->getTopics(topics);
+
+        while((topics.size() > m_publishTopicIdx) &&
+              (0U < MqttService::getInstance().getFreeQueueSize()))
+        {
+            publishTopic(plugin, topics[m_publishTopicIdx].as<String>());
+            ++m_publishTopicIdx;
+        }
+
+        /* Continue with the remaining topics in the next call. */
+        if (topics.size() > m_publishTopicIdx)
+        {
+            isQueueFull = true;
+        }
+        else
+        {
+            m_publishTopicIdx = 0U;
+            ++m_publishPluginIdx;
+            isAvailable = it.next();
+        }
+    }
+
+    /* All topics published? */
+    if (false == isAvailable)
+    {
+        m_isPublishPending = false;
+    }
+
+    return;
+}
+
+void PluginMgr::onMqttMessage(IPluginMaintenance* plugin, const String& topic, const uint8_t* payload, size_t size)
+{
+    MutexGuard<Mutex>                   guard(m_mutexMeta);
+    DLinkedListIterator<PluginObjData*> it(m_pluginMeta);
+    WebHandlerData*                     webHandlerData  = nullptr;
+
+    /* The plugin may be uninstalled in the meantime. Its web handler data
+     * contains the request limiter of the topic.
+     */
+    if (true == it.first())
+    {
+        do
+        {
+            PluginObjData* pluginMeta = *it.current();
+
+            if (plugin == pluginMeta->plugin)
+            {
+                uint8_t idx = 0U;
+
+                for(idx = 0U; (idx < PluginObjData::MAX_WEB_HANDLERS) && (nullptr == webHandlerData); ++idx)
+                {
+                    if ((nullptr != pluginMeta->webHandlers[idx].webHandler) &&
+                        (topic == pluginMeta->webHandlers[idx].topic))
+                    {
+                        webHandlerData = &pluginMeta->webHandlers[idx];
+                    }
+                }
+            }
+        }
+        while((nullptr == webHandlerData) && (true == it.next()));
+    }
+
+    if (nullptr != webHandlerData)
+    {
+        String                  value;
+        RequestLimiter::Result  result  = RequestLimiter::RESULT_APPLY;
+
+        (void)value.concat(reinterpret_cast<const char*>(payload), size);
+
+        result = webHandlerData->limiter.limit(value);
+
+        if (RequestLimiter::RESULT_REJECTED == result)
+        {
+            LOG_WARNING("[%s][%u] Too many requests of %s.", plugin->getName(), plugin->getUID(), topic.c_str());
+        }
+        else if (RequestLimiter::RESULT_APPLY == result)
+        {
+            applyTopic(plugin, topic, value);
+        }
+        else
+        {
+            /* Coalesced, it will be applied later. */
+            ;
+        }
+    }
+
+    return;
+}
+
 void PluginMgr::uploadHandler(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final, IPluginMaintenance* plugin, const String& topic, WebHandlerData* webHandlerData)
 {
+    MemTagGuard memTagGuard(MemTag::ID_WEB_SERVER);
+
     /* Begin of upload? */
     if (0 == index)
     {
@@ -653,9 +946,7 @@ void PluginMgr::uploadHandler(AsyncWebServerRequest *request, const String& file
             else
             {
                 /* Create a new file and overwrite a existing one. */
-                webHandlerData->fd = FILESYSTEM.open(webHandlerData->fullPath, "w");
-
-                if (false == webHandlerData->fd)
+                if (false == webHandlerData->uploadWriter.open(FILESYSTEM, webHandlerData->fullPath))
                 {
                     LOG_ERROR("Couldn't create file: %s", webHandlerData->fullPath.c_str());
                     webHandlerData->isUploadError = true;
@@ -667,24 +958,32 @@ void PluginMgr::uploadHandler(AsyncWebServerRequest *request, const String& file
 
     if (false == webHandlerData->isUploadError)
     {
-        /* If file is open, write data to it. */
-        if (true == webHandlerData->fd)
+        /* If file is open, write data to it. The data is written to flash asynchronously. */
+        if (true == webHandlerData->uploadWriter.isOpen())
         {
-            if (len != webHandlerData->fd.write(data, len))
+            if (false == webHandlerData->uploadWriter.write(data, len))
             {
                 LOG_ERROR("Less data written, upload aborted.");
                 webHandlerData->isUploadError = true;
                 webHandlerData->fullPath.clear();
-                webHandlerData->fd.close();
+                (void)webHandlerData->uploadWriter.close();
             }
         }
 
         /* Upload finished? */
-        if (true == final)
+        if ((false == webHandlerData->isUploadError) &&
+            (true == final))
         {
-            LOG_INFO("Upload of %s finished.", filename.c_str());
-
-            webHandlerData->fd.close();
+            if (false == webHandlerData->uploadWriter.close())
+            {
+                LOG_ERROR("Less data written, upload aborted.");
+                webHandlerData->isUploadError = true;
+                webHandlerData->fullPath.clear();
+            }
+            else
+            {
+                LOG_INFO("Upload of %s finished.", filename.c_str());
+            }
         }
     }
 
@@ -695,6 +994,7 @@ void PluginMgr::unregisterTopics(IPluginMaintenance* plugin)
 {
     if (nullptr != plugin)
     {
+        MutexGuard<Mutex>                   guard(m_mutexMeta);
         DLinkedListIterator<PluginObjData*> it(m_pluginMeta);
 
         /* Walk through plugin meta and remove every topic.
@@ -730,6 +1030,9 @@ void PluginMgr::unregisterTopics(IPluginMaintenance* plugin)
                 {
                     if (nullptr != pluginMeta->webHandlers[idx].webHandler)
                     {
+                        /* The topic may be registered by UID and alias, but it is subscribed only once. */
+                        MqttService::getInstance().unsubscribe(getMqttTopic(pluginMeta->plugin->getUID(), pluginMeta->webHandlers[idx].topic) + "/set");
+
                         LOG_INFO("[%s][%u] Unregister: %s", pluginMeta->plugin->getName(), pluginMeta->plugin->getUID(), pluginMeta->webHandlers[idx].uri.c_str());
 
                         if (false == MyWebServer::getInstance().removeHandler(pluginMeta->webHandlers[idx].webHandler))
@@ -47,9 +47,12 @@
 #include "IPluginMaintenance.hpp"
 #include "SlotList.h"
 #include "PluginFactory.h"
+#include "UploadWriter.h"
+#include "RequestLimiter.h"
 
 #include <LinkedList.hpp>
 #include <ESPAsyncWebServer.h>
+#include <Mutex.hpp>
 
 /******************************************************************************
  * Macros
@@ -85,6 +88,12 @@ public:
      */
     void begin();
 
+    /**
+     * Process the plugin manager. It applies coalesced topic requests, after
+     * their coalescing window elapsed. Call it periodically.
+     */
+    void process();
+
     /**
      * Register a plugin.
      *
@@ -173,6 +182,15 @@ public:
 
 private:
 
+    /** Max. number of requests in a burst to a plugin topic. */
+    static const uint32_t   TOPIC_REQ_LIMIT_BURST           = 4U;
+
+    /** Period in ms, after which one more request to a plugin topic is allowed. */
+    static const uint32_t   TOPIC_REQ_LIMIT_REFILL_PERIOD   = 250U;
+
+    /** Window in ms, in which requests to a plugin topic are coalesced. */
+    static const uint32_t   TOPIC_REQ_LIMIT_WINDOW          = 500U;
+
     /**
      * Web handler data, which is necessary for the webserver handling.
      */
@@ -180,9 +198,11 @@ private:
     {
         AsyncCallbackWebHandler*    webHandler;     /**< Webhandler callback, necessary to remove it later again. */
         String                      uri;            /**< URI where the handler is registered. */
+        String                      topic;          /**< Topic, which is handled. */
         bool                        isUploadError;  /**< If upload error happened, it will be true otherwise false. */
         String                      fullPath;       /**< Full path of uploaded file. If empty, there is no file available. */
-        File                        fd;             /**< Upload file descriptor */
+        UploadWriter                uploadWriter;   /**< Upload writer, which coalesces the data before writing to flash. */
+        RequestLimiter              limiter;        /**< Limits the topic requests, the latest request within the window wins. */
 
         /**
          * Initialize the web handler data.
@@ -190,9 +210,11 @@ private:
         WebHandlerData() :
             webHandler(nullptr),
             uri(),
+            topic(),
             isUploadError(false),
             fullPath(),
-            fd()
+            uploadWriter(),
+            limiter(TOPIC_REQ_LIMIT_BURST, TOPIC_REQ_LIMIT_REFILL_PERIOD, TOPIC_REQ_LIMIT_WINDOW)
         {
         }
     };
@@ -219,13 +241,28 @@ private:
 
     PluginFactory               m_pluginFactory;    /**< The plugin factory with the plugin type registry. */
     DLinkedList<PluginObjData*> m_pluginMeta;       /**< Plugin object management information. */
+    Mutex                       m_mutexMeta;        /**< Protects the plugin object management information. */
+    bool                        m_isMqttConnected;  /**< Is connected to the MQTT broker? Used to publish the topics after connect. */
+    bool                        m_isPublishPending; /**< Are topics left, which shall be published after connect? */
+    uint32_t                    m_publishPluginIdx; /**< Index of the plugin, which topics are published next. */
+    uint32_t                    m_publishTopicIdx;  /**< Index of the plugin topic, which is published next. */
 
     /**
      * Constructs the plugin manager.
      */
     PluginMgr() :
-        m_pluginFactory()
+        m_pluginFactory(),
+        m_pluginMeta(),
+        m_mutexMeta(),
+        m_isMqttConnected(false),
+        m_isPublishPending(false),
+        m_publishPluginIdx(0U),
+        m_publishTopicIdx(0U)
     {
+        /* The mutex is created here, because the plugin metadata may be
+         * accessed before begin() is called.
+         */
+        (void)m_mutexMeta.create();
     }
 
     /**
@@ -320,6 +357,51 @@ private:
      */
     void webReqHandler(AsyncWebServerRequest *request, IPluginMaintenance* plugin, const String& topic, WebHandlerData* webHandlerData);
 
+    /**
+     * Apply a coalesced topic request.
+     *
+     * @param[in] plugin    The plugin, which topic shall be set.
+     * @param[in] topic     The topic.
+     * @param[in] value     The serialized topic parameters.
+     */
+    void applyTopic(IPluginMaintenance* plugin, const String& topic, const String& value);
+
+    /**
+     * Get the MQTT topic of a plugin topic, relative to the MQTT base topic.
+     *
+     * @param[in] uid   Plugin UID
+     * @param[in] topic The plugin topic.
+     *
+     * @return MQTT topic
+     */
+    String getMqttTopic(uint16_t uid, const String& topic);
+
+    /**
+     * Publish the current topic data via MQTT, if connected.
+     *
+     * @param[in] plugin    The plugin, which topic shall be published.
+     * @param[in] topic     The topic.
+     */
+    void publishTopic(IPluginMaintenance* plugin, const String& topic);
+
+    /**
+     * Publish the pending topic data of all plugins via MQTT. To avoid that
+     * the outbound queue overflows, only as many topics are published as
+     * fit into the queue. The next call continues with the remaining ones.
+     * The plugin object management information must be protected by the caller.
+     */
+    void publishTopics();
+
+    /**
+     * Handle a topic request, which is received via MQTT.
+     *
+     * @param[in] plugin    The responsible plugin, which is related to the request.
+     * @param[in] topic     The topic.
+     * @param[in] payload   The topic parameters in JSON format.
+     * @param[in] size      Payload size in byte.
+     */
+    void onMqttMessage(IPluginMaintenance* plugin, const String& topic, const uint8_t* payload, size_t size);
+
     /**
      * File upload handler.
      *
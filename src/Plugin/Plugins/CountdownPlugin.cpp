@@ -37,10 +37,10 @@
 #include "RestApi.h"
 #include "Util.h"
 #include "FileSystem.h"
+#include "PluginConfigStore.h"
 
 #include <ArduinoJson.h>
 #include <Logging.h>
-#include <JsonFile.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -183,7 +183,7 @@ void CountdownPlugin::start(uint16_t width, uint16_t height)
     {
         if (false == saveConfiguration())
         {
-            LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
+            LOG_WARNING("Failed to create initial configuration of UID %u.", getUID());
         }
     }
 
@@ -196,15 +196,11 @@ void CountdownPlugin::start(uint16_t width, uint16_t height)
 
 void CountdownPlugin::stop()
 {
-    String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     m_cfgReloadTimer.stop();
 
-    if (false != FILESYSTEM.remove(configurationFilename))
-    {
-        LOG_INFO("File %s removed", configurationFilename.c_str());
-    }
+    PluginConfigStore::getInstance().remove(getUID());
 
     return;
 }
@@ -301,10 +297,8 @@ void CountdownPlugin::setTargetDayDescription(const TargetDayDescription& target
 bool CountdownPlugin::saveConfiguration() const
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["day"]                  = m_targetDate.day;
     jsonDoc["month"]                = m_targetDate.month;
@@ -312,14 +306,14 @@ bool CountdownPlugin::saveConfiguration() const
     jsonDoc["descriptionPlural"]    = m_targetDateInformation.plural;
     jsonDoc["descriptionSingular"]  = m_targetDateInformation.singular;
     
-    if (false == jsonFile.save(configurationFilename, jsonDoc))
+    if (false == PluginConfigStore::getInstance().save(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to save file %s.", configurationFilename.c_str());
+        LOG_WARNING("Failed to save configuration of UID %u.", getUID());
         status = false;
     }
     else
     {
-        LOG_INFO("File %s saved.", configurationFilename.c_str());
+        LOG_INFO("Configuration of UID %u saved.", getUID());
     }
 
     return status;
@@ -328,14 +322,12 @@ bool CountdownPlugin::saveConfiguration() const
 bool CountdownPlugin::loadConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    String              configurationFilename   = getFullPathToConfiguration();
 
-    if (false == jsonFile.load(configurationFilename, jsonDoc))
+    if (false == PluginConfigStore::getInstance().load(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to load file %s.", configurationFilename.c_str());
+        LOG_WARNING("Failed to load configuration of UID %u.", getUID());
         status = false;
     }
     else
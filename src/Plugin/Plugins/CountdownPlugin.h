@@ -65,8 +65,9 @@
 /**
  * Shows the remaining days until a configured target date.
  *
- * At the first installation a json document is generated to the /configuration/UUID.json
- * in the filesystem, where the target date has to be configured.
+ * At the first installation a default configuration is stored in the plugin
+ * configuration store. The target date has to be configured via REST API or
+ * by uploading a /configuration/<uid>.json file, which is imported once.
  *
  */
 class CountdownPlugin : public Plugin
@@ -395,12 +396,12 @@ private:
     SimpleTimer             m_cfgReloadTimer;           /**< Timer is used to cyclic reload the configuration from persistent memory. */
 
     /**
-     * Saves current configuration to JSON file.
+     * Saves current configuration to the plugin configuration store.
      */
     bool saveConfiguration() const;
 
     /**
-     * Load configuration from JSON file.
+     * Load configuration from the plugin configuration store.
      */
     bool loadConfiguration();
 
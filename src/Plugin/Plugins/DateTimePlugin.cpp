@@ -37,7 +37,7 @@
 
 #include <Logging.h>
 #include <FileSystem.h>
-#include <JsonFile.h>
+#include "PluginConfigStore.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -124,6 +124,7 @@ void DateTimePlugin::start(uint16_t width, uint16_t height)
      */
     tcHeight = height - 1U;
     m_textCanvas.setPosAndSize(0, 0, width, tcHeight);
+    m_textCanvas.setBackgroundColor(ColorDef::BLACK);
     (void)m_textCanvas.addWidget(m_textWidget);
 
     /* The text widget inside the text canvas is left aligned on x-axis and
@@ -147,6 +148,7 @@ void DateTimePlugin::start(uint16_t width, uint16_t height)
     }
 
     m_lampCanvas.setPosAndSize(1, height - 1, width, 1U);
+    m_lampCanvas.setBackgroundColor(ColorDef::BLACK);
 
     if (true == calcLayout(width, MAX_LAMPS, minDistance, minBorder, lampWidth, lampDistance))
     {
@@ -174,7 +176,7 @@ void DateTimePlugin::start(uint16_t width, uint16_t height)
     {
         if (false == saveConfiguration())
         {
-            LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
+            LOG_WARNING("Failed to create initial configuration of UID %u.", getUID());
         }
     }
 
@@ -184,12 +186,8 @@ void DateTimePlugin::start(uint16_t width, uint16_t height)
 void DateTimePlugin::stop()
 {
     MutexGuard<MutexRecursive>  guard(m_mutex);
-    String                      configurationFilename   = getFullPathToConfiguration();
 
-    if (false != FILESYSTEM.remove(configurationFilename))
-    {
-        LOG_INFO("File %s removed", configurationFilename.c_str());
-    }
+    PluginConfigStore::getInstance().remove(getUID());
 
     return;
 }
@@ -221,8 +219,15 @@ void DateTimePlugin::active(YAGfx& gfx)
     m_durationCounter = 0U;
     m_checkUpdateTimer.start(CHECK_UPDATE_PERIOD);
 
+    /* The display content is unknown, therefore paint the canvases completely. */
+    gfx.fillScreen(ColorDef::BLACK);
+    m_textCanvas.invalidate();
+    m_lampCanvas.invalidate();
+
     /* The date/time shall be updated on the display right after plugin activation. */
     updateDateTime(true);
+
+    return;
 }
 
 void DateTimePlugin::inactive()
@@ -240,7 +245,7 @@ void DateTimePlugin::update(YAGfx& gfx)
 
     if (false != m_isUpdateAvailable)
     {
-        gfx.fillScreen(ColorDef::BLACK);
+        /* Only changed widgets are painted again. */
         m_textCanvas.update(gfx);
         m_lampCanvas.update(gfx);
 
@@ -464,21 +469,19 @@ bool DateTimePlugin::calcLayout(uint16_t width, uint16_t cnt, uint16_t minDistan
 bool DateTimePlugin::saveConfiguration() const
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["cfg"] = m_cfg;
     
-    if (false == jsonFile.save(configurationFilename, jsonDoc))
+    if (false == PluginConfigStore::getInstance().save(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to save file %s.", configurationFilename.c_str());
+        LOG_WARNING("Failed to save configuration of UID %u.", getUID());
         status = false;
     }
     else
     {
-        LOG_INFO("File %s saved.", configurationFilename.c_str());
+        LOG_INFO("Configuration of UID %u saved.", getUID());
     }
 
     return status;
@@ -487,14 +490,12 @@ bool DateTimePlugin::saveConfiguration() const
 bool DateTimePlugin::loadConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    String              configurationFilename   = getFullPathToConfiguration();
 
-    if (false == jsonFile.load(configurationFilename, jsonDoc))
+    if (false == PluginConfigStore::getInstance().load(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to load file %s.", configurationFilename.c_str());
+        LOG_WARNING("Failed to load configuration of UID %u.", getUID());
         status = false;
     }
     else
@@ -323,12 +323,12 @@ private:
     bool calcLayout(uint16_t width, uint16_t cnt, uint16_t minDistance, uint16_t minBorder, uint16_t& elementWidth, uint16_t& elementDistance);
 
     /**
-     * Saves current configuration to JSON file.
+     * Saves current configuration to the plugin configuration store.
      */
     bool saveConfiguration() const;
 
     /**
-     * Load configuration from JSON file.
+     * Load configuration from the plugin configuration store.
      */
     bool loadConfiguration();
 };
@@ -33,6 +33,11 @@
  * Includes
  *****************************************************************************/
 #include "FirePlugin.h"
+#include "PluginConfigStore.h"
+
+#include <ArduinoJson.h>
+#include <Logging.h>
+#include <Util.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -54,20 +59,124 @@
  * Local Variables
  *****************************************************************************/
 
+/* Initialize plugin topic. */
+const char* FirePlugin::TOPIC_PALETTE   = "/palette";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
+void FirePlugin::getTopics(JsonArray& topics) const
+{
+    (void)topics.add(TOPIC_PALETTE);
+}
+
+bool FirePlugin::getTopic(const String& topic, JsonObject& value) const
+{
+    bool isSuccessful = false;
+
+    if (0U != topic.equals(TOPIC_PALETTE))
+    {
+        MutexGuard<MutexRecursive> guard(m_mutex);
+
+        value["cool"]   = colorToHtml(m_coolColor);
+        value["warm"]   = colorToHtml(m_warmColor);
+        value["hot"]    = colorToHtml(m_hotColor);
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool FirePlugin::setTopic(const String& topic, const JsonObject& value)
+{
+    bool isSuccessful = false;
+
+    if (0U != topic.equals(TOPIC_PALETTE))
+    {
+        MutexGuard<MutexRecursive>  guard(m_mutex);
+        JsonVariantConst            jsonCool    = value["cool"];
+        JsonVariantConst            jsonWarm    = value["warm"];
+        JsonVariantConst            jsonHot     = value["hot"];
+        Color                       coolColor   = m_coolColor;
+        Color                       warmColor   = m_warmColor;
+        Color                       hotColor    = m_hotColor;
+
+        /* Every color is optional, but at least one must be given and all
+         * given colors must be valid.
+         */
+        isSuccessful = (false == jsonCool.isNull()) ||
+                       (false == jsonWarm.isNull()) ||
+                       (false == jsonHot.isNull());
+
+        if ((true == isSuccessful) &&
+            (false == jsonCool.isNull()))
+        {
+            isSuccessful = htmlToColor(jsonCool.as<String>(), coolColor);
+        }
+
+        if ((true == isSuccessful) &&
+            (false == jsonWarm.isNull()))
+        {
+            isSuccessful = htmlToColor(jsonWarm.as<String>(), warmColor);
+        }
+
+        if ((true == isSuccessful) &&
+            (false == jsonHot.isNull()))
+        {
+            isSuccessful = htmlToColor(jsonHot.as<String>(), hotColor);
+        }
+
+        if (true == isSuccessful)
+        {
+            m_coolColor = coolColor;
+            m_warmColor = warmColor;
+            m_hotColor  = hotColor;
+
+            updatePalette();
+            (void)saveConfiguration();
+        }
+    }
+
+    return isSuccessful;
+}
+
 void FirePlugin::start(uint16_t width, uint16_t height)
 {
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
     if (nullptr == m_heat)
     {
-        m_heatSize = width * height;
-        m_heat = new(std::nothrow) uint8_t[m_heatSize];
+        m_heatSize  = width * height;
+        m_heat      = new(std::nothrow) uint8_t[m_heatSize];
+        m_rowColors = new(std::nothrow) Color[width];
 
-        if (nullptr == m_heat)
+        if ((nullptr == m_heat) ||
+            (nullptr == m_rowColors))
         {
-            m_heatSize = 0U;
+            releaseBuffers();
+        }
+        else
+        {
+            m_width     = width;
+            m_height    = height;
+
+            memset(m_heat, 0, m_heatSize);
+        }
+    }
+
+    /* Seed the pseudo random number generator, it must not be 0. */
+    m_randomState = ESP.getCycleCount() | 1U;
+
+    /* Try to load configuration. If there is no configuration available, a default configuration
+     * will be created.
+     */
+    if (false == loadConfiguration())
+    {
+        if (false == saveConfiguration())
+        {
+            LOG_WARNING("Failed to create initial configuration of UID %u.", getUID());
         }
     }
 
@@ -76,11 +185,11 @@ void FirePlugin::start(uint16_t width, uint16_t height)
 
 void FirePlugin::stop()
 {
-    if (nullptr != m_heat)
-    {
-        delete[] m_heat;
-        m_heat = nullptr;
-    }
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    releaseBuffers();
+
+    PluginConfigStore::getInstance().remove(getUID());
 
     return;
 }
@@ -101,21 +210,30 @@ void FirePlugin::inactive()
 
 void FirePlugin::update(YAGfx& gfx)
 {
-    int16_t x       = 0;
-    int16_t y       = 0;
+    MutexGuard<MutexRecursive>  guard(m_mutex);
+    uint16_t                    x       = 0U;
+    uint16_t                    y       = 0U;
 
-    if (nullptr == m_heat)
+    if ((nullptr == m_heat) ||
+        (2U > m_height))
     {
         return;
     }
 
-    for(x = 0; x < gfx.getWidth(); ++x)
+    /* Step 1) Cool down every cell a little bit */
     {
-        /* Step 1) Cool down every cell a little bit */
-        for(y = 0; y < gfx.getHeight(); ++y)
+        uint16_t    coolDownMax = ((COOLING * 10U) / m_height) + 2U;
+        size_t      heatPos     = 0U;
+
+        /* Low displays would exceed the value range of random8(). */
+        if (UINT8_MAX < coolDownMax)
+        {
+            coolDownMax = UINT8_MAX;
+        }
+
+        for(heatPos = 0U; heatPos < m_heatSize; ++heatPos)
         {
-            uint8_t     coolDownTemperature = random(0, ((COOLING * 10U) / gfx.getHeight()) + 2U);
-            uint32_t    heatPos             = x + y * gfx.getWidth();
+            uint8_t coolDownTemperature = random8(0U, static_cast<uint8_t>(coolDownMax));
 
             if (coolDownTemperature >= m_heat[heatPos])
             {
@@ -126,52 +244,70 @@ void FirePlugin::update(YAGfx& gfx)
                 m_heat[heatPos] -= coolDownTemperature;
             }
         }
+    }
+
+    /* Step 2) Heat from each cell drifts 'up' and diffuses a little bit.
+     * It is done row by row from the top, because every row depends only
+     * on the rows below.
+     */
+    for(y = 0U; y < (m_height - 1U); ++y)
+    {
+        uint8_t*        row     = &m_heat[y * m_width];
+        const uint8_t*  below1  = nullptr;
+        const uint8_t*  below2  = nullptr;
 
-        /* Step 2) Heat from each cell drifts 'up' and diffuses a little bit */
-        for(y = 0; y < (gfx.getHeight() - 1U); ++y)
+        if ((m_height - 2U) > y)
+        {
+            below1 = &m_heat[(y + 1U) * m_width];
+            below2 = &m_heat[(y + 2U) * m_width];
+        }
+        else
         {
-            uint16_t    diffusHeat  = 0U;
+            below1 = row;
+            below2 = &m_heat[(y + 1U) * m_width];
+        }
 
-            if ((gfx.getHeight() - 2U) > y)
-            {
-                diffusHeat += m_heat[x + (y + 1) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 1) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 2) * gfx.getWidth()];
-                diffusHeat /= 3U;
-            }
-            else
-            {
-                diffusHeat += m_heat[x + (y + 0) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 0) * gfx.getWidth()];
-                diffusHeat += m_heat[x + (y + 1) * gfx.getWidth()];
-                diffusHeat /= 3U;
-            }
+        for(x = 0U; x < m_width; ++x)
+        {
+            uint16_t diffusHeat = below1[x] + below1[x] + below2[x];
 
-            m_heat[x + y * gfx.getWidth()] = diffusHeat;
+            row[x] = diffusHeat / 3U;
         }
+    }
 
-        /* Step 3) Randomly ignite new 'sparks' of heat near the bottom */
-        if (random(0, 255) < SPARKING)
-        {
-            uint8_t     randValue   = random(160, 255);
-            uint32_t    heatPos     = x + (gfx.getHeight() - 1U) * gfx.getWidth();
-            uint16_t    heat        = m_heat[heatPos] + randValue;
+    /* Step 3) Randomly ignite new 'sparks' of heat near the bottom */
+    {
+        uint8_t* bottomRow = &m_heat[(m_height - 1U) * m_width];
 
-            if (UINT8_MAX < heat)
-            {
-                m_heat[heatPos] = 255U;
-            }
-            else
+        for(x = 0U; x < m_width; ++x)
+        {
+            if (random8(0U, 255U) < SPARKING)
             {
-                m_heat[heatPos] = heat;
+                uint16_t heat = bottomRow[x] + random8(160U, 255U);
+
+                if (UINT8_MAX < heat)
+                {
+                    bottomRow[x] = UINT8_MAX;
+                }
+                else
+                {
+                    bottomRow[x] = heat;
+                }
             }
         }
+    }
+
+    /* Step 4) Map from heat cells to LED colors, row by row. */
+    for(y = 0U; y < m_height; ++y)
+    {
+        const uint8_t* row = &m_heat[y * m_width];
 
-        /* Step 4) Map from heat cells to LED colors */
-        for(y = 0; y < gfx.getHeight(); ++y)
+        for(x = 0U; x < m_width; ++x)
         {
-            gfx.drawPixel(x, y, heatColor(m_heat[x + y * gfx.getWidth()]));
+            m_rowColors[x] = m_palette[row[x]];
         }
+
+        gfx.drawHSpan(0, y, m_rowColors, m_width);
     }
 
     return;
@@ -185,45 +321,155 @@ void FirePlugin::update(YAGfx& gfx)
  * Private Methods
  *****************************************************************************/
 
-Color FirePlugin::heatColor(uint8_t temperature)
+void FirePlugin::releaseBuffers()
 {
-    Color heatColor;
+    if (nullptr != m_heat)
+    {
+        delete[] m_heat;
+        m_heat = nullptr;
+    }
+
+    if (nullptr != m_rowColors)
+    {
+        delete[] m_rowColors;
+        m_rowColors = nullptr;
+    }
+
+    m_heatSize  = 0U;
+    m_width     = 0U;
+    m_height    = 0U;
 
-    /* Scale 'heat' down from 0-255 to 0-191, which can then be easily divided
-     * into three equal 'thirds' of 64 units each.
+    return;
+}
+
+void FirePlugin::updatePalette()
+{
+    /* The heat range is divided into three equal parts:
+     * black -> cool color -> warm color -> hot color
      */
-    uint8_t t192        = static_cast<uint32_t>(temperature) * 191U / 255U;
+    const Color     BLACK(0U, 0U, 0U);
+    const Color*    colors[]    = { &BLACK, &m_coolColor, &m_warmColor, &m_hotColor };
+    const uint16_t  PARTS       = UTIL_ARRAY_NUM(colors) - 1U;
+    uint16_t        heat        = 0U;
 
-    /* Calculate a value that ramps up from zero to 255 in each 'third' of the scale. */
-    uint8_t heatRamp    = t192 & 0x3fU; /* 0..63 */
+    for(heat = 0U; heat < PALETTE_SIZE; ++heat)
+    {
+        /* Position of the heat in the scale of parts in 1/255 steps. */
+        uint16_t        pos     = heat * PARTS;
+        uint16_t        part    = pos / (PALETTE_SIZE - 1U);
+        uint16_t        ratio   = pos % (PALETTE_SIZE - 1U);
+        const Color&    from    = *colors[part];
+        const Color&    to      = *colors[(PARTS > part) ? (part + 1U) : part];
+
+        m_palette[heat].setRed(from.getRed() + ((to.getRed() - from.getRed()) * ratio) / (PALETTE_SIZE - 1));
+        m_palette[heat].setGreen(from.getGreen() + ((to.getGreen() - from.getGreen()) * ratio) / (PALETTE_SIZE - 1));
+        m_palette[heat].setBlue(from.getBlue() + ((to.getBlue() - from.getBlue()) * ratio) / (PALETTE_SIZE - 1));
+    }
+
+    return;
+}
+
+bool FirePlugin::saveConfiguration() const
+{
+    bool                status                  = true;
+    const size_t        JSON_DOC_SIZE           = 256U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
-    /* Scale up to 0..252 */
-    heatRamp <<= 2;
+    jsonDoc["cool"] = colorToHtml(m_coolColor);
+    jsonDoc["warm"] = colorToHtml(m_warmColor);
+    jsonDoc["hot"]  = colorToHtml(m_hotColor);
 
-    /* Now figure out which third of the spectrum we're in. */
-    if (t192 & 0x80U)
+    if (false == PluginConfigStore::getInstance().save(getUID(), jsonDoc))
     {
-        /* We're in the hottest third */
-        heatColor.setRed(255U);         /* Full red */
-        heatColor.setGreen(255U);       /* Full green */
-        heatColor.setBlue(heatRamp);    /* Ramp up blue */
+        LOG_WARNING("Failed to save configuration of UID %u.", getUID());
+        status = false;
     }
-    else if (t192 & 0x40U)
+    else
     {
-        /* We're in the middle third */
-        heatColor.setRed(255U);         /* Full red */
-        heatColor.setGreen(heatRamp);   /* Ramp up green */
-        heatColor.setBlue(0U);          /* No blue */
+        LOG_INFO("Configuration of UID %u saved.", getUID());
+    }
+
+    return status;
+}
+
+bool FirePlugin::loadConfiguration()
+{
+    bool                status                  = true;
+    const size_t        JSON_DOC_SIZE           = 256U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+    if (false == PluginConfigStore::getInstance().load(getUID(), jsonDoc))
+    {
+        LOG_WARNING("Failed to load configuration of UID %u.", getUID());
+        status = false;
     }
     else
     {
-        /* We're in the coolest third */
-        heatColor.setRed(heatRamp); /* Ramp up red */
-        heatColor.setGreen(0U);     /* No green */
-        heatColor.setBlue(0U);      /* No blue */
+        JsonVariant jsonCool    = jsonDoc["cool"];
+        JsonVariant jsonWarm    = jsonDoc["warm"];
+        JsonVariant jsonHot     = jsonDoc["hot"];
+
+        if ((false == jsonCool.is<String>()) ||
+            (false == jsonWarm.is<String>()) ||
+            (false == jsonHot.is<String>()))
+        {
+            LOG_WARNING("Palette colors not found or invalid type.");
+            status = false;
+        }
+        else if ((false == htmlToColor(jsonCool.as<String>(), m_coolColor)) ||
+                 (false == htmlToColor(jsonWarm.as<String>(), m_warmColor)) ||
+                 (false == htmlToColor(jsonHot.as<String>(), m_hotColor)))
+        {
+            LOG_WARNING("Invalid palette color.");
+            status = false;
+        }
+        else
+        {
+            updatePalette();
+        }
+    }
+
+    return status;
+}
+
+String FirePlugin::colorToHtml(const Color& color)
+{
+    char buffer[8]; /* "#RRGGBB" */
+
+    (void)snprintf(buffer, sizeof(buffer), "#%02X%02X%02X", color.getRed(), color.getGreen(), color.getBlue());
+
+    return String(buffer);
+}
+
+bool FirePlugin::htmlToColor(const String& html, Color& color)
+{
+    bool            isSuccessful    = false;
+    const size_t    HTML_COLOR_LEN  = 7U; /* "#RRGGBB" */
+
+    if ((HTML_COLOR_LEN == html.length()) &&
+        ('#' == html[0]))
+    {
+        uint32_t    value   = 0U;
+        bool        isValid = true;
+        size_t      idx     = 1U;
+
+        /* Util::hexToUInt32() can't report an invalid digit, therefore check it here. */
+        while((HTML_COLOR_LEN > idx) && (true == isValid))
+        {
+            isValid = (0 != isxdigit(html[idx]));
+            ++idx;
+        }
+
+        if (true == isValid)
+        {
+            value = Util::hexToUInt32(html.substring(1U));
+            color = Color(value);
+
+            isSuccessful = true;
+        }
     }
 
-    return heatColor;
+    return isSuccessful;
 }
 
 /******************************************************************************
@@ -46,6 +46,8 @@
 #include <stdint.h>
 #include "Plugin.hpp"
 
+#include <Mutex.hpp>
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -67,7 +69,12 @@
  * 3) Sometimes randomly new 'sparks' of heat are added at the bottom
  * 4) The heat from each cell is rendered as a color into the leds array
  *
- * The heat-to-color mapping uses a black-body radiation approximation.
+ * The heat-to-color mapping uses a precalculated palette with 256 colors,
+ * which is by default a black-body radiation approximation. It can be
+ * themed by its three colors for cool, warm and hot heat.
+ *
+ * The heat cells are stored row by row, which keeps the memory access
+ * sequential and allows to write a whole row at once to the display.
  *
  * It was ported from https://github.com/FastLED/FastLED/blob/master/examples/Fire2012/Fire2012.ino
  */
@@ -84,8 +91,19 @@ public:
     FirePlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
         m_heat(nullptr),
-        m_heatSize(0U)
+        m_heatSize(0U),
+        m_width(0U),
+        m_height(0U),
+        m_rowColors(nullptr),
+        m_palette(),
+        m_coolColor(DEFAULT_COOL_COLOR),
+        m_warmColor(DEFAULT_WARM_COLOR),
+        m_hotColor(DEFAULT_HOT_COLOR),
+        m_randomState(1U),
+        m_mutex()
     {
+        (void)m_mutex.create();
+        updatePalette();
     }
 
     /**
@@ -93,11 +111,8 @@ public:
      */
     ~FirePlugin()
     {
-        if (nullptr != m_heat)
-        {
-            delete[] m_heat;
-            m_heat = nullptr;
-        }
+        releaseBuffers();
+        m_mutex.destroy();
     }
 
     /**
@@ -113,6 +128,43 @@ public:
         return new FirePlugin(name, uid);
     }
 
+    /**
+     * Get plugin topics, which can be get/set via different communication
+     * interfaces like REST, websocket, MQTT, etc.
+     * 
+     * Example:
+     * {
+     *     "topics": [
+     *         "/palette"
+     *     ]
+     * }
+     * 
+     * @param[out] topics   Topis in JSON format
+     */
+    void getTopics(JsonArray& topics) const final;
+
+    /**
+     * Get a topic data.
+     * Note, currently only JSON format is supported.
+     * 
+     * @param[in]   topic   The topic which data shall be retrieved.
+     * @param[out]  value   The topic value in JSON format.
+     * 
+     * @return If successful it will return true otherwise false.
+     */
+    bool getTopic(const String& topic, JsonObject& value) const final;
+
+    /**
+     * Set a topic data.
+     * Note, currently only JSON format is supported.
+     * 
+     * @param[in]   topic   The topic which data shall be retrieved.
+     * @param[in]   value   The topic value in JSON format.
+     * 
+     * @return If successful it will return true otherwise false.
+     */
+    bool setTopic(const String& topic, const JsonObject& value) final;
+
     /**
      * Start the plugin. This is called only once during plugin lifetime.
      * It can be used as deferred initialization (after the constructor)
@@ -160,8 +212,32 @@ public:
 
 private:
 
-    uint8_t*    m_heat;     /**< Heat temperature [0; 255] */
-    size_t      m_heatSize; /**< Number of heat temperatures */
+    /** Number of palette colors, one per heat level. */
+    static const uint16_t   PALETTE_SIZE        = 256U;
+
+    /** Default palette color of cool heat: red */
+    static const uint32_t   DEFAULT_COOL_COLOR  = 0xFF0000U;
+
+    /** Default palette color of warm heat: yellow */
+    static const uint32_t   DEFAULT_WARM_COLOR  = 0xFFFF00U;
+
+    /** Default palette color of hot heat: white */
+    static const uint32_t   DEFAULT_HOT_COLOR   = 0xFFFFFFU;
+
+    /** Plugin topic, used for the palette. */
+    static const char*      TOPIC_PALETTE;
+
+    uint8_t*                m_heat;                 /**< Heat temperature [0; 255], row by row */
+    size_t                  m_heatSize;             /**< Number of heat temperatures */
+    uint16_t                m_width;                /**< Number of heat cells per row */
+    uint16_t                m_height;               /**< Number of heat rows */
+    Color*                  m_rowColors;            /**< Colors of one row, which are written at once to the display. */
+    Color                   m_palette[PALETTE_SIZE];/**< Color per heat level */
+    Color                   m_coolColor;            /**< Palette color of cool heat */
+    Color                   m_warmColor;            /**< Palette color of warm heat */
+    Color                   m_hotColor;             /**< Palette color of hot heat */
+    uint32_t                m_randomState;          /**< State of the pseudo random number generator */
+    mutable MutexRecursive  m_mutex;                /**< Mutex to protect against concurrent access. */
 
     /**
      * Cooling: How much does the air cool as it rises?
@@ -177,13 +253,69 @@ private:
     static const uint8_t    SPARKING    = 120U;
 
     /**
-     * Approximates a 'black body radiation' spectrum for a given 'heat' level.
-     * This is useful for animations of 'fire'.
-     * Heat is specified as an arbitrary scale from 0 (cool) to 255 (hot).
-     * This is NOT a chromatically correct 'black body radiation'
-     * spectrum, but it's surprisingly close, and it's fast and small.
+     * Release the heat and row color buffers.
+     */
+    void releaseBuffers();
+
+    /**
+     * Calculate the palette from the cool, warm and hot colors. The colors
+     * are linear interpolated, starting with black for no heat.
+     */
+    void updatePalette();
+
+    /**
+     * Get a pseudo random number in the range [min; max).
+     * A xorshift generator is used, because its fast and the fire needs
+     * a lot of random numbers every frame.
+     *
+     * @param[in] min   Lower bound, inclusive
+     * @param[in] max   Upper bound, exclusive
+     *
+     * @return Pseudo random number
+     */
+    uint8_t random8(uint8_t min, uint8_t max)
+    {
+        uint32_t range = max - min;
+
+        m_randomState ^= m_randomState << 13U;
+        m_randomState ^= m_randomState >> 17U;
+        m_randomState ^= m_randomState << 5U;
+
+        return min + static_cast<uint8_t>(((m_randomState & 0xFFFFU) * range) >> 16U);
+    }
+
+    /**
+     * Saves current configuration to the plugin configuration store.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool saveConfiguration() const;
+
+    /**
+     * Load configuration from the plugin configuration store.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool loadConfiguration();
+
+    /**
+     * Convert a color to a HTML color string, e.g. "#FF0000".
+     *
+     * @param[in] color Color
+     *
+     * @return HTML color string
+     */
+    static String colorToHtml(const Color& color);
+
+    /**
+     * Convert a HTML color string, e.g. "#FF0000", to a color.
+     *
+     * @param[in]  html     HTML color string
+     * @param[out] color    Color
+     *
+     * @return If successful converted, it will return true otherwise false.
      */
-    Color heatColor(uint8_t temperature);
+    static bool htmlToColor(const String& html, Color& color);
 };
 
 /******************************************************************************
@@ -35,10 +35,10 @@
 #include "GithubPlugin.h"
 #include "RestApi.h"
 #include "FileSystem.h"
+#include "PluginConfigStore.h"
 
 #include <Logging.h>
 #include <ArduinoJson.h>
-#include <JsonFile.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -163,7 +163,7 @@ void GithubPlugin::start(uint16_t width, uint16_t height)
     {
         if (false == saveConfiguration())
         {
-            LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
+            LOG_WARNING("Failed to create initial configuration of UID %u.", getUID());
         }
     }
 
@@ -174,15 +174,11 @@ void GithubPlugin::start(uint16_t width, uint16_t height)
 
 void GithubPlugin::stop()
 {
-    String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     m_requestTimer.stop();
 
-    if (false != FILESYSTEM.remove(configurationFilename))
-    {
-        LOG_INFO("File %s removed", configurationFilename.c_str());
-    }
+    PluginConfigStore::getInstance().remove(getUID());
 
     return;
 }
@@ -477,22 +473,20 @@ void GithubPlugin::handleWebResponse(const DynamicJsonDocument& jsonDoc)
 bool GithubPlugin::saveConfiguration() const
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["user"] = m_githubUser;
     jsonDoc["repository"] = m_githubRepository;
     
-    if (false == jsonFile.save(configurationFilename, jsonDoc))
+    if (false == PluginConfigStore::getInstance().save(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to save file %s.", configurationFilename.c_str());
+        LOG_WARNING("Failed to save configuration of UID %u.", getUID());
         status = false;
     }
     else
     {
-        LOG_INFO("File %s saved.", configurationFilename.c_str());
+        LOG_INFO("Configuration of UID %u saved.", getUID());
     }
 
     return status;
@@ -501,14 +495,12 @@ bool GithubPlugin::saveConfiguration() const
 bool GithubPlugin::loadConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    String              configurationFilename   = getFullPathToConfiguration();
 
-    if (false == jsonFile.load(configurationFilename, jsonDoc))
+    if (false == PluginConfigStore::getInstance().load(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to load file %s.", configurationFilename.c_str());
+        LOG_WARNING("Failed to load configuration of UID %u.", getUID());
         status = false;
     }
     else
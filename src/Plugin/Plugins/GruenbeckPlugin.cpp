@@ -36,10 +36,10 @@
 #include "RestApi.h"
 #include "AsyncHttpClient.h"
 #include "FileSystem.h"
+#include "PluginConfigStore.h"
 
 #include <ArduinoJson.h>
 #include <Logging.h>
-#include <JsonFile.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -155,7 +155,7 @@ void GruenbeckPlugin::start(uint16_t width, uint16_t height)
     {
         if (false == saveConfiguration())
         {
-            LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
+            LOG_WARNING("Failed to create initial configuration of UID %u.", getUID());
         }
     }
 
@@ -166,15 +166,11 @@ void GruenbeckPlugin::start(uint16_t width, uint16_t height)
 
 void GruenbeckPlugin::stop()
 {
-    String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     m_requestTimer.stop();
 
-    if (false != FILESYSTEM.remove(configurationFilename))
-    {
-        LOG_INFO("File %s removed", configurationFilename.c_str());
-    }
+    PluginConfigStore::getInstance().remove(getUID());
 
     return;
 }
@@ -370,6 +366,10 @@ bool GruenbeckPlugin::startHttpRequest()
 
 void GruenbeckPlugin::initHttpClient()
 {
+    /* The device is polled periodically, therefore keep the connection alive. */
+    m_client.setKeepAlive(true);
+    m_client.setIdleTimeout(2U * UPDATE_PERIOD);
+
     m_client.regOnResponse(
         [this](const HttpResponse& rsp)
         {
@@ -464,21 +464,19 @@ void GruenbeckPlugin::handleWebResponse(const DynamicJsonDocument& jsonDoc)
 bool GruenbeckPlugin::saveConfiguration() const
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["gruenbeckIP"] = m_ipAddress;
     
-    if (false == jsonFile.save(configurationFilename, jsonDoc))
+    if (false == PluginConfigStore::getInstance().save(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to save file %s.", configurationFilename.c_str());
+        LOG_WARNING("Failed to save configuration of UID %u.", getUID());
         status = false;
     }
     else
     {
-        LOG_INFO("File %s saved.", configurationFilename.c_str());
+        LOG_INFO("Configuration of UID %u saved.", getUID());
     }
 
     return status;
@@ -487,14 +485,12 @@ bool GruenbeckPlugin::saveConfiguration() const
 bool GruenbeckPlugin::loadConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    String              configurationFilename   = getFullPathToConfiguration();
 
-    if (false == jsonFile.load(configurationFilename, jsonDoc))
+    if (false == PluginConfigStore::getInstance().load(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to load file %s.", configurationFilename.c_str());
+        LOG_WARNING("Failed to load configuration of UID %u.", getUID());
         status = false;
     }
     else
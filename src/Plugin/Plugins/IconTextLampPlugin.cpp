@@ -260,7 +260,11 @@ void IconTextLampPlugin::start(uint16_t width, uint16_t height)
     const uint16_t              canvasWidth     = width - ICON_WIDTH;
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
+    /* All canvases have a background, so they repaint only their
+     * changed widgets.
+     */
     m_iconCanvas.setPosAndSize(0, 0, ICON_WIDTH, ICON_HEIGHT);
+    m_iconCanvas.setBackgroundColor(ColorDef::BLACK);
     (void)m_iconCanvas.addWidget(m_bitmapWidget);
 
     /* If there is already an icon in the filesystem, it will be loaded.
@@ -277,6 +281,7 @@ void IconTextLampPlugin::start(uint16_t width, uint16_t height)
      */
     tcHeight = height - 2U;
     m_textCanvas.setPosAndSize(ICON_WIDTH, 0, width - ICON_WIDTH, tcHeight);
+    m_textCanvas.setBackgroundColor(ColorDef::BLACK);
     (void)m_textCanvas.addWidget(m_textWidget);
 
     /* The text widget inside the text canvas is left aligned on x-axis and
@@ -291,6 +296,7 @@ void IconTextLampPlugin::start(uint16_t width, uint16_t height)
     }
 
     m_lampCanvas.setPosAndSize(ICON_WIDTH, height - 1, canvasWidth, 1U);
+    m_lampCanvas.setBackgroundColor(ColorDef::BLACK);
 
     if (true == calcLayout(canvasWidth, MAX_LAMPS, minDistance, minBorder, lampWidth, lampDistance))
     {
@@ -328,11 +334,26 @@ void IconTextLampPlugin::stop()
     }
 }
 
-void IconTextLampPlugin::update(YAGfx& gfx)
+void IconTextLampPlugin::active(YAGfx& gfx)
 {
     MutexGuard<MutexRecursive> guard(m_mutex);
 
+    /* The display content is unknown, therefore clear the area between
+     * the canvases and paint them completely.
+     */
     gfx.fillScreen(ColorDef::BLACK);
+    m_iconCanvas.invalidate();
+    m_textCanvas.invalidate();
+    m_lampCanvas.invalidate();
+
+    return;
+}
+
+void IconTextLampPlugin::update(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    /* Only changed widgets are painted again. */
     m_iconCanvas.update(gfx);
     m_textCanvas.update(gfx);
     m_lampCanvas.update(gfx);
@@ -71,6 +71,12 @@ const char* IconTextPlugin::FILE_EXT_BITMAP         = ".bmp";
 /* Initialize sprite sheet parameter filename extension. */
 const char* IconTextPlugin::FILE_EXT_SPRITE_SHEET   = ".sprite";
 
+/* Initialize animated GIF image filename extension. */
+const char* IconTextPlugin::FILE_EXT_GIF            = ".gif";
+
+/* Initialize sprite animation filename extension. */
+const char* IconTextPlugin::FILE_EXT_ANIMATION      = ".anim";
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -170,6 +176,20 @@ bool IconTextPlugin::isUploadAccepted(const String& topic, const String& srcFile
 
             isAccepted = true;
         }
+        /* Accept upload of a animated GIF file. */
+        else if (0U != srcFilename.endsWith(FILE_EXT_GIF))
+        {
+            dstFilename = getFileName(FILE_EXT_GIF);
+
+            isAccepted = true;
+        }
+        /* Accept upload of a sprite animation file. */
+        else if (0U != srcFilename.endsWith(FILE_EXT_ANIMATION))
+        {
+            dstFilename = getFileName(FILE_EXT_ANIMATION);
+
+            isAccepted = true;
+        }
         else
         {
             /* Not accepted. */
@@ -188,10 +208,12 @@ void IconTextPlugin::start(uint16_t width, uint16_t height)
     (void)m_iconCanvas.addWidget(m_bitmapWidget);
 
     /* If there is already an icon in the filesystem, it will be loaded.
-     * First check whether it is a animated sprite sheet and if not, try
-     * to load just a bitmap image.
+     * First check whether it is a animated GIF image, a sprite animation or
+     * a animated sprite sheet and if not, try to load just a bitmap image.
      */
-    if (false == m_bitmapWidget.loadSpriteSheet(FILESYSTEM, getFileName(FILE_EXT_SPRITE_SHEET), getFileName(FILE_EXT_BITMAP)))
+    if ((false == m_bitmapWidget.loadGif(FILESYSTEM, getFileName(FILE_EXT_GIF))) &&
+        (false == m_bitmapWidget.loadAnimation(FILESYSTEM, getFileName(FILE_EXT_ANIMATION))) &&
+        (false == m_bitmapWidget.loadSpriteSheet(FILESYSTEM, getFileName(FILE_EXT_SPRITE_SHEET), getFileName(FILE_EXT_BITMAP))))
     {
         (void)m_bitmapWidget.load(FILESYSTEM, getFileName(FILE_EXT_BITMAP));
     }
@@ -233,6 +255,16 @@ void IconTextPlugin::stop()
         LOG_INFO("File %s removed", getFileName(FILE_EXT_SPRITE_SHEET).c_str());
     }
 
+    if (false != FILESYSTEM.remove(getFileName(FILE_EXT_GIF)))
+    {
+        LOG_INFO("File %s removed", getFileName(FILE_EXT_GIF).c_str());
+    }
+
+    if (false != FILESYSTEM.remove(getFileName(FILE_EXT_ANIMATION)))
+    {
+        LOG_INFO("File %s removed", getFileName(FILE_EXT_ANIMATION).c_str());
+    }
+
     return;
 }
 
@@ -282,6 +314,8 @@ bool IconTextPlugin::loadBitmap(const String& filename)
         if (true == status)
         {
             (void)FILESYSTEM.remove(getFileName(FILE_EXT_SPRITE_SHEET));
+            (void)FILESYSTEM.remove(getFileName(FILE_EXT_GIF));
+            (void)FILESYSTEM.remove(getFileName(FILE_EXT_ANIMATION));
         }
     }
     else if (0U != filename.endsWith(FILE_EXT_SPRITE_SHEET))
@@ -291,6 +325,44 @@ bool IconTextPlugin::loadBitmap(const String& filename)
         bmpFilename.replace(FILE_EXT_SPRITE_SHEET, FILE_EXT_BITMAP);
 
         status = m_bitmapWidget.loadSpriteSheet(FILESYSTEM, filename,  bmpFilename);
+
+        /* The animated GIF image and the sprite animation would be
+         * preferred after a restart.
+         */
+        if (true == status)
+        {
+            (void)FILESYSTEM.remove(getFileName(FILE_EXT_GIF));
+            (void)FILESYSTEM.remove(getFileName(FILE_EXT_ANIMATION));
+        }
+    }
+    else if (0U != filename.endsWith(FILE_EXT_GIF))
+    {
+        status = m_bitmapWidget.loadGif(FILESYSTEM, filename);
+
+        /* Ensure that only the animated GIF image file exists in the
+         * filesystem, because the bitmap image and the sprite sheet are
+         * obsolete.
+         */
+        if (true == status)
+        {
+            (void)FILESYSTEM.remove(getFileName(FILE_EXT_BITMAP));
+            (void)FILESYSTEM.remove(getFileName(FILE_EXT_SPRITE_SHEET));
+            (void)FILESYSTEM.remove(getFileName(FILE_EXT_ANIMATION));
+        }
+    }
+    else if (0U != filename.endsWith(FILE_EXT_ANIMATION))
+    {
+        status = m_bitmapWidget.loadAnimation(FILESYSTEM, filename);
+
+        /* Ensure that only the sprite animation file exists in the
+         * filesystem, because the other files are obsolete.
+         */
+        if (true == status)
+        {
+            (void)FILESYSTEM.remove(getFileName(FILE_EXT_BITMAP));
+            (void)FILESYSTEM.remove(getFileName(FILE_EXT_SPRITE_SHEET));
+            (void)FILESYSTEM.remove(getFileName(FILE_EXT_GIF));
+        }
     }
     else
     {
@@ -231,13 +231,16 @@ public:
     void setText(const String& formatText);
 
     /**
-     * Load bitmap image / sprite sheet from filesystem.
+     * Load bitmap image / sprite sheet / animated GIF image / sprite
+     * animation from filesystem.
      * If a bitmap image is loaded, it will remove a corresponding sprite
-     * sheet file from filesystem.
+     * sheet file, GIF image file and sprite animation file from filesystem.
      * If a sprite sheet is loaded, it will load the texture file from
      * filesystem. This assumes that the texture file was uploaded before!
+     * If a GIF image or sprite animation is loaded, it will remove the
+     * other files.
      *
-     * @param[in] filename  Bitmap image / Sprite sheet filename
+     * @param[in] filename  Bitmap image / Sprite sheet / GIF image / Sprite animation filename
      *
      * @return If successul, it will return true otherwise false.
      */
@@ -275,6 +278,16 @@ private:
      */
     static const char*      FILE_EXT_SPRITE_SHEET;
 
+    /**
+     * Filename extension of animated GIF image file.
+     */
+    static const char*      FILE_EXT_GIF;
+
+    /**
+     * Filename extension of sprite animation file.
+     */
+    static const char*      FILE_EXT_ANIMATION;
+
     Fonts::FontType         m_fontType;         /**< Font type which shall be used if there is no conflict with the layout. */
     WidgetGroup             m_textCanvas;       /**< Canvas used for the text widget. */
     WidgetGroup             m_iconCanvas;       /**< Canvas used for the bitmap widget. */
@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "MatrixPlugin.h"
 
+#include <Logging.h>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -54,14 +56,38 @@
  * Local Variables
  *****************************************************************************/
 
+/* Initialize "matrix code" color. */
+const Color MatrixPlugin::CODE_COLOR(175U, 255U, 175U);
+
+/* Initialize trail color. */
+const Color MatrixPlugin::TRAIL_COLOR(27U, 130U, 39U);
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
+void MatrixPlugin::start(uint16_t width, uint16_t height)
+{
+    if (false == m_shader.create(width, height))
+    {
+        LOG_ERROR("Not enough memory for the shader.");
+    }
+
+    return;
+}
+
+void MatrixPlugin::stop()
+{
+    m_shader.release();
+
+    return;
+}
+
 void MatrixPlugin::active(YAGfx& gfx)
 {
-    /* Clear display */
+    /* Clear display and the shader state, which corresponds to it. */
     gfx.fillScreen(ColorDef::BLACK);
+    m_shader.reset();
 
     return;
 }
@@ -77,77 +103,17 @@ void MatrixPlugin::update(YAGfx& gfx)
     if ((false == m_timer.isTimerRunning()) ||
         (true == m_timer.isTimeout()))
     {
-        const Color     CODE_COLOR(175U, 255U, 175U);
-        const Color     TRAIL_COLOR(27U, 130U, 39U);
-        const uint16_t  SCALE_FACTOR_NUMERATOR      = 192U;
-        const uint16_t  SCALE_FACTOR_DENOMINATOR    = 256U;
-        int16_t         x       = 0;
-        int16_t         y       = 0;
-        Color           color;
-        uint8_t         red     = 0U;
-        uint8_t         green   = 0U;
-        uint8_t         blue    = 0U;
-
-        /* Move "matrix code" one pixel row down (higher y value) and fade each
-         * pixel a little more to dark to achieve a color trail.
-         */
-        for(y = gfx.getHeight() - 1; y > 0; --y)
+        /* Spawn new falling "matrix code". */
+        if (0 == random(2))
         {
-            for(x = 0; x < gfx.getWidth(); ++x)
-            {
-                /* Get pixel from one row above. */
-                color = gfx.getColor(x, y - 1);
-
-                /* If the pixel has the code color, change to first trail color. */
-                if (CODE_COLOR == color)
-                {
-                    color = TRAIL_COLOR;
-                }
-
-                /* Fade color (destructive) to dark for the trail effect. */
-                color.get(red, green, blue);
-                red = static_cast<uint16_t>(red) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
-                green = static_cast<uint16_t>(green) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
-                blue = static_cast<uint16_t>(blue) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
-                color.set(red, green, blue);
-
-                /* Draw pixel at current position. */
-                gfx.drawPixel(x, y, color);
-            }
+            m_shader.getKernel().setSpawn(random(gfx.getWidth()));
         }
-
-        /* The lowest row is handled separately, because the code color must
-         * move one row down (higher y value) for the lightning effect.
-         */
-        for(x = 0; x < gfx.getWidth(); ++x)
+        else
         {
-            /* Get Pixel */
-            color = gfx.getColor(x, 0);
-
-            /* Create color trail and lightning effect. */
-            if (CODE_COLOR == color)
-            {
-                color = TRAIL_COLOR;
-
-                gfx.drawPixel(x, y + 1, CODE_COLOR);
-            }
-
-            /* Fade color (destructive) to dark. */
-            color.get(red, green, blue);
-            red = static_cast<uint16_t>(red) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
-            green = static_cast<uint16_t>(green) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
-            blue = static_cast<uint16_t>(blue) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
-            color.set(red, green, blue);
-
-            gfx.drawPixel(x, y, color);
+            m_shader.getKernel().setSpawn(-1);
         }
 
-        /* Spawn new falling "matrix code". */
-        if (0 == random(2))
-        {
-            x = random(gfx.getWidth());
-            gfx.drawPixel(x, 0, CODE_COLOR);
-        }
+        m_shader.render(gfx);
 
         m_timer.start(UPDATE_PERIOD);
     }
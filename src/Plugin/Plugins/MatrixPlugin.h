@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include "Plugin.hpp"
 #include <SimpleTimer.hpp>
+#include <YAGfxShader.h>
 
 /******************************************************************************
  * Macros
@@ -57,6 +58,8 @@
 
 /**
  * Shows the effect from the film "Matrix" over the whole display.
+ * The color of every pixel is kept as shader state, instead of reading it
+ * back from the display.
  */
 class MatrixPlugin : public Plugin
 {
@@ -70,7 +73,8 @@ public:
      */
     MatrixPlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
-        m_timer()
+        m_timer(),
+        m_shader()
     {
     }
 
@@ -94,6 +98,29 @@ public:
         return new MatrixPlugin(name, uid);
     }
 
+    /**
+     * Start the plugin. This is called only once during plugin lifetime.
+     * It can be used as deferred initialization (after the constructor)
+     * and provides the canvas size.
+     * 
+     * If your display layout depends on canvas or font size, calculate it
+     * here.
+     * 
+     * Overwrite it if your plugin needs to know that it was installed.
+     * 
+     * @param[in] width     Display width in pixel
+     * @param[in] height    Display height in pixel
+     */
+    void start(uint16_t width, uint16_t height) final;
+
+   /**
+     * Stop the plugin. This is called only once during plugin lifetime.
+     * It can be used as a first clean-up, before the plugin will be destroyed.
+     * 
+     * Overwrite it if your plugin needs to know that it will be uninstalled.
+     */
+    void stop() final;
+
     /**
      * This method will be called in case the plugin is set active, which means
      * it will be shown on the display in the next step.
@@ -121,7 +148,108 @@ private:
     /** Display update period in ms. */
     static const uint32_t   UPDATE_PERIOD   = 100U;
 
-    SimpleTimer m_timer;    /**< Updates the display in a slower period than update() is called. */
+    /**
+     * Matrix kernel, which moves the "matrix code" one pixel row down
+     * (higher y value) and fades each pixel a little more to dark to
+     * achieve a color trail.
+     */
+    class Kernel : public YAGfxPixelKernel<Color, Kernel>
+    {
+    public:
+
+        /**
+         * Constructs the kernel.
+         */
+        Kernel() :
+            m_spawnX(-1)
+        {
+        }
+
+        /**
+         * Shade a single pixel.
+         *
+         * @param[in]   x       x-coordinate
+         * @param[in]   y       y-coordinate
+         * @param[in]   t       Fixed point time (not used)
+         * @param[in]   prev    Colors of the previous frame
+         * @param[out]  next    Color in the next frame
+         *
+         * @return Pixel color
+         */
+        Color shade(int16_t x, int16_t y, uint32_t t, const YAGfxShaderStateView<Color>& prev, Color& next)
+        {
+            (void)t;
+
+            /* The code color moves one row down for the lightning effect,
+             * while it leaves the trail color behind.
+             */
+            if ((1 == y) &&
+                (CODE_COLOR == prev.get(x, 0)))
+            {
+                next = CODE_COLOR;
+            }
+            else if ((0 == y) &&
+                     (m_spawnX == x))
+            {
+                next = CODE_COLOR;
+            }
+            else
+            {
+                next = fade(prev.get(x, (0 == y) ? 0 : (y - 1)));
+            }
+
+            return next;
+        }
+
+        /**
+         * Set the column, where new "matrix code" is spawned in the next frame.
+         *
+         * @param[in] x x-coordinate or -1 for no spawn.
+         */
+        void setSpawn(int16_t x)
+        {
+            m_spawnX = x;
+        }
+
+    private:
+
+        int16_t m_spawnX;   /**< Column of new "matrix code" or -1 for none */
+
+        /**
+         * Fade color (destructive) to dark for the trail effect. The code
+         * color changes to the first trail color.
+         *
+         * @param[in] color Color of the pixel in the previous frame.
+         *
+         * @return Faded color
+         */
+        static Color fade(const Color& color)
+        {
+            const uint16_t  SCALE_FACTOR_NUMERATOR      = 192U;
+            const uint16_t  SCALE_FACTOR_DENOMINATOR    = 256U;
+            Color           faded   = (CODE_COLOR == color) ? TRAIL_COLOR : color;
+            uint8_t         red     = 0U;
+            uint8_t         green   = 0U;
+            uint8_t         blue    = 0U;
+
+            faded.get(red, green, blue);
+            red = static_cast<uint16_t>(red) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
+            green = static_cast<uint16_t>(green) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
+            blue = static_cast<uint16_t>(blue) * SCALE_FACTOR_NUMERATOR / SCALE_FACTOR_DENOMINATOR;
+            faded.set(red, green, blue);
+
+            return faded;
+        }
+    };
+
+    /** Color of the "matrix code". */
+    static const Color      CODE_COLOR;
+
+    /** First color of the trail. */
+    static const Color      TRAIL_COLOR;
+
+    SimpleTimer         m_timer;    /**< Updates the display in a slower period than update() is called. */
+    YAGfxShader<Kernel> m_shader;   /**< Shader engine, which renders the matrix code */
 };
 
 /******************************************************************************
@@ -35,10 +35,10 @@
 #include "OpenWeatherPlugin.h"
 #include "RestApi.h"
 #include "FileSystem.h"
+#include "PluginConfigStore.h"
 
 #include <Logging.h>
 #include <ArduinoJson.h>
-#include <JsonFile.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -207,7 +207,7 @@ void OpenWeatherPlugin::start(uint16_t width, uint16_t height)
     {
         if (false == saveConfiguration())
         {
-            LOG_WARNING("Failed to create initial configuration file %s.", getFullPathToConfiguration().c_str());
+            LOG_WARNING("Failed to create initial configuration of UID %u.", getUID());
         }
     }
 
@@ -218,15 +218,11 @@ void OpenWeatherPlugin::start(uint16_t width, uint16_t height)
 
 void OpenWeatherPlugin::stop()
 {
-    String                      configurationFilename = getFullPathToConfiguration();
     MutexGuard<MutexRecursive>  guard(m_mutex);
 
     m_requestTimer.stop();
 
-    if (false != FILESYSTEM.remove(configurationFilename))
-    {
-        LOG_INFO("File %s removed", configurationFilename.c_str());
-    }
+    PluginConfigStore::getInstance().remove(getUID());
 
     return;
 }
@@ -838,10 +834,8 @@ void OpenWeatherPlugin::handleWebResponse(DynamicJsonDocument& jsonDoc)
 bool OpenWeatherPlugin::saveConfiguration() const
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    String              configurationFilename   = getFullPathToConfiguration();
 
     jsonDoc["apiKey"]   = m_apiKey;
     jsonDoc["lat"]      = m_latitude;
@@ -849,14 +843,14 @@ bool OpenWeatherPlugin::saveConfiguration() const
     jsonDoc["other"]    = static_cast<int>(m_additionalInformation);
     jsonDoc["units"]    = m_units;
     
-    if (false == jsonFile.save(configurationFilename, jsonDoc))
+    if (false == PluginConfigStore::getInstance().save(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to save file %s.", configurationFilename.c_str());
+        LOG_WARNING("Failed to save configuration of UID %u.", getUID());
         status = false;
     }
     else
     {
-        LOG_INFO("File %s saved.", configurationFilename.c_str());
+        LOG_INFO("Configuration of UID %u saved.", getUID());
     }
 
     return status;
@@ -865,14 +859,12 @@ bool OpenWeatherPlugin::saveConfiguration() const
 bool OpenWeatherPlugin::loadConfiguration()
 {
     bool                status                  = true;
-    JsonFile            jsonFile(FILESYSTEM);
     const size_t        JSON_DOC_SIZE           = 512U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-    String              configurationFilename   = getFullPathToConfiguration();
 
-    if (false == jsonFile.load(configurationFilename, jsonDoc))
+    if (false == PluginConfigStore::getInstance().load(getUID(), jsonDoc))
     {
-        LOG_WARNING("Failed to load file %s.", configurationFilename.c_str());
+        LOG_WARNING("Failed to load configuration of UID %u.", getUID());
         status = false;
     }
     else
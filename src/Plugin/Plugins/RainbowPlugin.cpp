@@ -34,6 +34,8 @@
  *****************************************************************************/
 #include "RainbowPlugin.h"
 
+#include <Logging.h>
+
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
@@ -58,25 +60,27 @@
  * Public Methods
  *****************************************************************************/
 
-void RainbowPlugin::update(YAGfx& gfx)
+void RainbowPlugin::start(uint16_t width, uint16_t height)
 {
-    int16_t x       = 0;
-    int16_t y       = 0;
-    uint8_t angle   = m_angle;
-    Color   color;
-
-    for(x = 0; x < gfx.getWidth(); ++x)
+    if (false == m_shader.create(width, height))
     {
-        for(y = 0; y < gfx.getHeight(); ++y)
-        {
-            color.turnColorWheel(angle + y * ANGLE_DELTA);
-            gfx.drawPixel(x, y, color);
-        }
-
-        angle += ANGLE_DELTA;
+        LOG_ERROR("Not enough memory for the shader.");
     }
 
-    m_angle += ANGLE_DELTA;
+    return;
+}
+
+void RainbowPlugin::stop()
+{
+    m_shader.release();
+
+    return;
+}
+
+void RainbowPlugin::update(YAGfx& gfx)
+{
+    m_shader.render(gfx);
+    m_shader.advance();
 
     return;
 }
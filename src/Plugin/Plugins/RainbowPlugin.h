@@ -45,6 +45,7 @@
  *****************************************************************************/
 #include <stdint.h>
 #include "Plugin.hpp"
+#include <YAGfxShader.h>
 
 /******************************************************************************
  * Macros
@@ -56,6 +57,7 @@
 
 /**
  * Shows a rainbow over the whole display. Moving from left to right.
+ * The rainbow is calculated by a stateless shader kernel.
  */
 class RainbowPlugin : public Plugin
 {
@@ -69,7 +71,7 @@ public:
      */
     RainbowPlugin(const String& name, uint16_t uid) :
         Plugin(name, uid),
-        m_angle(0U)
+        m_shader()
     {
     }
 
@@ -93,6 +95,29 @@ public:
         return new RainbowPlugin(name, uid);
     }
 
+    /**
+     * Start the plugin. This is called only once during plugin lifetime.
+     * It can be used as deferred initialization (after the constructor)
+     * and provides the canvas size.
+     * 
+     * If your display layout depends on canvas or font size, calculate it
+     * here.
+     * 
+     * Overwrite it if your plugin needs to know that it was installed.
+     * 
+     * @param[in] width     Display width in pixel
+     * @param[in] height    Display height in pixel
+     */
+    void start(uint16_t width, uint16_t height) final;
+
+   /**
+     * Stop the plugin. This is called only once during plugin lifetime.
+     * It can be used as a first clean-up, before the plugin will be destroyed.
+     * 
+     * Overwrite it if your plugin needs to know that it will be uninstalled.
+     */
+    void stop() final;
+
     /**
      * Update the display.
      * The scheduler will call this method periodically.
@@ -106,7 +131,40 @@ private:
     /** Angle step delta in degree, used for the color wheel. */
     static const uint8_t    ANGLE_DELTA = 1U;
 
-    uint8_t m_angle;    /**< Current color wheel angle */
+    /**
+     * Rainbow kernel, which derives the color wheel angle from the pixel
+     * position and the number of frames.
+     */
+    class Kernel : public YAGfxPixelKernel<YAGfxShaderNoState, Kernel>
+    {
+    public:
+
+        /**
+         * Shade a single pixel.
+         *
+         * @param[in]   x       x-coordinate
+         * @param[in]   y       y-coordinate
+         * @param[in]   t       Fixed point time in frames
+         * @param[in]   prev    State of the previous frame (not used)
+         * @param[out]  next    State in the next frame (not used)
+         *
+         * @return Pixel color
+         */
+        Color shade(int16_t x, int16_t y, uint32_t t, const YAGfxShaderStateView<YAGfxShaderNoState>& prev, YAGfxShaderNoState& next)
+        {
+            Color   color;
+            uint8_t angle   = (t >> YAGfxShader<Kernel>::TIME_FRAC_BITS) + x + y;
+
+            (void)prev;
+            (void)next;
+
+            color.turnColorWheel(angle * ANGLE_DELTA);
+
+            return color;
+        }
+    };
+
+    YAGfxShader<Kernel> m_shader;   /**< Shader engine, which renders the rainbow */
 };
 
 /******************************************************************************
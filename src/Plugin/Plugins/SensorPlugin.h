@@ -263,12 +263,12 @@ private:
     ISensorChannel* getChannel(uint8_t sensorIdx, uint8_t channelIdx);
 
     /**
-     * Saves current configuration to JSON file.
+     * Saves current configuration to the plugin configuration store.
      */
     bool saveConfiguration() const;
 
     /**
-     * Load configuration from JSON file.
+     * Load configuration from the plugin configuration store.
      */
     bool loadConfiguration();
 };
@@ -337,12 +337,12 @@ private:
     void handleWebResponse(DynamicJsonDocument& jsonDoc);
 
     /**
-     * Saves current configuration to JSON file.
+     * Saves current configuration to the plugin configuration store.
      */
     bool saveConfiguration() const;
 
     /**
-     * Load configuration from JSON file.
+     * Load configuration from the plugin configuration store.
      */
     bool loadConfiguration();
 
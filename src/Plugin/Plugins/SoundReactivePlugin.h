@@ -330,12 +330,12 @@ private:
     float                   m_peak;                         /**< Determined signal peak over all frequency bands in dB SPL, used for AGC. */
 
     /**
-     * Saves current configuration to JSON file.
+     * Saves current configuration to the plugin configuration store.
      */
     bool saveConfiguration() const;
 
     /**
-     * Load configuration from JSON file.
+     * Load configuration from the plugin configuration store.
      */
     bool loadConfiguration();
 };
@@ -66,8 +66,10 @@
 /**
  * Shows the current sunrise / sunset times for a configured location.
  *
- * At the first installation a json document is generated to the /configuration/UUID.json
- * in the filesystem, where the longitude and latidude have to be configured.
+ * At the first installation a default configuration is stored in the plugin
+ * configuration store. The longitude and latitude have to be configured via
+ * REST API or by uploading a /configuration/<uid>.json file, which is
+ * imported once.
  *
  * Powered by sunrise-sunset.org!
  */
@@ -360,12 +362,12 @@ private:
     String addCurrentTimezoneValues(const String& dateTimeString) const;
 
     /**
-     * Saves current configuration to JSON file.
+     * Saves current configuration to the plugin configuration store.
      */
     bool saveConfiguration() const;
 
     /**
-     * Load configuration from JSON file.
+     * Load configuration from the plugin configuration store.
      */
     bool loadConfiguration();
 
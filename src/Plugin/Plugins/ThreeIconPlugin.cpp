@@ -242,6 +242,9 @@ void ThreeIconPlugin::start(uint16_t width, uint16_t height)
 
     m_threeIconCanvas.setPosAndSize(0, 0, width, height);
 
+    /* With a background, the canvas repaints only its changed icons. */
+    m_threeIconCanvas.setBackgroundColor(ColorDef::BLACK);
+
     for(iconId = 0U; iconId < MAX_ICONS; ++iconId)
     { 
         int16_t x = (ICON_WIDTH + DISTANCE) * iconId + DISTANCE;
@@ -285,6 +288,17 @@ void ThreeIconPlugin::stop()
     return;
 }
 
+void ThreeIconPlugin::active(YAGfx& gfx)
+{
+    MutexGuard<MutexRecursive> guard(m_mutex);
+
+    /* The display content is unknown, therefore paint the canvas completely. */
+    gfx.fillScreen(ColorDef::BLACK);
+    m_threeIconCanvas.invalidate();
+
+    return;
+}
+
 void ThreeIconPlugin::update(YAGfx& gfx)
 {
     uint8_t                     iconId = 0U;
@@ -299,7 +313,7 @@ void ThreeIconPlugin::update(YAGfx& gfx)
         }
     }   
 
-    gfx.fillScreen(ColorDef::BLACK);
+    /* Only changed icons are painted again. */
     m_threeIconCanvas.update(gfx);
 
     return;
@@ -40,6 +40,10 @@
 #include "ClockDrv.h"
 #include "ButtonDrv.h"
 #include "DisplayMgr.h"
+#include "WebSocket.h"
+#include "RestApi.h"
+#include "PluginMgr.h"
+#include "MqttService.h"
 
 #include "ConnectingState.h"
 #include "RestartState.h"
@@ -121,6 +125,9 @@ void ConnectedState::entry(StateMachine& sm)
         /* Start the ClockDriver */
         ClockDrv::getInstance().init();
 
+        /* Connect to the MQTT broker, if configured. */
+        (void)MqttService::getInstance().start(hostname);
+
         /* Notify about successful network connection. */
         DisplayMgr::getInstance().setNetworkStatus(true);
 
@@ -177,6 +184,16 @@ void ConnectedState::process(StateMachine& sm)
     /* Handle update, there may be one in the background. */
     UpdateMgr::getInstance().process();
 
+    /* Push the display content to the websocket display stream subscribers. */
+    WebSocketSrv::getInstance().process();
+
+    /* Handle MQTT connection and received topic requests. */
+    MqttService::getInstance().process();
+
+    /* Apply coalesced display control requests. */
+    RestApi::process();
+    PluginMgr::getInstance().process();
+
     /* Restart requested by update manager? This may happen after a successful received
      * new firmware or filesystem binary.
      */
@@ -199,6 +216,9 @@ void ConnectedState::exit(StateMachine& sm)
 {
     UTIL_NOT_USED(sm);
 
+    /* Disconnect from MQTT broker. */
+    MqttService::getInstance().stop();
+
     /* Disconnect all connections */
     (void)WiFi.disconnect();
 
@@ -53,6 +53,8 @@
 #include "FileSystem.h"
 #include "JsonFile.h"
 #include "Version.h"
+#include "BootProfiler.h"
+#include "PluginConfigStore.h"
 
 #include "APState.h"
 #include "ConnectingState.h"
@@ -106,9 +108,10 @@ static const char*  WELCOME_PLUGIN_ALIAS    = "#welcome";
 
 void InitState::entry(StateMachine& sm)
 {
-    bool                isError             = false;
-    ErrorState::ErrorId errorId             = ErrorState::ERROR_ID_UNKNOWN;
-    const char*         VERSION_FILE_NAME   = "/version.json";
+    bool                isError         = false;
+    ErrorState::ErrorId errorId         = ErrorState::ERROR_ID_UNKNOWN;
+    BootProfiler&       bootProfiler    = BootProfiler::getInstance();
+    uint8_t             phaseId         = bootProfiler.begin("Board");
 
     /* Initialize hardware */
     Board::init();
@@ -116,6 +119,9 @@ void InitState::entry(StateMachine& sm)
     /* Show as soon as possible the user on the serial console that the system is booting. */
     showStartupInfoOnSerial();
 
+    bootProfiler.end(phaseId);
+    phaseId = bootProfiler.begin("Peripherals");
+
     /* Set two-wire (I2C) pins, before calling begin(). */
     if (false == Wire.setPins(Board::Pin::i2cSdaPinNo, Board::Pin::i2cSclPinNo))
     {
@@ -137,74 +143,99 @@ void InitState::entry(StateMachine& sm)
         errorId = ErrorState::ERROR_ID_NO_USER_BUTTON;
         isError = true;
     }
-    /* Mounting the filesystem. */
-    else if (false == FILESYSTEM.begin())
-    {
-        LOG_FATAL("Couldn't mount the filesystem.");
-        errorId = ErrorState::ERROR_ID_BAD_FS;
-        isError = true;
-    }
-    /* Check whether the filesystem is valid.
-     * This is simply done by checking for a specific file in the root directory.
-     */
-    else if (false == FILESYSTEM.exists(VERSION_FILE_NAME))
-    {
-        LOG_FATAL("Filesystem is invalid.");
-        errorId = ErrorState::ERROR_ID_BAD_FS;
-        isError = true;
-    }
     else
     {
-        /* Initialize sensors */
-        SensorDataProvider::getInstance().begin();
-
-        /* Prepare everything for the plugins. */
-        PluginMgr::getInstance().begin();
-
-        /* Register plugins. This must be done before system message handler is initialized! */
-        PluginList::registerAll();
+        /* The filesystem, the plugin configurations and the sensors don't depend
+         * on the display. They are initialized on the other core, while the
+         * display comes up. This shows the user as early as possible, that
+         * the system is alive. Everything, which depends on them, waits until
+         * the parallel initialization is finished.
+         */
+        startParallelInit();
     }
 
+    bootProfiler.end(phaseId);
+
     /* Continue only if there is no error yet. */
     if (true == isError)
     {
         /* Error detected. */
         ;
     }
-    /* Start display */
-    else if (false == Display::getInstance().begin())
+    else
     {
-        LOG_FATAL("Failed to initialize display.");
-        /* To set a error id here, makes no sense, because it can not be shown. */
-        isError = true;
+        phaseId = bootProfiler.begin("Display");
+
+        /* Start display */
+        if (false == Display::getInstance().begin())
+        {
+            LOG_FATAL("Failed to initialize display.");
+            /* To set a error id here, makes no sense, because it can not be shown. */
+            isError = true;
+        }
+        /* Initialize display manager */
+        else if (false == DisplayMgr::getInstance().begin())
+        {
+            LOG_FATAL("Failed to initialize display manager.");
+            errorId = ErrorState::ERROR_ID_DISP_MGR;
+            isError = true;
+        }
+        else
+        {
+            /* Display is ready. */
+            ;
+        }
+
+        bootProfiler.end(phaseId);
     }
-    /* Initialize display manager */
-    else if (false == DisplayMgr::getInstance().begin())
+
+    /* The parallel initialization must be finished in any case, before
+     * the plugin manager uses the filesystem or leaving.
+     */
+    if (true == isError)
     {
-        LOG_FATAL("Failed to initialize display manager.");
-        errorId = ErrorState::ERROR_ID_DISP_MGR;
-        isError = true;
+        (void)waitForParallelInit();
     }
-    /* Initialize system message handler */
-    else if (false == SysMsg::getInstance().init())
+    else
     {
-        LOG_FATAL("Failed to initialize system message handler.");
-        errorId = ErrorState::ERROR_ID_SYS_MSG;
-        isError = true;
+        errorId = waitForParallelInit();
+
+        if (ErrorState::ERROR_ID_NO_ERROR != errorId)
+        {
+            isError = true;
+        }
     }
-    /* Initialize over-the-air update server */
-    else if (false == UpdateMgr::getInstance().init())
+
+    /* Continue only if there is no error yet. */
+    if (true == isError)
     {
-        LOG_FATAL("Failed to initialize Arduino OTA.");
-        errorId = ErrorState::ERROR_ID_UPDATE_MGR;
-        isError = true;
+        /* Error detected. */
+        ;
     }
     else
     {
-        Settings*           settings = &Settings::getInstance();
-        JsonFile            jsonFile(FILESYSTEM);
-        const size_t        JSON_DOC_SIZE   = 512U;
-        DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+        phaseId = bootProfiler.begin("Plugins");
+
+        /* Prepare everything for the plugins. This must be done before the plugins are registered! */
+        PluginMgr::getInstance().begin();
+
+        /* Register plugins. This must be done before system message handler is initialized! */
+        PluginList::registerAll();
+
+        /* Initialize system message handler */
+        if (false == SysMsg::getInstance().init())
+        {
+            LOG_FATAL("Failed to initialize system message handler.");
+            errorId = ErrorState::ERROR_ID_SYS_MSG;
+            isError = true;
+        }
+
+        bootProfiler.end(phaseId);
+    }
+
+    if (false == isError)
+    {
+        Settings* settings = &Settings::getInstance();
 
         /* Load some general configuration parameters from persistent memory. */
         if (true == settings->open(true))
@@ -230,53 +261,45 @@ void InitState::entry(StateMachine& sm)
             settings->close();
         }
 
+        /* Show some informations on the display. */
+        bootProfiler.mark("First frame");
+        showStartupInfoOnDisplay();
+    }
+
+    /* Continue only if there is no error yet. */
+    if (true == isError)
+    {
+        /* Error detected. */
+        ;
+    }
+    /* Initialize over-the-air update server */
+    else if (false == UpdateMgr::getInstance().init())
+    {
+        LOG_FATAL("Failed to initialize Arduino OTA.");
+        errorId = ErrorState::ERROR_ID_UPDATE_MGR;
+        isError = true;
+    }
+    else
+    {
         /* Don't store the wifi configuration in the NVS.
          * This seems to cause a reset after a client connected to the access point.
          * https://github.com/espressif/arduino-esp32/issues/2025#issuecomment-503415364
          */
         WiFi.persistent(false);
 
-        /* Show some informations on the display. */
-        showStartupInfoOnDisplay();
-
         /* Show a warning in case the filesystem may not be compatible to the firmware version. */
-        if (true == jsonFile.load(VERSION_FILE_NAME, jsonDoc))
+        if (false == m_isFileSystemCompatible)
         {
-            JsonVariant jsonVersion             = jsonDoc["version"];
-            bool        isFileSystemCompatible  = true;
+            const uint32_t  DURATION_NON_SCROLLING  = 3000U; /* ms */
+            const uint32_t  SCROLLING_REPEAT_NUM    = 1U;
+            const uint32_t  DURATION_PAUSE          = 500U; /* ms */
+            const uint32_t  SCROLLING_NO_REPEAT     = 0U;
+            const char*     errMsg                  = "WARN: Filesystem may not be compatible.";
 
-            if (true == jsonVersion.isNull())
-            {
-                isFileSystemCompatible = false;
-            }
-            else
-            {
-                String fileSystemVersion    = jsonVersion.as<String>();
-                String firmwareVersion      = Version::SOFTWARE_VER;
+            LOG_WARNING(errMsg);
 
-                /* Note that the firmware version may have a additional postfix.
-                 * Example: v4.1.2:b or v4.1.2:b:lc
-                 * See ./scripts/get_get_rev.py for the different postfixes.
-                 */
-                if (0U == firmwareVersion.startsWith(fileSystemVersion))
-                {
-                    isFileSystemCompatible = false;
-                }
-            }
-
-            if (false == isFileSystemCompatible)
-            {
-                const uint32_t  DURATION_NON_SCROLLING  = 3000U; /* ms */
-                const uint32_t  SCROLLING_REPEAT_NUM    = 1U;
-                const uint32_t  DURATION_PAUSE          = 500U; /* ms */
-                const uint32_t  SCROLLING_NO_REPEAT     = 0U;
-                const char*     errMsg                  = "WARN: Filesystem may not be compatible.";
-
-                LOG_WARNING(errMsg);
-
-                SysMsg::getInstance().show(errMsg, DURATION_NON_SCROLLING, SCROLLING_REPEAT_NUM, true);
-                SysMsg::getInstance().show("", DURATION_PAUSE, SCROLLING_NO_REPEAT, true);
-            }
+            SysMsg::getInstance().show(errMsg, DURATION_NON_SCROLLING, SCROLLING_REPEAT_NUM, true);
+            SysMsg::getInstance().show("", DURATION_PAUSE, SCROLLING_NO_REPEAT, true);
         }
     }
 
@@ -320,8 +343,10 @@ void InitState::exit(StateMachine& sm)
     /* Continue initialization steps only, if there was no low level error before. */
     if (ErrorState::ERROR_ID_NO_ERROR == ErrorState::getInstance().getErrorId())
     {
-        wifi_mode_t wifiMode = WIFI_MODE_NULL;
-        String      hostname;
+        wifi_mode_t     wifiMode        = WIFI_MODE_NULL;
+        String          hostname;
+        BootProfiler&   bootProfiler    = BootProfiler::getInstance();
+        uint8_t         phaseId         = bootProfiler.begin("Network");
 
         /* Get hostname. */
         if (false == Settings::getInstance().open(true))
@@ -353,6 +378,7 @@ void InitState::exit(StateMachine& sm)
             LOG_FATAL(errorStr);
             SysMsg::getInstance().show(errorStr);
 
+            bootProfiler.end(phaseId);
             sm.setState(ErrorState::getInstance());
         }
         /* Enable mDNS */
@@ -364,14 +390,20 @@ void InitState::exit(StateMachine& sm)
             LOG_FATAL(errorStr);
             SysMsg::getInstance().show(errorStr);
 
+            bootProfiler.end(phaseId);
             sm.setState(ErrorState::getInstance());
         }
         else
         {
+            bootProfiler.end(phaseId);
+            phaseId = bootProfiler.begin("Webserver init");
+
             /* Initialize webserver. The filesystem must be mounted before! */
             MyWebServer::init(m_isApModeRequested);
             MDNS.addService("http", "tcp", WebConfig::WEBSERVER_PORT);
 
+            bootProfiler.end(phaseId);
+
             /* Do some stuff only in wifi station mode. */
             if (false == m_isApModeRequested)
             {
@@ -382,6 +414,8 @@ void InitState::exit(StateMachine& sm)
                 SysMsg::getInstance().show("...");
                 delay(500U); /* Just to avoid a short splash */
 
+                phaseId = bootProfiler.begin("Plugins");
+
                 /* Loading plugin installation failed? */
                 if (false == PluginMgr::getInstance().load())
                 {
@@ -416,6 +450,8 @@ void InitState::exit(StateMachine& sm)
                     }
                 }
 
+                bootProfiler.end(phaseId);
+
                 /* Start over-the-air update server. */
                 UpdateMgr::getInstance().begin();
                 MDNS.enableArduino(WebConfig::ARDUINO_OTA_PORT, true); /* This typically set by ArduinoOTA, but is disabled there. */
@@ -430,6 +466,8 @@ void InitState::exit(StateMachine& sm)
         }
     }
 
+    BootProfiler::getInstance().finish();
+
     return;
 }
 
@@ -441,6 +479,152 @@ void InitState::exit(StateMachine& sm)
  * Private Methods
  *****************************************************************************/
 
+void InitState::startParallelInit()
+{
+    /* Reset results from a previous run. */
+    m_parallelInitErrorId       = ErrorState::ERROR_ID_UNKNOWN;
+    m_isFileSystemCompatible    = true;
+
+    /* Create binary semaphore to signal the end of the parallel initialization. */
+    m_parallelInitSemaphore = xSemaphoreCreateBinary();
+
+    if (nullptr != m_parallelInitSemaphore)
+    {
+        BaseType_t osRet = xTaskCreateUniversal(parallelInitTask,
+                                                "parallelInitTask",
+                                                PARALLEL_INIT_TASK_STACK_SIZE,
+                                                this,
+                                                PARALLEL_INIT_TASK_PRIORITY,
+                                                nullptr,
+                                                PARALLEL_INIT_TASK_RUN_CORE);
+
+        /* Couldn't task be created? */
+        if (pdPASS != osRet)
+        {
+            vSemaphoreDelete(m_parallelInitSemaphore);
+            m_parallelInitSemaphore = nullptr;
+        }
+    }
+
+    /* If the task couldn't be created, initialize sequentially. */
+    if (nullptr == m_parallelInitSemaphore)
+    {
+        LOG_WARNING("Parallel initialization not possible.");
+        initInParallel();
+    }
+
+    return;
+}
+
+ErrorState::ErrorId InitState::waitForParallelInit()
+{
+    if (nullptr != m_parallelInitSemaphore)
+    {
+        uint8_t phaseId = BootProfiler::getInstance().begin("Wait for parallel init");
+
+        (void)xSemaphoreTake(m_parallelInitSemaphore, portMAX_DELAY);
+
+        BootProfiler::getInstance().end(phaseId);
+
+        vSemaphoreDelete(m_parallelInitSemaphore);
+        m_parallelInitSemaphore = nullptr;
+    }
+
+    return m_parallelInitErrorId;
+}
+
+void InitState::parallelInitTask(void* parameters)
+{
+    InitState* tthis = static_cast<InitState*>(parameters);
+
+    if (nullptr != tthis)
+    {
+        tthis->initInParallel();
+
+        (void)xSemaphoreGive(tthis->m_parallelInitSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+}
+
+void InitState::initInParallel()
+{
+    const char*         VERSION_FILE_NAME   = "/version.json";
+    BootProfiler&       bootProfiler        = BootProfiler::getInstance();
+    uint8_t             phaseId             = bootProfiler.begin("Filesystem");
+    ErrorState::ErrorId errorId             = ErrorState::ERROR_ID_NO_ERROR;
+
+    /* Mounting the filesystem. */
+    if (false == FILESYSTEM.begin())
+    {
+        LOG_FATAL("Couldn't mount the filesystem.");
+        errorId = ErrorState::ERROR_ID_BAD_FS;
+    }
+    /* Check whether the filesystem is valid.
+     * This is simply done by checking for a specific file in the root directory.
+     */
+    else if (false == FILESYSTEM.exists(VERSION_FILE_NAME))
+    {
+        LOG_FATAL("Filesystem is invalid.");
+        errorId = ErrorState::ERROR_ID_BAD_FS;
+    }
+    else
+    {
+        JsonFile            jsonFile(FILESYSTEM);
+        const size_t        JSON_DOC_SIZE   = 512U;
+        DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+        /* Check whether the filesystem is compatible to the firmware version. */
+        if (true == jsonFile.load(VERSION_FILE_NAME, jsonDoc))
+        {
+            JsonVariant jsonVersion = jsonDoc["version"];
+
+            if (true == jsonVersion.isNull())
+            {
+                m_isFileSystemCompatible = false;
+            }
+            else
+            {
+                String fileSystemVersion    = jsonVersion.as<String>();
+                String firmwareVersion      = Version::SOFTWARE_VER;
+
+                /* Note that the firmware version may have a additional postfix.
+                 * Example: v4.1.2:b or v4.1.2:b:lc
+                 * See ./scripts/get_get_rev.py for the different postfixes.
+                 */
+                if (0U == firmwareVersion.startsWith(fileSystemVersion))
+                {
+                    m_isFileSystemCompatible = false;
+                }
+            }
+        }
+    }
+
+    bootProfiler.end(phaseId);
+
+    if (ErrorState::ERROR_ID_NO_ERROR == errorId)
+    {
+        phaseId = bootProfiler.begin("Plugin configuration");
+
+        /* Load the plugin configuration index. The plugin manager isn't
+         * touched here, because the plugins are registered by the main task.
+         */
+        PluginConfigStore::getInstance().begin();
+
+        bootProfiler.end(phaseId);
+        phaseId = bootProfiler.begin("Sensors");
+
+        /* Initialize sensors */
+        SensorDataProvider::getInstance().begin();
+
+        bootProfiler.end(phaseId);
+    }
+
+    m_parallelInitErrorId = errorId;
+
+    return;
+}
+
 void InitState::showStartupInfoOnSerial()
 {
     LOG_INFO("PIXELIX starts up ...");
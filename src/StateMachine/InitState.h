@@ -46,6 +46,10 @@
 #include <stdint.h>
 #include <StateMachine.hpp>
 #include <IPluginMaintenance.hpp>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include "ErrorState.h"
 
 /******************************************************************************
  * Macros
@@ -59,6 +63,11 @@
  * Initialization state:
  * - Initializes the board.
  * - Check for user button press during start up.
+ *
+ * The filesystem, the plugin configuration store and the sensors are
+ * initialized in a separate task on the other core, while the display
+ * comes up. The plugin manager and the plugins are initialized afterwards
+ * by the main task. The boot phases are recorded by the boot profiler.
  */
 class InitState : public AbstractState
 {
@@ -99,13 +108,28 @@ public:
 
 private:
 
-    bool    m_isApModeRequested;    /**< Is wifi AP mode requested? */
+    /** The parallel initialization task stack size in bytes. The task exists only during startup. */
+    static const uint32_t       PARALLEL_INIT_TASK_STACK_SIZE   = 8192U;
+
+    /** The parallel initialization task shall run on the core, which is not used by the Arduino loop task. */
+    static const BaseType_t     PARALLEL_INIT_TASK_RUN_CORE     = PRO_CPU_NUM;
+
+    /** The parallel initialization task priority shall be equal than the Arduino loop task priority. */
+    static const UBaseType_t    PARALLEL_INIT_TASK_PRIORITY     = 1U;
+
+    bool                        m_isApModeRequested;        /**< Is wifi AP mode requested? */
+    SemaphoreHandle_t           m_parallelInitSemaphore;    /**< Signals the end of the parallel initialization. */
+    ErrorState::ErrorId         m_parallelInitErrorId;      /**< Result of the parallel initialization. */
+    bool                        m_isFileSystemCompatible;   /**< Is the filesystem compatible to the firmware version? */
 
     /**
      * Constructs the state.
      */
     InitState() :
-        m_isApModeRequested(false)
+        m_isApModeRequested(false),
+        m_parallelInitSemaphore(nullptr),
+        m_parallelInitErrorId(ErrorState::ERROR_ID_UNKNOWN),
+        m_isFileSystemCompatible(true)
     {
     }
 
@@ -119,6 +143,33 @@ private:
     InitState(const InitState& state);
     InitState& operator=(const InitState& state);
 
+    /**
+     * Start the initialization steps, which are independent of the display,
+     * in a separate task. If the task can not be created, they will be
+     * done sequentially.
+     */
+    void startParallelInit();
+
+    /**
+     * Wait until the parallel initialization is finished.
+     *
+     * @return Error id of the parallel initialization. ERROR_ID_NO_ERROR if successful.
+     */
+    ErrorState::ErrorId waitForParallelInit();
+
+    /**
+     * Parallel initialization task.
+     *
+     * @param[in] parameters    Task parameters, which is the init state instance.
+     */
+    static void parallelInitTask(void* parameters);
+
+    /**
+     * Mount and check the filesystem, load the plugin configuration index and
+     * initialize the sensors.
+     */
+    void initInParallel();
+
     /**
      * Show startup information on the serial interface.
      */
@@ -37,6 +37,7 @@
 #include "MyWebServer.h"
 #include "UpdateMgr.h"
 #include "FileSystem.h"
+#include "PluginConfigStore.h"
 
 #include <Board.h>
 #include <Display.h>
@@ -93,6 +94,9 @@ void RestartState::process(StateMachine& sm)
         UpdateMgr::getInstance().end();
         MDNS.end();
 
+        /* Write pending plugin configurations */
+        PluginConfigStore::getInstance().flush();
+
         /* Unmount filesystem */
         FILESYSTEM.end();
 
@@ -0,0 +1,439 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming gzip inflater
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "GzipInflater.h"
+
+#include <string.h>
+#include <new>
+#include <rom/crc.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint32_t readUInt32LE(const uint8_t* data);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** gzip magic bytes */
+static const uint8_t    GZIP_MAGIC[2U]  = { 0x1FU, 0x8BU };
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+GzipInflater::GzipInflater() :
+    m_state(STATE_ERROR),
+    m_output(),
+    m_decompressor(nullptr),
+    m_window(nullptr),
+    m_windowIdx(0U),
+    m_buffer(),
+    m_bufferIdx(0U),
+    m_flags(0U),
+    m_skip(0U),
+    m_crc(0U),
+    m_outputSize(0U)
+{
+}
+
+GzipInflater::~GzipInflater()
+{
+    release();
+}
+
+bool GzipInflater::begin(const Output& output)
+{
+    bool isSuccessful = false;
+
+    release();
+
+    m_decompressor  = new(std::nothrow) tinfl_decompressor;
+    m_window        = new(std::nothrow) uint8_t[WINDOW_SIZE];
+
+    if ((nullptr == m_decompressor) ||
+        (nullptr == m_window) ||
+        (nullptr == output))
+    {
+        release();
+    }
+    else
+    {
+        tinfl_init(m_decompressor);
+
+        m_state         = STATE_HEADER;
+        m_output        = output;
+        m_windowIdx     = 0U;
+        m_bufferIdx     = 0U;
+        m_flags         = 0U;
+        m_skip          = 0U;
+        m_crc           = 0U;
+        m_outputSize    = 0U;
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool GzipInflater::write(const uint8_t* data, size_t size)
+{
+    if ((false == isRunning()) ||
+        (nullptr == data))
+    {
+        m_state = STATE_ERROR;
+    }
+
+    while((0U < size) &&
+          (STATE_ERROR != m_state) &&
+          (STATE_FINISHED != m_state))
+    {
+        switch(m_state)
+        {
+        case STATE_HEADER:
+            if (true == collect(data, size, HEADER_SIZE))
+            {
+                if ((GZIP_MAGIC[0U] != m_buffer[0U]) ||
+                    (GZIP_MAGIC[1U] != m_buffer[1U]) ||
+                    (METHOD_DEFLATE != m_buffer[2U]))
+                {
+                    m_state = STATE_ERROR;
+                }
+                else
+                {
+                    m_flags = m_buffer[3U];
+                    nextHeaderField();
+                }
+            }
+            break;
+
+        case STATE_EXTRA_LEN:
+            if (true == collect(data, size, 2U))
+            {
+                m_skip  = static_cast<size_t>(m_buffer[0U]) | (static_cast<size_t>(m_buffer[1U]) << 8U);
+                m_state = STATE_EXTRA;
+
+                if (0U == m_skip)
+                {
+                    nextHeaderField();
+                }
+            }
+            break;
+
+        case STATE_EXTRA:
+            {
+                size_t len = (size < m_skip) ? size : m_skip;
+
+                data    += len;
+                size    -= len;
+                m_skip  -= len;
+
+                if (0U == m_skip)
+                {
+                    nextHeaderField();
+                }
+            }
+            break;
+
+        case STATE_NAME:
+            /* fallthrough */
+        case STATE_COMMENT:
+            {
+                uint8_t value = *data;
+
+                ++data;
+                --size;
+
+                if ('\0' == value)
+                {
+                    nextHeaderField();
+                }
+            }
+            break;
+
+        case STATE_HEADER_CRC:
+            if (true == collect(data, size, 2U))
+            {
+                nextHeaderField();
+            }
+            break;
+
+        case STATE_DEFLATE:
+            inflate(data, size);
+            break;
+
+        case STATE_TRAILER:
+            if (true == collect(data, size, TRAILER_SIZE))
+            {
+                if ((m_crc != readUInt32LE(&m_buffer[0U])) ||
+                    (m_outputSize != readUInt32LE(&m_buffer[4U])))
+                {
+                    m_state = STATE_ERROR;
+                }
+                else
+                {
+                    m_state = STATE_FINISHED;
+                }
+            }
+            break;
+
+        default:
+            m_state = STATE_ERROR;
+            break;
+        }
+    }
+
+    /* Any data after the first gzip member is ignored. */
+
+    return (STATE_ERROR != m_state);
+}
+
+bool GzipInflater::end()
+{
+    bool isSuccessful = (STATE_FINISHED == m_state);
+
+    release();
+
+    return isSuccessful;
+}
+
+bool GzipInflater::isGzip(const uint8_t* data, size_t size)
+{
+    bool isGzipStream = false;
+
+    if ((nullptr != data) &&
+        (sizeof(GZIP_MAGIC) <= size) &&
+        (GZIP_MAGIC[0U] == data[0U]) &&
+        (GZIP_MAGIC[1U] == data[1U]))
+    {
+        isGzipStream = true;
+    }
+
+    return isGzipStream;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool GzipInflater::collect(const uint8_t*& data, size_t& size, size_t needed)
+{
+    bool    isComplete  = false;
+    size_t  len         = needed - m_bufferIdx;
+
+    if (size < len)
+    {
+        len = size;
+    }
+
+    memcpy(&m_buffer[m_bufferIdx], data, len);
+    m_bufferIdx += len;
+    data        += len;
+    size        -= len;
+
+    if (needed == m_bufferIdx)
+    {
+        m_bufferIdx = 0U;
+        isComplete  = true;
+    }
+
+    return isComplete;
+}
+
+void GzipInflater::nextHeaderField()
+{
+    bool isFound = false;
+
+    /* The optional header fields follow in a fixed order, every one is
+     * enabled by its flag.
+     */
+    while(false == isFound)
+    {
+        switch(m_state)
+        {
+        case STATE_HEADER:
+            m_state = STATE_EXTRA_LEN;
+            isFound = (0U != (m_flags & FLAG_EXTRA));
+            break;
+
+        case STATE_EXTRA_LEN:
+            /* fallthrough */
+        case STATE_EXTRA:
+            m_state = STATE_NAME;
+            isFound = (0U != (m_flags & FLAG_NAME));
+            break;
+
+        case STATE_NAME:
+            m_state = STATE_COMMENT;
+            isFound = (0U != (m_flags & FLAG_COMMENT));
+            break;
+
+        case STATE_COMMENT:
+            m_state = STATE_HEADER_CRC;
+            isFound = (0U != (m_flags & FLAG_HCRC));
+            break;
+
+        default:
+            m_state = STATE_DEFLATE;
+            isFound = true;
+            break;
+        }
+    }
+
+    return;
+}
+
+void GzipInflater::inflate(const uint8_t*& data, size_t& size)
+{
+    tinfl_status status = TINFL_STATUS_FAILED;
+
+    do
+    {
+        size_t  inSize  = size;
+        size_t  outSize = WINDOW_SIZE - m_windowIdx;
+
+        status = tinfl_decompress(m_decompressor, data, &inSize, m_window, &m_window[m_windowIdx], &outSize, TINFL_FLAG_HAS_MORE_INPUT);
+
+        data += inSize;
+        size -= inSize;
+
+        if (0U < outSize)
+        {
+            m_crc           = crc32_le(m_crc, &m_window[m_windowIdx], outSize);
+            m_outputSize    += outSize;
+
+            if (false == m_output(&m_window[m_windowIdx], outSize))
+            {
+                status = TINFL_STATUS_FAILED;
+            }
+
+            /* The window size is a power of two. */
+            m_windowIdx = (m_windowIdx + outSize) & (WINDOW_SIZE - 1U);
+        }
+    }
+    while(TINFL_STATUS_HAS_MORE_OUTPUT == status);
+
+    if (TINFL_STATUS_DONE == status)
+    {
+        /* The decoder may have read the first bytes of the trailer already
+         * into its bit buffer. Take them over, after skipping the remaining
+         * bits of the last deflate byte.
+         */
+        uint32_t    numBits = m_decompressor->m_num_bits;
+        uint32_t    bitBuf  = m_decompressor->m_bit_buf >> (numBits & 7U);
+
+        numBits >>= 3U;
+        while((0U < numBits) && (TRAILER_SIZE > m_bufferIdx))
+        {
+            m_buffer[m_bufferIdx] = static_cast<uint8_t>(bitBuf & 0xFFU);
+            ++m_bufferIdx;
+            bitBuf >>= 8U;
+            --numBits;
+        }
+
+        m_state = STATE_TRAILER;
+    }
+    else if (0 > status)
+    {
+        m_state = STATE_ERROR;
+    }
+    else
+    {
+        /* Decompression continues with the next data part. */
+        ;
+    }
+
+    return;
+}
+
+void GzipInflater::release()
+{
+    if (nullptr != m_decompressor)
+    {
+        delete m_decompressor;
+        m_decompressor = nullptr;
+    }
+
+    if (nullptr != m_window)
+    {
+        delete[] m_window;
+        m_window = nullptr;
+    }
+
+    m_output = nullptr;
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Read 32-bit unsigned integer in little endian order.
+ *
+ * @param[in] data  Data
+ *
+ * @return Value
+ */
+static uint32_t readUInt32LE(const uint8_t* data)
+{
+    return  static_cast<uint32_t>(data[0U]) |
+            (static_cast<uint32_t>(data[1U]) << 8U) |
+            (static_cast<uint32_t>(data[2U]) << 16U) |
+            (static_cast<uint32_t>(data[3U]) << 24U);
+}
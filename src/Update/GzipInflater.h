@@ -0,0 +1,245 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming gzip inflater
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup update
+ *
+ * @{
+ */
+
+#ifndef __GZIP_INFLATER_H__
+#define __GZIP_INFLATER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <rom/miniz.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Decompresses a gzip stream, which is received in arbitrary sized parts.
+ * The deflate decoder of the ROM is used, with its dictionary as bounded
+ * circular output window. Every decompressed part of the window is handed
+ * over to the output function, which typically writes it to the update
+ * partition. Therefore the whole image is never hold in memory.
+ *
+ * The CRC32 and the size of the decompressed data are verified with the
+ * gzip trailer.
+ */
+class GzipInflater
+{
+public:
+
+    /**
+     * Output function, called for every decompressed part.
+     *
+     * @param[in] data  Decompressed data
+     * @param[in] size  Size of decompressed data in byte
+     *
+     * @return If the data was successful processed, it will return true otherwise false.
+     */
+    typedef std::function<bool(const uint8_t* data, size_t size)> Output;
+
+    /**
+     * Constructs the inflater.
+     */
+    GzipInflater();
+
+    /**
+     * Destroys the inflater.
+     */
+    ~GzipInflater();
+
+    /**
+     * Start decompression of a new gzip stream.
+     * The decoder and its window buffer are allocated here.
+     *
+     * @param[in] output    Output function for the decompressed data
+     *
+     * @return If successful started, it will return true otherwise false.
+     */
+    bool begin(const Output& output);
+
+    /**
+     * Decompress the next part of the gzip stream.
+     *
+     * @param[in] data  Next part of the gzip stream
+     * @param[in] size  Size of the part in byte
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool write(const uint8_t* data, size_t size);
+
+    /**
+     * Finish the decompression and release the decoder and its window buffer.
+     *
+     * @return If the whole gzip stream was received and is valid, it will return true otherwise false.
+     */
+    bool end();
+
+    /**
+     * Is a decompression in progress?
+     *
+     * @return If started, it will return true otherwise false.
+     */
+    bool isRunning() const
+    {
+        return (nullptr != m_decompressor);
+    }
+
+    /**
+     * Get number of decompressed bytes.
+     *
+     * @return Number of decompressed bytes
+     */
+    uint32_t getOutputSize() const
+    {
+        return m_outputSize;
+    }
+
+    /**
+     * Checks whether the data starts with the gzip magic bytes.
+     *
+     * @param[in] data  Data
+     * @param[in] size  Size of data in byte
+     *
+     * @return If gzip stream, it will return true otherwise false.
+     */
+    static bool isGzip(const uint8_t* data, size_t size);
+
+    /** Size of the window buffer in byte. It is given by the deflate algorithm. */
+    static const size_t WINDOW_SIZE = TINFL_LZ_DICT_SIZE;
+
+private:
+
+    /**
+     * States of the gzip stream parser.
+     */
+    enum State
+    {
+        STATE_HEADER = 0,   /**< Fixed size header */
+        STATE_EXTRA_LEN,    /**< Length of the optional extra field */
+        STATE_EXTRA,        /**< Optional extra field */
+        STATE_NAME,         /**< Optional zero terminated original filename */
+        STATE_COMMENT,      /**< Optional zero terminated comment */
+        STATE_HEADER_CRC,   /**< Optional header CRC16 */
+        STATE_DEFLATE,      /**< Compressed data */
+        STATE_TRAILER,      /**< Trailer with CRC32 and size */
+        STATE_FINISHED,     /**< Whole stream received */
+        STATE_ERROR         /**< Invalid stream or output failed */
+    };
+
+    /** Size of the fixed gzip header in byte. */
+    static const size_t     HEADER_SIZE         = 10U;
+
+    /** Size of the gzip trailer in byte. */
+    static const size_t     TRAILER_SIZE        = 8U;
+
+    /** Compression method deflate. */
+    static const uint8_t    METHOD_DEFLATE      = 8U;
+
+    /** Header flag: Header CRC16 follows. */
+    static const uint8_t    FLAG_HCRC           = 0x02U;
+
+    /** Header flag: Extra field follows. */
+    static const uint8_t    FLAG_EXTRA          = 0x04U;
+
+    /** Header flag: Original filename follows. */
+    static const uint8_t    FLAG_NAME           = 0x08U;
+
+    /** Header flag: Comment follows. */
+    static const uint8_t    FLAG_COMMENT        = 0x10U;
+
+    State               m_state;            /**< Current parser state */
+    Output              m_output;           /**< Output function */
+    tinfl_decompressor* m_decompressor;     /**< Deflate decoder */
+    uint8_t*            m_window;           /**< Circular output window */
+    size_t              m_windowIdx;        /**< Write position in the output window */
+    uint8_t             m_buffer[HEADER_SIZE]; /**< Collects header and trailer fields */
+    size_t              m_bufferIdx;        /**< Number of collected bytes */
+    uint8_t             m_flags;            /**< Header flags */
+    size_t              m_skip;             /**< Number of bytes to skip in the current state */
+    uint32_t            m_crc;              /**< CRC32 of the decompressed data */
+    uint32_t            m_outputSize;       /**< Number of decompressed bytes */
+
+    GzipInflater(const GzipInflater& inflater);
+    GzipInflater& operator=(const GzipInflater& inflater);
+
+    /**
+     * Collect bytes into the internal buffer.
+     *
+     * @param[in,out]   data    Input data, will be moved forward
+     * @param[in,out]   size    Input data size, will be decreased
+     * @param[in]       needed  Number of bytes, which shall be collected
+     *
+     * @return If all needed bytes are collected, it will return true otherwise false.
+     */
+    bool collect(const uint8_t*& data, size_t& size, size_t needed);
+
+    /**
+     * Continue parsing the header after the current header field.
+     */
+    void nextHeaderField();
+
+    /**
+     * Decompress the given data and hand over the output.
+     *
+     * @param[in,out]   data    Input data, will be moved forward
+     * @param[in,out]   size    Input data size, will be decreased
+     */
+    void inflate(const uint8_t*& data, size_t& size);
+
+    /**
+     * Release the decoder and the window buffer.
+     */
+    void release();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __GZIP_INFLATER_H__ */
+
+/** @} */
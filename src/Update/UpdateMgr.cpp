@@ -162,6 +162,8 @@ void UpdateMgr::beginProgress()
 
         m_updateIsRunning   = true;
         m_progress          = UINT8_MAX; // Force update
+        m_timestamp         = millis();
+        m_statistics        = Statistics();
         m_textWidget.setFormatStr("Update");
 
         /* Show user update status */
@@ -198,7 +200,7 @@ void UpdateMgr::updateProgress(uint8_t progress)
         }
 
         /* Show update status on console. */
-        LOG_INFO(String("[") + m_progress + "%]");
+        LOG_INFO("[%u%%] %u byte/s", m_progress, m_statistics.throughput);
     }
 
     return;
@@ -208,6 +210,12 @@ void UpdateMgr::endProgress()
 {
     if (true == m_isInitialized)
     {
+        LOG_INFO("Received %u byte, written %u byte in %u ms (%u byte/s).",
+            m_statistics.received,
+            m_statistics.written,
+            m_statistics.duration,
+            m_statistics.throughput);
+
         /* Start display manager */
         if (false == DisplayMgr::getInstance().begin())
         {
@@ -218,6 +226,21 @@ void UpdateMgr::endProgress()
     return;
 }
 
+void UpdateMgr::updateStatistics(uint32_t received, uint32_t written)
+{
+    m_statistics.received   = received;
+    m_statistics.written    = written;
+    m_statistics.duration   = millis() - m_timestamp;
+
+    if (0U < m_statistics.duration)
+    {
+        /* Calculate in 64 bit to avoid an overflow for big images. */
+        m_statistics.throughput = static_cast<uint32_t>((static_cast<uint64_t>(received) * 1000U) / m_statistics.duration);
+    }
+
+    return;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -232,7 +255,9 @@ UpdateMgr::UpdateMgr() :
     m_progress(0U),
     m_isRestartReq(false),
     m_textWidget(),
-    m_progressBar()
+    m_progressBar(),
+    m_timestamp(0U),
+    m_statistics()
 {
     /* Move text for a better look. */
     m_textWidget.move(1, 1);
@@ -294,6 +319,8 @@ void UpdateMgr::onProgress(unsigned int progress, unsigned int total)
 {
     const uint32_t  PROGRESS_PERCENT    = (progress * 100U) / total;
 
+    /* The ArduinoOTA writes the received image directly to the update partition. */
+    getInstance().updateStatistics(progress, progress);
     getInstance().updateProgress(PROGRESS_PERCENT);
 
     return;
@@ -63,6 +63,17 @@ class UpdateMgr
 {
 public:
 
+    /**
+     * Transfer statistics of the current or last update.
+     */
+    struct Statistics
+    {
+        uint32_t    received;   /**< Number of received bytes */
+        uint32_t    written;    /**< Number of bytes written to the update partition */
+        uint32_t    duration;   /**< Duration since begin of the update in ms */
+        uint32_t    throughput; /**< Received bytes per second */
+    };
+
     /**
      * Get update manager instance.
      * 
@@ -145,6 +156,25 @@ public:
      */
     void endProgress(void);
 
+    /**
+     * Update the transfer statistics. In case of a compressed image, the
+     * number of written bytes is greater than the number of received bytes.
+     *
+     * @param[in] received  Number of received bytes
+     * @param[in] written   Number of bytes written to the update partition
+     */
+    void updateStatistics(uint32_t received, uint32_t written);
+
+    /**
+     * Get transfer statistics of the current or last update.
+     *
+     * @return Transfer statistics
+     */
+    const Statistics& getStatistics() const
+    {
+        return m_statistics;
+    }
+
     /** Over-the-air update password */
     static const char*  OTA_PASSWORD;
 
@@ -176,6 +206,12 @@ private:
     /** During the update the user shall be informed about the update progress. */
     ProgressBar         m_progressBar;
 
+    /** Timestamp in ms of the update begin. */
+    uint32_t            m_timestamp;
+
+    /** Transfer statistics of the current or last update. */
+    Statistics          m_statistics;
+
     /**
      * Constructs the update manager.
      */
@@ -33,10 +33,12 @@
  * Includes
  *****************************************************************************/
 #include "AsyncHttpClient.h"
+#include "MemTag.h"
 
 #include <Util.h>
 #include <Logging.h>
 #include <base64.h>
+#include <TraceRecorder.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -67,11 +69,16 @@ AsyncHttpClient::AsyncHttpClient() :
     m_processTaskExit(false),
     m_processTaskSemaphore(nullptr),
     m_tcpClient(),
-    m_cmdQueue(),
     m_evtQueue(),
     m_mutex(),
     m_isConnected(false),
-    m_isReqOpen(false),
+    m_requests(),
+    m_reqIdx(0U),
+    m_reqCnt(0U),
+    m_reqSentCnt(0U),
+    m_reqHostname(),
+    m_reqPort(0U),
+    m_reqIsSecure(false),
     m_onRspCallback(nullptr),
     m_onClosedCallback(),
     m_onErrorCallback(),
@@ -81,13 +88,23 @@ AsyncHttpClient::AsyncHttpClient() :
     m_base64Authorization(),
     m_uri(),
     m_headers(),
-    m_method(),
     m_userAgent("AsyncHttpClient"),
     m_isHttpVer10(false),
     m_isKeepAlive(false),
+    m_idleTimeout(DEFAULT_IDLE_TIMEOUT),
+    m_maxRequests(DEFAULT_MAX_REQUESTS),
     m_urlEncodedPars(),
-    m_payload(nullptr),
-    m_payloadSize(0U),
+    m_isConnecting(false),
+    m_isDisconnecting(false),
+    m_isConnReusable(false),
+    m_isConnPersistent(false),
+    m_connHostname(),
+    m_connPort(0U),
+    m_connIsSecure(false),
+    m_connReqCnt(0U),
+    m_connReqLimit(DEFAULT_MAX_REQUESTS),
+    m_connIdleTimeout(DEFAULT_IDLE_TIMEOUT),
+    m_lastActivity(0U),
     m_rspPart(RESPONSE_PART_STATUS_LINE),
     m_rsp(),
     m_rspLine(),
@@ -98,7 +115,6 @@ AsyncHttpClient::AsyncHttpClient() :
     m_chunkIndex(0U),
     m_chunkBodyPart(CHUNK_SIZE)
 {
-    (void)m_cmdQueue.create(CMD_QUEUE_SIZE);
     (void)m_evtQueue.create(EVT_QUEUE_SIZE);
     (void)m_mutex.create();
 
@@ -189,41 +205,27 @@ AsyncHttpClient::~AsyncHttpClient()
     m_tcpClient.onError(nullptr);
     m_tcpClient.onData(nullptr);
     m_tcpClient.onTimeout(nullptr);
-    m_mutex.destroy();
     clearEvtQueue();
-    clearCmdQueue();
+    clearRequests();
+    m_mutex.destroy();
     m_evtQueue.destroy();
-    m_cmdQueue.destroy();
 }
 
 bool AsyncHttpClient::begin(const String& url)
 {
     bool    status      = true;
     int     index       = url.indexOf(':');
-    bool    isReqOpen   = false;
 
     if (nullptr == m_processTaskHandle)
     {
         status = createProcessTask();
     }
 
-    /* Protect against concurrent access. */
-    {
-        MutexGuard<Mutex>   guard(m_mutex);
-        
-        isReqOpen = m_isReqOpen;
-    }
-
     /* Task couldn't be created? */
     if (false == status)
     {
         ;
     }
-    /* If a response is pending, abort. */
-    else if (true == isReqOpen)
-    {
-        status = false;
-    }
     /* The URL must contain the protocol. */
     else if (0 > index)
     {
@@ -287,6 +289,7 @@ bool AsyncHttpClient::begin(const String& url)
             {
                 auth = host.substring(0, index);
                 m_base64Authorization = base64::encode(auth);
+                m_base64Authorization.replace("\n", "");
 
                 /* Remove authorization from host string. */
                 host.remove(0, index + 1);
@@ -340,6 +343,23 @@ bool AsyncHttpClient::begin(const String& url)
             }
         }
 
+        /* Requests to a different host must be finished first,
+         * because they are sent on a single connection.
+         */
+        if (true == status)
+        {
+            MutexGuard<Mutex>   guard(m_mutex);
+
+            if ((0U < m_reqCnt) &&
+                ((m_reqHostname != m_hostname) ||
+                 (m_reqPort != m_port) ||
+                 (m_reqIsSecure != m_isSecure)))
+            {
+                LOG_WARNING("Requests to %s pending.", m_reqHostname.c_str());
+                status = false;
+            }
+        }
+
         if (false == status)
         {
             clear();
@@ -352,9 +372,10 @@ bool AsyncHttpClient::begin(const String& url)
 void AsyncHttpClient::end()
 {
     destroyProcessTask();
-    clearCmdQueue();
     clearEvtQueue();
+    clearRequests();
     clear();
+    clearRsp();
 }
 
 bool AsyncHttpClient::isConnected()
@@ -375,6 +396,16 @@ void AsyncHttpClient::setKeepAlive(bool keepAlive)
     m_isKeepAlive = keepAlive;
 }
 
+void AsyncHttpClient::setIdleTimeout(uint32_t idleTimeout)
+{
+    m_idleTimeout = idleTimeout;
+}
+
+void AsyncHttpClient::setMaxRequests(uint32_t maxRequests)
+{
+    m_maxRequests = maxRequests;
+}
+
 void AsyncHttpClient::addHeader(const String& name, const String& value)
 {
     /* Only add header if not handled by the client itself. */
@@ -435,36 +466,17 @@ void AsyncHttpClient::regOnError(const OnError& onError)
 
 bool AsyncHttpClient::GET()
 {
-    Cmd cmd;
-    
-    memset(&cmd, 0, sizeof(cmd));
-    cmd.id = CMD_ID_GET;
-
-    return m_cmdQueue.sendToBack(cmd, portMAX_DELAY);
+    return enqueueRequest("GET", true, nullptr, 0U);
 }
 
 bool AsyncHttpClient::POST(const uint8_t* payload, size_t size)
 {
-    Cmd cmd;
-    
-    memset(&cmd, 0, sizeof(cmd));
-    cmd.id = CMD_ID_POST;
-    cmd.u.data.data = payload;
-    cmd.u.data.size = size;
-
-    return m_cmdQueue.sendToBack(cmd, portMAX_DELAY);
+    return enqueueRequest("POST", false, payload, size);
 }
 
 bool AsyncHttpClient::POST(const String& payload)
 {
-    Cmd cmd;
-    
-    memset(&cmd, 0, sizeof(cmd));
-    cmd.id = CMD_ID_POST;
-    cmd.u.data.data = reinterpret_cast<const uint8_t*>(payload.c_str());
-    cmd.u.data.size = payload.length();
-
-    return m_cmdQueue.sendToBack(cmd, portMAX_DELAY);
+    return enqueueRequest("POST", false, reinterpret_cast<const uint8_t*>(payload.c_str()), payload.length());
 }
 
 /******************************************************************************
@@ -534,14 +546,20 @@ void AsyncHttpClient::destroyProcessTask()
     return;
 }
 
-void AsyncHttpClient::clearCmdQueue()
+void AsyncHttpClient::clearRequests()
 {
-    Cmd cmd;
+    MutexGuard<Mutex>   guard(m_mutex);
 
-    while(true == m_cmdQueue.receive(&cmd, 0U))
+    while(0U < m_reqCnt)
     {
-        (void)cmd;
+        m_requests[m_reqIdx].payload        = nullptr;
+        m_requests[m_reqIdx].payloadSize    = 0U;
+
+        m_reqIdx = (m_reqIdx + 1U) % MAX_PENDING_REQUESTS;
+        --m_reqCnt;
     }
+
+    m_reqSentCnt = 0U;
 }
 
 void AsyncHttpClient::clearEvtQueue()
@@ -573,8 +591,10 @@ void AsyncHttpClient::processTask(void* parameters)
 
         while(false == tthis->m_processTaskExit)
         {
-            tthis->processCmdQueue();
+            MemTagGuard memTagGuard(MemTag::ID_HTTP_CLIENT);
+
             tthis->processEvtQueue();
+            tthis->processRequests();
 
             delay(PROCESS_TASK_PERIOD);
         }
@@ -590,26 +610,81 @@ void AsyncHttpClient::processTask(void* parameters)
     return;
 }
 
-void AsyncHttpClient::processCmdQueue()
+void AsyncHttpClient::processRequests()
 {
-    Cmd cmd;
+    size_t  reqCnt      = 0U;
+    size_t  reqSentCnt  = 0U;
+    bool    isSameHost  = false;
 
-    while(true == m_cmdQueue.receive(&cmd, 0U))
+    /* Protect against concurrent access. */
     {
-        switch(cmd.id)
+        MutexGuard<Mutex>   guard(m_mutex);
+
+        reqCnt      = m_reqCnt;
+        reqSentCnt  = m_reqSentCnt;
+
+        if (0U < reqCnt)
         {
-        case CMD_ID_GET:
-            (void)getRequest();
-            break;
+            isSameHost = (m_reqHostname == m_connHostname) &&
+                         (m_reqPort == m_connPort) &&
+                         (m_reqIsSecure == m_connIsSecure);
 
-        case CMD_ID_POST:
-            (void)postRequest(cmd.u.data.data, cmd.u.data.size);
-            break;
+            /* The target of a new connection is the host of the pending requests. */
+            if ((false == m_isConnected) &&
+                (false == m_isConnecting))
+            {
+                m_connHostname  = m_reqHostname;
+                m_connPort      = m_reqPort;
+                m_connIsSecure  = m_reqIsSecure;
+            }
+        }
+    }
 
-        default:
-            break;
-        };
+    /* Wait until the connection is established or closed. */
+    if ((true == m_isConnecting) ||
+        (true == m_isDisconnecting))
+    {
+        ;
     }
+    else if (0U == reqCnt)
+    {
+        /* Close a kept-alive connection after the idle timeout. */
+        if ((true == m_isConnected) &&
+            (m_connIdleTimeout <= (millis() - m_lastActivity)))
+        {
+            LOG_INFO("Connection idle.");
+
+            m_isDisconnecting = m_tcpClient.connected();
+            disconnect();
+        }
+    }
+    else if (false == m_isConnected)
+    {
+        if (false == connect())
+        {
+            LOG_WARNING("Failed to connect.");
+
+            clearRequests();
+            notifyError();
+        }
+        else
+        {
+            m_isConnecting = true;
+        }
+    }
+    /* The connection can't be used for the pending requests? */
+    else if ((false == isSameHost) ||
+             ((false == m_isConnReusable) && (0U == reqSentCnt)))
+    {
+        m_isDisconnecting = m_tcpClient.connected();
+        disconnect();
+    }
+    else
+    {
+        sendRequests();
+    }
+
+    return;
 }
 
 void AsyncHttpClient::processEvtQueue()
@@ -618,6 +693,8 @@ void AsyncHttpClient::processEvtQueue()
 
     while(true == m_evtQueue.receive(&evt, 0U))
     {
+        TRACE_SCOPE("AsyncHttpClient::evt", evt.id);
+
         switch(evt.id)
         {
         case EVENT_ID_CONNECTED:
@@ -655,31 +732,31 @@ void AsyncHttpClient::processEvtQueue()
 
 void AsyncHttpClient::onConnect()
 {
-    bool isReqOpen = false;
-
     LOG_INFO("Connected.");
 
     /* Protect against concurrent access. */
     {
         MutexGuard<Mutex>   guard(m_mutex);
 
-        m_isConnected   = true;
-        isReqOpen       = m_isReqOpen;
-        m_isReqOpen     = false;
+        m_isConnected = true;
     }
 
-    /* Is there a queued request, which to send? */
-    if (true == isReqOpen)
-    {
-        if (false == sendRequest())
-        {
-            m_tcpClient.close();
-        }
-    }
+    m_isConnecting      = false;
+    m_isDisconnecting   = false;
+    m_isConnReusable    = true;
+    m_isConnPersistent  = false;
+    m_connReqCnt        = 0U;
+    m_connReqLimit      = m_maxRequests;
+    m_connIdleTimeout   = m_idleTimeout;
+    m_lastActivity      = millis();
+
+    /* The pending requests are sent by the next processing cycle. */
 }
 
 void AsyncHttpClient::onDisconnect()
 {
+    size_t lostCnt = 0U;
+
     LOG_INFO("Disconnected.");
 
     /* Protect against concurrent access. */
@@ -687,10 +764,50 @@ void AsyncHttpClient::onDisconnect()
         MutexGuard<Mutex>   guard(m_mutex);
         
         m_isConnected = false;
+
+        /* The server may close a kept-alive connection at any time, even if
+         * the requests are already sent. Idempotent requests are sent once
+         * again on a new connection, all others are lost.
+         */
+        while((0U < m_reqSentCnt) &&
+              ((false == m_requests[m_reqIdx].isIdempotent) ||
+               (true == m_requests[m_reqIdx].isRetried)))
+        {
+            m_requests[m_reqIdx].payload        = nullptr;
+            m_requests[m_reqIdx].payloadSize    = 0U;
+
+            m_reqIdx = (m_reqIdx + 1U) % MAX_PENDING_REQUESTS;
+            --m_reqCnt;
+            --m_reqSentCnt;
+            ++lostCnt;
+        }
+
+        while(0U < m_reqSentCnt)
+        {
+            --m_reqSentCnt;
+            m_requests[(m_reqIdx + m_reqSentCnt) % MAX_PENDING_REQUESTS].isRetried = true;
+        }
     }
 
-    clear();
+    m_isConnecting      = false;
+    m_isDisconnecting   = false;
+    m_isConnReusable    = false;
+    m_isConnPersistent  = false;
+
+    clearRsp();
     notifyClosed();
+
+    /* Every lost request is reported, because no response will follow. */
+    if (0U < lostCnt)
+    {
+        LOG_WARNING("%u request(s) lost.", lostCnt);
+
+        while(0U < lostCnt)
+        {
+            notifyError();
+            --lostCnt;
+        }
+    }
 }
 
 void AsyncHttpClient::onError(int8_t error)
@@ -714,6 +831,13 @@ void AsyncHttpClient::onError(int8_t error)
     }
 
     notifyError();
+
+    /* All pending requests are lost. */
+    clearRequests();
+    m_isConnecting      = false;
+    m_isConnReusable    = false;
+
+    m_isDisconnecting = m_tcpClient.connected();
     disconnect();
 }
 
@@ -765,13 +889,34 @@ void AsyncHttpClient::onData(const uint8_t* data, size_t len)
                 }
                 else if (TRANSFER_CODING_IDENTITY == m_transferCoding)
                 {
-                    /* "Content-Length" may be missing. */
-                    if (0U == m_contentLength)
+                    /* "Content-Length" may be missing. In this case the end
+                     * of the response can't be determined reliable and the
+                     * connection can't be used for further requests.
+                     */
+                    if ((0U == m_contentLength) &&
+                        (true == m_rsp.getHeader("Content-Length").isEmpty()))
                     {
                         m_contentLength = len - index;
+                        m_isConnReusable = false;
                     }
                 }
-                m_rspPart = RESPONSE_PART_BODY;
+                else
+                {
+                    /* Nothing to do. */
+                    ;
+                }
+
+                /* Response without body? */
+                if ((false == isError) &&
+                    (TRANSFER_CODING_IDENTITY == m_transferCoding) &&
+                    (0U == m_contentLength))
+                {
+                    completeResponse();
+                }
+                else
+                {
+                    m_rspPart = RESPONSE_PART_BODY;
+                }
             }
             break;
 
@@ -780,11 +925,7 @@ void AsyncHttpClient::onData(const uint8_t* data, size_t len)
             {
                 if (true == parseChunkedResponse(data, len, index))
                 {
-                    notifyResponse();
-
-                    m_transferCoding = TRANSFER_CODING_IDENTITY;
-                    m_rspPart = RESPONSE_PART_STATUS_LINE;
-                    m_rsp.clear();
+                    completeResponse();
                 }
             }
             else
@@ -808,12 +949,7 @@ void AsyncHttpClient::onData(const uint8_t* data, size_t len)
 
                 if (m_contentLength <= m_contentIndex)
                 {
-                    notifyResponse();
-
-                    m_rspPart = RESPONSE_PART_STATUS_LINE;
-                    m_rsp.clear();
-                    m_contentLength = 0U;
-                    m_contentIndex = 0U;
+                    completeResponse();
                 }
             }
             break;
@@ -837,9 +973,9 @@ void AsyncHttpClient::onTimeout(uint32_t timeout)
 
 bool AsyncHttpClient::connect()
 {
-    LOG_INFO("Connecting to %s:%u ...", m_hostname.c_str(), m_port);
+    LOG_INFO("Connecting to %s:%u ...", m_connHostname.c_str(), m_connPort);
 
-    return m_tcpClient.connect(m_hostname.c_str(), m_port, m_isSecure);
+    return m_tcpClient.connect(m_connHostname.c_str(), m_connPort, m_connIsSecure);
 }
 
 void AsyncHttpClient::disconnect()
@@ -860,90 +996,48 @@ void AsyncHttpClient::abort()
     }
 }
 
-bool AsyncHttpClient::getRequest()
+bool AsyncHttpClient::enqueueRequest(const char* method, bool isIdempotent, const uint8_t* payload, size_t size)
 {
-    bool status     = false;
-    bool isReqOpen  = false;
+    bool                status  = false;
+    MutexGuard<Mutex>   guard(m_mutex);
 
-    /* Protect against concurrent access. */
+    if (true == m_hostname.isEmpty())
     {
-        MutexGuard<Mutex>   guard(m_mutex);
-
-        isReqOpen = m_isReqOpen;
+        LOG_WARNING("No host.");
     }
-
-    if (false == isReqOpen)
+    else if (MAX_PENDING_REQUESTS <= m_reqCnt)
     {
-        m_method        = "GET";
-        m_payload       = nullptr;
-        m_payloadSize   = 0U;
-
-        if (false == m_tcpClient.connected())
-        {
-            status = connect();
-            isReqOpen = status;
-        }
-        else
-        {
-            status = sendRequest();
-            isReqOpen = false;
-        }
-
-        /* Protect against concurrent access. */
-        {
-            MutexGuard<Mutex>   guard(m_mutex);
-
-            m_isReqOpen = isReqOpen;
-        }
+        LOG_WARNING("Too many pending requests.");
     }
-
-    return status;
-}
-
-bool AsyncHttpClient::postRequest(const uint8_t* payload, size_t size)
-{
-    bool status     = false;
-    bool isReqOpen  = false;
-
-    /* Protect against concurrent access. */
+    else
     {
-        MutexGuard<Mutex>   guard(m_mutex);
+        Request& req = m_requests[(m_reqIdx + m_reqCnt) % MAX_PENDING_REQUESTS];
 
-        isReqOpen = m_isReqOpen;
-    }
+        serializeRequest(req, method, payload, size);
 
-    if (false == isReqOpen)
-    {
-        m_method        = "POST";
-        m_payload       = payload;
-        m_payloadSize   = size;
+        req.isKeepAlive     = m_isKeepAlive;
+        req.isPipelinable   = (true == isIdempotent) && (true == m_isKeepAlive) && (false == m_isHttpVer10);
+        req.isIdempotent    = isIdempotent;
+        req.isRetried       = false;
 
-        if (false == m_tcpClient.connected())
-        {
-            status = connect();
-            isReqOpen = status;
-        }
-        else
+        /* The first request determines the host for all following requests. */
+        if (0U == m_reqCnt)
         {
-            status = sendRequest();
-            isReqOpen = false;
+            m_reqHostname   = m_hostname;
+            m_reqPort       = m_port;
+            m_reqIsSecure   = m_isSecure;
         }
 
-        /* Protect against concurrent access. */
-        {
-            MutexGuard<Mutex>   guard(m_mutex);
-
-            m_isReqOpen = isReqOpen;
-        }
+        ++m_reqCnt;
+        status = true;
     }
 
     return status;
 }
 
-bool AsyncHttpClient::sendRequest()
+void AsyncHttpClient::serializeRequest(Request& req, const char* method, const uint8_t* payload, size_t size)
 {
-    bool        status      = false;
-    String      request;
+    String&     request     = req.header;
     const char* PROTOCOL    = "HTTP";
     const char* SP          = " ";
     const char* CRLF        = "\r\n";
@@ -956,12 +1050,19 @@ bool AsyncHttpClient::sendRequest()
      *            CRLF
      *            [ message-body ]
      *
+     * The "Connection" header and the terminating CRLF are added, when the
+     * request is sent, because only then it is known whether the connection
+     * shall be kept alive.
      */
 
+    /* Clearing keeps the allocated buffer, which is reused for every request. */
+    request.clear();
+    (void)request.reserve(REQUEST_HEADER_SIZE);
+
     /* Request-Line: Method SP Request-URI SP HTTP-Version CRLF */
 
     /* Method */
-    request += m_method;
+    request += method;
     request += SP;
 
     /* Request-URI    = "*" | absoluteURI | abs_path | authority */
@@ -1013,22 +1114,6 @@ bool AsyncHttpClient::sendRequest()
     request += m_userAgent;
     request += CRLF;
 
-    /* HTTP/1.1 defines the "close" connection option for the sender to
-     * signal that the connection will be closed after completion of the
-     * response.
-     */
-    request += "Connection: ";
-
-    if (false == m_isKeepAlive)
-    {
-        request += "close";
-    }
-    else
-    {
-        request += "keep-alive";
-    }
-    request += CRLF;
-
     if (false == m_isHttpVer10)
     {
         /* By the client supported transfer codings. */
@@ -1039,7 +1124,6 @@ bool AsyncHttpClient::sendRequest()
 
     if (0U < m_base64Authorization.length())
     {
-        m_base64Authorization.replace("\n", "");
         request += "Authorization: Basic ";
         request += m_base64Authorization;
         request += CRLF;
@@ -1050,45 +1134,205 @@ bool AsyncHttpClient::sendRequest()
      * a user payload is available, in this case the URL encoded parameters
      * are skipped.
      */
-    if ((nullptr != m_payload) &&
-        (0U < m_payloadSize))
+    req.body.clear();
+
+    if ((nullptr != payload) &&
+        (0U < size))
     {
         request += "Content-Length: ";
-        request += m_payloadSize;
+        request += size;
         request += CRLF;
 
+        req.payload     = payload;
+        req.payloadSize = size;
+
         if (false == m_urlEncodedPars.isEmpty())
         {
             LOG_WARNING("Parameters skipped.");
         }
     }
-    else if (false == m_urlEncodedPars.isEmpty())
+    else
     {
-        request += "Content-Type: application/x-www-form-urlencoded";
-        request += CRLF;
-        request += "Content-Length: ";
-        request += m_urlEncodedPars.length();
-        request += CRLF;
+        if (false == m_urlEncodedPars.isEmpty())
+        {
+            request += "Content-Type: application/x-www-form-urlencoded";
+            request += CRLF;
+            request += "Content-Length: ";
+            request += m_urlEncodedPars.length();
+            request += CRLF;
 
-        m_payload       = reinterpret_cast<const uint8_t*>(m_urlEncodedPars.c_str());
-        m_payloadSize   = m_urlEncodedPars.length();
+            req.body = m_urlEncodedPars;
+        }
+
+        req.payload     = nullptr;
+        req.payloadSize = 0U;
     }
 
     request += m_headers;
-    request += CRLF;
 
-    /* Send header */
-    status = (request.length() == m_tcpClient.write(request.c_str(), request.length()));
+    return;
+}
 
-    /* Send payload */
-    if ((true == status) &&
-        (nullptr != m_payload) &&
-        (0U < m_payloadSize))
+void AsyncHttpClient::sendRequests()
+{
+    const char* CONNECTION_KEEP_ALIVE   = "Connection: keep-alive\r\n\r\n";
+    const char* CONNECTION_CLOSE        = "Connection: close\r\n\r\n";
+    size_t      reqIdx                  = 0U;
+    size_t      reqCnt                  = 0U;
+    size_t      reqSentCnt              = 0U;
+    size_t      reqSentCntBefore        = 0U;
+    bool        isStopped               = false;
+    bool        isFailed                = false;
+
+    /* Protect against concurrent access.
+     * Only the process task removes requests, the application only adds
+     * requests behind the last one. Therefore the snapshot stays valid
+     * without holding the mutex during the transmission.
+     */
     {
-        status = (m_payloadSize == m_tcpClient.write(reinterpret_cast<const char*>(m_payload), m_payloadSize, 0));
+        MutexGuard<Mutex>   guard(m_mutex);
+
+        reqIdx      = m_reqIdx;
+        reqCnt      = m_reqCnt;
+        reqSentCnt  = m_reqSentCnt;
     }
 
-    return status;
+    reqSentCntBefore = reqSentCnt;
+
+    while((reqCnt > reqSentCnt) &&
+          (true == m_isConnReusable) &&
+          (false == isStopped))
+    {
+        const Request&  req         = m_requests[(reqIdx + reqSentCnt) % MAX_PENDING_REQUESTS];
+        const char*     connection  = CONNECTION_CLOSE;
+        const char*     payload     = reinterpret_cast<const char*>(req.payload);
+        size_t          payloadSize = req.payloadSize;
+        size_t          size        = 0U;
+
+        if (false == req.body.isEmpty())
+        {
+            payload     = req.body.c_str();
+            payloadSize = req.body.length();
+        }
+
+        /* The last request on the connection asks the server to close it. */
+        if ((true == req.isKeepAlive) &&
+            (m_connReqLimit > (m_connReqCnt + 1U)))
+        {
+            connection = CONNECTION_KEEP_ALIVE;
+        }
+
+        size = req.header.length() + strlen(connection) + payloadSize;
+
+        /* A request is only sent behind others, which wait for their response,
+         * if all of them can be pipelined and the server confirmed the
+         * persistent connection already.
+         */
+        if ((0U < reqSentCnt) &&
+            ((false == m_isConnPersistent) ||
+             (false == req.isPipelinable) ||
+             (false == m_requests[(reqIdx + reqSentCnt - 1U) % MAX_PENDING_REQUESTS].isPipelinable) ||
+             (m_tcpClient.space() < size)))
+        {
+            isStopped = true;
+        }
+        else
+        {
+            bool isSuccessful = (req.header.length() == m_tcpClient.add(req.header.c_str(), req.header.length()));
+
+            if (true == isSuccessful)
+            {
+                isSuccessful = (strlen(connection) == m_tcpClient.add(connection, strlen(connection)));
+            }
+
+            if ((true == isSuccessful) &&
+                (nullptr != payload) &&
+                (0U < payloadSize))
+            {
+                isSuccessful = (payloadSize == m_tcpClient.add(payload, payloadSize));
+            }
+
+            if (false == isSuccessful)
+            {
+                LOG_WARNING("Failed to send request.");
+
+                m_isConnReusable = false;
+                isStopped = true;
+                isFailed = true;
+            }
+            else
+            {
+                ++reqSentCnt;
+                ++m_connReqCnt;
+
+                if (CONNECTION_CLOSE == connection)
+                {
+                    m_isConnReusable = false;
+                }
+            }
+        }
+    }
+
+    /* Send all requests at once. */
+    if (reqSentCntBefore < reqSentCnt)
+    {
+        (void)m_tcpClient.send();
+        m_lastActivity = millis();
+
+        /* Protect against concurrent access. */
+        {
+            MutexGuard<Mutex>   guard(m_mutex);
+
+            m_reqSentCnt = reqSentCnt;
+        }
+    }
+
+    /* A partially sent request can't be completed anymore. It will be sent
+     * again on a new connection.
+     */
+    if (true == isFailed)
+    {
+        m_isDisconnecting = m_tcpClient.connected();
+        disconnect();
+    }
+
+    return;
+}
+
+void AsyncHttpClient::completeResponse()
+{
+    notifyResponse();
+
+    /* Protect against concurrent access. */
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+
+        /* The response belongs to the oldest sent request. */
+        if (0U < m_reqSentCnt)
+        {
+            m_requests[m_reqIdx].payload        = nullptr;
+            m_requests[m_reqIdx].payloadSize    = 0U;
+
+            m_reqIdx = (m_reqIdx + 1U) % MAX_PENDING_REQUESTS;
+            --m_reqCnt;
+            --m_reqSentCnt;
+        }
+    }
+
+    if (true == m_isConnReusable)
+    {
+        m_isConnPersistent = true;
+    }
+
+    m_lastActivity = millis();
+
+    m_transferCoding = TRANSFER_CODING_IDENTITY;
+    m_rspPart = RESPONSE_PART_STATUS_LINE;
+    m_rsp.clear();
+    m_contentLength = 0U;
+    m_contentIndex = 0U;
+
+    return;
 }
 
 void AsyncHttpClient::clear()
@@ -1100,6 +1344,11 @@ void AsyncHttpClient::clear()
     m_headers.clear();
     m_urlEncodedPars.clear();
 
+    return;
+}
+
+void AsyncHttpClient::clearRsp()
+{
     m_rspPart = RESPONSE_PART_STATUS_LINE;
     m_rsp.clear();
     m_rspLine.clear();
@@ -1110,13 +1359,6 @@ void AsyncHttpClient::clear()
     m_chunkIndex = 0U;
     m_chunkBodyPart = CHUNK_SIZE;
 
-    /* Protect against concurrent access. */
-    {
-        MutexGuard<Mutex>   guard(m_mutex);
-
-        m_isReqOpen = false;
-    }
-
     return;
 }
 
@@ -1163,17 +1405,77 @@ bool AsyncHttpClient::handleRspHeader()
      * response.
      */
     value = m_rsp.getHeader("Connection");
+    value.toLowerCase();
+
+    /* Server closes the connection after the response? */
+    if (0 <= value.indexOf("close"))
+    {
+        if (true == m_isConnReusable)
+        {
+            LOG_INFO("Connection can not be kept-alive.");
+            m_isConnReusable = false;
+        }
+    }
+    /* A HTTP/1.0 server keeps the connection only alive on explicit request. */
+    else if ((0U != m_rsp.getHttpVersion().endsWith("1.0")) &&
+             (0 > value.indexOf("keep-alive")))
+    {
+        m_isConnReusable = false;
+    }
+    else
+    {
+        /* Nothing to do. */
+        ;
+    }
+
+    /* Keep-Alive = "Keep-Alive" ":" 1#(keep-alive-param)
+     * e.g. "Keep-Alive: timeout=5, max=100"
+     *
+     * The server may close the idle connection after the timeout, therefore
+     * the client closes it a little bit earlier to avoid sending a request
+     * on a closing connection. The max. parameter limits the number of
+     * further requests on the connection.
+     */
+    value = m_rsp.getHeader("Keep-Alive");
 
     if (false == value.isEmpty())
     {
-        /* Server closes the connection after the response? */
-        if (0 <= value.indexOf("close"))
+        const char* TIMEOUT_PAR     = "timeout=";
+        const char* MAX_PAR         = "max=";
+        int         index           = value.indexOf(TIMEOUT_PAR);
+
+        if (0 <= index)
         {
-            /* Client want a permanent connection? */
-            if (true == m_isKeepAlive)
+            long        timeout     = value.substring(index + strlen(TIMEOUT_PAR)).toInt();
+            uint32_t    idleTimeout = 0U;
+
+            if (1 < timeout)
+            {
+                idleTimeout = static_cast<uint32_t>(timeout - 1) * 1000U;
+            }
+
+            if (m_connIdleTimeout > idleTimeout)
+            {
+                m_connIdleTimeout = idleTimeout;
+            }
+        }
+
+        index = value.indexOf(MAX_PAR);
+
+        if ((0 <= index) &&
+            (0U < m_reqSentCnt))
+        {
+            long        max         = value.substring(index + strlen(MAX_PAR)).toInt();
+            uint32_t    reqLimit    = m_connReqCnt - m_reqSentCnt + 1U;
+
+            if (0 < max)
+            {
+                reqLimit += static_cast<uint32_t>(max);
+            }
+
+            if (m_connReqLimit > reqLimit)
             {
-                LOG_WARNING("Connection can not be kept-alive.");
-                m_isKeepAlive = false;
+                m_connReqLimit = reqLimit;
             }
         }
     }
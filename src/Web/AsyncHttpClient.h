@@ -61,6 +61,11 @@
 /**
  * Asynchronous HTTP client
  *
+ * If keep-alive is enabled, the connection is reused for all requests to the
+ * same host until it is idle for too long or the max. number of requests per
+ * connection is reached. With HTTP/1.1 several queued GET requests are
+ * pipelined on the same connection.
+ *
  * Used RFCs:
  * - RFC2616 (obsolete, because of RFC7230)
  * - RFC7230
@@ -97,6 +102,7 @@ public:
     /**
      * Parse all necessary parameters from URL and prepare for sending requests.
      * Note, calling this will clear user defined headers and URL encoded parameters.
+     * It fails if requests to a different host are still pending.
      *
      * @param[in] url   URL
      *
@@ -130,6 +136,27 @@ public:
      */
     void setKeepAlive(bool keepAlive);
 
+    /**
+     * Set the time after which a kept-alive connection is closed, if no
+     * request is pending. If the server announces a shorter timeout via
+     * the "Keep-Alive" header, the shorter one is used.
+     *
+     * If a server is polled periodically, the idle timeout shall be longer
+     * than the polling period. Otherwise the connection is closed before
+     * the next request and every request pays for a new connection again.
+     *
+     * @param[in] idleTimeout   Idle timeout in ms
+     */
+    void setIdleTimeout(uint32_t idleTimeout);
+
+    /**
+     * Set the max. number of requests per kept-alive connection. The last
+     * request asks the server to close the connection.
+     *
+     * @param[in] maxRequests   Max. number of requests per connection
+     */
+    void setMaxRequests(uint32_t maxRequests);
+
     /**
      * Add header to request header.
      *
@@ -175,7 +202,9 @@ public:
     void regOnClosed(const OnClosed& onClosed);
 
     /**
-     * Register callback function on error.
+     * Register callback function on error. It is called once for every
+     * request, which is lost because the connection was closed before
+     * its response was received.
      *
      * @param[in] onError   Callback
      */
@@ -183,8 +212,10 @@ public:
     
     /**
      * Send GET request to host.
+     * The request is serialized immediately and queued, therefore the
+     * client can be prepared for the next request afterwards.
      *
-     * @return If request is successful sent, it will return true otherwise false.
+     * @return If request is successful queued, it will return true otherwise false.
      */
     bool GET();
 
@@ -222,47 +253,59 @@ private:
     static const UBaseType_t    PROCESS_TASK_PRIORITY   = 1U;
 
     /**
-     * Max. number of commands which can be queued.
+     * Max. number of events which can be queued.
+     */
+    static const size_t EVT_QUEUE_SIZE  = 10U;
+
+    /**
+     * Max. number of requests, which can be queued or are waiting for the response.
      */
-    static const size_t CMD_QUEUE_SIZE  = 10U;
+    static const size_t MAX_PENDING_REQUESTS    = 4U;
 
     /**
-     * Max. number of events which can be queued.
+     * Initial capacity of a request header buffer in byte.
      */
-    static const size_t EVT_QUEUE_SIZE  = 10U;
+    static const size_t REQUEST_HEADER_SIZE     = 256U;
 
     /**
-     * Command ids are used to identify what the user requests.
+     * Default idle timeout of a kept-alive connection in ms.
      */
-    enum CmdId
-    {
-        CMD_ID_GET = 0, /**< GET request */
-        CMD_ID_POST     /**< POST request */
-    };
+    static const uint32_t DEFAULT_IDLE_TIMEOUT  = 10000U;
+
+    /**
+     * Default max. number of requests per kept-alive connection.
+     */
+    static const uint32_t DEFAULT_MAX_REQUESTS  = 100U;
 
     /**
-     * A command is a combination of request and its corresponding data.
+     * A pre-serialized request. The buffers are kept and reused by the
+     * following requests.
      */
-    struct Cmd
+    struct Request
     {
-        CmdId   id;     /**< The command id identifies the kind of request. */
+        String          header;         /**< Request line and headers, except the "Connection" header and the empty line. */
+        String          body;           /**< URL encoded parameters, used as payload. */
+        const uint8_t*  payload;        /**< User payload, which must be kept alive until the response is available. */
+        size_t          payloadSize;    /**< User payload size in byte */
+        bool            isKeepAlive;    /**< Shall the connection be kept alive after the response? */
+        bool            isPipelinable;  /**< Can the request be pipelined (idempotent, HTTP/1.1, keep-alive)? */
+        bool            isIdempotent;   /**< Idempotent requests can be sent again after a connection loss. */
+        bool            isRetried;      /**< Is the request already sent again? */
 
         /**
-         * The union contains the event id specific parameters.
-         * Note not every command id must have parameters.
+         * Initializes the request.
          */
-        union
+        Request() :
+            header(),
+            body(),
+            payload(nullptr),
+            payloadSize(0U),
+            isKeepAlive(false),
+            isPipelinable(false),
+            isIdempotent(false),
+            isRetried(false)
         {
-            /**
-             * Data parameters, only valid for CMD_ID_POST.
-             */
-            struct
-            {
-                const uint8_t*  data;   /**< Command specific data. */
-                size_t          size;   /**< Command specific data size in byte. */
-            } data;
-
-        } u;
+        }
     };
 
     /**
@@ -347,13 +390,18 @@ private:
 
 
     AsyncClient     m_tcpClient;            /**< Asynchronous TCP client */
-    Queue<Cmd>      m_cmdQueue;             /**< Command queue */
     Queue<Event>    m_evtQueue;             /**< Event queue */
     Mutex           m_mutex;                /**< Used to protect against concurrent access. */
 
     /* Protected data */
     bool            m_isConnected;          /**< Is a connection established? */
-    bool            m_isReqOpen;            /**< Is a request open? */
+    Request         m_requests[MAX_PENDING_REQUESTS]; /**< Pending requests, ordered from the oldest to the newest. */
+    size_t          m_reqIdx;               /**< Index of the oldest pending request. */
+    size_t          m_reqCnt;               /**< Number of pending requests. */
+    size_t          m_reqSentCnt;           /**< Number of pending requests, which are sent and wait for the response. */
+    String          m_reqHostname;          /**< Server hostname of the pending requests. */
+    uint16_t        m_reqPort;              /**< Server port of the pending requests. */
+    bool            m_reqIsSecure;          /**< Secure transport of the pending requests. */
 
     /* Non-protected data */
     OnResponse      m_onRspCallback;        /**< Callback which to call for a complete response. */
@@ -365,13 +413,25 @@ private:
     String          m_base64Authorization;  /**< Authorization BASE64 encoded */
     String          m_uri;                  /**< Request URI */
     String          m_headers;              /**< Additional request headers */
-    String          m_method;               /**< Request method, e.g. GET, PUT, etc. */
     String          m_userAgent;            /**< User agent */
     bool            m_isHttpVer10;          /**< Use HTTP/1.0 (true) instead of HTTP/1.1 (false) */
     bool            m_isKeepAlive;          /**< Keep connection alive or not? */
+    uint32_t        m_idleTimeout;          /**< Idle timeout of a kept-alive connection in ms */
+    uint32_t        m_maxRequests;          /**< Max. number of requests per kept-alive connection */
     String          m_urlEncodedPars;       /**< URL encoded parameters (application/x-www-form-urlencoded) */
-    const uint8_t*  m_payload;              /**< Request payload */
-    size_t          m_payloadSize;          /**< Request payload size in byte */
+
+    /* Connection data, only used by the process task. */
+    bool            m_isConnecting;         /**< Is the connection establishment pending? */
+    bool            m_isDisconnecting;      /**< Is the connection closing? */
+    bool            m_isConnReusable;       /**< Can further requests be sent on the connection? */
+    bool            m_isConnPersistent;     /**< Did the server confirm the persistent connection by a response? */
+    String          m_connHostname;         /**< Server hostname of the connection */
+    uint16_t        m_connPort;             /**< Server port of the connection */
+    bool            m_connIsSecure;         /**< Secure transport of the connection */
+    uint32_t        m_connReqCnt;           /**< Number of requests, sent on the connection. */
+    uint32_t        m_connReqLimit;         /**< Max. number of requests on the connection. */
+    uint32_t        m_connIdleTimeout;      /**< Idle timeout of the connection in ms */
+    uint32_t        m_lastActivity;         /**< Timestamp in ms of the last request or response. */
 
     ResponsePart    m_rspPart;              /**< Current parsing part of the response */
     HttpResponse    m_rsp;                  /**< Response */
@@ -399,10 +459,10 @@ private:
     void destroyProcessTask();
 
     /**
-     * Clear the command queue.
-     * Attention, all commands will be lost and not acknowledged.
+     * Clear all pending requests.
+     * Attention, all requests will be lost and not acknowledged.
      */
-    void clearCmdQueue();
+    void clearRequests();
 
     /**
      * Clear the event queue.
@@ -416,9 +476,10 @@ private:
     static void processTask(void* parameters);
 
     /**
-     * Process the command queue.
+     * Process the pending requests: establish the connection, send the
+     * requests and close the connection if it is idle.
      */
-    void processCmdQueue();
+    void processRequests();
 
     /**
      * Process the event queue.
@@ -432,6 +493,7 @@ private:
 
     /**
      * This method is called if a connection is disconnected.
+     * Sent requests, which can't be sent again, are reported as error.
      */
     void onDisconnect();
 
@@ -475,34 +537,49 @@ private:
     void abort();
 
     /**
-     * Send GET request to host.
+     * Serialize a request and add it to the pending requests.
      *
-     * @return If request is successful sent, it will return true otherwise false.
+     * @param[in] method        Request method, e.g. GET, POST, etc.
+     * @param[in] isIdempotent  Is the request method idempotent?
+     * @param[in] payload       Payload, which must be kept alive until response is available!
+     * @param[in] size          Payload size in byte
+     *
+     * @return If request is successful queued, it will return true otherwise false.
      */
-    bool getRequest();
+    bool enqueueRequest(const char* method, bool isIdempotent, const uint8_t* payload, size_t size);
 
     /**
-     * Send POST request to host.
+     * Serialize a request into the request buffers.
      *
+     * @param[out] req      Request
+     * @param[in] method    Request method, e.g. GET, POST, etc.
      * @param[in] payload   Payload, which must be kept alive until response is available!
      * @param[in] size      Payload size in byte
-     *
-     * @return If request is successful sent, it will return true otherwise false.
      */
-    bool postRequest(const uint8_t* payload = nullptr, size_t size = 0U);
+    void serializeRequest(Request& req, const char* method, const uint8_t* payload, size_t size);
 
     /**
-     * Send request to host.
-     *
-     * @return If request is successful sent, it will return true otherwise false.
+     * Send the pending requests, which are not sent yet. Several requests
+     * are only sent at once, if they can be pipelined.
      */
-    bool sendRequest();
+    void sendRequests();
+
+    /**
+     * Remove the oldest pending request, because its response is complete,
+     * and notify the application about the response.
+     */
+    void completeResponse();
 
     /**
      * Clear all server related parameters.
      */
     void clear();
 
+    /**
+     * Clear the response parsing state.
+     */
+    void clearRsp();
+
     /**
      * Is line terminator detected?
      *
@@ -0,0 +1,351 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Chrome trace event format writer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ChromeTrace.h"
+
+#if (0 != CONFIG_TRACE_RECORDER_ENABLE)
+
+#include <stdio.h>
+#include <string.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Process id used for all events. */
+static const uint8_t    PROCESS_ID  = 1U;
+
+/** Chrome trace event phase per trace recorder event type. */
+static const char       PHASES[]    = { 'B', 'E', 'C' };
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+ChromeTrace::ChromeTrace() :
+    m_events(),
+    m_eventCnt(),
+    m_eventIdx(),
+    m_taskNames(),
+    m_taskNameCnt(0U),
+    m_taskNameIdx(0U),
+    m_state(STATE_HEADER),
+    m_isFirstItem(true),
+    m_line(),
+    m_lineLen(0U),
+    m_lineIdx(0U)
+{
+}
+
+ChromeTrace::~ChromeTrace()
+{
+    release();
+}
+
+bool ChromeTrace::snapshot()
+{
+    bool            isSuccessful    = true;
+    TraceRecorder&  recorder        = TraceRecorder::getInstance();
+    uint8_t         core            = 0U;
+
+    release();
+
+    for(core = 0U; core < TraceRecorder::MAX_CORES; ++core)
+    {
+        m_events[core] = new(std::nothrow) TraceRecorder::Event[TraceRecorder::EVENTS_PER_CORE];
+
+        if (nullptr == m_events[core])
+        {
+            isSuccessful = false;
+        }
+        else
+        {
+            uint32_t idx = 0U;
+
+            for(idx = 0U; idx < TraceRecorder::EVENTS_PER_CORE; ++idx)
+            {
+                if (true == recorder.getEvent(core, idx, m_events[core][m_eventCnt[core]]))
+                {
+                    ++m_eventCnt[core];
+                }
+            }
+        }
+    }
+
+#if configUSE_TRACE_FACILITY
+    {
+        UBaseType_t     numOfTasks  = uxTaskGetNumberOfTasks();
+        TaskStatus_t*   taskStatus  = new(std::nothrow) TaskStatus_t[numOfTasks];
+
+        if (nullptr != taskStatus)
+        {
+            UBaseType_t index = 0U;
+
+            numOfTasks = uxTaskGetSystemState(taskStatus, numOfTasks, nullptr);
+
+            for(index = 0U; (index < numOfTasks) && (MAX_TASKS > m_taskNameCnt); ++index)
+            {
+                TaskName& taskName = m_taskNames[m_taskNameCnt];
+
+                taskName.taskNumber = static_cast<uint16_t>(taskStatus[index].xTaskNumber);
+                (void)strncpy(taskName.name, taskStatus[index].pcTaskName, sizeof(taskName.name) - 1U);
+                taskName.name[sizeof(taskName.name) - 1U] = '\0';
+
+                ++m_taskNameCnt;
+            }
+
+            delete[] taskStatus;
+        }
+    }
+#endif  /* configUSE_TRACE_FACILITY */
+
+    if (false == isSuccessful)
+    {
+        release();
+    }
+
+    return isSuccessful;
+}
+
+size_t ChromeTrace::fill(uint8_t* buffer, size_t maxLen)
+{
+    size_t written = 0U;
+
+    if (nullptr != buffer)
+    {
+        while((maxLen > written) &&
+              ((STATE_FINISHED != m_state) || (m_lineLen > m_lineIdx)))
+        {
+            /* Current line completely written? */
+            if (m_lineLen <= m_lineIdx)
+            {
+                nextLine();
+            }
+            else
+            {
+                size_t len = m_lineLen - m_lineIdx;
+
+                if ((maxLen - written) < len)
+                {
+                    len = maxLen - written;
+                }
+
+                memcpy(&buffer[written], &m_line[m_lineIdx], len);
+                m_lineIdx   += len;
+                written     += len;
+            }
+        }
+    }
+
+    return written;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void ChromeTrace::release()
+{
+    uint8_t core = 0U;
+
+    for(core = 0U; core < TraceRecorder::MAX_CORES; ++core)
+    {
+        if (nullptr != m_events[core])
+        {
+            delete[] m_events[core];
+            m_events[core] = nullptr;
+        }
+
+        m_eventCnt[core] = 0U;
+        m_eventIdx[core] = 0U;
+    }
+
+    m_taskNameCnt   = 0U;
+    m_taskNameIdx   = 0U;
+    m_state         = STATE_HEADER;
+    m_isFirstItem   = true;
+    m_lineLen       = 0U;
+    m_lineIdx       = 0U;
+}
+
+void ChromeTrace::nextLine()
+{
+    const char* separator   = (true == m_isFirstItem) ? "" : ",";
+    int         len         = 0;
+
+    switch(m_state)
+    {
+    case STATE_HEADER:
+        len     = snprintf(m_line, sizeof(m_line), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+        m_state = STATE_TASK_NAMES;
+        break;
+
+    case STATE_TASK_NAMES:
+        if (m_taskNameCnt <= m_taskNameIdx)
+        {
+            m_state = STATE_EVENTS;
+        }
+        else
+        {
+            const TaskName& taskName = m_taskNames[m_taskNameIdx];
+
+            len = snprintf(m_line, sizeof(m_line),
+                "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                separator,
+                PROCESS_ID,
+                taskName.taskNumber,
+                taskName.name);
+
+            m_isFirstItem = false;
+            ++m_taskNameIdx;
+        }
+        break;
+
+    case STATE_EVENTS:
+        {
+            const TraceRecorder::Event* event = nextEvent();
+
+            if (nullptr == event)
+            {
+                m_state = STATE_FOOTER;
+            }
+            else
+            {
+                len = snprintf(m_line, sizeof(m_line),
+                    "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%u,\"pid\":%u,\"tid\":%u,\"args\":{\"value\":%d,\"core\":%u}}",
+                    separator,
+                    event->name,
+                    PHASES[event->type % sizeof(PHASES)],
+                    event->timestamp,
+                    PROCESS_ID,
+                    event->taskNumber,
+                    event->value,
+                    event->core);
+
+                m_isFirstItem = false;
+            }
+        }
+        break;
+
+    case STATE_FOOTER:
+        len     = snprintf(m_line, sizeof(m_line), "\n]}\n");
+        m_state = STATE_FINISHED;
+        break;
+
+    case STATE_FINISHED:
+    default:
+        break;
+    }
+
+    /* A truncated line is cut, which results in invalid JSON. But it avoids
+     * to write uninitialized data.
+     */
+    if (0 > len)
+    {
+        len = 0;
+    }
+    else if (static_cast<int>(sizeof(m_line)) <= len)
+    {
+        len = sizeof(m_line) - 1U;
+    }
+    else
+    {
+        ;
+    }
+
+    m_lineLen = static_cast<size_t>(len);
+    m_lineIdx = 0U;
+}
+
+const TraceRecorder::Event* ChromeTrace::nextEvent()
+{
+    const TraceRecorder::Event* event       = nullptr;
+    uint8_t                     eventCore   = 0U;
+    uint8_t                     core        = 0U;
+
+    /* The events of every core are ordered already, therefore its just a merge. */
+    for(core = 0U; core < TraceRecorder::MAX_CORES; ++core)
+    {
+        if ((nullptr != m_events[core]) &&
+            (m_eventCnt[core] > m_eventIdx[core]))
+        {
+            const TraceRecorder::Event* candidate = &m_events[core][m_eventIdx[core]];
+
+            if ((nullptr == event) ||
+                (static_cast<int32_t>(candidate->timestamp - event->timestamp) < 0))
+            {
+                event       = candidate;
+                eventCore   = core;
+            }
+        }
+    }
+
+    if (nullptr != event)
+    {
+        ++m_eventIdx[eventCore];
+    }
+
+    return event;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+#endif  /* (0 != CONFIG_TRACE_RECORDER_ENABLE) */
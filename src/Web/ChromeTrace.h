@@ -0,0 +1,168 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Chrome trace event format writer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __CHROME_TRACE_H__
+#define __CHROME_TRACE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <TraceRecorder.h>
+
+#if (0 != CONFIG_TRACE_RECORDER_ENABLE)
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Writes the recorded trace events in the Chrome trace event JSON format,
+ * which can be loaded e.g. by Perfetto or chrome://tracing.
+ *
+ * A snapshot of the trace recorder is taken first. The JSON output is
+ * generated piecewise afterwards, which allows to use it with a chunked
+ * HTTP response without keeping the whole JSON in memory.
+ */
+class ChromeTrace
+{
+public:
+
+    /**
+     * Constructs the writer.
+     */
+    ChromeTrace();
+
+    /**
+     * Destroys the writer.
+     */
+    ~ChromeTrace();
+
+    /**
+     * Take a snapshot of the recorded trace events and the task names.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool snapshot();
+
+    /**
+     * Write the next part of the JSON output to the buffer.
+     *
+     * @param[out]  buffer  Buffer
+     * @param[in]   maxLen  Buffer size in bytes
+     *
+     * @return Number of written bytes. If 0, the output is complete.
+     */
+    size_t fill(uint8_t* buffer, size_t maxLen);
+
+private:
+
+    /** Max. number of task names, which are considered. */
+    static const uint8_t    MAX_TASKS   = 32U;
+
+    /** Max. length of a single JSON output line. */
+    static const size_t     LINE_SIZE   = 128U;
+
+    /**
+     * Output states.
+     */
+    enum State
+    {
+        STATE_HEADER = 0,   /**< Write JSON header */
+        STATE_TASK_NAMES,   /**< Write task names as metadata events */
+        STATE_EVENTS,       /**< Write trace events */
+        STATE_FOOTER,       /**< Write JSON footer */
+        STATE_FINISHED      /**< Output complete */
+    };
+
+    /**
+     * Task name, used for the thread names.
+     */
+    struct TaskName
+    {
+        uint16_t    taskNumber;                     /**< Unique task number */
+        char        name[configMAX_TASK_NAME_LEN];  /**< Task name */
+    };
+
+    TraceRecorder::Event*   m_events[TraceRecorder::MAX_CORES];     /**< Event snapshot per core */
+    uint32_t                m_eventCnt[TraceRecorder::MAX_CORES];   /**< Number of events in the snapshot per core */
+    uint32_t                m_eventIdx[TraceRecorder::MAX_CORES];   /**< Read index in the snapshot per core */
+    TaskName                m_taskNames[MAX_TASKS];                 /**< Task names */
+    uint8_t                 m_taskNameCnt;                          /**< Number of task names */
+    uint8_t                 m_taskNameIdx;                          /**< Read index of the task names */
+    State                   m_state;                                /**< Output state */
+    bool                    m_isFirstItem;                          /**< Is first item in the JSON array? */
+    char                    m_line[LINE_SIZE];                      /**< Current output line */
+    size_t                  m_lineLen;                              /**< Length of the current output line */
+    size_t                  m_lineIdx;                              /**< Read index in the current output line */
+
+    ChromeTrace(const ChromeTrace& writer);
+    ChromeTrace& operator=(const ChromeTrace& writer);
+
+    /**
+     * Release the snapshot.
+     */
+    void release();
+
+    /**
+     * Prepare the next output line, depended on the output state.
+     */
+    void nextLine();
+
+    /**
+     * Get the oldest event of all cores, which was not written yet.
+     *
+     * @return Event or nullptr if all events were written.
+     */
+    const TraceRecorder::Event* nextEvent();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* (0 != CONFIG_TRACE_RECORDER_ENABLE) */
+
+#endif  /* __CHROME_TRACE_H__ */
+
+/** @} */
@@ -0,0 +1,560 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display snapshot image encoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "DisplaySnapshot.h"
+#include "DisplayMgr.h"
+
+#include <string.h>
+#include <new>
+#include <Display.h>
+#include "rom/crc.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void writeUInt32BE(uint8_t* dst, uint32_t value);
+static void writeUInt32LE(uint8_t* dst, uint32_t value);
+static void writeUInt16LE(uint8_t* dst, uint16_t value);
+static uint32_t adler32Update(uint32_t adler, const uint8_t* data, size_t len);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** PNG file signature. */
+static const uint8_t    PNG_SIGNATURE[]     = { 0x89U, 'P', 'N', 'G', '\r', '\n', 0x1AU, '\n' };
+
+/** PNG IEND chunk, which is always the same. */
+static const uint8_t    PNG_IEND_CHUNK[]    = { 0x00U, 0x00U, 0x00U, 0x00U, 'I', 'E', 'N', 'D', 0xAEU, 0x42U, 0x60U, 0x82U };
+
+/** Max. number of data bytes in a stored deflate block. */
+static const size_t     DEFLATE_BLOCK_SIZE  = 65535U;
+
+/** Size of a stored deflate block header in bytes. */
+static const size_t     DEFLATE_BLOCK_HEAD  = 5U;
+
+/** Size of the BMP file header and the BITMAPINFOHEADER in bytes. */
+static const size_t     BMP_HEADER_SIZE     = 14U + 40U;
+
+/** BMP resolution in pixel per meter (72 dpi). */
+static const uint32_t   BMP_RESOLUTION      = 2835U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+DisplaySnapshot::DisplaySnapshot() :
+    m_format(FORMAT_PNG),
+    m_framebuffer(nullptr),
+    m_width(0U),
+    m_height(0U),
+    m_scale(1U),
+    m_size(0U),
+    m_state(STATE_FINISHED),
+    m_head(),
+    m_headLen(0U),
+    m_headIdx(0U),
+    m_row(nullptr),
+    m_rowLen(0U),
+    m_rowIdx(0U),
+    m_rowY(0U),
+    m_rawRemaining(0U),
+    m_blockRemaining(0U),
+    m_crc(0U),
+    m_adler(1U)
+{
+}
+
+DisplaySnapshot::~DisplaySnapshot()
+{
+    release();
+}
+
+bool DisplaySnapshot::snapshot(Format format, uint8_t scale)
+{
+    bool        isSuccessful    = false;
+    IDisplay&   display         = Display::getInstance();
+
+    release();
+
+    if ((0U < scale) &&
+        (MAX_SCALE >= scale))
+    {
+        size_t pixels   = 0U;
+        size_t rowBytes = 0U;
+
+        m_format    = format;
+        m_width     = static_cast<uint16_t>(display.getWidth());
+        m_height    = static_cast<uint16_t>(display.getHeight());
+        m_scale     = scale;
+        pixels      = static_cast<size_t>(m_width) * m_height;
+        rowBytes    = static_cast<size_t>(m_width) * m_scale * 3U;
+
+        if (FORMAT_BMP == m_format)
+        {
+            /* Every BMP row is aligned to 4 byte. */
+            m_rowLen = (rowBytes + 3U) & ~static_cast<size_t>(3U);
+        }
+        else
+        {
+            /* Every PNG row starts with the filter type. */
+            m_rowLen = 1U + rowBytes;
+        }
+
+        m_framebuffer   = new(std::nothrow) uint32_t[pixels];
+        m_row           = new(std::nothrow) uint8_t[m_rowLen];
+
+        if ((nullptr != m_framebuffer) &&
+            (nullptr != m_row))
+        {
+            DisplayMgr::getInstance().getFBCopy(m_framebuffer, pixels, nullptr);
+
+            m_rawRemaining = m_rowLen * m_height * m_scale;
+
+            if (FORMAT_BMP == m_format)
+            {
+                m_size = BMP_HEADER_SIZE + m_rawRemaining;
+            }
+            else
+            {
+                size_t blocks       = (m_rawRemaining + DEFLATE_BLOCK_SIZE - 1U) / DEFLATE_BLOCK_SIZE;
+                size_t zlibStream   = 2U + (blocks * DEFLATE_BLOCK_HEAD) + m_rawRemaining + 4U;
+
+                /* Signature + IHDR chunk + IDAT chunk + IEND chunk */
+                m_size = sizeof(PNG_SIGNATURE) + (12U + 13U) + (12U + zlibStream) + sizeof(PNG_IEND_CHUNK);
+            }
+
+            m_state             = STATE_HEADER;
+            m_rowIdx            = m_rowLen;
+            m_rowY              = 0U;
+            m_blockRemaining    = 0U;
+            m_crc               = 0U;
+            m_adler             = 1U;
+            isSuccessful        = true;
+        }
+    }
+
+    if (false == isSuccessful)
+    {
+        release();
+    }
+
+    return isSuccessful;
+}
+
+size_t DisplaySnapshot::fill(uint8_t* buffer, size_t maxLen)
+{
+    size_t written = 0U;
+
+    if (nullptr != buffer)
+    {
+        while((maxLen > written) &&
+              ((STATE_FINISHED != m_state) || (m_headLen > m_headIdx)))
+        {
+            /* Pending header, block header or trailer? */
+            if (m_headLen > m_headIdx)
+            {
+                size_t len = m_headLen - m_headIdx;
+
+                if ((maxLen - written) < len)
+                {
+                    len = maxLen - written;
+                }
+
+                memcpy(&buffer[written], &m_head[m_headIdx], len);
+                m_headIdx   += len;
+                written     += len;
+            }
+            else if (STATE_DATA != m_state)
+            {
+                nextHead();
+            }
+            else if (0U == m_rawRemaining)
+            {
+                m_state = STATE_TRAILER;
+            }
+            else if ((FORMAT_PNG == m_format) &&
+                     (0U == m_blockRemaining))
+            {
+                nextBlockHead();
+            }
+            else if (m_rowLen <= m_rowIdx)
+            {
+                nextRow();
+            }
+            else
+            {
+                size_t len = m_rowLen - m_rowIdx;
+
+                if ((maxLen - written) < len)
+                {
+                    len = maxLen - written;
+                }
+
+                if (FORMAT_PNG == m_format)
+                {
+                    /* A row may be split over two deflate blocks. */
+                    if (m_blockRemaining < len)
+                    {
+                        len = m_blockRemaining;
+                    }
+
+                    m_crc               = crc32_le(m_crc, &m_row[m_rowIdx], len);
+                    m_adler             = adler32Update(m_adler, &m_row[m_rowIdx], len);
+                    m_blockRemaining    -= len;
+                }
+
+                memcpy(&buffer[written], &m_row[m_rowIdx], len);
+                m_rowIdx        += len;
+                m_rawRemaining  -= len;
+                written         += len;
+            }
+        }
+    }
+
+    return written;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void DisplaySnapshot::nextHead()
+{
+    uint32_t    imageWidth  = static_cast<uint32_t>(m_width) * m_scale;
+    uint32_t    imageHeight = static_cast<uint32_t>(m_height) * m_scale;
+    size_t      len         = 0U;
+
+    switch(m_state)
+    {
+    case STATE_HEADER:
+        if (FORMAT_BMP == m_format)
+        {
+            /* BITMAPFILEHEADER */
+            m_head[0U] = 'B';
+            m_head[1U] = 'M';
+            writeUInt32LE(&m_head[2U], m_size);
+            writeUInt32LE(&m_head[6U], 0U);
+            writeUInt32LE(&m_head[10U], BMP_HEADER_SIZE);
+
+            /* BITMAPINFOHEADER, positive height means bottom-up row order. */
+            writeUInt32LE(&m_head[14U], 40U);
+            writeUInt32LE(&m_head[18U], imageWidth);
+            writeUInt32LE(&m_head[22U], imageHeight);
+            writeUInt16LE(&m_head[26U], 1U);
+            writeUInt16LE(&m_head[28U], 24U);
+            writeUInt32LE(&m_head[30U], 0U);
+            writeUInt32LE(&m_head[34U], m_size - BMP_HEADER_SIZE);
+            writeUInt32LE(&m_head[38U], BMP_RESOLUTION);
+            writeUInt32LE(&m_head[42U], BMP_RESOLUTION);
+            writeUInt32LE(&m_head[46U], 0U);
+            writeUInt32LE(&m_head[50U], 0U);
+            len = BMP_HEADER_SIZE;
+        }
+        else
+        {
+            size_t idatLen = m_size - sizeof(PNG_SIGNATURE) - (12U + 13U) - 12U - sizeof(PNG_IEND_CHUNK);
+
+            memcpy(m_head, PNG_SIGNATURE, sizeof(PNG_SIGNATURE));
+            len = sizeof(PNG_SIGNATURE);
+
+            /* IHDR: 8 bit per color channel, RGB, deflate, no filter, no interlace */
+            writeUInt32BE(&m_head[len], 13U);
+            memcpy(&m_head[len + 4U], "IHDR", 4U);
+            writeUInt32BE(&m_head[len + 8U], imageWidth);
+            writeUInt32BE(&m_head[len + 12U], imageHeight);
+            m_head[len + 16U] = 8U;
+            m_head[len + 17U] = 2U;
+            m_head[len + 18U] = 0U;
+            m_head[len + 19U] = 0U;
+            m_head[len + 20U] = 0U;
+            writeUInt32BE(&m_head[len + 21U], crc32_le(0U, &m_head[len + 4U], 4U + 13U));
+            len += 12U + 13U;
+
+            /* IDAT chunk begin with the zlib header: deflate, 32K window, no dictionary, fastest */
+            writeUInt32BE(&m_head[len], idatLen);
+            memcpy(&m_head[len + 4U], "IDAT", 4U);
+            m_head[len + 8U] = 0x78U;
+            m_head[len + 9U] = 0x01U;
+            m_crc = crc32_le(0U, &m_head[len + 4U], 4U + 2U);
+            len += 8U + 2U;
+        }
+
+        m_state = STATE_DATA;
+        break;
+
+    case STATE_TRAILER:
+        if (FORMAT_PNG == m_format)
+        {
+            /* Finish zlib stream and IDAT chunk. */
+            writeUInt32BE(&m_head[0U], m_adler);
+            m_crc = crc32_le(m_crc, &m_head[0U], 4U);
+            writeUInt32BE(&m_head[4U], m_crc);
+            len = 8U;
+
+            memcpy(&m_head[len], PNG_IEND_CHUNK, sizeof(PNG_IEND_CHUNK));
+            len += sizeof(PNG_IEND_CHUNK);
+        }
+
+        m_state = STATE_FINISHED;
+        break;
+
+    case STATE_DATA:
+    case STATE_FINISHED:
+    default:
+        break;
+    }
+
+    m_headLen = len;
+    m_headIdx = 0U;
+
+    return;
+}
+
+void DisplaySnapshot::nextBlockHead()
+{
+    uint16_t    blockLen    = DEFLATE_BLOCK_SIZE;
+    uint8_t     isFinal     = 0U;
+
+    if (DEFLATE_BLOCK_SIZE >= m_rawRemaining)
+    {
+        blockLen    = static_cast<uint16_t>(m_rawRemaining);
+        isFinal     = 1U;
+    }
+
+    /* Stored block: BFINAL, BTYPE = 00, LEN and NLEN */
+    m_head[0U] = isFinal;
+    writeUInt16LE(&m_head[1U], blockLen);
+    writeUInt16LE(&m_head[3U], static_cast<uint16_t>(~blockLen));
+    m_crc = crc32_le(m_crc, m_head, DEFLATE_BLOCK_HEAD);
+
+    m_headLen           = DEFLATE_BLOCK_HEAD;
+    m_headIdx           = 0U;
+    m_blockRemaining    = blockLen;
+
+    return;
+}
+
+void DisplaySnapshot::nextRow()
+{
+    uint32_t    srcY    = 0U;
+    size_t      idx     = 0U;
+    uint16_t    x       = 0U;
+
+    if (FORMAT_BMP == m_format)
+    {
+        /* BMP rows are stored bottom-up. */
+        srcY = ((static_cast<uint32_t>(m_height) * m_scale) - 1U - m_rowY) / m_scale;
+    }
+    else
+    {
+        srcY = m_rowY / m_scale;
+
+        /* Filter type: none */
+        m_row[idx] = 0U;
+        ++idx;
+    }
+
+    for(x = 0U; x < m_width; ++x)
+    {
+        uint32_t    color   = m_framebuffer[(srcY * m_width) + x];
+        uint8_t     red     = static_cast<uint8_t>((color >> 16U) & 0xFFU);
+        uint8_t     green   = static_cast<uint8_t>((color >>  8U) & 0xFFU);
+        uint8_t     blue    = static_cast<uint8_t>((color >>  0U) & 0xFFU);
+        uint8_t     count   = 0U;
+
+        for(count = 0U; count < m_scale; ++count)
+        {
+            if (FORMAT_BMP == m_format)
+            {
+                m_row[idx + 0U] = blue;
+                m_row[idx + 1U] = green;
+                m_row[idx + 2U] = red;
+            }
+            else
+            {
+                m_row[idx + 0U] = red;
+                m_row[idx + 1U] = green;
+                m_row[idx + 2U] = blue;
+            }
+
+            idx += 3U;
+        }
+    }
+
+    /* BMP row padding */
+    while(m_rowLen > idx)
+    {
+        m_row[idx] = 0U;
+        ++idx;
+    }
+
+    m_rowIdx = 0U;
+    ++m_rowY;
+
+    return;
+}
+
+void DisplaySnapshot::release()
+{
+    if (nullptr != m_framebuffer)
+    {
+        delete[] m_framebuffer;
+        m_framebuffer = nullptr;
+    }
+
+    if (nullptr != m_row)
+    {
+        delete[] m_row;
+        m_row = nullptr;
+    }
+
+    m_size          = 0U;
+    m_state         = STATE_FINISHED;
+    m_headLen       = 0U;
+    m_headIdx       = 0U;
+    m_rowLen        = 0U;
+    m_rowIdx        = 0U;
+    m_rawRemaining  = 0U;
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write a 32 bit value in big endian byte order.
+ *
+ * @param[out] dst      Destination
+ * @param[in]  value    Value
+ */
+static void writeUInt32BE(uint8_t* dst, uint32_t value)
+{
+    dst[0U] = static_cast<uint8_t>((value >> 24U) & 0xFFU);
+    dst[1U] = static_cast<uint8_t>((value >> 16U) & 0xFFU);
+    dst[2U] = static_cast<uint8_t>((value >>  8U) & 0xFFU);
+    dst[3U] = static_cast<uint8_t>((value >>  0U) & 0xFFU);
+
+    return;
+}
+
+/**
+ * Write a 32 bit value in little endian byte order.
+ *
+ * @param[out] dst      Destination
+ * @param[in]  value    Value
+ */
+static void writeUInt32LE(uint8_t* dst, uint32_t value)
+{
+    dst[0U] = static_cast<uint8_t>((value >>  0U) & 0xFFU);
+    dst[1U] = static_cast<uint8_t>((value >>  8U) & 0xFFU);
+    dst[2U] = static_cast<uint8_t>((value >> 16U) & 0xFFU);
+    dst[3U] = static_cast<uint8_t>((value >> 24U) & 0xFFU);
+
+    return;
+}
+
+/**
+ * Write a 16 bit value in little endian byte order.
+ *
+ * @param[out] dst      Destination
+ * @param[in]  value    Value
+ */
+static void writeUInt16LE(uint8_t* dst, uint16_t value)
+{
+    dst[0U] = static_cast<uint8_t>((value >> 0U) & 0xFFU);
+    dst[1U] = static_cast<uint8_t>((value >> 8U) & 0xFFU);
+
+    return;
+}
+
+/**
+ * Continue the Adler-32 checksum calculation.
+ *
+ * @param[in] adler Adler-32 of the previous data, 1 for the first time.
+ * @param[in] data  Data
+ * @param[in] len   Data length in bytes
+ *
+ * @return Adler-32 checksum
+ */
+static uint32_t adler32Update(uint32_t adler, const uint8_t* data, size_t len)
+{
+    const uint32_t  MOD_ADLER   = 65521U;
+    const size_t    NMAX        = 5552U;    /* Max. number of bytes, before the sums may overflow. */
+    uint32_t        sumA        = adler & 0xFFFFU;
+    uint32_t        sumB        = (adler >> 16U) & 0xFFFFU;
+
+    while(0U < len)
+    {
+        size_t count = (NMAX < len) ? NMAX : len;
+
+        len -= count;
+
+        while(0U < count)
+        {
+            sumA += *data;
+            sumB += sumA;
+            ++data;
+            --count;
+        }
+
+        sumA %= MOD_ADLER;
+        sumB %= MOD_ADLER;
+    }
+
+    return (sumB << 16U) | sumA;
+}
@@ -0,0 +1,198 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Display snapshot image encoder
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __DISPLAY_SNAPSHOT_H__
+#define __DISPLAY_SNAPSHOT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Takes a snapshot of the display framebuffer and encodes it piecewise as
+ * PNG or BMP image. Only the framebuffer copy and a single image row are
+ * kept in memory, the image itself is never materialized. This allows to
+ * use it with a HTTP response callback.
+ *
+ * The PNG image uses uncompressed (stored) deflate blocks, which avoids
+ * the memory and CPU effort of a real compression. The total image size
+ * is known in advance in both formats.
+ */
+class DisplaySnapshot
+{
+public:
+
+    /**
+     * Supported image formats.
+     */
+    enum Format
+    {
+        FORMAT_PNG = 0, /**< PNG with 24 bit RGB color */
+        FORMAT_BMP      /**< BMP with 24 bit RGB color */
+    };
+
+    /**
+     * Constructs the display snapshot.
+     */
+    DisplaySnapshot();
+
+    /**
+     * Destroys the display snapshot.
+     */
+    ~DisplaySnapshot();
+
+    /**
+     * Take a snapshot of the current display content.
+     *
+     * @param[in] format    Image format
+     * @param[in] scale     Integer upscaling factor [1; MAX_SCALE]
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool snapshot(Format format, uint8_t scale);
+
+    /**
+     * Get total image size in bytes.
+     *
+     * @return Image size in bytes
+     */
+    size_t getSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Get the MIME type of the image.
+     *
+     * @return MIME type
+     */
+    const char* getContentType() const
+    {
+        return (FORMAT_BMP == m_format) ? "image/bmp" : "image/png";
+    }
+
+    /**
+     * Write the next part of the image to the buffer.
+     *
+     * @param[out]  buffer  Buffer
+     * @param[in]   maxLen  Buffer size in bytes
+     *
+     * @return Number of written bytes. If 0, the image is complete.
+     */
+    size_t fill(uint8_t* buffer, size_t maxLen);
+
+    /** Max. integer upscaling factor. */
+    static const uint8_t    MAX_SCALE   = 16U;
+
+private:
+
+    /** Size of the buffer for headers and trailers in bytes. */
+    static const size_t     HEAD_SIZE   = 64U;
+
+    /**
+     * Output states.
+     */
+    enum State
+    {
+        STATE_HEADER = 0,   /**< Write image header */
+        STATE_DATA,         /**< Write image data */
+        STATE_TRAILER,      /**< Write image trailer */
+        STATE_FINISHED      /**< Output complete */
+    };
+
+    Format      m_format;           /**< Image format */
+    uint32_t*   m_framebuffer;      /**< Copy of the display framebuffer */
+    uint16_t    m_width;            /**< Framebuffer width in pixel */
+    uint16_t    m_height;           /**< Framebuffer height in pixel */
+    uint8_t     m_scale;            /**< Upscaling factor */
+    size_t      m_size;             /**< Total image size in bytes */
+    State       m_state;            /**< Output state */
+    uint8_t     m_head[HEAD_SIZE];  /**< Current header, block header or trailer */
+    size_t      m_headLen;          /**< Length of the current header */
+    size_t      m_headIdx;          /**< Read index in the current header */
+    uint8_t*    m_row;              /**< Current image row in file format */
+    size_t      m_rowLen;           /**< Length of a image row in bytes */
+    size_t      m_rowIdx;           /**< Read index in the current image row */
+    uint32_t    m_rowY;             /**< Number of generated image rows */
+    size_t      m_rawRemaining;     /**< Remaining image data bytes */
+    size_t      m_blockRemaining;   /**< Remaining bytes in the current deflate block (PNG only) */
+    uint32_t    m_crc;              /**< CRC-32 of the IDAT chunk (PNG only) */
+    uint32_t    m_adler;            /**< Adler-32 of the zlib stream (PNG only) */
+
+    DisplaySnapshot(const DisplaySnapshot& snapshot);
+    DisplaySnapshot& operator=(const DisplaySnapshot& snapshot);
+
+    /**
+     * Prepare the header or trailer, depended on the output state.
+     */
+    void nextHead();
+
+    /**
+     * Prepare the header of the next stored deflate block (PNG only).
+     */
+    void nextBlockHead();
+
+    /**
+     * Generate the next image row in file format.
+     */
+    void nextRow();
+
+    /**
+     * Release the framebuffer copy and the row buffer.
+     */
+    void release();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __DISPLAY_SNAPSHOT_H__ */
+
+/** @} */
@@ -0,0 +1,516 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming directory listing
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "FileListing.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <ArduinoJson.h>
+#include <esp_system.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * A parked directory listing, which can be resumed by its cursor.
+ * It keeps no file handle open, only the position of the next entry.
+ */
+typedef struct
+{
+    uint32_t        id;         /**< Random cursor id, 0 if the slot is free. */
+    FS*             fs;         /**< Filesystem of the directory */
+    String          path;       /**< Path of the directory */
+    String          next;       /**< Path of the next entry, which shall be listed. */
+    uint32_t        offset;     /**< Offset of the next entry in the directory. */
+    unsigned long   timestamp;  /**< Timestamp in ms, when the listing was parked. */
+
+} ParkedListing;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void releaseParkedListing(ParkedListing& parkedListing);
+static void releaseExpiredListings();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/**
+ * Parked directory listings. The table is only accessed from the web server
+ * context, therefore no additional locking is necessary.
+ */
+static ParkedListing    gParkedListings[FileListing::MAX_CURSORS];
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+FileListing::FileListing() :
+    m_fs(nullptr),
+    m_path(),
+    m_dir(),
+    m_next(),
+    m_offset(0U),
+    m_maxCount(NO_LIMIT),
+    m_isResumable(false),
+    m_count(0U),
+    m_cursor(),
+    m_state(STATE_HEADER),
+    m_isFirstItem(true),
+    m_line(),
+    m_lineLen(0U),
+    m_lineIdx(0U)
+{
+}
+
+FileListing::~FileListing()
+{
+    release();
+}
+
+bool FileListing::begin(FS& fs, const String& path, uint32_t skip, uint32_t maxCount, bool isResumable)
+{
+    bool isSuccessful = false;
+
+    release();
+    releaseExpiredListings();
+
+    m_maxCount      = maxCount;
+    m_isResumable   = isResumable;
+
+    if (true == openDir(fs, path))
+    {
+        skipEntries(skip);
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool FileListing::resume(const String& cursor, uint32_t maxCount)
+{
+    bool            isSuccessful    = false;
+    unsigned int    slot            = 0U;
+    unsigned int    id              = 0U;
+
+    release();
+    releaseExpiredListings();
+
+    if ((2 == sscanf(cursor.c_str(), "%u.%x", &slot, &id)) &&
+        (MAX_CURSORS > slot) &&
+        (0U != id) &&
+        (id == gParkedListings[slot].id))
+    {
+        ParkedListing&  parkedListing   = gParkedListings[slot];
+        FS*             fs              = parkedListing.fs;
+        String          path            = parkedListing.path;
+        String          next            = parkedListing.next;
+        uint32_t        offset          = parkedListing.offset;
+
+        /* The cursor can be used only once. */
+        releaseParkedListing(parkedListing);
+
+        m_maxCount      = maxCount;
+        m_isResumable   = true;
+
+        if ((nullptr != fs) &&
+            (true == openDir(*fs, path)))
+        {
+            if (false == seek(next, offset))
+            {
+                release();
+            }
+            else
+            {
+                isSuccessful = true;
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+size_t FileListing::fill(uint8_t* buffer, size_t maxLen)
+{
+    size_t written = 0U;
+
+    if (nullptr != buffer)
+    {
+        while((maxLen > written) &&
+              ((STATE_FINISHED != m_state) || (m_lineLen > m_lineIdx)))
+        {
+            /* Current line completely written? */
+            if (m_lineLen <= m_lineIdx)
+            {
+                nextLine();
+            }
+            else
+            {
+                size_t len = m_lineLen - m_lineIdx;
+
+                if ((maxLen - written) < len)
+                {
+                    len = maxLen - written;
+                }
+
+                memcpy(&buffer[written], &m_line[m_lineIdx], len);
+                m_lineIdx   += len;
+                written     += len;
+            }
+        }
+    }
+
+    return written;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool FileListing::openDir(FS& fs, const String& path)
+{
+    m_offset    = 0U;
+    m_dir       = fs.open(path, "r");
+
+    if (false == m_dir)
+    {
+        m_dir = File();
+    }
+    else if (false == m_dir.isDirectory())
+    {
+        m_dir.close();
+        m_dir = File();
+    }
+    else
+    {
+        m_fs    = &fs;
+        m_path  = path;
+    }
+
+    return (true == m_dir);
+}
+
+void FileListing::skipEntries(uint32_t count)
+{
+    while(0U < count)
+    {
+        File entry = m_dir.openNextFile();
+
+        if (false == entry)
+        {
+            count = 0U;
+        }
+        else
+        {
+            entry.close();
+            ++m_offset;
+            --count;
+        }
+    }
+
+    return;
+}
+
+bool FileListing::seek(const String& name, uint32_t offset)
+{
+    skipEntries(offset);
+    m_next = m_dir.openNextFile();
+
+    /* Directory changed in the meantime? */
+    if ((false == m_next) ||
+        (name != m_next.path()))
+    {
+        if (true == m_next)
+        {
+            m_next.close();
+        }
+
+        m_dir.rewindDirectory();
+        m_offset    = 0U;
+        m_next      = m_dir.openNextFile();
+
+        while((true == m_next) &&
+              (name != m_next.path()))
+        {
+            m_next.close();
+            ++m_offset;
+            m_next = m_dir.openNextFile();
+        }
+    }
+
+    return (true == m_next);
+}
+
+void FileListing::nextLine()
+{
+    int len = 0;
+
+    switch(m_state)
+    {
+    case STATE_HEADER:
+        len     = snprintf(m_line, sizeof(m_line), "{\"data\":[");
+        m_state = STATE_ENTRIES;
+        break;
+
+    case STATE_ENTRIES:
+        if ((NO_LIMIT != m_maxCount) &&
+            (m_maxCount <= m_count))
+        {
+            if (true == m_isResumable)
+            {
+                park();
+            }
+
+            m_state = STATE_FOOTER;
+        }
+        else
+        {
+            File entry = nextEntry();
+
+            if (false == entry)
+            {
+                m_state = STATE_FOOTER;
+            }
+            else
+            {
+                const size_t                        JSON_DOC_SIZE   = 128U;
+                StaticJsonDocument<JSON_DOC_SIZE>   jsonDoc;
+                size_t                              lineLen         = 0U;
+
+                /* Use ArduinoJson for the entry, because the path may contain characters which need to be escaped. */
+                jsonDoc["name"] = entry.path();
+                jsonDoc["size"] = entry.size();
+                jsonDoc["type"] = (true == entry.isDirectory()) ? "dir" : "file";
+
+                if (false == m_isFirstItem)
+                {
+                    m_line[lineLen] = ',';
+                    ++lineLen;
+                }
+
+                lineLen += serializeJson(jsonDoc, &m_line[lineLen], sizeof(m_line) - lineLen);
+                len = static_cast<int>(lineLen);
+
+                entry.close();
+
+                m_isFirstItem = false;
+                ++m_count;
+            }
+        }
+        break;
+
+    case STATE_FOOTER:
+        if (true == m_cursor.isEmpty())
+        {
+            len = snprintf(m_line, sizeof(m_line), "],\"status\":\"ok\"}");
+        }
+        else
+        {
+            len = snprintf(m_line, sizeof(m_line), "],\"cursor\":\"%s\",\"status\":\"ok\"}", m_cursor.c_str());
+        }
+
+        /* The directory is not needed anymore, a parked listing opens it again. */
+        release();
+        m_state = STATE_FINISHED;
+        break;
+
+    case STATE_FINISHED:
+    default:
+        break;
+    }
+
+    if (0 > len)
+    {
+        len = 0;
+    }
+    else if (static_cast<int>(sizeof(m_line)) <= len)
+    {
+        len = sizeof(m_line) - 1U;
+    }
+    else
+    {
+        ;
+    }
+
+    m_lineLen = static_cast<size_t>(len);
+    m_lineIdx = 0U;
+}
+
+File FileListing::nextEntry()
+{
+    File entry;
+
+    if (true == m_next)
+    {
+        entry   = m_next;
+        m_next  = File();
+    }
+    else if (true == m_dir)
+    {
+        entry = m_dir.openNextFile();
+    }
+    else
+    {
+        ;
+    }
+
+    return entry;
+}
+
+void FileListing::park()
+{
+    File entry = nextEntry();
+
+    if (true == entry)
+    {
+        uint8_t slot    = 0U;
+        uint8_t idx     = 0U;
+
+        /* Use a free slot or evict the oldest parked listing. */
+        for(idx = 0U; idx < MAX_CURSORS; ++idx)
+        {
+            if (0U == gParkedListings[idx].id)
+            {
+                slot = idx;
+                break;
+            }
+            else if (static_cast<long>(gParkedListings[idx].timestamp - gParkedListings[slot].timestamp) < 0)
+            {
+                slot = idx;
+            }
+            else
+            {
+                ;
+            }
+        }
+
+        releaseParkedListing(gParkedListings[slot]);
+
+        /* The random id prevents that a old or guessed cursor resumes a foreign listing. */
+        do
+        {
+            gParkedListings[slot].id = esp_random();
+        }
+        while(0U == gParkedListings[slot].id);
+
+        gParkedListings[slot].fs        = m_fs;
+        gParkedListings[slot].path      = m_path;
+        gParkedListings[slot].next      = entry.path();
+        gParkedListings[slot].offset    = m_offset + m_count;
+        gParkedListings[slot].timestamp = millis();
+
+        entry.close();
+
+        m_cursor  = String(slot);
+        m_cursor += ".";
+        m_cursor += String(gParkedListings[slot].id, HEX);
+    }
+
+    return;
+}
+
+void FileListing::release()
+{
+    if (true == m_next)
+    {
+        m_next.close();
+        m_next = File();
+    }
+
+    if (true == m_dir)
+    {
+        m_dir.close();
+        m_dir = File();
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Release a parked directory listing and free its slot.
+ *
+ * @param[in] parkedListing Parked directory listing
+ */
+static void releaseParkedListing(ParkedListing& parkedListing)
+{
+    parkedListing.id    = 0U;
+    parkedListing.fs    = nullptr;
+    parkedListing.path  = String();
+    parkedListing.next  = String();
+
+    return;
+}
+
+/**
+ * Release all parked directory listings, which were not resumed in time.
+ */
+static void releaseExpiredListings()
+{
+    unsigned long   timestamp   = millis();
+    uint8_t         idx         = 0U;
+
+    for(idx = 0U; idx < FileListing::MAX_CURSORS; ++idx)
+    {
+        if ((0U != gParkedListings[idx].id) &&
+            (FileListing::CURSOR_TIMEOUT <= (timestamp - gParkedListings[idx].timestamp)))
+        {
+            releaseParkedListing(gParkedListings[idx]);
+        }
+    }
+
+    return;
+}
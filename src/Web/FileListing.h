@@ -0,0 +1,225 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Streaming directory listing
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __FILE_LISTING_H__
+#define __FILE_LISTING_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <FS.h>
+#include <WString.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Lists the entries of a directory as JSON. The JSON output is generated
+ * piecewise, which allows to use it with a chunked HTTP response without
+ * keeping the whole listing in memory.
+ *
+ * Output: {"data": [{"name": <path>, "size": <size>, "type": "file"|"dir"}, ...], "cursor": <cursor>, "status": "ok"}
+ *
+ * If a resumable listing is limited by a max. number of entries and there
+ * are more entries left, the output contains a opaque cursor. Only the
+ * position of the next entry (name and offset) is kept, not the open
+ * directory, because the filesystem provides only a few file handles.
+ * The listing can be resumed with the cursor later on, the directory is
+ * opened again and the listing continues at the kept position. A cursor
+ * can only be used once and expires after CURSOR_TIMEOUT ms, if it is not
+ * used. The cursor is missing, if all entries are listed.
+ */
+class FileListing
+{
+public:
+
+    /**
+     * Constructs the directory listing.
+     */
+    FileListing();
+
+    /**
+     * Destroys the directory listing.
+     */
+    ~FileListing();
+
+    /**
+     * Begin a new listing of a directory.
+     *
+     * @param[in] fs            Filesystem
+     * @param[in] path          Path of the directory
+     * @param[in] skip          Number of entries to skip at the beginning.
+     * @param[in] maxCount      Max. number of listed entries. Use NO_LIMIT to list all.
+     * @param[in] isResumable   If true, a cursor is provided in case more entries are left.
+     *
+     * @return If the directory is available, it will return true otherwise false.
+     *         If not, the listing will be empty.
+     */
+    bool begin(FS& fs, const String& path, uint32_t skip, uint32_t maxCount, bool isResumable);
+
+    /**
+     * Resume a listing with a cursor, which was provided by a previous listing.
+     *
+     * @param[in] cursor    Cursor
+     * @param[in] maxCount  Max. number of listed entries. Use NO_LIMIT to list all.
+     *
+     * @return If the cursor is valid, it will return true otherwise false.
+     */
+    bool resume(const String& cursor, uint32_t maxCount);
+
+    /**
+     * Write the next part of the JSON output to the buffer.
+     *
+     * @param[out]  buffer  Buffer
+     * @param[in]   maxLen  Buffer size in bytes
+     *
+     * @return Number of written bytes. If 0, the output is complete.
+     */
+    size_t fill(uint8_t* buffer, size_t maxLen);
+
+    /** Use it to list all entries of a directory. */
+    static const uint32_t   NO_LIMIT        = 0U;
+
+    /** Max. number of cursors, which can be valid at the same time. */
+    static const uint8_t    MAX_CURSORS     = 4U;
+
+    /** A not used cursor expires after this time in ms. */
+    static const uint32_t   CURSOR_TIMEOUT  = 30000U;
+
+private:
+
+    /** Max. length of a single JSON output line. */
+    static const size_t     LINE_SIZE       = 256U;
+
+    /**
+     * Output states.
+     */
+    enum State
+    {
+        STATE_HEADER = 0,   /**< Write JSON header */
+        STATE_ENTRIES,      /**< Write directory entries */
+        STATE_FOOTER,       /**< Write JSON footer */
+        STATE_FINISHED      /**< Output complete */
+    };
+
+    FS*         m_fs;               /**< Filesystem of the listed directory. */
+    String      m_path;             /**< Path of the listed directory. */
+    File        m_dir;              /**< Directory, which is listed. */
+    File        m_next;             /**< Next entry, already read from the directory. */
+    uint32_t    m_offset;           /**< Number of entries before the first listed one. */
+    uint32_t    m_maxCount;         /**< Max. number of entries to list. */
+    bool        m_isResumable;      /**< Provide a cursor if more entries are left? */
+    uint32_t    m_count;            /**< Number of listed entries. */
+    String      m_cursor;           /**< Cursor, which is reported at the end. */
+    State       m_state;            /**< Output state */
+    bool        m_isFirstItem;      /**< Is first item in the JSON array? */
+    char        m_line[LINE_SIZE];  /**< Current output line */
+    size_t      m_lineLen;          /**< Length of the current output line */
+    size_t      m_lineIdx;          /**< Read index in the current output line */
+
+    FileListing(const FileListing& listing);
+    FileListing& operator=(const FileListing& listing);
+
+    /**
+     * Open the directory, which shall be listed.
+     *
+     * @param[in] fs    Filesystem
+     * @param[in] path  Path of the directory
+     *
+     * @return If the directory is available, it will return true otherwise false.
+     */
+    bool openDir(FS& fs, const String& path);
+
+    /**
+     * Skip a number of directory entries.
+     *
+     * @param[in] count Number of entries to skip.
+     */
+    void skipEntries(uint32_t count);
+
+    /**
+     * Seek to the entry, where a parked listing shall continue.
+     * The offset is only a hint, because the directory may have changed
+     * since the listing was parked. If the entry is not found there,
+     * the whole directory is searched for it.
+     *
+     * @param[in] name      Path of the next entry
+     * @param[in] offset    Expected offset of the next entry
+     *
+     * @return If the entry is found, it will return true otherwise false.
+     */
+    bool seek(const String& name, uint32_t offset);
+
+    /**
+     * Prepare the next output line, depended on the output state.
+     */
+    void nextLine();
+
+    /**
+     * Get the next directory entry.
+     *
+     * @return Directory entry or a invalid file, if there are no more entries.
+     */
+    File nextEntry();
+
+    /**
+     * If there are more entries left, the position of the next entry is
+     * parked with a new cursor, so the listing can be resumed later on.
+     */
+    void park();
+
+    /**
+     * Release the directory and the pending entry.
+     */
+    void release();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __FILE_LISTING_H__ */
+
+/** @} */
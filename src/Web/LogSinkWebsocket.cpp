@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "LogSinkWebsocket.h"
+#include "MemTag.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -62,6 +63,7 @@ void LogSinkWebsocket::send(const Logging::Msg& msg)
 {
     if (nullptr != m_output)
     {
+        MemTagGuard memTagGuard(MemTag::ID_LOGGING);
         String      buffer;
         const char  DELIMITER = ';';
 
@@ -0,0 +1,1079 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  MQTT client
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MqttClient.h"
+
+#include <Logging.h>
+#include <Util.h>
+#include <new>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+MqttClient::MqttClient() :
+    m_tcpClient(),
+    m_evtQueue(),
+    m_mutex(),
+    m_state(STATE_IDLE),
+    m_onConnected(),
+    m_onMessage(),
+    m_hostname(),
+    m_port(MQTT_PORT),
+    m_user(),
+    m_password(),
+    m_clientId(),
+    m_timestamp(0U),
+    m_reconnectPeriod(RECONNECT_PERIOD_MIN),
+    m_lastTxTimestamp(0U),
+    m_lastRxTimestamp(0U),
+    m_isPingPending(false),
+    m_packetId(0U),
+    m_outQueue(),
+    m_outQueueCnt(0U),
+    m_droppedCnt(0U),
+    m_subRequests(),
+    m_rxBuffer(),
+    m_txBuffer()
+{
+    (void)m_evtQueue.create(EVT_QUEUE_SIZE);
+    (void)m_mutex.create();
+
+    m_tcpClient.onConnect(  [this](void* arg, AsyncClient* client)
+                            {
+                                Event   evt;
+
+                                UTIL_NOT_USED(arg);
+                                UTIL_NOT_USED(client);
+
+                                memset(&evt, 0, sizeof(evt));
+                                evt.id = EVENT_ID_CONNECTED;
+
+                                (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
+                            });
+
+    m_tcpClient.onDisconnect(   [this](void* arg, AsyncClient* client)
+                                {
+                                    Event   evt;
+
+                                    UTIL_NOT_USED(arg);
+                                    UTIL_NOT_USED(client);
+
+                                    memset(&evt, 0, sizeof(evt));
+                                    evt.id = EVENT_ID_DISCONNECTED;
+
+                                    (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
+                                });
+
+    m_tcpClient.onError(    [this](void* arg, AsyncClient* client, int8_t error)
+                            {
+                                Event   evt;
+
+                                UTIL_NOT_USED(arg);
+                                UTIL_NOT_USED(client);
+
+                                memset(&evt, 0, sizeof(evt));
+                                evt.id      = EVENT_ID_ERROR;
+                                evt.u.error = error;
+
+                                (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
+                            });
+
+    m_tcpClient.onData( [this](void* arg, AsyncClient* client, void* data, size_t len)
+                        {
+                            Event   evt;
+
+                            UTIL_NOT_USED(arg);
+                            UTIL_NOT_USED(client);
+
+                            memset(&evt, 0, sizeof(evt));
+                            evt.id          = EVENT_ID_DATA;
+                            evt.u.data.data = new(std::nothrow) uint8_t[len];
+
+                            if (nullptr == evt.u.data.data)
+                            {
+                                evt.u.data.size = 0U;
+                            }
+                            else
+                            {
+                                evt.u.data.size = len;
+                                memcpy(evt.u.data.data, data, len);
+                            }
+
+                            (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
+                        });
+
+    m_tcpClient.onTimeout(  [this](void* arg, AsyncClient* client, uint32_t timeout)
+                            {
+                                Event   evt;
+
+                                UTIL_NOT_USED(arg);
+                                UTIL_NOT_USED(client);
+
+                                memset(&evt, 0, sizeof(evt));
+                                evt.id          = EVENT_ID_TIMEOUT;
+                                evt.u.timeout   = timeout;
+
+                                (void)m_evtQueue.sendToBack(evt, portMAX_DELAY);
+                            });
+}
+
+MqttClient::~MqttClient()
+{
+    /* Unregister first all callbacks before cleaning the
+     * event queue.
+     */
+    m_tcpClient.onConnect(nullptr);
+    m_tcpClient.onDisconnect(nullptr);
+    m_tcpClient.onError(nullptr);
+    m_tcpClient.onData(nullptr);
+    m_tcpClient.onTimeout(nullptr);
+    m_mutex.destroy();
+    clearEvtQueue();
+    m_evtQueue.destroy();
+}
+
+bool MqttClient::begin(const String& url, const String& clientId)
+{
+    bool    status  = true;
+    String  host;
+    int     index   = 0;
+
+    end();
+
+    /* The URL must contain the protocol. */
+    if (false == url.startsWith("mqtt://"))
+    {
+        LOG_ERROR("Unknown protocol in \"%s\".", url.c_str());
+        status = false;
+    }
+    else
+    {
+        host = url.substring(strlen("mqtt://"));
+
+        /* Remove trailing path, it is not used. */
+        index = host.indexOf('/');
+
+        if (0 <= index)
+        {
+            host.remove(index);
+        }
+
+        /* Get user and password */
+        index = host.indexOf('@');
+
+        if (0 <= index)
+        {
+            String  auth        = host.substring(0, index);
+            int     authIndex   = auth.indexOf(':');
+
+            if (0 > authIndex)
+            {
+                m_user = auth;
+                m_password.clear();
+            }
+            else
+            {
+                m_user      = auth.substring(0, authIndex);
+                m_password  = auth.substring(authIndex + 1);
+            }
+
+            /* Remove authorization from host string. */
+            host.remove(0, index + 1);
+        }
+
+        /* Get port */
+        index   = host.indexOf(':');
+        m_port  = MQTT_PORT;
+
+        if (0 <= index)
+        {
+            long portNo = host.substring(index + 1).toInt();
+
+            if ((0 >= portNo) ||
+                (UINT16_MAX < portNo))
+            {
+                LOG_ERROR("Invalid port in \"%s\".", url.c_str());
+                status = false;
+            }
+            else
+            {
+                m_port = static_cast<uint16_t>(portNo);
+            }
+
+            host.remove(index);
+        }
+
+        if (true == host.isEmpty())
+        {
+            LOG_ERROR("No host in \"%s\".", url.c_str());
+            status = false;
+        }
+    }
+
+    if (false == status)
+    {
+        m_user.clear();
+        m_password.clear();
+    }
+    else
+    {
+        LOG_INFO("MQTT broker: %s:%u", host.c_str(), m_port);
+
+        m_hostname          = host;
+        m_clientId          = clientId;
+        m_reconnectPeriod   = RECONNECT_PERIOD_MIN;
+
+        /* Connect immediately in the next process() call. */
+        m_timestamp         = millis() - m_reconnectPeriod;
+        m_state             = STATE_DISCONNECTED;
+    }
+
+    return status;
+}
+
+void MqttClient::end()
+{
+    if (STATE_IDLE != m_state)
+    {
+        if (STATE_CONNECTED == m_state)
+        {
+            MqttPacket::appendFixedHeader(m_txBuffer, MqttPacket::PACKET_TYPE_DISCONNECT << 4U, 0U);
+            (void)flush();
+        }
+
+        m_state = STATE_IDLE;
+        m_tcpClient.close(true);
+    }
+
+    clearEvtQueue();
+
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+        size_t              idx     = 0U;
+
+        for(idx = 0U; idx < m_outQueueCnt; ++idx)
+        {
+            m_outQueue[idx] = Message();
+        }
+
+        m_outQueueCnt = 0U;
+        m_subRequests.clear();
+    }
+
+    m_rxBuffer.clear();
+    m_txBuffer.clear();
+    m_hostname.clear();
+    m_user.clear();
+    m_password.clear();
+
+    return;
+}
+
+void MqttClient::regOnConnected(const OnConnected& onConnected)
+{
+    m_onConnected = onConnected;
+}
+
+void MqttClient::regOnMessage(const OnMessage& onMessage)
+{
+    m_onMessage = onMessage;
+}
+
+bool MqttClient::publish(const String& topic, const String& payload, QoS qos, bool retain)
+{
+    bool isSuccessful = false;
+
+    if (STATE_IDLE != m_state)
+    {
+        Message msg;
+
+        msg.topic   = topic;
+        msg.payload = payload;
+        msg.qos     = qos;
+        msg.retain  = retain;
+
+        isSuccessful = enqueue(msg);
+    }
+
+    return isSuccessful;
+}
+
+size_t MqttClient::getFreeQueueSize() const
+{
+    MutexGuard<Mutex> guard(m_mutex);
+
+    return OUT_QUEUE_SIZE - m_outQueueCnt;
+}
+
+bool MqttClient::subscribe(const String& topic, QoS qos)
+{
+    bool isSuccessful = false;
+
+    if (STATE_IDLE != m_state)
+    {
+        SubRequest request;
+
+        request.topic   = topic;
+        request.qos     = qos;
+
+        addSubRequest(request);
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool MqttClient::unsubscribe(const String& topic)
+{
+    bool isSuccessful = false;
+
+    if (STATE_IDLE != m_state)
+    {
+        SubRequest request;
+
+        request.topic           = topic;
+        request.isUnsubscribe   = true;
+
+        addSubRequest(request);
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+void MqttClient::process()
+{
+    processEvtQueue();
+    processConnection();
+
+    if (STATE_CONNECTED == m_state)
+    {
+        sendOutQueue();
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void MqttClient::processEvtQueue()
+{
+    Event evt;
+
+    while(true == m_evtQueue.receive(&evt, 0U))
+    {
+        switch(evt.id)
+        {
+        case EVENT_ID_CONNECTED:
+            if (STATE_TCP_CONNECTING == m_state)
+            {
+                sendConnect();
+            }
+            break;
+
+        case EVENT_ID_DISCONNECTED:
+            onDisconnect();
+            break;
+
+        case EVENT_ID_ERROR:
+            LOG_WARNING("MQTT connection error: %d", evt.u.error);
+            m_tcpClient.close(true);
+            onDisconnect();
+            break;
+
+        case EVENT_ID_DATA:
+            if (nullptr != evt.u.data.data)
+            {
+                onData(evt.u.data.data, evt.u.data.size);
+
+                delete[] evt.u.data.data;
+                evt.u.data.data = nullptr;
+                evt.u.data.size = 0U;
+            }
+            break;
+
+        case EVENT_ID_TIMEOUT:
+            LOG_WARNING("MQTT connection timeout: %u ms", evt.u.timeout);
+            m_tcpClient.close(true);
+            onDisconnect();
+            break;
+
+        default:
+            break;
+        };
+    }
+}
+
+void MqttClient::clearEvtQueue()
+{
+    Event evt;
+
+    while(true == m_evtQueue.receive(&evt, 0U))
+    {
+        if ((EVENT_ID_DATA == evt.id) &&
+            (nullptr != evt.u.data.data))
+        {
+            delete[] evt.u.data.data;
+            evt.u.data.data = nullptr;
+            evt.u.data.size = 0U;
+        }
+    }
+}
+
+void MqttClient::processConnection()
+{
+    uint32_t    timestamp           = millis();
+    uint32_t    keepAlivePeriod     = KEEP_ALIVE * 1000U;
+
+    switch(m_state)
+    {
+    case STATE_IDLE:
+        /* Nothing to do. */
+        break;
+
+    case STATE_DISCONNECTED:
+        if (m_reconnectPeriod <= (timestamp - m_timestamp))
+        {
+            m_timestamp = timestamp;
+
+            if (false == m_tcpClient.connect(m_hostname.c_str(), m_port))
+            {
+                LOG_WARNING("Connecting to MQTT broker %s:%u failed.", m_hostname.c_str(), m_port);
+
+                /* Back off to avoid flooding the network with connection attempts. */
+                m_reconnectPeriod = (RECONNECT_PERIOD_MAX / 2U < m_reconnectPeriod) ? RECONNECT_PERIOD_MAX : (2U * m_reconnectPeriod);
+            }
+            else
+            {
+                m_state = STATE_TCP_CONNECTING;
+            }
+        }
+        break;
+
+    case STATE_TCP_CONNECTING:
+        /* fallthrough */
+    case STATE_MQTT_CONNECTING:
+        if (CONNACK_TIMEOUT <= (timestamp - m_timestamp))
+        {
+            LOG_WARNING("MQTT broker doesn't respond.");
+            m_tcpClient.close(true);
+            onDisconnect();
+        }
+        break;
+
+    case STATE_CONNECTED:
+        /* The broker shall respond at least to the PINGREQ within the keep alive period. */
+        if (keepAlivePeriod <= (timestamp - m_lastRxTimestamp))
+        {
+            LOG_WARNING("MQTT broker keep alive timeout.");
+            m_tcpClient.close(true);
+            onDisconnect();
+        }
+        else if ((false == m_isPingPending) &&
+                 (((keepAlivePeriod / 2U) <= (timestamp - m_lastTxTimestamp)) ||
+                  ((keepAlivePeriod / 2U) <= (timestamp - m_lastRxTimestamp))))
+        {
+            MqttPacket::appendFixedHeader(m_txBuffer, MqttPacket::PACKET_TYPE_PINGREQ << 4U, 0U);
+
+            if (true == flush())
+            {
+                m_isPingPending = true;
+            }
+        }
+        else
+        {
+            /* Nothing to do. */
+            ;
+        }
+        break;
+
+    default:
+        break;
+    };
+
+    return;
+}
+
+void MqttClient::onData(const uint8_t* data, size_t size)
+{
+    size_t  index       = 0U;
+    bool    isAborted   = false;
+
+    m_rxBuffer.insert(m_rxBuffer.end(), data, data + size);
+
+    /* Handle all complete packets. */
+    while((false == isAborted) && (2U <= (m_rxBuffer.size() - index)))
+    {
+        uint8_t                     header          = m_rxBuffer[index];
+        size_t                      remainingLength = 0U;
+        size_t                      lenIndex        = 0U;
+        MqttPacket::DecodeResult    result          = MqttPacket::decodeRemainingLength(&m_rxBuffer[index + 1U], m_rxBuffer.size() - index - 1U, remainingLength, lenIndex);
+
+        if (MqttPacket::DECODE_RESULT_MALFORMED == result)
+        {
+            isAborted = true;
+        }
+        /* Wait for more data. */
+        else if (MqttPacket::DECODE_RESULT_INCOMPLETE == result)
+        {
+            break;
+        }
+        else if (MAX_RX_PACKET_SIZE < (1U + lenIndex + remainingLength))
+        {
+            LOG_WARNING("MQTT packet too big: %u byte", 1U + lenIndex + remainingLength);
+            isAborted = true;
+        }
+        /* Packet not complete yet? */
+        else if ((m_rxBuffer.size() - index) < (1U + lenIndex + remainingLength))
+        {
+            break;
+        }
+        else
+        {
+            if (false == handlePacket(header, &m_rxBuffer[index + 1U + lenIndex], remainingLength))
+            {
+                isAborted = true;
+            }
+
+            index += 1U + lenIndex + remainingLength;
+        }
+    }
+
+    if (true == isAborted)
+    {
+        LOG_WARNING("Invalid MQTT packet received.");
+        m_rxBuffer.clear();
+        m_tcpClient.close(true);
+        onDisconnect();
+    }
+    else
+    {
+        m_rxBuffer.erase(m_rxBuffer.begin(), m_rxBuffer.begin() + index);
+    }
+
+    return;
+}
+
+bool MqttClient::handlePacket(uint8_t header, const uint8_t* data, size_t size)
+{
+    bool        isValid     = true;
+    uint8_t     type        = header >> 4U;
+    uint16_t    packetId    = 0U;
+
+    m_lastRxTimestamp = millis();
+
+    switch(type)
+    {
+    case MqttPacket::PACKET_TYPE_CONNACK:
+        if ((STATE_MQTT_CONNECTING != m_state) ||
+            (2U != size))
+        {
+            isValid = false;
+        }
+        else if (0U != data[1])
+        {
+            LOG_WARNING("MQTT connection refused: %u", data[1]);
+            isValid = false;
+        }
+        else
+        {
+            LOG_INFO("MQTT connected.");
+
+            m_state             = STATE_CONNECTED;
+            m_reconnectPeriod   = RECONNECT_PERIOD_MIN;
+            m_isPingPending     = false;
+
+            if (nullptr != m_onConnected)
+            {
+                m_onConnected();
+            }
+        }
+        break;
+
+    case MqttPacket::PACKET_TYPE_PUBLISH:
+        {
+            MqttPacket::Publish publish;
+
+            /* QoS 2 is never used, because the subscriptions request max. QoS 1. */
+            if (false == MqttPacket::decodePublish(header, data, size, publish))
+            {
+                isValid = false;
+            }
+            else
+            {
+                String topic;
+
+                (void)topic.concat(publish.topic, publish.topicLen);
+
+                if (QOS_1 == publish.qos)
+                {
+                    MqttPacket::appendFixedHeader(m_txBuffer, MqttPacket::PACKET_TYPE_PUBACK << 4U, 2U);
+                    MqttPacket::appendUInt16(m_txBuffer, publish.packetId);
+                    (void)flush();
+                }
+
+                if (nullptr != m_onMessage)
+                {
+                    m_onMessage(topic, publish.payload, publish.payloadSize);
+                }
+            }
+        }
+        break;
+
+    case MqttPacket::PACKET_TYPE_PUBACK:
+        if (2U != size)
+        {
+            isValid = false;
+        }
+        else
+        {
+            ackMessage(MqttPacket::decodeUInt16(data));
+        }
+        break;
+
+    case MqttPacket::PACKET_TYPE_UNSUBACK:
+        if (2U != size)
+        {
+            isValid = false;
+        }
+        else
+        {
+            ackSubRequest(MqttPacket::decodeUInt16(data));
+        }
+        break;
+
+    case MqttPacket::PACKET_TYPE_SUBACK:
+        if (3U > size)
+        {
+            isValid = false;
+        }
+        else
+        {
+            packetId = MqttPacket::decodeUInt16(data);
+
+            if (MqttPacket::SUBACK_FAILURE == data[2])
+            {
+                LOG_WARNING("MQTT subscription %u rejected.", packetId);
+            }
+
+            ackSubRequest(packetId);
+        }
+        break;
+
+    case MqttPacket::PACKET_TYPE_PINGRESP:
+        m_isPingPending = false;
+        break;
+
+    default:
+        isValid = false;
+        break;
+    };
+
+    return isValid;
+}
+
+void MqttClient::onDisconnect()
+{
+    if ((STATE_IDLE != m_state) &&
+        (STATE_DISCONNECTED != m_state))
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+        size_t              idx     = 0U;
+
+        if (STATE_CONNECTED == m_state)
+        {
+            LOG_INFO("MQTT disconnected.");
+        }
+        else
+        {
+            /* Back off to avoid flooding the network with connection attempts. */
+            m_reconnectPeriod = (RECONNECT_PERIOD_MAX / 2U < m_reconnectPeriod) ? RECONNECT_PERIOD_MAX : (2U * m_reconnectPeriod);
+        }
+
+        /* The client uses a clean session. Subscriptions are requested again
+         * after reconnect and not acknowledged messages are sent again.
+         */
+        for(idx = 0U; idx < m_outQueueCnt; ++idx)
+        {
+            m_outQueue[idx].isSent = false;
+        }
+
+        m_subRequests.clear();
+
+        m_state         = STATE_DISCONNECTED;
+        m_timestamp     = millis();
+
+        m_rxBuffer.clear();
+        m_txBuffer.clear();
+    }
+
+    return;
+}
+
+void MqttClient::sendConnect()
+{
+    MqttPacket::appendConnect(m_txBuffer, m_clientId, m_user, m_password, KEEP_ALIVE);
+
+    if (false == flush())
+    {
+        m_tcpClient.close(true);
+        onDisconnect();
+    }
+    else
+    {
+        m_state             = STATE_MQTT_CONNECTING;
+        m_timestamp         = millis();
+        m_lastRxTimestamp   = m_timestamp;
+    }
+
+    return;
+}
+
+void MqttClient::sendOutQueue()
+{
+    MutexGuard<Mutex>   guard(m_mutex);
+    uint32_t            timestamp   = millis();
+    size_t              space       = 0U;
+    size_t              idx         = 0U;
+    size_t              cnt         = 0U;
+    bool                isFull      = false;
+
+    /* Send first the rest of a packet, which didn't fit into the TCP send buffer before. */
+    if (false == flush())
+    {
+        LOG_WARNING("MQTT send failed.");
+        isFull = true;
+    }
+    else if (false == m_txBuffer.empty())
+    {
+        isFull = true;
+    }
+    else
+    {
+        space = m_tcpClient.space();
+    }
+
+    /* Serialize as many packets as fit into the TCP send buffer, to send
+     * them together. The subscription requests are walked through until all
+     * of them are sent and acknowledged.
+     */
+    for(idx = 0U; (idx < m_subRequests.size()) && (false == isFull); ++idx)
+    {
+        SubRequest& request = m_subRequests[idx];
+        size_t      size    = m_txBuffer.size();
+
+        if ((false == request.isSent) ||
+            (ACK_TIMEOUT <= (timestamp - request.timestamp)))
+        {
+            if (true == request.isUnsubscribe)
+            {
+                MqttPacket::appendUnsubscribe(m_txBuffer, request.packetId, request.topic);
+            }
+            else
+            {
+                MqttPacket::appendSubscribe(m_txBuffer, request.packetId, request.topic, request.qos);
+            }
+
+            if (false == keepPacket(size, space))
+            {
+                isFull = true;
+            }
+            else
+            {
+                request.isSent      = true;
+                request.timestamp   = timestamp;
+            }
+        }
+    }
+
+    for(idx = 0U; (idx < m_outQueueCnt) && (false == isFull); ++idx)
+    {
+        Message&    msg     = m_outQueue[idx];
+        size_t      size    = m_txBuffer.size();
+
+        if (true == msg.isSent)
+        {
+            /* Not acknowledged in time? */
+            if ((0U != msg.packetId) &&
+                (ACK_TIMEOUT <= (timestamp - msg.timestamp)))
+            {
+                MqttPacket::appendPublish(m_txBuffer, msg.topic, msg.payload, msg.qos, msg.retain, msg.packetId, true);
+            }
+        }
+        else
+        {
+            MqttPacket::appendPublish(m_txBuffer, msg.topic, msg.payload, msg.qos, msg.retain, msg.packetId, false);
+        }
+
+        if (size != m_txBuffer.size())
+        {
+            /* Doesn't fit anymore, the message is sent later. */
+            if (false == keepPacket(size, space))
+            {
+                isFull = true;
+            }
+            else
+            {
+                msg.isSent      = true;
+                msg.timestamp   = timestamp;
+            }
+        }
+    }
+
+    /* QoS 0 messages are done after they are sent. */
+    for(idx = 0U; idx < m_outQueueCnt; ++idx)
+    {
+        if ((true == m_outQueue[idx].isSent) &&
+            (0U == m_outQueue[idx].packetId))
+        {
+            m_outQueue[idx] = Message();
+        }
+        else
+        {
+            if (cnt != idx)
+            {
+                m_outQueue[cnt] = m_outQueue[idx];
+                m_outQueue[idx] = Message();
+            }
+
+            ++cnt;
+        }
+    }
+
+    m_outQueueCnt = cnt;
+
+    if (false == flush())
+    {
+        LOG_WARNING("MQTT send failed.");
+    }
+
+    return;
+}
+
+bool MqttClient::keepPacket(size_t size, size_t space)
+{
+    bool isKept = true;
+
+    /* A packet, which is bigger than the free TCP send buffer, would block all
+     * others. Therefore it is kept, if it is the first one and sent in parts.
+     */
+    if ((0U < size) &&
+        (space < m_txBuffer.size()))
+    {
+        m_txBuffer.resize(size);
+        isKept = false;
+    }
+
+    return isKept;
+}
+
+void MqttClient::ackMessage(uint16_t packetId)
+{
+    MutexGuard<Mutex>   guard(m_mutex);
+    size_t              idx     = 0U;
+
+    while((idx < m_outQueueCnt) &&
+          (packetId != m_outQueue[idx].packetId))
+    {
+        ++idx;
+    }
+
+    if (idx < m_outQueueCnt)
+    {
+        --m_outQueueCnt;
+
+        while(idx < m_outQueueCnt)
+        {
+            m_outQueue[idx] = m_outQueue[idx + 1U];
+            ++idx;
+        }
+
+        m_outQueue[m_outQueueCnt] = Message();
+    }
+
+    return;
+}
+
+void MqttClient::addSubRequest(const SubRequest& request)
+{
+    MutexGuard<Mutex>                   guard(m_mutex);
+    std::vector<SubRequest>::iterator   it      = m_subRequests.begin();
+
+    /* Only the latest request per topic filter is relevant. */
+    while(m_subRequests.end() != it)
+    {
+        if (request.topic == it->topic)
+        {
+            it = m_subRequests.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    m_subRequests.push_back(request);
+    m_subRequests.back().packetId = nextPacketId();
+
+    return;
+}
+
+void MqttClient::ackSubRequest(uint16_t packetId)
+{
+    MutexGuard<Mutex>                   guard(m_mutex);
+    std::vector<SubRequest>::iterator   it      = m_subRequests.begin();
+    bool                                isFound = false;
+
+    while((false == isFound) && (m_subRequests.end() != it))
+    {
+        if (packetId == it->packetId)
+        {
+            (void)m_subRequests.erase(it);
+            isFound = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return;
+}
+
+bool MqttClient::enqueue(const Message& msg)
+{
+    MutexGuard<Mutex>   guard(m_mutex);
+    bool                isSuccessful    = false;
+
+    if (OUT_QUEUE_SIZE <= m_outQueueCnt)
+    {
+        LOG_WARNING("MQTT queue full, %s dropped.", msg.topic.c_str());
+        ++m_droppedCnt;
+    }
+    else
+    {
+        Message& queuedMsg = m_outQueue[m_outQueueCnt];
+
+        queuedMsg = msg;
+
+        /* A packet identifier is only necessary, if a acknowledge is expected. */
+        if (QOS_0 != msg.qos)
+        {
+            queuedMsg.packetId = nextPacketId();
+        }
+
+        ++m_outQueueCnt;
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+uint16_t MqttClient::nextPacketId()
+{
+    ++m_packetId;
+
+    /* Packet identifier 0 is not allowed. */
+    if (0U == m_packetId)
+    {
+        m_packetId = 1U;
+    }
+
+    return m_packetId;
+}
+
+bool MqttClient::flush()
+{
+    bool isSuccessful = true;
+
+    if (false == m_txBuffer.empty())
+    {
+        size_t space    = m_tcpClient.space();
+        size_t size     = (space < m_txBuffer.size()) ? space : m_txBuffer.size();
+
+        /* If the TCP send buffer is full, the data is sent by the next call. */
+        if (0U < size)
+        {
+            if ((size != m_tcpClient.add(reinterpret_cast<const char*>(m_txBuffer.data()), size)) ||
+                (false == m_tcpClient.send()))
+            {
+                isSuccessful = false;
+                m_txBuffer.clear();
+            }
+            else
+            {
+                m_lastTxTimestamp = millis();
+                (void)m_txBuffer.erase(m_txBuffer.begin(), m_txBuffer.begin() + size);
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,491 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  MQTT client
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __MQTT_CLIENT_H__
+#define __MQTT_CLIENT_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <functional>
+#include <vector>
+#include <WString.h>
+#include <AsyncTCP.h>
+#include <Queue.hpp>
+#include <Mutex.hpp>
+#include <MqttPacket.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * MQTT 3.1.1 client, which supports QoS 0 and QoS 1.
+ *
+ * The TCP/IP stack notifications are queued and handled in the context of
+ * process(), which shall be called periodically. Published messages are
+ * queued in a bounded outbound queue and sent together in process(), which
+ * reduces the number of TCP segments. QoS 1 messages stay in the queue until
+ * they are acknowledged by the broker and are retransmitted after a timeout.
+ * A packet, which is bigger than the free TCP send buffer, is sent in parts
+ * over several process() calls.
+ *
+ * Subscribe and unsubscribe requests don't use the bounded outbound queue.
+ * They are kept in a separate list, with at most one request per topic filter,
+ * and are sent again until the broker acknowledged them.
+ *
+ * Used specification:
+ * - MQTT Version 3.1.1, OASIS Standard
+ */
+class MqttClient
+{
+public:
+
+    /**
+     * Quality of service
+     */
+    enum QoS
+    {
+        QOS_0 = 0,  /**< At most once delivery */
+        QOS_1       /**< At least once delivery */
+    };
+
+    /**
+     * Prototype of the callback, which is called after the connection to the broker is established.
+     */
+    typedef std::function<void()> OnConnected;
+
+    /**
+     * Prototype of the callback, which is called for every received message.
+     */
+    typedef std::function<void(const String& topic, const uint8_t* payload, size_t size)> OnMessage;
+
+    /**
+     * Constructs a MQTT client.
+     */
+    MqttClient();
+
+    /**
+     * Destroys the MQTT client.
+     */
+    ~MqttClient();
+
+    /**
+     * Parse the broker URL and connect to the broker.
+     * The URL format is mqtt://[<user>[:<password>]@]<host>[:<port>]
+     * If the connection is lost, the client will reconnect automatically.
+     *
+     * @param[in] url       Broker URL
+     * @param[in] clientId  Client identifier
+     *
+     * @return If successful parsed, it will return true otherwise false.
+     */
+    bool begin(const String& url, const String& clientId);
+
+    /**
+     * Disconnect from the broker and discard all queued messages.
+     */
+    void end();
+
+    /**
+     * Is the connection to the broker established?
+     *
+     * @return If connected, it will return true otherwise false.
+     */
+    bool isConnected() const
+    {
+        return (STATE_CONNECTED == m_state);
+    }
+
+    /**
+     * Register callback function, which is called after the connection to
+     * the broker is established. All subscriptions shall be done there,
+     * because the client uses a clean session.
+     *
+     * @param[in] onConnected   Callback
+     */
+    void regOnConnected(const OnConnected& onConnected);
+
+    /**
+     * Register callback function on message reception.
+     *
+     * @param[in] onMessage Callback
+     */
+    void regOnMessage(const OnMessage& onMessage);
+
+    /**
+     * Publish a message. It is queued and sent in the next process() call.
+     *
+     * @param[in] topic     Topic name
+     * @param[in] payload   Message payload
+     * @param[in] qos       Quality of service
+     * @param[in] retain    Shall the broker retain the message?
+     *
+     * @return If the message is queued, it will return true otherwise false.
+     */
+    bool publish(const String& topic, const String& payload, QoS qos, bool retain);
+
+    /**
+     * Get the number of messages, which can be published until the
+     * outbound queue is full.
+     *
+     * @return Number of free entries in the outbound queue
+     */
+    size_t getFreeQueueSize() const;
+
+    /**
+     * Subscribe a topic. It is sent in the next process() call and sent
+     * again until the broker acknowledged it.
+     *
+     * @param[in] topic Topic filter
+     * @param[in] qos   Max. quality of service
+     *
+     * @return If the subscription is requested, it will return true otherwise false.
+     */
+    bool subscribe(const String& topic, QoS qos);
+
+    /**
+     * Unsubscribe a topic. It is sent in the next process() call and sent
+     * again until the broker acknowledged it.
+     *
+     * @param[in] topic Topic filter
+     *
+     * @return If the unsubscription is requested, it will return true otherwise false.
+     */
+    bool unsubscribe(const String& topic);
+
+    /**
+     * Get number of messages, which were dropped, because the outbound queue was full.
+     *
+     * @return Number of dropped messages
+     */
+    uint32_t getDroppedCount() const
+    {
+        return m_droppedCnt;
+    }
+
+    /**
+     * Process the client: handle the TCP/IP stack notifications, received
+     * packets, keep alive, retransmissions and send the queued packets.
+     */
+    void process();
+
+private:
+
+    /** Default MQTT broker port. */
+    static const uint16_t   MQTT_PORT               = 1883U;
+
+    /** Keep alive interval in s. */
+    static const uint16_t   KEEP_ALIVE              = 60U;
+
+    /** Timeout in ms, after which a not acknowledged QoS 1 message is sent again. */
+    static const uint32_t   ACK_TIMEOUT             = 5000U;
+
+    /** Min. period in ms between connection attempts. */
+    static const uint32_t   RECONNECT_PERIOD_MIN    = 2000U;
+
+    /** Max. period in ms between connection attempts. */
+    static const uint32_t   RECONNECT_PERIOD_MAX    = 60000U;
+
+    /** Timeout in ms for the CONNACK. */
+    static const uint32_t   CONNACK_TIMEOUT         = 10000U;
+
+    /** Max. number of queued outbound messages. */
+    static const size_t     OUT_QUEUE_SIZE          = 16U;
+
+    /** Max. number of events which can be queued. */
+    static const size_t     EVT_QUEUE_SIZE          = 16U;
+
+    /** Max. size of a received packet in byte. Bigger packets close the connection. */
+    static const size_t     MAX_RX_PACKET_SIZE      = 2048U;
+
+    /**
+     * Connection states.
+     */
+    enum State
+    {
+        STATE_IDLE = 0,         /**< Not started. */
+        STATE_DISCONNECTED,     /**< Waiting for the next connection attempt. */
+        STATE_TCP_CONNECTING,   /**< TCP connection is established. */
+        STATE_MQTT_CONNECTING,  /**< CONNECT sent, waiting for CONNACK. */
+        STATE_CONNECTED         /**< Connected to the broker. */
+    };
+
+    /**
+     * Event ids used to identify the informations notified by the TCP/IP stack.
+     */
+    enum EventId
+    {
+        EVENT_ID_CONNECTED = 0, /**< Connection is established. */
+        EVENT_ID_DISCONNECTED,  /**< Connection is disconnected. */
+        EVENT_ID_ERROR,         /**< A error happened. */
+        EVENT_ID_DATA,          /**< Data is received. */
+        EVENT_ID_TIMEOUT        /**< A connection timeout happened. */
+    };
+
+    /**
+     * A event is a combination of notification and its corresponding data.
+     */
+    struct Event
+    {
+        EventId     id;     /**< Event id to identify the kind of notification. */
+
+        /**
+         * The union contains the event id specific parameters.
+         * Note not every event id must have parameters.
+         */
+        union
+        {
+            /**
+             * Data parameters, only valid for EVENT_ID_DATA.
+             */
+            struct
+            {
+                uint8_t*    data;   /**< Event specific data. */
+                size_t      size;   /**< Event specific data size in byte. */
+            } data;
+
+            int8_t      error;      /**< Error id, valid only for EVENT_ID_ERROR */
+            uint32_t    timeout;    /**< Timeout in ms, valid only for EVENT_ID_TIMEOUT */
+        } u;
+    };
+
+    /**
+     * Outbound message, which shall be published.
+     */
+    struct Message
+    {
+        String      topic;      /**< Topic name */
+        String      payload;    /**< Payload */
+        QoS         qos;        /**< Quality of service */
+        bool        retain;     /**< Retain flag */
+        uint16_t    packetId;   /**< Packet identifier, 0 if not used. */
+        bool        isSent;     /**< Is sent at least once? */
+        uint32_t    timestamp;  /**< Timestamp in ms of the last transmission. */
+
+        /**
+         * Initializes the message.
+         */
+        Message() :
+            topic(),
+            payload(),
+            qos(QOS_0),
+            retain(false),
+            packetId(0U),
+            isSent(false),
+            timestamp(0U)
+        {
+        }
+    };
+
+    /**
+     * Subscribe or unsubscribe request, which is not acknowledged yet.
+     */
+    struct SubRequest
+    {
+        String      topic;          /**< Topic filter */
+        QoS         qos;            /**< Max. quality of service, only for subscribe. */
+        bool        isUnsubscribe;  /**< Is it a unsubscribe request? */
+        uint16_t    packetId;       /**< Packet identifier */
+        bool        isSent;         /**< Is sent at least once? */
+        uint32_t    timestamp;      /**< Timestamp in ms of the last transmission. */
+
+        /**
+         * Initializes the request.
+         */
+        SubRequest() :
+            topic(),
+            qos(QOS_0),
+            isUnsubscribe(false),
+            packetId(0U),
+            isSent(false),
+            timestamp(0U)
+        {
+        }
+    };
+
+    AsyncClient             m_tcpClient;                /**< Asynchronous TCP client */
+    Queue<Event>            m_evtQueue;                 /**< Event queue, filled by the TCP/IP stack. */
+    mutable Mutex           m_mutex;                    /**< Protects the outbound queue and the subscription requests. */
+    volatile State          m_state;                    /**< Connection state */
+    OnConnected             m_onConnected;              /**< Callback on established connection. */
+    OnMessage               m_onMessage;                /**< Callback on received message. */
+    String                  m_hostname;                 /**< Broker hostname */
+    uint16_t                m_port;                     /**< Broker port */
+    String                  m_user;                     /**< User name, empty if not used. */
+    String                  m_password;                 /**< Password, empty if not used. */
+    String                  m_clientId;                 /**< Client identifier */
+    uint32_t                m_timestamp;                /**< Timestamp in ms of the last connection attempt. */
+    uint32_t                m_reconnectPeriod;          /**< Current period in ms between connection attempts. */
+    uint32_t                m_lastTxTimestamp;          /**< Timestamp in ms of the last sent packet. */
+    uint32_t                m_lastRxTimestamp;          /**< Timestamp in ms of the last received packet. */
+    bool                    m_isPingPending;            /**< Is a PINGRESP pending? */
+    uint16_t                m_packetId;                 /**< Last used packet identifier. */
+    Message                 m_outQueue[OUT_QUEUE_SIZE]; /**< Outbound queue */
+    size_t                  m_outQueueCnt;              /**< Number of messages in the outbound queue. */
+    uint32_t                m_droppedCnt;               /**< Number of dropped messages. */
+    std::vector<SubRequest> m_subRequests;              /**< Not acknowledged subscribe and unsubscribe requests. */
+    std::vector<uint8_t>    m_rxBuffer;                 /**< Receive buffer for incomplete packets. */
+    std::vector<uint8_t>    m_txBuffer;                 /**< Transmit buffer, used to batch several packets. Keeps the not sent part. */
+
+    MqttClient(const MqttClient& client);
+    MqttClient& operator=(const MqttClient& client);
+
+    /**
+     * Handle all events from the TCP/IP stack.
+     */
+    void processEvtQueue();
+
+    /**
+     * Clear the event queue and release its data.
+     */
+    void clearEvtQueue();
+
+    /**
+     * Handle the connection state, keep alive and the retransmissions.
+     */
+    void processConnection();
+
+    /**
+     * Handle received data, which may contain several or incomplete packets.
+     *
+     * @param[in] data  Received data
+     * @param[in] size  Data size in byte
+     */
+    void onData(const uint8_t* data, size_t size);
+
+    /**
+     * Handle a complete received packet.
+     *
+     * @param[in] header    Fixed header first byte
+     * @param[in] data      Variable header and payload
+     * @param[in] size      Size of variable header and payload in byte
+     *
+     * @return If the packet is valid, it will return true otherwise false.
+     */
+    bool handlePacket(uint8_t header, const uint8_t* data, size_t size);
+
+    /**
+     * Connection to broker is lost or closed. Prepare for reconnect.
+     */
+    void onDisconnect();
+
+    /**
+     * Send the CONNECT packet.
+     */
+    void sendConnect();
+
+    /**
+     * Serialize all subscription requests and queued messages, which are not
+     * sent yet or which need a retransmission, and send them together.
+     */
+    void sendOutQueue();
+
+    /**
+     * Append a packet to the transmit buffer, if it fits into the free TCP
+     * send buffer. A packet is always appended to a empty transmit buffer,
+     * it will be sent in parts.
+     *
+     * @param[in] size  Transmit buffer size in byte, before the packet was appended.
+     * @param[in] space Free TCP send buffer in byte
+     *
+     * @return If the packet is kept in the transmit buffer, it will return true otherwise false.
+     */
+    bool keepPacket(size_t size, size_t space);
+
+    /**
+     * Remove a acknowledged message from the outbound queue.
+     *
+     * @param[in] packetId  Packet identifier
+     */
+    void ackMessage(uint16_t packetId);
+
+    /**
+     * Add a subscribe or unsubscribe request. A older request for the same
+     * topic filter is replaced.
+     *
+     * @param[in] request   Request
+     */
+    void addSubRequest(const SubRequest& request);
+
+    /**
+     * Remove a acknowledged subscribe or unsubscribe request.
+     *
+     * @param[in] packetId  Packet identifier
+     */
+    void ackSubRequest(uint16_t packetId);
+
+    /**
+     * Add a message to the outbound queue.
+     *
+     * @param[in] msg   Message
+     *
+     * @return If successful queued, it will return true otherwise false.
+     */
+    bool enqueue(const Message& msg);
+
+    /**
+     * Get the next packet identifier. It is never 0.
+     *
+     * @return Packet identifier
+     */
+    uint16_t nextPacketId();
+
+    /**
+     * Send the transmit buffer, as much as fits into the free TCP send buffer.
+     * The rest is kept and sent by the next call.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool flush();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __MQTT_CLIENT_H__ */
+
+/** @} */
@@ -0,0 +1,239 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  MQTT service
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MqttService.h"
+#include "Settings.h"
+
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool MqttService::start(const String& hostname)
+{
+    bool    isSuccessful    = false;
+    String  url;
+
+    if (false == Settings::getInstance().open(true))
+    {
+        url = Settings::getInstance().getMqttBrokerUrl().getDefault();
+    }
+    else
+    {
+        url = Settings::getInstance().getMqttBrokerUrl().getValue();
+        Settings::getInstance().close();
+    }
+
+    if (true == url.isEmpty())
+    {
+        LOG_INFO("MQTT disabled.");
+    }
+    else
+    {
+        m_baseTopic = hostname;
+
+        m_client.regOnConnected(
+            [this]()
+            {
+                this->onConnected();
+            });
+
+        m_client.regOnMessage(
+            [this](const String& topic, const uint8_t* payload, size_t size)
+            {
+                this->onMessage(topic, payload, size);
+            });
+
+        isSuccessful = m_client.begin(url, hostname);
+    }
+
+    return isSuccessful;
+}
+
+void MqttService::stop()
+{
+    m_client.end();
+
+    return;
+}
+
+void MqttService::process()
+{
+    m_client.process();
+
+    return;
+}
+
+bool MqttService::publish(const String& topic, const String& payload, MqttClient::QoS qos, bool retain)
+{
+    return m_client.publish(m_baseTopic + topic, payload, qos, retain);
+}
+
+bool MqttService::subscribe(const String& topic, const TopicCallback& callback)
+{
+    MutexGuard<Mutex>   guard(m_mutex);
+    Subscription        subscription;
+
+    subscription.topic      = topic;
+    subscription.callback   = callback;
+
+    m_subscriptions.push_back(subscription);
+
+    /* If not connected, the topic will be subscribed after the connection is established. */
+    if (true == m_client.isConnected())
+    {
+        (void)m_client.subscribe(m_baseTopic + topic, MqttClient::QOS_1);
+    }
+
+    return true;
+}
+
+void MqttService::unsubscribe(const String& topic)
+{
+    MutexGuard<Mutex>                   guard(m_mutex);
+    std::vector<Subscription>::iterator it      = m_subscriptions.begin();
+    bool                                isFound = false;
+
+    while((false == isFound) && (m_subscriptions.end() != it))
+    {
+        if (topic == it->topic)
+        {
+            (void)m_subscriptions.erase(it);
+            isFound = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if ((true == isFound) &&
+        (true == m_client.isConnected()))
+    {
+        (void)m_client.unsubscribe(m_baseTopic + topic);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void MqttService::onConnected()
+{
+    MutexGuard<Mutex>   guard(m_mutex);
+    size_t              idx     = 0U;
+
+    /* The client uses a clean session, therefore all topics are subscribed again. */
+    for(idx = 0U; idx < m_subscriptions.size(); ++idx)
+    {
+        if (false == m_client.subscribe(m_baseTopic + m_subscriptions[idx].topic, MqttClient::QOS_1))
+        {
+            LOG_WARNING("Couldn't subscribe %s.", m_subscriptions[idx].topic.c_str());
+        }
+    }
+
+    return;
+}
+
+void MqttService::onMessage(const String& topic, const uint8_t* payload, size_t size)
+{
+    TopicCallback callback;
+
+    /* Call the subscriber without holding the mutex, because it may
+     * subscribe or unsubscribe topics.
+     */
+    if (true == topic.startsWith(m_baseTopic))
+    {
+        MutexGuard<Mutex>   guard(m_mutex);
+        String              relTopic    = topic.substring(m_baseTopic.length());
+        size_t              idx         = 0U;
+
+        while((idx < m_subscriptions.size()) && (nullptr == callback))
+        {
+            if (relTopic == m_subscriptions[idx].topic)
+            {
+                callback = m_subscriptions[idx].callback;
+            }
+
+            ++idx;
+        }
+    }
+
+    if (nullptr == callback)
+    {
+        LOG_WARNING("No subscriber for %s.", topic.c_str());
+    }
+    else
+    {
+        callback(topic, payload, size);
+    }
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,231 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  MQTT service
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __MQTT_SERVICE_H__
+#define __MQTT_SERVICE_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <functional>
+#include <vector>
+#include <WString.h>
+#include <Mutex.hpp>
+
+#include "MqttClient.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The MQTT service connects to the MQTT broker, which is configured in the
+ * settings, and dispatches the received messages to the subscribers.
+ * All topics are below the hostname as base topic.
+ */
+class MqttService
+{
+public:
+
+    /**
+     * Prototype of the callback, which is called for a received message.
+     */
+    typedef std::function<void(const String& topic, const uint8_t* payload, size_t size)> TopicCallback;
+
+    /**
+     * Get MQTT service instance.
+     *
+     * @return MQTT service instance
+     */
+    static MqttService& getInstance()
+    {
+        static MqttService instance; /* singleton idiom to force initialization in the first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Start the service. If no broker is configured, the service stays
+     * disabled.
+     *
+     * @param[in] hostname  Hostname, which is used as client id and base topic.
+     *
+     * @return If the service is started, it will return true otherwise false.
+     */
+    bool start(const String& hostname);
+
+    /**
+     * Stop the service.
+     */
+    void stop();
+
+    /**
+     * Process the service. Call it periodically.
+     */
+    void process();
+
+    /**
+     * Is the connection to the broker established?
+     *
+     * @return If connected, it will return true otherwise false.
+     */
+    bool isConnected() const
+    {
+        return m_client.isConnected();
+    }
+
+    /**
+     * Get the base topic, which is the hostname.
+     *
+     * @return Base topic
+     */
+    const String& getBaseTopic() const
+    {
+        return m_baseTopic;
+    }
+
+    /**
+     * Publish a message.
+     *
+     * @param[in] topic     Topic name, relative to the base topic.
+     * @param[in] payload   Message payload
+     * @param[in] qos       Quality of service
+     * @param[in] retain    Shall the broker retain the message?
+     *
+     * @return If the message is queued, it will return true otherwise false.
+     */
+    bool publish(const String& topic, const String& payload, MqttClient::QoS qos, bool retain);
+
+    /**
+     * Get the number of messages, which can be published until the
+     * outbound queue is full.
+     *
+     * @return Number of free entries in the outbound queue
+     */
+    size_t getFreeQueueSize() const
+    {
+        return m_client.getFreeQueueSize();
+    }
+
+    /**
+     * Subscribe a topic. The subscription is kept over reconnects and restarts
+     * of the service.
+     *
+     * @param[in] topic     Topic name, relative to the base topic.
+     * @param[in] callback  Callback, which is called for every received message.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool subscribe(const String& topic, const TopicCallback& callback);
+
+    /**
+     * Unsubscribe a topic.
+     *
+     * @param[in] topic Topic name, relative to the base topic.
+     */
+    void unsubscribe(const String& topic);
+
+private:
+
+    /**
+     * A subscription of a topic.
+     */
+    struct Subscription
+    {
+        String          topic;      /**< Topic name, relative to the base topic. */
+        TopicCallback   callback;   /**< Callback for received messages. */
+    };
+
+    MqttClient                  m_client;           /**< MQTT client */
+    mutable Mutex               m_mutex;            /**< Protects the subscriptions. */
+    String                      m_baseTopic;        /**< Base topic */
+    std::vector<Subscription>   m_subscriptions;    /**< Subscriptions */
+
+    /**
+     * Constructs the MQTT service.
+     */
+    MqttService() :
+        m_client(),
+        m_mutex(),
+        m_baseTopic(),
+        m_subscriptions()
+    {
+        (void)m_mutex.create();
+    }
+
+    /**
+     * Destroys the MQTT service.
+     */
+    ~MqttService()
+    {
+        /* Will never be called. */
+    }
+
+    /* An instance shall not be copied. */
+    MqttService(const MqttService& service);
+    MqttService& operator=(const MqttService& service);
+
+    /**
+     * Subscribe all topics after the connection is established.
+     */
+    void onConnected();
+
+    /**
+     * Dispatch a received message to its subscriber.
+     *
+     * @param[in] topic     Topic name
+     * @param[in] payload   Message payload
+     * @param[in] size      Payload size in byte
+     */
+    void onMessage(const String& topic, const uint8_t* payload, size_t size);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __MQTT_SERVICE_H__ */
+
+/** @} */
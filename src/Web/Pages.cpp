@@ -42,6 +42,8 @@
 #include "RestApi.h"
 #include "PluginMgr.h"
 #include "FileSystem.h"
+#include "RestUtil.h"
+#include "GzipInflater.h"
 
 #include <WiFi.h>
 #include <Esp.h>
@@ -78,7 +80,11 @@ struct TmplKeyWordFunc
 
 static String fitToSpiffs(const String& path, const String& filenNameWithoutExt, const String& fileNameExtension);
 
-static String tmplPageProcessor(const String& var);
+static String getGzipETag(File& fd);
+static String getWeakETag(File& fd);
+static bool sendStaticFile(AsyncWebServerRequest* request, const String& path);
+static void staticFilePage(AsyncWebServerRequest* request);
+static void tmplValues(AsyncWebServerRequest* request);
 
 static void aboutPage(AsyncWebServerRequest* request);
 static void debugPage(AsyncWebServerRequest* request);
@@ -118,11 +124,36 @@ static const String     PLUGIN_PAGE_FILE_EXTENSION      = ".html";
 /** SPIFFS limits the max. filename length, which includes the path as well. */
 static const uint32_t   SPIFFS_FILENAME_LENGTH_LIMIT    = 32U;
 
+/** File extension of gzip compressed files. */
+static const char*      GZIP_FILE_EXTENSION             = ".gz";
+
+/** Size of the gzip trailer in bytes, which contains the CRC32 and the size of the uncompressed content. */
+static const size_t     GZIP_TRAILER_SIZE               = 8U;
+
+/**
+ * Name of the request parameter, which contains the content hash of the file.
+ * It is added by the build to every asset reference in the web pages.
+ */
+static const char*      VERSION_PARAM                   = "v";
+
+/** Cache control for files, which are requested with a content hash. Their content never changes. */
+static const char*      CACHE_CONTROL_IMMUTABLE         = "public, max-age=31536000, immutable";
+
+/** Cache control for files, which the client shall revalidate on every use by ETag. */
+static const char*      CACHE_CONTROL_REVALIDATE        = "no-cache";
+
 /** Flag used to signal any kind of file upload error. */
 static bool             gIsUploadError                  = false;
 
+/** Size of the uploaded file in byte, as announced by the client. */
+static uint32_t         gUploadSize                     = UPDATE_SIZE_UNKNOWN;
+
+/** Inflater for gzip compressed firmware and filesystem images. */
+static GzipInflater     gInflater;
+
 /**
- * List of all used template keywords and the function how to retrieve the information.
+ * List of all values, which the web pages retrieve via /tmpl.json and the
+ * function how to retrieve the information.
  * The list is alphabetic sorted in ascending order.
  */
 static TmplKeyWordFunc  gTmplKeyWordToFunc[]            =
@@ -212,6 +243,9 @@ void Pages::init(AsyncWebServer& srv)
     (void)srv.on("/upload.html", HTTP_POST, uploadPage, uploadHandler)
         .setAuthentication(webLoginUser.c_str(), webLoginPassword.c_str());
 
+    (void)srv.on("/tmpl.json", HTTP_GET, tmplValues)
+        .setAuthentication(webLoginUser.c_str(), webLoginPassword.c_str());
+
     (void)srv.on("/", [](AsyncWebServerRequest* request) {
         if (nullptr != request)
         {
@@ -224,15 +258,16 @@ void Pages::init(AsyncWebServer& srv)
         .setAuthentication(webLoginUser.c_str(), webLoginPassword.c_str());
 
     /* Serve files with static content with enabled cache control.
-     * The client may cache files from filesystem for 1 hour.
+     * Precompressed files are preferred and every file gets an ETag.
+     * See sendStaticFile() for the cache control.
      */
-    (void)srv.serveStatic("/favicon.png", FILESYSTEM, "/favicon.png", "max-age=3600")
+    (void)srv.on("/favicon.png", HTTP_GET, staticFilePage)
         .setAuthentication(webLoginUser.c_str(), webLoginPassword.c_str());
-    (void)srv.serveStatic("/images/", FILESYSTEM, "/images/", "max-age=3600")
+    (void)srv.on("/images/*", HTTP_GET, staticFilePage)
         .setAuthentication(webLoginUser.c_str(), webLoginPassword.c_str());
-    (void)srv.serveStatic("/js/", FILESYSTEM, "/js/", "max-age=3600")
+    (void)srv.on("/js/*", HTTP_GET, staticFilePage)
         .setAuthentication(webLoginUser.c_str(), webLoginPassword.c_str());
-    (void)srv.serveStatic("/style/", FILESYSTEM, "/style/", "max-age=3600")
+    (void)srv.on("/style/*", HTTP_GET, staticFilePage)
         .setAuthentication(webLoginUser.c_str(), webLoginPassword.c_str());
 
     /* Add one page per plugin. */
@@ -250,7 +285,10 @@ void Pages::init(AsyncWebServer& srv)
                                 return;
                             }
 
-                            request->send(FILESYSTEM, uri, "text/html", false, tmplPageProcessor);
+                            if (false == sendStaticFile(request, uri))
+                            {
+                                Pages::error(request);
+                            }
 
                         }).setAuthentication(webLoginUser.c_str(), webLoginPassword.c_str());;
 
@@ -274,7 +312,10 @@ void Pages::error(AsyncWebServerRequest* request)
 
     LOG_INFO("Invalid web request: %s", request->url().c_str());
 
-    request->send(FILESYSTEM, "/error.html", "text/html", false, tmplPageProcessor);
+    if (false == sendStaticFile(request, "/error.html"))
+    {
+        request->send(HttpStatus::STATUS_CODE_NOT_FOUND, "text/plain", "Not found.");
+    }
 
     return;
 }
@@ -301,34 +342,193 @@ static String fitToSpiffs(const String& path, const String& filenNameWithoutExt,
 }
 
 /**
- * Processor for page template, containing the common part, which is available
- * in every page. It is responsible for the data binding.
+ * Get the ETag of a gzip compressed file. It is derived from the gzip trailer,
+ * which contains the CRC32 and the size of the uncompressed content. Therefore
+ * it changes only if the content changes, without reading the whole file.
+ *
+ * @param[in] fd    File descriptor of the gzip compressed file
+ *
+ * @return ETag or a empty string, if the file is no valid gzip file.
+ */
+static String getGzipETag(File& fd)
+{
+    String  eTag;
+    size_t  fileSize    = fd.size();
+    uint8_t trailer[GZIP_TRAILER_SIZE];
+
+    if ((sizeof(trailer) <= fileSize) &&
+        (true == fd.seek(fileSize - sizeof(trailer))) &&
+        (sizeof(trailer) == fd.read(trailer, sizeof(trailer))))
+    {
+        char        buffer[19U]; /* Quotes, 2 x 8 hex digits and string termination. */
+        uint32_t    crc32   = static_cast<uint32_t>(trailer[0U]) |
+                              (static_cast<uint32_t>(trailer[1U]) << 8U) |
+                              (static_cast<uint32_t>(trailer[2U]) << 16U) |
+                              (static_cast<uint32_t>(trailer[3U]) << 24U);
+        uint32_t    size    = static_cast<uint32_t>(trailer[4U]) |
+                              (static_cast<uint32_t>(trailer[5U]) << 8U) |
+                              (static_cast<uint32_t>(trailer[6U]) << 16U) |
+                              (static_cast<uint32_t>(trailer[7U]) << 24U);
+
+        (void)snprintf(buffer, sizeof(buffer), "\"%08X%08X\"", crc32, size);
+        eTag = buffer;
+    }
+
+    /* Rewind, because the file will be sent afterwards. */
+    (void)fd.seek(0U);
+
+    return eTag;
+}
+
+/**
+ * Get a weak ETag of a uncompressed file. It is derived from the file size
+ * and the time of the last write access.
+ *
+ * @param[in] fd    File descriptor
+ *
+ * @return ETag
+ */
+static String getWeakETag(File& fd)
+{
+    char buffer[24U]; /* W/, quotes, 2 x 8 hex digits, separator and string termination. */
+
+    (void)snprintf(buffer, sizeof(buffer), "W/\"%X-%X\"", static_cast<uint32_t>(fd.size()), static_cast<uint32_t>(fd.getLastWrite()));
+
+    return String(buffer);
+}
+
+/**
+ * Send a file with static content from the filesystem. If a gzip
+ * compressed variant (<path>.gz) is available, it will be preferred.
+ *
+ * Every file gets an ETag. If the client already has the file, only
+ * "304 Not Modified" will be sent.
+ *
+ * The build adds the content hash as version parameter to every asset
+ * reference in the web pages. Such a request may be cached by the client
+ * forever, because a changed content results in a different URL. All other
+ * requests must be revalidated by the client on every use.
  *
- * @param[in] var   Name of variable in the template
+ * @param[in] request   HTTP request
+ * @param[in] path      Path of the file in the filesystem, without the .gz extension.
+ *
+ * @return If the file was found, it will return true otherwise false.
  */
-static String tmplPageProcessor(const String& var)
+static bool sendStaticFile(AsyncWebServerRequest* request, const String& path)
 {
-    String  result;
-    uint8_t index   = 0U;
     bool    isFound = false;
+    File    fd      = FILESYSTEM.open(path + GZIP_FILE_EXTENSION, "r");
+    String  eTag;
 
-    while ((index < UTIL_ARRAY_NUM(gTmplKeyWordToFunc)) && (false == isFound))
+    if (false == fd)
+    {
+        fd = FILESYSTEM.open(path, "r");
+
+        if ((true == fd) &&
+            (false == fd.isDirectory()))
+        {
+            eTag = getWeakETag(fd);
+        }
+    }
+    else
     {
-        if (var == gTmplKeyWordToFunc[index].keyword)
+        eTag = getGzipETag(fd);
+    }
+
+    if (true == eTag.isEmpty())
+    {
+        if (true == fd)
+        {
+            fd.close();
+        }
+    }
+    else
+    {
+        AsyncWebServerResponse* response        = nullptr;
+        const char*             cacheControl    = CACHE_CONTROL_REVALIDATE;
+
+        if (true == request->hasParam(VERSION_PARAM))
+        {
+            cacheControl = CACHE_CONTROL_IMMUTABLE;
+        }
+
+        /* Has the client already the current file? */
+        if ((true == request->hasHeader("If-None-Match")) &&
+            (eTag == request->header("If-None-Match")))
+        {
+            fd.close();
+            response = request->beginResponse(HttpStatus::STATUS_CODE_NOT_MODIFIED);
+        }
+        else
+        {
+            /* The response takes the ownership of the file. The content type is
+             * derived from the path and the response adds the content encoding
+             * in case of a gzip compressed file.
+             */
+            response = request->beginResponse(fd, path);
+        }
+
+        if (nullptr != response)
         {
-            result  = gTmplKeyWordToFunc[index].func();
-            isFound = true;
+            response->addHeader("ETag", eTag);
+            response->addHeader("Cache-Control", cacheControl);
+            request->send(response);
         }
 
-        ++index;
+        isFound = true;
     }
 
-    if (false == isFound)
+    return isFound;
+}
+
+/**
+ * Static file page, which serves the requested file from the filesystem.
+ *
+ * @param[in] request   HTTP request
+ */
+static void staticFilePage(AsyncWebServerRequest* request)
+{
+    if (nullptr == request)
     {
-        result = var;
+        return;
     }
 
-    return result;
+    if (false == sendStaticFile(request, request->url()))
+    {
+        Pages::error(request);
+    }
+
+    return;
+}
+
+/**
+ * Provides the dynamic values, which the web pages show. This keeps the
+ * web pages static and therefore cacheable.
+ *
+ * @param[in] request   HTTP request
+ */
+static void tmplValues(AsyncWebServerRequest* request)
+{
+    const size_t        JSON_DOC_SIZE   = 3072U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    JsonVariant         dataObj;
+    uint8_t             index           = 0U;
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    dataObj = RestUtil::prepareRspSuccess(jsonDoc);
+
+    for(index = 0U; index < UTIL_ARRAY_NUM(gTmplKeyWordToFunc); ++index)
+    {
+        dataObj[gTmplKeyWordToFunc[index].keyword] = gTmplKeyWordToFunc[index].func();
+    }
+
+    RestUtil::sendJsonRsp(request, jsonDoc, HttpStatus::STATUS_CODE_OK);
+
+    return;
 }
 
 /**
@@ -343,7 +543,10 @@ static void aboutPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/about.html", "text/html", false, tmplPageProcessor);
+    if (false == sendStaticFile(request, "/about.html"))
+    {
+        Pages::error(request);
+    }
 
     return;
 }
@@ -360,7 +563,10 @@ static void debugPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/debug.html", "text/html", false, tmplPageProcessor);
+    if (false == sendStaticFile(request, "/debug.html"))
+    {
+        Pages::error(request);
+    }
 
     return;
 }
@@ -377,7 +583,10 @@ static void displayPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/display.html", "text/html", false, tmplPageProcessor);
+    if (false == sendStaticFile(request, "/display.html"))
+    {
+        Pages::error(request);
+    }
 
     return;
 }
@@ -394,7 +603,10 @@ static void editPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/edit.html", "text/html", false, tmplPageProcessor);
+    if (false == sendStaticFile(request, "/edit.html"))
+    {
+        Pages::error(request);
+    }
 
     return;
 }
@@ -411,7 +623,10 @@ static void indexPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/index.html", "text/html", false, tmplPageProcessor);
+    if (false == sendStaticFile(request, "/index.html"))
+    {
+        Pages::error(request);
+    }
 
     return;
 }
@@ -428,7 +643,10 @@ static void infoPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/info.html", "text/html", false, tmplPageProcessor);
+    if (false == sendStaticFile(request, "/info.html"))
+    {
+        Pages::error(request);
+    }
 
     return;
 }
@@ -445,7 +663,10 @@ static void settingsPage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/settings.html", "text/html", false, tmplPageProcessor);
+    if (false == sendStaticFile(request, "/settings.html"))
+    {
+        Pages::error(request);
+    }
 
     return;
 }
@@ -462,7 +683,10 @@ static void updatePage(AsyncWebServerRequest* request)
         return;
     }
 
-    request->send(FILESYSTEM, "/update.html", "text/html", false, tmplPageProcessor);
+    if (false == sendStaticFile(request, "/update.html"))
+    {
+        Pages::error(request);
+    }
 
     return;
 }
@@ -517,17 +741,26 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
     /* Begin of upload? */
     if (0 == index)
     {
-        uint32_t fileSize = UPDATE_SIZE_UNKNOWN;
+        uint32_t    fileSize        = UPDATE_SIZE_UNKNOWN;
+        bool        isCompressed    = GzipInflater::isGzip(data, len);
+        String      imageName       = filename;
 
         /* If there is a pending upload, abort it. */
         if (true == Update.isRunning())
         {
             Update.abort();
+            (void)gInflater.end();
             LOG_WARNING("Pending upload aborted.");
         }
 
+        /* A compressed image is uploaded with the additional gzip file extension. */
+        if (true == imageName.endsWith(GZIP_FILE_EXTENSION))
+        {
+            imageName.remove(imageName.length() - strlen(GZIP_FILE_EXTENSION));
+        }
+
         /* Upload firmware or filesystem? */
-        int cmd = (filename == FILESYSTEM_FILENAME) ? U_SPIFFS : U_FLASH;
+        int cmd = (imageName == FILESYSTEM_FILENAME) ? U_SPIFFS : U_FLASH;
 
         if (U_FLASH == cmd)
         {
@@ -561,7 +794,16 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
             LOG_INFO("Upload of %s (%u byte) starts.", filename.c_str(), fileSize);
         }
 
-        gIsUploadError = false;
+        gIsUploadError  = false;
+        gUploadSize     = fileSize;
+
+        /* The size of the decompressed image is unknown until its end. The
+         * announced file size is only used for the upload progress.
+         */
+        if (true == isCompressed)
+        {
+            fileSize = UPDATE_SIZE_UNKNOWN;
+        }
 
         /* Update filesystem? */
         if (U_SPIFFS == cmd)
@@ -585,6 +827,28 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
             /* Inform client about abort.*/
             request->send(HttpStatus::STATUS_CODE_PAYLOAD_TOO_LARGE, "text/plain", "Upload aborted.");
         }
+        /* The compressed image is decompressed on the fly into the update partition. */
+        else if ((true == isCompressed) &&
+                 (false == gInflater.begin(
+                    [](const uint8_t* image, size_t imageSize) -> bool
+                    {
+                        return (imageSize == Update.write(const_cast<uint8_t*>(image), imageSize));
+                    })))
+        {
+            LOG_ERROR("Upload failed: No memory for decompression.");
+            gIsUploadError = true;
+
+            Update.abort();
+
+            /* Mount filesystem again, it may be unmounted in case of filesystem update.*/
+            if (false == FILESYSTEM.begin())
+            {
+                LOG_FATAL("Couldn't mount filesystem.");
+            }
+
+            /* Inform client about abort.*/
+            request->send(HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR, "text/plain", "Upload aborted.");
+        }
         /* Update is now running. */
         else
         {
@@ -600,20 +864,56 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
     {
         if (false == gIsUploadError)
         {
-            if(len != Update.write(data, len))
+            if (true == gInflater.isRunning())
+            {
+                if (false == gInflater.write(data, len))
+                {
+                    LOG_ERROR("Upload failed: %s", (UPDATE_ERROR_OK != Update.getError()) ? Update.errorString() : "Invalid compressed image.");
+                    gIsUploadError = true;
+                }
+            }
+            else if(len != Update.write(data, len))
             {
                 LOG_ERROR("Upload failed: %s", Update.errorString());
                 gIsUploadError = true;
             }
-            else
+
+            if (false == gIsUploadError)
             {
-                uint32_t progress = (Update.progress() * 100) / Update.size();
+                uint32_t received   = index + len;
+                uint32_t progress   = 0U;
+
+                /* Progress is based on the received data, because the size
+                 * of a decompressed image is not known in advance.
+                 */
+                if ((UPDATE_SIZE_UNKNOWN != gUploadSize) &&
+                    (0U < gUploadSize))
+                {
+                    progress = (received * 100U) / gUploadSize;
+                }
+                else
+                {
+                    progress = (Update.progress() * 100U) / Update.size();
+                }
 
+                UpdateMgr::getInstance().updateStatistics(received, Update.progress());
                 UpdateMgr::getInstance().updateProgress(progress);
             }
 
             /* Upload finished? */
-            if (true == final)
+            if ((true == final) &&
+                (true == gInflater.isRunning()))
+            {
+                if (false == gInflater.end())
+                {
+                    LOG_ERROR("Upload failed: Incomplete compressed image.");
+                    gIsUploadError = true;
+                }
+            }
+
+            /* Upload finished? */
+            if ((true == final) &&
+                (false == gIsUploadError))
             {
                 /* Finish update now. */
                 if (false == Update.end(true))
@@ -646,6 +946,7 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
 
             /* Abort update */
             Update.abort();
+            (void)gInflater.end();
             UpdateMgr::getInstance().endProgress();
 
             /* Inform client about abort.*/
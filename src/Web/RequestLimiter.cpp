@@ -0,0 +1,190 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Request rate limiter with coalescing
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "RequestLimiter.h"
+
+#include <Arduino.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Statistics of all limiters. */
+RequestLimiter::TotalStatistics RequestLimiter::m_totalStatistics;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool RequestLimiter::init()
+{
+    bool isSuccessful = true;
+
+    if (false == m_mutex.isAllocated())
+    {
+        isSuccessful = m_mutex.create();
+    }
+
+    /* The first request shall not be coalesced. */
+    m_timestamp = millis() - m_window;
+    m_isPending = false;
+    m_pending.clear();
+
+    return isSuccessful;
+}
+
+bool RequestLimiter::take()
+{
+    MutexGuard<Mutex>   guard(m_mutex);
+    bool                isAccepted  = m_tokenBucket.take();
+
+    if (false == isAccepted)
+    {
+        countRejected();
+    }
+    else
+    {
+        countApplied();
+    }
+
+    return isAccepted;
+}
+
+RequestLimiter::Result RequestLimiter::limit(const String& value)
+{
+    MutexGuard<Mutex>   guard(m_mutex);
+    Result              result      = RESULT_APPLY;
+    uint32_t            timestamp   = millis();
+
+    if (false == m_tokenBucket.take(timestamp))
+    {
+        countRejected();
+
+        result = RESULT_REJECTED;
+    }
+    /* Within the coalescing window, the request replaces a pending one. */
+    else if ((0U < m_window) &&
+             (m_window > (timestamp - m_timestamp)))
+    {
+        if (true == m_isPending)
+        {
+            countCoalesced();
+        }
+
+        m_pending   = value;
+        m_isPending = true;
+
+        result = RESULT_COALESCED;
+    }
+    else
+    {
+        /* A pending request is older, therefore it is replaced. */
+        if (true == m_isPending)
+        {
+            countCoalesced();
+
+            m_pending.clear();
+            m_isPending = false;
+        }
+
+        countApplied();
+
+        m_timestamp = timestamp;
+        result      = RESULT_APPLY;
+    }
+
+    return result;
+}
+
+bool RequestLimiter::getPending(String& value)
+{
+    MutexGuard<Mutex>   guard(m_mutex);
+    bool                isPending   = false;
+    uint32_t            timestamp   = millis();
+
+    if ((true == m_isPending) &&
+        (m_window <= (timestamp - m_timestamp)))
+    {
+        countApplied();
+
+        value       = m_pending;
+        m_timestamp = timestamp;
+        m_isPending = false;
+        m_pending.clear();
+
+        isPending = true;
+    }
+
+    return isPending;
+}
+
+RequestLimiter::Statistics RequestLimiter::getStatistics() const
+{
+    MutexGuard<Mutex> guard(m_mutex);
+
+    return m_statistics;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
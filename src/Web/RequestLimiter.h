@@ -0,0 +1,240 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Request rate limiter with coalescing
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __REQUEST_LIMITER_H__
+#define __REQUEST_LIMITER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <WString.h>
+#include <Mutex.hpp>
+#include <TokenBucket.hpp>
+#include <atomic>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Limits the requests of a single endpoint.
+ *
+ * A token bucket limits the request rate, further requests are rejected.
+ * Additionally requests, which change a state, can be coalesced: After a
+ * request was applied, the following requests within a short window are
+ * not applied. Only the latest one is kept as pending request and applied
+ * after the window elapsed. So the final state of a burst is applied and
+ * persisted, but not every intermediate one.
+ */
+class RequestLimiter
+{
+public:
+
+    /**
+     * Result of a request check.
+     */
+    enum Result
+    {
+        RESULT_APPLY = 0,   /**< Apply the request now. */
+        RESULT_COALESCED,   /**< Request is kept as pending request, it will be applied later. */
+        RESULT_REJECTED     /**< Request rejected, because of too many requests. */
+    };
+
+    /**
+     * Request statistics
+     */
+    struct Statistics
+    {
+        uint32_t    applied;    /**< Number of applied requests */
+        uint32_t    coalesced;  /**< Number of requests, which were replaced by a later one */
+        uint32_t    rejected;   /**< Number of rejected requests */
+    };
+
+    /**
+     * Constructs the request limiter.
+     *
+     * @param[in] burst         Max. number of requests in a burst
+     * @param[in] refillPeriod  Period in ms, after which one more request is allowed
+     * @param[in] window        Coalescing window in ms, 0 to disable coalescing
+     */
+    RequestLimiter(uint32_t burst, uint32_t refillPeriod, uint32_t window) :
+        m_mutex(),
+        m_tokenBucket(burst, refillPeriod),
+        m_window(window),
+        m_timestamp(0U),
+        m_isPending(false),
+        m_pending(),
+        m_statistics()
+    {
+    }
+
+    /**
+     * Destroys the request limiter.
+     */
+    ~RequestLimiter()
+    {
+    }
+
+    /**
+     * Initialize the request limiter.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool init();
+
+    /**
+     * Limit the request rate only, without coalescing.
+     *
+     * @return If the request is accepted, it will return true otherwise false.
+     */
+    bool take();
+
+    /**
+     * Limit a request, which changes a state.
+     *
+     * @param[in] value Request value, which is kept if the request is coalesced.
+     *
+     * @return Result, which tells the caller how to handle the request.
+     */
+    Result limit(const String& value);
+
+    /**
+     * Get the pending request value, if the coalescing window elapsed.
+     * The pending request is counted as applied.
+     *
+     * @param[out] value    Request value
+     *
+     * @return If a pending request shall be applied now, it will return true otherwise false.
+     */
+    bool getPending(String& value);
+
+    /**
+     * Get the statistics of this limiter.
+     *
+     * @return Statistics
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * Get the statistics of all limiters.
+     *
+     * @return Statistics
+     */
+    static Statistics getTotalStatistics()
+    {
+        Statistics statistics;
+
+        statistics.applied      = m_totalStatistics.applied.load(std::memory_order_relaxed);
+        statistics.coalesced    = m_totalStatistics.coalesced.load(std::memory_order_relaxed);
+        statistics.rejected     = m_totalStatistics.rejected.load(std::memory_order_relaxed);
+
+        return statistics;
+    }
+
+private:
+
+    /**
+     * Statistics of all limiters. The limiters are used by different tasks
+     * and every limiter has its own mutex, therefore the counters are atomic.
+     */
+    struct TotalStatistics
+    {
+        std::atomic<uint32_t>   applied;    /**< Number of applied requests */
+        std::atomic<uint32_t>   coalesced;  /**< Number of requests, which were replaced by a later one */
+        std::atomic<uint32_t>   rejected;   /**< Number of rejected requests */
+    };
+
+    mutable Mutex       m_mutex;        /**< Protects the pending request and the statistics. */
+    TokenBucket         m_tokenBucket;  /**< Limits the request rate. */
+    uint32_t            m_window;       /**< Coalescing window in ms. */
+    uint32_t            m_timestamp;    /**< Timestamp in ms of the last applied request. */
+    bool                m_isPending;    /**< Is a request pending? */
+    String              m_pending;      /**< Value of the pending request. */
+    Statistics          m_statistics;   /**< Statistics of this limiter. */
+
+    /** Statistics of all limiters. */
+    static TotalStatistics  m_totalStatistics;
+
+    RequestLimiter(const RequestLimiter& limiter);
+    RequestLimiter& operator=(const RequestLimiter& limiter);
+
+    /**
+     * Count an applied request.
+     */
+    void countApplied()
+    {
+        ++m_statistics.applied;
+        (void)m_totalStatistics.applied.fetch_add(1U, std::memory_order_relaxed);
+        return;
+    }
+
+    /**
+     * Count a request, which was replaced by a later one.
+     */
+    void countCoalesced()
+    {
+        ++m_statistics.coalesced;
+        (void)m_totalStatistics.coalesced.fetch_add(1U, std::memory_order_relaxed);
+        return;
+    }
+
+    /**
+     * Count a rejected request.
+     */
+    void countRejected()
+    {
+        ++m_statistics.rejected;
+        (void)m_totalStatistics.rejected.fetch_add(1U, std::memory_order_relaxed);
+        return;
+    }
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __REQUEST_LIMITER_H__ */
+
+/** @} */
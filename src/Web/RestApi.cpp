@@ -42,6 +42,16 @@
 #include "FileSystem.h"
 #include "RestUtil.h"
 #include "SlotList.h"
+#include "PluginConfigStore.h"
+#include "MemMon.h"
+#include "MemTag.h"
+#include "TaskMon.h"
+#include "BootProfiler.h"
+#include "ChromeTrace.h"
+#include "FileListing.h"
+#include "DisplaySnapshot.h"
+#include "UploadWriter.h"
+#include "RequestLimiter.h"
 
 #include <Util.h>
 #include <WiFi.h>
@@ -49,6 +59,7 @@
 #include <Esp.h>
 #include <Logging.h>
 #include <SensorDataProvider.h>
+#include <memory>
 
 /******************************************************************************
  * Compiler Switches
@@ -70,15 +81,22 @@ static void handleButton(AsyncWebServerRequest* request);
 static void handleFadeEffect(AsyncWebServerRequest* request);
 static void handleSlots(AsyncWebServerRequest* request);
 static void handleSlot(AsyncWebServerRequest* request);
+static void handleSnapshot(AsyncWebServerRequest* request);
 static void handlePluginInstall(AsyncWebServerRequest* request);
 static void handlePluginUninstall(AsyncWebServerRequest* request);
 static void handlePlugins(AsyncWebServerRequest* request);
+static void handlePluginConfig(AsyncWebServerRequest* request);
 static void handleSensors(AsyncWebServerRequest* request);
 static void handleSettings(AsyncWebServerRequest* request);
 static void handleSetting(AsyncWebServerRequest* request);
 static bool storeSetting(KeyValue* parameter, const String& value, String& error);
 static void handleStatus(AsyncWebServerRequest* request);
-static void getFiles(File& dir, JsonArray& files, uint32_t& preCount, uint32_t& count, bool isRecursive);
+static void handleMemory(AsyncWebServerRequest* request);
+static void handleBoot(AsyncWebServerRequest* request);
+static void handleTasks(AsyncWebServerRequest* request);
+#if (0 != CONFIG_TRACE_RECORDER_ENABLE)
+static void handleTrace(AsyncWebServerRequest* request);
+#endif  /* (0 != CONFIG_TRACE_RECORDER_ENABLE) */
 static void handleFilesystem(AsyncWebServerRequest* request);
 static void handleFileGet(AsyncWebServerRequest* request);
 static String getContentType(const String& filename);
@@ -91,6 +109,24 @@ static bool isValidHostname(const String& hostname);
  * Local Variables
  *****************************************************************************/
 
+/** Upload writer, used for file uploads via REST API. */
+static UploadWriter gUploadWriter;
+
+/** Max. number of requests in a burst to a display control endpoint. */
+static const uint32_t   REQ_LIMIT_BURST         = 4U;
+
+/** Period in ms, after which one more request to a display control endpoint is allowed. */
+static const uint32_t   REQ_LIMIT_REFILL_PERIOD = 250U;
+
+/** Window in ms, in which slot activations are coalesced. */
+static const uint32_t   REQ_LIMIT_WINDOW        = 500U;
+
+/** Request limiter of the virtual button endpoint. Every request is a button press, therefore no coalescing. */
+static RequestLimiter   gButtonLimiter(REQ_LIMIT_BURST, REQ_LIMIT_REFILL_PERIOD, 0U);
+
+/** Request limiter of the slot endpoint. The latest slot activation wins. */
+static RequestLimiter   gSlotLimiter(REQ_LIMIT_BURST, REQ_LIMIT_REFILL_PERIOD, REQ_LIMIT_WINDOW);
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -109,17 +145,31 @@ static bool isValidHostname(const String& hostname);
 
 void RestApi::init(AsyncWebServer& srv)
 {
+    if ((false == gButtonLimiter.init()) ||
+        (false == gSlotLimiter.init()))
+    {
+        LOG_WARNING("Request limiter not available.");
+    }
+
     (void)srv.on("/rest/api/v1/button", handleButton);
     (void)srv.on("/rest/api/v1/display/fadeEffect", handleFadeEffect);
     (void)srv.on("/rest/api/v1/display/slots", handleSlots);
     (void)srv.on("/rest/api/v1/display/slot/*", handleSlot);
+    (void)srv.on("/rest/api/v1/display/snapshot", handleSnapshot);
     (void)srv.on("/rest/api/v1/plugin/install", handlePluginInstall);
     (void)srv.on("/rest/api/v1/plugin/uninstall", handlePluginUninstall);
     (void)srv.on("/rest/api/v1/plugins", handlePlugins);
+    (void)srv.on("/rest/api/v1/plugin/config", handlePluginConfig);
     (void)srv.on("/rest/api/v1/sensors", handleSensors);
     (void)srv.on("/rest/api/v1/settings", handleSettings);
     (void)srv.on("/rest/api/v1/setting", handleSetting);
     (void)srv.on("/rest/api/v1/status", handleStatus);
+    (void)srv.on("/rest/api/v1/memory", handleMemory);
+    (void)srv.on("/rest/api/v1/boot", handleBoot);
+    (void)srv.on("/rest/api/v1/tasks", handleTasks);
+#if (0 != CONFIG_TRACE_RECORDER_ENABLE)
+    (void)srv.on("/rest/api/v1/trace", handleTrace);
+#endif  /* (0 != CONFIG_TRACE_RECORDER_ENABLE) */
     (void)srv.on("/rest/api/v1/fs/file", HTTP_GET, handleFileGet);
     (void)srv.on("/rest/api/v1/fs/file", HTTP_POST, handleFilePost, uploadHandler);
     (void)srv.on("/rest/api/v1/fs/file", HTTP_DELETE, handleFileDelete);
@@ -128,6 +178,24 @@ void RestApi::init(AsyncWebServer& srv)
     return;
 }
 
+void RestApi::process()
+{
+    String  value;
+    uint8_t slotId  = SlotList::SLOT_ID_INVALID;
+
+    /* Apply the last coalesced slot activation. */
+    if (true == gSlotLimiter.getPending(value))
+    {
+        if ((false == Util::strToUInt8(value, slotId)) ||
+            (false == DisplayMgr::getInstance().activateSlot(slotId)))
+        {
+            LOG_WARNING("Activation of slot %s rejected.", value.c_str());
+        }
+    }
+
+    return;
+}
+
 /**
  * Handle invalid rest path request.
  *
@@ -177,6 +245,11 @@ static void handleButton(AsyncWebServerRequest* request)
         RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
         httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
     }
+    else if (false == gButtonLimiter.take())
+    {
+        RestUtil::prepareRspError(jsonDoc, "Too many requests.");
+        httpStatusCode = HttpStatus::STATUS_CODE_TOO_MANY_REQUESTS;
+    }
     else
     {
         DisplayMgr::getInstance().activateNextSlot();
@@ -352,7 +425,22 @@ static void handleSlot(AsyncWebServerRequest* request)
             /* Only activate a slot? */
             else if (false == request->hasArg("sticky"))
             {
-                if (false == DisplayMgr::getInstance().activateSlot(slotId))
+                RequestLimiter::Result result = gSlotLimiter.limit(String(slotId));
+
+                if (RequestLimiter::RESULT_REJECTED == result)
+                {
+                    RestUtil::prepareRspError(jsonDoc, "Too many requests.");
+                    httpStatusCode = HttpStatus::STATUS_CODE_TOO_MANY_REQUESTS;
+                }
+                /* The activation is done after the coalescing window, if no later one replaces it. */
+                else if (RequestLimiter::RESULT_COALESCED == result)
+                {
+                    JsonVariant dataObj = RestUtil::prepareRspSuccess(jsonDoc);
+
+                    dataObj["coalesced"]    = true;
+                    httpStatusCode          = HttpStatus::STATUS_CODE_OK;
+                }
+                else if (false == DisplayMgr::getInstance().activateSlot(slotId))
                 {
                     RestUtil::prepareRspError(jsonDoc, "Request rejected.");
                     httpStatusCode = HttpStatus::STATUS_CODE_METHOD_NOT_ALLOWED;
@@ -365,6 +453,11 @@ static void handleSlot(AsyncWebServerRequest* request)
                     httpStatusCode      = HttpStatus::STATUS_CODE_OK;
                 }
             }
+            else if (false == gSlotLimiter.take())
+            {
+                RestUtil::prepareRspError(jsonDoc, "Too many requests.");
+                httpStatusCode = HttpStatus::STATUS_CODE_TOO_MANY_REQUESTS;
+            }
             /* Consider sticky flag. */
             else
             {
@@ -426,6 +519,105 @@ static void handleSlot(AsyncWebServerRequest* request)
     return;
 }
 
+/**
+ * Get a snapshot of the display content as image (?format=png|bmp&scale=<factor>).
+ * The image is encoded piecewise into the response. Default is PNG without upscaling.
+ * GET \c "/api/v1/display/snapshot"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleSnapshot(AsyncWebServerRequest* request)
+{
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET != request->method())
+    {
+        const size_t        JSON_DOC_SIZE   = 512U;
+        DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+        RestUtil::sendJsonRsp(request, jsonDoc, HttpStatus::STATUS_CODE_NOT_FOUND);
+    }
+    else
+    {
+        std::shared_ptr<DisplaySnapshot>    snapshot(new(std::nothrow) DisplaySnapshot());
+        DisplaySnapshot::Format             format          = DisplaySnapshot::FORMAT_PNG;
+        uint8_t                             scale           = 1U;
+        const char*                         errorMsg        = nullptr;
+        uint32_t                            httpStatusCode  = HttpStatus::STATUS_CODE_BAD_REQUEST;
+
+        if (true == request->hasArg("format"))
+        {
+            const String& formatStr = request->arg("format");
+
+            if (true == formatStr.equalsIgnoreCase("bmp"))
+            {
+                format = DisplaySnapshot::FORMAT_BMP;
+            }
+            else if (false == formatStr.equalsIgnoreCase("png"))
+            {
+                errorMsg = "Unsupported format.";
+            }
+            else
+            {
+                ;
+            }
+        }
+
+        if (nullptr != errorMsg)
+        {
+            ;
+        }
+        else if ((true == request->hasArg("scale")) &&
+                 ((false == Util::strToUInt8(request->arg("scale"), scale)) ||
+                  (0U == scale) ||
+                  (DisplaySnapshot::MAX_SCALE < scale)))
+        {
+            errorMsg = "Invalid scale.";
+        }
+        else if ((nullptr == snapshot) ||
+                 (false == snapshot->snapshot(format, scale)))
+        {
+            errorMsg        = "Out of memory.";
+            httpStatusCode  = HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR;
+        }
+        else
+        {
+            ;
+        }
+
+        if (nullptr != errorMsg)
+        {
+            const size_t        JSON_DOC_SIZE   = 512U;
+            DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+            RestUtil::prepareRspError(jsonDoc, errorMsg);
+            RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+        }
+        else
+        {
+            /* The image size is known in advance, but the image itself is generated piecewise. */
+            AsyncWebServerResponse* response = request->beginResponse(snapshot->getContentType(), snapshot->getSize(),
+                [snapshot](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+                    UTIL_NOT_USED(index);
+                    return snapshot->fill(buffer, maxLen);
+                });
+
+            if (nullptr != response)
+            {
+                response->addHeader("Cache-Control", "no-store");
+            }
+
+            request->send(response);
+        }
+    }
+
+    return;
+}
+
 /**
  * Install plugin
  * POST \c "/api/v1/plugin/install?name=<plugin-name>"
@@ -620,6 +812,61 @@ static void handlePlugins(AsyncWebServerRequest* request)
     return;
 }
 
+/**
+ * Export the configuration of a plugin instance in JSON format.
+ * The response is the plain configuration, same as in a plugin JSON configuration
+ * file. This allows to restore it by writing it to the configuration directory.
+ * GET \c "/api/v1/plugin/config"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handlePluginConfig(AsyncWebServerRequest* request)
+{
+    const size_t        JSON_DOC_SIZE   = 4096U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET != request->method())
+    {
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else if (false == request->hasArg("uid"))
+    {
+        RestUtil::prepareRspError(jsonDoc, "UID is missing.");
+        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else
+    {
+        uint16_t uid = 0U;
+
+        if (false == Util::strToUInt16(request->arg("uid"), uid))
+        {
+            RestUtil::prepareRspError(jsonDoc, "Invalid UID.");
+            httpStatusCode = HttpStatus::STATUS_CODE_BAD_REQUEST;
+        }
+        else if (false == PluginConfigStore::getInstance().load(uid, jsonDoc))
+        {
+            jsonDoc.clear();
+            RestUtil::prepareRspError(jsonDoc, "Configuration not found.");
+            httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+        }
+        else
+        {
+            httpStatusCode = HttpStatus::STATUS_CODE_OK;
+        }
+    }
+
+    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+
+    return;
+}
+
 /**
  * List all sensors.
  * GET \c "/api/v1/sensors"
@@ -1159,7 +1406,7 @@ static bool storeSetting(KeyValue* parameter, const String& value, String& error
 static void handleStatus(AsyncWebServerRequest* request)
 {
     uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
-    const size_t        JSON_DOC_SIZE   = 512U;
+    const size_t        JSON_DOC_SIZE   = 768U;
     DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
     if (nullptr == request)
@@ -1181,6 +1428,8 @@ static void handleStatus(AsyncWebServerRequest* request)
         JsonObject  swObj           = dataObj.createNestedObject("software");
         JsonObject  internalRamObj  = swObj.createNestedObject("internalRam");
         JsonObject  wifiObj         = dataObj.createNestedObject("wifi");
+        JsonObject  requestsObj     = dataObj.createNestedObject("requests");
+        RequestLimiter::Statistics  reqStatistics   = RequestLimiter::getTotalStatistics();
 
         /* Only in station mode it makes sense to retrieve the RSSI.
          * Otherwise keep it -100 dbm.
@@ -1211,6 +1460,10 @@ static void handleStatus(AsyncWebServerRequest* request)
         wifiObj["rssi"]         = rssi;                             // dBm
         wifiObj["quality"]      = WiFiUtil::getSignalQuality(rssi); // percent
 
+        requestsObj["applied"]      = reqStatistics.applied;
+        requestsObj["coalesced"]    = reqStatistics.coalesced;
+        requestsObj["rejected"]     = reqStatistics.rejected;
+
         httpStatusCode          = HttpStatus::STATUS_CODE_OK;
     }
 
@@ -1220,91 +1473,332 @@ static void handleStatus(AsyncWebServerRequest* request)
 }
 
 /**
- * Get the files in the directory (optional: recursively) and fill the JSON array flat.
- * It will start to collect the files/directories after "preCount" were found.
- * It will stop to collect after "count" files.
- * 
- * @param[in]       dir         The directory to start with.
- * @param[out]      files       JSON array for collecting the files.
- * @param[in,out]   preCount    This amount of files will be skipped.
- * @param[in,out]   count       Amount of files which max. to collect.
- * @param[in]       isRecursive If true, it will get all files recursive from root to all leafs.
+ * Get heap memory information, like the memory usage per tag and the
+ * fragmentation history.
+ * GET \c "/api/v1/memory"
+ *
+ * @param[in] request   HTTP request
  */
-static void getFiles(File& dir, JsonArray& files, uint32_t& preCount, uint32_t& count, bool isRecursive)
+static void handleMemory(AsyncWebServerRequest* request)
 {
-    File fd = dir.openNextFile();
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = 2048U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
-    while((true == fd) && (0U < count))
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET != request->method())
     {
-        /* Skip the first number of files. */
-        if (0U < preCount)
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else
+    {
+        uint8_t     fragHistory[MemMon::FRAGMENTATION_HISTORY_SIZE];
+        size_t      fragHistoryCnt  = MemMon::getInstance().getFragmentationHistory(fragHistory, UTIL_ARRAY_NUM(fragHistory));
+        JsonVariant dataObj         = RestUtil::prepareRspSuccess(jsonDoc);
+        JsonObject  heapObj         = dataObj.createNestedObject("heap");
+        JsonArray   tagsArray       = dataObj.createNestedArray("tags");
+        JsonArray   fragArray       = dataObj.createNestedArray("fragmentation");
+        uint8_t     id              = 0U;
+        size_t      idx             = 0U;
+
+        heapObj["size"]             = ESP.getHeapSize();
+        heapObj["available"]        = ESP.getFreeHeap();
+        heapObj["minAvailable"]     = ESP.getMinFreeHeap();
+        heapObj["largestBlock"]     = ESP.getMaxAllocHeap();
+        heapObj["untracked"]        = MemTag::getUntrackedCount();
+
+        for(id = 0U; id < MemTag::ID_COUNT; ++id)
+        {
+            MemTag::Statistics  statistics;
+            JsonObject          tagObj      = tagsArray.createNestedObject();
+
+            MemTag::getStatistics(static_cast<MemTag::Id>(id), statistics);
+
+            tagObj["name"]          = MemTag::idToStr(static_cast<MemTag::Id>(id));
+            tagObj["liveBytes"]     = statistics.liveBytes;
+            tagObj["peakBytes"]     = statistics.peakBytes;
+            tagObj["allocCount"]    = statistics.allocCount;
+            tagObj["freeCount"]     = statistics.freeCount;
+        }
+
+        /* Oldest sample first, one sample per memory monitor cycle. */
+        for(idx = 0U; idx < fragHistoryCnt; ++idx)
         {
-            /* One file/directory skipped. */
-            --preCount;
+            (void)fragArray.add(fragHistory[idx]);
+        }
+
+        httpStatusCode = HttpStatus::STATUS_CODE_OK;
+    }
+
+    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+
+    return;
+}
 
-            /* Dive into every directory recursively. */
-            if ((true == isRecursive) &&
-                (true == fd.isDirectory()))
+/**
+ * Get the boot phases, recorded by the boot profiler.
+ * All timestamps and durations are in us since power-on.
+ * GET \c "/api/v1/boot"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleBoot(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = 4096U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET != request->method())
+    {
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else
+    {
+        BootProfiler&   bootProfiler    = BootProfiler::getInstance();
+        JsonVariant     dataObj         = RestUtil::prepareRspSuccess(jsonDoc);
+        JsonArray       phasesArray;
+        uint8_t         phaseCnt        = bootProfiler.getPhaseCount();
+        uint8_t         idx             = 0U;
+
+        dataObj["finished"] = bootProfiler.isFinished();
+        dataObj["duration"] = bootProfiler.getBootDuration();
+        phasesArray         = dataObj.createNestedArray("phases");
+
+        for(idx = 0U; idx < phaseCnt; ++idx)
+        {
+            BootProfiler::Phase phase;
+
+            if (true == bootProfiler.getPhase(idx, phase))
             {
-                getFiles(fd, files, preCount, count, isRecursive);
+                JsonObject phaseObj = phasesArray.createNestedObject();
+
+                phaseObj["name"]        = phase.name;
+                phaseObj["start"]       = phase.start;
+                phaseObj["duration"]    = phase.duration;
+                phaseObj["core"]        = phase.core;
+                phaseObj["running"]     = phase.isRunning;
             }
         }
-        else
-        {
-            JsonObject jsonFile = files.createNestedObject();
 
-            /* One file/directory collected. */
-            --count;
+        httpStatusCode = HttpStatus::STATUS_CODE_OK;
+    }
+
+    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+
+    return;
+}
+
+/**
+ * Get the task run time statistics, sampled by the task monitor.
+ * Every task in a sample is reported as array: [task number, run time, priority, core, stack headroom].
+ * To follow the statistics continuously, request with the "since" argument set to the
+ * "nextSeqNum" of the previous response.
+ * GET \c "/api/v1/tasks"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleTasks(AsyncWebServerRequest* request)
+{
+    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
+    const size_t        JSON_DOC_SIZE   = 12288U;
+    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET != request->method())
+    {
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+    }
+    else
+    {
+        TaskMon&            taskMon             = TaskMon::getInstance();
+        const uint8_t       MAX_SAMPLES         = 4U;   /* Limited by the JSON document size. */
+        uint8_t             sampleCnt           = 0U;
+        uint32_t            since               = 0U;
+        bool                isSinceAvailable    = false;
+        TaskMon::Sample*    samples             = new(std::nothrow) TaskMon::Sample[MAX_SAMPLES];
 
-            jsonFile["name"] = String(fd.path());
-            jsonFile["size"] = fd.size();
+        if (true == request->hasArg("since"))
+        {
+            isSinceAvailable = Util::strToUInt32(request->arg("since"), since);
+        }
 
-            if (true == fd.isDirectory())
+        if ((true == request->hasArg("since")) &&
+            (false == isSinceAvailable))
+        {
+            RestUtil::prepareRspError(jsonDoc, "Invalid sequence number.");
+            httpStatusCode = HttpStatus::STATUS_CODE_BAD_REQUEST;
+        }
+        else if (nullptr == samples)
+        {
+            RestUtil::prepareRspError(jsonDoc, "Out of memory.");
+            httpStatusCode = HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR;
+        }
+        else
+        {
+            JsonVariant dataObj         = RestUtil::prepareRspSuccess(jsonDoc);
+            JsonArray   tasksArray      = dataObj.createNestedArray("tasks");
+            JsonArray   samplesArray    = dataObj.createNestedArray("samples");
+            uint32_t    nextSeqNum      = since;
+            uint8_t     idx             = 0U;
+            uint8_t     taskIdx         = 0U;
+
+            dataObj["samplingCycle"] = TaskMon::SAMPLING_CYCLE;
+
+            /* Without sequence number, the latest samples are reported.
+             * The samples are copied at once, so they are consistent.
+             */
+            if (false == isSinceAvailable)
             {
-                jsonFile["type"] = "dir";
+                sampleCnt = taskMon.getLatestSamples(samples, MAX_SAMPLES);
+            }
+            else
+            {
+                sampleCnt = taskMon.getSamplesSince(since, samples, MAX_SAMPLES);
+            }
+
+            for(idx = 0U; idx < sampleCnt; ++idx)
+            {
+                const TaskMon::Sample&  sample              = samples[idx];
+                JsonObject              sampleObj           = samplesArray.createNestedObject();
+                JsonArray               sampleTasksArray    = sampleObj.createNestedArray("tasks");
+
+                sampleObj["seqNum"]         = sample.seqNum;
+                sampleObj["timestamp"]      = sample.timestamp;
+                sampleObj["totalRunTime"]   = sample.totalRunTime;
 
-                if (true == isRecursive)
+                for(taskIdx = 0U; taskIdx < sample.taskCount; ++taskIdx)
                 {
-                    /* Dive into every directory recursively. */
-                    getFiles(fd, files, preCount, count, isRecursive);
+                    const TaskMon::TaskInfo&    taskInfo    = sample.tasks[taskIdx];
+                    JsonArray                   taskArray   = sampleTasksArray.createNestedArray();
+
+                    (void)taskArray.add(taskInfo.taskNumber);
+                    (void)taskArray.add(taskInfo.runTime);
+                    (void)taskArray.add(taskInfo.priority);
+                    (void)taskArray.add(taskInfo.core);
+                    (void)taskArray.add(taskInfo.stackHeadroom);
                 }
+
+                nextSeqNum = sample.seqNum + 1U;
             }
-            else
+
+            /* The names are only known for the tasks of the latest sample. */
+            if (0U < sampleCnt)
             {
-                jsonFile["type"] = "file";
+                const TaskMon::Sample& sample = samples[sampleCnt - 1U];
+
+                for(taskIdx = 0U; taskIdx < sample.taskCount; ++taskIdx)
+                {
+                    String taskName;
+
+                    if (true == taskMon.getTaskName(sample.tasks[taskIdx].taskNumber, taskName))
+                    {
+                        JsonObject taskObj = tasksArray.createNestedObject();
+
+                        taskObj["number"]   = sample.tasks[taskIdx].taskNumber;
+                        taskObj["name"]     = taskName;
+                    }
+                }
             }
-        }
 
-        fd.close();
+            dataObj["nextSeqNum"] = nextSeqNum;
 
-        /* Still possible to collect more? */
-        if (0U < count)
-        {
-            fd = dir.openNextFile();
+            httpStatusCode = HttpStatus::STATUS_CODE_OK;
         }
+
+        delete[] samples;
     }
-    
-    /* Cleanup */
-    if (true == fd)
+
+    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+
+    return;
+}
+
+#if (0 != CONFIG_TRACE_RECORDER_ENABLE)
+
+/**
+ * Get the recorded trace events in the Chrome trace event format.
+ * The response is not wrapped, so it can be loaded directly in e.g. Perfetto.
+ * GET \c "/api/v1/trace"
+ *
+ * @param[in] request   HTTP request
+ */
+static void handleTrace(AsyncWebServerRequest* request)
+{
+    if (nullptr == request)
+    {
+        return;
+    }
+
+    if (HTTP_GET != request->method())
     {
-        fd.close();
+        const size_t        JSON_DOC_SIZE   = 512U;
+        DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+        RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
+        RestUtil::sendJsonRsp(request, jsonDoc, HttpStatus::STATUS_CODE_NOT_FOUND);
     }
+    else
+    {
+        std::shared_ptr<ChromeTrace> chromeTrace(new(std::nothrow) ChromeTrace());
+
+        if ((nullptr == chromeTrace) ||
+            (false == chromeTrace->snapshot()))
+        {
+            const size_t        JSON_DOC_SIZE   = 512U;
+            DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+
+            RestUtil::prepareRspError(jsonDoc, "Out of memory.");
+            RestUtil::sendJsonRsp(request, jsonDoc, HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR);
+        }
+        else
+        {
+            /* The trace is generated piecewise and released together with the response. */
+            AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+                [chromeTrace](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+                    UTIL_NOT_USED(index);
+                    return chromeTrace->fill(buffer, maxLen);
+                });
+
+            request->send(response);
+        }
+    }
+
+    return;
 }
 
+#endif  /* (0 != CONFIG_TRACE_RECORDER_ENABLE) */
+
 /**
  * List files of given directory (?dir=<path>).
- * 
+ * The listing is streamed, therefore the number of entries is not limited by the available heap.
+ *
+ * Optional parameters:
+ * - count=<n>: Max. number of entries. If more entries are left, the response contains a cursor.
+ * - cursor=<cursor>: Continue a previous listing, instead of using the "dir" parameter.
+ * - page=<n>: Deprecated, lists 15 entries after skipping the previous pages.
+ *
  * GET \c "/api/v1/fs"
  *
  * @param[in] request   HTTP request
  */
 static void handleFilesystem(AsyncWebServerRequest* request)
 {
-    String              content;
-    uint32_t            httpStatusCode  = HttpStatus::STATUS_CODE_OK;
-    const size_t        JSON_DOC_SIZE   = 2048U;
-    DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
-
     if (nullptr == request)
     {
         return;
@@ -1312,54 +1806,86 @@ static void handleFilesystem(AsyncWebServerRequest* request)
 
     if (HTTP_GET != request->method())
     {
+        const size_t        JSON_DOC_SIZE   = 512U;
+        DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
+
         RestUtil::prepareRspErrorHttpMethodNotSupported(jsonDoc);
-        httpStatusCode = HttpStatus::STATUS_CODE_NOT_FOUND;
+        RestUtil::sendJsonRsp(request, jsonDoc, HttpStatus::STATUS_CODE_NOT_FOUND);
     }
     else
     {
-        const String&   path                = request->arg("dir");
-        const String&   pageStr             = request->arg("page");
-        File            fdRoot              = FILESYSTEM.open(path, "r");
-        JsonArray       jsonData            = jsonDoc.createNestedArray("data");
-        const uint32_t  DEFAULT_MAX_FILES   = 15U;
-        uint32_t        count               = DEFAULT_MAX_FILES;
-        uint32_t        page                = 0U;
-        uint32_t        preCount            = page * count;
+        std::shared_ptr<FileListing>    fileListing(new(std::nothrow) FileListing());
+        const uint32_t                  PAGE_SIZE       = 15U;
+        uint32_t                        maxCount        = FileListing::NO_LIMIT;
+        uint32_t                        page            = 0U;
+        const char*                     errorMsg        = nullptr;
+        uint32_t                        httpStatusCode  = HttpStatus::STATUS_CODE_BAD_REQUEST;
 
-        if (false == pageStr.isEmpty())
+        if (nullptr == fileListing)
         {
-            if (true == Util::strToUInt32(pageStr, page))
-            {
-                preCount = page * count;
-            }
+            errorMsg        = "Out of memory.";
+            httpStatusCode  = HttpStatus::STATUS_CODE_INTERNAL_SERVER_ERROR;
         }
-
-        if (false == fdRoot)
+        else if ((true == request->hasArg("count")) &&
+                 (false == Util::strToUInt32(request->arg("count"), maxCount)))
         {
-            LOG_WARNING("Invalid path.");
+            errorMsg = "Invalid count.";
         }
-        else
+        else if (true == request->hasArg("cursor"))
+        {
+            if (false == fileListing->resume(request->arg("cursor"), maxCount))
+            {
+                errorMsg = "Invalid or expired cursor.";
+            }
+        }
+        else if (true == request->hasArg("page"))
         {
-            if (false == fdRoot.isDirectory())
+            /* A page is requested by its number, therefore no cursor is provided. */
+            if (false == Util::strToUInt32(request->arg("page"), page))
+            {
+                errorMsg = "Invalid page.";
+            }
+            else if (false == fileListing->begin(FILESYSTEM, request->arg("dir"), page * PAGE_SIZE, PAGE_SIZE, false))
             {
-                LOG_WARNING("Requested path is not a directory.");
+                LOG_WARNING("Invalid directory %s.", request->arg("dir").c_str());
             }
             else
             {
-                LOG_INFO("List %s (page = %u)", path.c_str(), page);
-                getFiles(fdRoot, jsonData, preCount, count, false);
+                LOG_INFO("List %s (page = %u)", request->arg("dir").c_str(), page);
             }
-
-            fdRoot.close();
+        }
+        else if (false == fileListing->begin(FILESYSTEM, request->arg("dir"), 0U, maxCount, true))
+        {
+            /* A not available directory results in a empty listing. */
+            LOG_WARNING("Invalid directory %s.", request->arg("dir").c_str());
+        }
+        else
+        {
+            LOG_INFO("List %s", request->arg("dir").c_str());
         }
 
-        /* Prepare response */
-        jsonDoc["status"]   = "ok";
+        if (nullptr != errorMsg)
+        {
+            const size_t        JSON_DOC_SIZE   = 512U;
+            DynamicJsonDocument jsonDoc(JSON_DOC_SIZE);
 
-        httpStatusCode      = HttpStatus::STATUS_CODE_OK;
-    }
+            LOG_WARNING("File listing failed: %s", errorMsg);
 
-    RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+            RestUtil::prepareRspError(jsonDoc, errorMsg);
+            RestUtil::sendJsonRsp(request, jsonDoc, httpStatusCode);
+        }
+        else
+        {
+            /* The listing is generated piecewise and released together with the response. */
+            AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+                [fileListing](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+                    UTIL_NOT_USED(index);
+                    return fileListing->fill(buffer, maxLen);
+                });
+
+            request->send(response);
+        }
+    }
 
     return;
 }
@@ -1506,7 +2032,16 @@ static void handleFilePost(AsyncWebServerRequest* request)
     }
     else
     {
-        (void)RestUtil::prepareRspSuccess(jsonDoc);
+        JsonVariant                         jsonData    = RestUtil::prepareRspSuccess(jsonDoc);
+        const UploadWriter::Statistics&     statistics  = gUploadWriter.getStatistics();
+
+        /* Upload statistics, e.g. to observe the flash write performance. */
+        jsonData["size"]                = statistics.size;
+        jsonData["duration"]            = statistics.duration;
+        jsonData["throughput"]          = statistics.throughput;
+        jsonData["maxWriteDuration"]    = statistics.maxWriteDuration;
+        jsonData["maxFramePeriod"]      = statistics.maxFramePeriod;
+
         httpStatusCode = HttpStatus::STATUS_CODE_OK;
     }
 
@@ -1527,15 +2062,12 @@ static void handleFilePost(AsyncWebServerRequest* request)
  */
 static void uploadHandler(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final)
 {
-    static File fd;
-    bool        isError = false;
+    bool isError = false;
 
     /* Begin of upload? */
     if (0 == index)
     {
-        fd = FILESYSTEM.open(filename, "w");
-
-        if (false == fd)
+        if (false == gUploadWriter.open(FILESYSTEM, filename))
         {
             isError = true;
         }
@@ -1545,23 +2077,33 @@ static void uploadHandler(AsyncWebServerRequest *request, const String& filename
         }
     }
 
-    if (true == fd)
+    /* The data is coalesced into larger blocks, which are written to flash asynchronously. */
+    if ((true == gUploadWriter.isOpen()) &&
+        (false == gUploadWriter.write(data, len)))
     {
-        (void)fd.write(data, len);
+        isError = true;
     }
 
+    /* Upload finished? Note, after an error the writer is already closed. */
     if ((true == final) &&
-        (false == isError))
-    {        
-        LOG_INFO("File %s successful written.", filename.c_str());
-
-        fd.close();
+        (false == isError) &&
+        (true == gUploadWriter.isOpen()))
+    {
+        if (false == gUploadWriter.close())
+        {
+            isError = true;
+        }
+        else
+        {
+            LOG_INFO("File %s successful written.", filename.c_str());
+        }
     }
-    else if (true == isError)
+
+    if (true == isError)
     {
         LOG_INFO("File %s upload aborted.", filename.c_str());
 
-        fd.close();
+        (void)gUploadWriter.close();
     }
 
     if (true == isError)
@@ -74,6 +74,12 @@ static const char BASE_URI[] = "/rest/api/v1";
  */
 void init(AsyncWebServer& srv);
 
+/**
+ * Process the REST interface. It applies coalesced requests, after their
+ * coalescing window elapsed. Call it periodically.
+ */
+void process(void);
+
 /**
  * Handle invalid rest path request.
  * 
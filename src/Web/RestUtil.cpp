@@ -33,6 +33,7 @@
  * Includes
  *****************************************************************************/
 #include "RestUtil.h"
+#include "MemTag.h"
 
 #include <Logging.h>
 
@@ -121,6 +122,8 @@ void RestUtil::prepareRspErrorHttpMethodNotSupported(JsonDocument& jsonDoc)
  */
 void RestUtil::sendJsonRsp(AsyncWebServerRequest* request, const JsonDocument& jsonDoc, uint32_t httpStatusCode)
 {
+    MemTagGuard memTagGuard(MemTag::ID_WEB_SERVER);
+
     if (true == jsonDoc.overflowed())
     {
         LOG_ERROR("JSON document has less memory available.");
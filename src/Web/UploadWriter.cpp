@@ -0,0 +1,386 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Coalescing upload writer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "UploadWriter.h"
+#include "DisplayMgr.h"
+
+#include <string.h>
+#include <new>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+UploadWriter::UploadWriter() :
+    m_fd(),
+    m_blocks(nullptr),
+    m_freeQueue(nullptr),
+    m_jobQueue(nullptr),
+    m_taskSemaphore(nullptr),
+    m_blockIdx(BLOCK_IDX_INVALID),
+    m_blockLen(0U),
+    m_isError(false),
+    m_timestamp(0U),
+    m_statistics()
+{
+}
+
+UploadWriter::~UploadWriter()
+{
+    (void)close();
+}
+
+bool UploadWriter::open(FS& fs, const String& path)
+{
+    bool isSuccessful = false;
+
+    /* A previous upload may be aborted without closing the writer. */
+    if (true == isOpen())
+    {
+        (void)close();
+    }
+
+    m_blocks        = new(std::nothrow) uint8_t[BLOCK_SIZE * BLOCK_COUNT];
+    m_freeQueue     = xQueueCreate(BLOCK_COUNT, sizeof(uint8_t));
+    m_jobQueue      = xQueueCreate(BLOCK_COUNT + 1U, sizeof(Job)); /* One more for the exit request. */
+    m_taskSemaphore = xSemaphoreCreateBinary();
+
+    if ((nullptr == m_blocks) ||
+        (nullptr == m_freeQueue) ||
+        (nullptr == m_jobQueue) ||
+        (nullptr == m_taskSemaphore))
+    {
+        LOG_ERROR("Not enough heap for upload writer.");
+    }
+    else
+    {
+        m_fd = fs.open(path, "w");
+
+        if (false == m_fd)
+        {
+            LOG_ERROR("Couldn't create file: %s", path.c_str());
+        }
+        else
+        {
+            BaseType_t  osRet   = pdFAIL;
+            uint8_t     idx     = 0U;
+
+            for(idx = 0U; idx < BLOCK_COUNT; ++idx)
+            {
+                (void)xQueueSend(m_freeQueue, &idx, 0U);
+            }
+
+            m_blockIdx  = BLOCK_IDX_INVALID;
+            m_blockLen  = 0U;
+            m_isError   = false;
+            m_timestamp = millis();
+            memset(&m_statistics, 0, sizeof(m_statistics));
+
+            DisplayMgr::getInstance().resetMaxFramePeriod();
+
+            /* The writer task gives the semaphore, after it is finished. */
+            osRet = xTaskCreateUniversal(   writerTask,
+                                            "uploadWriter",
+                                            TASK_STACK_SIZE,
+                                            this,
+                                            TASK_PRIORITY,
+                                            nullptr,
+                                            TASK_RUN_CORE);
+
+            if (pdPASS != osRet)
+            {
+                LOG_ERROR("Couldn't create upload writer task.");
+                m_fd.close();
+            }
+            else
+            {
+                isSuccessful = true;
+            }
+        }
+    }
+
+    if (false == isSuccessful)
+    {
+        release();
+    }
+
+    return isSuccessful;
+}
+
+bool UploadWriter::write(const uint8_t* data, size_t len)
+{
+    size_t idx = 0U;
+
+    if ((false == isOpen()) ||
+        (nullptr == data))
+    {
+        return false;
+    }
+
+    while((false == m_isError) && (len > idx))
+    {
+        /* Get a free block, if necessary. This blocks until the writer task released one. */
+        if (BLOCK_IDX_INVALID == m_blockIdx)
+        {
+            if (pdTRUE != xQueueReceive(m_freeQueue, &m_blockIdx, pdMS_TO_TICKS(BLOCK_WAIT_TIMEOUT)))
+            {
+                LOG_ERROR("Upload writer is stuck.");
+                m_blockIdx  = BLOCK_IDX_INVALID;
+                m_isError   = true;
+            }
+            else
+            {
+                m_blockLen = 0U;
+            }
+        }
+        else
+        {
+            size_t partLen = BLOCK_SIZE - m_blockLen;
+
+            if ((len - idx) < partLen)
+            {
+                partLen = len - idx;
+            }
+
+            memcpy(&m_blocks[(m_blockIdx * BLOCK_SIZE) + m_blockLen], &data[idx], partLen);
+            m_blockLen  += partLen;
+            idx         += partLen;
+
+            if (BLOCK_SIZE <= m_blockLen)
+            {
+                (void)submitBlock();
+            }
+        }
+    }
+
+    return (false == m_isError);
+}
+
+bool UploadWriter::close()
+{
+    bool isSuccessful = false;
+
+    if (true == isOpen())
+    {
+        const Job   EXIT_JOB    = { BLOCK_IDX_INVALID, 0U };
+        uint32_t    duration    = 0U;
+
+        /* Write the last, not completely filled block. */
+        if ((BLOCK_IDX_INVALID != m_blockIdx) &&
+            (0U < m_blockLen))
+        {
+            (void)submitBlock();
+        }
+
+        /* The exit request is queued after all pending blocks, which are written before. */
+        (void)xQueueSend(m_jobQueue, &EXIT_JOB, portMAX_DELAY);
+        (void)xSemaphoreTake(m_taskSemaphore, portMAX_DELAY);
+
+        m_fd.close();
+
+        duration = millis() - m_timestamp;
+
+        m_statistics.duration       = duration;
+        m_statistics.throughput     = (0U == duration) ? m_statistics.size : static_cast<uint32_t>((static_cast<uint64_t>(m_statistics.size) * 1000U) / duration);
+        m_statistics.maxFramePeriod = DisplayMgr::getInstance().getMaxFramePeriod();
+
+        LOG_INFO("Upload: %u byte in %u ms (%u byte/s), max. block write %u ms, max. frame period %u ms.",
+            m_statistics.size,
+            m_statistics.duration,
+            m_statistics.throughput,
+            m_statistics.maxWriteDuration,
+            m_statistics.maxFramePeriod);
+
+        isSuccessful = (false == m_isError);
+
+        release();
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool UploadWriter::submitBlock()
+{
+    Job job = { m_blockIdx, m_blockLen };
+
+    /* There are never more blocks than the queue can hold, therefore it will never block. */
+    if (pdTRUE != xQueueSend(m_jobQueue, &job, pdMS_TO_TICKS(BLOCK_WAIT_TIMEOUT)))
+    {
+        m_isError = true;
+    }
+
+    m_blockIdx = BLOCK_IDX_INVALID;
+    m_blockLen = 0U;
+
+    return (false == m_isError);
+}
+
+void UploadWriter::release()
+{
+    if (true == m_fd)
+    {
+        m_fd.close();
+    }
+
+    if (nullptr != m_blocks)
+    {
+        delete[] m_blocks;
+        m_blocks = nullptr;
+    }
+
+    if (nullptr != m_freeQueue)
+    {
+        vQueueDelete(m_freeQueue);
+        m_freeQueue = nullptr;
+    }
+
+    if (nullptr != m_jobQueue)
+    {
+        vQueueDelete(m_jobQueue);
+        m_jobQueue = nullptr;
+    }
+
+    if (nullptr != m_taskSemaphore)
+    {
+        vSemaphoreDelete(m_taskSemaphore);
+        m_taskSemaphore = nullptr;
+    }
+
+    m_blockIdx = BLOCK_IDX_INVALID;
+    m_blockLen = 0U;
+
+    return;
+}
+
+void UploadWriter::writerTask(void* parameters)
+{
+    UploadWriter* tthis = reinterpret_cast<UploadWriter*>(parameters);
+
+    if (nullptr != tthis)
+    {
+        bool isExit = false;
+
+        while(false == isExit)
+        {
+            Job job = { BLOCK_IDX_INVALID, 0U };
+
+            if (pdTRUE == xQueueReceive(tthis->m_jobQueue, &job, portMAX_DELAY))
+            {
+                if (0U == job.len)
+                {
+                    isExit = true;
+                }
+                else
+                {
+                    /* After a write error, the remaining blocks are just released. */
+                    if (false == tthis->m_isError)
+                    {
+                        uint32_t timestamp  = 0U;
+                        uint32_t duration   = 0U;
+
+                        /* Place the flash write cycle right after the display refresh.
+                         * If the display is not updated, it is written after the timeout.
+                         */
+                        (void)DisplayMgr::getInstance().waitForFrameDone(FRAME_WAIT_TIMEOUT);
+
+                        timestamp = millis();
+
+                        if (job.len != tthis->m_fd.write(&tthis->m_blocks[job.blockIdx * BLOCK_SIZE], job.len))
+                        {
+                            LOG_ERROR("Less data written, upload aborted.");
+                            tthis->m_isError = true;
+                        }
+                        else
+                        {
+                            tthis->m_statistics.size += job.len;
+                            ++tthis->m_statistics.blockCount;
+                        }
+
+                        duration = millis() - timestamp;
+
+                        if (tthis->m_statistics.maxWriteDuration < duration)
+                        {
+                            tthis->m_statistics.maxWriteDuration = duration;
+                        }
+                    }
+
+                    (void)xQueueSend(tthis->m_freeQueue, &job.blockIdx, portMAX_DELAY);
+                }
+            }
+        }
+
+        (void)xSemaphoreGive(tthis->m_taskSemaphore);
+    }
+
+    vTaskDelete(nullptr);
+
+    return;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
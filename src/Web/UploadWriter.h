@@ -0,0 +1,221 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Coalescing upload writer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup web
+ *
+ * @{
+ */
+
+#ifndef __UPLOAD_WRITER_H__
+#define __UPLOAD_WRITER_H__
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <FS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Writes uploaded data to a file. The received data parts are coalesced
+ * into blocks, which are written to flash by a low priority writer task.
+ * Every block is written right after a frame was sent to the physical
+ * display, so the flash write cycle doesn't disturb the display refresh.
+ *
+ * The receiving task is only blocked, if all blocks are waiting to be
+ * written.
+ */
+class UploadWriter
+{
+public:
+
+    /**
+     * Upload statistics, available after the writer is closed.
+     */
+    struct Statistics
+    {
+        uint32_t    size;               /**< Number of written bytes */
+        uint32_t    duration;           /**< Duration from open to close in ms */
+        uint32_t    throughput;         /**< Throughput in byte/s */
+        uint32_t    blockCount;         /**< Number of written blocks */
+        uint32_t    maxWriteDuration;   /**< Max. duration of a single block write in ms */
+        uint32_t    maxFramePeriod;     /**< Max. display frame period during the upload in ms */
+    };
+
+    /**
+     * Constructs the upload writer.
+     */
+    UploadWriter();
+
+    /**
+     * Destroys the upload writer. A open file will be closed.
+     */
+    ~UploadWriter();
+
+    /**
+     * Create the file and start the writer task.
+     * A existing file will be overwritten.
+     *
+     * @param[in] fs    Filesystem
+     * @param[in] path  Path of the file
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool open(FS& fs, const String& path);
+
+    /**
+     * Write data. The data is copied and written later on.
+     *
+     * @param[in] data  Data
+     * @param[in] len   Data length in bytes
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool write(const uint8_t* data, size_t len);
+
+    /**
+     * Write all pending data, stop the writer task and close the file.
+     *
+     * @return If all data was written successful, it will return true otherwise false.
+     */
+    bool close();
+
+    /**
+     * Is the writer open?
+     *
+     * @return If open, it will return true otherwise false.
+     */
+    bool isOpen() const
+    {
+        return (nullptr != m_taskSemaphore);
+    }
+
+    /**
+     * Get statistics of the last upload.
+     *
+     * @return Upload statistics
+     */
+    const Statistics& getStatistics() const
+    {
+        return m_statistics;
+    }
+
+    /** Block size in bytes, which is equal to the flash sector size. */
+    static const size_t         BLOCK_SIZE          = 4096U;
+
+    /** Number of blocks, one is filled while the other is written. */
+    static const uint8_t        BLOCK_COUNT         = 2U;
+
+private:
+
+    /** The writer task stack size in bytes */
+    static const uint32_t       TASK_STACK_SIZE     = 4096U;
+
+    /** The writer task shall run on any MCU core. */
+    static const BaseType_t     TASK_RUN_CORE       = tskNO_AFFINITY;
+
+    /** The writer task priority is low, it shall not disturb the display and the network. */
+    static const UBaseType_t    TASK_PRIORITY       = 1U;
+
+    /** Max. time in ms to wait for the display window, before writing anyway. */
+    static const uint32_t       FRAME_WAIT_TIMEOUT  = 50U;
+
+    /** Max. time in ms to wait for a free block. */
+    static const uint32_t       BLOCK_WAIT_TIMEOUT  = 5000U;
+
+    /** Invalid block index */
+    static const uint8_t        BLOCK_IDX_INVALID   = UINT8_MAX;
+
+    /**
+     * A block, which shall be written by the writer task.
+     * A block with length 0 requests the writer task to exit.
+     */
+    struct Job
+    {
+        uint8_t blockIdx;   /**< Block index */
+        size_t  len;        /**< Number of bytes in the block */
+    };
+
+    File                m_fd;               /**< File descriptor */
+    uint8_t*            m_blocks;           /**< Block memory */
+    QueueHandle_t       m_freeQueue;        /**< Indices of the free blocks */
+    QueueHandle_t       m_jobQueue;         /**< Blocks, which shall be written */
+    SemaphoreHandle_t   m_taskSemaphore;    /**< Binary semaphore used to signal the writer task exited. */
+    uint8_t             m_blockIdx;         /**< Index of the block, which is currently filled. */
+    size_t              m_blockLen;         /**< Number of bytes in the current block */
+    volatile bool       m_isError;          /**< Write error happened? */
+    uint32_t            m_timestamp;        /**< Timestamp in ms, when the writer was opened. */
+    Statistics          m_statistics;       /**< Statistics */
+
+    UploadWriter(const UploadWriter& writer);
+    UploadWriter& operator=(const UploadWriter& writer);
+
+    /**
+     * Pass the current block to the writer task.
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool submitBlock();
+
+    /**
+     * Release all resources.
+     */
+    void release();
+
+    /**
+     * Writer task, which writes the blocks to flash.
+     *
+     * @param[in] parameters    Task parameters
+     */
+    static void writerTask(void* parameters);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif  /* __UPLOAD_WRITER_H__ */
+
+/** @} */
@@ -34,10 +34,13 @@
  *****************************************************************************/
 #include "WebSocket.h"
 #include "Settings.h"
+#include "MemTag.h"
+#include "DisplayMgr.h"
 
 #include "WsCmdAlias.h"
 #include "WsCmdBrightness.h"
 #include "WsCmdButton.h"
+#include "WsCmdDispStream.h"
 #include "WsCmdEffect.h"
 #include "WsCmdGetDisp.h"
 #include "WsCmdInstall.h"
@@ -52,6 +55,7 @@
 
 #include <Logging.h>
 #include <Util.h>
+#include <algorithm>
 
 /******************************************************************************
  * Compiler Switches
@@ -69,6 +73,8 @@
  * Prototypes
  *****************************************************************************/
 
+static WsCmd* findCommand(const char* cmd, size_t cmdLen);
+
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
@@ -115,6 +121,9 @@ static WsCmdEffect          gWsCmdEffect;
 /** Websocket get/set plugin alias name command */
 static WsCmdAlias           gWsCmdAlias;
 
+/** Websocket display stream subscription command */
+static WsCmdDispStream      gWsCmdDispStream;
+
 /** Websocket command list */
 static WsCmd*       gWsCommands[] =
 {
@@ -131,9 +140,13 @@ static WsCmd*       gWsCommands[] =
     &gWsCmdIperf,
     &gWsCmdButton,
     &gWsCmdEffect,
-    &gWsCmdAlias
+    &gWsCmdAlias,
+    &gWsCmdDispStream
 };
 
+/** Websocket commands with binary support, indexed by the binary command id. */
+static WsCmd*       gWsBinCommands[WsCmd::BIN_CMD_ID_MAX];
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -142,6 +155,23 @@ void WebSocketSrv::init(AsyncWebServer& srv)
 {
     String      webLoginUser;
     String      webLoginPassword;
+    uint8_t     index               = 0U;
+
+    /* Sort the commands by their hash, to find them by binary search. */
+    std::sort(&gWsCommands[0U], &gWsCommands[UTIL_ARRAY_NUM(gWsCommands)],
+        [](const WsCmd* cmdA, const WsCmd* cmdB) -> bool {
+            return cmdA->getCmdHash() < cmdB->getCmdHash();
+        });
+
+    for(index = 0U; index < UTIL_ARRAY_NUM(gWsCommands); ++index)
+    {
+        WsCmd::BinCmdId binCmdId = gWsCommands[index]->getBinCmdId();
+
+        if (WsCmd::BIN_CMD_ID_NONE != binCmdId)
+        {
+            gWsBinCommands[binCmdId] = gWsCommands[index];
+        }
+    }
 
     if (false == Settings::getInstance().open(true))
     {
@@ -156,6 +186,14 @@ void WebSocketSrv::init(AsyncWebServer& srv)
         Settings::getInstance().close();
     }
 
+    if (false == m_mutex.isAllocated())
+    {
+        if (false == m_mutex.create())
+        {
+            LOG_ERROR("Couldn't create mutex, display stream not available.");
+        }
+    }
+
     /* Register websocket event handler */
     m_webSocket.onEvent(onEvent);
 
@@ -168,6 +206,188 @@ void WebSocketSrv::init(AsyncWebServer& srv)
     return;
 }
 
+void WebSocketSrv::process()
+{
+    /* Any display stream subscriber and is the stream available? */
+    if ((0U < m_displaySubscriberCnt) &&
+        (true == m_mutex.isAllocated()))
+    {
+        DisplayMgr::FramePtr frame = DisplayMgr::getInstance().getFrame();
+
+        if (nullptr != frame)
+        {
+            MutexGuard<Mutex>   guard(m_mutex);
+            uint8_t             idx     = 0U;
+
+            /* The frame message is created only once for all subscribers.
+             * Every subscriber gets a reference to the same message buffer.
+             */
+            if ((frame->seqNo != m_frameMsgSeqNo) ||
+                (nullptr == m_frameMsg))
+            {
+                const uint16_t  WIDTH   = frame->bitmap.getWidth();
+                const uint16_t  HEIGHT  = frame->bitmap.getHeight();
+
+                releaseFrameMsg();
+
+                m_frameMsg = m_webSocket.makeBuffer(DISPLAY_FRAME_HDR_SIZE + (3U * WIDTH * HEIGHT));
+
+                if ((nullptr != m_frameMsg) &&
+                    (nullptr == m_frameMsg->get()))
+                {
+                    /* The websocket server destroys the empty buffer. */
+                    m_frameMsg = nullptr;
+                }
+                else if (nullptr != m_frameMsg)
+                {
+                    uint8_t*    msg     = m_frameMsg->get();
+                    size_t      msgIdx  = DISPLAY_FRAME_HDR_SIZE;
+                    int16_t     x       = 0;
+                    int16_t     y       = 0;
+
+                    /* Keep the message until the next frame is available. */
+                    m_frameMsg->lock();
+
+                    msg[0U] = DISPLAY_FRAME_MSG_ID;
+                    msg[1U] = frame->slotId;
+                    msg[2U] = static_cast<uint8_t>((WIDTH >> 8U) & 0xFFU);
+                    msg[3U] = static_cast<uint8_t>((WIDTH >> 0U) & 0xFFU);
+                    msg[4U] = static_cast<uint8_t>((HEIGHT >> 8U) & 0xFFU);
+                    msg[5U] = static_cast<uint8_t>((HEIGHT >> 0U) & 0xFFU);
+                    msg[6U] = static_cast<uint8_t>((frame->seqNo >> 24U) & 0xFFU);
+                    msg[7U] = static_cast<uint8_t>((frame->seqNo >> 16U) & 0xFFU);
+                    msg[8U] = static_cast<uint8_t>((frame->seqNo >> 8U) & 0xFFU);
+                    msg[9U] = static_cast<uint8_t>((frame->seqNo >> 0U) & 0xFFU);
+
+                    for(y = 0; y < HEIGHT; ++y)
+                    {
+                        for(x = 0; x < WIDTH; ++x)
+                        {
+                            uint32_t color = frame->bitmap.getColor(x, y);
+
+                            msg[msgIdx + 0U] = static_cast<uint8_t>((color >> 16U) & 0xFFU);
+                            msg[msgIdx + 1U] = static_cast<uint8_t>((color >> 8U) & 0xFFU);
+                            msg[msgIdx + 2U] = static_cast<uint8_t>((color >> 0U) & 0xFFU);
+                            msgIdx += 3U;
+                        }
+                    }
+
+                    m_frameMsgSeqNo = frame->seqNo;
+                }
+                else
+                {
+                    ;
+                }
+            }
+
+            if (nullptr != m_frameMsg)
+            {
+                for(idx = 0U; idx < MAX_DISPLAY_SUBSCRIBERS; ++idx)
+                {
+                    if (0U != m_displaySubscribers[idx].clientId)
+                    {
+                        sendFrame(m_displaySubscribers[idx], m_frameMsgSeqNo);
+                    }
+                }
+            }
+        }
+    }
+
+    return;
+}
+
+bool WebSocketSrv::subscribeDisplay(uint32_t clientId, uint8_t maxFps)
+{
+    bool                isSuccessful    = false;
+    DisplaySubscriber*  subscriber      = nullptr;
+    uint8_t             idx             = 0U;
+    MutexGuard<Mutex>   guard(m_mutex);
+
+    if ((0U == clientId) ||
+        (0U == maxFps) ||
+        (false == m_mutex.isAllocated()))
+    {
+        return false;
+    }
+
+    /* Already subscribed or find a free one. */
+    for(idx = 0U; idx < MAX_DISPLAY_SUBSCRIBERS; ++idx)
+    {
+        if (clientId == m_displaySubscribers[idx].clientId)
+        {
+            subscriber = &m_displaySubscribers[idx];
+            break;
+        }
+        else if ((nullptr == subscriber) &&
+                 (0U == m_displaySubscribers[idx].clientId))
+        {
+            subscriber = &m_displaySubscribers[idx];
+        }
+        else
+        {
+            /* Nothing to do. */
+            ;
+        }
+    }
+
+    if (nullptr != subscriber)
+    {
+        /* New subscriber? */
+        if (clientId != subscriber->clientId)
+        {
+            subscriber->clientId    = clientId;
+            subscriber->timestamp   = 0U;
+            subscriber->seqNo       = 0U;
+            subscriber->sent        = 0U;
+            subscriber->skipped     = 0U;
+
+            ++m_displaySubscriberCnt;
+            DisplayMgr::getInstance().subscribeFrames();
+
+            LOG_INFO("ws[%u] Display stream started with max. %u fps.", clientId, maxFps);
+        }
+
+        subscriber->period  = 1000U / maxFps;
+        isSuccessful        = true;
+    }
+
+    return isSuccessful;
+}
+
+void WebSocketSrv::unsubscribeDisplay(uint32_t clientId)
+{
+    uint8_t             idx     = 0U;
+    MutexGuard<Mutex>   guard(m_mutex);
+
+    if (0U == clientId)
+    {
+        return;
+    }
+
+    for(idx = 0U; idx < MAX_DISPLAY_SUBSCRIBERS; ++idx)
+    {
+        DisplaySubscriber& subscriber = m_displaySubscribers[idx];
+
+        if (clientId == subscriber.clientId)
+        {
+            LOG_INFO("ws[%u] Display stream stopped, %u frames sent, %u frames skipped.", clientId, subscriber.sent, subscriber.skipped);
+
+            subscriber.clientId = 0U;
+
+            --m_displaySubscriberCnt;
+            DisplayMgr::getInstance().unsubscribeFrames();
+
+            if (0U == m_displaySubscriberCnt)
+            {
+                releaseFrameMsg();
+            }
+            break;
+        }
+    }
+
+    return;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -178,6 +398,8 @@ void WebSocketSrv::init(AsyncWebServer& srv)
 
 void WebSocketSrv::onEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len)
 {
+    MemTagGuard memTagGuard(MemTag::ID_WEB_SERVER);
+
     if ((nullptr == server) ||
         (nullptr == client))
     {
@@ -229,6 +451,10 @@ void WebSocketSrv::onConnect(AsyncWebSocket* server, AsyncWebSocketClient* clien
 void WebSocketSrv::onDisconnect(AsyncWebSocket* server, AsyncWebSocketClient* client)
 {
     LOG_INFO("ws[%s][%u] Client disconnected.", server->url(), client->id());
+
+    /* Stop the display stream. */
+    unsubscribeDisplay(client->id());
+
     return;
 }
 
@@ -270,8 +496,9 @@ void WebSocketSrv::onData(AsyncWebSocket* server, AsyncWebSocketClient* client,
         LOG_ERROR("ws[%s][%u] Frame info is missing.", server->url(), client->id());
         server->close(client->id(), 0U, "Frame info is missing.");
     }
-    /* No text frame? */
-    else if (WS_TEXT != info->opcode)
+    /* No text or binary frame? */
+    else if ((WS_TEXT != info->opcode) &&
+             (WS_BINARY != info->opcode))
     {
         LOG_ERROR("ws[%s][%u] Not supported message type received: %u", server->url(), client->id(), info->opcode);
         server->close(client->id(), 0U, "Not supported message type.");
@@ -287,6 +514,11 @@ void WebSocketSrv::onData(AsyncWebSocket* server, AsyncWebSocketClient* client,
         {
             LOG_WARNING("ws[%s][%u] Message: -", server->url(), client->id());
         }
+        /* Handle binary message */
+        else if (WS_BINARY == info->opcode)
+        {
+            handleBinaryMsg(server, client, data, len);
+        }
         /* Handle text message */
         else
         {
@@ -305,10 +537,6 @@ void WebSocketSrv::onData(AsyncWebSocket* server, AsyncWebSocketClient* client,
 
 void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const char* msg, size_t msgLen)
 {
-    size_t      msgIndex    = 0U;
-    String      cmd;
-    String      par;
-    WsCmd*      wsCmd       = nullptr;
     const char  DELIMITER   = ';';
 
     if ((nullptr == server) ||
@@ -319,75 +547,159 @@ void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* clien
         return;
     }
 
-    /* Skip spaces and tabs in front. */
-    while((msgLen > msgIndex) && ( (' ' == msg[msgIndex]) || ('\t' == msg[msgIndex]) ))
+    if (MSG_BUFFER_SIZE <= msgLen)
     {
-        ++msgIndex;
+        client->text("NACK;\"Message too long.\"");
     }
-
-    /* Get command string */
-    while((msgLen > msgIndex) && (DELIMITER != msg[msgIndex]))
+    else
     {
-        cmd += msg[msgIndex];
-        ++msgIndex;
-    }
+        char*   token       = m_msgBuffer;
+        char*   delimiter   = nullptr;
 
-    /* Command string not empty? */
-    if (0 < cmd.length())
-    {
-        uint8_t index = 0U;
+        /* The message is tokenized in place, therefore no further copies
+         * for the command string and the parameters are necessary.
+         */
+        memcpy(m_msgBuffer, msg, msgLen);
+        m_msgBuffer[msgLen] = '\0';
 
-        /* Find command object */
-        while((nullptr == wsCmd) && (index < UTIL_ARRAY_NUM(gWsCommands)))
+        /* Skip spaces and tabs in front. */
+        while((' ' == *token) || ('\t' == *token))
         {
-            if (cmd == gWsCommands[index]->getCmd())
-            {
-                wsCmd = gWsCommands[index];
-            }
-
-            ++index;
+            ++token;
         }
 
-        /* Command not found? */
-        if (nullptr == wsCmd)
+        /* Terminate command string */
+        delimiter = strchr(token, DELIMITER);
+
+        if (nullptr != delimiter)
         {
-            client->text("NACK;\"Command unknown.\"");
+            *delimiter = '\0';
         }
-        else
+
+        /* Command string not empty? */
+        if ('\0' != *token)
         {
-            /* Determine parameters */
-            if ((msgLen > msgIndex) &&
-                (DELIMITER == msg[msgIndex]))
-            {
-                /* Overstep delimiter */
-                ++msgIndex;
+            WsCmd* wsCmd = findCommand(token, strlen(token));
 
-                while(msgLen > msgIndex)
+            /* Command not found? */
+            if (nullptr == wsCmd)
+            {
+                client->text("NACK;\"Command unknown.\"");
+            }
+            else
+            {
+                /* Determine parameters */
+                while(nullptr != delimiter)
                 {
-                    if (DELIMITER == msg[msgIndex])
-                    {
-                        wsCmd->setPar(par.c_str());
-                        par.clear();
-                    }
-                    else
+                    token       = delimiter + 1;
+                    delimiter   = strchr(token, DELIMITER);
+
+                    if (nullptr != delimiter)
                     {
-                        par += msg[msgIndex];
+                        *delimiter = '\0';
                     }
 
-                    ++msgIndex;
+                    wsCmd->setPar(token);
                 }
 
-                wsCmd->setPar(par.c_str());
+                /* Execute command */
+                wsCmd->execute(server, client);
             }
-
-            /* Execute command */
-            wsCmd->execute(server, client);
         }
     }
 
     return;
 }
 
+void WebSocketSrv::handleBinaryMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* msg, size_t msgLen)
+{
+    uint8_t binCmdId    = 0U;
+    WsCmd*  wsCmd       = nullptr;
+
+    if ((nullptr == server) ||
+        (nullptr == client) ||
+        (nullptr == msg) ||
+        (0 == msgLen))
+    {
+        return;
+    }
+
+    /* The first byte is the command id, followed by the parameters. */
+    binCmdId = msg[0U];
+
+    if (WsCmd::BIN_CMD_ID_MAX > binCmdId)
+    {
+        wsCmd = gWsBinCommands[binCmdId];
+    }
+
+    /* Command not found? */
+    if (nullptr == wsCmd)
+    {
+        uint8_t rsp[2U] = { binCmdId, WsCmd::BIN_NACK };
+
+        server->binary(client->id(), rsp, sizeof(rsp));
+    }
+    else
+    {
+        wsCmd->executeBinary(server, client, &msg[1U], msgLen - 1U);
+    }
+
+    return;
+}
+
+void WebSocketSrv::sendFrame(DisplaySubscriber& subscriber, uint32_t seqNo)
+{
+    AsyncWebSocketClient*   client      = m_webSocket.client(subscriber.clientId);
+    uint32_t                timestamp   = millis();
+
+    /* Client not available anymore, frame already sent or max. frame rate
+     * reached? In the last case the frame may be sent in a later call.
+     */
+    if ((nullptr == client) ||
+        (WS_CONNECTED != client->status()) ||
+        (nullptr == client->client()) ||
+        (seqNo == subscriber.seqNo) ||
+        (subscriber.period > (timestamp - subscriber.timestamp)))
+    {
+        /* Nothing to do. */
+        ;
+    }
+    /* A slow client skips the frame, instead of queueing it. The frame is
+     * only sent, if the previous messages are already handed over to the
+     * TCP stack and there is enough space for the whole frame.
+     */
+    else if ((true == client->queueIsFull()) ||
+             (m_frameMsg->length() > client->client()->space()))
+    {
+        subscriber.seqNo = seqNo;
+        ++subscriber.skipped;
+    }
+    else
+    {
+        client->binary(m_frameMsg);
+
+        subscriber.seqNo        = seqNo;
+        subscriber.timestamp    = timestamp;
+        ++subscriber.sent;
+    }
+
+    return;
+}
+
+void WebSocketSrv::releaseFrameMsg()
+{
+    if (nullptr != m_frameMsg)
+    {
+        m_frameMsg->unlock();
+        m_frameMsg = nullptr;
+    }
+
+    /* Destroy the message buffers, which are sent to all clients. */
+    m_webSocket._cleanBuffers();
+
+    return;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -395,3 +707,52 @@ void WebSocketSrv::handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* clien
 /******************************************************************************
  * Local Functions
  *****************************************************************************/
+
+/**
+ * Find websocket command by its command string.
+ *
+ * @param[in] cmd       Command string (not '\0' terminated)
+ * @param[in] cmdLen    Command string length
+ *
+ * @return Websocket command or nullptr if not found.
+ */
+static WsCmd* findCommand(const char* cmd, size_t cmdLen)
+{
+    WsCmd*          wsCmd   = nullptr;
+    const uint32_t  cmdHash = WsCmd::hash(cmd, cmdLen);
+    size_t          left    = 0U;
+    size_t          right   = UTIL_ARRAY_NUM(gWsCommands);
+
+    /* Binary search for the first command with the same hash. */
+    while(left < right)
+    {
+        size_t mid = left + ((right - left) / 2U);
+
+        if (gWsCommands[mid]->getCmdHash() < cmdHash)
+        {
+            left = mid + 1U;
+        }
+        else
+        {
+            right = mid;
+        }
+    }
+
+    /* Different command strings may have the same hash. */
+    while((nullptr == wsCmd) &&
+          (UTIL_ARRAY_NUM(gWsCommands) > left) &&
+          (cmdHash == gWsCommands[left]->getCmdHash()))
+    {
+        const char* candidate = gWsCommands[left]->getCmd();
+
+        if ((0 == strncmp(candidate, cmd, cmdLen)) &&
+            ('\0' == candidate[cmdLen]))
+        {
+            wsCmd = gWsCommands[left];
+        }
+
+        ++left;
+    }
+
+    return wsCmd;
+}
@@ -46,6 +46,7 @@
 #include <ESPAsyncWebServer.h>
 #include <stdint.h>
 #include <Print.h>
+#include <Mutex.hpp>
 
 #include "WebConfig.h"
 
@@ -83,15 +84,76 @@ public:
      */
     void init(AsyncWebServer& srv);
 
+    /**
+     * Push the last completed display frame to the display stream
+     * subscribers. Call it periodically.
+     */
+    void process(void);
+
+    /**
+     * Subscribe a client to the display stream. If the client is already
+     * subscribed, only its max. frame rate is updated.
+     *
+     * @param[in] clientId  Websocket client id
+     * @param[in] maxFps    Max. frame rate in frames per second
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool subscribeDisplay(uint32_t clientId, uint8_t maxFps);
+
+    /**
+     * Unsubscribe a client from the display stream.
+     *
+     * @param[in] clientId  Websocket client id
+     */
+    void unsubscribeDisplay(uint32_t clientId);
+
+    /** Max. number of clients, which can subscribe to the display stream. */
+    static const uint8_t    MAX_DISPLAY_SUBSCRIBERS = 4U;
+
+    /** Id of a display frame message. It is never used as binary command id. */
+    static const uint8_t    DISPLAY_FRAME_MSG_ID    = 0xFFU;
+
+    /** Size of the display frame message header in bytes. */
+    static const size_t     DISPLAY_FRAME_HDR_SIZE  = 10U;
+
 private:
 
-    AsyncWebSocket  m_webSocket;    /**< Websocket */
+    /**
+     * A client, which subscribed to the display stream.
+     */
+    struct DisplaySubscriber
+    {
+        uint32_t    clientId;   /**< Websocket client id, 0 if not used */
+        uint32_t    period;     /**< Min. period between two frames in ms */
+        uint32_t    timestamp;  /**< Timestamp in ms of the last sent frame */
+        uint32_t    seqNo;      /**< Sequence number of the last sent frame */
+        uint32_t    sent;       /**< Number of sent frames */
+        uint32_t    skipped;    /**< Number of frames skipped, because the client was not ready */
+    };
+
+    /** Max. length of a text message in bytes, including the string termination. */
+    static const size_t MSG_BUFFER_SIZE = 256U;
+
+    AsyncWebSocket                  m_webSocket;                                    /**< Websocket */
+    char                            m_msgBuffer[MSG_BUFFER_SIZE];                   /**< Text message buffer, which is tokenized in place. */
+    Mutex                           m_mutex;                                        /**< Protects the display subscribers */
+    DisplaySubscriber               m_displaySubscribers[MAX_DISPLAY_SUBSCRIBERS];  /**< Display stream subscribers */
+    uint8_t                         m_displaySubscriberCnt;                         /**< Number of display stream subscribers */
+    AsyncWebSocketMessageBuffer*    m_frameMsg;                                     /**< Display frame message, shared by all subscribers. Locked as long as it is the current one. */
+    uint32_t                        m_frameMsgSeqNo;                                /**< Sequence number of the frame in the message */
 
     /**
      * Constructs the websocket server.
      */
     WebSocketSrv() :
-        m_webSocket(WebConfig::WEBSOCKET_PATH)
+        m_webSocket(WebConfig::WEBSOCKET_PATH),
+        m_msgBuffer(),
+        m_mutex(),
+        m_displaySubscribers(),
+        m_displaySubscriberCnt(0U),
+        m_frameMsg(nullptr),
+        m_frameMsgSeqNo(0U)
     {
     }
 
@@ -173,6 +235,31 @@ private:
      */
     void handleMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const char* msg, size_t msgLen);
 
+    /**
+     * Handle a binary websocket message.
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Weboscket client
+     * @param[in] msg       Websocket message
+     * @param[in] msgLen    Websocket message length
+     */
+    void handleBinaryMsg(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* msg, size_t msgLen);
+
+    /**
+     * Send the display frame message to a subscriber, if it is due and
+     * the client is ready. A client, which is not ready, skips the frame.
+     *
+     * @param[in] subscriber    Display stream subscriber
+     * @param[in] seqNo         Sequence number of the frame in the message
+     */
+    void sendFrame(DisplaySubscriber& subscriber, uint32_t seqNo);
+
+    /**
+     * Release the display frame message. It is destroyed by the websocket
+     * server, after it was sent to all subscribers.
+     */
+    void releaseFrameMsg();
+
     /**
      * Write single data byte to all clients.
      *
@@ -67,6 +67,25 @@ const char*    WsCmd::NACK      = "NACK";
  * Public Methods
  *****************************************************************************/
 
+uint32_t WsCmd::hash(const char* str, size_t len)
+{
+    const uint32_t  FNV_OFFSET_BASIS    = 2166136261UL;
+    const uint32_t  FNV_PRIME           = 16777619UL;
+    uint32_t        value               = FNV_OFFSET_BASIS;
+    size_t          index               = 0U;
+
+    if (nullptr != str)
+    {
+        for(index = 0U; index < len; ++index)
+        {
+            value ^= static_cast<uint8_t>(str[index]);
+            value *= FNV_PRIME;
+        }
+    }
+
+    return value;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -107,6 +126,30 @@ void WsCmd::sendNegativeResponse(AsyncWebSocket* server, AsyncWebSocketClient* c
     }
 }
 
+void WsCmd::sendBinaryResponse(AsyncWebSocket* server, AsyncWebSocketClient* client, bool isPositive, const uint8_t* data, size_t dataLen)
+{
+    if ((nullptr != server) &&
+        (nullptr != client))
+    {
+        uint8_t rsp[2U + BIN_RSP_MAX_LEN];
+
+        rsp[0U] = static_cast<uint8_t>(m_binCmdId);
+        rsp[1U] = (true == isPositive) ? BIN_ACK : BIN_NACK;
+
+        if ((nullptr == data) ||
+            (BIN_RSP_MAX_LEN < dataLen))
+        {
+            dataLen = 0U;
+        }
+        else
+        {
+            memcpy(&rsp[2U], data, dataLen);
+        }
+
+        server->binary(client->id(), rsp, 2U + dataLen);
+    }
+}
+
 /******************************************************************************
  * Private Methods
  *****************************************************************************/
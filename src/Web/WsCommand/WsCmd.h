@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <ESPAsyncWebServer.h>
+#include <Util.h>
 
 /******************************************************************************
  * Macros
@@ -60,13 +61,37 @@ class WsCmd
 {
 public:
 
+    /**
+     * Binary command ids. A binary message starts with the command id,
+     * followed by the parameters. A binary response starts with the
+     * command id and the status (BIN_ACK/BIN_NACK), followed by the
+     * result.
+     */
+    enum BinCmdId
+    {
+        BIN_CMD_ID_NONE = 0,    /**< Command has no binary support */
+        BIN_CMD_ID_BUTTON,      /**< Trigger virtual user button */
+        BIN_CMD_ID_BRIGHTNESS,  /**< Get/set display brightness */
+        BIN_CMD_ID_MOVE,        /**< Move plugin to slot */
+        BIN_CMD_ID_MAX          /**< Number of binary command ids */
+    };
+
+    /** Binary positive response status */
+    static const uint8_t    BIN_ACK     = 0U;
+
+    /** Binary negative response status */
+    static const uint8_t    BIN_NACK    = 1U;
+
     /**
      * Constructs a websocket command.
      * 
-     * @param[in] cmd   Command string
+     * @param[in] cmd       Command string
+     * @param[in] binCmdId  Binary command id
      */
-    WsCmd(const char* cmd) :
-        m_cmd(cmd)
+    WsCmd(const char* cmd, BinCmdId binCmdId = BIN_CMD_ID_NONE) :
+        m_cmd(cmd),
+        m_cmdHash(hash(cmd, strlen(cmd))),
+        m_binCmdId(binCmdId)
     {
     }
 
@@ -82,11 +107,41 @@ public:
      * 
      * @return Command string
      */
-    const String& getCmd() const
+    const char* getCmd() const
     {
         return m_cmd;
     }
 
+    /**
+     * Get hash of the command string.
+     * 
+     * @return Command string hash
+     */
+    uint32_t getCmdHash() const
+    {
+        return m_cmdHash;
+    }
+
+    /**
+     * Get binary command id.
+     * 
+     * @return Binary command id
+     */
+    BinCmdId getBinCmdId() const
+    {
+        return m_binCmdId;
+    }
+
+    /**
+     * Calculate the hash (FNV-1a) of a command string.
+     * 
+     * @param[in] str   Command string (not '\0' terminated)
+     * @param[in] len   Command string length
+     * 
+     * @return Hash
+     */
+    static uint32_t hash(const char* str, size_t len);
+
     /**
      * Execute command.
      * 
@@ -102,6 +157,24 @@ public:
      */
     virtual void setPar(const char* par) = 0;
 
+    /**
+     * Execute command, received as binary message.
+     * A command with binary support shall override it, otherwise a negative
+     * response is sent.
+     * 
+     * @param[in] server    Websocket server
+     * @param[in] client    Websocket client
+     * @param[in] par       Binary parameters
+     * @param[in] parLen    Binary parameters length in bytes
+     */
+    virtual void executeBinary(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* par, size_t parLen)
+    {
+        UTIL_NOT_USED(par);
+        UTIL_NOT_USED(parLen);
+
+        sendBinaryResponse(server, client, false);
+    }
+
 protected:
 
     /** Delimiter of websocket parameters */
@@ -140,9 +213,25 @@ protected:
      */
     void sendNegativeResponse(AsyncWebSocket* server, AsyncWebSocketClient* client, const String& msg);
 
+    /**
+     * Send binary response to the client.
+     * 
+     * @param[in] server        Websocket server which is used to send a message to the client.
+     * @param[in] client        The client the message belongs to.
+     * @param[in] isPositive    Positive or negative response
+     * @param[in] data          Response data (optional)
+     * @param[in] dataLen       Response data length in bytes
+     */
+    void sendBinaryResponse(AsyncWebSocket* server, AsyncWebSocketClient* client, bool isPositive, const uint8_t* data = nullptr, size_t dataLen = 0U);
+
+    /** Max. binary response data length in bytes */
+    static const size_t     BIN_RSP_MAX_LEN = 16U;
+
 private:
 
-    String  m_cmd;  /**< Command */
+    const char* m_cmd;      /**< Command */
+    uint32_t    m_cmdHash;  /**< Command string hash */
+    BinCmdId    m_binCmdId; /**< Binary command id */
 
     WsCmd();
     WsCmd(const WsCmd& cmd);
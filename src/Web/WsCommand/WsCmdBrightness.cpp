@@ -111,7 +111,7 @@ void WsCmdBrightness::setPar(const char* par)
     switch(m_parCnt)
     {
     case 0:
-        if (false == Util::strToUInt8(String(par), m_brightness))
+        if (false == Util::strToUInt8(par, m_brightness))
         {
             LOG_ERROR("Conversion failed: %s", par);
             m_isError = true;
@@ -143,6 +143,42 @@ void WsCmdBrightness::setPar(const char* par)
     return;
 }
 
+void WsCmdBrightness::executeBinary(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* par, size_t parLen)
+{
+    if ((nullptr == server) ||
+        (nullptr == client))
+    {
+        return;
+    }
+
+    if ((2U < parLen) ||
+        ((2U == parLen) && (1U < par[1U])))
+    {
+        sendBinaryResponse(server, client, false);
+    }
+    else
+    {
+        uint8_t rsp[2U];
+
+        if (1U <= parLen)
+        {
+            DisplayMgr::getInstance().setBrightness(par[0U]);
+        }
+
+        if (2U == parLen)
+        {
+            DisplayMgr::getInstance().setAutoBrightnessAdjustment(1U == par[1U]);
+        }
+
+        rsp[0U] = DisplayMgr::getInstance().getBrightness();
+        rsp[1U] = (true == DisplayMgr::getInstance().getAutoBrightnessAdjustment()) ? 1U : 0U;
+
+        sendBinaryResponse(server, client, true, rsp, sizeof(rsp));
+    }
+
+    return;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
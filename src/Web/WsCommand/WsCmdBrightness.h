@@ -64,7 +64,7 @@ public:
      * Constructs the websocket command.
      */
     WsCmdBrightness() :
-        WsCmd("BRIGHTNESS"),
+        WsCmd("BRIGHTNESS", BIN_CMD_ID_BRIGHTNESS),
         m_isError(false),
         m_parCnt(0U),
         m_brightness(0U),
@@ -94,6 +94,19 @@ public:
      */
     void setPar(const char* par) final;
 
+    /**
+     * Execute command, received as binary message.
+     *
+     * Parameters: [<brightness> [<auto-brightness-adjustment>]]
+     * Response data: <brightness> <auto-brightness-adjustment>
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Websocket client
+     * @param[in] par       Binary parameters
+     * @param[in] parLen    Binary parameters length in bytes
+     */
+    void executeBinary(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* par, size_t parLen) final;
+
 private:
 
     bool    m_isError;      /**< Any error happened during parameter reception? */
@@ -95,6 +95,30 @@ void WsCmdButton::setPar(const char* par)
     return;
 }
 
+void WsCmdButton::executeBinary(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* par, size_t parLen)
+{
+    UTIL_NOT_USED(par);
+
+    if ((nullptr == server) ||
+        (nullptr == client))
+    {
+        return;
+    }
+
+    if (0U != parLen)
+    {
+        sendBinaryResponse(server, client, false);
+    }
+    else
+    {
+        DisplayMgr::getInstance().activateNextSlot();
+
+        sendBinaryResponse(server, client, true);
+    }
+
+    return;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
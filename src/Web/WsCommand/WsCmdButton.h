@@ -64,7 +64,7 @@ public:
      * Constructs the websocket command.
      */
     WsCmdButton() :
-        WsCmd("BUTTON"),
+        WsCmd("BUTTON", BIN_CMD_ID_BUTTON),
         m_isError(false)
     {
     }
@@ -91,6 +91,19 @@ public:
      */
     void setPar(const char* par) final;
 
+    /**
+     * Execute command, received as binary message.
+     *
+     * Parameters: -
+     * Response data: -
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Websocket client
+     * @param[in] par       Binary parameters
+     * @param[in] parLen    Binary parameters length in bytes
+     */
+    void executeBinary(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* par, size_t parLen) final;
+
 private:
 
     bool    m_isError;  /**< Any error happened during parameter reception? */
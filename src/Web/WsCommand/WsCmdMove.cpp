@@ -78,26 +78,19 @@ void WsCmdMove::execute(AsyncWebSocket* server, AsyncWebSocketClient* client)
     }
     else
     {
-        uint8_t             srcSlotId   = DisplayMgr::getInstance().getSlotIdByPluginUID(m_uid);
-        IPluginMaintenance* plugin      = DisplayMgr::getInstance().getPluginInSlot(srcSlotId);
+        const char* errorMsg = move(m_uid, m_slotId);
 
-        if (SlotList::SLOT_ID_INVALID == srcSlotId)
+        if (nullptr != errorMsg)
         {
-            sendNegativeResponse(server, client, "\"Plugin UID not found.\"");
-        }
-        else if (nullptr == plugin)
-        {
-            sendNegativeResponse(server, client, "\"Plugin not found.\"");
-        }
-        else if (false == DisplayMgr::getInstance().movePluginToSlot(plugin, m_slotId))
-        {
-            sendNegativeResponse(server, client, "\"Move failed.\"");
+            String msg = "\"";
+
+            msg += errorMsg;
+            msg += "\"";
+
+            sendNegativeResponse(server, client, msg);
         }
         else
         {
-            /* Save new location of plugin in persistent memory. */
-            PluginMgr::getInstance().save();
-
             sendPositiveResponse(server, client);
         }
     }
@@ -113,7 +106,7 @@ void WsCmdMove::setPar(const char* par)
     switch(m_parCnt)
     {
     case 0:
-        if (false == Util::strToUInt16(String(par), m_uid))
+        if (false == Util::strToUInt16(par, m_uid))
         {
             LOG_ERROR("Conversion failed: %s", par);
             m_isError = true;
@@ -121,7 +114,7 @@ void WsCmdMove::setPar(const char* par)
         break;
 
     case 1:
-        if (false == Util::strToUInt8(String(par), m_slotId))
+        if (false == Util::strToUInt8(par, m_slotId))
         {
             LOG_ERROR("Conversion failed: %s", par);
             m_isError = true;
@@ -138,6 +131,28 @@ void WsCmdMove::setPar(const char* par)
     return;
 }
 
+void WsCmdMove::executeBinary(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* par, size_t parLen)
+{
+    if ((nullptr == server) ||
+        (nullptr == client))
+    {
+        return;
+    }
+
+    if (3U != parLen)
+    {
+        sendBinaryResponse(server, client, false);
+    }
+    else
+    {
+        uint16_t uid = (static_cast<uint16_t>(par[0U]) << 8U) | static_cast<uint16_t>(par[1U]);
+
+        sendBinaryResponse(server, client, (nullptr == move(uid, par[2U])));
+    }
+
+    return;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -146,6 +161,33 @@ void WsCmdMove::setPar(const char* par)
  * Private Methods
  *****************************************************************************/
 
+const char* WsCmdMove::move(uint16_t uid, uint8_t slotId)
+{
+    const char*         errorMsg    = nullptr;
+    uint8_t             srcSlotId   = DisplayMgr::getInstance().getSlotIdByPluginUID(uid);
+    IPluginMaintenance* plugin      = DisplayMgr::getInstance().getPluginInSlot(srcSlotId);
+
+    if (SlotList::SLOT_ID_INVALID == srcSlotId)
+    {
+        errorMsg = "Plugin UID not found.";
+    }
+    else if (nullptr == plugin)
+    {
+        errorMsg = "Plugin not found.";
+    }
+    else if (false == DisplayMgr::getInstance().movePluginToSlot(plugin, slotId))
+    {
+        errorMsg = "Move failed.";
+    }
+    else
+    {
+        /* Save new location of plugin in persistent memory. */
+        PluginMgr::getInstance().save();
+    }
+
+    return errorMsg;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -66,7 +66,7 @@ public:
      * Constructs the websocket command.
      */
     WsCmdMove() :
-        WsCmd("MOVE"),
+        WsCmd("MOVE", BIN_CMD_ID_MOVE),
         m_isError(false),
         m_parCnt(0U),
         m_uid(0U),
@@ -96,6 +96,19 @@ public:
      */
     void setPar(const char* par) final;
 
+    /**
+     * Execute command, received as binary message.
+     *
+     * Parameters: <plugin-uid (16 bit, big endian)> <slot-id>
+     * Response data: -
+     *
+     * @param[in] server    Websocket server
+     * @param[in] client    Websocket client
+     * @param[in] par       Binary parameters
+     * @param[in] parLen    Binary parameters length in bytes
+     */
+    void executeBinary(AsyncWebSocket* server, AsyncWebSocketClient* client, const uint8_t* par, size_t parLen) final;
+
 private:
 
     bool        m_isError;  /**< Any error happened during parameter reception? */
@@ -105,6 +118,16 @@ private:
 
     WsCmdMove(const WsCmdMove& cmd);
     WsCmdMove& operator=(const WsCmdMove& cmd);
+
+    /**
+     * Move a plugin to a different slot.
+     *
+     * @param[in] uid       UID of plugin, which to move
+     * @param[in] slotId    Slot id of destination slot
+     *
+     * @return If successful, it will return nullptr otherwise the error message.
+     */
+    const char* move(uint16_t uid, uint8_t slotId);
 };
 
 /******************************************************************************
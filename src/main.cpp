@@ -43,6 +43,7 @@
 #include "TaskMon.h"
 #include "MemMon.h"
 #include "ResetMon.h"
+#include "PluginConfigStore.h"
 
 /******************************************************************************
  * Macros
@@ -161,6 +162,9 @@ void loop()
     /* Memory monitor */
     MemMon::getInstance().process();
 
+    /* Write pending plugin configurations */
+    PluginConfigStore::getInstance().process();
+
     /* Schedule other tasks with same or lower priority. */
     delay(LOOP_TASK_PERIOD);
 
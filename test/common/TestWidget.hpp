@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <Widget.hpp>
+#include <Util.h>
 
 /******************************************************************************
  * Macros
@@ -96,9 +97,34 @@ public:
     void setPenColor(const Color& color)
     {
         m_color = color;
+        invalidate();
         return;
     }
 
+    /**
+     * Get the area in the canvas, which the widget paints.
+     *
+     * @param[in]   gfx     Graphics interface of the canvas
+     * @param[out]  area    Area in the canvas
+     */
+    void getArea(const YAGfx& gfx, Area& area) const override
+    {
+        UTIL_NOT_USED(gfx);
+
+        area = Area(m_posX, m_posY, WIDTH, HEIGHT);
+        return;
+    }
+
+    /**
+     * Paints the widget every pixel in its area?
+     *
+     * @return If the widget is opaque, it will return true otherwise false.
+     */
+    bool isOpaque() const override
+    {
+        return true;
+    }
+
     static const uint16_t           WIDTH       = 10U;  /**< Widget width in pixel */
     static const uint16_t           HEIGHT      = 5U;   /**< Widget height in pixel */
     static constexpr const char*    WIDGET_TYPE = "test";   /**< Widget type string */
@@ -0,0 +1,348 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test bitmap cache.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Util.h>
+#include <BitmapCache.h>
+#include <FS.h>
+#include <stdio.h>
+#include <utime.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool copyFile(const char* src, const char* dst);
+static void testBitmapCache();
+static void testBitmapCacheLru();
+static void testBitmapCacheModified();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Test image with 2x2 pixels, 24 bpp. */
+static const char*  TEST_IMAGE          = "./test/test_BmpImgLoader/test24bpp.bmp";
+
+/** Unsupported test image, which is not a bitmap image at all. */
+static const char*  TEST_IMAGE_INVALID  = "./test/test_GifDecoder/animation.gif";
+
+/** Copies of the test image, created by the tests. */
+static const char*  TEST_IMAGE_COPIES[] =
+{
+    "./test/test_BitmapCache/copy0.bmp",
+    "./test/test_BitmapCache/copy1.bmp",
+    "./test/test_BitmapCache/copy2.bmp"
+};
+
+/** Size of the decoded test image in bytes. */
+static const size_t TEST_IMAGE_SIZE     = 2U * 2U * sizeof(Color);
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testBitmapCache);
+    RUN_TEST(testBitmapCacheLru);
+    RUN_TEST(testBitmapCacheModified);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    BitmapCache::getInstance().setBudget(BitmapCache::DEFAULT_BUDGET);
+    BitmapCache::getInstance().clear();
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    size_t idx = 0U;
+
+    BitmapCache::getInstance().clear();
+
+    for(idx = 0U; idx < UTIL_ARRAY_NUM(TEST_IMAGE_COPIES); ++idx)
+    {
+        (void)remove(TEST_IMAGE_COPIES[idx]);
+    }
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Copy a file.
+ *
+ * @param[in] src   Source file name
+ * @param[in] dst   Destination file name
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool copyFile(const char* src, const char* dst)
+{
+    bool    isSuccessful    = false;
+    FILE*   srcFd           = fopen(src, "rb");
+    FILE*   dstFd           = fopen(dst, "wb");
+
+    if ((nullptr != srcFd) &&
+        (nullptr != dstFd))
+    {
+        uint8_t buffer[64];
+        size_t  cnt     = 0U;
+
+        isSuccessful = true;
+
+        while(0U < (cnt = fread(buffer, 1U, sizeof(buffer), srcFd)))
+        {
+            if (cnt != fwrite(buffer, 1U, cnt, dstFd))
+            {
+                isSuccessful = false;
+                break;
+            }
+        }
+    }
+
+    if (nullptr != srcFd)
+    {
+        fclose(srcFd);
+    }
+
+    if (nullptr != dstFd)
+    {
+        fclose(dstFd);
+    }
+
+    return isSuccessful;
+}
+
+/**
+ * Test sharing of bitmaps.
+ */
+static void testBitmapCache()
+{
+    BitmapCache&        cache   = BitmapCache::getInstance();
+    FS                  localFileSystem;
+    BitmapCache::Ref    ref1;
+    BitmapCache::Ref    ref2;
+
+    TEST_ASSERT_EQUAL_UINT8(0U, cache.getCount());
+    TEST_ASSERT_EQUAL(0U, cache.getUsage());
+    TEST_ASSERT_TRUE(ref1.isEmpty());
+    TEST_ASSERT_EQUAL_UINT16(0U, ref1.get().getWidth());
+
+    /* Errors are reported like the bitmap loader does. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_NOT_FOUND, cache.load(localFileSystem, "./notExisting.bmp", ref1));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED, cache.load(localFileSystem, TEST_IMAGE_INVALID, ref1));
+    TEST_ASSERT_TRUE(ref1.isEmpty());
+    TEST_ASSERT_EQUAL_UINT8(0U, cache.getCount());
+
+    /* The first load decodes the image. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE, ref1));
+    TEST_ASSERT_FALSE(ref1.isEmpty());
+    TEST_ASSERT_EQUAL_UINT16(2U, ref1.get().getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2U, ref1.get().getHeight());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, ref1.get().getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, ref1.get().getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT8(1U, cache.getCount());
+    TEST_ASSERT_EQUAL(TEST_IMAGE_SIZE, cache.getUsage());
+
+    /* The second load shares the decoded image. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE, ref2));
+    TEST_ASSERT_EQUAL_PTR(&ref1.get(), &ref2.get());
+    TEST_ASSERT_EQUAL_UINT8(1U, cache.getCount());
+
+    /* Loading the same image again doesn't change anything. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE, ref2));
+    TEST_ASSERT_EQUAL_PTR(&ref1.get(), &ref2.get());
+
+    /* Copies share it too. */
+    {
+        BitmapCache::Ref ref3(ref1);
+
+        TEST_ASSERT_EQUAL_PTR(&ref1.get(), &ref3.get());
+
+        ref3.release();
+        TEST_ASSERT_TRUE(ref3.isEmpty());
+
+        ref3 = ref2;
+        TEST_ASSERT_EQUAL_PTR(&ref2.get(), &ref3.get());
+    }
+
+    /* Referenced bitmaps are never released. */
+    cache.clear();
+    TEST_ASSERT_EQUAL_UINT8(1U, cache.getCount());
+
+    /* Not referenced bitmaps stay cached until they are cleared. */
+    ref1.release();
+    ref2.release();
+    TEST_ASSERT_EQUAL_UINT8(1U, cache.getCount());
+    cache.clear();
+    TEST_ASSERT_EQUAL_UINT8(0U, cache.getCount());
+    TEST_ASSERT_EQUAL(0U, cache.getUsage());
+
+    return;
+}
+
+/**
+ * Test the least recently used replacement with the memory budget.
+ */
+static void testBitmapCacheLru()
+{
+    BitmapCache&        cache   = BitmapCache::getInstance();
+    FS                  localFileSystem;
+    BitmapCache::Ref    ref;
+    BitmapCache::Ref    refLoaded;
+    size_t              idx     = 0U;
+
+    for(idx = 0U; idx < UTIL_ARRAY_NUM(TEST_IMAGE_COPIES); ++idx)
+    {
+        TEST_ASSERT_TRUE(copyFile(TEST_IMAGE, TEST_IMAGE_COPIES[idx]));
+    }
+
+    /* Budget for two images. */
+    cache.setBudget(2U * TEST_IMAGE_SIZE);
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE_COPIES[0], ref));
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE_COPIES[1], ref));
+    TEST_ASSERT_EQUAL_UINT8(2U, cache.getCount());
+
+    /* Use the first one again, so the second one is the least recently used. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE_COPIES[0], refLoaded));
+
+    /* The third one replaces the second one, which is not referenced anymore. */
+    ref.release();
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE_COPIES[2], ref));
+    TEST_ASSERT_EQUAL_UINT8(2U, cache.getCount());
+    TEST_ASSERT_EQUAL(2U * TEST_IMAGE_SIZE, cache.getUsage());
+
+    /* The first one is still cached. */
+    {
+        BitmapCache::Ref refAgain;
+
+        TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE_COPIES[0], refAgain));
+        TEST_ASSERT_EQUAL_PTR(&refLoaded.get(), &refAgain.get());
+    }
+
+    /* Referenced bitmaps exceed the budget, instead of being released. */
+    cache.setBudget(0U);
+    TEST_ASSERT_EQUAL_UINT8(2U, cache.getCount());
+    refLoaded.release();
+    cache.setBudget(TEST_IMAGE_SIZE);
+    TEST_ASSERT_EQUAL_UINT8(1U, cache.getCount());
+    TEST_ASSERT_EQUAL_UINT16(2U, ref.get().getWidth());
+
+    return;
+}
+
+/**
+ * Test that a modified file is loaded again.
+ */
+static void testBitmapCacheModified()
+{
+    BitmapCache&        cache   = BitmapCache::getInstance();
+    FS                  localFileSystem;
+    BitmapCache::Ref    refOld;
+    BitmapCache::Ref    refNew;
+    struct utimbuf      times;
+
+    TEST_ASSERT_TRUE(copyFile(TEST_IMAGE, TEST_IMAGE_COPIES[0]));
+    times.actime    = 1000;
+    times.modtime   = 1000;
+    TEST_ASSERT_EQUAL_INT(0, utime(TEST_IMAGE_COPIES[0], &times));
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE_COPIES[0], refOld));
+
+    /* Modify file. */
+    times.actime    = 2000;
+    times.modtime   = 2000;
+    TEST_ASSERT_EQUAL_INT(0, utime(TEST_IMAGE_COPIES[0], &times));
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, cache.load(localFileSystem, TEST_IMAGE_COPIES[0], refNew));
+    TEST_ASSERT_TRUE(&refOld.get() != &refNew.get());
+    TEST_ASSERT_EQUAL_UINT8(1U, cache.getCount());
+
+    /* The outdated bitmap is still valid for its user. */
+    TEST_ASSERT_EQUAL_UINT16(2U, refOld.get().getWidth());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, refOld.get().getColor(0, 0));
+    refOld.release();
+
+    TEST_ASSERT_EQUAL_UINT8(1U, cache.getCount());
+    TEST_ASSERT_EQUAL(TEST_IMAGE_SIZE, cache.getUsage());
+
+    return;
+}
@@ -35,6 +35,7 @@
 #include <unity.h>
 #include <BitmapWidget.h>
 #include <Util.h>
+#include <FS.h>
 
 #include "../common/YAGfxTest.hpp"
 
@@ -55,6 +56,9 @@
  *****************************************************************************/
 
 static void testBitmapWidget();
+static void testBitmapWidgetGifFinished();
+static void testBitmapWidgetGifCorrupt();
+static void paintUntilValid(YAGfx& gfx, BitmapWidget& widget);
 
 /******************************************************************************
  * Local Variables
@@ -90,6 +94,8 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testBitmapWidget);
+    RUN_TEST(testBitmapWidgetGifFinished);
+    RUN_TEST(testBitmapWidgetGifCorrupt);
 
     return UNITY_END();
 }
@@ -191,3 +197,84 @@ static void testBitmapWidget()
 
     return;
 }
+
+/**
+ * Test that a finished GIF animation keeps its last frame and is not
+ * painted anymore.
+ */
+static void testBitmapWidgetGifFinished()
+{
+    YAGfxTest           testGfx;
+    BitmapWidget        bitmapWidget;
+    FS                  localFileSystem;
+    Widget::Area        area;
+
+    /* Animation with 8x6 pixels and 3 frames, without animation loop extension.
+     * It is shown only once.
+     */
+    TEST_ASSERT_TRUE(bitmapWidget.loadGif(localFileSystem, "./test/test_BitmapWidget/once.gif"));
+    TEST_ASSERT_TRUE(bitmapWidget.isInvalid());
+
+    /* The animation runs until the delay of its last frame elapsed. */
+    bitmapWidget.update(testGfx);
+    TEST_ASSERT_TRUE(bitmapWidget.isInvalid());
+
+    paintUntilValid(testGfx, bitmapWidget);
+    TEST_ASSERT_FALSE(bitmapWidget.isInvalid());
+
+    /* It must not be started again, but the last frame is still shown. */
+    bitmapWidget.update(testGfx);
+    TEST_ASSERT_FALSE(bitmapWidget.isInvalid());
+    bitmapWidget.getArea(testGfx, area);
+    TEST_ASSERT_EQUAL_UINT16(8U, area.width);
+    TEST_ASSERT_EQUAL_UINT16(6U, area.height);
+
+    return;
+}
+
+/**
+ * Test that a corrupt GIF animation is stopped and not decoded again.
+ */
+static void testBitmapWidgetGifCorrupt()
+{
+    YAGfxTest           testGfx;
+    BitmapWidget        bitmapWidget;
+    FS                  localFileSystem;
+    Widget::Area        area;
+
+    /* The first frame is complete, the second one is cut off. */
+    TEST_ASSERT_TRUE(bitmapWidget.loadGif(localFileSystem, "./test/test_BitmapWidget/corrupt.gif"));
+    bitmapWidget.update(testGfx);
+    TEST_ASSERT_TRUE(bitmapWidget.isInvalid());
+
+    paintUntilValid(testGfx, bitmapWidget);
+    TEST_ASSERT_FALSE(bitmapWidget.isInvalid());
+
+    /* The decoder is closed, nothing is shown anymore. */
+    bitmapWidget.update(testGfx);
+    TEST_ASSERT_FALSE(bitmapWidget.isInvalid());
+    bitmapWidget.getArea(testGfx, area);
+    TEST_ASSERT_TRUE(area.isEmpty());
+
+    return;
+}
+
+/**
+ * Paint the widget until it is valid, but at most for 2 s.
+ *
+ * @param[in] gfx       Graphics interface
+ * @param[in] widget    Widget to paint
+ */
+static void paintUntilValid(YAGfx& gfx, BitmapWidget& widget)
+{
+    const uint32_t  TIMEOUT     = 2000U; /* ms */
+    uint32_t        timestamp   = millis();
+
+    while((true == widget.isInvalid()) &&
+          (TIMEOUT > (millis() - timestamp)))
+    {
+        widget.update(gfx);
+    }
+
+    return;
+}
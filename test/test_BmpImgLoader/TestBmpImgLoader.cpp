@@ -121,6 +121,8 @@ static void testBmpImgLoader()
 {
     BmpImgLoader        loader;
     YAGfxDynamicBitmap  bitmap;
+    YAGfxPaletteBitmap  paletteBitmap;
+    YAGfxAlphaBitmap    alphaBitmap;
     FS                  localFileSystem;
 
     /* Load test image:
@@ -157,5 +159,53 @@ static void testBmpImgLoader()
     /* Load valid bitmap file. */
     TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/test24bpp.bmp", bitmap));
 
+    /* Load test image as palette bitmap, 4 colors need 2 bpp. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/test24bpp.bmp", paletteBitmap));
+    TEST_ASSERT_EQUAL_UINT8(2, paletteBitmap.getBpp());
+    TEST_ASSERT_EQUAL_UINT16(2, paletteBitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2, paletteBitmap.getHeight());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, paletteBitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff00, paletteBitmap.getColor(1, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xff0000, paletteBitmap.getColor(0, 1));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, paletteBitmap.getColor(1, 1));
+
+    /* Unsupported files are reported the same way. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED, loader.load(localFileSystem, "./test/test_BmpImgLoader/test32bpp.bmp", paletteBitmap));
+    TEST_ASSERT_FALSE(paletteBitmap.isAllocated());
+
+    /* Load test image with alpha channel. Bit fields without alpha mask
+     * result in an opaque bitmap.
+     */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/test32bpp.bmp", alphaBitmap));
+    TEST_ASSERT_EQUAL_UINT16(2, alphaBitmap.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2, alphaBitmap.getHeight());
+    TEST_ASSERT_TRUE(alphaBitmap.isOpaque());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, alphaBitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, alphaBitmap.getColor(1, 1));
+
+    /* Load test image:
+     * 2x2 pixels
+     * (0, 0) blue, opaque
+     * (1, 0) green, transparent
+     * (0, 1) red, alpha 128
+     * (1, 1) white, opaque
+     * 32 bpp, bitfield with alpha mask, V5 header
+     * No color palette
+     */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_BmpImgLoader/test32bppAlpha.bmp", alphaBitmap));
+    TEST_ASSERT_FALSE(alphaBitmap.isOpaque());
+    TEST_ASSERT_TRUE(alphaBitmap.isTranslucent());
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, alphaBitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0x00ff00, alphaBitmap.getColor(1, 0));
+    TEST_ASSERT_EQUAL_UINT32(0xff0000, alphaBitmap.getColor(0, 1));
+    TEST_ASSERT_EQUAL_UINT32(0xffffff, alphaBitmap.getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT8(255U, alphaBitmap.getAlpha(0, 0));
+    TEST_ASSERT_EQUAL_UINT8(0U, alphaBitmap.getAlpha(1, 0));
+    TEST_ASSERT_EQUAL_UINT8(128U, alphaBitmap.getAlpha(0, 1));
+    TEST_ASSERT_EQUAL_UINT8(255U, alphaBitmap.getAlpha(1, 1));
+
+    /* The full color bitmap doesn't support the extended headers. */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_FILE_FORMAT_UNSUPPORTED, loader.load(localFileSystem, "./test/test_BmpImgLoader/test32bppAlpha.bmp", bitmap));
+
     return;
 }
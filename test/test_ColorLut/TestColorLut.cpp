@@ -0,0 +1,214 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test output color lookup tables.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <ColorLut.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testColorLut();
+static void testColorLutDithering();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testColorLut);
+    RUN_TEST(testColorLutDithering);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test color lookup tables.
+ */
+static void testColorLut()
+{
+    ColorLut    lut;
+    Color       color;
+    uint8_t     red     = 0U;
+    uint8_t     green   = 0U;
+    uint8_t     blue    = 0U;
+
+    /* Default: Gamma correction, neutral white balance and full brightness. */
+    TEST_ASSERT_EQUAL_UINT8(255U, lut.getBrightness());
+    lut.getWhiteBalance(red, green, blue);
+    TEST_ASSERT_EQUAL_UINT8(255U, red);
+    TEST_ASSERT_EQUAL_UINT8(255U, green);
+    TEST_ASSERT_EQUAL_UINT8(255U, blue);
+
+    /* Black and white are kept. */
+    TEST_ASSERT_EQUAL_UINT32(0x000000U, static_cast<uint32_t>(lut.apply(ColorDef::BLACK)));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFU, static_cast<uint32_t>(lut.apply(ColorDef::WHITE)));
+
+    /* Mid gray is darkened by the gamma correction: 255 * (128 / 255) ^ 2.2 = 55.7 */
+    color = lut.apply(Color(128U, 128U, 128U));
+    TEST_ASSERT_EQUAL_UINT8(56U, color.getRed());
+    TEST_ASSERT_EQUAL_UINT8(56U, color.getGreen());
+    TEST_ASSERT_EQUAL_UINT8(56U, color.getBlue());
+
+    /* Gamma of 1 means no correction. */
+    lut.setGamma(1.0F);
+    color = lut.apply(Color(0x12U, 0x34U, 0x56U));
+    TEST_ASSERT_EQUAL_UINT32(0x123456U, static_cast<uint32_t>(color));
+
+    /* The color intensity is considered. */
+    color = lut.apply(Color(200U, 100U, 50U, 128U));
+    TEST_ASSERT_EQUAL_UINT8(100U, color.getRed());
+    TEST_ASSERT_EQUAL_UINT8(50U, color.getGreen());
+    TEST_ASSERT_EQUAL_UINT8(25U, color.getBlue());
+
+    /* Brightness scales all base colors. */
+    lut.setBrightness(128U);
+    TEST_ASSERT_EQUAL_UINT8(128U, lut.getBrightness());
+    color = lut.apply(ColorDef::WHITE);
+    TEST_ASSERT_EQUAL_UINT32(0x808080U, static_cast<uint32_t>(color));
+
+    /* White balance scales every base color on its own. */
+    lut.setBrightness(255U);
+    lut.setWhiteBalance(255U, 128U, 0U);
+    color = lut.apply(ColorDef::WHITE);
+    TEST_ASSERT_EQUAL_UINT32(0xFF8000U, static_cast<uint32_t>(color));
+
+    /* Invalid gamma is ignored. */
+    lut.setGamma(0.0F);
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, lut.getGamma());
+
+    return;
+}
+
+/**
+ * Test color lookup tables with temporal dithering.
+ */
+static void testColorLutDithering()
+{
+    const uint8_t       FRAMES      = 4U;
+    ColorLut            lut;
+    ColorLut::Residual  residual;
+    uint8_t             frame       = 0U;
+    uint16_t            sum         = 0U;
+
+    /* A quarter of the lowest value can't be shown without dithering. */
+    lut.setGamma(1.0F);
+    lut.setBrightness(64U);
+    TEST_ASSERT_EQUAL_UINT32(0x000000U, static_cast<uint32_t>(lut.apply(Color(1U, 1U, 1U))));
+
+    /* With dithering one of four frames shows the lowest value. */
+    for(frame = 0U; frame < FRAMES; ++frame)
+    {
+        Color color = lut.apply(Color(1U, 1U, 1U), residual);
+
+        TEST_ASSERT_EQUAL_UINT8(color.getRed(), color.getGreen());
+        TEST_ASSERT_EQUAL_UINT8(color.getRed(), color.getBlue());
+
+        sum += color.getRed();
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(1U, sum);
+
+    /* Values, which can be shown exactly, are not dithered. */
+    residual = ColorLut::Residual();
+    lut.setBrightness(255U);
+
+    for(frame = 0U; frame < FRAMES; ++frame)
+    {
+        TEST_ASSERT_EQUAL_UINT32(0x102030U, static_cast<uint32_t>(lut.apply(Color(0x10U, 0x20U, 0x30U), residual)));
+    }
+
+    return;
+}
@@ -54,6 +54,8 @@
  *****************************************************************************/
 
 static void testGfx();
+static void testPaletteBitmap();
+static void testAlphaBitmap();
 
 /******************************************************************************
  * Local Variables
@@ -89,6 +91,8 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testGfx);
+    RUN_TEST(testPaletteBitmap);
+    RUN_TEST(testAlphaBitmap);
 
     return UNITY_END();
 }
@@ -219,5 +223,324 @@ static void testGfx()
     testGfx.fillScreen(0U);
     TEST_ASSERT_TRUE(testGfx.verify(0, 0, YAGfxTest::WIDTH, YAGfxTest::HEIGHT, 0U));
 
+    /* Test drawing a horizontal span. */
+    {
+        Color span[YAGfxTest::WIDTH];
+
+        for(x = 0; x < YAGfxTest::WIDTH; ++x)
+        {
+            span[x] = x + 1;
+        }
+
+        testGfx.drawHSpan(0, 1, span, YAGfxTest::WIDTH);
+
+        for(x = 0; x < YAGfxTest::WIDTH; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT16(span[x], testGfx.getColor(x, 1));
+        }
+
+        TEST_ASSERT_TRUE(testGfx.verify(0, 0, YAGfxTest::WIDTH, 1U, 0U));
+        TEST_ASSERT_TRUE(testGfx.verify(0, 2, YAGfxTest::WIDTH, YAGfxTest::HEIGHT - 2U, 0U));
+
+        /* Span partly outside on the left side. */
+        bitmap.fillScreen(0U);
+        bitmap.drawHSpan(-2, 1, span, YAGfxTest::WIDTH);
+
+        for(x = 0; x < (YAGfxTest::WIDTH - 2); ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT16(span[x + 2], bitmap.getColor(x, 1));
+        }
+
+        TEST_ASSERT_EQUAL_UINT16(0U, bitmap.getColor(YAGfxTest::WIDTH - 2, 1));
+        TEST_ASSERT_EQUAL_UINT16(0U, bitmap.getColor(YAGfxTest::WIDTH - 1, 1));
+
+        /* Span partly outside on the right side and span outside the canvas. */
+        bitmap.fillScreen(0U);
+        bitmap.drawHSpan(YAGfxTest::WIDTH - 1, 0, span, 3U);
+        bitmap.drawHSpan(0, YAGfxTest::HEIGHT, span, 3U);
+        bitmap.drawHSpan(0, -1, span, 3U);
+        TEST_ASSERT_EQUAL_UINT16(span[0], bitmap.getColor(YAGfxTest::WIDTH - 1, 0));
+        TEST_ASSERT_EQUAL_UINT16(0U, bitmap.getColor(YAGfxTest::WIDTH - 2, 0));
+        TEST_ASSERT_EQUAL_UINT16(0U, bitmap.getColor(0, YAGfxTest::HEIGHT - 1));
+        TEST_ASSERT_EQUAL_UINT16(0U, bitmap.getColor(0, 0));
+    }
+
+    /* Clear screen */
+    testGfx.fillScreen(0U);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, YAGfxTest::WIDTH, YAGfxTest::HEIGHT, 0U));
+
+    return;
+}
+
+/**
+ * Test the bitmap with indexed colors.
+ */
+static void testPaletteBitmap()
+{
+    YAGfxTest           testGfx;
+    YAGfxDynamicBitmap  fullColorBitmap;
+    YAGfxPaletteBitmap  bitmap;
+    const Color         COLORS[]    = { 0x000000, 0xff0000, 0x00ff00, 0x0000ff, 0xffffff };
+    const uint16_t      WIDTH       = 11U;
+    const uint16_t      HEIGHT      = 3U;
+    int16_t             x           = 0;
+    int16_t             y           = 0;
+
+    /* Number of bits per pixel by colors. */
+    TEST_ASSERT_EQUAL_UINT8(1U, YAGfxPaletteBitmap::getBppByColors(1U));
+    TEST_ASSERT_EQUAL_UINT8(1U, YAGfxPaletteBitmap::getBppByColors(2U));
+    TEST_ASSERT_EQUAL_UINT8(2U, YAGfxPaletteBitmap::getBppByColors(3U));
+    TEST_ASSERT_EQUAL_UINT8(4U, YAGfxPaletteBitmap::getBppByColors(16U));
+    TEST_ASSERT_EQUAL_UINT8(8U, YAGfxPaletteBitmap::getBppByColors(17U));
+    TEST_ASSERT_EQUAL_UINT8(8U, YAGfxPaletteBitmap::getBppByColors(256U));
+    TEST_ASSERT_EQUAL_UINT8(0U, YAGfxPaletteBitmap::getBppByColors(257U));
+
+    /* Only 1, 2, 4 and 8 bits per pixel are supported. */
+    TEST_ASSERT_FALSE(bitmap.isAllocated());
+    TEST_ASSERT_FALSE(bitmap.create(WIDTH, HEIGHT, 3U));
+    TEST_ASSERT_FALSE(bitmap.create(0U, HEIGHT, 1U));
+
+    /* Every pixel is accessed with every supported bits per pixel.
+     * The width isn't a multiple of the pixels per byte by intention.
+     */
+    for(uint8_t bpp = 1U; bpp <= 8U; bpp *= 2U)
+    {
+        uint16_t paletteSize = 1U << bpp;
+
+        bitmap.release();
+        TEST_ASSERT_TRUE(bitmap.create(WIDTH, HEIGHT, bpp));
+        TEST_ASSERT_EQUAL_UINT8(bpp, bitmap.getBpp());
+        TEST_ASSERT_EQUAL_UINT16(paletteSize, bitmap.getPaletteSize());
+        TEST_ASSERT_EQUAL_UINT16(WIDTH, bitmap.getWidth());
+        TEST_ASSERT_EQUAL_UINT16(HEIGHT, bitmap.getHeight());
+
+        for(y = 0; y < HEIGHT; ++y)
+        {
+            for(x = 0; x < WIDTH; ++x)
+            {
+                bitmap.setIndex(x, y, (x + y) % paletteSize);
+            }
+        }
+
+        for(y = 0; y < HEIGHT; ++y)
+        {
+            for(x = 0; x < WIDTH; ++x)
+            {
+                TEST_ASSERT_EQUAL_UINT8((x + y) % paletteSize, bitmap.getIndex(x, y));
+            }
+        }
+
+        /* Out of bounds is ignored. */
+        bitmap.setIndex(WIDTH, 0, 1U);
+        TEST_ASSERT_EQUAL_UINT8(0U, bitmap.getIndex(WIDTH, 0));
+        TEST_ASSERT_EQUAL_UINT8(0U, bitmap.getIndex(-1, 0));
+    }
+
+    /* Convert a bitmap with full colors. */
+    TEST_ASSERT_TRUE(fullColorBitmap.create(WIDTH, HEIGHT));
+
+    for(y = 0; y < HEIGHT; ++y)
+    {
+        for(x = 0; x < WIDTH; ++x)
+        {
+            fullColorBitmap.drawPixel(x, y, COLORS[(x * y) % UTIL_ARRAY_NUM(COLORS)]);
+        }
+    }
+
+    TEST_ASSERT_TRUE(bitmap.convert(fullColorBitmap));
+    TEST_ASSERT_EQUAL_UINT8(4U, bitmap.getBpp());
+    TEST_ASSERT_TRUE(bitmap.getMemorySize() < (WIDTH * HEIGHT * sizeof(Color)));
+
+    for(y = 0; y < HEIGHT; ++y)
+    {
+        for(x = 0; x < WIDTH; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(fullColorBitmap.getColor(x, y), bitmap.getColor(x, y));
+        }
+    }
+
+    /* Only palette colors can be drawn. */
+    bitmap.drawPixel(0, 0, COLORS[4]);
+    TEST_ASSERT_EQUAL_UINT32(COLORS[4], bitmap.getColor(0, 0));
+    bitmap.drawPixel(0, 0, Color(0x123456));
+    TEST_ASSERT_EQUAL_UINT32(COLORS[4], bitmap.getColor(0, 0));
+    bitmap.drawPixel(0, 0, COLORS[0]);
+    TEST_ASSERT_EQUAL_UINT32(COLORS[0], bitmap.getColor(0, 0));
+
+    /* Changing the palette changes all pixels with this index. */
+    bitmap.setPaletteColor(bitmap.getIndex(0, 0), Color(0x123456));
+    TEST_ASSERT_EQUAL_UINT32(0x123456, bitmap.getColor(0, 0));
+    TEST_ASSERT_EQUAL_UINT32(0x123456, bitmap.getColor(0, 1));
+    bitmap.setPaletteColor(bitmap.getIndex(0, 0), COLORS[0]);
+
+    /* Copy */
+    {
+        YAGfxPaletteBitmap copy(bitmap);
+
+        TEST_ASSERT_EQUAL_UINT8(bitmap.getBpp(), copy.getBpp());
+
+        for(y = 0; y < HEIGHT; ++y)
+        {
+            for(x = 0; x < WIDTH; ++x)
+            {
+                TEST_ASSERT_EQUAL_UINT32(bitmap.getColor(x, y), copy.getColor(x, y));
+            }
+        }
+    }
+
+    /* Draw it, which expands the palette directly. */
+    testGfx.fillScreen(0x0000ffU);
+    testGfx.drawBitmap(1, 2, bitmap);
+    TEST_ASSERT_EQUAL_UINT32(0x0000ff, testGfx.getColor(0, 0));
+
+    for(y = 0; y < HEIGHT; ++y)
+    {
+        for(x = 0; x < WIDTH; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(fullColorBitmap.getColor(x, y), testGfx.getColor(x + 1, y + 2));
+        }
+    }
+
+    /* Too many colors. */
+    fullColorBitmap.release();
+    TEST_ASSERT_TRUE(fullColorBitmap.create(17U, 16U));
+
+    for(y = 0; y < 16; ++y)
+    {
+        for(x = 0; x < 17; ++x)
+        {
+            fullColorBitmap.drawPixel(x, y, Color(x * 17 + y));
+        }
+    }
+
+    TEST_ASSERT_FALSE(bitmap.convert(fullColorBitmap));
+    TEST_ASSERT_FALSE(bitmap.isAllocated());
+
+    return;
+}
+
+/**
+ * Test the bitmap with alpha channel and the palette bitmap with color key.
+ */
+static void testAlphaBitmap()
+{
+    YAGfxTest           testGfx;
+    YAGfxAlphaBitmap    bitmap;
+    YAGfxPaletteBitmap  paletteBitmap;
+    const Color         BACKGROUND  = 0x0000ff;
+    const Color         FOREGROUND  = 0xff0000;
+    const uint16_t      WIDTH       = 5U;
+    const uint16_t      HEIGHT      = 2U;
+    int16_t             x           = 0;
+    int16_t             y           = 0;
+    Color               color;
+
+    /* Fixed-point blending. */
+    color = BACKGROUND;
+    color.blend(FOREGROUND, 0U);
+    TEST_ASSERT_EQUAL_UINT32(BACKGROUND, color);
+    color.blend(FOREGROUND, 255U);
+    TEST_ASSERT_EQUAL_UINT32(FOREGROUND, color);
+    color = BACKGROUND;
+    color.blend(FOREGROUND, 128U);
+    TEST_ASSERT_EQUAL_UINT32(0x80007f, color);
+
+    /* A new bitmap is opaque and has no alpha mask. */
+    TEST_ASSERT_TRUE(bitmap.create(WIDTH, HEIGHT));
+    TEST_ASSERT_TRUE(bitmap.isOpaque());
+    TEST_ASSERT_FALSE(bitmap.isTranslucent());
+    TEST_ASSERT_EQUAL(WIDTH * HEIGHT * sizeof(Color), bitmap.getMemorySize());
+    TEST_ASSERT_EQUAL_UINT8(YAGfxAlphaBitmap::ALPHA_OPAQUE, bitmap.getAlpha(0, 0));
+    TEST_ASSERT_EQUAL_UINT8(YAGfxAlphaBitmap::ALPHA_TRANSPARENT, bitmap.getAlpha(WIDTH, 0));
+
+    bitmap.fillScreen(FOREGROUND);
+
+    /* Opaque pixels don't allocate the alpha mask. */
+    bitmap.setAlpha(0, 0, YAGfxAlphaBitmap::ALPHA_OPAQUE);
+    TEST_ASSERT_EQUAL(WIDTH * HEIGHT * sizeof(Color), bitmap.getMemorySize());
+
+    /* Row 0: transparent, opaque, opaque, partial, opaque
+     * Row 1: opaque
+     */
+    bitmap.setAlpha(0, 0, YAGfxAlphaBitmap::ALPHA_TRANSPARENT);
+    TEST_ASSERT_FALSE(bitmap.isOpaque());
+    TEST_ASSERT_FALSE(bitmap.isTranslucent());
+    TEST_ASSERT_EQUAL(WIDTH * HEIGHT * (sizeof(Color) + 1U), bitmap.getMemorySize());
+    bitmap.setAlpha(3, 0, 128U);
+    TEST_ASSERT_TRUE(bitmap.isTranslucent());
+    TEST_ASSERT_EQUAL_UINT8(128U, bitmap.getAlpha(3, 0));
+
+    testGfx.fillScreen(BACKGROUND);
+    testGfx.drawBitmap(1, 1, bitmap);
+    TEST_ASSERT_EQUAL_UINT32(BACKGROUND, testGfx.getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT32(FOREGROUND, testGfx.getColor(2, 1));
+    TEST_ASSERT_EQUAL_UINT32(FOREGROUND, testGfx.getColor(3, 1));
+    TEST_ASSERT_EQUAL_UINT32(0x80007f, testGfx.getColor(4, 1));
+    TEST_ASSERT_EQUAL_UINT32(FOREGROUND, testGfx.getColor(5, 1));
+    TEST_ASSERT_EQUAL_UINT32(BACKGROUND, testGfx.getColor(6, 1));
+
+    for(x = 0; x < WIDTH; ++x)
+    {
+        TEST_ASSERT_EQUAL_UINT32(FOREGROUND, testGfx.getColor(x + 1, 2));
+    }
+
+    /* Copy */
+    {
+        YAGfxAlphaBitmap copy(bitmap);
+
+        TEST_ASSERT_TRUE(copy.isTranslucent());
+
+        for(y = 0; y < HEIGHT; ++y)
+        {
+            for(x = 0; x < WIDTH; ++x)
+            {
+                TEST_ASSERT_EQUAL_UINT8(bitmap.getAlpha(x, y), copy.getAlpha(x, y));
+            }
+        }
+    }
+
+    /* Partial transparent pixels can't be converted to a palette bitmap. */
+    TEST_ASSERT_FALSE(paletteBitmap.convert(bitmap));
+
+    /* Transparent pixels are converted to a color key. */
+    bitmap.setAlpha(3, 0, YAGfxAlphaBitmap::ALPHA_TRANSPARENT);
+    TEST_ASSERT_FALSE(bitmap.isTranslucent());
+    TEST_ASSERT_TRUE(paletteBitmap.convert(bitmap));
+    TEST_ASSERT_TRUE(paletteBitmap.hasTransparentIndex());
+    TEST_ASSERT_EQUAL_UINT8(1U, paletteBitmap.getBpp());
+    TEST_ASSERT_EQUAL_UINT8(paletteBitmap.getTransparentIndex(), paletteBitmap.getIndex(0, 0));
+    TEST_ASSERT_EQUAL_UINT8(paletteBitmap.getTransparentIndex(), paletteBitmap.getIndex(3, 0));
+
+    testGfx.fillScreen(BACKGROUND);
+    testGfx.drawBitmap(1, 1, paletteBitmap);
+
+    for(y = 0; y < HEIGHT; ++y)
+    {
+        for(x = 0; x < WIDTH; ++x)
+        {
+            if (YAGfxAlphaBitmap::ALPHA_TRANSPARENT == bitmap.getAlpha(x, y))
+            {
+                TEST_ASSERT_EQUAL_UINT32(BACKGROUND, testGfx.getColor(x + 1, y + 1));
+            }
+            else
+            {
+                TEST_ASSERT_EQUAL_UINT32(FOREGROUND, testGfx.getColor(x + 1, y + 1));
+            }
+        }
+    }
+
+    /* Without color key all pixels are drawn. */
+    paletteBitmap.clearTransparentIndex();
+    TEST_ASSERT_FALSE(paletteBitmap.hasTransparentIndex());
+    testGfx.fillScreen(BACKGROUND);
+    testGfx.drawBitmap(1, 1, paletteBitmap);
+    TEST_ASSERT_EQUAL_UINT32(paletteBitmap.getColor(0, 0), testGfx.getColor(1, 1));
+    TEST_ASSERT_EQUAL_UINT32(FOREGROUND, testGfx.getColor(2, 1));
+
+    /* Releasing makes the bitmap opaque again. */
+    bitmap.release();
+    TEST_ASSERT_TRUE(bitmap.isOpaque());
+    TEST_ASSERT_EQUAL(0U, bitmap.getMemorySize());
+
     return;
 }
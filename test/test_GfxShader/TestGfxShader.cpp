@@ -0,0 +1,318 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Procedural shader engine tests.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <Util.h>
+#include <YAGfxShader.h>
+
+#include "../common/YAGfxTest.hpp"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Stateless kernel, which shades a gradient moving with the time.
+ */
+class GradientKernel : public YAGfxPixelKernel<YAGfxShaderNoState, GradientKernel>
+{
+public:
+
+    /**
+     * Shade a single pixel.
+     *
+     * @param[in]   x       x-coordinate
+     * @param[in]   y       y-coordinate
+     * @param[in]   t       Fixed point time
+     * @param[in]   prev    State of the previous frame
+     * @param[out]  next    State in the next frame
+     *
+     * @return Color
+     */
+    Color shade(int16_t x, int16_t y, uint32_t t, const YAGfxShaderStateView<YAGfxShaderNoState>& prev, YAGfxShaderNoState& next)
+    {
+        UTIL_NOT_USED(prev);
+        UTIL_NOT_USED(next);
+
+        return Color(x, y, t >> YAGfxShader<GradientKernel>::TIME_FRAC_BITS);
+    }
+};
+
+/**
+ * Stateful kernel, which moves every pixel one row down per frame.
+ * The first row is taken from the spawn color.
+ */
+class FallKernel : public YAGfxPixelKernel<uint8_t, FallKernel>
+{
+public:
+
+    /**
+     * Constructs the kernel.
+     */
+    FallKernel() :
+        m_spawn(0U)
+    {
+    }
+
+    /**
+     * Shade a single pixel.
+     *
+     * @param[in]   x       x-coordinate
+     * @param[in]   y       y-coordinate
+     * @param[in]   t       Fixed point time
+     * @param[in]   prev    State of the previous frame
+     * @param[out]  next    State in the next frame
+     *
+     * @return Color
+     */
+    Color shade(int16_t x, int16_t y, uint32_t t, const YAGfxShaderStateView<uint8_t>& prev, uint8_t& next)
+    {
+        UTIL_NOT_USED(t);
+
+        if (0 == y)
+        {
+            next = m_spawn;
+        }
+        else
+        {
+            next = prev.get(x, y - 1);
+        }
+
+        return Color(next, 0U, 0U);
+    }
+
+    uint8_t m_spawn;    /**< Value for the first row */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testShaderStateView();
+static void testShaderStateless();
+static void testShaderStateful();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testShaderStateView);
+    RUN_TEST(testShaderStateless);
+    RUN_TEST(testShaderStateful);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the state view, especially the clamping at the borders.
+ */
+static void testShaderStateView()
+{
+    const uint8_t                   STATES[] =
+    {
+        1U, 2U, 3U,
+        4U, 5U, 6U
+    };
+    YAGfxShaderStateView<uint8_t>   view(STATES, 3U, 2U, 3U);
+
+    TEST_ASSERT_EQUAL_UINT16(3U, view.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(2U, view.getHeight());
+
+    TEST_ASSERT_EQUAL_UINT8(1U, view.get(0, 0));
+    TEST_ASSERT_EQUAL_UINT8(6U, view.get(2, 1));
+    TEST_ASSERT_EQUAL_UINT8(1U, view.get(-1, -1));
+    TEST_ASSERT_EQUAL_UINT8(3U, view.get(3, 0));
+    TEST_ASSERT_EQUAL_UINT8(4U, view.get(0, 2));
+    TEST_ASSERT_EQUAL_UINT8(6U, view.get(100, 100));
+    TEST_ASSERT_EQUAL_PTR(&STATES[3], view.getRow(1));
+
+    return;
+}
+
+/**
+ * Test the engine with a stateless kernel.
+ */
+static void testShaderStateless()
+{
+    YAGfxTest                   testGfx;
+    YAGfxShader<GradientKernel> shader;
+    int16_t                     x       = 0;
+    int16_t                     y       = 0;
+
+    /* Nothing is rendered without buffers. */
+    TEST_ASSERT_FALSE(shader.isCreated());
+    testGfx.fillScreen(ColorDef::WHITE);
+    shader.render(testGfx);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, YAGfxTest::WIDTH, YAGfxTest::HEIGHT, ColorDef::WHITE));
+
+    TEST_ASSERT_FALSE(shader.create(0U, YAGfxTest::HEIGHT));
+    TEST_ASSERT_TRUE(shader.create(YAGfxTest::WIDTH, YAGfxTest::HEIGHT));
+    TEST_ASSERT_TRUE(shader.isCreated());
+    TEST_ASSERT_NULL(shader.getState(0U, 0U));
+
+    /* Time advances in fixed point units. */
+    TEST_ASSERT_EQUAL_UINT32(0U, shader.getTime());
+    shader.advance();
+    shader.advance(YAGfxShader<GradientKernel>::TIME_ONE / 2U);
+    TEST_ASSERT_EQUAL_UINT32(YAGfxShader<GradientKernel>::TIME_ONE * 3U / 2U, shader.getTime());
+
+    shader.render(testGfx);
+
+    for(y = 0; y < YAGfxTest::HEIGHT; ++y)
+    {
+        for(x = 0; x < YAGfxTest::WIDTH; ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(x, y, 1U)), static_cast<uint32_t>(testGfx.getColor(x, y)));
+        }
+    }
+
+    shader.reset();
+    TEST_ASSERT_EQUAL_UINT32(0U, shader.getTime());
+
+    shader.release();
+    TEST_ASSERT_FALSE(shader.isCreated());
+
+    return;
+}
+
+/**
+ * Test the engine with a stateful kernel, which needs the previous frame.
+ */
+static void testShaderStateful()
+{
+    YAGfxTest               testGfx;
+    YAGfxShader<FallKernel> shader;
+    uint8_t*                state   = nullptr;
+    int16_t                 y       = 0;
+
+    TEST_ASSERT_TRUE(shader.create(YAGfxTest::WIDTH, YAGfxTest::HEIGHT));
+    TEST_ASSERT_NULL(shader.getState(YAGfxTest::WIDTH, 0U));
+    TEST_ASSERT_NULL(shader.getState(0U, YAGfxTest::HEIGHT));
+
+    /* Initial state is default constructed. */
+    state = shader.getState(1U, 0U);
+    TEST_ASSERT_NOT_NULL(state);
+    TEST_ASSERT_EQUAL_UINT8(0U, *state);
+
+    /* The spawn value moves one row down per frame. */
+    shader.getKernel().m_spawn = 10U;
+    shader.render(testGfx);
+    shader.getKernel().m_spawn = 20U;
+    shader.render(testGfx);
+    shader.getKernel().m_spawn = 30U;
+    shader.render(testGfx);
+
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(30U, 0U, 0U)), static_cast<uint32_t>(testGfx.getColor(0, 0)));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(20U, 0U, 0U)), static_cast<uint32_t>(testGfx.getColor(0, 1)));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(10U, 0U, 0U)), static_cast<uint32_t>(testGfx.getColor(0, 2)));
+
+    for(y = 3; y < YAGfxTest::HEIGHT; ++y)
+    {
+        TEST_ASSERT_EQUAL_UINT32(0U, static_cast<uint32_t>(testGfx.getColor(0, y)));
+    }
+
+    /* Injected states are considered by the next frame. */
+    state = shader.getState(1U, 2U);
+    TEST_ASSERT_NOT_NULL(state);
+    TEST_ASSERT_EQUAL_UINT8(10U, *state);
+    *state = 99U;
+    shader.render(testGfx);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(99U, 0U, 0U)), static_cast<uint32_t>(testGfx.getColor(1, 3)));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(Color(10U, 0U, 0U)), static_cast<uint32_t>(testGfx.getColor(0, 3)));
+
+    /* Reset clears the states. */
+    shader.reset();
+    state = shader.getState(1U, 3U);
+    TEST_ASSERT_NOT_NULL(state);
+    TEST_ASSERT_EQUAL_UINT8(0U, *state);
+
+    return;
+}
@@ -0,0 +1,274 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  GIF decoder tests.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <FS.h>
+#include <GifDecoder.h>
+#include <BmpImgLoader.h>
+#include <YAGfxBitmap.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void checkFrame(FS& fs, const GifDecoder& decoder, const char* refFileName);
+
+static void testGifDecoderInvalid();
+static void testGifDecoderAnimation();
+static void testGifDecoderLzwTableFull();
+static void testGifDecoderCopy();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testGifDecoderInvalid);
+    RUN_TEST(testGifDecoderAnimation);
+    RUN_TEST(testGifDecoderLzwTableFull);
+    RUN_TEST(testGifDecoderCopy);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Check the current frame of the decoder against a reference bitmap.
+ *
+ * @param[in] fs            Filesystem
+ * @param[in] decoder       GIF decoder
+ * @param[in] refFileName   Name of the reference bitmap file
+ */
+static void checkFrame(FS& fs, const GifDecoder& decoder, const char* refFileName)
+{
+    BmpImgLoader        loader;
+    YAGfxDynamicBitmap  refBitmap;
+    const YAGfxBitmap&  frame       = decoder.getFrame();
+    int16_t             y           = 0;
+
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(fs, refFileName, refBitmap));
+    TEST_ASSERT_EQUAL_UINT16(refBitmap.getWidth(), frame.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(refBitmap.getHeight(), frame.getHeight());
+
+    for(y = 0; y < refBitmap.getHeight(); ++y)
+    {
+        int16_t x = 0;
+
+        for(x = 0; x < refBitmap.getWidth(); ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(refBitmap.getColor(x, y)), static_cast<uint32_t>(frame.getColor(x, y)));
+        }
+    }
+
+    return;
+}
+
+/**
+ * Test invalid and unsupported files.
+ */
+static void testGifDecoderInvalid()
+{
+    GifDecoder  decoder;
+    FS          localFileSystem;
+
+    TEST_ASSERT_FALSE(decoder.isOpen());
+    TEST_ASSERT_EQUAL(GifDecoder::RET_FILE_NOT_FOUND, decoder.next());
+
+    TEST_ASSERT_EQUAL(GifDecoder::RET_FILE_NOT_FOUND, decoder.open(localFileSystem, "./test/test_GifDecoder/notExisting.gif"));
+    TEST_ASSERT_FALSE(decoder.isOpen());
+
+    /* A bitmap image is not a GIF image. */
+    TEST_ASSERT_EQUAL(GifDecoder::RET_FILE_FORMAT_UNSUPPORTED, decoder.open(localFileSystem, "./test/test_GifDecoder/animation0.bmp"));
+    TEST_ASSERT_FALSE(decoder.isOpen());
+    TEST_ASSERT_EQUAL_UINT16(0U, decoder.getFrame().getWidth());
+    TEST_ASSERT_EQUAL_UINT16(0U, decoder.getFrame().getHeight());
+
+    return;
+}
+
+/**
+ * Test an animation with 8x6 pixels and 3 frames, which repeats infinite.
+ * Frame 0: Whole canvas, 100 ms, leave in place
+ * Frame 1: Local color table, transparency, 200 ms, restore to background
+ * Frame 2: Interlaced, small data sub-blocks, no delay, restore to previous
+ */
+static void testGifDecoderAnimation()
+{
+    GifDecoder  decoder;
+    FS          localFileSystem;
+    uint8_t     loop            = 0U;
+
+    TEST_ASSERT_EQUAL(GifDecoder::RET_OK, decoder.open(localFileSystem, "./test/test_GifDecoder/animation.gif"));
+    TEST_ASSERT_TRUE(decoder.isOpen());
+
+    /* The second loop must result in the same frames. */
+    for(loop = 0U; loop < 2U; ++loop)
+    {
+        if (0U < loop)
+        {
+            TEST_ASSERT_EQUAL(GifDecoder::RET_OK, decoder.next());
+        }
+
+        TEST_ASSERT_FALSE(decoder.isFinished());
+        TEST_ASSERT_EQUAL_UINT32(100U, decoder.getDelay());
+        checkFrame(localFileSystem, decoder, "./test/test_GifDecoder/animation0.bmp");
+
+        TEST_ASSERT_EQUAL(GifDecoder::RET_OK, decoder.next());
+        TEST_ASSERT_EQUAL_UINT32(200U, decoder.getDelay());
+        checkFrame(localFileSystem, decoder, "./test/test_GifDecoder/animation1.bmp");
+
+        TEST_ASSERT_EQUAL(GifDecoder::RET_OK, decoder.next());
+        TEST_ASSERT_EQUAL_UINT32(GifDecoder::DEFAULT_DELAY, decoder.getDelay());
+        checkFrame(localFileSystem, decoder, "./test/test_GifDecoder/animation2.bmp");
+    }
+
+    decoder.close();
+    TEST_ASSERT_FALSE(decoder.isOpen());
+
+    return;
+}
+
+/**
+ * Test a single frame with 64x64 pixels and 256 colors. The LZW table
+ * runs full and the encoder sends clear codes in between.
+ */
+static void testGifDecoderLzwTableFull()
+{
+    GifDecoder  decoder;
+    FS          localFileSystem;
+
+    TEST_ASSERT_EQUAL(GifDecoder::RET_OK, decoder.open(localFileSystem, "./test/test_GifDecoder/noise.gif"));
+    checkFrame(localFileSystem, decoder, "./test/test_GifDecoder/noise.bmp");
+
+    /* Without animation loop extension, the image is shown once and the
+     * last frame stays.
+     */
+    TEST_ASSERT_FALSE(decoder.isFinished());
+    TEST_ASSERT_EQUAL(GifDecoder::RET_OK, decoder.next());
+    TEST_ASSERT_TRUE(decoder.isFinished());
+    checkFrame(localFileSystem, decoder, "./test/test_GifDecoder/noise.bmp");
+
+    return;
+}
+
+/**
+ * Test copying a decoder, which opens the same file again.
+ */
+static void testGifDecoderCopy()
+{
+    GifDecoder  decoder;
+    FS          localFileSystem;
+
+    TEST_ASSERT_EQUAL(GifDecoder::RET_OK, decoder.open(localFileSystem, "./test/test_GifDecoder/animation.gif"));
+    TEST_ASSERT_EQUAL(GifDecoder::RET_OK, decoder.next());
+
+    {
+        GifDecoder copy(decoder);
+
+        TEST_ASSERT_TRUE(copy.isOpen());
+        checkFrame(localFileSystem, copy, "./test/test_GifDecoder/animation0.bmp");
+
+        copy = GifDecoder();
+        TEST_ASSERT_FALSE(copy.isOpen());
+
+        copy = decoder;
+        TEST_ASSERT_EQUAL(GifDecoder::RET_OK, copy.next());
+        checkFrame(localFileSystem, copy, "./test/test_GifDecoder/animation1.bmp");
+    }
+
+    /* The original decoder is not affected. */
+    checkFrame(localFileSystem, decoder, "./test/test_GifDecoder/animation1.bmp");
+
+    return;
+}
@@ -0,0 +1,352 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test game of life grid.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <LifeGrid.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testLifeGrid();
+static void testLifeGridRules();
+
+static void stepReference(const LifeGrid& grid, bool* cells);
+static bool isEqual(const LifeGrid& grid, const bool* cells);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testLifeGrid);
+    RUN_TEST(testLifeGridRules);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test game of life grid handling and cycle detection.
+ */
+static void testLifeGrid()
+{
+    LifeGrid    grid;
+    uint8_t     idx     = 0U;
+
+    /* Invalid size */
+    TEST_ASSERT_FALSE(grid.create(0U, 8U));
+    TEST_ASSERT_FALSE(grid.isAllocated());
+    TEST_ASSERT_NULL(grid.getRow(0U));
+
+    TEST_ASSERT_TRUE(grid.create(40U, 8U));
+    TEST_ASSERT_TRUE(grid.isAllocated());
+    TEST_ASSERT_EQUAL_UINT16(40U, grid.getWidth());
+    TEST_ASSERT_EQUAL_UINT16(8U, grid.getHeight());
+
+    /* Cells outside the grid are dead and can't be set. */
+    grid.setCell(40U, 0U, true);
+    grid.setCell(0U, 8U, true);
+    TEST_ASSERT_FALSE(grid.getCell(40U, 0U));
+    TEST_ASSERT_FALSE(grid.getCell(0U, 8U));
+
+    /* Block is a still life. */
+    grid.setCell(10U, 3U, true);
+    grid.setCell(11U, 3U, true);
+    grid.setCell(10U, 4U, true);
+    grid.setCell(11U, 4U, true);
+    TEST_ASSERT_TRUE(grid.getCell(11U, 4U));
+    TEST_ASSERT_EQUAL_UINT32(0x00000c00U, grid.getRow(3U)[0U]);
+    grid.step();
+    TEST_ASSERT_EQUAL_UINT32(1U, grid.getGeneration());
+    TEST_ASSERT_EQUAL_UINT8(1U, grid.getPeriod());
+
+    /* Blinker across the word border is an oscillator with period 2. */
+    grid.clear();
+    TEST_ASSERT_EQUAL_UINT32(0U, grid.getGeneration());
+    grid.setCell(31U, 2U, true);
+    grid.setCell(32U, 2U, true);
+    grid.setCell(33U, 2U, true);
+    grid.step();
+    TEST_ASSERT_EQUAL_UINT8(0U, grid.getPeriod());
+    TEST_ASSERT_TRUE(grid.getCell(32U, 1U));
+    TEST_ASSERT_TRUE(grid.getCell(32U, 2U));
+    TEST_ASSERT_TRUE(grid.getCell(32U, 3U));
+    TEST_ASSERT_FALSE(grid.getCell(31U, 2U));
+    TEST_ASSERT_FALSE(grid.getCell(33U, 2U));
+    grid.step();
+    TEST_ASSERT_EQUAL_UINT8(2U, grid.getPeriod());
+
+    /* Blinker wraps around at the left and right border. */
+    grid.clear();
+    grid.setCell(39U, 5U, true);
+    grid.setCell(0U, 5U, true);
+    grid.setCell(1U, 5U, true);
+    grid.step();
+    TEST_ASSERT_TRUE(grid.getCell(0U, 4U));
+    TEST_ASSERT_TRUE(grid.getCell(0U, 5U));
+    TEST_ASSERT_TRUE(grid.getCell(0U, 6U));
+    TEST_ASSERT_FALSE(grid.getCell(39U, 5U));
+    TEST_ASSERT_FALSE(grid.getCell(1U, 5U));
+
+    /* Blinker wraps around at the top and bottom border. */
+    grid.step();
+    grid.step();
+    TEST_ASSERT_EQUAL_UINT8(2U, grid.getPeriod());
+    grid.clear();
+    grid.setCell(20U, 7U, true);
+    grid.setCell(20U, 0U, true);
+    grid.setCell(20U, 1U, true);
+    grid.step();
+    TEST_ASSERT_TRUE(grid.getCell(19U, 0U));
+    TEST_ASSERT_TRUE(grid.getCell(20U, 0U));
+    TEST_ASSERT_TRUE(grid.getCell(21U, 0U));
+    TEST_ASSERT_FALSE(grid.getCell(20U, 7U));
+
+    /* Extinct grid is stable. */
+    grid.clear();
+    grid.setCell(5U, 5U, true);
+    grid.step();
+    TEST_ASSERT_EQUAL_UINT8(0U, grid.getPeriod());
+    grid.step();
+    TEST_ASSERT_EQUAL_UINT8(1U, grid.getPeriod());
+
+    /* A glider is no cycle within the history. */
+    grid.clear();
+    grid.setCell(1U, 0U, true);
+    grid.setCell(2U, 1U, true);
+    grid.setCell(0U, 2U, true);
+    grid.setCell(1U, 2U, true);
+    grid.setCell(2U, 2U, true);
+
+    for(idx = 0U; idx < LifeGrid::HISTORY_SIZE; ++idx)
+    {
+        grid.step();
+        TEST_ASSERT_EQUAL_UINT8(0U, grid.getPeriod());
+    }
+
+    grid.destroy();
+    TEST_ASSERT_FALSE(grid.isAllocated());
+
+    return;
+}
+
+/**
+ * Test the word parallel generation step against a cell by cell reference.
+ */
+static void testLifeGridRules()
+{
+    const uint16_t SIZES[][2] =
+    {
+        { 64U, 32U },
+        { 32U, 8U },
+        { 37U, 5U },
+        { 95U, 3U },
+        { 1U, 1U },
+        { 3U, 2U }
+    };
+    const uint32_t  GENERATIONS = 50U;
+    uint8_t         sizeIdx     = 0U;
+
+    for(sizeIdx = 0U; sizeIdx < UTIL_ARRAY_NUM(SIZES); ++sizeIdx)
+    {
+        LifeGrid    grid;
+        uint16_t    width       = SIZES[sizeIdx][0];
+        uint16_t    height      = SIZES[sizeIdx][1];
+        bool*       cells       = new bool[width * height];
+        uint32_t    generation  = 0U;
+        uint16_t    x           = 0U;
+        uint16_t    y           = 0U;
+
+        TEST_ASSERT_TRUE(grid.create(width, height));
+        grid.randomize(sizeIdx + 1U);
+
+        for(y = 0U; y < height; ++y)
+        {
+            for(x = 0U; x < width; ++x)
+            {
+                cells[x + y * width] = grid.getCell(x, y);
+            }
+        }
+
+        for(generation = 0U; generation < GENERATIONS; ++generation)
+        {
+            grid.step();
+            stepReference(grid, cells);
+            TEST_ASSERT_TRUE(isEqual(grid, cells));
+        }
+
+        delete[] cells;
+    }
+
+    return;
+}
+
+/**
+ * Calculate the next generation cell by cell, like the plugin did before.
+ *
+ * @param[in]       grid    Grid, only used for its size.
+ * @param[in,out]   cells   Cells, row by row.
+ */
+static void stepReference(const LifeGrid& grid, bool* cells)
+{
+    uint16_t    width   = grid.getWidth();
+    uint16_t    height  = grid.getHeight();
+    bool*       next    = new bool[width * height];
+    int32_t     x       = 0;
+    int32_t     y       = 0;
+
+    for(y = 0; y < height; ++y)
+    {
+        for(x = 0; x < width; ++x)
+        {
+            uint8_t count   = 0U;
+            int32_t dX      = 0;
+            int32_t dY      = 0;
+            bool    isAlive = cells[x + y * width];
+
+            for(dY = -1; dY <= 1; ++dY)
+            {
+                for(dX = -1; dX <= 1; ++dX)
+                {
+                    if ((0 != dX) || (0 != dY))
+                    {
+                        int32_t nX = (x + dX + width) % width;
+                        int32_t nY = (y + dY + height) % height;
+
+                        if (true == cells[nX + nY * width])
+                        {
+                            ++count;
+                        }
+                    }
+                }
+            }
+
+            next[x + y * width] = (3U == count) || ((true == isAlive) && (2U == count));
+        }
+    }
+
+    memcpy(cells, next, width * height * sizeof(bool));
+    delete[] next;
+
+    return;
+}
+
+/**
+ * Compare the grid with the reference cells.
+ *
+ * @param[in] grid  Grid
+ * @param[in] cells Reference cells, row by row.
+ *
+ * @return If equal, it will return true otherwise false.
+ */
+static bool isEqual(const LifeGrid& grid, const bool* cells)
+{
+    bool        isSame  = true;
+    uint16_t    x       = 0U;
+    uint16_t    y       = 0U;
+
+    for(y = 0U; (y < grid.getHeight()) && (true == isSame); ++y)
+    {
+        for(x = 0U; (x < grid.getWidth()) && (true == isSame); ++x)
+        {
+            if (cells[x + y * grid.getWidth()] != grid.getCell(x, y))
+            {
+                isSame = false;
+            }
+        }
+    }
+
+    return isSame;
+}
@@ -0,0 +1,307 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test MQTT packet encoder and decoder.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <MqttPacket.h>
+#include <Util.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testRemainingLength();
+static void testConnect();
+static void testSubscribe();
+static void testPublish();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testRemainingLength);
+    RUN_TEST(testConnect);
+    RUN_TEST(testSubscribe);
+    RUN_TEST(testPublish);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the encoding and decoding of the remaining length.
+ */
+static void testRemainingLength()
+{
+    /* Boundaries, where the number of used byte changes. */
+    const size_t            LENGTHS[]           = { 0U, 127U, 128U, 16383U, 16384U, 2097151U, 2097152U, MqttPacket::MAX_REMAINING_LENGTH };
+    const size_t            SIZES[]             = { 1U, 1U,   2U,   2U,     3U,     3U,       4U,       4U };
+    const uint8_t           MALFORMED[]         = { 0x80U, 0x80U, 0x80U, 0x80U, 0x01U };
+    std::vector<uint8_t>    buffer;
+    size_t                  idx                 = 0U;
+    size_t                  remainingLength     = 0U;
+    size_t                  lenSize             = 0U;
+
+    for(idx = 0U; idx < UTIL_ARRAY_NUM(LENGTHS); ++idx)
+    {
+        buffer.clear();
+        MqttPacket::appendFixedHeader(buffer, MqttPacket::PACKET_TYPE_PINGREQ << 4U, LENGTHS[idx]);
+
+        TEST_ASSERT_EQUAL_UINT32(1U + SIZES[idx], buffer.size());
+        TEST_ASSERT_EQUAL_UINT8(0xC0U, buffer[0]);
+
+        /* All byte are necessary to decode it. */
+        TEST_ASSERT_EQUAL_INT(MqttPacket::DECODE_RESULT_INCOMPLETE, MqttPacket::decodeRemainingLength(&buffer[1], SIZES[idx] - 1U, remainingLength, lenSize));
+        TEST_ASSERT_EQUAL_INT(MqttPacket::DECODE_RESULT_OK, MqttPacket::decodeRemainingLength(&buffer[1], SIZES[idx], remainingLength, lenSize));
+        TEST_ASSERT_EQUAL_UINT32(LENGTHS[idx], remainingLength);
+        TEST_ASSERT_EQUAL_UINT32(SIZES[idx], lenSize);
+    }
+
+    /* Examples from the specification. */
+    buffer.clear();
+    MqttPacket::appendFixedHeader(buffer, 0U, 321U);
+    TEST_ASSERT_EQUAL_UINT32(3U, buffer.size());
+    TEST_ASSERT_EQUAL_UINT8(0xC1U, buffer[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x02U, buffer[2]);
+
+    /* More than 4 byte are not allowed. */
+    TEST_ASSERT_EQUAL_INT(MqttPacket::DECODE_RESULT_MALFORMED, MqttPacket::decodeRemainingLength(MALFORMED, sizeof(MALFORMED), remainingLength, lenSize));
+    TEST_ASSERT_EQUAL_UINT32(4U, lenSize);
+}
+
+/**
+ * Test the CONNECT packet framing.
+ */
+static void testConnect()
+{
+    const uint8_t           EXPECTED_ANONYMOUS[]    =
+    {
+        0x10U, 0x10U,                               /* Fixed header */
+        0x00U, 0x04U, 'M', 'Q', 'T', 'T',           /* Protocol name */
+        0x04U,                                      /* Protocol level */
+        0x02U,                                      /* Clean session */
+        0x00U, 0x3CU,                               /* Keep alive */
+        0x00U, 0x04U, 'p', 'i', 'x', 'i'            /* Client identifier */
+    };
+    const uint8_t           EXPECTED_AUTH[]         =
+    {
+        0x10U, 0x19U,                               /* Fixed header */
+        0x00U, 0x04U, 'M', 'Q', 'T', 'T',           /* Protocol name */
+        0x04U,                                      /* Protocol level */
+        0xC2U,                                      /* User, password, clean session */
+        0x00U, 0x3CU,                               /* Keep alive */
+        0x00U, 0x04U, 'p', 'i', 'x', 'i',           /* Client identifier */
+        0x00U, 0x02U, 'u', 's',                     /* User */
+        0x00U, 0x03U, 'p', 'w', 'd'                 /* Password */
+    };
+    std::vector<uint8_t>    buffer;
+
+    MqttPacket::appendConnect(buffer, "pixi", "", "", 60U);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED_ANONYMOUS), buffer.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED_ANONYMOUS, buffer.data(), sizeof(EXPECTED_ANONYMOUS));
+
+    buffer.clear();
+    MqttPacket::appendConnect(buffer, "pixi", "us", "pwd", 60U);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED_AUTH), buffer.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED_AUTH, buffer.data(), sizeof(EXPECTED_AUTH));
+
+    /* A password without user is not sent. */
+    buffer.clear();
+    MqttPacket::appendConnect(buffer, "pixi", "", "pwd", 60U);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED_ANONYMOUS), buffer.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED_ANONYMOUS, buffer.data(), sizeof(EXPECTED_ANONYMOUS));
+}
+
+/**
+ * Test the SUBSCRIBE and UNSUBSCRIBE packet framing.
+ */
+static void testSubscribe()
+{
+    const uint8_t           EXPECTED_SUBSCRIBE[]    =
+    {
+        0x82U, 0x08U,                               /* Fixed header */
+        0x12U, 0x34U,                               /* Packet identifier */
+        0x00U, 0x03U, 'a', '/', 'b',                /* Topic filter */
+        0x01U                                       /* Requested QoS */
+    };
+    const uint8_t           EXPECTED_UNSUBSCRIBE[]  =
+    {
+        0xA2U, 0x07U,                               /* Fixed header */
+        0x12U, 0x35U,                               /* Packet identifier */
+        0x00U, 0x03U, 'a', '/', 'b'                 /* Topic filter */
+    };
+    std::vector<uint8_t>    buffer;
+
+    MqttPacket::appendSubscribe(buffer, 0x1234U, "a/b", 1U);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED_SUBSCRIBE), buffer.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED_SUBSCRIBE, buffer.data(), sizeof(EXPECTED_SUBSCRIBE));
+
+    buffer.clear();
+    MqttPacket::appendUnsubscribe(buffer, 0x1235U, "a/b");
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED_UNSUBSCRIBE), buffer.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED_UNSUBSCRIBE, buffer.data(), sizeof(EXPECTED_UNSUBSCRIBE));
+}
+
+/**
+ * Test the PUBLISH packet framing and decoding.
+ */
+static void testPublish()
+{
+    const uint8_t           EXPECTED_QOS0[]     =
+    {
+        0x31U, 0x07U,                               /* Fixed header with retain */
+        0x00U, 0x03U, 'a', '/', 'b',                /* Topic name */
+        'o', 'n'                                    /* Payload */
+    };
+    const uint8_t           EXPECTED_QOS1_DUP[] =
+    {
+        0x3AU, 0x09U,                               /* Fixed header with QoS 1 and DUP */
+        0x00U, 0x03U, 'a', '/', 'b',                /* Topic name */
+        0x00U, 0x2AU,                               /* Packet identifier */
+        'o', 'n'                                    /* Payload */
+    };
+    const uint8_t           INVALID_QOS2[]      = { 0x00U, 0x01U, 'a', 0x00U, 0x01U };
+    const uint8_t           INVALID_TOPIC[]     = { 0x00U, 0x05U, 'a', '/', 'b' };
+    std::vector<uint8_t>    buffer;
+    MqttPacket::Publish     publish;
+    String                  payload;
+    size_t                  idx                 = 0U;
+
+    MqttPacket::appendPublish(buffer, "a/b", "on", 0U, true, 0x002AU, false);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED_QOS0), buffer.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED_QOS0, buffer.data(), sizeof(EXPECTED_QOS0));
+
+    TEST_ASSERT_TRUE(MqttPacket::decodePublish(buffer[0], &buffer[2], buffer.size() - 2U, publish));
+    TEST_ASSERT_EQUAL_UINT8(0U, publish.qos);
+    TEST_ASSERT_EQUAL_UINT16(0U, publish.packetId);
+    TEST_ASSERT_EQUAL_UINT32(3U, publish.topicLen);
+    TEST_ASSERT_EQUAL_INT(0, strncmp("a/b", publish.topic, publish.topicLen));
+    TEST_ASSERT_EQUAL_UINT32(2U, publish.payloadSize);
+    TEST_ASSERT_EQUAL_UINT8('o', publish.payload[0]);
+    TEST_ASSERT_EQUAL_UINT8('n', publish.payload[1]);
+
+    buffer.clear();
+    MqttPacket::appendPublish(buffer, "a/b", "on", 1U, false, 0x002AU, true);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(EXPECTED_QOS1_DUP), buffer.size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED_QOS1_DUP, buffer.data(), sizeof(EXPECTED_QOS1_DUP));
+
+    TEST_ASSERT_TRUE(MqttPacket::decodePublish(buffer[0], &buffer[2], buffer.size() - 2U, publish));
+    TEST_ASSERT_EQUAL_UINT8(1U, publish.qos);
+    TEST_ASSERT_EQUAL_UINT16(0x002AU, publish.packetId);
+    TEST_ASSERT_EQUAL_UINT32(3U, publish.topicLen);
+    TEST_ASSERT_EQUAL_UINT32(2U, publish.payloadSize);
+    TEST_ASSERT_EQUAL_UINT8('o', publish.payload[0]);
+
+    /* A payload, which needs a 2 byte remaining length. */
+    for(idx = 0U; idx < 200U; ++idx)
+    {
+        payload += 'x';
+    }
+
+    buffer.clear();
+    MqttPacket::appendPublish(buffer, "a/b", payload, 0U, false, 0U, false);
+    TEST_ASSERT_EQUAL_UINT32(3U + 2U + 3U + 200U, buffer.size());
+    TEST_ASSERT_EQUAL_UINT8(0x30U, buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xCDU, buffer[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x01U, buffer[2]);
+
+    TEST_ASSERT_TRUE(MqttPacket::decodePublish(buffer[0], &buffer[3], buffer.size() - 3U, publish));
+    TEST_ASSERT_EQUAL_UINT32(200U, publish.payloadSize);
+
+    /* QoS 2 and a topic length beyond the packet are rejected. */
+    TEST_ASSERT_FALSE(MqttPacket::decodePublish(0x34U, INVALID_QOS2, sizeof(INVALID_QOS2), publish));
+    TEST_ASSERT_FALSE(MqttPacket::decodePublish(0x30U, INVALID_TOPIC, sizeof(INVALID_TOPIC), publish));
+    TEST_ASSERT_FALSE(MqttPacket::decodePublish(0x30U, INVALID_TOPIC, 1U, publish));
+}
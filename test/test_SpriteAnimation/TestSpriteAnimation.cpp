@@ -0,0 +1,219 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Sprite animation tests.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <FS.h>
+#include <SpriteAnimation.h>
+#include <BmpImgLoader.h>
+#include <YAGfxBitmap.h>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void checkFrame(const SpriteAnimation& animation, const YAGfxBitmap& texture, uint16_t frameIdx);
+
+static void testSpriteAnimation();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testSpriteAnimation);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Check the current frame of the animation against the frame in the
+ * texture image, which the animation was created from.
+ *
+ * @param[in] animation Sprite animation
+ * @param[in] texture   Texture image
+ * @param[in] frameIdx  Index of the frame in the texture image
+ */
+static void checkFrame(const SpriteAnimation& animation, const YAGfxBitmap& texture, uint16_t frameIdx)
+{
+    const YAGfxBitmap&  frame       = animation.getFrame();
+    uint16_t            framesX     = texture.getWidth() / frame.getWidth();
+    int16_t             offsX       = (frameIdx % framesX) * frame.getWidth();
+    int16_t             offsY       = (frameIdx / framesX) * frame.getHeight();
+    int16_t             y           = 0;
+
+    TEST_ASSERT_EQUAL_UINT16(frameIdx, animation.getCurrentFrame());
+
+    for(y = 0; y < frame.getHeight(); ++y)
+    {
+        int16_t x = 0;
+
+        for(x = 0; x < frame.getWidth(); ++x)
+        {
+            TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(texture.getColor(offsX + x, offsY + y)), static_cast<uint32_t>(frame.getColor(x, y)));
+        }
+    }
+
+    return;
+}
+
+/**
+ * Test sprite animation.
+ */
+static void testSpriteAnimation()
+{
+    SpriteAnimation     animation;
+    BmpImgLoader        loader;
+    YAGfxDynamicBitmap  texture;
+    FS                  localFileSystem;
+    uint16_t            frameIdx        = 0U;
+
+    /* The sprite animation was created from the texture with:
+     * create_sprite_anim.py --frameWidth 20 --frameHeight 16 --framesCnt 3 --fps 10 texture.bmp test.anim
+     * Frame 0: Diagonal line and a bar
+     * Frame 1: Only the last pixel changed
+     * Frame 2: Long runs and literals
+     * The texture contains a 4th frame, which is not part of the animation.
+     */
+    TEST_ASSERT_EQUAL(BmpImgLoader::RET_OK, loader.load(localFileSystem, "./test/test_SpriteAnimation/texture.bmp", texture));
+
+    /* No animation loaded. */
+    TEST_ASSERT_TRUE(animation.isEmpty());
+    animation.next();
+    TEST_ASSERT_TRUE(animation.isEmpty());
+
+    /* A bitmap image is not a sprite animation. */
+    TEST_ASSERT_FALSE(animation.load(localFileSystem, "./test/test_SpriteAnimation/texture.bmp"));
+    TEST_ASSERT_TRUE(animation.isEmpty());
+
+    TEST_ASSERT_TRUE(animation.load(localFileSystem, "./test/test_SpriteAnimation/test.anim"));
+    TEST_ASSERT_FALSE(animation.isEmpty());
+    TEST_ASSERT_EQUAL_UINT16(20U, animation.getFrameWidth());
+    TEST_ASSERT_EQUAL_UINT16(16U, animation.getFrameHeight());
+    TEST_ASSERT_EQUAL_UINT16(3U, animation.getFrameCount());
+    TEST_ASSERT_EQUAL_UINT8(10U, animation.getFPS());
+    TEST_ASSERT_TRUE(animation.isRepeatedInfinite());
+
+    /* Play it twice. */
+    for(frameIdx = 0U; frameIdx < (2U * animation.getFrameCount()); ++frameIdx)
+    {
+        checkFrame(animation, texture, frameIdx % animation.getFrameCount());
+        animation.next();
+    }
+
+    /* Copy continues with the same frame. */
+    {
+        SpriteAnimation copy(animation);
+
+        animation.next();
+        checkFrame(copy, texture, 0U);
+        copy.next();
+        checkFrame(copy, texture, 1U);
+    }
+
+    /* Running once keeps the last frame. */
+    animation.repeatInfinite(false);
+    animation.next();
+    checkFrame(animation, texture, 2U);
+    animation.next();
+    checkFrame(animation, texture, 2U);
+
+    animation.reset();
+    checkFrame(animation, texture, 0U);
+
+    animation.release();
+    TEST_ASSERT_TRUE(animation.isEmpty());
+
+    return;
+}
@@ -0,0 +1,160 @@
+/* MIT License
+ *
+ * Copyright (c) 2019 - 2022 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Test token bucket.
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <unity.h>
+#include <TokenBucket.hpp>
+#include <Util.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testTokenBucket();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point
+ *
+ * @param[in] argc  Number of command line arguments
+ * @param[in] argv  Command line arguments
+ */
+extern int main(int argc, char **argv)
+{
+    UTIL_NOT_USED(argc);
+    UTIL_NOT_USED(argv);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testTokenBucket);
+
+    return UNITY_END();
+}
+
+/**
+ * Setup a test. This function will be called before every test by unity.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test. This function will be called after every test by unity.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test token bucket.
+ */
+static void testTokenBucket()
+{
+    const uint32_t  CAPACITY        = 3U;
+    const uint32_t  REFILL_PERIOD   = 100U; /* ms */
+    TokenBucket     bucket(CAPACITY, REFILL_PERIOD);
+    uint32_t        timestamp       = 1000U;
+
+    /* Bucket is full, a burst of its capacity is possible. */
+    TEST_ASSERT_EQUAL_UINT32(CAPACITY, bucket.getTokens(timestamp));
+    TEST_ASSERT_TRUE(bucket.take(timestamp));
+    TEST_ASSERT_TRUE(bucket.take(timestamp));
+    TEST_ASSERT_TRUE(bucket.take(timestamp));
+    TEST_ASSERT_FALSE(bucket.take(timestamp));
+
+    /* No token before the refill period elapsed. */
+    timestamp += REFILL_PERIOD - 1U;
+    TEST_ASSERT_FALSE(bucket.take(timestamp));
+
+    /* One token after the refill period. */
+    timestamp += 1U;
+    TEST_ASSERT_TRUE(bucket.take(timestamp));
+    TEST_ASSERT_FALSE(bucket.take(timestamp));
+
+    /* The remaining time is considered for the next token. */
+    timestamp += REFILL_PERIOD + (REFILL_PERIOD / 2U);
+    TEST_ASSERT_TRUE(bucket.take(timestamp));
+    timestamp += REFILL_PERIOD / 2U;
+    TEST_ASSERT_TRUE(bucket.take(timestamp));
+    TEST_ASSERT_FALSE(bucket.take(timestamp));
+
+    /* The bucket never exceeds its capacity. */
+    timestamp += 100U * REFILL_PERIOD;
+    TEST_ASSERT_EQUAL_UINT32(CAPACITY, bucket.getTokens(timestamp));
+
+    /* Timestamp overflow */
+    timestamp = UINT32_MAX - (REFILL_PERIOD / 2U);
+    TEST_ASSERT_EQUAL_UINT32(CAPACITY, bucket.getTokens(timestamp));
+    TEST_ASSERT_TRUE(bucket.take(timestamp));
+    timestamp += REFILL_PERIOD;
+    TEST_ASSERT_EQUAL_UINT32(CAPACITY, bucket.getTokens(timestamp));
+
+    return;
+}
@@ -138,6 +138,12 @@ static void testUtil(void)
     TEST_ASSERT_FALSE(Util::strToUInt8("-1", valueUInt8));
     TEST_ASSERT_EQUAL_UINT8(0U, valueUInt8);
 
+    TEST_ASSERT_FALSE(Util::strToUInt8(static_cast<const char*>(nullptr), valueUInt8));
+    TEST_ASSERT_EQUAL_UINT8(0U, valueUInt8);
+
+    TEST_ASSERT_TRUE(Util::strToUInt8(String("42"), valueUInt8));
+    TEST_ASSERT_EQUAL_UINT8(42U, valueUInt8);
+
     /* Test string to 16 bit unsigned integer conversion. */
     TEST_ASSERT_TRUE(Util::strToUInt16("0", valueUInt16));
     TEST_ASSERT_EQUAL_UINT16(0U, valueUInt16);
@@ -58,6 +58,7 @@
 template < typename T >
 static T getMin(const T value1, const T value2);
 static void testWidgetGroup();
+static void testWidgetGroupInvalidation();
 
 /******************************************************************************
  * Local Variables
@@ -93,6 +94,7 @@ extern int main(int argc, char **argv)
     UNITY_BEGIN();
 
     RUN_TEST(testWidgetGroup);
+    RUN_TEST(testWidgetGroupInvalidation);
 
     return UNITY_END();
 }
@@ -241,3 +243,81 @@ static void testWidgetGroup()
 
     return;
 }
+
+/**
+ * Widget group invalidation tests.
+ */
+static void testWidgetGroupInvalidation()
+{
+    const uint16_t  CANVAS_WIDTH        = 16;
+    const uint16_t  CANVAS_HEIGHT       = 8;
+    const Color     BACKGROUND_COLOR    = 0x010203;
+    const Color     WIDGET_COLOR        = 0x123456;
+    const Color     WIDGET2_COLOR       = 0x654321;
+
+    YAGfxTest   testGfx;
+    WidgetGroup testWGroup(CANVAS_WIDTH, CANVAS_HEIGHT, 0, 0);
+    TestWidget  testWidget;
+    TestWidget  testWidget2;
+
+    testWGroup.setBackgroundColor(BACKGROUND_COLOR);
+    TEST_ASSERT_TRUE(testWGroup.hasBackgroundColor());
+    TEST_ASSERT_TRUE(testWGroup.isOpaque());
+    TEST_ASSERT_TRUE(testWGroup.addWidget(testWidget));
+    testWidget.setPenColor(WIDGET_COLOR);
+
+    /* First update paints the background and the widget. */
+    testGfx.fill(0);
+    TEST_ASSERT_TRUE(testWGroup.isInvalid());
+    testWGroup.update(testGfx);
+    TEST_ASSERT_FALSE(testWGroup.isInvalid());
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestWidget::WIDTH, TestWidget::HEIGHT, WIDGET_COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(TestWidget::WIDTH, 0, CANVAS_WIDTH - TestWidget::WIDTH, CANVAS_HEIGHT, BACKGROUND_COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(0, TestWidget::HEIGHT, CANVAS_WIDTH, CANVAS_HEIGHT - TestWidget::HEIGHT, BACKGROUND_COLOR));
+
+    /* Nothing changed, therefore nothing shall be painted. */
+    testGfx.setCallCounterDrawPixel(0);
+    testWGroup.update(testGfx);
+    TEST_ASSERT_EQUAL_UINT32(0, testGfx.getCallCounterDrawPixel());
+
+    /* Moving the widget restores the background at the old position and
+     * paints the widget at the new position. Only the united area is painted.
+     */
+    testGfx.setCallCounterDrawPixel(0);
+    testWidget.move(2, 1);
+    TEST_ASSERT_TRUE(testWGroup.isInvalid());
+    testWGroup.update(testGfx);
+    TEST_ASSERT_EQUAL_UINT32((TestWidget::WIDTH + 2U) * (TestWidget::HEIGHT + 1U) + (TestWidget::WIDTH * TestWidget::HEIGHT),
+                             testGfx.getCallCounterDrawPixel());
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, 2, CANVAS_HEIGHT, BACKGROUND_COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, CANVAS_WIDTH, 1, BACKGROUND_COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(2, 1, TestWidget::WIDTH, TestWidget::HEIGHT, WIDGET_COLOR));
+
+    /* A disabled widget disappears. */
+    testWidget.disable();
+    testWGroup.update(testGfx);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, CANVAS_WIDTH, CANVAS_HEIGHT, BACKGROUND_COLOR));
+
+    /* A widget, which is completely covered by an opaque widget on top, is not painted. */
+    testWidget.enable();
+    testWidget.move(0, 0);
+    TEST_ASSERT_TRUE(testWGroup.addWidget(testWidget2));
+    testWidget2.setPenColor(WIDGET2_COLOR);
+    testWGroup.update(testGfx);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestWidget::WIDTH, TestWidget::HEIGHT, WIDGET2_COLOR));
+
+    /* The covered widget changes, but only the background and the widget on top are painted. */
+    testWidget.setPenColor(WIDGET_COLOR);
+    testGfx.setCallCounterDrawPixel(0);
+    testWGroup.update(testGfx);
+    TEST_ASSERT_EQUAL_UINT32(TestWidget::WIDTH * TestWidget::HEIGHT * 2U, testGfx.getCallCounterDrawPixel());
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, TestWidget::WIDTH, TestWidget::HEIGHT, WIDGET2_COLOR));
+
+    /* The widget on top is moved away, therefore the widget below appears again. */
+    testWidget2.move(CANVAS_WIDTH - TestWidget::WIDTH, CANVAS_HEIGHT - TestWidget::HEIGHT);
+    testWGroup.update(testGfx);
+    TEST_ASSERT_TRUE(testGfx.verify(0, 0, 1, 1, WIDGET_COLOR));
+    TEST_ASSERT_TRUE(testGfx.verify(CANVAS_WIDTH - TestWidget::WIDTH, CANVAS_HEIGHT - TestWidget::HEIGHT, TestWidget::WIDTH, TestWidget::HEIGHT, WIDGET2_COLOR));
+
+    return;
+}